@@ -0,0 +1,1259 @@
+/*
+ * SPLATSTORM X - Host Kernel Benchmarks
+ * Times the portable kernels on the build machine (make bench-host) and
+ * checks every result against a plain reference, so a change to any of
+ * them can be measured and verified without a console.
+ *
+ * Kernels:
+ * - Tile binning (assign_splats_to_tiles) and the per-tile depth sort
+ *   (sort_splats_by_depth): exact, bin for bin, against a direct
+ *   circle/rectangle test and a stable sort per tile
+ * - Frustum culling (cull_gaussian_splat_indices): octree and 4-wide
+ *   tests against the scalar sphere test, over an orbiting camera; and a
+ *   256k scene under a 64k visible cap, which must fill the cap with the
+ *   most important visible splats from the whole index range
+ * - Scene depth sort (bucket_sort_splats_optimized): full radix sorts
+ *   after camera jumps and incremental repairs after small moves
+ * - Projection: project_gaussian_batch() against project_gaussian_complete()
+ *   within the PROJECT_BATCH_TOL_* bounds
+ * - Fixed-point math: fixed_mul, fixed16_mul/div, the MMI 4-wide forms, the
+ *   reciprocal and both square roots, against 64-bit and double references
+ *
+ * Splat distributions are synthetic (uniform, clustered, large footprints)
+ * at several sizes, plus any frames captured on hardware with
+ * bench_capture=<frame>:<file> and passed here with --splats <file>. The
+ * scene kernels also run on 64k, 128k and 256k splat scenes, past the old
+ * 32k limit, to show how they scale with resident scene size.
+ *
+ * Usage: bench_kernels [--quick] [--runs N] [--filter TEXT] [--splats FILE]...
+ * Exits non-zero when a check fails. Times are host microseconds: compare
+ * them between builds on one machine, not with EE cycles.
+ */
+
+#include "splatstorm_x.h"
+#include "gaussian_types.h"
+#include "fixed_math_mmi.h"
+#include "memory_optimized.h"
+#include "splatstorm_optimized.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SAMPLES       1000
+#define BENCH_MAX_SPLAT_FILES   8
+#define BENCH_POSES             64          // Orbit poses the scene kernels cycle through
+#define BENCH_CHECK_POSES       8
+#define BENCH_CULL_SLACK        8           // Q16.16 LSB: plane and radius rounding
+#define BENCH_CULL_BUDGET       65536       // Visible cap of the budgeted cull, as QUALITY_MAX_SPLATS
+#define BENCH_BUDGET_SCENE      262144      // Scene the budgeted cull runs on, in every mode
+#define BENCH_RENDER_WIDTH      640
+#define BENCH_RENDER_HEIGHT     448
+#define BENCH_SORT_KEY_DROP     8           // As SORT_KEY_DROP_BITS in sorting_optimized.c
+#define BENCH_TILE_KEY_SHIFT    4           // Z24 to the 20-bit tile sort key
+
+typedef void (*BenchRun)(void* context, u32 run);
+
+typedef enum {
+    RENDER_UNIFORM,
+    RENDER_CLUSTERED,
+    RENDER_LARGE,
+    RENDER_DISTRIBUTIONS
+} RenderDistribution;
+
+typedef enum {
+    SCENE_UNIFORM,
+    SCENE_CLUSTERED,
+    SCENE_DISTRIBUTIONS
+} SceneDistribution;
+
+typedef struct {
+    char name[32];
+    GaussianSplatRender* splats;
+    u32 count;
+    u32 width;
+    u32 height;
+} RenderSet;
+
+typedef struct {
+    char name[32];
+    GaussianSplat3D* splats;
+    PackedSplat* packed;
+    u32 count;
+} SceneSet;
+
+// Capture file layout (benchmark.c)
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 record_size;
+    u32 count;
+    u16 width;
+    u16 height;
+} BenchSplatsHeader;
+
+static const char* const g_render_names[RENDER_DISTRIBUTIONS] = {"uniform", "clustered", "large"};
+static const char* const g_scene_names[SCENE_DISTRIBUTIONS] = {"uniform", "clustered"};
+static const u32 g_sizes[] = {1024, 8192, 32768};
+static const u32 g_scene_sizes[] = {1024, 8192, 32768, 65536, 131072, 262144};
+
+static struct {
+    bool quick;
+    u32 min_runs;
+    const char* filter;
+    const char* splat_files[BENCH_MAX_SPLAT_FILES];
+    u32 splat_file_count;
+} g_options = {false, 3, NULL, {NULL}, 0};
+
+static u32 g_failures;
+static u32 g_rng;
+static double g_samples[BENCH_MAX_SAMPLES];
+
+// FrustumInternal is private to frustum_culling_complete.c; this holds it
+static u8 g_frustum[1024] __attribute__((aligned(16)));
+
+// ============================================================================
+// Timing and report
+// ============================================================================
+
+static double bench_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec * 1e-3;
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Run until the time budget is spent and at least min_runs are in;
+// run is the sample number, for kernels that vary their input per run
+static void bench_time(BenchRun run, void* context, double* min_us, double* median_us) {
+    double budget_us = g_options.quick ? 20000.0 : 200000.0;
+    double start = bench_now_us();
+    u32 count = 0;
+
+    while (count < BENCH_MAX_SAMPLES && (count < g_options.min_runs || bench_now_us() - start < budget_us)) {
+        double t0 = bench_now_us();
+        run(context, count);
+        g_samples[count++] = bench_now_us() - t0;
+    }
+
+    qsort(g_samples, count, sizeof(double), bench_compare_double);
+    *min_us = g_samples[0];
+    *median_us = g_samples[count / 2];
+}
+
+static bool bench_selected(const char* kernel) {
+    return !g_options.filter || strstr(kernel, g_options.filter);
+}
+
+static void bench_report(const char* kernel, const char* distribution, u32 items, double min_us, double median_us,
+                         bool ok) {
+    printf("%-18s %-20s %8u %11.1f %11.1f %9.2f  %s\n", kernel, distribution, items, min_us, median_us,
+           items ? median_us * 1000.0 / items : 0.0, ok ? "ok" : "FAIL");
+    if (!ok) {
+        g_failures++;
+    }
+}
+
+static void bench_run_kernel(const char* kernel, const char* distribution, u32 items, BenchRun run, void* context,
+                             bool (*check)(void* context)) {
+    double min_us, median_us;
+    bench_time(run, context, &min_us, &median_us);
+    bench_report(kernel, distribution, items, min_us, median_us, check(context));
+}
+
+// ============================================================================
+// Synthetic data
+// ============================================================================
+
+static void* bench_alloc(size_t alignment, size_t size) {
+    void* ptr = NULL;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : NULL;
+}
+
+static u32 bench_random(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+static float bench_uniform(float lo, float hi) {
+    return lo + (hi - lo) * (bench_random() >> 8) * (1.0f / 16777216.0f);
+}
+
+static float bench_normal(void) {
+    float u = bench_uniform(1e-6f, 1.0f);
+    float v = bench_uniform(0.0f, 6.2831853f);
+    return sqrtf(-2.0f * logf(u)) * cosf(v);
+}
+
+static void render_set_generate(RenderSet* set, RenderDistribution distribution, u32 count) {
+    g_rng = 0x9E3779B9u ^ (count * 31 + distribution);
+    snprintf(set->name, sizeof(set->name), "%s", g_render_names[distribution]);
+    set->splats = (GaussianSplatRender*)calloc(count, sizeof(GaussianSplatRender));
+    set->count = count;
+    set->width = BENCH_RENDER_WIDTH;
+    set->height = BENCH_RENDER_HEIGHT;
+
+    float centers[16][2];
+    for (u32 c = 0; c < 16; c++) {
+        centers[c][0] = bench_uniform(0.0f, BENCH_RENDER_WIDTH);
+        centers[c][1] = bench_uniform(0.0f, BENCH_RENDER_HEIGHT);
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        GaussianSplatRender* splat = &set->splats[i];
+        float x, y, radius;
+        u32 depth = bench_random() & 0xFFFFFF;
+
+        switch (distribution) {
+        case RENDER_CLUSTERED: {
+            const float* center = centers[bench_random() & 15];
+            x = center[0] + bench_normal() * 24.0f;
+            y = center[1] + bench_normal() * 24.0f;
+            radius = bench_uniform(1.0f, 12.0f);
+            depth &= 0xFFFF00;  // Equal sort keys: the tile sort must keep bin order
+            break;
+        }
+        case RENDER_LARGE:
+            x = bench_uniform(-32.0f, BENCH_RENDER_WIDTH + 32.0f);
+            y = bench_uniform(-32.0f, BENCH_RENDER_HEIGHT + 32.0f);
+            radius = bench_uniform(8.0f, 96.0f);
+            break;
+        default:
+            x = bench_uniform(-16.0f, BENCH_RENDER_WIDTH + 16.0f);
+            y = bench_uniform(-16.0f, BENCH_RENDER_HEIGHT + 16.0f);
+            radius = bench_uniform(1.0f, 8.0f);
+            break;
+        }
+
+        splat->screen_x = (s16)CLAMP(x * 16.0f, -32768.0f, 32767.0f);
+        splat->screen_y = (s16)CLAMP(y * 16.0f, -32768.0f, 32767.0f);
+        splat->radius = (u16)(radius * 16.0f);
+        splat->depth = depth;
+        splat->atlas_index = (u8)(bench_random() & 0x3F);
+        splat->atlas_level = (u8)(bench_random() & 0x3);
+        splat->color[0] = splat->color[1] = splat->color[2] = splat->color[3] = 0xFF;
+    }
+}
+
+static bool render_set_load(RenderSet* set, const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "bench: cannot open %s\n", filename);
+        return false;
+    }
+
+    BenchSplatsHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == BENCHMARK_SPLATS_MAGIC &&
+              header.version == BENCHMARK_SPLATS_VERSION && header.record_size == sizeof(GaussianSplatRender);
+    if (ok) {
+        set->splats = (GaussianSplatRender*)calloc(header.count ? header.count : 1, sizeof(GaussianSplatRender));
+        ok = set->splats && fread(set->splats, sizeof(GaussianSplatRender), header.count, file) == header.count;
+    }
+    fclose(file);
+
+    if (!ok) {
+        fprintf(stderr, "bench: %s is not a splat capture\n", filename);
+        free(set->splats);
+        set->splats = NULL;
+        return false;
+    }
+
+    const char* base = strrchr(filename, '/');
+    snprintf(set->name, sizeof(set->name), "%s", base ? base + 1 : filename);
+    set->count = header.count;
+    set->width = header.width ? header.width : BENCH_RENDER_WIDTH;
+    set->height = header.height ? header.height : BENCH_RENDER_HEIGHT;
+    return true;
+}
+
+// Q8.8 mantissas with the smallest exponent that fits the largest entry
+static void scene_encode_covariance(GaussianSplat3D* splat, const float cov[9]) {
+    float largest = 0.0f;
+    for (int i = 0; i < 9; i++) {
+        largest = MAX(largest, fabsf(cov[i]));
+    }
+
+    int exponent = 0;
+    while (exponent < 15 && largest * FIXED8_SCALE / ldexpf(1.0f, exponent - 7) > 32767.0f) {
+        exponent++;
+    }
+    float to_mantissa = FIXED8_SCALE / ldexpf(1.0f, exponent - 7);
+    for (int i = 0; i < 9; i++) {
+        splat->cov_mant[i] = (fixed8_t)CLAMP(cov[i] * to_mantissa, -32768.0f, 32767.0f);
+    }
+    splat->cov_exp = (u8)exponent;
+}
+
+static void scene_set_generate(SceneSet* set, SceneDistribution distribution, u32 count) {
+    g_rng = 0x85EBCA6Bu ^ (count * 17 + distribution);
+    snprintf(set->name, sizeof(set->name), "%s", g_scene_names[distribution]);
+    set->splats = (GaussianSplat3D*)bench_alloc(CACHE_LINE_SIZE, count * sizeof(GaussianSplat3D));
+    set->packed = (PackedSplat*)bench_alloc(64, count * sizeof(PackedSplat));
+    set->count = count;
+    memset(set->splats, 0, count * sizeof(GaussianSplat3D));
+    memset(set->packed, 0, count * sizeof(PackedSplat));
+
+    float centers[32][3];
+    for (u32 c = 0; c < 32; c++) {
+        for (int k = 0; k < 3; k++) {
+            centers[c][k] = bench_uniform(-15.0f, 15.0f);
+        }
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        GaussianSplat3D* splat = &set->splats[i];
+        float pos[3];
+        if (distribution == SCENE_CLUSTERED) {
+            const float* center = centers[bench_random() & 31];
+            for (int k = 0; k < 3; k++) {
+                pos[k] = center[k] + bench_normal() * 1.5f;
+            }
+        } else {
+            for (int k = 0; k < 3; k++) {
+                pos[k] = bench_uniform(-20.0f, 20.0f);
+            }
+        }
+
+        // Axis variances with one correlated pair: positive definite
+        float sigma[3], cov[9] = {0};
+        for (int k = 0; k < 3; k++) {
+            sigma[k] = bench_uniform(0.03f, 0.3f);
+            cov[k * 4] = sigma[k] * sigma[k];
+        }
+        cov[1] = cov[3] = bench_uniform(-0.5f, 0.5f) * sigma[0] * sigma[1];
+
+        for (int k = 0; k < 3; k++) {
+            splat->pos[k] = fixed_from_float(pos[k]);
+            set->packed[i].position[k] = pos[k];
+        }
+        set->packed[i].position[3] = 1.0f;
+        scene_encode_covariance(splat, cov);
+        splat->color[0] = (u8)bench_random();
+        splat->color[1] = (u8)bench_random();
+        splat->color[2] = (u8)bench_random();
+        splat->opacity = (u8)(128 + (bench_random() & 127));
+        splat->importance = (u32)(splat->opacity / 255.0f * (sigma[0] + sigma[1] + sigma[2]) * 1000.0f);
+    }
+}
+
+// ============================================================================
+// Camera: orbit around the scene, +Z forward in view space as the
+// projection expects, GL clip depth so the culling planes close the frustum.
+// Built column-major, element (row, col) at [col * 4 + row], which is how
+// extract_frustum_planes() reads view_proj; project_gaussian_complete() and
+// project_gaussian_batch() read view and proj row-major, so those two are
+// stored transposed.
+// ============================================================================
+
+typedef struct {
+    CameraFixed camera;
+    float depth_axis[4];                      // View-space depth for the scene sort
+} BenchPose;
+
+static BenchPose g_poses[BENCH_POSES];
+
+static void bench_pose(BenchPose* pose, float angle, float distance) {
+    const float near_plane = 0.5f, far_plane = 100.0f;
+    const float fy = 1.0f / tanf(0.5f * 60.0f * 3.14159265f / 180.0f);
+    const float aspect = (float)BENCH_RENDER_WIDTH / BENCH_RENDER_HEIGHT;
+
+    float eye[3] = {distance * cosf(angle), 0.3f * distance, distance * sinf(angle)};
+    float forward[3] = {-eye[0], -eye[1], -eye[2]};
+    float length = sqrtf(forward[0] * forward[0] + forward[1] * forward[1] + forward[2] * forward[2]);
+    for (int k = 0; k < 3; k++) forward[k] /= length;
+
+    // right = world up x forward, up = forward x right
+    float right[3] = {forward[2], 0.0f, -forward[0]};
+    length = sqrtf(right[0] * right[0] + right[2] * right[2]);
+    right[0] /= length; right[2] /= length;
+    float up[3] = {forward[1] * right[2] - forward[2] * right[1], forward[2] * right[0] - forward[0] * right[2],
+                   forward[0] * right[1] - forward[1] * right[0]};
+
+    float view[16] = {0}, proj[16] = {0};
+    const float* axes[3] = {right, up, forward};
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            view[col * 4 + row] = axes[row][col];
+        }
+        view[12 + row] = -(axes[row][0] * eye[0] + axes[row][1] * eye[1] + axes[row][2] * eye[2]);
+    }
+    view[15] = 1.0f;
+
+    proj[0] = fy / aspect;
+    proj[5] = fy;
+    proj[10] = (far_plane + near_plane) / (far_plane - near_plane);
+    proj[11] = 1.0f;                                                                // w = view z
+    proj[14] = -2.0f * far_plane * near_plane / (far_plane - near_plane);
+
+    CameraFixed* camera = &pose->camera;
+    memset(camera, 0, sizeof(*camera));
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += proj[k * 4 + row] * view[col * 4 + k];
+            }
+            camera->view_proj[col * 4 + row] = fixed_from_float(sum);
+        }
+    }
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            camera->view[row * 4 + col] = fixed_from_float(view[col * 4 + row]);
+            camera->proj[row * 4 + col] = fixed_from_float(proj[col * 4 + row]);
+        }
+    }
+    camera->viewport[2] = fixed_from_int(BENCH_RENDER_WIDTH);
+    camera->viewport[3] = fixed_from_int(BENCH_RENDER_HEIGHT);
+
+    for (int k = 0; k < 3; k++) {
+        pose->depth_axis[k] = forward[k];
+    }
+    pose->depth_axis[3] = view[14];
+}
+
+// ============================================================================
+// Tile binning and the per-tile sort
+// ============================================================================
+
+typedef struct {
+    const RenderSet* set;
+    u32* counts;                              // Reference bins
+    u32* starts;
+    u32* bins;
+} TileContext;
+
+static const GaussianSplatRender* g_key_splats;
+
+static inline s32 floor_div(s32 value, s32 divisor) {
+    s32 quotient = value / divisor;
+    return (value % divisor && value < 0) ? quotient - 1 : quotient;
+}
+
+static bool reference_overlap(const GaussianSplatRender* splat, s32 tile_x, s32 tile_y) {
+    const s32 size = TILE_SIZE << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s64 x = CLAMP((s32)splat->screen_x, tile_x * size, (tile_x + 1) * size);
+    s64 y = CLAMP((s32)splat->screen_y, tile_y * size, (tile_y + 1) * size);
+    s64 dx = splat->screen_x - x;
+    s64 dy = splat->screen_y - y;
+    return dx * dx + dy * dy <= (s64)splat->radius * splat->radius;
+}
+
+// Visit every (tile, splat) overlap in splat order
+static void reference_bin(TileContext* context, bool scatter) {
+    const RenderSet* set = context->set;
+    const s32 size = TILE_SIZE << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s32 tiles_x = CLAMP((s32)((set->width + TILE_SIZE - 1) / TILE_SIZE), 1, TILES_X);
+    s32 tiles_y = CLAMP((s32)((set->height + TILE_SIZE - 1) / TILE_SIZE), 1, TILES_Y);
+
+    for (u32 i = 0; i < set->count; i++) {
+        const GaussianSplatRender* splat = &set->splats[i];
+        if (splat->radius == 0) continue;
+
+        s32 x0 = MAX(floor_div(splat->screen_x - splat->radius, size), 0);
+        s32 x1 = MIN(floor_div(splat->screen_x + splat->radius, size), tiles_x - 1);
+        s32 y0 = MAX(floor_div(splat->screen_y - splat->radius, size), 0);
+        s32 y1 = MIN(floor_div(splat->screen_y + splat->radius, size), tiles_y - 1);
+        for (s32 ty = y0; ty <= y1; ty++) {
+            for (s32 tx = x0; tx <= x1; tx++) {
+                if (!reference_overlap(splat, tx, ty)) continue;
+                u32 tile_id = ty * TILES_X + tx;
+                if (scatter) {
+                    context->bins[context->starts[tile_id] + context->counts[tile_id]] = i;
+                }
+                context->counts[tile_id]++;
+            }
+        }
+    }
+}
+
+static int compare_tile_key(const void* a, const void* b) {
+    u32 ia = *(const u32*)a;
+    u32 ib = *(const u32*)b;
+    u32 ka = (g_key_splats[ia].depth >> BENCH_TILE_KEY_SHIFT) & 0xFFFFF;
+    u32 kb = (g_key_splats[ib].depth >> BENCH_TILE_KEY_SHIFT) & 0xFFFFF;
+    if (ka != kb) return (ka > kb) - (ka < kb);
+    return (ia > ib) - (ia < ib);  // Bin order: the radix sort is stable
+}
+
+static void tile_reference_build(TileContext* context) {
+    context->counts = (u32*)calloc(MAX_TILES, sizeof(u32));
+    context->starts = (u32*)calloc(MAX_TILES + 1, sizeof(u32));
+    reference_bin(context, false);
+
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        context->starts[tile_id + 1] = context->starts[tile_id] + context->counts[tile_id];
+        context->counts[tile_id] = 0;
+    }
+    context->bins = (u32*)malloc(MAX(context->starts[MAX_TILES], 1) * sizeof(u32));
+    reference_bin(context, true);
+}
+
+static void tile_reference_free(TileContext* context) {
+    free(context->counts);
+    free(context->starts);
+    free(context->bins);
+}
+
+// Engine bins against the reference; sorted compares the stable per-tile sort
+static bool tile_check(TileContext* context, bool sorted) {
+    u32 mismatched = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32* expected = &context->bins[context->starts[tile_id]];
+        u32 expected_count = context->counts[tile_id];
+        if (sorted) {
+            g_key_splats = context->set->splats;
+            qsort(expected, expected_count, sizeof(u32), compare_tile_key);
+        }
+
+        u32 count = 0;
+        const u32* bin = get_tile_splat_list(tile_id, &count);
+        if (count != expected_count || (count && (!bin || memcmp(bin, expected, count * sizeof(u32)) != 0))) {
+            if (mismatched++ == 0) {
+                fprintf(stderr, "bench: %s, tile %u: %u splats, expected %u\n", context->set->name, tile_id,
+                        count, expected_count);
+            }
+        }
+    }
+    return mismatched == 0;
+}
+
+static void run_tile_bin(void* context, u32 run) {
+    (void)run;
+    assign_splats_to_tiles(((TileContext*)context)->set->splats, ((TileContext*)context)->set->count);
+}
+
+static void run_tile_sort(void* context, u32 run) {
+    (void)run;
+    sort_splats_by_depth(((TileContext*)context)->set->splats);
+}
+
+static bool check_tile_bin(void* context) {
+    return tile_check((TileContext*)context, false);
+}
+
+static bool check_tile_sort(void* context) {
+    return tile_check((TileContext*)context, true);
+}
+
+static void bench_tiles(const RenderSet* set) {
+    if (!bench_selected("tile_bin") && !bench_selected("tile_sort")) return;
+
+    TileContext context = {set, NULL, NULL, NULL};
+    tile_reference_build(&context);
+    tile_set_render_size(set->width, set->height);
+
+    // The sort reorders the bins in place, so the bin check runs first and
+    // one fresh binning feeds the sort
+    if (bench_selected("tile_bin")) {
+        bench_run_kernel("tile_bin", set->name, set->count, run_tile_bin, &context, check_tile_bin);
+    }
+    if (bench_selected("tile_sort")) {
+        assign_splats_to_tiles(set->splats, set->count);
+        bench_run_kernel("tile_sort", set->name, context.starts[MAX_TILES], run_tile_sort, &context,
+                         check_tile_sort);
+    }
+    tile_reference_free(&context);
+}
+
+// ============================================================================
+// Frustum culling
+// ============================================================================
+
+typedef struct {
+    const SceneSet* set;
+    u32* visible;
+    u32 visible_count;
+} CullContext;
+
+static void run_cull(void* context, u32 run) {
+    CullContext* cull = (CullContext*)context;
+    cull_gaussian_splat_indices(cull->set->splats, NULL, cull->set->count, g_poses[run % BENCH_POSES].camera.view_proj,
+                                cull->visible, cull->set->count, &cull->visible_count);
+}
+
+// Every splat whose slightly shrunk sphere the scalar test keeps must be
+// visible, and every visible splat must pass with a slightly grown one.
+// Each pose is culled twice and the second pass checked: the first may
+// still keep splats for their temporal coherence grace frame.
+static bool check_cull(void* context) {
+    CullContext* cull = (CullContext*)context;
+    const SceneSet* set = cull->set;
+    u8* marked = (u8*)malloc(set->count);
+    u32 missing = 0, extra = 0, invalid = 0;
+
+    for (u32 pose = 0; pose < BENCH_CHECK_POSES; pose++) {
+        const fixed16_t* view_proj = g_poses[pose * (BENCH_POSES / BENCH_CHECK_POSES)].camera.view_proj;
+        cull_gaussian_splat_indices(set->splats, NULL, set->count, view_proj, cull->visible, set->count,
+                                    &cull->visible_count);
+        cull_gaussian_splat_indices(set->splats, NULL, set->count, view_proj, cull->visible, set->count,
+                                    &cull->visible_count);
+        extract_frustum_planes(view_proj, g_frustum);
+
+        memset(marked, 0, set->count);
+        for (u32 i = 0; i < cull->visible_count; i++) {
+            u32 index = cull->visible[i];
+            if (index >= set->count || marked[index]) {
+                invalid++;
+                continue;
+            }
+            marked[index] = 1;
+        }
+
+        for (u32 i = 0; i < set->count; i++) {
+            const GaussianSplat3D* splat = &set->splats[i];
+            fixed16_t radius = gaussian_splat_bounding_radius(splat);
+            if (!marked[i] && is_sphere_visible(splat->pos, MAX(radius - BENCH_CULL_SLACK, 0), g_frustum)) {
+                missing++;
+            } else if (marked[i] && !is_sphere_visible(splat->pos, radius + BENCH_CULL_SLACK, g_frustum)) {
+                extra++;
+            }
+        }
+    }
+    free(marked);
+
+    if (missing || extra || invalid) {
+        fprintf(stderr, "bench: %s cull: %u visible splats dropped, %u outside kept, %u bad indices\n", set->name,
+                missing, extra, invalid);
+    }
+    return missing == 0 && extra == 0 && invalid == 0;
+}
+
+static void bench_cull(const SceneSet* set) {
+    if (!bench_selected("frustum_cull")) return;
+
+    CullContext context = {set, (u32*)malloc(set->count * sizeof(u32)), 0};
+    cleanup_frustum_culling();  // The octree is built for the splats of the first call
+    bench_run_kernel("frustum_cull", set->name, set->count, run_cull, &context, check_cull);
+    free(context.visible);
+}
+
+// The visible cap limits the output, not the splats tested: every kept
+// index must be visible in an uncapped cull, the cap must fill when more
+// are visible, splats past the cap's index range must show up, and no
+// dropped visible splat may be more important than a kept one by more than
+// the culler's importance code step (1/8 octave). Each pose is culled twice
+// capped, as the importance limit follows the previous pass
+static void run_cull_budget(void* context, u32 run) {
+    CullContext* cull = (CullContext*)context;
+    cull_gaussian_splat_indices(cull->set->splats, NULL, cull->set->count, g_poses[run % BENCH_POSES].camera.view_proj,
+                                cull->visible, BENCH_CULL_BUDGET, &cull->visible_count);
+}
+
+static bool check_cull_budget(void* context) {
+    CullContext* cull = (CullContext*)context;
+    const SceneSet* set = cull->set;
+    u8* marked = (u8*)malloc(set->count);
+    u32 short_fills = 0, invalid = 0, past_budget = 0, misranked = 0;
+
+    for (u32 pose = 0; pose < BENCH_CHECK_POSES; pose++) {
+        const fixed16_t* view_proj = g_poses[pose * (BENCH_POSES / BENCH_CHECK_POSES)].camera.view_proj;
+        cull_gaussian_splat_indices(set->splats, NULL, set->count, view_proj, cull->visible, set->count,
+                                    &cull->visible_count);
+        cull_gaussian_splat_indices(set->splats, NULL, set->count, view_proj, cull->visible, set->count,
+                                    &cull->visible_count);
+        u32 uncapped = cull->visible_count;
+        memset(marked, 0, set->count);
+        for (u32 i = 0; i < uncapped; i++) {
+            marked[cull->visible[i]] = 1;
+        }
+
+        for (int pass = 0; pass < 2; pass++) {
+            cull_gaussian_splat_indices(set->splats, NULL, set->count, view_proj, cull->visible, BENCH_CULL_BUDGET,
+                                        &cull->visible_count);
+        }
+        if (cull->visible_count != MIN(uncapped, BENCH_CULL_BUDGET)) {
+            short_fills++;
+        }
+        for (u32 i = 0; i < cull->visible_count; i++) {
+            u32 index = cull->visible[i];
+            if (index >= set->count || marked[index] != 1) {
+                invalid++;
+                continue;
+            }
+            marked[index] = 2;
+            if (index >= BENCH_CULL_BUDGET) {
+                past_budget++;
+            }
+        }
+
+        // Least important kept against most important dropped
+        u32 kept_min = 0xFFFFFFFFu, dropped_max = 0;
+        for (u32 i = 0; i < set->count; i++) {
+            if (marked[i] == 2) {
+                kept_min = MIN(kept_min, set->splats[i].importance);
+            } else if (marked[i] == 1) {
+                dropped_max = MAX(dropped_max, set->splats[i].importance);
+            }
+        }
+        if (uncapped > BENCH_CULL_BUDGET && (u64)dropped_max * 8 > (u64)kept_min * 9) {
+            misranked++;
+        }
+    }
+    free(marked);
+
+    if (short_fills || invalid || past_budget == 0 || misranked) {
+        fprintf(stderr, "bench: %s capped cull: %u short fills, %u bad indices, %u kept past index %u, "
+                "%u poses dropping more important splats\n", set->name, short_fills, invalid, past_budget,
+                BENCH_CULL_BUDGET, misranked);
+    }
+    return short_fills == 0 && invalid == 0 && past_budget > 0 && misranked == 0;
+}
+
+static void bench_cull_budget(const SceneSet* set) {
+    if (!bench_selected("frustum_cull_cap")) return;
+
+    CullContext context = {set, (u32*)malloc(set->count * sizeof(u32)), 0};
+    cleanup_frustum_culling();
+    bench_run_kernel("frustum_cull_cap", set->name, set->count, run_cull_budget, &context, check_cull_budget);
+    free(context.visible);
+}
+
+// ============================================================================
+// Scene depth sort
+// ============================================================================
+
+typedef struct {
+    const SceneSet* set;
+    const float* last_axis;
+    bool jumps;                               // Opposite views each run: full sorts
+} DepthSortContext;
+
+static u32 depth_sort_key(const float axis[4], const float position[4]) {
+    union { float f; u32 u; } bits;
+    bits.f = axis[0] * position[0] + axis[1] * position[1] + axis[2] * position[2] + axis[3];
+    u32 ordered = (bits.u & 0x80000000) ? ~bits.u : (bits.u | 0x80000000);
+    return ~ordered & ~((1u << BENCH_SORT_KEY_DROP) - 1);
+}
+
+static void run_depth_sort(void* context, u32 run) {
+    DepthSortContext* sort = (DepthSortContext*)context;
+    const BenchPose* pose = sort->jumps ? &g_poses[(run & 1) * (BENCH_POSES / 2)] : &g_poses[run % BENCH_POSES];
+    sorting_set_depth_axis(pose->depth_axis);
+    bucket_sort_splats_optimized();
+    sort->last_axis = pose->depth_axis;
+}
+
+// A permutation, far to near by the sort's own keys
+static bool check_depth_sort(void* context) {
+    DepthSortContext* sort = (DepthSortContext*)context;
+    const SceneSet* set = sort->set;
+    const u32* order = sorting_get_order();
+    if (!order) return false;
+
+    u8* seen = (u8*)calloc(set->count, 1);
+    u32 duplicates = 0, inversions = 0;
+    u32 previous = 0;
+    for (u32 i = 0; i < set->count; i++) {
+        u32 index = order[i];
+        if (index >= set->count || seen[index]) {
+            duplicates++;
+            continue;
+        }
+        seen[index] = 1;
+        u32 key = depth_sort_key(sort->last_axis, set->packed[index].position);
+        if (i > 0 && key < previous) {
+            inversions++;
+        }
+        previous = key;
+    }
+    free(seen);
+
+    if (duplicates || inversions) {
+        fprintf(stderr, "bench: %s depth sort: %u bad indices, %u out of order\n", set->name, duplicates,
+                inversions);
+    }
+    return duplicates == 0 && inversions == 0;
+}
+
+static void bench_depth_sort(const SceneSet* set) {
+    if (!bench_selected("depth_sort_full") && !bench_selected("depth_sort_incr")) return;
+
+    // allocate_vu_buffer() never frees: one context per scene, reused by both runs
+    sorting_system_init(set->packed, (int)set->count);
+    DepthSortContext context = {set, NULL, true};
+    if (bench_selected("depth_sort_full")) {
+        bench_run_kernel("depth_sort_full", set->name, set->count, run_depth_sort, &context, check_depth_sort);
+    }
+    if (bench_selected("depth_sort_incr")) {
+        context.jumps = false;
+        bench_run_kernel("depth_sort_incr", set->name, set->count, run_depth_sort, &context, check_depth_sort);
+    }
+    sorting_system_cleanup();
+}
+
+// ============================================================================
+// Projection
+// ============================================================================
+
+typedef struct {
+    const SceneSet* set;
+    GaussianSplat2D* batch_out;
+    u8* batch_visible;
+    GaussianSplat2D* scalar_out;
+    u8* scalar_visible;
+} ProjectContext;
+
+static void run_project_batch(void* context, u32 run) {
+    ProjectContext* project = (ProjectContext*)context;
+    const CameraFixed* camera = &g_poses[run % BENCH_POSES].camera;
+    for (u32 first = 0; first < project->set->count; first += PROJECT_BATCH_MAX) {
+        u32 count = MIN(PROJECT_BATCH_MAX, project->set->count - first);
+        u32 mask = 0;
+        project_gaussian_batch(&project->set->splats[first], NULL, count, camera, &project->batch_out[first], &mask);
+        for (u32 i = 0; i < count; i++) {
+            project->batch_visible[first + i] = (mask >> i) & 1;
+        }
+    }
+}
+
+static void run_project_scalar(void* context, u32 run) {
+    ProjectContext* project = (ProjectContext*)context;
+    const CameraFixed* camera = &g_poses[run % BENCH_POSES].camera;
+    for (u32 i = 0; i < project->set->count; i++) {
+        project->scalar_visible[i] =
+            project_gaussian_complete(&project->set->splats[i], camera, &project->scalar_out[i]) == GAUSSIAN_SUCCESS;
+    }
+}
+
+static inline bool within(s32 a, s32 b, s32 tolerance) {
+    return abs(a - b) <= tolerance;
+}
+
+// Whether the splat center sits on a side plane of the frustum, in
+// doubles: within the far plane's w * 2^-17 of |ndc| = 1 the scalar path's
+// Q16.16 1/w may decide either way
+static bool project_on_edge(const GaussianSplat3D* splat, const CameraFixed* camera) {
+    double view[4], clip[4];
+    for (int row = 0; row < 4; row++) {
+        view[row] = camera->view[row * 4 + 3] / 65536.0;
+        for (int k = 0; k < 3; k++) {
+            view[row] += camera->view[row * 4 + k] / 65536.0 * (splat->pos[k] / 65536.0);
+        }
+    }
+    for (int row = 0; row < 4; row++) {
+        clip[row] = 0.0;
+        for (int k = 0; k < 4; k++) {
+            clip[row] += camera->proj[row * 4 + k] / 65536.0 * view[k];
+        }
+    }
+    if (clip[3] <= 0.0) return false;
+    double band = 1.0 / 1024.0;
+    return fabs(fabs(clip[0] / clip[3]) - 1.0) < band || fabs(fabs(clip[1] / clip[3]) - 1.0) < band;
+}
+
+// The same visible set, but for splats on a frustum side, and every field
+// within its PROJECT_BATCH_TOL_* bound
+static bool check_project(void* context) {
+    ProjectContext* project = (ProjectContext*)context;
+    const SceneSet* set = project->set;
+    u32 visibility = 0, outside = 0, visible = 0;
+
+    for (u32 pose = 0; pose < BENCH_CHECK_POSES; pose++) {
+        u32 run = pose * (BENCH_POSES / BENCH_CHECK_POSES);
+        run_project_batch(project, run);
+        run_project_scalar(project, run);
+
+        for (u32 i = 0; i < set->count; i++) {
+            if (project->batch_visible[i] != project->scalar_visible[i]) {
+                visibility += !project_on_edge(&set->splats[i], &g_poses[run % BENCH_POSES].camera);
+                continue;
+            }
+            if (!project->scalar_visible[i]) continue;
+            visible++;
+
+            const GaussianSplat2D* a = &project->batch_out[i];
+            const GaussianSplat2D* b = &project->scalar_out[i];
+            fixed16_t screen_x = PROJECT_BATCH_TOL_SCREEN_AT(fixed_from_int(BENCH_RENDER_WIDTH), b->depth);
+            fixed16_t screen_y = PROJECT_BATCH_TOL_SCREEN_AT(fixed_from_int(BENCH_RENDER_HEIGHT), b->depth);
+            bool ok = within(a->screen_pos[0], b->screen_pos[0], screen_x) &&
+                      within(a->screen_pos[1], b->screen_pos[1], screen_y) &&
+                      within(a->depth, b->depth, PROJECT_BATCH_TOL_DEPTH) &&
+                      within(a->radius, b->radius, PROJECT_BATCH_TOL_RADIUS) &&
+                      within(a->eigenvals[0], b->eigenvals[0], PROJECT_BATCH_TOL_EIGEN) &&
+                      within(a->eigenvals[1], b->eigenvals[1], PROJECT_BATCH_TOL_EIGEN);
+            for (int k = 0; k < 4; k++) {
+                ok = ok && within(a->cov_2d[k], b->cov_2d[k], PROJECT_BATCH_TOL_COV);
+            }
+            if (!ok && outside++ == 0) {
+                fprintf(stderr,
+                        "bench: %s projection of splat %u: screen %d,%d vs %d,%d, depth %u vs %u, radius %d vs %d, "
+                        "eigen %d,%d vs %d,%d, cov %d,%d,%d,%d vs %d,%d,%d,%d\n",
+                        set->name, i, a->screen_pos[0], a->screen_pos[1], b->screen_pos[0], b->screen_pos[1],
+                        a->depth, b->depth, a->radius, b->radius, a->eigenvals[0], a->eigenvals[1],
+                        b->eigenvals[0], b->eigenvals[1], a->cov_2d[0], a->cov_2d[1], a->cov_2d[2], a->cov_2d[3],
+                        b->cov_2d[0], b->cov_2d[1], b->cov_2d[2], b->cov_2d[3]);
+            }
+        }
+    }
+
+    if (visibility || outside) {
+        fprintf(stderr, "bench: %s projection: %u visibility mismatches, %u of %u splats past tolerance\n",
+                set->name, visibility, outside, visible);
+    }
+    return visibility == 0 && outside == 0;
+}
+
+static bool check_none(void* context) {
+    (void)context;
+    return true;
+}
+
+static void bench_project(const SceneSet* set) {
+    if (!bench_selected("project_batch") && !bench_selected("project_scalar")) return;
+
+    ProjectContext context = {set, (GaussianSplat2D*)calloc(set->count, sizeof(GaussianSplat2D)),
+                              (u8*)calloc(set->count, 1), (GaussianSplat2D*)calloc(set->count, sizeof(GaussianSplat2D)),
+                              (u8*)calloc(set->count, 1)};
+    if (bench_selected("project_scalar")) {
+        bench_run_kernel("project_scalar", set->name, set->count, run_project_scalar, &context, check_none);
+    }
+    if (bench_selected("project_batch")) {
+        bench_run_kernel("project_batch", set->name, set->count, run_project_batch, &context, check_project);
+    }
+    free(context.batch_out);
+    free(context.batch_visible);
+    free(context.scalar_out);
+    free(context.scalar_visible);
+}
+
+// ============================================================================
+// Fixed-point math
+// ============================================================================
+
+typedef struct {
+    u32 count;                                // Multiple of 4
+    fixed16_t* a;
+    fixed16_t* b;
+    fixed16_t* c;
+    fixed16_t* out;
+    volatile fixed16_t sink;
+} MathContext;
+
+// Magnitudes spread evenly over 2^-8 .. 2^7, either sign
+static fixed16_t math_value(void) {
+    fixed16_t value = (fixed16_t)(ldexpf(bench_uniform(1.0f, 2.0f), (int)(bench_random() % 15) - 8) * FIXED16_SCALE);
+    return (bench_random() & 1) ? -value : value;
+}
+
+static void run_fixed_mul(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed_mul(math->a[i], math->b[i]);
+    }
+}
+
+static void run_fixed16_mul(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed16_mul(math->a[i], math->b[i]);
+    }
+}
+
+static void run_fixed16_div(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed16_div(math->a[i], math->b[i]);
+    }
+}
+
+static void run_fixed16x4_mul(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i += 4) {
+        fixed16x4_store(&math->out[i], fixed16x4_mul(fixed16x4_load(&math->a[i]), fixed16x4_load(&math->b[i])));
+    }
+}
+
+// Lanes of a, b and c as x, y and z of four vectors, dotted with themselves
+static void run_fixed16x4_dot3(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i += 4) {
+        fixed16x4 x = fixed16x4_load(&math->a[i]);
+        fixed16x4 y = fixed16x4_load(&math->b[i]);
+        fixed16x4 z = fixed16x4_load(&math->c[i]);
+        fixed16x4_store(&math->out[i], fixed16x4_dot3(x, y, z, x, y, z));
+    }
+}
+
+static void run_fixed_recip(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed_recip_newton(math->a[i]);
+    }
+}
+
+static void run_fixed16x4_recip(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i += 4) {
+        fixed16x4_store(&math->out[i], fixed16x4_recip(fixed16x4_load(&math->a[i])));
+    }
+}
+
+static void run_fixed_sqrt_lut(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed_sqrt_lut(abs(math->a[i]));
+    }
+}
+
+static void run_fixed16_sqrt(void* context, u32 run) {
+    MathContext* math = (MathContext*)context;
+    (void)run;
+    for (u32 i = 0; i < math->count; i++) {
+        math->out[i] = fixed16_sqrt(abs(math->a[i]));
+    }
+}
+
+static bool math_report_errors(const char* kernel, u32 errors, u32 count) {
+    if (errors) {
+        fprintf(stderr, "bench: %s: %u of %u results past tolerance\n", kernel, errors, count);
+    }
+    return errors == 0;
+}
+
+// fixed_mul is the 64-bit product's bits 16..47, exactly
+static bool check_fixed_mul(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != (fixed16_t)(((s64)math->a[i] * math->b[i]) >> 16);
+    }
+    return math_report_errors("fixed_mul", errors, math->count);
+}
+
+static fixed16_t saturate(s64 value) {
+    return (fixed16_t)CLAMP(value, (s64)FIXED16_MIN, (s64)FIXED16_MAX);
+}
+
+// fixed16_mul and fixed16_div: the 64-bit result saturated to Q16.16
+static bool check_fixed16_mul(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != saturate(((s64)math->a[i] * math->b[i]) >> 16);
+    }
+    return math_report_errors("fixed16_mul", errors, math->count);
+}
+
+static bool check_fixed16_div(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != saturate(((s64)math->a[i] << 16) / math->b[i]);
+    }
+    return math_report_errors("fixed16_div", errors, math->count);
+}
+
+static bool check_fixed16x4_dot3(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        fixed16_t sum = fixed_mul(math->a[i], math->a[i]) + fixed_mul(math->b[i], math->b[i]) +
+                        fixed_mul(math->c[i], math->c[i]);
+        errors += !within(math->out[i], sum, 2);
+    }
+    return math_report_errors("fixed16x4_dot3", errors, math->count);
+}
+
+// Within 2^-12 of 1/d, or 2 LSB for the small reciprocals
+static bool check_fixed_recip(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        double expected = 65536.0 * 65536.0 / math->a[i];
+        errors += fabs(math->out[i] - expected) > MAX(fabs(expected) / 4096.0, 2.0);
+    }
+    return math_report_errors("fixed_recip_newton", errors, math->count);
+}
+
+// The 4-wide reciprocal takes fixed_recip_newton()'s steps exactly
+static bool check_fixed16x4_recip(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != fixed_recip_newton(math->a[i]);
+    }
+    return math_report_errors("fixed16x4_recip", errors, math->count);
+}
+
+static bool check_fixed16x4_mul(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != fixed_mul(math->a[i], math->b[i]);
+    }
+    return math_report_errors("fixed16x4_mul", errors, math->count);
+}
+
+// Truncated 8-bit entries, nearest entry: within 1% of the root, or 2 LSB
+static bool check_fixed_sqrt_lut(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        double expected = sqrt(abs(math->a[i]) * 65536.0);
+        errors += fabs(math->out[i] - expected) > MAX(expected / 100.0, 2.0);
+    }
+    return math_report_errors("fixed_sqrt_lut", errors, math->count);
+}
+
+// Exact: the root rounded down
+static bool check_fixed16_sqrt(void* context) {
+    MathContext* math = (MathContext*)context;
+    u32 errors = 0;
+    for (u32 i = 0; i < math->count; i++) {
+        errors += math->out[i] != (fixed16_t)floor(sqrt((double)abs(math->a[i]) * 65536.0));
+    }
+    return math_report_errors("fixed16_sqrt", errors, math->count);
+}
+
+static void bench_math(u32 count) {
+    static const struct {
+        const char* name;
+        BenchRun run;
+        bool (*check)(void* context);
+    } kernels[] = {
+        {"fixed_mul", run_fixed_mul, check_fixed_mul},
+        {"fixed16_mul", run_fixed16_mul, check_fixed16_mul},
+        {"fixed16_div", run_fixed16_div, check_fixed16_div},
+        {"fixed16x4_mul", run_fixed16x4_mul, check_fixed16x4_mul},
+        {"fixed16x4_dot3", run_fixed16x4_dot3, check_fixed16x4_dot3},
+        {"fixed_recip_newton", run_fixed_recip, check_fixed_recip},
+        {"fixed16x4_recip", run_fixed16x4_recip, check_fixed16x4_recip},
+        {"fixed_sqrt_lut", run_fixed_sqrt_lut, check_fixed_sqrt_lut},
+        {"fixed16_sqrt", run_fixed16_sqrt, check_fixed16_sqrt},
+    };
+
+    MathContext context;
+    context.count = count;
+    context.a = (fixed16_t*)bench_alloc(16, count * sizeof(fixed16_t));
+    context.b = (fixed16_t*)bench_alloc(16, count * sizeof(fixed16_t));
+    context.c = (fixed16_t*)bench_alloc(16, count * sizeof(fixed16_t));
+    context.out = (fixed16_t*)bench_alloc(16, count * sizeof(fixed16_t));
+    g_rng = 0xC2B2AE35u ^ count;
+    for (u32 i = 0; i < count; i++) {
+        context.a[i] = math_value();
+        context.b[i] = math_value();
+        context.c[i] = math_value();
+    }
+
+    for (u32 k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (bench_selected(kernels[k].name)) {
+            bench_run_kernel(kernels[k].name, "log-uniform", count, kernels[k].run, &context, kernels[k].check);
+        }
+    }
+
+    free(context.a);
+    free(context.b);
+    free(context.c);
+    free(context.out);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(void) {
+    fprintf(stderr, "usage: bench_kernels [--quick] [--runs N] [--filter TEXT] [--splats FILE]...\n"
+                    "  --quick        smaller sizes and shorter timing\n"
+                    "  --runs N       at least N timed runs per kernel (default 3)\n"
+                    "  --filter TEXT  only kernels whose name contains TEXT\n"
+                    "  --splats FILE  a bench_capture=<frame>:<file> capture, binned and sorted as recorded\n");
+}
+
+int main(int argc, char** argv) {
+    setvbuf(stdout, NULL, _IOLBF, 0);  // Rows and stderr findings in order
+    for (int arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "--quick") == 0) {
+            g_options.quick = true;
+        } else if (strcmp(argv[arg], "--runs") == 0 && arg + 1 < argc) {
+            g_options.min_runs = (u32)CLAMP(atoi(argv[++arg]), 1, BENCH_MAX_SAMPLES);
+        } else if (strcmp(argv[arg], "--filter") == 0 && arg + 1 < argc) {
+            g_options.filter = argv[++arg];
+        } else if (strcmp(argv[arg], "--splats") == 0 && arg + 1 < argc) {
+            if (g_options.splat_file_count < BENCH_MAX_SPLAT_FILES) {
+                g_options.splat_files[g_options.splat_file_count++] = argv[++arg];
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // Engine setup the kernels depend on; its messages go before the table
+    GaussianLUTs luts;
+    fixed_math_init();
+    if (gaussian_luts_generate_all(&luts) != GAUSSIAN_SUCCESS || tile_system_init(MAX_SPLATS_PER_SCENE) != 0) {
+        fprintf(stderr, "bench: engine setup failed\n");
+        return 1;
+    }
+    for (u32 pose = 0; pose < BENCH_POSES; pose++) {
+        bench_pose(&g_poses[pose], pose * 6.2831853f / BENCH_POSES, 30.0f);
+    }
+
+    u32 size_count = g_options.quick ? 2 : sizeof(g_sizes) / sizeof(g_sizes[0]);
+    printf("\n%-18s %-20s %8s %11s %11s %9s  %s\n", "kernel", "distribution", "items", "min_us", "median_us",
+           "ns/item", "check");
+
+    for (u32 s = 0; s < size_count; s++) {
+        bench_math(g_sizes[s]);
+    }
+
+    for (u32 s = 0; s < size_count; s++) {
+        for (u32 d = 0; d < RENDER_DISTRIBUTIONS; d++) {
+            RenderSet set;
+            render_set_generate(&set, (RenderDistribution)d, g_sizes[s]);
+            bench_tiles(&set);
+            free(set.splats);
+        }
+    }
+
+    for (u32 f = 0; f < g_options.splat_file_count; f++) {
+        RenderSet set;
+        if (!render_set_load(&set, g_options.splat_files[f])) {
+            g_failures++;
+            continue;
+        }
+        bench_tiles(&set);
+        free(set.splats);
+    }
+
+    u32 scene_size_count = g_options.quick ? 2 : sizeof(g_scene_sizes) / sizeof(g_scene_sizes[0]);
+    for (u32 s = 0; s < scene_size_count; s++) {
+        for (u32 d = 0; d < SCENE_DISTRIBUTIONS; d++) {
+            SceneSet set;
+            scene_set_generate(&set, (SceneDistribution)d, g_scene_sizes[s]);
+            bench_cull(&set);
+            bench_depth_sort(&set);
+            bench_project(&set);
+            free(set.splats);
+            free(set.packed);
+        }
+    }
+
+    // Larger scene than the visible cap, in quick runs too
+    SceneSet budget_set;
+    scene_set_generate(&budget_set, SCENE_UNIFORM, BENCH_BUDGET_SCENE);
+    bench_cull_budget(&budget_set);
+    free(budget_set.splats);
+    free(budget_set.packed);
+
+    cleanup_frustum_culling();
+    tile_system_cleanup();
+    printf("\n%u check%s failed\n", g_failures, g_failures == 1 ? "" : "s");
+    return g_failures ? 1 : 0;
+}
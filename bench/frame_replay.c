@@ -0,0 +1,611 @@
+/*
+ * SPLATSTORM X - Frame Replay
+ * Replays a frame captured on hardware with capture=<frame>:<file>
+ * (src/frame_capture.c) through the host build of the tile kernels
+ * (make frame-replay REPLAY_ARGS="<file> ..."), so a view that is slow on
+ * the console can be reproduced, checked and timed on the build machine.
+ *
+ * - Screen-space LOD runs again on the captured VU1 output and is compared
+ *   with the captured result. It is float code: the EE FPU rounds
+ *   differently, so an odd splat may differ by an LSB.
+ * - Tiling (process_tiles) runs on the captured LOD output with the
+ *   frame's tile settings; every bin must match the captured one, splat
+ *   for splat, and so must the render regions built from them.
+ * - Binning, the per-tile sort, region building and LOD are timed.
+ * - The captured GIF chain is walked as the GIF consumes it: tags, A+D
+ *   register writes, primitives and the pixels the sprites cover inside
+ *   their scissor. --dump-gif lists every tag.
+ *
+ * Usage: frame_replay FILE [--runs N] [--dump-gif]
+ * Exits non-zero when the file cannot be read or a replay differs.
+ */
+
+#include "splatstorm_x.h"
+#include "gaussian_types.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPLAY_MAX_SAMPLES      1000
+#define REPLAY_DEFAULT_RUNS     20
+#define REPLAY_SECTION_KINDS    (FRAME_CAPTURE_SECTION_GIF + 1)
+
+// GS registers the chain walk follows
+#define GS_REG_PRIM             0x00
+#define GS_REG_XYZ2             0x05
+#define GS_REG_XYZOFFSET_1      0x18
+#define GS_REG_SCISSOR_1        0x40
+#define GS_REG_COUNT            0x100
+#define GS_PRIM_SPRITE          6
+#define GIF_REG_AD              0x0E
+#define GIF_REG_NOP             0x0F
+
+// Capture file layout (frame_capture.c)
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 header_size;
+    u32 frame;
+    u16 width;
+    u16 height;
+    u32 flags;
+    float saturation_epsilon;
+    u8 quality_level;
+    u8 render_mode;
+    u16 reserved;
+} ReplayHeader;
+
+typedef struct {
+    u32 id;
+    u32 record_size;
+    u32 count;
+    u32 reserved;
+} ReplaySection;
+
+typedef struct {
+    const void* data;                         // First section of the kind, NULL when absent
+    u32 count;
+} ReplayStage;
+
+static struct {
+    ReplayHeader header;
+    u8* file_data;
+    ReplayStage stages[REPLAY_SECTION_KINDS];
+    u64* gif;                                 // GIF sections joined in file order
+    u32 gif_qwords;
+    u32 gif_chunks;
+} g_replay;
+
+static struct {
+    u32 min_runs;
+    bool dump_gif;
+} g_options = {REPLAY_DEFAULT_RUNS, false};
+
+static u32 g_failures;
+static double g_samples[REPLAY_MAX_SAMPLES];
+
+// ============================================================================
+// Capture file
+// ============================================================================
+
+static u32 replay_record_size(u32 id) {
+    switch (id) {
+        case FRAME_CAPTURE_SECTION_CAMERA:         return sizeof(CameraFixed);
+        case FRAME_CAPTURE_SECTION_PROJECTED:
+        case FRAME_CAPTURE_SECTION_LOD:            return sizeof(GaussianSplatRender);
+        case FRAME_CAPTURE_SECTION_TILE_RANGES:    return sizeof(TileRange);
+        case FRAME_CAPTURE_SECTION_REGIONS:        return sizeof(TileRegion);
+        case FRAME_CAPTURE_SECTION_GIF:            return 16;
+        default:                                   return sizeof(u32);
+    }
+}
+
+static bool replay_load(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "replay: cannot open %s\n", filename);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    g_replay.file_data = (u8*)malloc(size > 0 ? (size_t)size : 1);
+    bool ok = g_replay.file_data && size >= (long)sizeof(ReplayHeader) &&
+              fread(g_replay.file_data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    memcpy(&g_replay.header, g_replay.file_data, ok ? sizeof(ReplayHeader) : 0);
+    if (!ok || g_replay.header.magic != FRAME_CAPTURE_MAGIC || g_replay.header.version != FRAME_CAPTURE_VERSION ||
+        g_replay.header.header_size != sizeof(ReplayHeader)) {
+        fprintf(stderr, "replay: %s is not a version %u frame capture\n", filename, FRAME_CAPTURE_VERSION);
+        return false;
+    }
+
+    // Two passes over the sections: check and size the GIF chain, then join it
+    for (int pass = 0; pass < 2; pass++) {
+        u32 offset = sizeof(ReplayHeader);
+        u32 gif_qwords = 0;
+        while (offset + sizeof(ReplaySection) <= (u32)size) {
+            ReplaySection section;
+            memcpy(&section, g_replay.file_data + offset, sizeof(section));
+            offset += sizeof(section);
+            u64 bytes = (u64)section.record_size * section.count;
+            if (section.id == 0 || section.id >= REPLAY_SECTION_KINDS ||
+                section.record_size != replay_record_size(section.id) || bytes > (u32)size - offset) {
+                fprintf(stderr, "replay: %s: bad section %u at byte %u\n", filename, section.id,
+                        offset - (u32)sizeof(section));
+                return false;
+            }
+
+            if (section.id == FRAME_CAPTURE_SECTION_GIF) {
+                if (pass == 1) {
+                    memcpy(&g_replay.gif[gif_qwords * 2], g_replay.file_data + offset, (size_t)bytes);
+                    g_replay.gif_chunks++;
+                }
+                gif_qwords += section.count;
+            } else if (pass == 0 && !g_replay.stages[section.id].data) {
+                g_replay.stages[section.id].data = g_replay.file_data + offset;
+                g_replay.stages[section.id].count = section.count;
+            }
+            offset += (u32)bytes;
+        }
+
+        if (pass == 0) {
+            g_replay.gif_qwords = gif_qwords;
+            g_replay.gif = (u64*)calloc(gif_qwords ? gif_qwords : 1, 16);
+            if (!g_replay.gif) return false;
+        }
+    }
+    return true;
+}
+
+// A stage copied to 16-byte aligned memory, as the kernels expect
+static void* replay_copy(u32 id, u32 extra_records) {
+    const ReplayStage* stage = &g_replay.stages[id];
+    size_t bytes = (size_t)(stage->count + extra_records) * replay_record_size(id);
+    void* copy = NULL;
+    if (posix_memalign(&copy, 64, bytes ? bytes : 16) != 0) return NULL;
+    memcpy(copy, stage->data, (size_t)stage->count * replay_record_size(id));
+    return copy;
+}
+
+static void replay_report(const char* stage, u32 mismatched, u32 total, const char* what) {
+    if (mismatched == 0) {
+        printf("%-8s ok: %u %s match the capture\n", stage, total, what);
+    } else {
+        printf("%-8s DIFFERS: %u of %u %s\n", stage, mismatched, total, what);
+        g_failures++;
+    }
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+typedef void (*ReplayRun)(void* context);
+
+static double replay_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec * 1e-3;
+}
+
+static int replay_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void replay_time(const char* kernel, u32 items, ReplayRun run, void* context) {
+    u32 count = MIN(g_options.min_runs, REPLAY_MAX_SAMPLES);
+    for (u32 i = 0; i < count; i++) {
+        double t0 = replay_now_us();
+        run(context);
+        g_samples[i] = replay_now_us() - t0;
+    }
+    qsort(g_samples, count, sizeof(double), replay_compare_double);
+    printf("%-18s %8u %11.1f %11.1f %9.2f\n", kernel, items, g_samples[0], g_samples[count / 2],
+           items ? g_samples[count / 2] * 1000.0 / items : 0.0);
+}
+
+// ============================================================================
+// LOD, tiling and regions
+// ============================================================================
+
+typedef struct {
+    GaussianSplatRender* input;               // Captured VU1 output, kept intact
+    GaussianSplatRender* work;
+    u32 input_count;
+    GaussianSplatRender* splats;              // Captured LOD output
+    u32 count;
+    TileRegion* regions;
+} ReplayContext;
+
+static void run_lod(void* context) {
+    ReplayContext* replay = (ReplayContext*)context;
+    memcpy(replay->work, replay->input, replay->input_count * sizeof(GaussianSplatRender));
+    frame_arena_begin();
+    tile_lod_aggregate(replay->work, replay->input_count);
+}
+
+static void run_bin(void* context) {
+    ReplayContext* replay = (ReplayContext*)context;
+    assign_splats_to_tiles(replay->splats, replay->count);
+}
+
+static void run_sort(void* context) {
+    ReplayContext* replay = (ReplayContext*)context;
+    sort_splats_by_depth(replay->splats);
+}
+
+static void run_bin_sort(void* context) {
+    run_bin(context);
+    run_sort(context);
+}
+
+static void run_regions(void* context) {
+    ReplayContext* replay = (ReplayContext*)context;
+    tile_build_render_regions(replay->splats, replay->count, replay->regions, TILE_MAX_REGIONS);
+}
+
+static void replay_lod(ReplayContext* context) {
+    if (!context->input) {
+        printf("lod      skipped: no projected splats in the capture\n");
+        return;
+    }
+    u32 count = g_replay.stages[FRAME_CAPTURE_SECTION_LOD].count;
+    frame_arena_begin();
+    memcpy(context->work, context->input, context->input_count * sizeof(GaussianSplatRender));
+    u32 replayed = tile_lod_aggregate(context->work, context->input_count);
+    u32 mismatched = (replayed != count) ? MAX(replayed, count) : 0;
+    for (u32 i = 0; i < count && replayed == count; i++) {
+        mismatched += memcmp(&context->work[i], &context->splats[i], sizeof(GaussianSplatRender)) != 0;
+    }
+    if (replayed != count) {
+        printf("lod      %u splats from %u, capture has %u\n", replayed, context->input_count, count);
+    }
+    replay_report("lod", mismatched, count, "aggregated splats");
+}
+
+static void replay_tiles(ReplayContext* context) {
+    const TileRange* captured = (const TileRange*)g_replay.stages[FRAME_CAPTURE_SECTION_TILE_RANGES].data;
+    const u32* lists = (const u32*)g_replay.stages[FRAME_CAPTURE_SECTION_TILE_LISTS].data;
+    u32 list_entries = g_replay.stages[FRAME_CAPTURE_SECTION_TILE_LISTS].count;
+    if (!captured || g_replay.stages[FRAME_CAPTURE_SECTION_TILE_RANGES].count != MAX_TILES || !lists) {
+        printf("tiles    skipped: no tile ranges in the capture\n");
+        return;
+    }
+
+    CameraFixed camera;
+    memcpy(&camera, g_replay.stages[FRAME_CAPTURE_SECTION_CAMERA].data, sizeof(camera));
+    TileRange* ranges = (TileRange*)calloc(MAX_TILES, sizeof(TileRange));
+    if (!ranges || process_tiles(context->splats, context->count, &camera, ranges) != 0) {
+        printf("tiles    DIFFERS: process_tiles failed\n");
+        g_failures++;
+        free(ranges);
+        return;
+    }
+
+    u32 mismatched = 0;
+    u32 overlaps = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32 count = 0;
+        const u32* bin = get_tile_splat_list(tile_id, &count);
+        const TileRange* expected = &captured[tile_id];
+        bool same = count == expected->count && ranges[tile_id].min_depth == expected->min_depth &&
+                    ranges[tile_id].max_depth == expected->max_depth &&
+                    expected->start_index + expected->count <= list_entries &&
+                    (count == 0 || (bin && memcmp(bin, &lists[expected->start_index], count * sizeof(u32)) == 0));
+        if (!same && mismatched++ == 0) {
+            fprintf(stderr, "replay: tile %u,%u: %u splats, capture has %u\n", tile_id % TILES_X, tile_id / TILES_X,
+                    count, expected->count);
+        }
+        overlaps += count;
+    }
+    free(ranges);
+    replay_report("tiles", mismatched, MAX_TILES, "tile bins");
+    printf("tiles    %u overlaps, %.2f per splat\n", overlaps, context->count ? (double)overlaps / context->count : 0.0);
+
+    const TileRegion* regions = (const TileRegion*)g_replay.stages[FRAME_CAPTURE_SECTION_REGIONS].data;
+    const u32* indices = (const u32*)g_replay.stages[FRAME_CAPTURE_SECTION_REGION_INDICES].data;
+    u32 region_count = g_replay.stages[FRAME_CAPTURE_SECTION_REGIONS].count;
+    u32 index_count = g_replay.stages[FRAME_CAPTURE_SECTION_REGION_INDICES].count;
+    u32 built = tile_build_render_regions(context->splats, context->count, context->regions, TILE_MAX_REGIONS);
+    const u32* built_indices = tile_get_region_indices();
+
+    mismatched = (built != region_count) ? MAX(built, region_count) : 0;
+    for (u32 r = 0; r < region_count && built == region_count; r++) {
+        const TileRegion* expected = &regions[r];
+        const TileRegion* region = &context->regions[r];
+        bool same = memcmp(region, expected, sizeof(TileRegion)) == 0 &&
+                    expected->start_index + expected->count <= index_count &&
+                    memcmp(&built_indices[region->start_index], &indices[expected->start_index],
+                           expected->count * sizeof(u32)) == 0;
+        mismatched += !same;
+    }
+    if (built != region_count) {
+        printf("regions  %u built, capture has %u\n", built, region_count);
+    }
+    replay_report("regions", mismatched, region_count, "render regions");
+}
+
+static void replay_timings(ReplayContext* context) {
+    if (!context->splats) return;
+
+    printf("\n%-18s %8s %11s %11s %9s\n", "kernel", "items", "min_us", "median_us", "ns/item");
+    if (context->input) {
+        replay_time("lod_aggregate", context->input_count, run_lod, context);
+    }
+    replay_time("tile_bin", context->count, run_bin, context);
+    run_bin(context);
+    replay_time("tile_sort", context->count, run_sort, context);
+    run_bin_sort(context);
+    replay_time("render_regions", context->count, run_regions, context);
+}
+
+// ============================================================================
+// GIF chain
+// ============================================================================
+
+static const char* gs_register_name(u32 reg) {
+    switch (reg) {
+        case 0x00: return "PRIM";        case 0x01: return "RGBAQ";       case 0x02: return "ST";
+        case 0x03: return "UV";          case 0x04: return "XYZF2";       case 0x05: return "XYZ2";
+        case 0x06: return "TEX0_1";      case 0x07: return "TEX0_2";      case 0x08: return "CLAMP_1";
+        case 0x09: return "CLAMP_2";     case 0x0A: return "FOG";         case 0x0C: return "XYZF3";
+        case 0x0D: return "XYZ3";        case 0x14: return "TEX1_1";      case 0x15: return "TEX1_2";
+        case 0x16: return "TEX2_1";      case 0x17: return "TEX2_2";      case 0x18: return "XYZOFFSET_1";
+        case 0x19: return "XYZOFFSET_2"; case 0x1A: return "PRMODECONT";  case 0x1B: return "PRMODE";
+        case 0x1C: return "TEXCLUT";     case 0x22: return "SCANMSK";     case 0x3B: return "TEXA";
+        case 0x3D: return "FOGCOL";      case 0x3F: return "TEXFLUSH";    case 0x40: return "SCISSOR_1";
+        case 0x41: return "SCISSOR_2";   case 0x42: return "ALPHA_1";     case 0x43: return "ALPHA_2";
+        case 0x44: return "DIMX";        case 0x45: return "DTHE";        case 0x46: return "COLCLAMP";
+        case 0x47: return "TEST_1";      case 0x48: return "TEST_2";      case 0x49: return "PABE";
+        case 0x4A: return "FBA_1";       case 0x4B: return "FBA_2";       case 0x4C: return "FRAME_1";
+        case 0x4D: return "FRAME_2";     case 0x4E: return "ZBUF_1";      case 0x4F: return "ZBUF_2";
+        case 0x50: return "BITBLTBUF";   case 0x51: return "TRXPOS";      case 0x52: return "TRXREG";
+        case 0x53: return "TRXDIR";      case 0x54: return "HWREG";       case 0x60: return "SIGNAL";
+        case 0x61: return "FINISH";      case 0x62: return "LABEL";
+        default:   return NULL;
+    }
+}
+
+typedef struct {
+    u64 prim;
+    u64 offset[2];                            // XYZOFFSET per context
+    u64 scissor[2];                           // SCISSOR per context
+    u64 vertex;                               // First XYZ2 of a sprite
+    bool vertex_pending;
+
+    u32 writes[GS_REG_COUNT];                 // Register writes, A+D and REGLIST
+    u32 tags[4];                              // By FLG
+    u32 image_qwords;
+    u32 sprites;
+    u32 other_vertices;                       // Kicks of anything but sprites
+    double sprite_pixels;                     // Covered inside the scissor
+} GifWalk;
+
+// One register write as the GS would take it
+static void gif_write(GifWalk* walk, u32 reg, u64 value) {
+    walk->writes[reg & (GS_REG_COUNT - 1)]++;
+    u32 context = (walk->prim >> 9) & 1;
+
+    if (reg == GS_REG_PRIM) {
+        walk->prim = value;
+        walk->vertex_pending = false;
+    } else if (reg == GS_REG_XYZOFFSET_1 || reg == GS_REG_XYZOFFSET_1 + 1) {
+        walk->offset[reg - GS_REG_XYZOFFSET_1] = value;
+    } else if (reg == GS_REG_SCISSOR_1 || reg == GS_REG_SCISSOR_1 + 1) {
+        walk->scissor[reg - GS_REG_SCISSOR_1] = value;
+    } else if (reg == GS_REG_XYZ2) {
+        if ((walk->prim & 7) != GS_PRIM_SPRITE) {
+            walk->other_vertices++;
+            return;
+        }
+        if (!walk->vertex_pending) {
+            walk->vertex = value;
+            walk->vertex_pending = true;
+            return;
+        }
+        walk->vertex_pending = false;
+        walk->sprites++;
+
+        // Window coordinates in 12.4, clipped to the scissor (inclusive pixels)
+        s32 ofx = (s32)(walk->offset[context] & 0xFFFF);
+        s32 ofy = (s32)((walk->offset[context] >> 32) & 0xFFFF);
+        s32 x0 = (s32)(walk->vertex & 0xFFFF) - ofx, y0 = (s32)((walk->vertex >> 16) & 0xFFFF) - ofy;
+        s32 x1 = (s32)(value & 0xFFFF) - ofx, y1 = (s32)((value >> 16) & 0xFFFF) - ofy;
+        u64 scissor = walk->scissor[context];
+        s32 sx0 = (s32)(scissor & 0x7FF) << 4, sx1 = ((s32)((scissor >> 16) & 0x7FF) + 1) << 4;
+        s32 sy0 = (s32)((scissor >> 32) & 0x7FF) << 4, sy1 = ((s32)((scissor >> 48) & 0x7FF) + 1) << 4;
+        s32 left = MAX(MIN(x0, x1), sx0), right = MIN(MAX(x0, x1), sx1);
+        s32 top = MAX(MIN(y0, y1), sy0), bottom = MIN(MAX(y0, y1), sy1);
+        if (right > left && bottom > top) {
+            walk->sprite_pixels += (double)(right - left) * (bottom - top) / 256.0;
+        }
+    }
+}
+
+static void replay_gif(void) {
+    if (g_replay.gif_qwords == 0) {
+        printf("\ngif      no PATH3 chain in the capture\n");
+        return;
+    }
+
+    GifWalk walk;
+    memset(&walk, 0, sizeof(walk));
+    walk.scissor[0] = walk.scissor[1] = ((u64)2047 << 16) | ((u64)2047 << 48);
+
+    const u64* chain = g_replay.gif;
+    u32 qword = 0;
+    bool truncated = false;
+    while (qword < g_replay.gif_qwords) {
+        u64 tag = chain[qword * 2];
+        u64 regs = chain[qword * 2 + 1];
+        u32 nloop = (u32)(tag & 0x7FFF);
+        u32 flg = (u32)((tag >> 58) & 3);
+        u32 nreg = (u32)((tag >> 60) & 0xF);
+        nreg = nreg ? nreg : 16;
+        walk.tags[flg]++;
+
+        if (g_options.dump_gif) {
+            static const char* const kinds[4] = {"PACKED", "REGLIST", "IMAGE", "IMAGE"};
+            printf("  %6u %-7s nloop %4u nreg %2u%s%s\n", qword, kinds[flg], nloop, nreg,
+                   (tag >> 15) & 1 ? " eop" : "", (tag >> 46) & 1 ? " pre" : "");
+        }
+        if ((tag >> 46) & 1) {
+            gif_write(&walk, GS_REG_PRIM, (tag >> 47) & 0x7FF);
+        }
+        qword++;
+
+        u32 data_qwords = (flg == 0) ? nloop * nreg : (flg == 1) ? (nloop * nreg + 1) / 2 : nloop;
+        if (qword + data_qwords > g_replay.gif_qwords) {
+            truncated = true;
+            break;
+        }
+
+        if (flg == 0) {
+            for (u32 i = 0; i < nloop * nreg; i++) {
+                const u64* data = &chain[(qword + i) * 2];
+                u32 desc = (u32)((regs >> ((i % nreg) * 4)) & 0xF);
+                if (desc == GIF_REG_AD) {
+                    u32 reg = (u32)(data[1] & 0xFF);
+                    gif_write(&walk, reg, data[0]);
+                    if (g_options.dump_gif && reg != GS_REG_XYZ2) {
+                        const char* name = gs_register_name(reg);
+                        printf("           %-11s %016llx\n", name ? name : "?", (unsigned long long)data[0]);
+                    }
+                } else if (desc != GIF_REG_NOP) {
+                    walk.writes[desc]++;  // PACKED forms other than A+D: counted, not decoded
+                }
+            }
+        } else if (flg == 1) {
+            const u64* words = &chain[qword * 2];
+            for (u32 i = 0; i < nloop * nreg; i++) {
+                u32 desc = (u32)((regs >> ((i % nreg) * 4)) & 0xF);
+                if (desc != GIF_REG_NOP && desc != GIF_REG_AD) {
+                    gif_write(&walk, desc, words[i]);
+                }
+            }
+        } else {
+            walk.image_qwords += nloop;
+        }
+        qword += data_qwords;
+    }
+
+    u32 width = g_replay.header.width, height = g_replay.header.height;
+    printf("\ngif      %u qwords (%u KB) in %u chunks: %u PACKED, %u REGLIST, %u IMAGE tags (%u image qwords)\n",
+           g_replay.gif_qwords, g_replay.gif_qwords / 64, g_replay.gif_chunks, walk.tags[0], walk.tags[1],
+           walk.tags[2] + walk.tags[3], walk.image_qwords);
+    printf("gif      %u sprites, %.0f pixels inside their scissors (%.2fx the %ux%u frame), %u other vertex kicks\n",
+           walk.sprites, walk.sprite_pixels, width && height ? walk.sprite_pixels / (width * height) : 0.0, width,
+           height, walk.other_vertices);
+    printf("gif      writes:");
+    for (u32 reg = 0; reg < GS_REG_COUNT; reg++) {
+        if (walk.writes[reg] == 0) continue;
+        const char* name = gs_register_name(reg);
+        if (name) {
+            printf(" %s %u", name, walk.writes[reg]);
+        } else {
+            printf(" 0x%02X %u", reg, walk.writes[reg]);
+        }
+    }
+    printf("\n");
+    if (truncated) {
+        printf("gif      DIFFERS: chain ends inside a GIF packet at qword %u\n", qword);
+        g_failures++;
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(void) {
+    fprintf(stderr, "usage: frame_replay FILE [--runs N] [--dump-gif]\n"
+                    "  FILE        a capture=<frame>:<file> frame capture\n"
+                    "  --runs N    timed runs per kernel (default %u)\n"
+                    "  --dump-gif  list every GIF tag and A+D write of the chain\n", REPLAY_DEFAULT_RUNS);
+}
+
+int main(int argc, char** argv) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    const char* filename = NULL;
+    for (int arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "--runs") == 0 && arg + 1 < argc) {
+            int runs = atoi(argv[++arg]);
+            g_options.min_runs = (u32)CLAMP(runs, 1, REPLAY_MAX_SAMPLES);
+        } else if (strcmp(argv[arg], "--dump-gif") == 0) {
+            g_options.dump_gif = true;
+        } else if (!filename && argv[arg][0] != '-') {
+            filename = argv[arg];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (!filename) {
+        usage();
+        return 2;
+    }
+    if (!replay_load(filename)) {
+        return 1;
+    }
+
+    const ReplayHeader* header = &g_replay.header;
+    printf("Frame %u, %ux%u, %s path, LOD quality %u, saturation %s (%.4f), texture order %s\n", header->frame,
+           header->width, header->height, header->render_mode == VU_RENDER_MODE_XGKICK ? "direct VU1" : "EE tiled",
+           header->quality_level, (header->flags & FRAME_CAPTURE_FLAG_SATURATION) ? "on" : "off",
+           header->saturation_epsilon, (header->flags & FRAME_CAPTURE_FLAG_TEXTURE_ORDER) ? "on" : "off");
+    printf("Visible %u, projected %u, after LOD %u, %u render regions\n\n",
+           g_replay.stages[FRAME_CAPTURE_SECTION_VISIBLE].count, g_replay.stages[FRAME_CAPTURE_SECTION_PROJECTED].count,
+           g_replay.stages[FRAME_CAPTURE_SECTION_LOD].count, g_replay.stages[FRAME_CAPTURE_SECTION_REGIONS].count);
+
+    // The engine state the captured frame ran with
+    u32 splat_count = MAX(g_replay.stages[FRAME_CAPTURE_SECTION_PROJECTED].count,
+                          g_replay.stages[FRAME_CAPTURE_SECTION_LOD].count);
+    fixed_math_init();
+    if (tile_system_init(MAX(splat_count, 1)) != 0 || frame_arena_init(FRAME_ARENA_SIZE) != 0) {
+        fprintf(stderr, "replay: engine setup failed\n");
+        return 1;
+    }
+    tile_set_render_size(header->width, header->height);
+    tile_set_lod_quality(header->quality_level);
+    tile_set_saturation_cull((header->flags & FRAME_CAPTURE_FLAG_SATURATION) != 0, header->saturation_epsilon);
+    tile_set_texture_order((header->flags & FRAME_CAPTURE_FLAG_TEXTURE_ORDER) != 0);
+    tile_set_occlusion_culling(true);
+
+    ReplayContext context = {NULL, NULL, 0, NULL, 0, NULL};
+    if (g_replay.stages[FRAME_CAPTURE_SECTION_PROJECTED].data) {
+        context.input = (GaussianSplatRender*)replay_copy(FRAME_CAPTURE_SECTION_PROJECTED, 0);
+        context.work = (GaussianSplatRender*)replay_copy(FRAME_CAPTURE_SECTION_PROJECTED, 0);
+        context.input_count = g_replay.stages[FRAME_CAPTURE_SECTION_PROJECTED].count;
+    }
+    if (g_replay.stages[FRAME_CAPTURE_SECTION_LOD].data && g_replay.stages[FRAME_CAPTURE_SECTION_CAMERA].data) {
+        context.splats = (GaussianSplatRender*)replay_copy(FRAME_CAPTURE_SECTION_LOD, 0);
+        context.count = g_replay.stages[FRAME_CAPTURE_SECTION_LOD].count;
+        context.regions = (TileRegion*)calloc(TILE_MAX_REGIONS, sizeof(TileRegion));
+    }
+
+    if (context.splats && context.count > 0) {
+        replay_lod(&context);
+        replay_tiles(&context);
+        replay_timings(&context);
+    } else {
+        printf("No EE tiling in the capture: nothing to replay but the GIF chain\n");
+    }
+    replay_gif();
+
+    free(context.input);
+    free(context.work);
+    free(context.splats);
+    free(context.regions);
+    free(g_replay.gif);
+    free(g_replay.file_data);
+    tile_system_cleanup();
+    frame_arena_cleanup();
+    printf("\n%u replay%s differ%s\n", g_failures, g_failures == 1 ? "" : "s", g_failures == 1 ? "s" : "");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+/*
+ * SPLATSTORM X - Host Stand-ins
+ * The engine services the portable kernels call, for host builds
+ * (make bench-host). Memory comes from the C heap, files from POSIX I/O,
+ * scratchpad streams take the engine's own bounce path, and VU0 reports
+ * itself unavailable, so culling runs its EE path. get_cpu_cycles() counts
+ * host time in EE cycles (294.912 MHz), so the engine's own stage
+ * statistics read in host milliseconds.
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define HOST_SPR_STREAM_MIN_BLOCK 32          // As SPR_STREAM_MIN_BLOCK in dma_system_complete.c
+
+ProfileZoneFrame g_profile_zone_frame;
+
+static struct {
+    u8* base;
+    u32 capacity;
+    u32 top;
+} g_host_arena;
+
+static u8 g_host_spr_bounce[SPR_STREAM_HALF_SIZE] __attribute__((aligned(DMA_ALIGNMENT)));
+
+// ============================================================================
+// Logging: errors and warnings to stderr, the rest dropped so it stays out
+// of the timings
+// ============================================================================
+
+static void host_log(const char* level, const char* format, va_list args) {
+    fprintf(stderr, "%s: ", level);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+}
+
+void debug_log_error(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    host_log("ERROR", format, args);
+    va_end(args);
+}
+
+void debug_log_warning(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    host_log("WARNING", format, args);
+    va_end(args);
+}
+
+void debug_log_info(const char* format, ...) {
+    (void)format;
+}
+
+void debug_log_verbose(const char* format, ...) {
+    (void)format;
+}
+
+void boot_profile_begin(const char* name) {
+    (void)name;
+}
+
+void boot_profile_end(void) {
+}
+
+// ============================================================================
+// Time
+// ============================================================================
+
+u64 get_cpu_cycles(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 294912000ULL + (u64)now.tv_nsec * 294912ULL / 1000000ULL;
+}
+
+// ============================================================================
+// Memory
+// ============================================================================
+
+static void* host_aligned_alloc(u32 size, u32 alignment) {
+    void* ptr = NULL;
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+    return posix_memalign(&ptr, alignment, size ? size : 1) == 0 ? ptr : NULL;
+}
+
+void* memory_alloc_at(MemoryBudgetClass budget, u32 size, u32 alignment, const char* file, u32 line) {
+    (void)budget;
+    (void)file;
+    (void)line;
+    return host_aligned_alloc(size, alignment);
+}
+
+void memory_free(void* ptr) {
+    free(ptr);
+}
+
+void* memory_pool_alloc(u32 pool_id, u32 size, u32 alignment, const char* file, u32 line) {
+    (void)pool_id;
+    (void)file;
+    (void)line;
+    return host_aligned_alloc(size, alignment);
+}
+
+void memory_pool_free(u32 pool_id, void* ptr) {
+    (void)pool_id;
+    free(ptr);
+}
+
+// The scratchpad bump allocator in memory_optimized.c never frees; neither
+// does this one
+void* allocate_vu_buffer(size_t size) {
+    return size ? host_aligned_alloc((u32)((size + 15) & ~(size_t)15), VU_ALIGNMENT) : NULL;
+}
+
+int frame_arena_init(u32 size) {
+    if (g_host_arena.base) {
+        return 0;
+    }
+    g_host_arena.base = (u8*)host_aligned_alloc(size, CACHE_LINE_SIZE);
+    g_host_arena.capacity = g_host_arena.base ? size : 0;
+    g_host_arena.top = 0;
+    return g_host_arena.base ? 0 : -1;
+}
+
+void frame_arena_cleanup(void) {
+    free(g_host_arena.base);
+    memset(&g_host_arena, 0, sizeof(g_host_arena));
+}
+
+bool frame_arena_active(void) {
+    return g_host_arena.base != NULL;
+}
+
+void frame_arena_begin(void) {
+    g_host_arena.top = 0;
+}
+
+void* frame_arena_alloc(u32 size, u32 alignment) {
+    if (!g_host_arena.base || size == 0) {
+        return NULL;
+    }
+    if (alignment == 0) {
+        alignment = VU_ALIGNMENT;
+    }
+    u32 offset = (g_host_arena.top + alignment - 1) & ~(alignment - 1);
+    if (offset > g_host_arena.capacity || size > g_host_arena.capacity - offset) {
+        return NULL;
+    }
+    g_host_arena.top = offset + size;
+    return g_host_arena.base + offset;
+}
+
+void frame_arena_mark(FrameArenaStage stage) {
+    (void)stage;
+}
+
+// ============================================================================
+// Files
+// ============================================================================
+
+int open_file_auto(const char* filename, int flags) {
+    return open(filename, flags);
+}
+
+int read_file_data(int fd, void* buffer, size_t size) {
+    return (int)read(fd, buffer, size);
+}
+
+int close_file(int fd) {
+    return close(fd);
+}
+
+// ============================================================================
+// Scratchpad streaming: the bounce path dma_spr_stream() takes before the
+// DMA system is up, block sizes included
+// ============================================================================
+
+GaussianResult dma_spr_stream(const void* records, u32 record_size, const u32* indices, u32 count,
+                              SprStreamKernel kernel, void* user) {
+    if (!records || !kernel || record_size == 0 || (record_size & 15) || record_size > SPR_STREAM_HALF_SIZE) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    const u8* bytes = (const u8*)records;
+    u32 block_records = SPR_STREAM_HALF_SIZE / record_size;
+    block_records = MIN(block_records, MAX(count / 4, HOST_SPR_STREAM_MIN_BLOCK));
+
+    for (u32 first = 0; first < count; first += block_records) {
+        u32 block_count = MIN(block_records, count - first);
+        if (indices) {
+            for (u32 i = 0; i < block_count; i++) {
+                memcpy(&g_host_spr_bounce[i * record_size], bytes + indices[first + i] * record_size, record_size);
+            }
+            kernel(g_host_spr_bounce, first, block_count, user);
+        } else {
+            kernel(bytes + first * record_size, first, block_count, user);
+        }
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+// ============================================================================
+// VU0 culling engine: never available
+// ============================================================================
+
+int vu0_cull_engine_set_planes(const float planes[6][4]) {
+    (void)planes;
+    return -1;
+}
+
+float* vu0_cull_engine_begin_batch(u32* buffer_id) {
+    (void)buffer_id;
+    return NULL;
+}
+
+int vu0_cull_engine_submit(u32 count) {
+    (void)count;
+    return -1;
+}
+
+int vu0_cull_engine_collect(u16* masks, u32* buffer_id) {
+    (void)masks;
+    (void)buffer_id;
+    return 0;
+}
+
+u32 vu0_cull_engine_in_flight(void) {
+    return 0;
+}
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK dma.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_DMA_H
+#define HOST_DMA_H
+#endif // HOST_DMA_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK dmaKit.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_DMAKIT_H
+#define HOST_DMAKIT_H
+#endif // HOST_DMAKIT_H
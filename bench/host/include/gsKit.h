@@ -0,0 +1,14 @@
+/*
+ * SPLATSTORM X - Host stand-in for gsKit.h (make bench-host)
+ * The portable kernels only pass these types around by pointer
+ */
+
+#ifndef HOST_GSKIT_H
+#define HOST_GSKIT_H
+
+#include <tamtypes.h>
+
+typedef struct gsGlobal GSGLOBAL;
+typedef struct gsTexture GSTEXTURE;
+
+#endif // HOST_GSKIT_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK iopcontrol.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_IOPCONTROL_H
+#define HOST_IOPCONTROL_H
+#endif // HOST_IOPCONTROL_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK iopheap.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_IOPHEAP_H
+#define HOST_IOPHEAP_H
+#endif // HOST_IOPHEAP_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK kernel.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_KERNEL_H
+#define HOST_KERNEL_H
+#endif // HOST_KERNEL_H
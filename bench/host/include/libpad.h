@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK libpad.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_LIBPAD_H
+#define HOST_LIBPAD_H
+#endif // HOST_LIBPAD_H
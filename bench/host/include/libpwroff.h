@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK libpwroff.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_LIBPWROFF_H
+#define HOST_LIBPWROFF_H
+#endif // HOST_LIBPWROFF_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK loadfile.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_LOADFILE_H
+#define HOST_LOADFILE_H
+#endif // HOST_LOADFILE_H
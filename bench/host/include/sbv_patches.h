@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK sbv_patches.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_SBV_PATCHES_H
+#define HOST_SBV_PATCHES_H
+#endif // HOST_SBV_PATCHES_H
@@ -0,0 +1,8 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK sifrpc.h (make bench-host)
+ * Nothing from it reaches the portable kernels; the include only has to resolve
+ */
+
+#ifndef HOST_SIFRPC_H
+#define HOST_SIFRPC_H
+#endif // HOST_SIFRPC_H
@@ -0,0 +1,20 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK tamtypes.h (make bench-host)
+ * The same widths as on the EE; u128 is the compiler's 128-bit integer
+ */
+
+#ifndef HOST_TAMTYPES_H
+#define HOST_TAMTYPES_H
+
+typedef unsigned char u8;
+typedef unsigned short u16;
+typedef unsigned int u32;
+typedef unsigned long long u64;
+typedef unsigned int u128 __attribute__((mode(TI)));
+
+typedef signed char s8;
+typedef signed short s16;
+typedef signed int s32;
+typedef signed long long s64;
+
+#endif // HOST_TAMTYPES_H
@@ -0,0 +1,45 @@
+/*
+ * SPLATSTORM X - Host stand-in for PS2SDK vif_codes.h (make bench-host)
+ * VIFcode encoders the engine headers' inline helpers expand
+ */
+
+#ifndef HOST_VIF_CODES_H
+#define HOST_VIF_CODES_H
+
+#include <tamtypes.h>
+
+#define VIF_CODE(immediate, num, cmd, irq) \
+    ((u32)(immediate) | ((u32)(num) << 16) | ((u32)(cmd) << 24) | ((u32)(irq) << 31))
+
+#define VIF_CMD_NOP         0x00
+#define VIF_CMD_STCYCL      0x01
+#define VIF_CMD_OFFSET      0x02
+#define VIF_CMD_BASE        0x03
+#define VIF_CMD_ITOP        0x04
+#define VIF_CMD_STMOD       0x05
+#define VIF_CMD_MARK        0x07
+#define VIF_CMD_FLUSHE      0x10
+#define VIF_CMD_FLUSH       0x11
+#define VIF_CMD_FLUSHA      0x13
+#define VIF_CMD_MSCAL       0x14
+#define VIF_CMD_MSCALF      0x15
+#define VIF_CMD_MPG         0x4A
+#define VIF_CMD_DIRECT      0x50
+#define VIF_CMD_DIRECTHL    0x51
+#define VIF_CMD_UNPACK(m, vn, vl) (0x60 | ((m) << 4) | ((vn) << 2) | (vl))
+
+#define UNPACK_IMDT(addr, usn, flg) ((u32)(addr) | ((u32)(usn) << 14) | ((u32)(flg) << 15))
+#define UNPACK_NUM(num)             ((u32)(num) << 16)
+#define STCYCL_IMDT(cl, wl)         ((u32)(cl) | ((u32)(wl) << 8))
+#define OFFSET_IMDT(offset)         ((u32)(offset))
+#define BASE_IMDT(base)             ((u32)(base))
+#define ITOP_IMDT(addr)             ((u32)(addr))
+#define STMOD_IMDT(mode)            ((u32)(mode))
+#define MARK_IMDT(mark)             ((u32)(mark))
+#define MPG_IMDT(addr)              ((u32)(addr))
+#define MSCAL_IMDT(addr)            ((u32)(addr))
+#define MSCALF_IMDT(addr)           ((u32)(addr))
+#define DIRECT_IMDT(size)           ((u32)(size))
+#define DIRECTHL_IMDT(size)         ((u32)(size))
+
+#endif // HOST_VIF_CODES_H
@@ -0,0 +1,307 @@
+/*
+ * SPLATSTORM X - 4-wide fixed-point math on the R5900 MMI
+ * fixed16x4 holds four Q16.16 lanes in one 128-bit EE register.
+ * Lane results match the scalar helpers in gaussian_types.h bit for bit
+ * (fixed_mul truncation, wrapping add), except fixed16x4_dot3(), which
+ * accumulates the exact products and rounds once.
+ *
+ * The MMI multiplies only lanes 0 and 2, so every multiply runs twice,
+ * the second time on operands rotated by one lane (QFSRV with SA = 4 bytes).
+ * HI/LO and SA are clobbered; the compiler never keeps values in SA.
+ */
+
+#ifndef FIXED_MATH_MMI_H
+#define FIXED_MATH_MMI_H
+
+#include <tamtypes.h>
+#include "gaussian_types.h"
+
+// Four Q16.16 lanes; loads and stores need 16-byte alignment
+typedef u128 fixed16x4;
+
+// Lane access through memory
+typedef union {
+    fixed16x4 v;
+    fixed16_t lane[4];
+} fixed16x4_lanes;
+
+static inline fixed16x4 fixed16x4_load(const fixed16_t* p) {
+    return *(const fixed16x4*)p;
+}
+
+static inline void fixed16x4_store(fixed16_t* p, fixed16x4 v) {
+    *(fixed16x4*)p = v;
+}
+
+#ifndef SPLATSTORM_HOST
+// (x, y, z, w) straight from four scalar registers
+static inline fixed16x4 fixed16x4_set(fixed16_t x, fixed16_t y, fixed16_t z, fixed16_t w) {
+    fixed16x4 result, low, high;
+    __asm__ (
+        "pextlw   %1, %4, %3      \n\t"   // x y in the low doubleword
+        "pextlw   %2, %6, %5      \n\t"   // z w in the low doubleword
+        "pcpyld   %0, %2, %1      \n\t"   // x y z w
+        : "=r" (result), "=&r" (low), "=&r" (high)
+        : "r" (x), "r" (y), "r" (z), "r" (w)
+    );
+    return result;
+}
+
+// Broadcast one scalar to all lanes
+static inline fixed16x4 fixed16x4_splat(fixed16_t a) {
+    fixed16x4 result;
+    __asm__ (
+        "pextlw   %0, %1, %1      \n\t"   // a a in the low doubleword
+        "pcpyld   %0, %0, %0      \n\t"
+        : "=&r" (result)
+        : "r" (a)
+    );
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_add(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("paddw    %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_sub(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("psubw    %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_min(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("pminw    %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_max(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("pmaxw    %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_clamp(fixed16x4 v, fixed16x4 lo, fixed16x4 hi) {
+    return fixed16x4_min(fixed16x4_max(v, lo), hi);
+}
+
+// All ones in lanes where a < b, zero elsewhere
+static inline fixed16x4 fixed16x4_cmplt(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("pcgtw    %0, %2, %1" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+static inline fixed16x4 fixed16x4_or(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result;
+    __asm__ ("por      %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+// Arithmetic shift right by a constant
+#define FIXED16X4_SRA(v, shift) ({                                  \
+    fixed16x4 _sra_result;                                          \
+    __asm__ ("psraw    %0, %1, %2"                                  \
+             : "=r" (_sra_result) : "r" (v), "i" (shift));          \
+    _sra_result;                                                    \
+})
+
+// Per-lane fixed_mul(): 64-bit product, bits 16..47
+static inline fixed16x4 fixed16x4_mul(fixed16x4 a, fixed16x4 b) {
+    fixed16x4 result, a_odd, b_odd, even, hi, lo;
+    __asm__ (
+        "mtsab    $0, 4           \n\t"   // QFSRV shifts by one lane
+        "qfsrv    %1, %6, %6      \n\t"   // Lanes 1, 3 into 0, 2
+        "qfsrv    %2, %7, %7      \n\t"
+        "pmultw   $0, %6, %7      \n\t"   // Lanes 0, 2 -> HI:LO
+        "pmfhi    %4              \n\t"
+        "pmflo    %5              \n\t"
+        "psllw    %4, %4, 16      \n\t"
+        "psrlw    %5, %5, 16      \n\t"
+        "por      %3, %4, %5      \n\t"   // r0 . r2 .
+        "pmultw   $0, %1, %2      \n\t"   // Lanes 1, 3 -> HI:LO
+        "pmfhi    %4              \n\t"
+        "pmflo    %5              \n\t"
+        "psllw    %4, %4, 16      \n\t"
+        "psrlw    %5, %5, 16      \n\t"
+        "por      %0, %4, %5      \n\t"   // r1 . r3 .
+        "ppacw    %0, %0, %3      \n\t"   // r0 r2 r1 r3
+        "pexcw    %0, %0          \n\t"   // r0 r1 r2 r3
+        : "=&r" (result), "=&r" (a_odd), "=&r" (b_odd), "=&r" (even), "=&r" (hi), "=&r" (lo)
+        : "r" (a), "r" (b)
+        : "hi", "lo"
+    );
+    return result;
+}
+
+// ax*bx + ay*by + az*bz per lane, summed at 64 bits and shifted once;
+// within 2 LSB of three fixed_mul() additions
+static inline fixed16x4 fixed16x4_dot3(fixed16x4 ax, fixed16x4 ay, fixed16x4 az,
+                                       fixed16x4 bx, fixed16x4 by, fixed16x4 bz) {
+    fixed16x4 result, even, hi, lo, odd_a, odd_b;
+    __asm__ (
+        "pmultw   $0, %6, %9      \n\t"   // Lanes 0, 2
+        "pmaddw   $0, %7, %10     \n\t"
+        "pmaddw   $0, %8, %11     \n\t"
+        "pmfhi    %2              \n\t"
+        "pmflo    %3              \n\t"
+        "psllw    %2, %2, 16      \n\t"
+        "psrlw    %3, %3, 16      \n\t"
+        "por      %1, %2, %3      \n\t"   // r0 . r2 .
+        "mtsab    $0, 4           \n\t"   // Lanes 1, 3
+        "qfsrv    %4, %6, %6      \n\t"
+        "qfsrv    %5, %9, %9      \n\t"
+        "pmultw   $0, %4, %5      \n\t"
+        "qfsrv    %4, %7, %7      \n\t"
+        "qfsrv    %5, %10, %10    \n\t"
+        "pmaddw   $0, %4, %5      \n\t"
+        "qfsrv    %4, %8, %8      \n\t"
+        "qfsrv    %5, %11, %11    \n\t"
+        "pmaddw   $0, %4, %5      \n\t"
+        "pmfhi    %2              \n\t"
+        "pmflo    %3              \n\t"
+        "psllw    %2, %2, 16      \n\t"
+        "psrlw    %3, %3, 16      \n\t"
+        "por      %0, %2, %3      \n\t"   // r1 . r3 .
+        "ppacw    %0, %0, %1      \n\t"   // r0 r2 r1 r3
+        "pexcw    %0, %0          \n\t"   // r0 r1 r2 r3
+        : "=&r" (result), "=&r" (even), "=&r" (hi), "=&r" (lo), "=&r" (odd_a), "=&r" (odd_b)
+        : "r" (ax), "r" (ay), "r" (az), "r" (bx), "r" (by), "r" (bz)
+        : "hi", "lo"
+    );
+    return result;
+}
+
+// Rows to columns: four xyzw records in, x, y, z and w lanes out
+static inline void fixed16x4_transpose(fixed16x4* r0, fixed16x4* r1, fixed16x4* r2, fixed16x4* r3) {
+    fixed16x4 t0, t1, t2, t3;
+    __asm__ (
+        "pextlw   %0, %5, %4      \n\t"   // a0 b0 a1 b1
+        "pextuw   %1, %5, %4      \n\t"   // a2 b2 a3 b3
+        "pextlw   %2, %7, %6      \n\t"   // c0 d0 c1 d1
+        "pextuw   %3, %7, %6      \n\t"   // c2 d2 c3 d3
+        : "=&r" (t0), "=&r" (t1), "=&r" (t2), "=&r" (t3)
+        : "r" (*r0), "r" (*r1), "r" (*r2), "r" (*r3)
+    );
+    __asm__ (
+        "pcpyld   %0, %6, %4      \n\t"   // a0 b0 c0 d0
+        "pcpyud   %1, %4, %6      \n\t"   // a1 b1 c1 d1
+        "pcpyld   %2, %7, %5      \n\t"   // a2 b2 c2 d2
+        "pcpyud   %3, %5, %7      \n\t"   // a3 b3 c3 d3
+        : "=&r" (*r0), "=&r" (*r1), "=&r" (*r2), "=&r" (*r3)
+        : "r" (t0), "r" (t1), "r" (t2), "r" (t3)
+    );
+}
+
+#else // SPLATSTORM_HOST
+
+// Host builds (make bench-host): the same lane results in plain C
+
+static inline fixed16x4 fixed16x4_set(fixed16_t x, fixed16_t y, fixed16_t z, fixed16_t w) {
+    fixed16x4_lanes result = { .lane = { x, y, z, w } };
+    return result.v;
+}
+
+static inline fixed16x4 fixed16x4_splat(fixed16_t a) {
+    return fixed16x4_set(a, a, a, a);
+}
+
+#define FIXED16X4_HOST_LANES(name, expr)                            \
+static inline fixed16x4 name(fixed16x4 va, fixed16x4 vb) {          \
+    fixed16x4_lanes a, b, result;                                   \
+    a.v = va;                                                       \
+    b.v = vb;                                                       \
+    for (int i = 0; i < 4; i++) {                                   \
+        result.lane[i] = (expr);                                    \
+    }                                                               \
+    return result.v;                                                \
+}
+
+FIXED16X4_HOST_LANES(fixed16x4_add, (fixed16_t)((u32)a.lane[i] + (u32)b.lane[i]))
+FIXED16X4_HOST_LANES(fixed16x4_sub, (fixed16_t)((u32)a.lane[i] - (u32)b.lane[i]))
+FIXED16X4_HOST_LANES(fixed16x4_min, MIN(a.lane[i], b.lane[i]))
+FIXED16X4_HOST_LANES(fixed16x4_max, MAX(a.lane[i], b.lane[i]))
+FIXED16X4_HOST_LANES(fixed16x4_cmplt, (a.lane[i] < b.lane[i]) ? -1 : 0)
+FIXED16X4_HOST_LANES(fixed16x4_or, a.lane[i] | b.lane[i])
+FIXED16X4_HOST_LANES(fixed16x4_mul, (fixed16_t)(((s64)a.lane[i] * b.lane[i]) >> 16))
+
+#undef FIXED16X4_HOST_LANES
+
+static inline fixed16x4 fixed16x4_clamp(fixed16x4 v, fixed16x4 lo, fixed16x4 hi) {
+    return fixed16x4_min(fixed16x4_max(v, lo), hi);
+}
+
+#define FIXED16X4_SRA(value, shift) ({                              \
+    fixed16x4_lanes _sra_lanes;                                     \
+    _sra_lanes.v = (value);                                         \
+    for (int _sra_i = 0; _sra_i < 4; _sra_i++) {                    \
+        _sra_lanes.lane[_sra_i] >>= (shift);                        \
+    }                                                               \
+    _sra_lanes.v;                                                   \
+})
+
+static inline fixed16x4 fixed16x4_dot3(fixed16x4 ax, fixed16x4 ay, fixed16x4 az,
+                                       fixed16x4 bx, fixed16x4 by, fixed16x4 bz) {
+    fixed16x4_lanes a[3], b[3], result;
+    a[0].v = ax; a[1].v = ay; a[2].v = az;
+    b[0].v = bx; b[1].v = by; b[2].v = bz;
+    for (int i = 0; i < 4; i++) {
+        s64 sum = (s64)a[0].lane[i] * b[0].lane[i] + (s64)a[1].lane[i] * b[1].lane[i] +
+                  (s64)a[2].lane[i] * b[2].lane[i];
+        result.lane[i] = (fixed16_t)(sum >> 16);
+    }
+    return result.v;
+}
+
+static inline void fixed16x4_transpose(fixed16x4* r0, fixed16x4* r1, fixed16x4* r2, fixed16x4* r3) {
+    fixed16x4_lanes in[4], out[4];
+    in[0].v = *r0; in[1].v = *r1; in[2].v = *r2; in[3].v = *r3;
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            out[col].lane[row] = in[row].lane[col];
+        }
+    }
+    *r0 = out[0].v; *r1 = out[1].v; *r2 = out[2].v; *r3 = out[3].v;
+}
+
+#endif // SPLATSTORM_HOST
+
+// Bit i set where lane i is negative (or all ones, from a compare)
+static inline u32 fixed16x4_sign_mask(fixed16x4 v) {
+    fixed16x4_lanes lanes;
+    lanes.v = v;
+    return ((u32)lanes.lane[0] >> 31) | (((u32)lanes.lane[1] >> 31) << 1) |
+           (((u32)lanes.lane[2] >> 31) << 2) | (((u32)lanes.lane[3] >> 31) << 3);
+}
+
+// Per-lane fixed_recip_newton(): the same power-of-two start and four
+// Newton steps on the magnitudes, run on all lanes at once
+static inline fixed16x4 fixed16x4_recip(fixed16x4 d) {
+    fixed16x4_lanes in, abs_d, x;
+    in.v = d;
+    for (int i = 0; i < 4; i++) {
+        abs_d.lane[i] = fixed_abs(in.lane[i]);
+        x.lane[i] = (abs_d.lane[i] > 2) ? (fixed16_t)(1U << __builtin_clz((u32)abs_d.lane[i])) : 0;
+    }
+
+    // x_{n+1} = x_n * (2 - d * x_n)
+    fixed16x4 two = fixed16x4_splat(fixed_from_int(2));
+    for (int i = 0; i < 4; i++) {
+        x.v = fixed16x4_mul(x.v, fixed16x4_sub(two, fixed16x4_mul(abs_d.v, x.v)));
+    }
+
+    // Signs back; 1/d does not fit Q16.16 for the two smallest magnitudes
+    for (int i = 0; i < 4; i++) {
+        if (abs_d.lane[i] <= 2) {
+            x.lane[i] = FIXED16_MAX;
+        }
+        if (in.lane[i] < 0) {
+            x.lane[i] = fixed_neg(x.lane[i]);
+        }
+    }
+    return x.v;
+}
+
+#endif // FIXED_MATH_MMI_H
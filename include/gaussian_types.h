@@ -21,7 +21,8 @@ typedef enum {
     POOL_TYPE_STACK,                          // Stack allocation (LIFO free)
     POOL_TYPE_BUDDY,                          // Buddy system (power-of-2 sizes)
     POOL_TYPE_FREELIST,                       // Free list (general purpose)
-    POOL_TYPE_RING                            // Ring buffer (circular)
+    POOL_TYPE_RING,                           // Ring buffer (circular)
+    POOL_TYPE_TLSF                            // Two-level segregated fit (O(1) general purpose)
 } MemoryPoolType;
 
 // Fixed-point precision definitions with overflow protection
@@ -32,9 +33,9 @@ typedef enum {
 
 // Safety limits for overflow detection
 #define FIXED16_MAX 0x7FFFFFFF
-#define FIXED16_MIN 0x80000000
+#define FIXED16_MIN (-0x7FFFFFFF - 1)  // Signed, so s64 clamps compare correctly
 #define FIXED8_MAX 0x7FFF
-#define FIXED8_MIN 0x8000
+#define FIXED8_MIN (-0x7FFF - 1)
 
 // Fixed-point types with range documentation
 typedef s32 fixed16_t;  // Q16.16: -32768.0 to 32767.99998 range
@@ -48,6 +49,12 @@ typedef s16 fixed8_t;   // Q8.8: -128.0 to 127.996 range (mantissa for adaptive
 #define ATLAS_ENTRIES 64                // 8x8 footprint atlas
 #define FOOTPRINT_RES 32                // 32x32 per footprint
 #define ATLAS_SIZE (FOOTPRINT_RES * 8)  // 256x256 total atlas
+#define FOOTPRINT_MIP_LEVELS 4          // 32x32, 16x16, 8x8 and 4x4 footprints
+#define ATLAS_HEIGHT (ATLAS_SIZE + ATLAS_SIZE / 2)  // Level 0 on top, levels 1+ side by side below
+#define ATLAS_HEIGHT_LOG2 9             // GS TH covering ATLAS_HEIGHT
+#define FOOTPRINT_ATLAS_BITS 8          // GS atlas texels: 8 (PSMT8) or 4 (PSMT4) bit alpha indices
+#define FOOTPRINT_ATLAS_BYTES (ATLAS_SIZE * ATLAS_HEIGHT * FOOTPRINT_ATLAS_BITS / 8)
+#define FOOTPRINT_CLUT_ENTRIES (1 << FOOTPRINT_ATLAS_BITS)  // Alpha ramp CLUT size
 #define MAX_EIG_VAL 10.0f               // Maximum eigenvalue for LUT normalization
 
 // Memory alignment constants
@@ -57,9 +64,11 @@ typedef s16 fixed8_t;   // Q8.8: -128.0 to 127.996 range (mantissa for adaptive
 
 // Performance constants
 #define VU_BATCH_SIZE 256               // Splats per VU batch (fits in 16KB)
-#define MAX_SPLATS_PER_TILE 128         // Maximum splats per tile
-#define MAX_SPLATS_PER_SCENE 32768      // Maximum splats per scene
+#define MAX_SPLATS_PER_TILE 128         // Tiles drawing more are split into sub-tile regions
+#define MAX_SPLATS_PER_SCENE 262144     // Index limit; the default scene budget holds ~141k records
 #define NUM_DEPTH_BUCKETS 256           // Bucket sort depth buckets
+#define FRAME_ARENA_SIZE (4 * 1024 * 1024)  // Per-frame arena; size it from FrameArenaStats peaks
+#define SPR_STREAM_HALF_SIZE (8 * 1024)     // Scratchpad stream block: 16KB SPR split in two halves
 
 // 3D Gaussian splat with adaptive covariance scaling (64-byte aligned)
 typedef struct {
@@ -69,11 +78,42 @@ typedef struct {
     fixed8_t cov_mant[9];       // 3x3 covariance mantissa (Q8.8) - 18 bytes
     u8 color[3];                // RGB (0-255) - 3 bytes
     u8 opacity;                 // Opacity (0-255, sigmoid-scaled) - 1 byte
-    u16 sh_coeffs[16];          // SH degree 0-2 coefficients (quantized) - 32 bytes
+    u16 sh_coeffs[16];          // Scalar SH: [1..8] degree 1-2 color offset (s16 Q1.15 of 255) - 32 bytes
     u32 importance;             // Importance metric for LOD - 4 bytes
-    u8 padding[8];              // Pad to 64 bytes for cache alignment
+    u8 padding[8];              // 80 bytes; the alignment rounds the record to 128
 } __attribute__((aligned(CACHE_LINE_SIZE))) GaussianSplat3D;
 
+// Hot/warm/cold split of GaussianSplat3D (scene stream storage)
+// Each pass reads only the stream it needs: culling touches 16 bytes per splat.
+// Hot stream: culling data, one VU qword per splat
+typedef struct {
+    fixed16_t pos[3];           // 3D position (Q16.16) - 12 bytes
+    fixed16_t radius;           // Bounding radius (3 sigma, Q16.16) - 4 bytes
+} __attribute__((aligned(16))) GaussianSplatHot;
+
+// Warm stream: projection and shading inputs
+typedef struct {
+    fixed8_t cov_mant[9];       // 3x3 covariance mantissa (Q8.8) - 18 bytes
+    u8 cov_exp;                 // Covariance exponent (0-15) - 1 byte
+    u8 color[3];                // RGB (0-255) - 3 bytes
+    u8 opacity;                 // Opacity (0-255) - 1 byte
+    u8 padding[9];              // Pad to 32 bytes
+} __attribute__((aligned(16))) GaussianSplatWarm;
+
+// Cold stream: data no per-frame pass reads
+typedef struct {
+    u16 sh_coeffs[16];          // SH degree 0-2 coefficients (quantized) - 32 bytes
+    u32 importance;             // Importance metric for LOD - 4 bytes
+    u8 padding[12];             // Pad to 48 bytes
+} __attribute__((aligned(16))) GaussianSplatCold;
+
+typedef struct {
+    GaussianSplatHot* hot;      // Position + radius
+    GaussianSplatWarm* warm;    // Covariance + color + opacity, NULL in a compact (hot-only) set
+    GaussianSplatCold* cold;    // SH + importance, NULL with warm
+    u32 count;                  // Splats in each stream
+} GaussianSplatStreams;
+
 // 2D projected Gaussian splat with complete information (64-byte aligned)
 typedef struct {
     fixed16_t screen_pos[2];    // 2D screen position (Q16.16) - 8 bytes
@@ -86,9 +126,24 @@ typedef struct {
     fixed16_t eigenvecs[4];     // Eigenvectors (2x2 rotation matrix, Q16.16) - 16 bytes
     u16 tile_mask;              // Bitmask of tiles this splat affects - 2 bytes
     u8 atlas_u, atlas_v;        // Atlas UV coordinates (0-255) - 2 bytes
-    u8 padding[4];              // Pad to 64 bytes
+    u8 atlas_level;             // Footprint mip level from the screen radius - 1 byte
+    u8 padding[3];              // Pad to 64 bytes
 } __attribute__((aligned(CACHE_LINE_SIZE))) GaussianSplat2D;
 
+// Quantized render splat: only what tiling, sorting and GS submission read (16 bytes)
+// Screen position and radius are GS 12.4 pixels; depth is the GS Z24 value.
+#define RENDER_SPLAT_SUBPIXEL_SHIFT 4         // 12.4 fixed point, as in GS XYZ2
+#define RENDER_SPLAT_DEPTH_BITS 24            // Z24, larger = nearer
+typedef struct {
+    s16 screen_x;               // Screen x (12.4) - 2 bytes
+    s16 screen_y;               // Screen y (12.4) - 2 bytes
+    u16 radius;                 // 3σ radius (12.4) - 2 bytes
+    u8 atlas_index;             // Footprint atlas cell (aspect row * 8 + angle column) - 1 byte
+    u8 atlas_level;             // Footprint mip level from the screen radius - 1 byte
+    u32 depth;                  // Z24 depth, larger = nearer - 4 bytes
+    u8 color[4];                // RGBA, GS alpha scale (0x80 = opaque) - 4 bytes
+} __attribute__((aligned(16))) GaussianSplatRender;
+
 // Tile-based rasterization configuration
 #define TILE_SIZE 16
 #define TILES_X (640/TILE_SIZE)         // 40 tiles horizontally
@@ -100,29 +155,77 @@ typedef struct {
 #define COARSE_TILES_X (640/COARSE_TILE_SIZE)  // 10 coarse tiles
 #define COARSE_TILES_Y (448/COARSE_TILE_SIZE)  // 7 coarse tiles
 #define MAX_COARSE_TILES (COARSE_TILES_X * COARSE_TILES_Y)
+#define TILE_MAX_REGIONS (MAX_TILES * 2) // Render regions per frame, hot tiles split in four
 
 // Tile range with depth bounds for culling
 typedef struct {
-    u16 start_index;            // Starting index in sorted splat array
-    u16 count;                  // Number of splats in this tile
-    fixed16_t min_depth;        // Minimum depth in tile
-    fixed16_t max_depth;        // Maximum depth in tile
+    u32 start_index;            // Starting index in sorted splat array
+    u32 count;                  // Number of splats in this tile
+    fixed16_t min_depth;        // Minimum depth in tile (Z24)
+    fixed16_t max_depth;        // Maximum depth in tile (Z24)
     u8 visibility_mask;         // Visibility bitmask for hierarchical culling
     u8 padding[3];              // Alignment
 } TileRange;
 
+// Scissor rectangle drawn with one back-to-front splat list
+typedef struct {
+    u16 x, y;                   // Top-left pixel
+    u16 width, height;          // Size in pixels
+    u32 start_index;            // First entry in the region index list
+    u32 count;                  // Splats drawn in this region
+} TileRegion;
+
 // Advanced LUT texture data structures
 typedef struct {
     u32* exp_lut;               // Exponential falloff LUT (256 entries)
     u32* sqrt_lut;              // Square root LUT for eigenvalues (256 entries)
     u32* cov_inv_lut;           // 2D covariance inverse LUT (128x128)
-    u32* footprint_atlas;       // Precalculated Gaussian footprints (256x256)
+    u8* footprint_atlas;        // Precalculated Gaussian footprints as GS texels (256x256 PSMT8/PSMT4)
+    u32* footprint_clut;        // Alpha ramp CLUT for the atlas (CT32, CSM1 order)
     u32* sh_lighting_lut;       // Spherical harmonics lighting (256x256)
     u32* recip_lut;             // Reciprocal LUT for divisions (256 entries)
+    void* cooked_payload;       // Cooked LUT file backing every table above, or NULL
     bool initialized;           // Initialization flag
     u32 total_memory_usage;     // Total VRAM usage in bytes
 } GaussianLUTs;
 
+// GS local memory geometry: 4MB as 512 pages of 32 blocks (256 bytes each).
+// TBP/CBP are block addresses, FBP/ZBP page addresses.
+#define GS_VRAM_SIZE            (4 * 1024 * 1024)
+#define GS_VRAM_BLOCK_BYTES     256
+#define GS_VRAM_PAGE_BLOCKS     32
+#define GS_VRAM_PAGE_COUNT      (GS_VRAM_SIZE / (GS_VRAM_BLOCK_BYTES * GS_VRAM_PAGE_BLOCKS))
+#define GS_VRAM_BLOCK_COUNT     (GS_VRAM_PAGE_COUNT * GS_VRAM_PAGE_BLOCKS)
+#define GS_VRAM_INVALID         0xFFFFFFFF    // No block address
+#define GS_VRAM_MAX_ALLOCS      64            // Live allocations tracked for free
+#define GS_VRAM_MAX_BANDS       16            // Page rows tracked per resident texture
+
+// Textures whose GS residency is managed by the VRAM manager
+typedef enum {
+    GS_TEXTURE_FOOTPRINT_CLUT,          // Alpha ramp CLUT of the footprint atlas
+    GS_TEXTURE_COV_INV_LUT,             // Covariance inverse LUT
+    GS_TEXTURE_FOOTPRINT_ATLAS,         // Gaussian footprint atlas
+    GS_TEXTURE_SH_LIGHTING,             // Spherical harmonics lighting LUT
+    GS_TEXTURE_COUNT
+} GSTextureId;
+
+// VRAM manager statistics
+typedef struct {
+    u32 used_blocks;                    // Blocks currently allocated
+    u32 peak_blocks;                    // High-water mark
+    u32 free_pages;                     // Completely free pages
+    u32 largest_free_pages;             // Longest run of free pages
+    u32 resident_textures;              // Managed textures currently in VRAM
+    u32 uploads;                        // Texture upload requests
+    u32 uploads_skipped;                // Requests with every band unchanged
+    u32 bands_uploaded;                 // Page rows actually transferred
+    u32 bytes_uploaded;                 // GIF IMAGE bytes transferred
+    u32 binds;                          // Texture binds
+    u32 bind_misses;                    // Binds that had to restore an evicted texture
+    u32 evictions;                      // Textures evicted to make room
+    u32 failed_allocs;                  // Allocations that could not be satisfied
+} GSVramStats;
+
 // VU batch processing structure with double buffering
 typedef struct {
     GaussianSplat3D* input_buffer_a;    // Input buffer A
@@ -172,6 +275,7 @@ typedef struct {
     u32 splats_processed;       // Processed splat count
     u32 visible_splats;         // Visible splats after culling
     u32 projected_splats;       // Projected splats
+    u32 lod_splats;             // Splats left after screen-space LOD aggregation
     u32 rendered_splats;        // Actually rendered splats
     u32 tiles_rendered;         // Tiles with content
     u32 overdraw_pixels;        // Estimated overdraw
@@ -193,8 +297,11 @@ typedef struct {
 // Culling statistics structure
 typedef struct {
     u32 total_splats;           // Total splats in scene
-    u32 total_cells;            // Total spatial grid cells
-    u32 visible_cells;          // Cells visible this frame
+    u32 total_cells;            // Total culling octree nodes
+    u32 visible_cells;          // Nodes visible this frame
+    u32 inside_cells;           // Nodes fully inside the frustum this frame
+    u32 temporal_cells;         // Nodes classified from their history, without plane tests
+    u32 occluded_cells;         // Visible nodes culled behind last frame's opaque tiles
     u32 empty_cells;            // Empty cells
     u64 frame_number;           // Current frame number
 } CullingStats;
@@ -218,6 +325,110 @@ typedef struct {
     float cache_efficiency;    // Cache efficiency
 } MemoryStats;
 
+// Per-subsystem memory budgets, each backed by its own TLSF pool
+typedef enum {
+    MEMORY_BUDGET_SCENE,                      // Splat records, streams, scene buffers
+    MEMORY_BUDGET_FRAME,                      // Frame arena and per-frame working sets
+    MEMORY_BUDGET_DMA,                        // DMA packets and command buffers
+    MEMORY_BUDGET_ASSET,                      // LUTs, loader buffers, untagged allocations
+    MEMORY_BUDGET_DEBUG,                      // Debug capture and diagnostics
+    MEMORY_BUDGET_COUNT
+} MemoryBudgetClass;
+
+// Budget sizes (28MB of the 32MB EE RAM). A 60k-splat scene needs 13.4MB for
+// records and streams, plus ~7MB of scene arrays sized for MAX_SCENE_SPLATS.
+#define MEMORY_BUDGET_SCENE_SIZE  (20 * 1024 * 1024)
+#define MEMORY_BUDGET_FRAME_SIZE  (FRAME_ARENA_SIZE + 1024 * 1024)
+#define MEMORY_BUDGET_DMA_SIZE    (2 * 1024 * 1024)
+#define MEMORY_BUDGET_ASSET_SIZE  (1024 * 1024)
+#define MEMORY_BUDGET_DEBUG_SIZE  (256 * 1024)
+
+// Budget usage
+typedef struct {
+    const char* name;                         // Budget name
+    u32 budget;                               // Hard limit in bytes
+    u32 used;                                 // Bytes in use
+    u32 peak;                                 // Peak bytes in use
+    u32 free_bytes;                           // Bytes still available (not necessarily contiguous)
+    u32 overruns;                             // Requests refused (total)
+    u32 largest_overrun;                      // Largest refused request
+    u32 frame_peak;                           // Peak bytes in use during the last frame
+    u32 alert_bytes;                          // Frame peak that raises an alert, 0 = none
+    u32 alerts;                               // Frames that crossed alert_bytes (total)
+} MemoryBudgetStats;
+
+// Allocation sites are tracked by file and line (memory_alloc, memory_pool_alloc)
+#define MEMORY_CALLSITE_SLOTS    128          // Slot 0 collects untracked allocations
+#define MEMORY_CALLSITE_REPORT   8            // Sites memory_budget_print lists
+#define MEMORY_ALERT_PERCENT     90           // Default alert level, share of each budget
+
+typedef struct {
+    const char* file;                         // NULL for the untracked slot
+    u32 line;
+    u32 pool_id;                              // Pool of the site's first allocation
+    u32 live_bytes;                           // Bytes still allocated
+    u32 peak_bytes;                           // High-water mark of live_bytes
+    u32 allocations;                          // Allocations made (total)
+} MemoryCallsiteStats;
+
+// Per-frame arena stages, in render_frame order
+typedef enum {
+    FRAME_STAGE_CULL,                         // Visible splat list
+    FRAME_STAGE_PROJECT,                      // Projected render splats
+    FRAME_STAGE_TILE,                         // Tile ranges and bins
+    FRAME_STAGE_RENDER,                       // GS submission scratch
+    FRAME_STAGE_COUNT
+} FrameArenaStage;
+
+// Frame arena usage; stage and frame figures are for the last completed frame
+typedef struct {
+    u32 capacity;                             // Arena size in bytes
+    u32 used;                                 // Bytes in use right now
+    u32 frame_high_water;                     // Peak bytes in the last frame
+    u32 peak_high_water;                      // Peak bytes over all frames
+    u32 stage_bytes[FRAME_STAGE_COUNT];       // Peak bytes each stage added
+    u32 failed_allocations;                   // Allocations that did not fit (total)
+} FrameArenaStats;
+
+// Kernel run over one scratchpad-resident block of a dma_spr_stream() pass.
+// first is the stream position of block[0]: the record index for contiguous
+// streams, the position in the index list for gathered ones.
+typedef void (*SprStreamKernel)(const void* block, u32 first, u32 count, void* user);
+
+// DMA traffic accounting groups; fromSPR and toSPR share DMA_STATS_SPR
+typedef enum {
+    DMA_STATS_VIF0,                           // VU0 culling packets and programs
+    DMA_STATS_VIF1,                           // VU1 constants, batches and programs
+    DMA_STATS_GIF,                            // PATH3: GS packets and texture uploads
+    DMA_STATS_SPR,                            // Scratchpad copies and streams
+    DMA_STATS_CHANNELS
+} DMAStatsChannel;
+
+// DMA traffic of one frame. Bytes count data moved, not source-chain tags
+// (except where the tags carry VIF codes); wait cycles are EE time blocked
+// on the channel, asleep or spinning.
+typedef struct {
+    u32 bytes[DMA_STATS_CHANNELS];
+    u32 transfers[DMA_STATS_CHANNELS];        // Sends started
+    u32 wait_cycles[DMA_STATS_CHANNELS];
+} DMAChannelStats;
+
+// VU and VIF activity of one frame, sampled from VPU-STAT and the VIF
+// status registers on a timer interrupt (vu_activity.c). Cycles are EE
+// cycles; per-unit arrays are indexed by VU_UNIT_VU0 / VU_UNIT_VU1.
+typedef struct {
+    u32 samples;
+    u32 sampled_cycles;                       // Time the samples cover
+    u32 busy_cycles[2];                       // Microprogram running
+    u32 runs[2];                              // Idle-to-running edges
+    u32 gap_cycles[2];                        // Idle between the frame's first and last run
+    u32 max_gap_cycles[2];
+    u32 xgkick_wait_cycles;                   // VU1 stalled on XGKICK, GIF busy
+    u32 vif_vu_wait_cycles[2];                // VIF holding MSCAL/FLUSHE for a running program
+    u32 vif_gif_wait_cycles;                  // VIF1 waiting for the GIF (DIRECT, FLUSHA)
+    u32 vif_stop_cycles[2];                   // VIF stopped: interrupt bit, STOP or ForceBreak
+} VUActivityStats;
+
 // Include shared types instead of circular dependency
 #include "splatstorm_types.h"
 
@@ -226,22 +437,22 @@ typedef struct {
     fixed16_t view[16];         // View matrix (Q16.16)
     fixed16_t proj[16];         // Projection matrix (Q16.16)
     fixed16_t view_proj[16];    // Combined view-projection (Q16.16)
+    fixed16_t inv_view_proj[16]; // Inverse view-projection (Q16.16)
     fixed16_t viewport[4];      // Viewport transform (x, y, w, h)
-    fixed16_t frustum[6][4];    // Frustum planes for culling
+    fixed16_t frustum[6][4];    // Normalized frustum planes, cached with view_proj
     fixed16_t position[3];      // Camera position
     fixed16_t rotation[4];      // Camera rotation (quaternion)
     fixed16_t last_position[3]; // Previous position for coherence
     fixed16_t last_rotation[4]; // Previous rotation for coherence
-    bool moved_significantly;   // Movement flag for temporal coherence
+    bool moved_significantly;   // Matrices changed since the previous frame
     u64 last_update_frame;      // Last update frame number
 } CameraFixed;
 
 // Scene management with complete state
 typedef struct {
-    GaussianSplat3D* splats_3d;         // Original 3D splats
-    GaussianSplat2D* splats_2d;         // Projected 2D splats
-    u32* sort_keys;                     // Sorting keys for depth ordering
-    u16* sort_indices;                  // Sorted indices
+    GaussianSplat3D* splats_3d;         // Original 3D splats, owned by the loader
+    GaussianSplatStreams streams;       // Hot/warm/cold split of splats_3d (count 0 when unused)
+    void* cooked_payload;               // Cooked scene payload backing splats_3d and streams, or NULL
     TileRange* tile_ranges;             // Per-tile splat ranges
     TileRange* coarse_tile_ranges;      // Coarse tile ranges for hierarchical culling
     u32* tile_splat_lists;              // Per-tile splat lists
@@ -258,6 +469,44 @@ typedef struct {
     FrameProfileData profile;           // Performance profiling data
 } GaussianScene;
 
+// Instanced splat assets (scene_instances.c): one copy of an asset's splats
+// and octree, drawn at every instance's transform
+#define SCENE_MAX_ASSETS     8
+#define SCENE_MAX_INSTANCES  128
+
+typedef struct CullIndex CullIndex;     // Asset octree (frustum_culling_complete.c)
+
+typedef struct {
+    GaussianSplat3D* splats;            // Object space
+    u32 splat_count;
+    CullIndex* cull_index;
+    fixed16_t bounds_min[3];            // Object-space bounds, splat radii included
+    fixed16_t bounds_max[3];
+    char name[64];                      // Source file, to share the asset between instances
+} SplatAsset;
+
+typedef struct {
+    u32 asset;                          // Index into the asset table
+    fixed16_t transform[16];            // Object to world, row vectors like the camera matrices
+    fixed16_t bounds_min[3];            // World bounds of the transformed asset
+    fixed16_t bounds_max[3];
+    u32 visible_first;                  // This frame's visible indices, after the scene's
+    u32 visible_count;
+    bool enabled;
+} SplatInstance;
+
+// Dynamic splat updates (scene_dynamic.c): fields of a SplatUpdate to apply
+#define SPLAT_UPDATE_POSITION   0x01
+#define SPLAT_UPDATE_COLOR      0x02
+#define SPLAT_UPDATE_OPACITY    0x04
+#define SCENE_DIRTY_RANGES      16      // Pending ranges before neighbours merge
+
+typedef struct {
+    fixed16_t pos[3];                   // World position (Q16.16)
+    u8 color[3];                        // RGB (0-255)
+    u8 opacity;                         // Opacity (0-255)
+} SplatUpdate;
+
 // Debug visualization modes with detailed options
 typedef enum {
     DEBUG_MODE_NORMAL,
@@ -278,7 +527,7 @@ typedef enum {
 extern u32 g_exp_lut[LUT_SIZE];
 extern u32 g_sqrt_lut[LUT_SIZE];
 extern u32 g_cov_inv_lut[COV_INV_LUT_RES * COV_INV_LUT_RES];
-extern u32 g_footprint_atlas[ATLAS_SIZE * ATLAS_SIZE];
+extern u8 g_footprint_atlas[ATLAS_SIZE * ATLAS_HEIGHT];   // 8-bit alpha
 extern u32 g_sh_lighting_lut[256 * 256];
 extern u32 g_recip_lut[LUT_SIZE];
 
@@ -287,9 +536,46 @@ GaussianResult gaussian_system_init(u32 max_splats);
 void gaussian_system_cleanup(void);
 GaussianResult gaussian_scene_init(GaussianScene* scene, u32 max_splats);
 void gaussian_scene_destroy(GaussianScene* scene);
+void gaussian_covariance_from_scale_rotation(const float scale[3], const float rotation[4],
+                                             fixed8_t cov_mant[9], u8* cov_exp);
+fixed16_t gaussian_splat_bounding_radius(const GaussianSplat3D* splat);
+GaussianResult gaussian_splat_streams_build(GaussianSplatStreams* streams, const GaussianSplat3D* splats,
+                                           u32 count, u32 pool_id);
+void gaussian_splat_streams_store(GaussianSplatStreams* streams, u32 index, const GaussianSplat3D* splat);
+void gaussian_splat_streams_gather(const GaussianSplatStreams* streams, u32 index, GaussianSplat3D* out);
+GaussianResult gaussian_splats_sort_by_importance(GaussianSplat3D* splats, GaussianSplatStreams* streams,
+                                                  u32 count, u32* remap);
+GaussianResult gaussian_splats_permute(GaussianSplat3D* splats, GaussianSplatStreams* streams,
+                                       u32 count, const u32* order, u32* remap);
+GaussianResult project_gaussian_complete(const GaussianSplat3D* splat3d, const CameraFixed* camera,
+                                         GaussianSplat2D* splat2d);
+#define PROJECT_BATCH_MAX 16            // Splats per project_gaussian_batch() call
+// project_gaussian_batch() against project_gaussian_complete(): the same
+// visible set, and per splat at most these Q16.16 / Q8.8 differences.
+// The eigenvalues and radius carry the scalar sqrt LUT's 8-bit error; the
+// inverse covariance and atlas cell follow from them and are not bounded.
+#define PROJECT_BATCH_TOL_SCREEN  (FIXED16_SCALE / 16)  // Screen position, 1/16 pixel
+// Far out the scalar path's Q16.16 1/w dominates: up to 1 LSB (2^-16) off,
+// so up to w * 2^-16 in NDC, half of that times the viewport extent on screen
+#define PROJECT_BATCH_TOL_SCREEN_AT(extent, depth) \
+    (PROJECT_BATCH_TOL_SCREEN + (fixed16_t)(((s64)(extent) * (depth)) >> 33))
+#define PROJECT_BATCH_TOL_DEPTH   4                     // Depth: three truncated view products
+#define PROJECT_BATCH_TOL_COV     1                     // cov_2d, 1 Q8.8 LSB
+#define PROJECT_BATCH_TOL_EIGEN   (FIXED16_SCALE / 16)  // Eigenvalues
+#define PROJECT_BATCH_TOL_RADIUS  (FIXED16_SCALE / 8)   // Radius (3 sigma)
+GaussianResult project_gaussian_batch(const GaussianSplat3D* splats, const u32* indices, u32 count,
+                                      const CameraFixed* camera, GaussianSplat2D* out, u32* visible_mask);
 GaussianResult gaussian_luts_generate_all(GaussianLUTs* luts);
+GaussianResult gaussian_luts_load(GaussianLUTs* luts, const char* filename);
 GaussianResult gaussian_luts_upload_to_gs(GaussianLUTs* luts, void* gsGlobal);
 void gaussian_luts_cleanup(GaussianLUTs* luts);
+void footprint_atlas_build_mips(u8* alpha);
+u32 footprint_atlas_level(u32 diameter);
+void footprint_set_mip_bias(u32 bias);
+u32 footprint_get_mip_bias(void);
+void footprint_atlas_cell(u32 cell, u32 level, u32* u, u32* v);
+void footprint_atlas_pack(const u8* alpha, u8* texels);
+void footprint_clut_build(u32* clut);
 
 // Memory management functions
 GaussianResult memory_pool_init(MemoryPool* pool, u32 size, u32 alignment);
@@ -303,6 +589,11 @@ static inline fixed16_t fixed_mul_safe(fixed16_t a, fixed16_t b) {
     fixed16_t result;
     s32 hi, lo;
     
+#ifdef SPLATSTORM_HOST
+    s64 product = (s64)a * b;
+    hi = (s32)(product >> 32);
+    lo = (s32)product;
+#else
     // Use MIPS mult instruction and check for overflow
     __asm__ volatile (
         "mult   %2, %3          \n\t"   // Multiply a * b -> HI:LO
@@ -311,6 +602,7 @@ static inline fixed16_t fixed_mul_safe(fixed16_t a, fixed16_t b) {
         : "=r" (hi), "=r" (lo)          // Outputs: hi, lo
         : "r" (a), "r" (b)              // Inputs: a, b
     );
+#endif
     
     // Check for overflow by examining upper bits
     s32 shifted_hi = hi << 16;
@@ -342,6 +634,9 @@ static inline fixed16_t fixed_sub_safe(fixed16_t a, fixed16_t b) {
 
 // Optimized fixed-point multiplication using MIPS assembly - COMPLETE IMPLEMENTATION
 static inline fixed16_t fixed_mul(fixed16_t a, fixed16_t b) {
+#ifdef SPLATSTORM_HOST
+    return (fixed16_t)(((s64)a * b) >> 16);
+#else
     fixed16_t result;
     
     // Use MIPS mult instruction for 32x32->64 bit multiplication
@@ -359,6 +654,7 @@ static inline fixed16_t fixed_mul(fixed16_t a, fixed16_t b) {
     );
     
     return result;
+#endif
 }
 
 static inline fixed16_t fixed_add(fixed16_t a, fixed16_t b) {
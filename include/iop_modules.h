@@ -74,6 +74,22 @@ enum ENHANCED_MODLIST {
 
 #define BOOT_MODULE 99
 
+// Device classes whose drivers load on first use; the first five are the
+// device types get_boot_device() reports
+enum IOP_DEVICE_CLASS {
+    IOP_DEVICE_CDROM = 0,
+    IOP_DEVICE_USB_MASS,
+    IOP_DEVICE_HDD,
+    IOP_DEVICE_MEMCARD,
+    IOP_DEVICE_HOST,
+    IOP_DEVICE_PADS,
+    IOP_DEVICE_USB_INPUT,
+    IOP_DEVICE_AUDIO,
+    IOP_DEVICE_CLASSES
+};
+
+#define IOP_DEVICE_BIT(device_class) (1U << (device_class))
+
 // Core IRX modules
 irx_define(iomanX);
 irx_define(fileXio);
@@ -146,4 +162,12 @@ void iop_print_module_status(void);
 int iop_reload_module(int id);
 int iop_get_module_memory_usage(int id);
 
+// On-demand device drivers
+void iop_set_boot_path(const char* path);
+int iop_require_device(int device_class);
+int iop_require_path(const char* path);
+bool iop_device_ready(int device_class);
+u32 iop_prefetch_devices(u32 class_mask);
+bool iop_wait_prefetch(void);
+
 #endif // IOP_MODULES_H
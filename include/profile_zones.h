@@ -0,0 +1,147 @@
+/*
+ * SPLATSTORM X - Zone Profiler
+ * Static zone ids timed with the COP0 Count register, one row of per-zone
+ * cycles per frame kept in a PROFILE_HISTORY_FRAMES ring for percentiles
+ *
+ * A zone costs an mfc0 and a store to open and an mfc0, a subtract and an
+ * add to close. Zones nest freely and report inclusive time; each zone id
+ * must not nest inside itself. A zone left open by an early return simply
+ * adds nothing that frame. PROFILE_ZONE_BEGIN/END compile away in release
+ * builds (NDEBUG); the stage zones the quality controller reads call
+ * profile_zone_begin/end directly and are always on.
+ *
+ * Outside release builds each zone also takes deltas of the two EE
+ * performance counters, PCR0 and PCR1, counting the event pair picked with
+ * profile_zones_set_counters(). Counting is off until a pair is picked.
+ */
+
+#ifndef PROFILE_ZONES_H
+#define PROFILE_ZONES_H
+
+#include <tamtypes.h>
+#include <stdbool.h>
+
+#define PROFILE_HISTORY_FRAMES   128 // Power of two
+#define PROFILE_ZONE_GRAPH_FRAMES 50 // Newest frames in a debug graph
+
+#if !defined(NDEBUG) && !defined(SPLATSTORM_HOST)
+#define PROFILE_ZONE_COUNTERS    1   // Zones read PCR0/PCR1 as well
+#endif
+
+typedef enum {
+    PROFILE_ZONE_FRAME,                       // Main loop, frame to frame
+    PROFILE_ZONE_RENDER,                      // render_frame
+    PROFILE_ZONE_CULL,                        // Frustum and occlusion culling
+    PROFILE_ZONE_VU,                          // Projection; the whole VU1 submit on the direct path
+    PROFILE_ZONE_TILE,                        // LOD, binning and render regions
+    PROFILE_ZONE_GS,                          // GS wait, clear and draw submission
+    PROFILE_ZONE_GS_SYNC,                     // Wait for the previous frame, inside GS
+    PROFILE_ZONE_LOD,                         // Screen-space LOD, inside TILE
+    PROFILE_ZONE_STREAMING,                   // Scene streaming and paging
+    PROFILE_ZONE_BIN,                         // Fine tile binning, inside TILE
+    PROFILE_ZONE_SORT,                        // Per-tile depth sort, inside TILE
+    PROFILE_ZONE_PACKETS,                     // GIF packet build and send, inside GS
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+// PCR0/PCR1 event pairs, R5900 event numbers in the comments
+typedef enum {
+    PROFILE_COUNTERS_OFF,
+    PROFILE_COUNTERS_CACHE,                   // I-cache misses (6), D-cache misses (6)
+    PROFILE_COUNTERS_BRANCH,                  // Branches issued (3), branches mispredicted (3)
+    PROFILE_COUNTERS_ISSUE,                   // Instructions completed (12), dual issues (2)
+    PROFILE_COUNTERS_STALL,                   // Address bus busy (11), data bus busy (11)
+    PROFILE_COUNTER_SETS
+} ProfileCounterSet;
+
+typedef struct {
+    u32 start[PROFILE_ZONE_COUNT];            // Count register at the open
+    u32 cycles[PROFILE_ZONE_COUNT];           // This frame so far
+#ifdef PROFILE_ZONE_COUNTERS
+    u32 counter_start[2][PROFILE_ZONE_COUNT]; // PCR0/PCR1 at the open
+    u32 counters[2][PROFILE_ZONE_COUNT];      // PCR0/PCR1 events this frame so far
+#endif
+} ProfileZoneFrame;
+
+typedef struct {
+    u32 frames;                               // Frames summarized
+    float min_ms;
+    float avg_ms;
+    float max_ms;
+    float p50_ms;
+    float p95_ms;
+    float p99_ms;
+} ProfileZoneSummary;
+
+extern ProfileZoneFrame g_profile_zone_frame;
+
+// 32 bits wrap every 14.5 s at 294.912 MHz; one wrap inside a zone still
+// subtracts right. Host builds (make bench-host) read 0; the harness times
+// with its own clock.
+static inline u32 profile_zone_clock(void) {
+#ifdef SPLATSTORM_HOST
+    return 0;
+#else
+    u32 count;
+    __asm__ volatile("mfc0 %0, $9" : "=r"(count));
+    return count;
+#endif
+}
+
+#ifdef PROFILE_ZONE_COUNTERS
+// Reads stay legal with counting off (PCCR.CTE clear); the deltas are 0
+static inline u32 profile_zone_pcr0(void) {
+    u32 count;
+    __asm__ volatile("mfpc %0, 0" : "=r"(count));
+    return count;
+}
+
+static inline u32 profile_zone_pcr1(void) {
+    u32 count;
+    __asm__ volatile("mfpc %0, 1" : "=r"(count));
+    return count;
+}
+#endif
+
+static inline void profile_zone_begin(ProfileZone zone) {
+#ifdef PROFILE_ZONE_COUNTERS
+    g_profile_zone_frame.counter_start[0][zone] = profile_zone_pcr0();
+    g_profile_zone_frame.counter_start[1][zone] = profile_zone_pcr1();
+#endif
+    g_profile_zone_frame.start[zone] = profile_zone_clock();
+}
+
+static inline void profile_zone_end(ProfileZone zone) {
+    g_profile_zone_frame.cycles[zone] += profile_zone_clock() - g_profile_zone_frame.start[zone];
+#ifdef PROFILE_ZONE_COUNTERS
+    g_profile_zone_frame.counters[0][zone] += profile_zone_pcr0() - g_profile_zone_frame.counter_start[0][zone];
+    g_profile_zone_frame.counters[1][zone] += profile_zone_pcr1() - g_profile_zone_frame.counter_start[1][zone];
+#endif
+}
+
+// Cycles the zone has closed with so far this frame
+static inline u32 profile_zone_cycles(ProfileZone zone) {
+    return g_profile_zone_frame.cycles[zone];
+}
+
+#ifdef NDEBUG
+#define PROFILE_ZONE_BEGIN(zone) ((void)0)
+#define PROFILE_ZONE_END(zone)   ((void)0)
+#else
+#define PROFILE_ZONE_BEGIN(zone) profile_zone_begin(zone)
+#define PROFILE_ZONE_END(zone)   profile_zone_end(zone)
+#endif
+
+// Ring buffer and summaries (profiling_system.c)
+void profile_zones_reset(void);
+void profile_zones_end_frame(bool record);
+const char* profile_zone_name(ProfileZone zone);
+u32 profile_zone_history(ProfileZone zone, float* values_ms, u32 max_values);
+bool profile_zones_latest(u32 cycles[PROFILE_ZONE_COUNT], u32 events[2]);
+bool profile_zone_summary(ProfileZone zone, ProfileZoneSummary* summary);
+void profile_zones_set_counters(ProfileCounterSet set);
+ProfileCounterSet profile_zones_get_counters(void);
+const char* profile_counter_name(ProfileCounterSet set, u32 counter);
+bool profile_zone_counters(ProfileZone zone, float per_frame[2]);
+
+#endif // PROFILE_ZONES_H
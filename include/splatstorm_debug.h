@@ -8,6 +8,7 @@
 
     // COMPLETE IMPLEMENTATION - Full functionality
 #include <tamtypes.h>
+#include "profile_zones.h"
 
 
 // Debug Configuration
@@ -92,6 +93,7 @@ void debug_update_cycles(u32 vu0, u32 vu1, u32 gs, u32 dma);
 // On-Screen Display
 void debug_draw_overlay(void);
 void debug_draw_graph(const char* name, float* values, u32 count);
+void debug_draw_zone_graph(ProfileZone zone);
 void debug_draw_text(u32 x, u32 y, const char* text);
 
 // Memory Debugging
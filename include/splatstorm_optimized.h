@@ -27,7 +27,10 @@ void get_dma_stats(DMAStats* stats);
 int sorting_system_init(PackedSplat* splats, int count);
 void bucket_sort_splats_optimized(void);
 void sorting_camera_moved(void);
-int camera_moved_significantly(void);
+void sorting_splats_moved(void);
+void sorting_set_depth_axis(const float axis[4]);
+const u32* sorting_get_order(void);
+bool camera_moved_significantly(const CameraFixed* camera);
 void get_sorting_stats(int* last_sort_frame, int* buckets_used, float* sort_time_ms);
 void sorting_system_cleanup(void);
 
@@ -159,6 +159,8 @@ int dma_channel_shutdown(int channel, int flags);
 // VU1 Register Addresses  
 #define VU1_STAT            ((volatile u32*)0x10003400)
 #define VU1_FBRST           ((volatile u32*)0x10003410)
+#define VIF1_FBRST          ((volatile u32*)0x10003C10)
+#define VIF_FBRST_STC       0x8                // Cancel a stall (i bit, MARK)
 #define VU1_VF00            ((volatile u32*)0x11008000)
 #define VU1_MICRO_MEM       0x11008000
 #define VU1_DATA_MEM        0x1100C000
@@ -174,6 +176,96 @@ int dma_channel_shutdown(int channel, int flags);
 #define VU_STATUS_BUSY      0x0008
 #define VU_STATUS_ERROR     0x8000
 
+// VU0 culling engine batch size (spheres per VIF0 batch)
+#define VU0_CULL_BATCH_SIZE      96
+
+// VU Render Modes
+#define VU_RENDER_MODE_DOWNLOAD  0  // Results read back to EE, tiled GS submission
+#define VU_RENDER_MODE_XGKICK    1  // VU1 builds and XGKICKs sprites over PATH1
+
+// View-dependent (SH) color modes
+#define VU_SH_MODE_OFF           0  // Base color only
+#define VU_SH_MODE_FULL          1  // Degree 1-2 SH on VU1 for every splat, every frame
+#define VU_SH_MODE_CACHED        2  // Re-shaded only where the view direction turned past the threshold
+#define VU_SH_CACHE_THRESHOLD_DEFAULT 2.0f  // Degrees
+
+// Tile saturation early-out: block transmittance treated as opaque
+#define TILE_SATURATION_EPSILON_DEFAULT (1.0f / 64.0f)
+
+// Tile heatmap debug modes: what shades each tile
+#define TILE_HEATMAP_OFF         0
+#define TILE_HEATMAP_SPLATS      1  // Splats drawn in the tile
+#define TILE_HEATMAP_FILL        2  // Estimated pixels filled: sprite areas clipped to the tile
+#define TILE_HEATMAP_CYCLES      3  // EE cycles building and submitting the tile's sprites
+#define TILE_HEATMAP_MODES       4
+#define TILE_HEATMAP_TOP_TILES   8  // Hottest tiles in the readout
+
+// VU1 projection programs the auto-tuner chooses between (vu/*.vu1)
+#define VU1_MICROCODE_VARIANT_COUNT 5
+#define VU1_MICROCODE_DEFAULT    0  // gaussian_projection_fixed, the batch-contract program
+
+// Resident VU microcode manager (vu_microcode_manager.c)
+#define VU_UNIT_VU0              0
+#define VU_UNIT_VU1              1
+#define VU_MICROCODE_MAX_PROGRAMS 16
+#define VU_MICROCODE_MAX_MPG_TAGS 8  // REF+MPG tags per program, 128 qwords each
+
+// VU activity sampler (vu_activity.c), on EE timer 1
+#define VU_ACTIVITY_SAMPLE_HZ    16000  // Default rate, vusample=<hz> on the command line
+#define VU_ACTIVITY_MAX_HZ       72000  // One sample per 128 bus clocks at 1/16
+
+// Worker threads (worker_threads.c); lower numbers run first
+#define WORKER_INPUT_PRIORITY    32  // Pad reads, woken by VBLANK
+#define WORKER_IO_PRIORITY       63  // Job queue, asleep on I/O most of the time
+#define WORKER_RENDER_PRIORITY   64  // The main (render) thread
+#define WORKER_QUEUE_JOBS        64
+#define WORKER_JOB_PAYLOAD       160 // Bytes copied with each job
+
+// Boot timeline (profiling_system.c)
+#define BOOT_PROFILE_MAX_EVENTS  128
+#define BOOT_PROFILE_MAX_DEPTH   8   // Nested boot_profile_begin scopes
+#define BOOT_PROFILE_LOG         "mc0:/SPLATSTORM/BOOT.CSV"
+
+// Unit address splatstorm_network_configure applies (telemetry, network scenes)
+#define NETWORK_UNIT_IP          "192.168.1.100"
+#define NETWORK_UNIT_MASK        "255.255.255.0"
+#define NETWORK_UNIT_GATEWAY     "192.168.1.1"
+
+// Telemetry (telemetry.c): frame records to a host collector over UDP
+#define TELEMETRY_BATCH_FRAMES   16  // Records per datagram
+#define TELEMETRY_RING_BATCHES   8   // Batches queued or being sent before frames drop
+#define TELEMETRY_DEFAULT_PORT   9000
+#define TELEMETRY_MAGIC          0x4D545053  // 'SPTM'
+#define TELEMETRY_VERSION        3
+#define TELEMETRY_FLAG_REUSED    0x01        // Static frame, nothing drawn
+#define TELEMETRY_FLAG_FALLBACK  0x02        // Fallback mode active
+#define TELEMETRY_FLAG_DIRECT    0x04        // VU1 XGKICK render path
+#define TELEMETRY_FLAG_MEMORY    0x08        // A memory budget or the frame arena above its alert level
+
+// Benchmark mode (benchmark.c): recorded camera paths, per-frame CSV
+#define BENCHMARK_MAX_FRAMES     2700        // 90 s at 30 fps
+#define BENCHMARK_PATH_MAGIC     0x50435053  // 'SPCP'
+#define BENCHMARK_PATH_VERSION   1
+#define BENCHMARK_DEFAULT_CSV    "mass:/BENCH.CSV"
+#define BENCHMARK_CONFIG_FILE    "BENCH.CNF" // Options, one per line, next to the ELF
+#define BENCHMARK_SPLATS_MAGIC   0x44525053  // 'SPRD': projected splats for make bench-host
+#define BENCHMARK_SPLATS_VERSION 1
+
+// Frame capture (frame_capture.c): one frame's pipeline state for make frame-replay
+#define FRAME_CAPTURE_MAGIC      0x43465053  // 'SPFC'
+#define FRAME_CAPTURE_VERSION    1
+#define FRAME_CAPTURE_FLAG_SATURATION    0x01  // Saturation early-out on
+#define FRAME_CAPTURE_FLAG_TEXTURE_ORDER 0x02  // Equal-depth splats grouped by footprint cell
+#define FRAME_CAPTURE_SECTION_CAMERA     1     // CameraFixed
+#define FRAME_CAPTURE_SECTION_VISIBLE    2     // u32 scene indices after culling
+#define FRAME_CAPTURE_SECTION_PROJECTED  3     // GaussianSplatRender from VU1
+#define FRAME_CAPTURE_SECTION_LOD        4     // GaussianSplatRender after screen-space LOD
+#define FRAME_CAPTURE_SECTION_TILE_RANGES 5    // TileRange[MAX_TILES], into TILE_LISTS
+#define FRAME_CAPTURE_SECTION_TILE_LISTS 6     // u32 bins, tile after tile
+#define FRAME_CAPTURE_SECTION_REGIONS    7     // TileRegion
+#define FRAME_CAPTURE_SECTION_REGION_INDICES 8 // u32, by region start_index
+#define FRAME_CAPTURE_SECTION_GIF        9     // One submitted GIF chunk, qwords
+
 // Memory Pool Base Addresses
 #define EE_CODE_BASE        (void*)0x00100000
 #define EE_DOUBLE_BUFFER_A  (void*)0x00200000
@@ -183,13 +275,7 @@ int dma_channel_shutdown(int channel, int flags);
 #define EE_STACK_HEAP       (void*)0x00600000
 #define EE_IOP_MODULES      (void*)0x00700000
 
-// VRAM Pool Base Addresses
-#define VRAM_SPLAT_ATLAS    (void*)0x00000000
-#define VRAM_OCTREE_MAP     (void*)0x00100000
-#define VRAM_LIGHT_PROBE    (void*)0x00200000
-#define VRAM_ZBUFFER        (void*)0x00300000
-#define VRAM_FRAMEBUFFER    (void*)0x00400000
-#define VRAM_GS_CONTEXT     (void*)0x00500000
+// GS VRAM is handed out in page/block units by gs_vram_alloc (gs_vram_complete.c)
 
 // Fixed-point math types
 typedef s32 fixed16_t;
@@ -528,6 +614,9 @@ int close_file(int fd);
 long get_file_size(int fd);
 int file_exists(const char* filename);
 void file_system_shutdown(void);
+u32 storage_benchmark_devices(bool force);
+bool storage_get_benchmark(u32 device, const char** name, const char** prefix,
+                           u32* read_kbps, u32* open_latency_us);
 
 // Performance Counter Functions
 u64 get_cpu_cycles(void);
@@ -558,6 +647,7 @@ int hardware_has_network_adapter(void);
 int hardware_has_hdd(void);
 int hardware_has_usb(void);
 int hardware_has_firewire(void);
+int hardware_is_dev_unit(void);
 void hardware_detection_shutdown(void);
 
 // Enhanced system structures (forward declarations)
@@ -617,9 +707,11 @@ int splatstorm_network_configure(const char* ip, const char* mask, const char* g
 bool splatstorm_network_is_connected(void);
 const char* splatstorm_network_get_ip(void);
 int splatstorm_network_create_socket(void);
+int splatstorm_network_create_udp_socket(void);
 int splatstorm_network_connect(int sock, const char* host, int port);
 int splatstorm_network_send(int sock, const void* data, size_t size);
 int splatstorm_network_receive(int sock, void* buffer, size_t size);
+int splatstorm_network_receive_nowait(int sock, void* buffer, size_t size);
 void splatstorm_network_close_socket(int sock);
 void splatstorm_network_get_stats(network_stats_t* stats);
 
@@ -674,6 +766,9 @@ int splatstorm_asset_load_batch(const char** filenames, int count);
 // Enhanced IOP module system
 #include "iop_modules.h"
 
+// Zone profiler: static zones, per-frame history and percentiles
+#include "profile_zones.h"
+
 // Additional type definitions for main_complete.c
 typedef struct {
     u8 left_stick_x, left_stick_y;    // 0-255, center at 128
@@ -682,6 +777,16 @@ typedef struct {
     u32 buttons_pressed;
 } InputState;
 
+// I/O worker job: gets the posted arg, or its payload copy when arg is NULL
+typedef void (*WorkerJob)(void* arg);
+
+// Boot timeline event kinds
+typedef enum {
+    BOOT_EVENT_PHASE,                 // Init step: boot_profile_begin/phase
+    BOOT_EVENT_IRX,                   // One IOP module load
+    BOOT_EVENT_MARK                   // Instant, e.g. the first frame
+} BootEventKind;
+
 typedef struct {
     bool initialized;
     int pad_state;
@@ -728,13 +833,16 @@ typedef enum {
 #define INPUT_BUTTON_SELECT     0x0100
 #define INPUT_BUTTON_START      0x0800
 #define INPUT_BUTTON_TRIANGLE   0x1000
+#define INPUT_BUTTON_CIRCLE     0x2000
+#define INPUT_BUTTON_CROSS      0x4000
 #define INPUT_BUTTON_SQUARE     0x8000
 
 // Include gaussian types
 #include "gaussian_types.h"
 
 // Scene constants
-#define MAX_SCENE_SPLATS    MAX_SPLATS
+#define MAX_SCENE_SPLATS    MAX_SPLATS      // Projected splats the tile system starts sized for; it grows
+#define SCENE_LOAD_SPLAT_BUDGET 0           // Most important splats kept at load, 0 keeps all
 
 // Additional function declarations for complete implementations
 int memory_system_init(void);
@@ -744,6 +852,61 @@ void* memory_pool_alloc(u32 pool_id, u32 size, u32 alignment, const char* file,
 #define MEMORY_POOL_ALLOC(pool_id, size) memory_pool_alloc(pool_id, size, 16, __FILE__, __LINE__)
 void memory_pool_free(u32 pool_id, void* ptr);
 void memory_pool_reset(u32 pool_id);
+void* memory_alloc_at(MemoryBudgetClass budget, u32 size, u32 alignment, const char* file, u32 line);
+#define memory_alloc(budget, size, alignment) memory_alloc_at(budget, size, alignment, __FILE__, __LINE__)
+void memory_free(void* ptr);
+bool memory_budget_fits(MemoryBudgetClass budget, u32 size);
+u32 memory_budget_pool(MemoryBudgetClass budget);
+void memory_get_budget_stats(MemoryBudgetClass budget, MemoryBudgetStats* stats);
+void memory_budget_print(void);
+void memory_budget_set_alert(MemoryBudgetClass budget, u32 bytes);
+bool memory_budget_set_size(MemoryBudgetClass budget, u32 bytes);
+MemoryBudgetClass memory_budget_find(const char* name, u32 length);
+bool memory_parse_alert_option(const char* option);
+void memory_budget_end_frame(void);
+bool memory_alert_active(void);
+u32 memory_get_callsites(MemoryCallsiteStats* sites, u32 max_sites);
+void memory_get_statistics(MemoryStats* stats);
+
+// Hardware profiles (hardware_profile.c): engine defaults per console class
+typedef enum {
+    HARDWARE_PROFILE_FAT,                     // Fat console without an HDD in use
+    HARDWARE_PROFILE_FAT_HDD,                 // Fat console booted from or fitted with the HDD
+    HARDWARE_PROFILE_SLIM,                    // SCPH-70000 and later, no expansion bay
+    HARDWARE_PROFILE_DEVKIT,                  // DTL-T development units
+    HARDWARE_PROFILE_EMULATOR,                // Named only: emulators report a retail BIOS
+    HARDWARE_PROFILE_COUNT
+} HardwareProfileId;
+
+#define HARDWARE_PROFILE_CONFIG_FILE  "PROFILE.CNF"  // Profile overrides next to the ELF
+#define HARDWARE_PROFILE_STORAGE_MAX  4
+
+typedef struct {
+    const char* name;
+    u32 pool_sizes[MEMORY_BUDGET_COUNT];      // Memory budget sizes in bytes
+    u32 vu_render_mode;                       // VU_RENDER_MODE_* to start in
+    u32 vu_microcode;                         // VU1 program (VU1_MICROCODE_* index) untuned or as fallback
+    bool vu_autotune;                         // Time the VU1 programs on each scene
+    const char* storage[HARDWARE_PROFILE_STORAGE_MAX];  // Scene cache device prefixes, first tried first
+    u32 storage_count;
+    u32 resolution_level;                     // Render size level to start at
+    bool field_rendering;                     // One half-height image per interlaced field
+    u32 max_splats;                           // Visible splats drawn per frame
+    u32 load_splat_budget;                    // Splats kept at load, 0 = all
+} HardwareProfile;
+
+const HardwareProfile* hardware_profile_select(const char* boot_path, const char* forced);
+const HardwareProfile* hardware_profile_get(void);
+HardwareProfileId hardware_profile_id(void);
+u32 hardware_profile_storage_mask(void);
+int frame_arena_init(u32 size);
+void frame_arena_cleanup(void);
+bool frame_arena_active(void);
+void frame_arena_begin(void);
+void* frame_arena_alloc(u32 size, u32 alignment);
+void frame_arena_mark(FrameArenaStage stage);
+void frame_arena_rollback(FrameArenaStage stage);
+void frame_arena_get_stats(FrameArenaStats* stats);
 int input_system_init(void);
 void input_system_cleanup(void);
 void input_update(InputState* input);
@@ -752,43 +915,223 @@ void vu_system_cleanup(void);
 int vu_load_microcode(void);
 GaussianResult dma_system_init(void);
 void dma_system_cleanup(void);
+void dma_wait_channel(int channel);
+void dma_set_completion_callback(int channel, void (*callback)(int channel));
+void dma_get_completion_stats(int channel, u32* completions, u64* wait_cycles);
+void dma_account_transfer(int channel, u32 bytes);
+void dma_account_wait(int channel, u32 cycles);
+void dma_stats_end_frame(void);
+void dma_get_channel_stats(DMAChannelStats* stats);
+const char* dma_stats_channel_name(DMAStatsChannel channel);
+void vu_wait_vu1_idle(void);
+void vu_get_wait_stats(u32* end_interrupts, u64* sleep_cycles);
+GaussianResult vu_activity_start(u32 sample_hz);
+void vu_activity_stop(void);
+bool vu_activity_running(void);
+void vu_activity_end_frame(void);
+void vu_activity_get_stats(VUActivityStats* stats);
+float vu_activity_busy_fraction(u32 vu_unit);
+GaussianResult dma_setup_chain_transfer(const void** data_blocks, const u32* sizes,
+                                       u32 block_count, u32 channel);
+GaussianResult dma_execute_chain_transfer(u32 channel);
+GaussianResult dma_spr_stream(const void* records, u32 record_size, const u32* indices, u32 count,
+                              SprStreamKernel kernel, void* user);
 int tile_system_init(u32 max_splats);
+void tile_system_use_frame_arena(bool enable);
+void tile_set_texture_order(bool enable);
+void tile_set_render_size(u32 width, u32 height);
 GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm);
+void gs_renderer_set_field_rendering(bool enabled);
+bool gs_renderer_get_field_rendering(void);
+void gs_renderer_set_depth_buffer(bool enabled);
+bool gs_renderer_get_depth_buffer(void);
+void gs_renderer_set_triple_buffering(bool enabled);
+bool gs_renderer_get_triple_buffering(void);
+void gs_wait_vblank(void);
+void gs_renderer_set_frame_latency(u32 frames);
+u32 gs_renderer_get_frame_latency(void);
+void gs_sync_frame(void);
+u64 gs_get_sync_wait_cycles(void);
+GaussianResult worker_system_init(void);
+void worker_system_shutdown(void);
+bool worker_system_active(void);
+bool worker_post_job(WorkerJob function, void* arg, const void* payload, u32 payload_size);
+void worker_flush(void);
+bool worker_input_read(InputState* input);
+bool worker_input_peek(InputState* input);
+void worker_get_stats(u32* jobs_posted, u32* jobs_pending, u32* jobs_dropped, u32* input_polls);
+GaussianResult gs_vram_init(void);
+bool gs_vram_is_initialized(void);
+void gs_vram_cleanup(void);
+u32 gs_vram_buffer_blocks(u32 width, u32 height, u32 psm);
+u32 gs_vram_alloc(u32 width, u32 height, u32 psm);
+u32 gs_vram_alloc_blocks(u32 blocks);
+GaussianResult gs_vram_reserve(u32 tbp, u32 blocks);
+void gs_vram_free(u32 tbp);
+u32 gs_vram_texture_upload(GSTextureId id, const void* data, u32 width, u32 height, u32 psm);
+u32 gs_vram_texture_bind(GSTextureId id);
+void gs_vram_texture_pin(GSTextureId id, bool pinned);
+void gs_vram_texture_evict(GSTextureId id);
+void gs_vram_texture_release(GSTextureId id);
+void gs_vram_next_frame(void);
+void gs_vram_get_stats(GSVramStats* stats);
 void camera_init_fixed(void* camera);
 void camera_set_position_fixed(void* camera, float x, float y, float z);
+void camera_set_pose_fixed(void* camera, const fixed16_t position[3], const fixed16_t rotation[4]);
 void camera_set_target_fixed(void* camera, float x, float y, float z);
 void camera_update_matrices_fixed(void* camera);
+bool camera_begin_frame(void* camera);
+void camera_pad_frustum_fixed(const CameraFixed* camera, float margin, CameraFixed* padded);
 void camera_move_relative_fixed(void* camera, float x, float y, float z);
 void camera_rotate_fixed(void* camera, float pitch, float yaw, float roll);
 void camera_extract_frustum_fixed(void* camera, Frustum* frustum);
 int load_ply_file_fixed(const char* filename, void* splats, u32* count);
 
+// Pipelined reads (file_system_complete.c): decode gets each block in file
+// order while the next one is being read
+typedef GaussianResult (*FileBlockDecoder)(const u8* block, u32 size, u32 file_offset, void* user);
+GaussianResult file_read_pipelined(const char* filename, u32 offset, u32 length, u32 block_size,
+                                   FileBlockDecoder decode, void* user, u32* delivered);
+
 // Complete PLY loader functions
 GaussianResult load_ply_file(const char* filename, GaussianSplat3D** splats, u32* count);
+GaussianResult load_ply_file_budgeted(const char* filename, GaussianSplat3D** splats, u32* count, u32 budget);
 GaussianResult validate_ply_file(const char* filename, u32* vertex_count);
 GaussianResult get_ply_info(const char* filename, PLYFileInfo* info);
 
+// Cooked scene loader (asset_loader_real.c, files from tools/cook_scene.py).
+// A scene named net:<host>[:port]/<name> streams from tools/scene_server.py.
+#define SCENE_SERVER_PREFIX        "net:"
+#define SCENE_SERVER_DEFAULT_PORT  9100
+GaussianResult load_cooked_scene(const char* filename, GaussianScene* scene);
+GaussianResult load_packed_scene(const char* filename, GaussianScene* scene);
+GaussianResult scene_cache_load(const char* filename, u32 load_budget, GaussianScene* scene);
+GaussianResult scene_cache_store(const char* filename, u32 load_budget, const GaussianScene* scene);
+GaussianResult scene_stream_begin(const char* filename, GaussianScene* scene);
+GaussianResult scene_stream_update(bool wait);
+bool scene_stream_active(void);
+void scene_stream_cancel(void);
+GaussianResult scene_paging_open(const char* filename, GaussianScene* scene, u32 max_resident);
+GaussianResult scene_paging_update(const fixed16_t camera_position[3], u32 splat_budget);
+bool scene_paging_active(void);
+void scene_paging_get_stats(u32* resident_pages, u32* loads, u32* evictions);
+void scene_paging_close(void);
+
 // Complete frustum culling functions
 GaussianResult init_spatial_grid(const GaussianSplat3D* splats, u32 splat_count);
+GaussianResult init_spatial_grid_streams(const GaussianSplatStreams* streams);
+GaussianResult load_octree_index(const char* filename, const GaussianSplat3D* splats, u32 splat_count);
+GaussianResult init_spatial_grid_cooked(void* nodes, u32 node_count, u32 node_stride,
+                                        u32* splat_indices, u32 splat_count,
+                                        const GaussianSplatStreams* refit_streams);
+GaussianResult init_spatial_grid_paged(void* nodes, u32 node_count, u32 node_stride,
+                                       u32* splat_indices, u32 index_capacity, u32 leaf_count);
+GaussianResult spatial_grid_set_leaf_counts(const u32* leaf_counts, u32 leaf_count);
+GaussianResult spatial_grid_remap_splats(const u32* remap, u32 splat_count);
+GaussianResult spatial_grid_linearize(GaussianSplat3D* splats, GaussianSplatStreams* streams, u32 splat_count);
+u32 spatial_grid_refit_splats(const GaussianSplat3D* splats, const GaussianSplatStreams* streams,
+                              u32 first, u32 count);
+GaussianResult spatial_grid_export(const void** nodes, u32* node_count, u32* node_stride,
+                                   const u32** splat_indices, u32* splat_count);
+
+// VU0 culling engine (vu_culling.c)
+int vu_culling_init(void);
+void vu_culling_shutdown(void);
+int vu0_cull_engine_set_planes(const float planes[6][4]);
+float* vu0_cull_engine_begin_batch(u32* buffer_id);
+int vu0_cull_engine_submit(u32 count);
+int vu0_cull_engine_collect(u16* masks, u32* buffer_id);
+u32 vu0_cull_engine_in_flight(void);
 GaussianResult extract_frustum_planes(const fixed16_t view_proj_matrix[16], void* frustum);
 GaussianResult cull_gaussian_splats(const GaussianSplat3D* input_splats, u32 input_count,
                                    const fixed16_t view_proj_matrix[16],
                                    GaussianSplat3D* output_splats, u32* output_count);
+GaussianResult cull_gaussian_splat_streams(const GaussianSplatStreams* streams, u32 input_count,
+                                          const fixed16_t view_proj_matrix[16],
+                                          GaussianSplat3D* output_splats, u32* output_count);
+GaussianResult cull_gaussian_splat_indices(const GaussianSplat3D* input_splats,
+                                          const GaussianSplatStreams* streams, u32 input_count,
+                                          const fixed16_t view_proj_matrix[16],
+                                          u32* visible_indices, u32 visible_capacity, u32* visible_count);
 GaussianResult get_culling_stats(CullingStats* stats);
+void cull_importance_invalidate(u32 first, u32 count);
+CullIndex* cull_index_create(const GaussianSplat3D* splats, u32 splat_count);
+void cull_index_destroy(CullIndex* index);
+void cull_index_bounds(const CullIndex* index, fixed16_t bounds_min[3], fixed16_t bounds_max[3]);
+GaussianResult cull_index_splat_indices(CullIndex* index, const GaussianSplat3D* splats, u32 splat_count,
+                                        const fixed16_t view_proj_matrix[16],
+                                        u32* visible_indices, u32 visible_capacity, u32* visible_count);
 bool is_sphere_visible(const fixed16_t center[3], fixed16_t radius, void* frustum_ptr);
 void cleanup_frustum_culling(void);
 GaussianResult gs_upload_lut_textures(const GaussianLUTs* luts);
 int vu_upload_constants(void* camera);
+int vu_upload_instance_constants(void* camera, const fixed16_t transform[16]);
 void vu_wait_for_completion(void);
 void gs_clear_buffers(u32 color, u32 depth);
+void gs_setup_gaussian_texturing(void);
+void gs_flush_command_buffer(void);
 void gs_swap_contexts(void);
 int vu_process_batch(void* visible_splats, u32 visible_count, void* projected_splats, u32* projected_count);
+int vu_render_batch_direct(void* visible_splats, u32 visible_count, u32* kicked_count);
+int vu_process_indexed(const GaussianSplat3D* scene_splats, const u32* indices, u32 count,
+                       GaussianSplatRender* projected_splats, u32* projected_count);
+int vu_render_indexed_direct(const GaussianSplat3D* scene_splats, const u32* indices, u32 count,
+                             u32* kicked_count);
+void vu_set_render_mode(u32 mode);
+u32 vu_get_render_mode(void);
+void vu_set_sh_mode(u32 mode, float threshold_degrees);
+u32 vu_get_sh_mode(void);
+int vu_sh_cache_init(u32 splat_count);
+void vu_sh_cache_invalidate(u32 first, u32 count);
+int vu_autotune_microcode(const GaussianSplat3D* splats, u32 splat_count, const CameraFixed* camera);
+u32 vu_get_microcode_variant(void);
+int vu_set_default_microcode(u32 variant, bool autotune);
+u32 vu_find_microcode_variant(const char* name);
+int vu_microcode_manager_init(void);
+int vu_microcode_register(u32 unit, const char* name, const u32* start, const u32* end);
+u32 vu_microcode_build_mpg(u32 program_id, u64* chain, u32* entry);
+int vu_microcode_upload(u32 program_id, u32* entry);
+bool vu_microcode_is_resident(u32 program_id);
+void vu_microcode_invalidate(u32 unit);
+void vu_microcode_get_stats(u32* transfers, u32* transfer_qwords, u32* resident_hits);
+void vu_reset_performance_counters(void);
+u64 gs_get_splat_prim(void);
+void tile_set_lod_quality(u32 quality_level);
+u32 tile_lod_aggregate(GaussianSplatRender* splats, u32 splat_count);
+void tile_set_saturation_cull(bool enable, float epsilon);
+bool tile_get_saturation_cull(void);
+float tile_get_saturation_epsilon(void);
+bool tile_get_texture_order(void);
+void tile_set_layout_reuse(bool enable);
+void tile_get_binning_stats(u32* one_pass_frames, u32* fallbacks, u32* border_splats);
+void tile_set_occlusion_culling(bool enable);
+bool tile_occlusion_available(void);
+bool tile_occlusion_test(float ndc_min_x, float ndc_min_y, float ndc_max_x, float ndc_max_y, u32 nearest_depth);
+void tile_get_occlusion_stats(u32* queries, u32* hidden);
+void tile_set_heatmap_mode(u32 mode);
+u32 tile_get_heatmap_mode(void);
+const char* tile_heatmap_mode_name(u32 mode);
+void tile_heatmap_add_cycles(u32 x, u32 y, u32 width, u32 height, u32 cycles);
+const u32* tile_get_heatmap(u32* tiles_x, u32* tiles_y, u32* max_value);
+u32 tile_heatmap_hottest(u32* tile_ids, u32* values, u32 max_tiles);
 int process_tiles(void* projected_splats, u32 projected_count, void* camera, void* tile_ranges);
+bool assign_splats_to_tiles(const GaussianSplatRender* splats, u32 splat_count);
+void sort_splats_by_depth(const GaussianSplatRender* splats);
+GaussianResult gs_set_render_resolution(u32 width, u32 height);
+void gs_get_render_resolution(u32* width, u32* height);
 void gs_set_scissor_rect(u32 x, u32 y, u32 width, u32 height);
+void gs_clear_rect(u32 x, u32 y, u32 width, u32 height, u32 color);
 void gs_disable_scissor(void);
 const u32* get_tile_splat_list(u32 tile_id, u32* count);
+u32 tile_build_render_regions(const GaussianSplatRender* splats, u32 splat_count,
+                              TileRegion* regions, u32 max_regions);
+const u32* tile_get_region_indices(void);
+void tile_get_region_stats(u32* hot_tiles, u32* split_regions, u32* sparse_blocks, u32* merged_regions);
+bool tile_is_covered(u32 tile_id);
 void gs_render_splat_batch(const GaussianSplat2D* splats, u32 splat_count);
+void gs_render_splat_indices(const GaussianSplatRender* splats, const u32* indices, u32 index_count);
 void gs_render_debug_overlay(void);
+void gs_render_heatmap(const u32* heat, u32 tiles_x, u32 tiles_y, u32 max_value);
 void gs_enable_debug_mode(bool show_tiles, bool show_centers, u32 overlay_color);
 void gs_renderer_cleanup(void);
 void tile_system_cleanup(void);
@@ -814,5 +1157,73 @@ void profile_get_frame_data(FrameProfileData* data);
 void profiling_get_stats_summary(float* avg_frame_time, float* current_fps, u32* total_frames, u32* avg_splats);
 void profiling_end_frame(void);
 float profiling_get_frame_time(void);
+void boot_profile_start(void);
+void boot_profile_begin(const char* name);
+void boot_profile_phase(const char* name);
+void boot_profile_end(void);
+void boot_profile_event(const char* name, BootEventKind kind, u64 start_cycles, u64 end_cycles);
+void boot_profile_mark(const char* name);
+void boot_profile_finish(const char* log_path);
+bool boot_profile_finished(void);
+void boot_profile_print(void);
+GaussianResult boot_profile_export(const char* filename);
+void boot_profile_get_summary(float* total_ms, const char** slowest_name, float* slowest_ms);
+
+// Telemetry (telemetry.c)
+GaussianResult telemetry_start(const char* destination);
+void telemetry_stop(void);
+bool telemetry_active(void);
+void telemetry_record_frame(u32 frame, const FrameProfileData* profile, u8 quality_level, u8 resolution_level,
+                            u8 flags);
+void telemetry_get_stats(u32* frames_recorded, u32* batches_sent, u32* batches_dropped);
+
+// Benchmark mode (benchmark.c)
+typedef enum {
+    BENCHMARK_OFF,
+    BENCHMARK_RECORD,                 // Live camera, path saved at the end
+    BENCHMARK_REPLAY                  // Camera from a recorded path, one pose per frame
+} BenchmarkMode;
+
+bool benchmark_parse_option(const char* option);
+u32 benchmark_load_config(const char* boot_path);
+const char* benchmark_get_scene(void);
+GaussianResult benchmark_start(void);
+BenchmarkMode benchmark_mode(void);
+bool benchmark_apply_camera(CameraFixed* camera);
+bool benchmark_record_frame(const CameraFixed* camera, const FrameProfileData* profile);
+void benchmark_capture_splats(const GaussianSplatRender* splats, u32 count);
+GaussianResult benchmark_finish(void);
+
+// Frame capture (frame_capture.c)
+bool frame_capture_parse_option(const char* option);
+void frame_capture_begin(u32 frame, const CameraFixed* camera, u32 quality_level);
+bool frame_capture_active(void);
+void frame_capture_write(u32 section, const void* records, u32 record_size, u32 count);
+void frame_capture_tiles(const TileRange* ranges);
+void frame_capture_regions(const TileRegion* regions, u32 region_count, const u32* indices);
+void frame_capture_end(void);
+
+// Instanced splat assets (scene_instances.c)
+int scene_asset_load(const char* filename);
+int scene_instance_add(u32 asset, const fixed16_t transform[16]);
+GaussianResult scene_instance_set_transform(u32 instance, const fixed16_t transform[16]);
+void scene_instance_set_enabled(u32 instance, bool enabled);
+bool scene_instance_parse_option(const char* option);
+u32 scene_instances_count(void);
+u32 scene_instances_revision(void);
+u32 scene_instances_cull(const CameraFixed* camera, u32* visible_indices, u32 capacity);
+GaussianResult scene_instances_project(CameraFixed* camera, const u32* visible_indices,
+                                       GaussianSplatRender* projected_splats, u32* projected_count);
+GaussianResult scene_instances_render_direct(CameraFixed* camera, const u32* visible_indices, u32* kicked_count);
+void scene_instances_get_stats(u32* instances, u32* visible_instances, u32* visible_splats);
+void scene_instances_clear(void);
+
+// Dynamic splats (scene_dynamic.c)
+GaussianResult scene_splats_update(GaussianScene* scene, u32 first, u32 count, const SplatUpdate* updates,
+                                   u32 fields);
+GaussianResult scene_splats_mark_dirty(const GaussianScene* scene, u32 first, u32 count, u32 fields);
+u32 scene_splats_apply_updates(GaussianScene* scene);
+void scene_splats_get_update_stats(u32* splats, u32* ranges, u32* nodes);
+void scene_splats_reset_updates(void);
 
 #endif // SPLATSTORM_X_H
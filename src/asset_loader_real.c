@@ -2,14 +2,24 @@
  * SPLATSTORM X - Real Asset Loading System
  * Replaces stub functions with actual binary file loading
  * Based on your technical specifications for custom binary format
+ * Version 2 "cooked" scenes (tools/cook_scene.py) load with a single read,
+ * or stream in progressively over fileXio async reads or from a host
+ * scene server over TCP (net:<host>[:port]/<name>, tools/scene_server.py)
+ * Version 3 "packed" scenes are compressed ~14x and decode at read speed
+ * Version 4 "paged" scenes are packed scenes cut into spatial pages that a
+ * fixed cache loads around the camera, so scene size is not bounded by RAM
+ * Converted PLY scenes are cached as cooked scenes keyed by their source
  */
 
 #include <tamtypes.h>
 #include <stdio.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <string.h>
+#include <stdlib.h>
 #include <malloc.h>
+#include <fileXio_rpc.h>
 #include "splatstorm_x.h"
 
 // Binary file format header
@@ -22,6 +32,102 @@ typedef struct {
 
 #define SPLAT_MAGIC 0x53504C54  // 'SPLT'
 #define SPLAT_VERSION 1
+#define SPLAT_VERSION_COOKED 2
+#define SPLAT_VERSION_PACKED 3
+#define SPLAT_VERSION_PAGED 4
+
+// Cooked scene sections, in payload order. Each starts on a DMA_ALIGNMENT
+// boundary and holds the final in-memory layout of that array.
+typedef enum {
+    COOKED_SECTION_RECORDS,         // GaussianSplat3D records (VU1 DMA source)
+    COOKED_SECTION_HOT,             // GaussianSplatHot, radius precomputed
+    COOKED_SECTION_WARM,            // GaussianSplatWarm
+    COOKED_SECTION_COLD,            // GaussianSplatCold
+    COOKED_SECTION_OCTREE_NODES,    // Culling octree nodes, bounds include radii
+    COOKED_SECTION_OCTREE_INDICES,  // u32 splat indices grouped by subtree
+    COOKED_SECTION_COUNT
+} CookedSection;
+
+typedef struct {
+    u32 offset;         // Bytes from the start of the payload
+    u32 size;           // Section bytes (count * stride)
+    u32 stride;         // Element size the cooker wrote
+    u32 count;          // Elements
+} CookedSectionEntry;
+
+// Packed (version 3) scene sections: a compressed cooked scene, decoded
+// block by block into the version 2 layout as it is read
+typedef enum {
+    PACKED_SECTION_SH_CODEBOOK,     // u16[16] SH coefficient vectors, at most 256
+    PACKED_SECTION_OCTREE_NODES,    // Culling octree nodes, refit after decoding
+    PACKED_SECTION_LEAF_FRAMES,     // PackedLeafFrame per octree leaf, in splat order
+    PACKED_SECTION_SPLATS,          // PackedSplat records in octree leaf order, last in the file
+    PACKED_SECTION_COUNT
+} PackedSection;
+
+// Bounds of one octree leaf and the run of splats quantized across them
+typedef struct {
+    fixed16_t bounds_min[3];
+    fixed16_t bounds_max[3];
+    u32 splat_count;
+    u32 reserved;
+} PackedLeafFrame;
+
+// 16-byte compressed splat: 14x smaller than a record plus its streams
+typedef struct {
+    u32 position;       // x:11 y:10 z:11 (high to low) across the leaf's bounds
+    u32 rotation;       // Smallest-three quaternion: largest index:2, three 10-bit components
+    u8 scale[3];        // log2(scale) in 1/16 octaves, 128 = 1.0
+    u8 sh_index;        // SH codebook entry
+    u8 color[3];        // RGB (0-255)
+    u8 opacity;         // Opacity (0-255)
+} PackedSplat;
+
+#define PACKED_SH_CODEBOOK_MAX 256
+#define PACKED_BLOCK_SPLATS    4096     // 64 KB per read; two blocks in flight
+#define PACKED_POS_X_BITS      11
+#define PACKED_POS_Y_BITS      10
+#define PACKED_POS_Z_BITS      11
+
+// Paged (version 4) scene sections: the tables before PAGE_DATA stay resident,
+// pages are read from PAGE_DATA as the camera approaches them
+typedef enum {
+    PAGED_SECTION_SH_CODEBOOK,      // u16[16] SH coefficient vectors, at most 256
+    PAGED_SECTION_PAGE_NODES,       // Culling octree cut at page level; its leaves are the pages
+    PAGED_SECTION_PAGES,            // PagedPage per page tree leaf, depth-first
+    PAGED_SECTION_PROXIES,          // PackedSplat LOD proxies, quantized across their page's bounds
+    PAGED_SECTION_PAGE_DATA,        // Per page: its leaf frames, then its splats; last in the file
+    PAGED_SECTION_COUNT
+} PagedSection;
+
+// One page: an octree subtree of at most SCENE_PAGE_SPLATS splats, and the
+// few coarse splats drawn in its place while it is not resident
+typedef struct {
+    fixed16_t bounds_min[3];    // Subtree bounds, including splat and proxy radii
+    fixed16_t bounds_max[3];
+    u32 data_offset;            // Bytes into PAGE_DATA, DMA_ALIGNMENT-aligned
+    u16 frame_count;            // PackedLeafFrames at data_offset
+    u16 splat_count;            // PackedSplats after them
+    u32 proxy_first;            // First proxy in PROXIES
+    u32 proxy_count;
+} PagedPage;
+
+#define SCENE_PAGE_SPLATS     1024      // Splats per page and per cache slot
+#define SCENE_PAGE_SLOTS_MAX  64
+#define SCENE_PAGE_NONE       0xFFFF
+#define SCENE_PAGE_LOOKAHEAD  30.0f     // Frames of camera velocity the prefetch runs ahead
+#define SCENE_PAGE_HYSTERESIS 1.25f     // A resident page only gives way to one this much closer
+
+// Cooked file header (128 bytes): the payload that follows it is read in
+// one call straight into a scene-budget block
+typedef struct {
+    u32 magic;          // 'SPLT' magic number
+    u32 version;        // SPLAT_VERSION_COOKED
+    u32 splat_count;    // Number of splats
+    u32 payload_size;   // Bytes after the header, multiple of DMA_ALIGNMENT
+    CookedSectionEntry sections[COOKED_SECTION_COUNT];
+    u32 reserved[4];    // Pad to 128 bytes
+} CookedSceneHeader;
 
 /*
  * Load Gaussian splat scene from binary file
@@ -65,7 +171,7 @@ int load_gaussian_splat_scene(const char* filename, GaussianSplat3D** splats, in
         return -5;
     }
     
-    if (header.splat_count == 0 || header.splat_count > 65536) {
+    if (header.splat_count == 0 || header.splat_count > MAX_SPLATS_PER_SCENE) {
         debug_log_error("Invalid splat count: %d", header.splat_count);
         close(fd);
         return -6;
@@ -74,9 +180,9 @@ int load_gaussian_splat_scene(const char* filename, GaussianSplat3D** splats, in
     debug_log_info("File header valid: %d splats, version %d", 
                    header.splat_count, header.version);
     
-    // Allocate memory for splats (16-byte aligned for DMA)
+    // Allocate memory for splats from the scene budget
     size_t splat_data_size = header.splat_count * sizeof(GaussianSplat3D);
-    *splats = (GaussianSplat3D*)splatstorm_malloc(splat_data_size);
+    *splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, splat_data_size, CACHE_LINE_SIZE);
     if (!*splats) {
         debug_log_error("Failed to allocate memory for %d splats", header.splat_count);
         close(fd);
@@ -86,7 +192,7 @@ int load_gaussian_splat_scene(const char* filename, GaussianSplat3D** splats, in
     // Read splat data
     if (read(fd, *splats, splat_data_size) != (int)splat_data_size) {
         debug_log_error("Failed to read splat data");
-        splatstorm_free(*splats);
+        memory_free(*splats);
         *splats = NULL;
         close(fd);
         return -8;
@@ -99,6 +205,1474 @@ int load_gaussian_splat_scene(const char* filename, GaussianSplat3D** splats, in
     return 0;
 }
 
+// Check a cooked header against this build's layouts and the scene budget
+static GaussianResult cooked_header_check(const char* filename, const CookedSceneHeader* header) {
+    if (header->magic != SPLAT_MAGIC || header->version != SPLAT_VERSION_COOKED) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    debug_log_info("Loading cooked scene: %s (%u splats, %u KB)", filename,
+                   header->splat_count, header->payload_size / 1024);
+    
+    // Element layouts must match this build exactly; the octree node stride is
+    // checked by the culling module, which owns that type
+    static const u32 strides[COOKED_SECTION_COUNT] = {
+        sizeof(GaussianSplat3D), sizeof(GaussianSplatHot), sizeof(GaussianSplatWarm),
+        sizeof(GaussianSplatCold), 0, sizeof(u32)
+    };
+    // A compact scene (cook_scene.py --compact) leaves warm and cold empty
+    bool compact = header->sections[COOKED_SECTION_WARM].count == 0 &&
+                   header->sections[COOKED_SECTION_COLD].count == 0;
+    bool valid = header->splat_count > 0 && header->splat_count <= MAX_SPLATS_PER_SCENE &&
+                 (header->payload_size % DMA_ALIGNMENT) == 0;
+    for (int s = 0; s < COOKED_SECTION_COUNT && valid; s++) {
+        const CookedSectionEntry* section = &header->sections[s];
+        bool stream = s == COOKED_SECTION_WARM || s == COOKED_SECTION_COLD;
+        valid = (section->offset % DMA_ALIGNMENT) == 0 &&
+                section->size == section->count * section->stride &&
+                section->offset + section->size <= header->payload_size &&
+                (strides[s] == 0 || section->stride == strides[s]) &&
+                (s == COOKED_SECTION_OCTREE_NODES || section->count == header->splat_count ||
+                 (compact && stream));
+    }
+    if (!valid) {
+        debug_log_error("Cooked scene %s does not match this build's layout", filename);
+        return GAUSSIAN_ERROR_UNSUPPORTED_FORMAT;
+    }
+    
+    if (!memory_budget_fits(MEMORY_BUDGET_SCENE, header->payload_size)) {
+        debug_log_error("Cooked scene needs %u KB, scene budget is full", header->payload_size / 1024);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    return GAUSSIAN_SUCCESS;
+}
+
+// Point the scene's records and streams into a cooked payload; the scene owns it from here
+static void cooked_scene_attach(GaussianScene* scene, u8* payload, const CookedSceneHeader* header,
+                                u32 resident) {
+    const CookedSectionEntry* sections = header->sections;
+    
+    if (scene->cooked_payload && scene->cooked_payload != payload) {
+        memory_free(scene->cooked_payload);
+    }
+    scene->cooked_payload = payload;
+    scene->splats_3d = (GaussianSplat3D*)(payload + sections[COOKED_SECTION_RECORDS].offset);
+    scene->streams.hot = (GaussianSplatHot*)(payload + sections[COOKED_SECTION_HOT].offset);
+    scene->streams.warm = NULL;
+    scene->streams.cold = NULL;
+    if (sections[COOKED_SECTION_WARM].count > 0) {
+        scene->streams.warm = (GaussianSplatWarm*)(payload + sections[COOKED_SECTION_WARM].offset);
+        scene->streams.cold = (GaussianSplatCold*)(payload + sections[COOKED_SECTION_COLD].offset);
+    }
+    scene->streams.count = resident;
+    scene->splat_count = resident;
+}
+
+// Adopt the payload's octree; splat_count must be the whole scene
+static GaussianResult cooked_scene_adopt_octree(u8* payload, const CookedSceneHeader* header) {
+    const CookedSectionEntry* sections = header->sections;
+    return init_spatial_grid_cooked(payload + sections[COOKED_SECTION_OCTREE_NODES].offset,
+                                    sections[COOKED_SECTION_OCTREE_NODES].count,
+                                    sections[COOKED_SECTION_OCTREE_NODES].stride,
+                                    (u32*)(payload + sections[COOKED_SECTION_OCTREE_INDICES].offset),
+                                    header->splat_count, NULL);
+}
+
+// Cooked load; a non-NULL key must match the header's reserved words
+static GaussianResult load_cooked_scene_keyed(const char* filename, GaussianScene* scene, const u32* key) {
+    int fd = open_file_auto(filename, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    CookedSceneHeader header;
+    if (read_file_data(fd, &header, sizeof(header)) != (int)sizeof(header) ||
+        (key && memcmp(header.reserved, key, sizeof(header.reserved)) != 0)) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    GaussianResult result = cooked_header_check(filename, &header);
+    if (result != GAUSSIAN_SUCCESS) {
+        close_file(fd);
+        return result;
+    }
+    
+    u8* payload = (u8*)memory_alloc(MEMORY_BUDGET_SCENE, header.payload_size, DMA_ALIGNMENT);
+    if (!payload) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // The whole scene in one read: no per-splat work follows
+    int bytes_read = read_file_data(fd, payload, header.payload_size);
+    close_file(fd);
+    if (bytes_read != (int)header.payload_size) {
+        debug_log_error("Cooked scene truncated (%d of %u bytes)", bytes_read, header.payload_size);
+        memory_free(payload);
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    result = cooked_scene_adopt_octree(payload, &header);
+    if (result != GAUSSIAN_SUCCESS) {
+        debug_log_error("Cooked scene octree rejected");
+        memory_free(payload);
+        return result;
+    }
+    
+    cooked_scene_attach(scene, payload, &header, header.splat_count);
+    
+    debug_log_info("Cooked scene resident: %u splats, %u octree nodes",
+                   header.splat_count, header.sections[COOKED_SECTION_OCTREE_NODES].count);
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Load a cooked (version 2) scene: one header read, one payload read, then
+ * pointer fix-ups. Records, streams and the culling octree are used in place.
+ * Returns GAUSSIAN_ERROR_INVALID_FORMAT for files that are not cooked scenes.
+ */
+GaussianResult load_cooked_scene(const char* filename, GaussianScene* scene) {
+    if (!filename || !scene) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    return load_cooked_scene_keyed(filename, scene, NULL);
+}
+
+/*
+ * Progressive cooked-scene streaming
+ * The payload is allocated up front and filled chunk by chunk with fileXio
+ * non-blocking reads, polled once per frame. A chunk is SCENE_STREAM_CHUNK_SPLATS
+ * splats of every per-splat section; once all of its reads land the scene's
+ * splat_count grows to cover it, so the renderer draws the head of the file
+ * (the cooker writes splats most important first) while the rest arrives.
+ * The culler builds a provisional octree over the resident prefix; the cooked
+ * octree is read last and adopted once every splat is resident.
+ *
+ * A network source reads the same ranges from a TCP socket. The scene
+ * server sends the header and then every range in scene_stream_next_range()
+ * order without being asked, so the stream never waits on a round trip;
+ * each update receives what the stack has buffered straight into place.
+ */
+#define SCENE_STREAM_CHUNK_SPLATS 2048   // Splats per chunk; chunk * stride stays DMA_ALIGNMENT-aligned
+#define SCENE_STREAM_CHUNK_READS  4
+
+// Per-chunk read order: culling and render inputs before data no pass reads
+static const CookedSection g_stream_chunk_sections[SCENE_STREAM_CHUNK_READS] = {
+    COOKED_SECTION_HOT, COOKED_SECTION_WARM, COOKED_SECTION_RECORDS, COOKED_SECTION_COLD
+};
+
+typedef struct {
+    CookedSceneHeader header;   // First: fileXio reads it straight into the aligned state
+    GaussianScene* scene;
+    u8* payload;
+    int fd;                     // fileXio descriptor
+    int sock;                   // Scene server socket, -1 for a fileXio stream
+    u32 chunk_first;            // First splat of the chunk being read
+    u32 step;                   // Read within the chunk, or octree section once all are resident
+    u32 read_offset;            // Payload offset of the read in flight
+    u32 read_size;              // Bytes requested by the read in flight
+    u32 received;               // Bytes of it a network source has delivered
+    u32 resident;               // Splats whose chunk reads have all completed
+    u32 reads;                  // Reads completed
+    u64 start_cycles;
+    bool active;                // A stream is open
+} SceneStreamState;
+
+static SceneStreamState g_scene_stream __attribute__((aligned(64))) = {0};
+
+// Next read within the chunk, past the sections a compact scene leaves empty;
+// SCENE_STREAM_CHUNK_READS once the chunk is complete
+static u32 scene_stream_next_step(u32 step) {
+    const CookedSectionEntry* sections = g_scene_stream.header.sections;
+    do {
+        step++;
+    } while (step < SCENE_STREAM_CHUNK_READS && sections[g_stream_chunk_sections[step]].count == 0);
+    return step;
+}
+
+// Byte range of the next read, or false once the octree is in
+static bool scene_stream_next_range(u32* offset, u32* size) {
+    const CookedSectionEntry* sections = g_scene_stream.header.sections;
+    u32 count = g_scene_stream.header.splat_count;
+    
+    if (g_scene_stream.chunk_first < count) {
+        const CookedSectionEntry* section = &sections[g_stream_chunk_sections[g_scene_stream.step]];
+        u32 chunk = MIN(SCENE_STREAM_CHUNK_SPLATS, count - g_scene_stream.chunk_first);
+        *offset = section->offset + g_scene_stream.chunk_first * section->stride;
+        *size = chunk * section->stride;
+        return true;
+    }
+    
+    if (g_scene_stream.step < 2) {
+        const CookedSectionEntry* section =
+            &sections[g_scene_stream.step == 0 ? COOKED_SECTION_OCTREE_NODES : COOKED_SECTION_OCTREE_INDICES];
+        *offset = section->offset;
+        *size = section->size;
+        return true;
+    }
+    
+    return false;
+}
+
+// Seek in blocking mode, then issue the read without waiting for it.
+// While a read is in flight every other fileXio call waits for it first.
+// A network source is sent the ranges unasked and only tracks them.
+static GaussianResult scene_stream_issue(u32 offset, u32 size) {
+    g_scene_stream.read_offset = offset;
+    g_scene_stream.received = 0;
+    if (g_scene_stream.sock >= 0) {
+        g_scene_stream.read_size = size;
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    if (fileXioLseek(g_scene_stream.fd, sizeof(CookedSceneHeader) + offset, SEEK_SET) < 0) {
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    fileXioSetBlockMode(FXIO_NOWAIT);
+    fileXioRead(g_scene_stream.fd, g_scene_stream.payload + offset, size);
+    fileXioSetBlockMode(FXIO_WAIT);
+    
+    g_scene_stream.read_size = size;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Network source: receive what has arrived of the read in flight. False
+// while more of it is on the way; once true, received falls short of the
+// read when the connection closed or failed.
+static bool scene_stream_receive(bool wait) {
+    while (g_scene_stream.received < g_scene_stream.read_size) {
+        u8* target = g_scene_stream.payload + g_scene_stream.read_offset + g_scene_stream.received;
+        u32 wanted = g_scene_stream.read_size - g_scene_stream.received;
+        int bytes = wait ? splatstorm_network_receive(g_scene_stream.sock, target, wanted)
+                         : splatstorm_network_receive_nowait(g_scene_stream.sock, target, wanted);
+        if (bytes == 0 && !wait) {
+            return false;
+        }
+        if (bytes <= 0) {
+            return true;
+        }
+        g_scene_stream.received += bytes;
+    }
+    return true;
+}
+
+// Close the stream and hand back control of fileXio or the network; published splats stay valid
+static void scene_stream_close(void) {
+    if (g_scene_stream.sock >= 0) {
+        splatstorm_network_close_socket(g_scene_stream.sock);
+        splatstorm_network_shutdown();
+        g_scene_stream.sock = -1;
+        g_scene_stream.read_size = 0;
+        g_scene_stream.active = false;
+        return;
+    }
+    
+    int ret;
+    if (g_scene_stream.read_size > 0) {
+        fileXioWaitAsync(FXIO_WAIT, &ret);
+        g_scene_stream.read_size = 0;
+    }
+    fileXioClose(g_scene_stream.fd);
+    g_scene_stream.active = false;
+}
+
+// Shared by both sources once the header checks out: payload, state, first read
+static GaussianResult scene_stream_start(GaussianScene* scene, int fd, int sock) {
+    u8* payload = (u8*)memory_alloc(MEMORY_BUDGET_SCENE, g_scene_stream.header.payload_size, DMA_ALIGNMENT);
+    if (!payload) {
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    cooked_scene_attach(scene, payload, &g_scene_stream.header, 0);
+    
+    g_scene_stream.scene = scene;
+    g_scene_stream.payload = payload;
+    g_scene_stream.fd = fd;
+    g_scene_stream.sock = sock;
+    g_scene_stream.chunk_first = 0;
+    g_scene_stream.step = 0;
+    g_scene_stream.read_size = 0;
+    g_scene_stream.resident = 0;
+    g_scene_stream.reads = 0;
+    g_scene_stream.start_cycles = get_cpu_cycles();
+    g_scene_stream.active = true;
+    
+    u32 offset, size;
+    scene_stream_next_range(&offset, &size);
+    GaussianResult result = scene_stream_issue(offset, size);
+    if (result != GAUSSIAN_SUCCESS) {
+        scene_stream_close();
+    }
+    return result;
+}
+
+// Blocking receive of exactly size bytes
+static bool scene_server_receive_all(int sock, void* buffer, u32 size) {
+    u32 received = 0;
+    while (received < size) {
+        int bytes = splatstorm_network_receive(sock, (u8*)buffer + received, size - received);
+        if (bytes <= 0) {
+            return false;
+        }
+        received += bytes;
+    }
+    return true;
+}
+
+/*
+ * net:<host>[:port]/<name>: ask the scene server for a scene by name. It
+ * answers with the cooked header and the payload in stream order, or closes
+ * the connection when it has no such scene. The request carries the chunk
+ * size so the server cuts the ranges the way this build reads them.
+ */
+static GaussianResult scene_stream_begin_network(const char* source, GaussianScene* scene) {
+    char host[64];
+    const char* name = strchr(source, '/');
+    if (!name || name == source || name[1] == '\0' || (u32)(name - source) >= sizeof(host)) {
+        debug_log_error("Network scene %s is not <host>[:port]/<name>", source);
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    memcpy(host, source, name - source);
+    host[name - source] = '\0';
+    int port = SCENE_SERVER_DEFAULT_PORT;
+    char* separator = strchr(host, ':');
+    if (separator) {
+        *separator = '\0';
+        port = atoi(separator + 1);
+    }
+    
+    if (splatstorm_network_init() < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    if (!splatstorm_network_is_connected() &&
+        splatstorm_network_configure(NETWORK_UNIT_IP, NETWORK_UNIT_MASK, NETWORK_UNIT_GATEWAY) < 0) {
+        splatstorm_network_shutdown();
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    int sock = splatstorm_network_create_socket();
+    if (sock < 0 || splatstorm_network_connect(sock, host, port) < 0) {
+        debug_log_error("Scene server %s:%d unreachable", host, port);
+        if (sock >= 0) {
+            splatstorm_network_close_socket(sock);
+        }
+        splatstorm_network_shutdown();
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    char request[160];
+    int length = snprintf(request, sizeof(request), "SPLT %u %s\n", SCENE_STREAM_CHUNK_SPLATS, name + 1);
+    GaussianResult result = GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    if (length > 0 && length < (int)sizeof(request) &&
+        splatstorm_network_send(sock, request, length) == length &&
+        scene_server_receive_all(sock, &g_scene_stream.header, sizeof(CookedSceneHeader))) {
+        result = cooked_header_check(source, &g_scene_stream.header);
+    }
+    if (result == GAUSSIAN_SUCCESS) {
+        result = scene_stream_start(scene, -1, sock);
+        if (result != GAUSSIAN_ERROR_OUT_OF_MEMORY) {
+            return result;  // The stream owns the socket, closed with it on failure
+        }
+    } else {
+        debug_log_error("Scene server %s:%d has no cooked scene %s", host, port, name + 1);
+    }
+    
+    splatstorm_network_close_socket(sock);
+    splatstorm_network_shutdown();
+    return result;
+}
+
+/*
+ * Open a cooked scene and start streaming it into scene. Returns with the
+ * first chunk requested but nothing resident; scene_stream_update() makes
+ * progress. GAUSSIAN_ERROR_INVALID_FORMAT means the file is not a cooked
+ * scene, GAUSSIAN_ERROR_INIT_FAILED that fileXio is not available. Names
+ * starting with SCENE_SERVER_PREFIX stream from a scene server instead.
+ */
+GaussianResult scene_stream_begin(const char* filename, GaussianScene* scene) {
+    if (!filename || !scene) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (g_scene_stream.active) {
+        return GAUSSIAN_ERROR_BUSY;
+    }
+    if (strncmp(filename, SCENE_SERVER_PREFIX, strlen(SCENE_SERVER_PREFIX)) == 0) {
+        return scene_stream_begin_network(filename + strlen(SCENE_SERVER_PREFIX), scene);
+    }
+    
+    char full_path[256];
+    if (find_file_on_storage(filename, full_path, sizeof(full_path)) != GAUSSIAN_SUCCESS) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    if (fileXioInit() < 0) {
+        debug_log_warning("fileXio unavailable, scene cannot stream");
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+    
+    int fd = fileXioOpen(full_path, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    CookedSceneHeader* header = &g_scene_stream.header;
+    if (fileXioRead(fd, header, sizeof(CookedSceneHeader)) != (int)sizeof(CookedSceneHeader)) {
+        fileXioClose(fd);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    GaussianResult result = cooked_header_check(filename, header);
+    if (result == GAUSSIAN_SUCCESS) {
+        result = scene_stream_start(scene, fd, -1);
+        if (result != GAUSSIAN_ERROR_OUT_OF_MEMORY) {
+            return result;
+        }
+    }
+    fileXioClose(fd);
+    return result;
+}
+
+/*
+ * Collect the read in flight (waiting for it if wait is set) and issue the
+ * next one. Growth is published in doubling steps so the culler rebuilds its
+ * provisional octree only log2(chunks) times.
+ */
+GaussianResult scene_stream_update(bool wait) {
+    if (!g_scene_stream.active) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    int bytes_read = 0;
+    if (g_scene_stream.sock >= 0) {
+        if (!scene_stream_receive(wait)) {
+            return GAUSSIAN_SUCCESS;  // Still arriving
+        }
+        bytes_read = (int)g_scene_stream.received;
+    } else if (fileXioWaitAsync(wait ? FXIO_WAIT : FXIO_NOWAIT, &bytes_read) != FXIO_COMPLETE) {
+        return GAUSSIAN_SUCCESS;  // Still in flight
+    }
+    
+    u32 expected = g_scene_stream.read_size;
+    g_scene_stream.read_size = 0;
+    if (bytes_read != (int)expected) {
+        debug_log_error("Scene stream read failed (%d of %u bytes), keeping %u splats",
+                        bytes_read, expected, g_scene_stream.scene->splat_count);
+        scene_stream_close();
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    g_scene_stream.reads++;
+    
+    GaussianScene* scene = g_scene_stream.scene;
+    u32 count = g_scene_stream.header.splat_count;
+    
+    if (g_scene_stream.chunk_first < count) {
+        g_scene_stream.step = scene_stream_next_step(g_scene_stream.step);
+        if (g_scene_stream.step == SCENE_STREAM_CHUNK_READS) {
+            g_scene_stream.chunk_first += MIN(SCENE_STREAM_CHUNK_SPLATS, count - g_scene_stream.chunk_first);
+            g_scene_stream.resident = g_scene_stream.chunk_first;
+            g_scene_stream.step = 0;
+            
+            if (g_scene_stream.resident >= scene->splat_count * 2 || g_scene_stream.resident == count) {
+                scene->streams.count = g_scene_stream.resident;
+                scene->splat_count = g_scene_stream.resident;
+            }
+        }
+    } else {
+        g_scene_stream.step++;
+    }
+    
+    u32 offset, size;
+    if (scene_stream_next_range(&offset, &size)) {
+        GaussianResult result = scene_stream_issue(offset, size);
+        if (result != GAUSSIAN_SUCCESS) {
+            scene_stream_close();
+        }
+        return result;
+    }
+    
+    // Everything is in: swap the provisional octree for the cooked one
+    scene_stream_close();
+    if (cooked_scene_adopt_octree(g_scene_stream.payload, &g_scene_stream.header) != GAUSSIAN_SUCCESS) {
+        debug_log_warning("Cooked scene octree rejected, culling keeps the built tree");
+    }
+    
+    float elapsed_ms = (get_cpu_cycles() - g_scene_stream.start_cycles) * 1000.0f / 294912000.0f;
+    debug_log_info("Scene streamed: %u splats in %u reads, %.1f ms", count, g_scene_stream.reads, elapsed_ms);
+    return GAUSSIAN_SUCCESS;
+}
+
+bool scene_stream_active(void) {
+    return g_scene_stream.active;
+}
+
+// Stop streaming, e.g. before the scene that owns the payload is destroyed
+void scene_stream_cancel(void) {
+    if (g_scene_stream.active) {
+        scene_stream_close();
+    }
+}
+
+/*
+ * Packed (version 3) scenes
+ * Positions are quantized across their octree leaf's bounds, so splats are
+ * stored in leaf order and the index array is the identity. Covariance is
+ * stored as log scale plus a smallest-three quaternion and rebuilt with
+ * gaussian_covariance_from_scale_rotation(); SH is a codebook index. Blocks
+ * go through file_read_pipelined(), each decoding while the next one is
+ * read, so the load runs at read speed.
+ */
+
+// Dequantization frame of one octree leaf
+typedef struct {
+    fixed16_t origin[3];
+    float step[3];              // Q16.16 units per quantization step
+} PackedFrame;
+
+static float g_packed_scale_lut[256];
+static bool g_packed_scale_lut_ready = false;
+
+static void packed_scale_lut_init(void) {
+    if (!g_packed_scale_lut_ready) {
+        for (int q = 0; q < 256; q++) {
+            g_packed_scale_lut[q] = exp2f((q - 128) / 16.0f);
+        }
+        g_packed_scale_lut_ready = true;
+    }
+}
+
+static void packed_frame_init(PackedFrame* frame, const fixed16_t bounds_min[3], const fixed16_t bounds_max[3]) {
+    static const u32 steps[3] = {
+        (1U << PACKED_POS_X_BITS) - 1, (1U << PACKED_POS_Y_BITS) - 1, (1U << PACKED_POS_Z_BITS) - 1
+    };
+    for (int j = 0; j < 3; j++) {
+        frame->origin[j] = bounds_min[j];
+        frame->step[j] = ((float)bounds_max[j] - (float)bounds_min[j]) / (float)steps[j];
+    }
+}
+
+// Decode one splat into its record and stream entries
+static void packed_splat_decode(const PackedSplat* packed, const PackedFrame* frame,
+                                const u16* sh_codebook, u32 sh_count, GaussianSplat3D* splat) {
+    memset(splat, 0, sizeof(GaussianSplat3D));
+    
+    u32 qx = packed->position >> (PACKED_POS_Y_BITS + PACKED_POS_Z_BITS);
+    u32 qy = (packed->position >> PACKED_POS_Z_BITS) & ((1U << PACKED_POS_Y_BITS) - 1);
+    u32 qz = packed->position & ((1U << PACKED_POS_Z_BITS) - 1);
+    splat->pos[0] = frame->origin[0] + (fixed16_t)((float)qx * frame->step[0]);
+    splat->pos[1] = frame->origin[1] + (fixed16_t)((float)qy * frame->step[1]);
+    splat->pos[2] = frame->origin[2] + (fixed16_t)((float)qz * frame->step[2]);
+    
+    // Smallest three: the dropped (largest) component is non-negative
+    float rotation[4];
+    u32 largest = packed->rotation >> 30;
+    float sum = 0.0f;
+    for (u32 c = 0, k = 0; c < 4; c++) {
+        if (c == largest) continue;
+        u32 q = (packed->rotation >> (20 - 10 * k)) & 0x3FF;
+        rotation[c] = ((float)q * (2.0f / 1023.0f) - 1.0f) * 0.70710678f;
+        sum += rotation[c] * rotation[c];
+        k++;
+    }
+    rotation[largest] = sqrtf(MAX(0.0f, 1.0f - sum));
+    
+    float scale[3] = {
+        g_packed_scale_lut[packed->scale[0]], g_packed_scale_lut[packed->scale[1]], g_packed_scale_lut[packed->scale[2]]
+    };
+    u8 cov_exp;
+    gaussian_covariance_from_scale_rotation(scale, rotation, splat->cov_mant, &cov_exp);
+    splat->cov_exp = cov_exp;
+    
+    memcpy(splat->color, packed->color, sizeof(splat->color));
+    splat->opacity = packed->opacity;
+    
+    u32 sh_index = (packed->sh_index < sh_count) ? packed->sh_index : 0;
+    memcpy(splat->sh_coeffs, &sh_codebook[sh_index * 16], sizeof(splat->sh_coeffs));
+    
+    // Importance as asset_manager_complete.c computes it
+    splat->importance = (u32)(packed->opacity / 255.0f * (scale[0] + scale[1] + scale[2]) * 1000.0f);
+}
+
+// Version 2 layout the packed scene decodes into
+static u32 packed_output_layout(CookedSceneHeader* layout, u32 splat_count, const CookedSectionEntry* nodes) {
+    static const u32 strides[COOKED_SECTION_COUNT] = {
+        sizeof(GaussianSplat3D), sizeof(GaussianSplatHot), sizeof(GaussianSplatWarm),
+        sizeof(GaussianSplatCold), 0, sizeof(u32)
+    };
+    
+    memset(layout, 0, sizeof(CookedSceneHeader));
+    layout->magic = SPLAT_MAGIC;
+    layout->version = SPLAT_VERSION_COOKED;
+    layout->splat_count = splat_count;
+    
+    u32 offset = 0;
+    for (int s = 0; s < COOKED_SECTION_COUNT; s++) {
+        CookedSectionEntry* section = &layout->sections[s];
+        section->offset = offset;
+        section->stride = (s == COOKED_SECTION_OCTREE_NODES) ? nodes->stride : strides[s];
+        section->count = (s == COOKED_SECTION_OCTREE_NODES) ? nodes->count : splat_count;
+        section->size = section->count * section->stride;
+        offset = (offset + section->size + DMA_ALIGNMENT - 1) & ~(DMA_ALIGNMENT - 1);
+    }
+    layout->payload_size = offset;
+    return offset;
+}
+
+// Decoder state for the pipelined splat read
+typedef struct {
+    u32 splats_offset;          // File offset of the first packed splat
+    const u16* sh_codebook;
+    u32 sh_count;
+    const PackedLeafFrame* leaves;
+    u32 leaf;
+    u32 leaf_end;               // One past the last splat of the current leaf
+    PackedFrame frame;
+    GaussianSplat3D* records;
+    GaussianSplatStreams* streams;
+} PackedDecodeState;
+
+static GaussianResult packed_decode_block(const u8* block, u32 size, u32 file_offset, void* user) {
+    PackedDecodeState* state = (PackedDecodeState*)user;
+    const PackedSplat* packed = (const PackedSplat*)block;
+    u32 first = (file_offset - state->splats_offset) / sizeof(PackedSplat);
+    u32 block_splats = size / sizeof(PackedSplat);
+    
+    for (u32 i = 0; i < block_splats; i++) {
+        u32 index = first + i;
+        while (index >= state->leaf_end) {
+            state->leaf++;
+            state->leaf_end += state->leaves[state->leaf].splat_count;
+            packed_frame_init(&state->frame, state->leaves[state->leaf].bounds_min,
+                              state->leaves[state->leaf].bounds_max);
+        }
+        packed_splat_decode(&packed[i], &state->frame, state->sh_codebook, state->sh_count, &state->records[index]);
+        gaussian_splat_streams_store(state->streams, index, &state->records[index]);
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Load a packed (version 3) scene. Header and tables are read directly, the
+ * compressed splats through file_read_pipelined() in PACKED_BLOCK_SPLATS
+ * blocks. Returns GAUSSIAN_ERROR_INVALID_FORMAT for files that are not
+ * packed scenes.
+ */
+GaussianResult load_packed_scene(const char* filename, GaussianScene* scene) {
+    if (!filename || !scene) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    int fd = open_file_auto(filename, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    static CookedSceneHeader header __attribute__((aligned(64)));
+    if (read_file_data(fd, &header, sizeof(header)) != (int)sizeof(header) ||
+        header.magic != SPLAT_MAGIC || header.version != SPLAT_VERSION_PACKED) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    debug_log_info("Loading packed scene: %s (%u splats, %u KB)", filename,
+                   header.splat_count, header.payload_size / 1024);
+    
+    // Tables come first and are read in one call; the splats follow them.
+    // The octree node stride is checked by the culling module.
+    static const u32 strides[PACKED_SECTION_COUNT] = {
+        16 * sizeof(u16), 0, sizeof(PackedLeafFrame), sizeof(PackedSplat)
+    };
+    const CookedSectionEntry* sections = header.sections;
+    const CookedSectionEntry* splats = &sections[PACKED_SECTION_SPLATS];
+    u32 sh_count = sections[PACKED_SECTION_SH_CODEBOOK].count;
+    bool valid = header.splat_count > 0 && splats->count == header.splat_count &&
+                 sh_count > 0 && sh_count <= PACKED_SH_CODEBOOK_MAX &&
+                 sections[PACKED_SECTION_OCTREE_NODES].count > 0 &&
+                 sections[PACKED_SECTION_LEAF_FRAMES].count > 0;
+    for (int s = 0; s < PACKED_SECTION_COUNT && valid; s++) {
+        const CookedSectionEntry* section = &sections[s];
+        valid = (section->offset % DMA_ALIGNMENT) == 0 &&
+                section->size == section->count * section->stride &&
+                section->offset + section->size <= header.payload_size &&
+                (strides[s] == 0 || section->stride == strides[s]) &&
+                (s == PACKED_SECTION_SPLATS || section->offset + section->size <= splats->offset);
+    }
+    if (!valid) {
+        debug_log_error("Packed scene %s does not match this build's layout", filename);
+        close_file(fd);
+        return GAUSSIAN_ERROR_UNSUPPORTED_FORMAT;
+    }
+    
+    CookedSceneHeader layout;
+    u32 output_size = packed_output_layout(&layout, header.splat_count, &sections[PACKED_SECTION_OCTREE_NODES]);
+    u32 block_bytes = PACKED_BLOCK_SPLATS * sizeof(PackedSplat);
+    if (!memory_budget_fits(MEMORY_BUDGET_SCENE, output_size) ||
+        !memory_budget_fits(MEMORY_BUDGET_ASSET, splats->offset + 2 * block_bytes)) {
+        debug_log_error("Packed scene needs %u KB decoded, budget is full", output_size / 1024);
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    u8* payload = (u8*)memory_alloc(MEMORY_BUDGET_SCENE, output_size, DMA_ALIGNMENT);
+    u8* tables = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, splats->offset, DMA_ALIGNMENT);
+    if (!payload || !tables) {
+        memory_free(payload);
+        memory_free(tables);
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    if (read_file_data(fd, tables, splats->offset) != (int)splats->offset) {
+        result = GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    close_file(fd);
+    
+    // Leaf runs must tile the splat array exactly
+    const u16* sh_codebook = (const u16*)(tables + sections[PACKED_SECTION_SH_CODEBOOK].offset);
+    const PackedLeafFrame* leaves = (const PackedLeafFrame*)(tables + sections[PACKED_SECTION_LEAF_FRAMES].offset);
+    u32 leaf_count = sections[PACKED_SECTION_LEAF_FRAMES].count;
+    if (result == GAUSSIAN_SUCCESS) {
+        u32 covered = 0;
+        for (u32 l = 0; l < leaf_count; l++) {
+            covered += leaves[l].splat_count;
+        }
+        if (covered != header.splat_count) {
+            debug_log_error("Packed scene leaf frames cover %u of %u splats", covered, header.splat_count);
+            result = GAUSSIAN_ERROR_INVALID_FORMAT;
+        }
+    }
+    
+    packed_scale_lut_init();
+    
+    const CookedSectionEntry* out = layout.sections;
+    GaussianSplat3D* records = (GaussianSplat3D*)(payload + out[COOKED_SECTION_RECORDS].offset);
+    GaussianSplatStreams streams = {
+        (GaussianSplatHot*)(payload + out[COOKED_SECTION_HOT].offset),
+        (GaussianSplatWarm*)(payload + out[COOKED_SECTION_WARM].offset),
+        (GaussianSplatCold*)(payload + out[COOKED_SECTION_COLD].offset),
+        header.splat_count
+    };
+    
+    if (result == GAUSSIAN_SUCCESS) {
+        PackedDecodeState state = {
+            sizeof(header) + splats->offset, sh_codebook, sh_count, leaves, 0, leaves[0].splat_count,
+            {{0}}, records, &streams
+        };
+        packed_frame_init(&state.frame, leaves[0].bounds_min, leaves[0].bounds_max);
+        
+        u32 delivered = 0;
+        result = file_read_pipelined(filename, state.splats_offset, splats->size, block_bytes,
+                                     packed_decode_block, &state, &delivered);
+        if (result == GAUSSIAN_SUCCESS && delivered != splats->size) {
+            result = GAUSSIAN_ERROR_FILE_READ_FAILED;
+        }
+    }
+    
+    // Splats arrive in leaf order, so leaf slot i holds splat i. Sorting them most
+    // important first (for splat budgets) turns that identity into the remap.
+    // Bounds are refit from the decoded positions.
+    if (result == GAUSSIAN_SUCCESS) {
+        memcpy(payload + out[COOKED_SECTION_OCTREE_NODES].offset,
+               tables + sections[PACKED_SECTION_OCTREE_NODES].offset, sections[PACKED_SECTION_OCTREE_NODES].size);
+        u32* indices = (u32*)(payload + out[COOKED_SECTION_OCTREE_INDICES].offset);
+        if (gaussian_splats_sort_by_importance(records, &streams, header.splat_count, indices) != GAUSSIAN_SUCCESS) {
+            debug_log_warning("Packed scene kept in leaf order: no memory to sort by importance");
+            for (u32 i = 0; i < header.splat_count; i++) {
+                indices[i] = i;
+            }
+        }
+        result = init_spatial_grid_cooked(payload + out[COOKED_SECTION_OCTREE_NODES].offset,
+                                          out[COOKED_SECTION_OCTREE_NODES].count,
+                                          out[COOKED_SECTION_OCTREE_NODES].stride,
+                                          indices, header.splat_count, &streams);
+    }
+    memory_free(tables);
+    
+    if (result != GAUSSIAN_SUCCESS) {
+        debug_log_error("Packed scene %s failed to decode (%d)", filename, result);
+        memory_free(payload);
+        return result;
+    }
+    
+    cooked_scene_attach(scene, payload, &layout, header.splat_count);
+    
+    debug_log_info("Packed scene resident: %u splats, %u KB read, %u KB decoded",
+                   header.splat_count, header.payload_size / 1024, output_size / 1024);
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Converted-scene cache
+ * A PLY scene converted at boot (covariances, octree, splats in tree order) is
+ * written back out as a cooked scene, to the HDD or, when it is small enough,
+ * the memory card. The header's reserved words hold the key: source size, a
+ * hash of the source, the load budget and SCENE_CACHE_FORMAT. The hash covers
+ * SCENE_CACHE_SAMPLES blocks spread over the file, header and tail included,
+ * so keying a scene costs a few small reads rather than a second full read.
+ * Later boots with the same source take the one-read cooked path.
+ */
+#define SCENE_CACHE_DIR         "SPLATCACHE"
+#define SCENE_CACHE_FORMAT      2               // Bump when the PLY conversion changes
+#define SCENE_CACHE_SAMPLES     16
+#define SCENE_CACHE_SAMPLE_SIZE 4096
+#define SCENE_CACHE_MC_MAX      (2 * 1024 * 1024)   // Larger caches skip the memory card
+#define FNV_OFFSET_BASIS        0x811C9DC5u
+#define FNV_PRIME               0x01000193u
+
+static u8 g_scene_cache_sample[SCENE_CACHE_SAMPLE_SIZE] __attribute__((aligned(64)));
+
+static u32 scene_cache_hash(u32 hash, const u8* data, u32 size) {
+    for (u32 i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// Key the source file and name its cache entry, "/SPLATCACHE/Sxxxxxxxx.SPC"
+static GaussianResult scene_cache_key(const char* filename, u32 load_budget, u32 key[4],
+                                      char* cache_name, size_t name_size) {
+    int fd = open_file_auto(filename, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    long size = get_file_size(fd);
+    if (size <= 0) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    // Evenly spaced blocks, the first at the PLY header, the last at the tail
+    u32 file_size = (u32)size;
+    u32 span = file_size > SCENE_CACHE_SAMPLE_SIZE ? file_size - SCENE_CACHE_SAMPLE_SIZE : 0;
+    u32 hash = FNV_OFFSET_BASIS;
+    for (u32 s = 0; s < SCENE_CACHE_SAMPLES; s++) {
+        u32 offset = (u32)((u64)span * s / (SCENE_CACHE_SAMPLES - 1));
+        int length = (int)MIN(SCENE_CACHE_SAMPLE_SIZE, file_size - offset);
+        if (lseek(fd, offset, SEEK_SET) != (int)offset ||
+            read_file_data(fd, g_scene_cache_sample, length) != length) {
+            close_file(fd);
+            return GAUSSIAN_ERROR_FILE_READ_FAILED;
+        }
+        hash = scene_cache_hash(hash, g_scene_cache_sample, length);
+    }
+    close_file(fd);
+    
+    key[0] = file_size;
+    key[1] = hash;
+    key[2] = load_budget;
+    key[3] = SCENE_CACHE_FORMAT;
+    snprintf(cache_name, name_size, "/" SCENE_CACHE_DIR "/S%08X.SPC",
+             scene_cache_hash(FNV_OFFSET_BASIS, (const u8*)key, 4 * sizeof(u32)));
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Load the cached conversion of a source scene. Returns
+ * GAUSSIAN_ERROR_FILE_NOT_FOUND on a miss and GAUSSIAN_ERROR_INVALID_FORMAT
+ * when the entry belongs to another source or conversion.
+ */
+GaussianResult scene_cache_load(const char* filename, u32 load_budget, GaussianScene* scene) {
+    if (!filename || !scene) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    u32 key[4];
+    char cache_name[64];
+    GaussianResult result = scene_cache_key(filename, load_budget, key, cache_name, sizeof(cache_name));
+    if (result != GAUSSIAN_SUCCESS) {
+        return result;
+    }
+    
+    result = load_cooked_scene_keyed(cache_name, scene, key);
+    if (result == GAUSSIAN_SUCCESS) {
+        debug_log_info("Scene cache hit: %s for %s", cache_name, filename);
+    }
+    return result;
+}
+
+// Write header and sections; the header goes last so a short write never validates
+static GaussianResult scene_cache_write(const char* path, const CookedSceneHeader* header,
+                                        const void* const sections[COOKED_SECTION_COUNT]) {
+    static const u8 zeros[DMA_ALIGNMENT] __attribute__((aligned(64))) = {0};
+    
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    CookedSceneHeader blank;
+    memset(&blank, 0, sizeof(blank));
+    bool written = write_file_data(fd, &blank, sizeof(blank)) == (int)sizeof(blank);
+    
+    u32 offset = 0;
+    for (int s = 0; s < COOKED_SECTION_COUNT && written; s++) {
+        const CookedSectionEntry* section = &header->sections[s];
+        while (offset < section->offset && written) {
+            u32 pad = MIN(section->offset - offset, DMA_ALIGNMENT);
+            written = write_file_data(fd, zeros, pad) == (int)pad;
+            offset += pad;
+        }
+        if (written && section->size > 0) {
+            written = write_file_data(fd, sections[s], section->size) == (int)section->size;
+            offset += section->size;
+        }
+    }
+    while (offset < header->payload_size && written) {
+        u32 pad = MIN(header->payload_size - offset, DMA_ALIGNMENT);
+        written = write_file_data(fd, zeros, pad) == (int)pad;
+        offset += pad;
+    }
+    
+    written = written && lseek(fd, 0, SEEK_SET) == 0 &&
+              write_file_data(fd, header, sizeof(*header)) == (int)sizeof(*header);
+    close_file(fd);
+    return written ? GAUSSIAN_SUCCESS : GAUSSIAN_ERROR_FILE_WRITE_FAILED;
+}
+
+/*
+ * Store a converted scene for scene_cache_load(). Needs the scene's full
+ * streams (not the compact hot-only set) and the culling octree built over it. Tries the hardware profile's
+ * storage in order, memory cards only for scenes up to SCENE_CACHE_MC_MAX.
+ */
+GaussianResult scene_cache_store(const char* filename, u32 load_budget, const GaussianScene* scene) {
+    if (!filename || !scene || !scene->splats_3d || scene->splat_count == 0 ||
+        scene->streams.count != scene->splat_count || !scene->streams.warm) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    CookedSectionEntry nodes_entry;
+    const void* nodes;
+    const u32* indices;
+    u32 index_count;
+    GaussianResult result = spatial_grid_export(&nodes, &nodes_entry.count, &nodes_entry.stride,
+                                                &indices, &index_count);
+    if (result != GAUSSIAN_SUCCESS || index_count != scene->splat_count) {
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+    
+    u32 key[4];
+    char cache_name[64];
+    result = scene_cache_key(filename, load_budget, key, cache_name, sizeof(cache_name));
+    if (result != GAUSSIAN_SUCCESS) {
+        return result;
+    }
+    
+    CookedSceneHeader header;
+    u32 payload_size = packed_output_layout(&header, scene->splat_count, &nodes_entry);
+    memcpy(header.reserved, key, sizeof(header.reserved));
+    
+    const void* sections[COOKED_SECTION_COUNT] = {
+        scene->splats_3d, scene->streams.hot, scene->streams.warm, scene->streams.cold, nodes, indices
+    };
+    
+    const HardwareProfile* profile = hardware_profile_get();
+    const char* const* devices = profile->storage;
+    for (u32 d = 0; d < profile->storage_count; d++) {
+        if (get_boot_device(devices[d]) == IOP_DEVICE_MEMCARD && payload_size > SCENE_CACHE_MC_MAX) {
+            continue;
+        }
+        if (iop_require_path(devices[d]) < 0) {
+            continue;  // No drive or card behind the device
+        }
+        
+        char path[96];
+        snprintf(path, sizeof(path), "%s/" SCENE_CACHE_DIR, devices[d]);
+        mkdir(path, 0755);  // Usually there already
+        snprintf(path, sizeof(path), "%s%s", devices[d], cache_name);
+        
+        result = scene_cache_write(path, &header, sections);
+        if (result == GAUSSIAN_SUCCESS) {
+            debug_log_info("Scene cache stored: %s (%u KB)", path, payload_size / 1024);
+            return GAUSSIAN_SUCCESS;
+        }
+    }
+    
+    debug_log_warning("Scene cache not stored for %s (%u KB)", filename, payload_size / 1024);
+    return result;
+}
+
+/*
+ * Paged (version 4) scenes
+ * The scene is cut into pages, octree subtrees of up to SCENE_PAGE_SPLATS
+ * splats, stored as packed splats. A fixed cache of slots holds the pages
+ * nearest the camera's predicted position; every other page draws its LOD
+ * proxies, which stay resident. The scene arrays hold the proxies first, then
+ * one SCENE_PAGE_SPLATS run per slot. Culling walks the page tree, whose leaf
+ * ranges are re-laid over the proxies or the slot each time a page loads or
+ * leaves. One page read is in flight at a time on fileXio.
+ */
+typedef struct {
+    CookedSceneHeader header;   // First: fileXio reads it straight into the aligned state
+    GaussianScene* scene;
+    u8* tables;                 // Resident sections: SH codebook to proxies
+    u8* staging;                // Page read buffer
+    const PagedPage* pages;
+    const u16* sh_codebook;
+    u16* page_slot;             // Slot holding each page, SCENE_PAGE_NONE if not resident
+    float* page_distance;       // Distance from the predicted camera position
+    u32* leaf_counts;           // Index entries of each page tree leaf
+    u32* indices;               // Page tree index array, in the scene payload
+    u32 page_count;
+    u32 proxy_count;            // Scene splats before the first slot
+    u32 slot_count;
+    u32 sh_count;
+    u16 slot_page[SCENE_PAGE_SLOTS_MAX];  // Page held by each slot, SCENE_PAGE_NONE if free
+    int fd;                     // fileXio descriptor
+    u32 loading_page;           // Page of the read in flight
+    u32 loading_slot;
+    u32 read_size;              // Bytes of the read in flight, 0 when idle
+    float last_position[3];
+    float velocity[3];          // Camera movement per update, smoothed
+    bool has_position;
+    bool dirty;                 // Resident set changed since the leaf ranges were laid out
+    u32 loads;
+    u32 evictions;
+    bool active;
+} ScenePagingState;
+
+static ScenePagingState g_scene_paging __attribute__((aligned(64))) = {0};
+
+static u32 scene_page_bytes(const PagedPage* page) {
+    return page->frame_count * sizeof(PackedLeafFrame) + page->splat_count * sizeof(PackedSplat);
+}
+
+// Decode n packed splats quantized across one frame into scene entries from first
+static void scene_paging_decode(const PackedSplat* packed, u32 count, const PackedFrame* frame, u32 first) {
+    GaussianScene* scene = g_scene_paging.scene;
+    for (u32 i = 0; i < count; i++) {
+        GaussianSplat3D* record = &scene->splats_3d[first + i];
+        packed_splat_decode(&packed[i], frame, g_scene_paging.sh_codebook, g_scene_paging.sh_count, record);
+        gaussian_splat_streams_store(&scene->streams, first + i, record);
+    }
+    cull_importance_invalidate(first, count);
+}
+
+// Decode the staged page into its slot; false if its leaf frames do not add up
+static bool scene_paging_decode_page(const PagedPage* page, u32 slot) {
+    const PackedLeafFrame* leaves = (const PackedLeafFrame*)g_scene_paging.staging;
+    const PackedSplat* packed = (const PackedSplat*)(leaves + page->frame_count);
+    u32 base = g_scene_paging.proxy_count + slot * SCENE_PAGE_SPLATS;
+    
+    u32 covered = 0;
+    for (u32 l = 0; l < page->frame_count; l++) {
+        covered += leaves[l].splat_count;
+    }
+    if (covered != page->splat_count) {
+        return false;
+    }
+    
+    u32 decoded = 0;
+    for (u32 l = 0; l < page->frame_count; l++) {
+        PackedFrame frame;
+        packed_frame_init(&frame, leaves[l].bounds_min, leaves[l].bounds_max);
+        scene_paging_decode(&packed[decoded], leaves[l].splat_count, &frame, base + decoded);
+        decoded += leaves[l].splat_count;
+    }
+    return true;
+}
+
+// Point every page tree leaf at its slot, or at its proxies if it has none
+static GaussianResult scene_paging_layout(void) {
+    u32 cursor = 0;
+    for (u32 p = 0; p < g_scene_paging.page_count; p++) {
+        const PagedPage* page = &g_scene_paging.pages[p];
+        u32 slot = g_scene_paging.page_slot[p];
+        u32 first = (slot != SCENE_PAGE_NONE) ? g_scene_paging.proxy_count + slot * SCENE_PAGE_SPLATS
+                                              : page->proxy_first;
+        u32 count = (slot != SCENE_PAGE_NONE) ? page->splat_count : page->proxy_count;
+        
+        for (u32 i = 0; i < count; i++) {
+            g_scene_paging.indices[cursor++] = first + i;
+        }
+        g_scene_paging.leaf_counts[p] = count;
+    }
+    
+    g_scene_paging.dirty = false;
+    return spatial_grid_set_leaf_counts(g_scene_paging.leaf_counts, g_scene_paging.page_count);
+}
+
+static void scene_paging_evict(u32 slot) {
+    u32 page = g_scene_paging.slot_page[slot];
+    if (page != SCENE_PAGE_NONE) {
+        g_scene_paging.page_slot[page] = SCENE_PAGE_NONE;
+        g_scene_paging.slot_page[slot] = SCENE_PAGE_NONE;
+        g_scene_paging.evictions++;
+        g_scene_paging.dirty = true;
+    }
+}
+
+// Seek in blocking mode, then read the page without waiting for it
+static GaussianResult scene_paging_issue(u32 page_index, u32 slot) {
+    const PagedPage* page = &g_scene_paging.pages[page_index];
+    u32 offset = sizeof(CookedSceneHeader) + g_scene_paging.header.sections[PAGED_SECTION_PAGE_DATA].offset +
+                 page->data_offset;
+    if (fileXioLseek(g_scene_paging.fd, offset, SEEK_SET) < 0) {
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    u32 size = scene_page_bytes(page);
+    fileXioSetBlockMode(FXIO_NOWAIT);
+    fileXioRead(g_scene_paging.fd, g_scene_paging.staging, size);
+    fileXioSetBlockMode(FXIO_WAIT);
+    
+    g_scene_paging.loading_page = page_index;
+    g_scene_paging.loading_slot = slot;
+    g_scene_paging.read_size = size;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Distance from a point to a page's bounds, 0 inside them
+static float scene_page_distance(const PagedPage* page, const float point[3]) {
+    float distance_sq = 0.0f;
+    for (int j = 0; j < 3; j++) {
+        float lo = fixed_to_float(page->bounds_min[j]);
+        float hi = fixed_to_float(page->bounds_max[j]);
+        float d = (point[j] < lo) ? lo - point[j] : (point[j] > hi) ? point[j] - hi : 0.0f;
+        distance_sq += d * d;
+    }
+    return sqrtf(distance_sq);
+}
+
+static void scene_paging_free(void) {
+    memory_free(g_scene_paging.tables);
+    memory_free(g_scene_paging.staging);
+    memory_free(g_scene_paging.page_slot);
+    memory_free(g_scene_paging.page_distance);
+    memory_free(g_scene_paging.leaf_counts);
+    g_scene_paging.tables = NULL;
+    g_scene_paging.staging = NULL;
+    g_scene_paging.page_slot = NULL;
+    g_scene_paging.page_distance = NULL;
+    g_scene_paging.leaf_counts = NULL;
+}
+
+/*
+ * Open a paged scene: resident tables and proxies are read and decoded, the
+ * page tree is handed to culling, and the scene draws proxies everywhere
+ * until scene_paging_update() brings pages in. max_resident caps the scene
+ * splats (proxies plus slots). Returns GAUSSIAN_ERROR_INVALID_FORMAT for
+ * files that are not paged scenes, GAUSSIAN_ERROR_INIT_FAILED without fileXio.
+ */
+GaussianResult scene_paging_open(const char* filename, GaussianScene* scene, u32 max_resident) {
+    if (!filename || !scene || max_resident == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (g_scene_paging.active) {
+        return GAUSSIAN_ERROR_BUSY;
+    }
+    
+    char full_path[256];
+    if (find_file_on_storage(filename, full_path, sizeof(full_path)) != GAUSSIAN_SUCCESS) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    if (fileXioInit() < 0) {
+        debug_log_warning("fileXio unavailable, paged scenes cannot load");
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+    
+    int fd = fileXioOpen(full_path, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    CookedSceneHeader* header = &g_scene_paging.header;
+    if (fileXioRead(fd, header, sizeof(CookedSceneHeader)) != (int)sizeof(CookedSceneHeader) ||
+        header->magic != SPLAT_MAGIC || header->version != SPLAT_VERSION_PAGED) {
+        fileXioClose(fd);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    debug_log_info("Opening paged scene: %s (%u splats, %u KB)", filename,
+                   header->splat_count, header->payload_size / 1024);
+    
+    // Resident tables come first; the page tree node stride is checked by the culling module
+    static const u32 strides[PAGED_SECTION_COUNT] = {
+        16 * sizeof(u16), 0, sizeof(PagedPage), sizeof(PackedSplat), 1
+    };
+    const CookedSectionEntry* sections = header->sections;
+    const CookedSectionEntry* page_data = &sections[PAGED_SECTION_PAGE_DATA];
+    u32 sh_count = sections[PAGED_SECTION_SH_CODEBOOK].count;
+    u32 page_count = sections[PAGED_SECTION_PAGES].count;
+    u32 proxy_count = sections[PAGED_SECTION_PROXIES].count;
+    bool valid = header->splat_count > 0 && sh_count > 0 && sh_count <= PACKED_SH_CODEBOOK_MAX &&
+                 sections[PAGED_SECTION_PAGE_NODES].count > 0 && page_count > 0;
+    for (int s = 0; s < PAGED_SECTION_COUNT && valid; s++) {
+        const CookedSectionEntry* section = &sections[s];
+        valid = (section->offset % DMA_ALIGNMENT) == 0 &&
+                section->size == section->count * section->stride &&
+                section->offset + section->size <= header->payload_size &&
+                (strides[s] == 0 || section->stride == strides[s]) &&
+                (s == PAGED_SECTION_PAGE_DATA || section->offset + section->size <= page_data->offset);
+    }
+    if (!valid) {
+        debug_log_error("Paged scene %s does not match this build's layout", filename);
+        fileXioClose(fd);
+        return GAUSSIAN_ERROR_UNSUPPORTED_FORMAT;
+    }
+    
+    // Proxies stay resident; whatever the cap leaves becomes page slots
+    u32 resident_cap = MIN(max_resident, MAX_SPLATS_PER_SCENE);
+    u32 slot_count = (proxy_count < resident_cap) ? (resident_cap - proxy_count) / SCENE_PAGE_SPLATS : 0;
+    slot_count = MIN(slot_count, MIN(page_count, SCENE_PAGE_SLOTS_MAX));
+    CookedSceneHeader layout;
+    u32 output_size = 0;
+    while (slot_count > 0) {
+        output_size = packed_output_layout(&layout, proxy_count + slot_count * SCENE_PAGE_SPLATS,
+                                           &sections[PAGED_SECTION_PAGE_NODES]);
+        if (memory_budget_fits(MEMORY_BUDGET_SCENE, output_size)) break;
+        slot_count--;
+    }
+    u32 capacity = proxy_count + slot_count * SCENE_PAGE_SPLATS;
+    u32 staging_size = SCENE_PAGE_SPLATS * (sizeof(PackedLeafFrame) + sizeof(PackedSplat));
+    u32 state_size = page_count * (sizeof(u16) + sizeof(float) + sizeof(u32));
+    if (slot_count == 0 ||
+        !memory_budget_fits(MEMORY_BUDGET_ASSET, page_data->offset + staging_size + state_size)) {
+        debug_log_error("Paged scene %s: no room for its %u proxies and a page cache", filename, proxy_count);
+        fileXioClose(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    u8* payload = (u8*)memory_alloc(MEMORY_BUDGET_SCENE, output_size, DMA_ALIGNMENT);
+    g_scene_paging.tables = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, page_data->offset, DMA_ALIGNMENT);
+    g_scene_paging.staging = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, staging_size, DMA_ALIGNMENT);
+    g_scene_paging.page_slot = (u16*)memory_alloc(MEMORY_BUDGET_ASSET, page_count * sizeof(u16), 16);
+    g_scene_paging.page_distance = (float*)memory_alloc(MEMORY_BUDGET_ASSET, page_count * sizeof(float), 16);
+    g_scene_paging.leaf_counts = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, page_count * sizeof(u32), 16);
+    if (!payload || !g_scene_paging.tables || !g_scene_paging.staging || !g_scene_paging.page_slot ||
+        !g_scene_paging.page_distance || !g_scene_paging.leaf_counts) {
+        memory_free(payload);
+        scene_paging_free();
+        fileXioClose(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    if (fileXioRead(fd, g_scene_paging.tables, page_data->offset) != (int)page_data->offset) {
+        result = GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    // Pages must tile the scene and stay inside the page data and proxy tables
+    const PagedPage* pages = (const PagedPage*)(g_scene_paging.tables + sections[PAGED_SECTION_PAGES].offset);
+    if (result == GAUSSIAN_SUCCESS) {
+        u32 covered = 0;
+        for (u32 p = 0; p < page_count && result == GAUSSIAN_SUCCESS; p++) {
+            const PagedPage* page = &pages[p];
+            covered += page->splat_count;
+            if (page->splat_count > SCENE_PAGE_SPLATS || page->frame_count > page->splat_count ||
+                (page->data_offset % DMA_ALIGNMENT) != 0 ||
+                page->data_offset + scene_page_bytes(page) > page_data->size ||
+                page->proxy_first + page->proxy_count > proxy_count) {
+                result = GAUSSIAN_ERROR_INVALID_FORMAT;
+            }
+        }
+        if (result == GAUSSIAN_SUCCESS && covered != header->splat_count) {
+            debug_log_error("Paged scene pages cover %u of %u splats", covered, header->splat_count);
+            result = GAUSSIAN_ERROR_INVALID_FORMAT;
+        }
+    }
+    
+    // Slots that hold no page are never indexed; clear them once all the same
+    memset(payload, 0, output_size);
+    const CookedSectionEntry* out = layout.sections;
+    memcpy(payload + out[COOKED_SECTION_OCTREE_NODES].offset,
+           g_scene_paging.tables + sections[PAGED_SECTION_PAGE_NODES].offset, sections[PAGED_SECTION_PAGE_NODES].size);
+    if (result == GAUSSIAN_SUCCESS) {
+        result = init_spatial_grid_paged(payload + out[COOKED_SECTION_OCTREE_NODES].offset,
+                                         out[COOKED_SECTION_OCTREE_NODES].count,
+                                         out[COOKED_SECTION_OCTREE_NODES].stride,
+                                         (u32*)(payload + out[COOKED_SECTION_OCTREE_INDICES].offset),
+                                         capacity, page_count);
+    }
+    
+    if (result != GAUSSIAN_SUCCESS) {
+        debug_log_error("Paged scene %s rejected (%d)", filename, result);
+        memory_free(payload);
+        scene_paging_free();
+        fileXioClose(fd);
+        return result;
+    }
+    
+    cooked_scene_attach(scene, payload, &layout, capacity);
+    
+    g_scene_paging.scene = scene;
+    g_scene_paging.pages = pages;
+    g_scene_paging.sh_codebook = (const u16*)(g_scene_paging.tables + sections[PAGED_SECTION_SH_CODEBOOK].offset);
+    g_scene_paging.indices = (u32*)(payload + out[COOKED_SECTION_OCTREE_INDICES].offset);
+    g_scene_paging.page_count = page_count;
+    g_scene_paging.proxy_count = proxy_count;
+    g_scene_paging.slot_count = slot_count;
+    g_scene_paging.sh_count = sh_count;
+    g_scene_paging.fd = fd;
+    g_scene_paging.read_size = 0;
+    g_scene_paging.has_position = false;
+    g_scene_paging.loads = 0;
+    g_scene_paging.evictions = 0;
+    for (u32 s = 0; s < SCENE_PAGE_SLOTS_MAX; s++) {
+        g_scene_paging.slot_page[s] = SCENE_PAGE_NONE;
+    }
+    
+    // Proxies first: they are what every page shows until it loads
+    packed_scale_lut_init();
+    const PackedSplat* proxies = (const PackedSplat*)(g_scene_paging.tables + sections[PAGED_SECTION_PROXIES].offset);
+    for (u32 p = 0; p < page_count; p++) {
+        PackedFrame frame;
+        packed_frame_init(&frame, pages[p].bounds_min, pages[p].bounds_max);
+        scene_paging_decode(&proxies[pages[p].proxy_first], pages[p].proxy_count, &frame, pages[p].proxy_first);
+        g_scene_paging.page_slot[p] = SCENE_PAGE_NONE;
+    }
+    
+    g_scene_paging.active = true;
+    scene_paging_layout();
+    
+    debug_log_info("Paged scene open: %u pages, %u proxies, %u slots of %u splats (%u KB resident)",
+                   page_count, proxy_count, slot_count, SCENE_PAGE_SPLATS, output_size / 1024);
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Once per frame: collect the page read in flight, then start the next one.
+ * Pages are ranked by distance from where the camera will be
+ * SCENE_PAGE_LOOKAHEAD frames ahead at its current velocity; the nearest
+ * missing page takes a free slot or evicts the farthest resident page.
+ * splat_budget is the renderer's current splat cap: slots past it are emptied.
+ */
+GaussianResult scene_paging_update(const fixed16_t camera_position[3], u32 splat_budget) {
+    if (!g_scene_paging.active || !camera_position) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    if (g_scene_paging.read_size > 0) {
+        int bytes_read = 0;
+        if (fileXioWaitAsync(FXIO_NOWAIT, &bytes_read) == FXIO_COMPLETE) {
+            u32 page = g_scene_paging.loading_page;
+            u32 slot = g_scene_paging.loading_slot;
+            bool loaded = bytes_read == (int)g_scene_paging.read_size &&
+                          scene_paging_decode_page(&g_scene_paging.pages[page], slot);
+            g_scene_paging.read_size = 0;
+            
+            if (loaded) {
+                g_scene_paging.page_slot[page] = slot;
+                g_scene_paging.slot_page[slot] = page;
+                g_scene_paging.loads++;
+                g_scene_paging.dirty = true;
+            } else {
+                // A page that cannot be read now will not be later: keep what is resident
+                debug_log_error("Scene page %u failed to load (%d of %u bytes), paging stopped", page,
+                                bytes_read, scene_page_bytes(&g_scene_paging.pages[page]));
+                scene_paging_close();
+                return GAUSSIAN_ERROR_FILE_READ_FAILED;
+            }
+        }
+    }
+    
+    // Predicted camera position from the smoothed per-update movement
+    float position[3], predicted[3];
+    for (int j = 0; j < 3; j++) {
+        position[j] = fixed_to_float(camera_position[j]);
+        float moved = g_scene_paging.has_position ? position[j] - g_scene_paging.last_position[j] : 0.0f;
+        g_scene_paging.velocity[j] = g_scene_paging.velocity[j] * 0.75f + moved * 0.25f;
+        g_scene_paging.last_position[j] = position[j];
+        predicted[j] = position[j] + g_scene_paging.velocity[j] * SCENE_PAGE_LOOKAHEAD;
+    }
+    g_scene_paging.has_position = true;
+    
+    // Slots past the renderer's budget would be culled anyway: hand them back to the proxies
+    u32 active_slots = (splat_budget > g_scene_paging.proxy_count) ?
+                       (splat_budget - g_scene_paging.proxy_count) / SCENE_PAGE_SPLATS : 0;
+    active_slots = MIN(active_slots, g_scene_paging.slot_count);
+    for (u32 s = active_slots; s < g_scene_paging.slot_count; s++) {
+        scene_paging_evict(s);
+    }
+    
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    if (g_scene_paging.read_size == 0 && active_slots > 0) {
+        u32 best = SCENE_PAGE_NONE;
+        for (u32 p = 0; p < g_scene_paging.page_count; p++) {
+            float distance = scene_page_distance(&g_scene_paging.pages[p], predicted);
+            g_scene_paging.page_distance[p] = distance;
+            if (g_scene_paging.page_slot[p] == SCENE_PAGE_NONE && g_scene_paging.pages[p].splat_count > 0 &&
+                (best == SCENE_PAGE_NONE || distance < g_scene_paging.page_distance[best])) {
+                best = p;
+            }
+        }
+        
+        // A free slot, else the slot of the farthest resident page
+        u32 slot = SCENE_PAGE_NONE;
+        for (u32 s = 0; s < active_slots && best != SCENE_PAGE_NONE; s++) {
+            u32 held = g_scene_paging.slot_page[s];
+            if (held == SCENE_PAGE_NONE) {
+                slot = s;
+                break;
+            }
+            if (slot == SCENE_PAGE_NONE ||
+                g_scene_paging.page_distance[held] > g_scene_paging.page_distance[g_scene_paging.slot_page[slot]]) {
+                slot = s;
+            }
+        }
+        
+        if (slot != SCENE_PAGE_NONE) {
+            u32 held = g_scene_paging.slot_page[slot];
+            bool closer = held == SCENE_PAGE_NONE ||
+                          g_scene_paging.page_distance[held] >
+                          g_scene_paging.page_distance[best] * SCENE_PAGE_HYSTERESIS;
+            if (closer) {
+                scene_paging_evict(slot);
+                GaussianResult issued = scene_paging_issue(best, slot);
+                if (issued != GAUSSIAN_SUCCESS) {
+                    result = issued;
+                }
+            }
+        }
+    }
+    
+    if (g_scene_paging.dirty) {
+        GaussianResult laid_out = scene_paging_layout();
+        if (laid_out != GAUSSIAN_SUCCESS) {
+            result = laid_out;
+        }
+    }
+    return result;
+}
+
+bool scene_paging_active(void) {
+    return g_scene_paging.active;
+}
+
+// Resident pages, loads and evictions since the scene was opened
+void scene_paging_get_stats(u32* resident_pages, u32* loads, u32* evictions) {
+    u32 resident = 0;
+    for (u32 s = 0; s < g_scene_paging.slot_count; s++) {
+        if (g_scene_paging.slot_page[s] != SCENE_PAGE_NONE) {
+            resident++;
+        }
+    }
+    if (resident_pages) *resident_pages = resident;
+    if (loads) *loads = g_scene_paging.loads;
+    if (evictions) *evictions = g_scene_paging.evictions;
+}
+
+// Stop paging, e.g. before the scene that owns the slots is destroyed
+void scene_paging_close(void) {
+    if (!g_scene_paging.active) {
+        return;
+    }
+    
+    int ret;
+    if (g_scene_paging.read_size > 0) {
+        fileXioWaitAsync(FXIO_WAIT, &ret);
+        g_scene_paging.read_size = 0;
+    }
+    fileXioClose(g_scene_paging.fd);
+    scene_paging_free();
+    g_scene_paging.active = false;
+}
+
 /*
  * Generate test splats for development and testing
  * Creates a simple test scene with known splat positions
@@ -106,13 +1680,13 @@ int load_gaussian_splat_scene(const char* filename, GaussianSplat3D** splats, in
 GaussianSplat3D* generate_test_splats(int count) {
     debug_log_info("Generating %d test splats", count);
     
-    if (count <= 0 || count > 65536) {
+    if (count <= 0 || count > MAX_SPLATS_PER_SCENE) {
         debug_log_error("Invalid test splat count: %d", count);
         return NULL;
     }
     
     // Allocate memory for test splats
-    GaussianSplat3D* splats = (GaussianSplat3D*)splatstorm_malloc(count * sizeof(GaussianSplat3D));
+    GaussianSplat3D* splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, count * sizeof(GaussianSplat3D), CACHE_LINE_SIZE);
     if (!splats) {
         debug_log_error("Failed to allocate memory for test splats");
         return NULL;
@@ -203,7 +1777,7 @@ int save_gaussian_splat_scene(const char* filename, GaussianSplat3D* splats, int
  */
 void free_gaussian_splats(GaussianSplat3D* splats) {
     if (splats) {
-        splatstorm_free(splats);
+        memory_free(splats);
         debug_log_info("Freed splat memory");
     }
 }
@@ -54,19 +54,10 @@ GaussianResult asset_manager_init(u32 max_splats) {
         return GAUSSIAN_SUCCESS;
     }
     
-    // Allocate memory pool for assets
-    size_t pool_size = max_splats * sizeof(GaussianSplat3D) + 1024 * 1024; // 1MB extra
-    u32 pool_id;
-    int result = memory_pool_create(POOL_TYPE_LINEAR, pool_size, 64, &pool_id);
-    if (result != 0) {
-        printf("Failed to create asset memory pool\n");
-        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
-    }
-    g_asset_manager.asset_pool_id = pool_id;
-    
-    // Allocate splat storage
-    g_asset_manager.loaded_splats = (GaussianSplat3D*)memory_pool_alloc(
-        g_asset_manager.asset_pool_id, max_splats * sizeof(GaussianSplat3D), 64, __FILE__, __LINE__);
+    // Allocate splat storage from the scene budget
+    g_asset_manager.asset_pool_id = memory_budget_pool(MEMORY_BUDGET_SCENE);
+    g_asset_manager.loaded_splats = (GaussianSplat3D*)memory_alloc(
+        MEMORY_BUDGET_SCENE, max_splats * sizeof(GaussianSplat3D), 64);
     if (!g_asset_manager.loaded_splats) {
         debug_log_error("Failed to allocate splat storage");
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
@@ -85,7 +76,7 @@ void asset_manager_cleanup(void) {
         return;
     }
     
-    // Memory pools are managed by the memory system
+    memory_free(g_asset_manager.loaded_splats);
     
     memset(&g_asset_manager, 0, sizeof(g_asset_manager));
     debug_log_info( "Asset manager cleaned up");
@@ -499,7 +490,7 @@ static bool load_ply_binary(const char* data, size_t size, GaussianSplat3D** spl
     if (vertex_count == 0) return false;
     
     // Allocate memory for splats
-    *splats = (GaussianSplat3D*)malloc(vertex_count * sizeof(GaussianSplat3D));
+    *splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, vertex_count * sizeof(GaussianSplat3D), 64);
     if (!*splats) return false;
     
     // Read binary vertex data
@@ -665,7 +656,7 @@ static bool load_ply_ascii(const char* data, size_t size, GaussianSplat3D** spla
     if (vertex_count == 0 || ptr >= end) return false;
     
     // Allocate memory for splats
-    *splats = (GaussianSplat3D*)malloc(vertex_count * sizeof(GaussianSplat3D));
+    *splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, vertex_count * sizeof(GaussianSplat3D), 64);
     if (!*splats) return false;
     
     // Read ASCII vertex data
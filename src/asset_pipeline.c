@@ -15,6 +15,7 @@
 #include <malloc.h>
 #include <gsInit.h>
 #include <gsToolkit.h>
+#include <fcntl.h>
 
 // Asset pipeline state
 static bool asset_pipeline_initialized = false;
@@ -42,6 +43,8 @@ typedef struct {
 
 #define ASSET_MAGIC 0x53504C54  // "SPLT"
 #define ASSET_VERSION 1
+#define TEXTURE_READ_BLOCK (64 * 1024)  // Pipelined read block for pixel data
+
 // Asset pipeline initialization
 int splatstorm_asset_pipeline_init(void) {
     debug_log_info("Asset Pipeline: Initializing asset loading system");
@@ -74,6 +77,12 @@ void splatstorm_asset_pipeline_shutdown(void) {
     debug_log_info("Asset Pipeline: Asset pipeline shutdown complete");
 }
 
+// Pixel data lands in texture->Mem at its offset past the header
+static GaussianResult texture_copy_block(const u8* block, u32 size, u32 file_offset, void* user) {
+    memcpy((u8*)user + (file_offset - sizeof(asset_header_t)), block, size);
+    return GAUSSIAN_SUCCESS;
+}
+
 // Load texture from file (PNG/JPEG support framework)
 GSTEXTURE* splatstorm_asset_load_texture(const char* filename) {
     if (!asset_pipeline_initialized || !filename) {
@@ -83,36 +92,34 @@ GSTEXTURE* splatstorm_asset_load_texture(const char* filename) {
     
     debug_log_info("Asset Pipeline: Loading texture: %s", filename);
     
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
+    int fd = open_file_auto(filename, O_RDONLY);
+    if (fd < 0) {
         debug_log_error("Asset Pipeline: Cannot open texture file: %s", filename);
         return NULL;
     }
     
     // Read asset header
     asset_header_t header;
-    if (fread(&header, sizeof(header), 1, file) != 1) {
+    int header_read = read_file_data(fd, &header, sizeof(header));
+    close_file(fd);
+    if (header_read != (int)sizeof(header)) {
         debug_log_error("Asset Pipeline: Cannot read asset header");
-        fclose(file);
         return NULL;
     }
     
     // Validate header
     if (header.magic != ASSET_MAGIC) {
         debug_log_error("Asset Pipeline: Invalid asset magic number");
-        fclose(file);
         return NULL;
     }
     
     if (header.version != ASSET_VERSION) {
         debug_log_error("Asset Pipeline: Unsupported asset version: %u", header.version);
-        fclose(file);
         return NULL;
     }
     
     if (header.type != ASSET_TYPE_TEXTURE) {
         debug_log_error("Asset Pipeline: Asset is not a texture");
-        fclose(file);
         return NULL;
     }
     
@@ -120,20 +127,19 @@ GSTEXTURE* splatstorm_asset_load_texture(const char* filename) {
     GSTEXTURE* texture = splatstorm_create_texture(header.width, header.height, header.format);
     if (!texture) {
         debug_log_error("Asset Pipeline: Failed to create texture");
-        fclose(file);
         return NULL;
     }
     
-    // Read texture data
-    if (fread(texture->Mem, header.size, 1, file) != 1) {
+    // Read texture data, copying each block out while the next one is read
+    u32 delivered = 0;
+    GaussianResult result = file_read_pipelined(filename, sizeof(header), header.size, TEXTURE_READ_BLOCK,
+                                                texture_copy_block, texture->Mem, &delivered);
+    if (result != GAUSSIAN_SUCCESS || delivered != header.size) {
         debug_log_error("Asset Pipeline: Failed to read texture data");
         splatstorm_free_texture(texture);
-        fclose(file);
         return NULL;
     }
     
-    fclose(file);
-    
     // Upload to VRAM
     if (!splatstorm_upload_texture(texture)) {
         debug_log_warning("Asset Pipeline: Failed to upload texture to VRAM");
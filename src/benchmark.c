@@ -0,0 +1,459 @@
+/*
+ * SPLATSTORM X - Benchmark Mode
+ * Repeatable performance runs over recorded camera paths.
+ *
+ * Record: the camera flies from live input as usual and its pose is kept
+ * every frame, then saved as a path. Replay: the pose of frame i is set
+ * bit for bit before frame i renders, whatever the frame took, so every
+ * build renders the same sequence of views. Both modes keep per-frame
+ * stage timings, sampled VU busy time and splat counts in memory, write
+ * them to CSV when the run ends and print a summary; nothing touches
+ * storage mid-run.
+ *
+ * Options come from the command line (argv[2] onward) or from
+ * BENCHMARK_CONFIG_FILE next to the ELF, for discs booted from SYSTEM.CNF,
+ * which cannot pass arguments:
+ *   bench=record:<path file>   bench=replay:<path file>
+ *   bench_csv=<file>           bench_frames=<n>   bench_scene=<file>
+ *   bench_capture=<frame>:<file>
+ *
+ * bench_capture saves the projected splats of one frame, as tiling gets
+ * them, for the host kernel benchmarks (make bench-host, BENCH_ARGS=
+ * "--splats <file>"). It works with or without a benchmark run. Frames
+ * count from the first one binned on the EE; the direct VU1 path never
+ * hands its splats to tiling. The write is synchronous, so that frame's
+ * timings include it. Layout, little endian: magic u32, version u16,
+ * record size u16, splat count u32, render width u16, height u16, then the
+ * GaussianSplatRender records.
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include "performance_utils.h"
+#include <tamtypes.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    u32 magic;                                // BENCHMARK_PATH_MAGIC
+    u32 version;                              // BENCHMARK_PATH_VERSION
+    u32 frame_count;
+    u32 reserved;
+} BenchmarkPathHeader;
+
+typedef struct {
+    u32 magic;                                // BENCHMARK_SPLATS_MAGIC
+    u16 version;                              // BENCHMARK_SPLATS_VERSION
+    u16 record_size;                          // sizeof(GaussianSplatRender)
+    u32 count;
+    u16 width;                                // Render resolution the splats were binned at
+    u16 height;
+} BenchmarkSplatsHeader;
+
+typedef struct {
+    fixed16_t position[3];
+    fixed16_t rotation[4];                    // Quaternion
+} BenchmarkPose;
+
+typedef struct {
+    u32 frame_cycles;                         // Main loop, frame to frame
+    u32 render_cycles;                        // render_frame
+    u32 cull_cycles;
+    u32 vu_cycles;
+    u32 tile_cycles;
+    u32 gs_cycles;
+    u32 visible_splats;
+    u32 projected_splats;
+    u32 lod_splats;
+    u32 rendered_splats;
+    u32 vu_busy_cycles[2];                    // Sampled VU0/VU1 run time, 0 with the sampler off
+    u32 vu1_gap_cycles;                       // VU1 idle between the frame's runs
+} BenchmarkSample;
+
+static struct {
+    BenchmarkMode mode;
+    char path_file[64];
+    char csv_file[64];
+    char scene_file[64];
+    u32 max_frames;                           // Record: frames before the run stops
+
+    // Run state
+    bool started;
+    BenchmarkPose* poses;                     // Replay: loaded path; record: path so far
+    BenchmarkSample* samples;
+    u32 path_frames;                          // Poses in a loaded path
+    u32 frame;                                // Frames taken
+
+    // Splat capture, independent of the run
+    char capture_file[64];
+    u32 capture_frame;
+    u32 capture_calls;                        // Frames that reached tiling so far
+} g_bench = {BENCHMARK_OFF, "", BENCHMARK_DEFAULT_CSV, "", BENCHMARK_MAX_FRAMES};
+
+static u32 g_bench_sorted[BENCHMARK_MAX_FRAMES];
+
+static void benchmark_copy(char* dest, const char* src, u32 size) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+// One option; false when it is not a benchmark option
+bool benchmark_parse_option(const char* option) {
+    if (!option) return false;
+
+    if (strncmp(option, "bench=record:", 13) == 0) {
+        g_bench.mode = BENCHMARK_RECORD;
+        benchmark_copy(g_bench.path_file, option + 13, sizeof(g_bench.path_file));
+    } else if (strncmp(option, "bench=replay:", 13) == 0) {
+        g_bench.mode = BENCHMARK_REPLAY;
+        benchmark_copy(g_bench.path_file, option + 13, sizeof(g_bench.path_file));
+    } else if (strncmp(option, "bench_csv=", 10) == 0) {
+        benchmark_copy(g_bench.csv_file, option + 10, sizeof(g_bench.csv_file));
+    } else if (strncmp(option, "bench_frames=", 13) == 0) {
+        u32 frames = (u32)atoi(option + 13);
+        g_bench.max_frames = (frames > 0) ? MIN(frames, BENCHMARK_MAX_FRAMES) : BENCHMARK_MAX_FRAMES;
+    } else if (strncmp(option, "bench_scene=", 12) == 0) {
+        benchmark_copy(g_bench.scene_file, option + 12, sizeof(g_bench.scene_file));
+    } else if (strncmp(option, "bench_capture=", 14) == 0) {
+        const char* separator = strchr(option + 14, ':');
+        if (!separator || !separator[1]) return false;
+        g_bench.capture_frame = (u32)atoi(option + 14);
+        benchmark_copy(g_bench.capture_file, separator + 1, sizeof(g_bench.capture_file));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Read BENCHMARK_CONFIG_FILE from the directory of the ELF. Returns the
+// number of options applied; 0 when there is no file.
+u32 benchmark_load_config(const char* boot_path) {
+    if (!boot_path) return 0;
+
+    // Directory: everything up to the last separator
+    char config_path[96];
+    u32 dir_length = 0;
+    for (u32 i = 0; boot_path[i] && i < sizeof(config_path) - 16; i++) {
+        if (boot_path[i] == '/' || boot_path[i] == '\\' || boot_path[i] == ':') {
+            dir_length = i + 1;
+        }
+    }
+    memcpy(config_path, boot_path, dir_length);
+    config_path[dir_length] = '\0';
+    strcat(config_path, BENCHMARK_CONFIG_FILE);
+    if (strncmp(boot_path, "cdrom", 5) == 0) {
+        strcat(config_path, ";1");  // ISO 9660 version suffix
+    }
+
+    if (iop_require_path(config_path) < 0) return 0;
+    FILE* file = fopen(config_path, "r");
+    if (!file) return 0;
+
+    u32 applied = 0;
+    char line[96];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+        if (benchmark_parse_option(line)) {
+            applied++;
+        } else {
+            debug_log_warning("Benchmark: unknown option '%s' in %s", line, config_path);
+        }
+    }
+    fclose(file);
+
+    printf("SPLATSTORM X: %u benchmark options from %s\n", applied, config_path);
+    return applied;
+}
+
+// Scene named by bench_scene, or NULL
+const char* benchmark_get_scene(void) {
+    return g_bench.scene_file[0] ? g_bench.scene_file : NULL;
+}
+
+BenchmarkMode benchmark_mode(void) {
+    return g_bench.started ? g_bench.mode : BENCHMARK_OFF;
+}
+
+static GaussianResult benchmark_load_path(void) {
+    if (iop_require_path(g_bench.path_file) < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    FILE* file = fopen(g_bench.path_file, "rb");
+    if (!file) {
+        debug_log_error("Benchmark: cannot open camera path %s", g_bench.path_file);
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+
+    BenchmarkPathHeader header;
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != BENCHMARK_PATH_MAGIC ||
+        header.version != BENCHMARK_PATH_VERSION || header.frame_count == 0 ||
+        header.frame_count > BENCHMARK_MAX_FRAMES) {
+        debug_log_error("Benchmark: %s is not a camera path", g_bench.path_file);
+        result = GAUSSIAN_ERROR_INVALID_FORMAT;
+    } else if (fread(g_bench.poses, sizeof(BenchmarkPose), header.frame_count, file) != header.frame_count) {
+        debug_log_error("Benchmark: camera path %s is truncated", g_bench.path_file);
+        result = GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    fclose(file);
+
+    g_bench.path_frames = (result == GAUSSIAN_SUCCESS) ? header.frame_count : 0;
+    return result;
+}
+
+/*
+ * Allocate the run buffers and, to replay, load the path. Benchmark off
+ * (no bench= option) is a success that does nothing.
+ */
+GaussianResult benchmark_start(void) {
+    if (g_bench.mode == BENCHMARK_OFF || g_bench.started) {
+        return GAUSSIAN_SUCCESS;
+    }
+
+    g_bench.poses = (BenchmarkPose*)memory_alloc(MEMORY_BUDGET_DEBUG, BENCHMARK_MAX_FRAMES * sizeof(BenchmarkPose),
+                                                 CACHE_LINE_SIZE);
+    g_bench.samples = (BenchmarkSample*)memory_alloc(MEMORY_BUDGET_DEBUG,
+                                                     BENCHMARK_MAX_FRAMES * sizeof(BenchmarkSample), CACHE_LINE_SIZE);
+    if (!g_bench.poses || !g_bench.samples) {
+        benchmark_finish();
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+
+    if (g_bench.mode == BENCHMARK_REPLAY) {
+        GaussianResult result = benchmark_load_path();
+        if (result != GAUSSIAN_SUCCESS) {
+            benchmark_finish();
+            return result;
+        }
+    }
+
+    g_bench.frame = 0;
+    g_bench.started = true;
+    if (g_bench.mode == BENCHMARK_REPLAY) {
+        printf("SPLATSTORM X: Benchmark replaying %s, %u frames\n", g_bench.path_file, g_bench.path_frames);
+    } else {
+        printf("SPLATSTORM X: Benchmark recording to %s, up to %u frames\n", g_bench.path_file, g_bench.max_frames);
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Replay: set the pose of the next frame. False once the path has ended,
+ * which ends the run.
+ */
+bool benchmark_apply_camera(CameraFixed* camera) {
+    if (benchmark_mode() != BENCHMARK_REPLAY || g_bench.frame >= g_bench.path_frames) {
+        return false;
+    }
+
+    const BenchmarkPose* pose = &g_bench.poses[g_bench.frame];
+    camera_set_pose_fixed(camera, pose->position, pose->rotation);
+    return true;
+}
+
+/*
+ * Keep the frame the zone profiler just closed, and in recording the pose
+ * it was drawn from. False once the run has all its frames.
+ */
+bool benchmark_record_frame(const CameraFixed* camera, const FrameProfileData* profile) {
+    if (benchmark_mode() == BENCHMARK_OFF || !camera || !profile) {
+        return false;
+    }
+
+    u32 limit = (g_bench.mode == BENCHMARK_REPLAY) ? g_bench.path_frames : g_bench.max_frames;
+    if (g_bench.frame >= limit) {
+        return false;
+    }
+
+    u32 cycles[PROFILE_ZONE_COUNT];
+    if (!profile_zones_latest(cycles, NULL)) {
+        memset(cycles, 0, sizeof(cycles));
+    }
+
+    BenchmarkSample* sample = &g_bench.samples[g_bench.frame];
+    sample->frame_cycles = cycles[PROFILE_ZONE_FRAME];
+    sample->render_cycles = (u32)profile->frame_cycles;
+    sample->cull_cycles = (u32)profile->cull_cycles;
+    sample->vu_cycles = (u32)profile->vu_execute_cycles;
+    sample->tile_cycles = (u32)profile->tile_sort_cycles;
+    sample->gs_cycles = (u32)profile->gs_render_cycles;
+    sample->visible_splats = profile->visible_splats;
+    sample->projected_splats = profile->projected_splats;
+    sample->lod_splats = profile->lod_splats;
+    sample->rendered_splats = profile->rendered_splats;
+    VUActivityStats activity;
+    vu_activity_get_stats(&activity);
+    sample->vu_busy_cycles[VU_UNIT_VU0] = activity.busy_cycles[VU_UNIT_VU0];
+    sample->vu_busy_cycles[VU_UNIT_VU1] = activity.busy_cycles[VU_UNIT_VU1];
+    sample->vu1_gap_cycles = activity.gap_cycles[VU_UNIT_VU1];
+
+    if (g_bench.mode == BENCHMARK_RECORD) {
+        BenchmarkPose* pose = &g_bench.poses[g_bench.frame];
+        memcpy(pose->position, camera->position, sizeof(pose->position));
+        memcpy(pose->rotation, camera->rotation, sizeof(pose->rotation));
+    }
+
+    g_bench.frame++;
+    return g_bench.frame < limit;
+}
+
+/*
+ * bench_capture: save this frame's projected splats if it is the frame
+ * asked for. Call once per drawn frame, just before binning.
+ */
+void benchmark_capture_splats(const GaussianSplatRender* splats, u32 count) {
+    if (!g_bench.capture_file[0] || g_bench.capture_calls++ != g_bench.capture_frame || !splats) {
+        return;
+    }
+
+    if (iop_require_path(g_bench.capture_file) < 0) return;
+    FILE* file = fopen(g_bench.capture_file, "wb");
+    if (!file) {
+        debug_log_error("Benchmark: cannot write %s", g_bench.capture_file);
+        return;
+    }
+
+    u32 width, height;
+    gs_get_render_resolution(&width, &height);
+    BenchmarkSplatsHeader header = {BENCHMARK_SPLATS_MAGIC, BENCHMARK_SPLATS_VERSION, sizeof(GaussianSplatRender),
+                                    count, (u16)width, (u16)height};
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(splats, sizeof(GaussianSplatRender), count, file) == count;
+    fclose(file);
+
+    if (!written) {
+        debug_log_error("Benchmark: splat capture %s incomplete", g_bench.capture_file);
+        return;
+    }
+    printf("SPLATSTORM X: %u projected splats of frame %u saved to %s\n", count, g_bench.capture_frame,
+           g_bench.capture_file);
+}
+
+static GaussianResult benchmark_save_path(void) {
+    if (iop_require_path(g_bench.path_file) < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    FILE* file = fopen(g_bench.path_file, "wb");
+    if (!file) {
+        debug_log_error("Benchmark: cannot write camera path %s", g_bench.path_file);
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+
+    BenchmarkPathHeader header = {BENCHMARK_PATH_MAGIC, BENCHMARK_PATH_VERSION, g_bench.frame, 0};
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(g_bench.poses, sizeof(BenchmarkPose), g_bench.frame, file) == g_bench.frame;
+    fclose(file);
+
+    if (!written) {
+        debug_log_error("Benchmark: camera path %s incomplete", g_bench.path_file);
+        return GAUSSIAN_ERROR_FILE_WRITE_FAILED;
+    }
+    printf("SPLATSTORM X: Camera path saved to %s (%u frames)\n", g_bench.path_file, g_bench.frame);
+    return GAUSSIAN_SUCCESS;
+}
+
+static GaussianResult benchmark_write_csv(void) {
+    if (iop_require_path(g_bench.csv_file) < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    FILE* file = fopen(g_bench.csv_file, "w");
+    if (!file) {
+        debug_log_error("Benchmark: cannot write %s", g_bench.csv_file);
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+
+    fprintf(file, "frame,frame_ms,render_ms,cull_ms,vu_ms,tile_ms,gs_ms,visible,projected,lod,rendered,"
+                  "vu0_busy_ms,vu1_busy_ms,vu1_gap_ms\n");
+    for (u32 i = 0; i < g_bench.frame; i++) {
+        const BenchmarkSample* sample = &g_bench.samples[i];
+        fprintf(file, "%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%u,%u,%u,%.3f,%.3f,%.3f\n", i,
+                cycles_to_ms(sample->frame_cycles), cycles_to_ms(sample->render_cycles),
+                cycles_to_ms(sample->cull_cycles), cycles_to_ms(sample->vu_cycles),
+                cycles_to_ms(sample->tile_cycles), cycles_to_ms(sample->gs_cycles),
+                sample->visible_splats, sample->projected_splats, sample->lod_splats, sample->rendered_splats,
+                cycles_to_ms(sample->vu_busy_cycles[VU_UNIT_VU0]), cycles_to_ms(sample->vu_busy_cycles[VU_UNIT_VU1]),
+                cycles_to_ms(sample->vu1_gap_cycles));
+    }
+    fclose(file);
+
+    printf("SPLATSTORM X: Benchmark frames written to %s\n", g_bench.csv_file);
+    return GAUSSIAN_SUCCESS;
+}
+
+static int benchmark_compare_u32(const void* a, const void* b) {
+    u32 x = *(const u32*)a;
+    u32 y = *(const u32*)b;
+    return (x > y) - (x < y);
+}
+
+static float benchmark_percentile(u32 count, u32 percent) {
+    return cycles_to_ms(g_bench_sorted[(count * percent + 99) / 100 - 1]);
+}
+
+static void benchmark_print_summary(void) {
+    u32 count = g_bench.frame;
+    u64 totals[6] = {0};
+    u64 visible = 0, rendered = 0;
+    u64 vu_busy[2] = {0};
+    for (u32 i = 0; i < count; i++) {
+        const BenchmarkSample* sample = &g_bench.samples[i];
+        g_bench_sorted[i] = sample->frame_cycles;
+        totals[0] += sample->frame_cycles;
+        totals[1] += sample->render_cycles;
+        totals[2] += sample->cull_cycles;
+        totals[3] += sample->vu_cycles;
+        totals[4] += sample->tile_cycles;
+        totals[5] += sample->gs_cycles;
+        visible += sample->visible_splats;
+        rendered += sample->rendered_splats;
+        vu_busy[VU_UNIT_VU0] += sample->vu_busy_cycles[VU_UNIT_VU0];
+        vu_busy[VU_UNIT_VU1] += sample->vu_busy_cycles[VU_UNIT_VU1];
+    }
+    qsort(g_bench_sorted, count, sizeof(u32), benchmark_compare_u32);
+
+    float seconds = cycles_to_ms(totals[0]) / 1000.0f;
+    printf("\n=== SPLATSTORM X BENCHMARK (%s, built %s %s) ===\n",
+           g_bench.mode == BENCHMARK_REPLAY ? "replay" : "record", __DATE__, __TIME__);
+    printf("Path: %s, %u frames in %.2f s, %.2f fps\n", g_bench.path_file, count, seconds,
+           seconds > 0.0f ? count / seconds : 0.0f);
+    printf("Frame ms: min %.2f avg %.2f p50 %.2f p95 %.2f p99 %.2f max %.2f\n",
+           cycles_to_ms(g_bench_sorted[0]), cycles_to_ms(totals[0]) / count, benchmark_percentile(count, 50),
+           benchmark_percentile(count, 95), benchmark_percentile(count, 99), cycles_to_ms(g_bench_sorted[count - 1]));
+    printf("Stage avg ms: Render %.2f, Cull %.2f, VU %.2f, Tile %.2f, GS %.2f\n",
+           cycles_to_ms(totals[1]) / count, cycles_to_ms(totals[2]) / count, cycles_to_ms(totals[3]) / count,
+           cycles_to_ms(totals[4]) / count, cycles_to_ms(totals[5]) / count);
+    printf("Splats avg: %llu visible, %llu rendered\n", visible / count, rendered / count);
+    if (vu_activity_running() && totals[0] > 0) {
+        printf("VU busy (sampled): VU0 %.1f%%, VU1 %.1f%% of frame time\n",
+               vu_busy[VU_UNIT_VU0] * 100.0f / totals[0], vu_busy[VU_UNIT_VU1] * 100.0f / totals[0]);
+    }
+    printf("===============================\n\n");
+}
+
+/*
+ * End the run: save a recorded path, write the CSV, print the summary and
+ * free the buffers. Safe to call when no run is active.
+ */
+GaussianResult benchmark_finish(void) {
+    GaussianResult result = GAUSSIAN_SUCCESS;
+
+    if (g_bench.started && g_bench.frame > 0) {
+        if (g_bench.mode == BENCHMARK_RECORD) {
+            result = benchmark_save_path();
+        }
+        GaussianResult csv_result = benchmark_write_csv();
+        if (result == GAUSSIAN_SUCCESS) {
+            result = csv_result;
+        }
+        benchmark_print_summary();
+    }
+
+    if (g_bench.poses) memory_free(g_bench.poses);
+    if (g_bench.samples) memory_free(g_bench.samples);
+    g_bench.poses = NULL;
+    g_bench.samples = NULL;
+    g_bench.started = false;
+    return result;
+}
@@ -8,7 +8,9 @@
  * - View and projection matrix computation
  * - Quaternion-based rotation
  * - Look-at and FPS-style camera controls
- * - Frustum extraction for culling
+ * - Cached view-projection, inverse and frustum, rebuilt only when dirty
+ * - Per-frame "camera changed" signal for culling, sorting and tiling
+ * - Padded cull frustum for a camera latched again before projection
  * - Smooth interpolation and constraints
  */
 
@@ -35,9 +37,12 @@ static fixed16_t g_camera_near_plane;
 static fixed16_t g_camera_far_plane;
 static bool g_camera_matrices_dirty = true;
 static bool g_camera_initialized = false;
+static u32 g_camera_revision = 0;          // Bumped each time the matrices are rebuilt
+static u32 g_camera_frame_revision = 0;    // Revision seen by the last camera_begin_frame
 
 // Forward declarations
-static void frustum_normalize_planes(Frustum* frustum);
+static void camera_invert_view_proj_fixed(CameraFixed* camera);
+static void camera_cache_frustum_fixed(CameraFixed* camera);
 
 // Camera system constants
 #define DEFAULT_FOV         fixed_from_float(60.0f * M_PI / 180.0f)  // 60 degrees in radians
@@ -147,11 +152,14 @@ void camera_init_fixed(void* camera_ptr) {
     memset(camera->view, 0, sizeof(camera->view));
     memset(camera->proj, 0, sizeof(camera->proj));
     memset(camera->view_proj, 0, sizeof(camera->view_proj));
+    memset(camera->inv_view_proj, 0, sizeof(camera->inv_view_proj));
     
     // Set identity matrices
     camera->view[0] = camera->view[5] = camera->view[10] = camera->view[15] = FIXED16_SCALE;
     camera->proj[0] = camera->proj[5] = camera->proj[10] = camera->proj[15] = FIXED16_SCALE;
     camera->view_proj[0] = camera->view_proj[5] = camera->view_proj[10] = camera->view_proj[15] = FIXED16_SCALE;
+    camera->inv_view_proj[0] = camera->inv_view_proj[5] = camera->inv_view_proj[10] = camera->inv_view_proj[15] = FIXED16_SCALE;
+    camera->moved_significantly = true;
     
     g_camera_matrices_dirty = true;
     g_camera_initialized = true;
@@ -168,6 +176,16 @@ void camera_set_position_fixed(void* camera_ptr, float x, float y, float z) {
     g_camera_matrices_dirty = true;
 }
 
+// Set position and rotation quaternion bit for bit, e.g. from a recorded path
+void camera_set_pose_fixed(void* camera_ptr, const fixed16_t position[3], const fixed16_t rotation[4]) {
+    CameraFixed* camera = (CameraFixed*)camera_ptr;
+    if (!camera || !position || !rotation) return;
+    
+    memcpy(camera->position, position, sizeof(camera->position));
+    memcpy(camera->rotation, rotation, sizeof(camera->rotation));
+    g_camera_matrices_dirty = true;
+}
+
 // Set camera target
 void camera_set_target_fixed(void* camera_ptr, float x, float y, float z) {
     CameraFixed* camera = (CameraFixed*)camera_ptr;
@@ -355,23 +373,29 @@ void camera_update_view_matrix_fixed(CameraFixed* camera) {
 }
 
 // Update projection matrix
+// Built in float and converted once: only runs when the camera is dirty, and
+// 1 / (far - near) is below what the Q16.16 reciprocal resolves
 void camera_update_projection_matrix_fixed(CameraFixed* camera) {
     if (!camera) return;
     
     // Perspective projection matrix
-    fixed16_t f = fixed_mul(FIXED16_SCALE, fixed_recip_newton(fixed_from_float(tanf(fixed_to_float(g_camera_fov) * 0.5f))));
-    fixed16_t near_far_diff = g_camera_far_plane - g_camera_near_plane;
+    float f = 1.0f / tanf(fixed_to_float(g_camera_fov) * 0.5f);
+    float near_plane = fixed_to_float(g_camera_near_plane);
+    float far_plane = fixed_to_float(g_camera_far_plane);
+    float inv_depth = 1.0f / (far_plane - near_plane);
     
     memset(camera->proj, 0, sizeof(camera->proj));
     
-    camera->proj[0] = fixed_mul(f, fixed_recip_newton(g_camera_aspect));  // f/aspect
-    camera->proj[5] = f;                             // f
-    camera->proj[10] = -fixed_mul(g_camera_far_plane + g_camera_near_plane, fixed_recip_newton(near_far_diff));
-    camera->proj[11] = -FIXED16_SCALE;               // -1
-    camera->proj[14] = -fixed_mul(fixed_mul(fixed_from_float(2.0f), fixed_mul(g_camera_far_plane, g_camera_near_plane)), fixed_recip_newton(near_far_diff));
+    camera->proj[0] = fixed_from_float(f / fixed_to_float(g_camera_aspect));  // f/aspect
+    camera->proj[5] = fixed_from_float(f);                                     // f
+    camera->proj[10] = fixed_from_float(-(far_plane + near_plane) * inv_depth);
+    camera->proj[11] = -FIXED16_SCALE;                                         // -1
+    camera->proj[14] = fixed_from_float(-2.0f * far_plane * near_plane * inv_depth);
 }
 
 // Update all matrices
+// View, projection, their product, its inverse and the frustum planes are
+// cached in the camera and only rebuilt after something marked them dirty.
 void camera_update_matrices_fixed(void* camera_ptr) {
     CameraFixed* camera = (CameraFixed*)camera_ptr;
     if (!camera) {
@@ -385,79 +409,128 @@ void camera_update_matrices_fixed(void* camera_ptr) {
     // Update projection matrix
     camera_update_projection_matrix_fixed(camera);
     
-    // Update combined view-projection matrix
-    matrix_multiply_4x4_fixed(camera->proj, camera->view, camera->view_proj);
+    // Row vectors (translation in m[12..14]): clip = p * view * proj
+    matrix_multiply_4x4_fixed(camera->view, camera->proj, camera->view_proj);
+    camera_invert_view_proj_fixed(camera);
+    camera_cache_frustum_fixed(camera);
     
+    g_camera_revision++;
     g_camera_matrices_dirty = false;
 }
 
-// Extract frustum planes from view-projection matrix
-void camera_extract_frustum_fixed(void* camera_ptr, Frustum* frustum) {
+// Latch the per-frame camera signal
+// Brings the cached matrices up to date and sets camera->moved_significantly
+// when they changed since the previous call. Returns the same flag.
+bool camera_begin_frame(void* camera_ptr) {
     CameraFixed* camera = (CameraFixed*)camera_ptr;
     if (!camera) {
         camera = &g_camera;
     }
-    if (!frustum) return;
     
+    camera_update_matrices_fixed(camera);
+    
+    camera->moved_significantly = (g_camera_revision != g_camera_frame_revision);
+    g_camera_frame_revision = g_camera_revision;
+    
+    return camera->moved_significantly;
+}
+
+// Copy of the camera for culling, its view-projection and frustum widened
+// so clip x and y may reach (1 + margin) * w. Covers a camera that still
+// turns a little between the cull and projection; the copy's inverse is
+// left as it was.
+void camera_pad_frustum_fixed(const CameraFixed* camera, float margin, CameraFixed* padded) {
+    if (!camera || !padded) return;
+
+    *padded = *camera;
+    float scale = 1.0f / (1.0f + margin);
+    for (int j = 0; j < 4; j++) {
+        padded->view_proj[j * 4 + 0] = fixed_from_float(fixed_to_float(camera->view_proj[j * 4 + 0]) * scale);
+        padded->view_proj[j * 4 + 1] = fixed_from_float(fixed_to_float(camera->view_proj[j * 4 + 1]) * scale);
+    }
+    camera_cache_frustum_fixed(padded);
+}
+
+// Inverse view-projection: proj^-1 * view^-1, both inverted in closed form
+// (rigid view, perspective projection) instead of a general Q16.16 inversion
+static void camera_invert_view_proj_fixed(CameraFixed* camera) {
+    const fixed16_t* v = camera->view;
+    const fixed16_t* p = camera->proj;
+    float inv_view[16];
+    float inv_proj[16];
+    
+    // View = [R 0; t 1]  ->  [R^T 0; -t R^T 1]
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            inv_view[i * 4 + j] = fixed_to_float(v[j * 4 + i]);
+        }
+        inv_view[i * 4 + 3] = 0.0f;
+    }
+    for (int j = 0; j < 3; j++) {
+        inv_view[12 + j] = -(fixed_to_float(v[12]) * inv_view[0 * 4 + j] +
+                             fixed_to_float(v[13]) * inv_view[1 * 4 + j] +
+                             fixed_to_float(v[14]) * inv_view[2 * 4 + j]);
+    }
+    inv_view[15] = 1.0f;
+    
+    // Perspective rows (a 0 0 0), (0 b 0 0), (0 0 c -1), (0 0 d 0)
+    float a = fixed_to_float(p[0]), b = fixed_to_float(p[5]);
+    float c = fixed_to_float(p[10]), d = fixed_to_float(p[14]);
+    memset(inv_proj, 0, sizeof(inv_proj));
+    inv_proj[0] = (a != 0.0f) ? 1.0f / a : 0.0f;
+    inv_proj[5] = (b != 0.0f) ? 1.0f / b : 0.0f;
+    inv_proj[11] = (d != 0.0f) ? 1.0f / d : 0.0f;
+    inv_proj[14] = -1.0f;
+    inv_proj[15] = c * inv_proj[11];
+    
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += inv_proj[i * 4 + k] * inv_view[k * 4 + j];
+            }
+            camera->inv_view_proj[i * 4 + j] = fixed_from_float(sum);
+        }
+    }
+}
+
+// Cache normalized frustum planes (normal xyz, distance) from view_proj
+static void camera_cache_frustum_fixed(CameraFixed* camera) {
     const fixed16_t* m = camera->view_proj;
     
-    // Extract frustum planes from view-projection matrix
-    // Left plane
-    frustum->planes[0][0] = m[3] + m[0];   // A
-    frustum->planes[0][1] = m[7] + m[4];   // B
-    frustum->planes[0][2] = m[11] + m[8];  // C
-    frustum->planes[0][3] = m[15] + m[12]; // D
-    
-    // Right plane
-    frustum->planes[1][0] = m[3] - m[0];
-    frustum->planes[1][1] = m[7] - m[4];
-    frustum->planes[1][2] = m[11] - m[8];
-    frustum->planes[1][3] = m[15] - m[12];
-    
-    // Bottom plane
-    frustum->planes[2][0] = m[3] + m[1];
-    frustum->planes[2][1] = m[7] + m[5];
-    frustum->planes[2][2] = m[11] + m[9];
-    frustum->planes[2][3] = m[15] + m[13];
-    
-    // Top plane
-    frustum->planes[3][0] = m[3] - m[1];
-    frustum->planes[3][1] = m[7] - m[5];
-    frustum->planes[3][2] = m[11] - m[9];
-    frustum->planes[3][3] = m[15] - m[13];
-    
-    // Near plane
-    frustum->planes[4][0] = m[3] + m[2];
-    frustum->planes[4][1] = m[7] + m[6];
-    frustum->planes[4][2] = m[11] + m[10];
-    frustum->planes[4][3] = m[15] + m[14];
-    
-    // Far plane
-    frustum->planes[5][0] = m[3] - m[2];
-    frustum->planes[5][1] = m[7] - m[6];
-    frustum->planes[5][2] = m[11] - m[10];
-    frustum->planes[5][3] = m[15] - m[14];
-    
-    // Normalize planes
-    frustum_normalize_planes(frustum);
+    // Column 3 +/- columns 0-2: left, right, bottom, top, near, far
+    for (int i = 0; i < 6; i++) {
+        int column = i / 2;
+        float sign = (i & 1) ? -1.0f : 1.0f;
+        float plane[4];
+        
+        for (int j = 0; j < 4; j++) {
+            plane[j] = fixed_to_float(m[j * 4 + 3]) + sign * fixed_to_float(m[j * 4 + column]);
+        }
+        
+        float length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        float inv_length = (length > 0.0f) ? 1.0f / length : 1.0f;
+        
+        for (int j = 0; j < 4; j++) {
+            camera->frustum[i][j] = fixed_from_float(plane[j] * inv_length);
+        }
+    }
 }
 
-// Normalize frustum planes
-static void frustum_normalize_planes(Frustum* frustum) {
+// Extract frustum planes from view-projection matrix
+// Served from the cached planes; nothing is recomputed while the camera is still
+void camera_extract_frustum_fixed(void* camera_ptr, Frustum* frustum) {
+    CameraFixed* camera = (CameraFixed*)camera_ptr;
+    if (!camera) {
+        camera = &g_camera;
+    }
     if (!frustum) return;
     
+    camera_update_matrices_fixed(camera);
+    
     for (int i = 0; i < 6; i++) {
-        float* plane = frustum->planes[i];
-        float length = sqrtf(plane[0] * plane[0] + 
-                            plane[1] * plane[1] + 
-                            plane[2] * plane[2]);
-        
-        if (length > 0.0f) {
-            float inv_length = 1.0f / length;
-            plane[0] *= inv_length;
-            plane[1] *= inv_length;
-            plane[2] *= inv_length;
-            plane[3] *= inv_length;
+        for (int j = 0; j < 4; j++) {
+            frustum->planes[i][j] = fixed_to_float(camera->frustum[i][j]);
         }
     }
 }
@@ -546,6 +619,10 @@ void camera_update_input(pad_state_t* pad, float delta_time) {
     if (g_camera.rotation[0] < min_pitch) g_camera.rotation[0] = min_pitch;
     
     // Update camera matrices after input changes
+    if (pad->buttons & (PAD_UP | PAD_DOWN | PAD_LEFT | PAD_RIGHT) ||
+        yaw_delta != 0 || pitch_delta != 0) {
+        g_camera_matrices_dirty = true;
+    }
     camera_update_matrices_fixed(&g_camera);
 }
 
@@ -586,4 +663,19 @@ float* camera_get_proj_matrix(void) {
     }
     
     return proj_matrix_float;
-}
\ No newline at end of file
+}
+
+float* camera_get_view_proj_matrix(void) {
+    static float view_proj_matrix_float[16];
+    
+    if (!g_camera_initialized) {
+        return NULL;
+    }
+    
+    // Convert fixed-point to float
+    for (int i = 0; i < 16; i++) {
+        view_proj_matrix_float[i] = fixed_to_float(g_camera.view_proj[i]);
+    }
+    
+    return view_proj_matrix_float;
+}
@@ -9,8 +9,11 @@
  * - Double buffering for continuous data streaming
  * - Chain DMA for large transfers without CPU intervention
  * - Scratchpad memory utilization for hot data
+ * - Double-buffered scratchpad streaming (toSPR) for EE hot loops
  * - Bandwidth optimization with burst transfers
  * - Cache-aligned memory management
+ * - Channel end interrupts: waits sleep on a semaphore instead of spinning
+ * - Per-frame bytes, transfers and wait cycles for VIF0, VIF1, GIF and SPR
  * - Performance profiling and bandwidth monitoring
  */
 
@@ -56,10 +59,12 @@ static dma_handler_t g_dma_handlers[DMA_CHANNEL_COUNT] = {NULL};
 #define DMA_FLAG_INTERRUPT    0x0001
 #define DMA_FLAG_CHAIN_MODE   0x0002
 
-// DMA tag constants
-#define DMA_TAG_NEXT 0x0                      // Continue to next entry
-#define DMA_TAG_REF  0x1                      // Reference mode
-#define DMA_TAG_END  0x7                      // End of chain
+// DMA tag IDs (source chain mode)
+#define DMA_TAG_REFE 0x0                      // Reference, end of chain
+#define DMA_TAG_CNT  0x1                      // Data follows tag
+#define DMA_TAG_NEXT 0x2                      // Data follows tag, next tag at ADDR
+#define DMA_TAG_REF  0x3                      // Reference data at ADDR
+#define DMA_TAG_END  0x7                      // Data follows tag, end of chain
 
 // VIF mode constants
 #define VIF_MODE_NORMAL 0x0                   // Normal VIF mode
@@ -92,6 +97,8 @@ static dma_handler_t g_dma_handlers[DMA_CHANNEL_COUNT] = {NULL};
 // Missing constants
 #define VU1_CONSTANTS_BASE    0x3F0
 #define GIF_FLG_PACKED        0x00
+#define GIF_FLG_REGLIST       0x01
+#define GIF_MAX_NLOOP         0x7FFF
 // Note: DMA_TAG_END and DMA_TAG_NEXT already defined above
 
 
@@ -134,6 +141,11 @@ static inline int dma_channel_busy(int channel) {
 static inline u64 create_gif_tag(u32 nloop, u32 eop, u32 pre, u32 prim, u32 flg, u32 nreg) {
     return (u64)nloop | ((u64)eop << 15) | ((u64)pre << 46) | ((u64)prim << 47) | ((u64)flg << 58) | ((u64)nreg << 60);
 }
+
+// Sprite register list: RGBAQ, UV, XYZ2, UV, XYZ2
+#define GS_SPRITE_REGLIST_NREG 5
+#define GS_SPRITE_REGLIST_REGS ((u64)GS_RGBAQ | ((u64)GS_UV << 4) | ((u64)GS_XYZ2 << 8) | \
+                                ((u64)GS_UV << 12) | ((u64)GS_XYZ2 << 16))
 #define VIF_MSCNT       0x15
 #define VIF_MSCALF      0x16
 #define VIF_STMASK      0x20
@@ -168,12 +180,12 @@ typedef struct {
     u64 last_flush_cycles;                    // Last flush timestamp
 } DMABuffer;
 
-// Chain DMA entry
+// Chain DMA entry (one qword, laid out as the hardware source-chain tag)
 typedef struct {
-    u32 addr;                                 // Source address
+    u32 dma_tag;                              // Tag low word: QWC | ID << 28 (built on execute)
+    u32 addr;                                 // Source address (tag ADDR field)
     u32 size;                                 // Transfer size in qwords
-    u32 tag;                                  // DMA tag
-    u32 padding;                              // Alignment padding
+    u32 tag;                                  // DMA tag ID
 } ChainDMAEntry;
 
 // DMA system state
@@ -197,6 +209,7 @@ typedef struct {
     u32 chain_count;                          // Number of chain entries
     u32 chain_capacity;                       // Chain capacity
     u32 active_channel;                       // Currently active DMA channel
+    bool chain_in_flight;                     // Tag list may still be read by the DMAC
     
     // VIF/GIF modes
     u32 vif_mode;                             // VIF transfer mode
@@ -214,6 +227,16 @@ typedef struct {
     u32 cache_hits;                           // Cache hits
     u32 cache_misses;                         // Cache misses
     u32 cache_flushes;                        // Cache flushes performed
+    
+    // End-of-transfer interrupts, installed for DMA_COMPLETION_CHANNELS
+    s32 completion_sema[DMA_CHANNEL_COUNT];   // Signalled at each channel end, -1 = none
+    s32 completion_handler[DMA_CHANNEL_COUNT];// DMAC handler id, -1 = waits spin
+    volatile u32 completion_count[DMA_CHANNEL_COUNT];  // End interrupts taken
+    u64 completion_wait_cycles[DMA_CHANNEL_COUNT];     // EE time spent asleep in waits
+    
+    // Per-channel traffic, this frame so far and the last completed one
+    DMAChannelStats frame_stats;
+    DMAChannelStats last_frame_stats;
 } DMASystemState;
 
 // Forward declarations
@@ -221,6 +244,155 @@ GaussianResult dma_flush_buffer(DMABuffer* buffer, u32 channel);
 
 static DMASystemState g_dma_state = {0};
 
+// Channels the render path waits on; the rest keep the kernel's default
+static const int g_dma_completion_channels[] = { DMA_CHANNEL_VIF0, DMA_CHANNEL_VIF1, DMA_CHANNEL_GIF };
+#define DMA_COMPLETION_CHANNELS (sizeof(g_dma_completion_channels) / sizeof(g_dma_completion_channels[0]))
+
+// DMAStatsChannel of each DMAC channel, -1 for the channels nothing here drives
+static const s8 g_dma_stats_group[DMA_CHANNEL_COUNT] = {
+    DMA_STATS_VIF0, DMA_STATS_VIF1, DMA_STATS_GIF, -1, -1, -1, -1, -1, DMA_STATS_SPR, DMA_STATS_SPR
+};
+
+// Channel end interrupt: wake the waiting thread, then run the callback
+// registered through dma_set_completion_callback(), in interrupt context
+static int dma_completion_handler(int channel) {
+    g_dma_state.completion_count[channel]++;
+    iSignalSema(g_dma_state.completion_sema[channel]);
+    if (g_dma_handlers[channel]) {
+        g_dma_handlers[channel](channel);
+    }
+    ExitHandler();
+    return 0;
+}
+
+static void dma_completion_install(void) {
+    for (int channel = 0; channel < DMA_CHANNEL_COUNT; channel++) {
+        g_dma_state.completion_sema[channel] = -1;
+        g_dma_state.completion_handler[channel] = -1;
+    }
+    
+    u32 installed = 0;
+    for (u32 i = 0; i < DMA_COMPLETION_CHANNELS; i++) {
+        int channel = g_dma_completion_channels[i];
+        ee_sema_t sema;
+        memset(&sema, 0, sizeof(sema));
+        sema.init_count = 0;
+        sema.max_count = 1;
+        g_dma_state.completion_sema[channel] = CreateSema(&sema);
+        if (g_dma_state.completion_sema[channel] < 0) {
+            continue;
+        }
+        
+        g_dma_state.completion_handler[channel] = AddDmacHandler(channel, dma_completion_handler, 0);
+        if (g_dma_state.completion_handler[channel] < 0) {
+            DeleteSema(g_dma_state.completion_sema[channel]);
+            g_dma_state.completion_sema[channel] = -1;
+            continue;
+        }
+        EnableDmac(channel);
+        installed++;
+    }
+    
+    printf("SPLATSTORM X: DMA end interrupts on %u of %u channels\n", installed, (u32)DMA_COMPLETION_CHANNELS);
+}
+
+static void dma_completion_remove(void) {
+    for (u32 i = 0; i < DMA_COMPLETION_CHANNELS; i++) {
+        int channel = g_dma_completion_channels[i];
+        if (g_dma_state.completion_handler[channel] >= 0) {
+            DisableDmac(channel);
+            RemoveDmacHandler(channel, g_dma_state.completion_handler[channel]);
+        }
+        if (g_dma_state.completion_sema[channel] >= 0) {
+            DeleteSema(g_dma_state.completion_sema[channel]);
+        }
+        g_dma_state.completion_handler[channel] = -1;
+        g_dma_state.completion_sema[channel] = -1;
+    }
+}
+
+// Block until a channel is idle. With its end interrupt installed the
+// thread sleeps and lower-priority threads run; otherwise it spins on
+// CHCR STR. The loop re-reads STR, so a count left over from an earlier
+// transfer only costs one extra pass.
+void dma_wait_channel(int channel) {
+    if (channel < 0 || channel >= DMA_CHANNEL_COUNT || !dma_channel_status(channel)) {
+        return;
+    }
+    
+    u64 wait_start = get_cpu_cycles();
+    if (!g_dma_state.initialized || g_dma_state.completion_handler[channel] < 0) {
+        while (dma_channel_status(channel)) {
+            __asm__ volatile("nop");
+        }
+    } else {
+        while (dma_channel_status(channel)) {
+            WaitSema(g_dma_state.completion_sema[channel]);
+        }
+        g_dma_state.completion_wait_cycles[channel] += get_cpu_cycles() - wait_start;
+    }
+    dma_account_wait(channel, (u32)(get_cpu_cycles() - wait_start));
+}
+
+// Run callback from the end interrupt of a channel, NULL to clear. It
+// runs in interrupt context: only i-prefixed kernel calls, and keep it short.
+void dma_set_completion_callback(int channel, void (*callback)(int channel)) {
+    if (channel < 0 || channel >= DMA_CHANNEL_COUNT) {
+        return;
+    }
+    g_dma_handlers[channel] = callback;
+}
+
+// End interrupts taken and EE cycles slept waiting for a channel
+void dma_get_completion_stats(int channel, u32* completions, u64* wait_cycles) {
+    bool valid = channel >= 0 && channel < DMA_CHANNEL_COUNT;
+    if (completions) *completions = valid ? g_dma_state.completion_count[channel] : 0;
+    if (wait_cycles) *wait_cycles = valid ? g_dma_state.completion_wait_cycles[channel] : 0;
+}
+
+// Charge a send of bytes to a DMAC channel's group for this frame
+void dma_account_transfer(int channel, u32 bytes) {
+    if (channel < 0 || channel >= DMA_CHANNEL_COUNT || g_dma_stats_group[channel] < 0) {
+        return;
+    }
+    g_dma_state.frame_stats.bytes[g_dma_stats_group[channel]] += bytes;
+    g_dma_state.frame_stats.transfers[g_dma_stats_group[channel]]++;
+}
+
+// Charge EE cycles blocked on a DMAC channel to its group for this frame
+void dma_account_wait(int channel, u32 cycles) {
+    if (channel < 0 || channel >= DMA_CHANNEL_COUNT || g_dma_stats_group[channel] < 0) {
+        return;
+    }
+    g_dma_state.frame_stats.wait_cycles[g_dma_stats_group[channel]] += cycles;
+}
+
+// Close the frame's accounting; call once per main loop pass
+void dma_stats_end_frame(void) {
+    g_dma_state.last_frame_stats = g_dma_state.frame_stats;
+    memset(&g_dma_state.frame_stats, 0, sizeof(g_dma_state.frame_stats));
+}
+
+// Traffic of the last completed frame
+void dma_get_channel_stats(DMAChannelStats* stats) {
+    if (stats) {
+        *stats = g_dma_state.last_frame_stats;
+    }
+}
+
+const char* dma_stats_channel_name(DMAStatsChannel channel) {
+    static const char* names[DMA_STATS_CHANNELS] = { "VIF0", "VIF1", "GIF", "SPR" };
+    return (u32)channel < DMA_STATS_CHANNELS ? names[channel] : "?";
+}
+
+// dma_channel_wait, with the time it took charged to the channel
+static int dma_timed_channel_wait(int channel, int timeout) {
+    u64 wait_start = get_cpu_cycles();
+    int result = dma_channel_wait(channel, timeout);
+    dma_account_wait(channel, (u32)(get_cpu_cycles() - wait_start));
+    return result;
+}
+
 // Performance monitoring
 // COMPLETE IMPLEMENTATION - Use centralized performance counter
 // Removed static inline version, using performance_counters.c implementation
@@ -247,7 +419,7 @@ GaussianResult dma_system_init(void) {
     for (int i = 0; i < 2; i++) {
         // Upload buffers
         g_dma_state.upload_buffers[i].capacity = DMA_BUFFER_SIZE;
-        g_dma_state.upload_buffers[i].data = (u64*)memalign(DMA_ALIGNMENT, DMA_BUFFER_SIZE);
+        g_dma_state.upload_buffers[i].data = (u64*)memory_alloc(MEMORY_BUDGET_DMA, DMA_BUFFER_SIZE, DMA_ALIGNMENT);
         g_dma_state.upload_buffers[i].size = DMA_BUFFER_SIZE;
         g_dma_state.upload_buffers[i].used = 0;
         g_dma_state.upload_buffers[i].in_use = false;
@@ -255,7 +427,7 @@ GaussianResult dma_system_init(void) {
         
         // Download buffers
         g_dma_state.download_buffers[i].capacity = DMA_BUFFER_SIZE;
-        g_dma_state.download_buffers[i].data = (u64*)memalign(DMA_ALIGNMENT, DMA_BUFFER_SIZE);
+        g_dma_state.download_buffers[i].data = (u64*)memory_alloc(MEMORY_BUDGET_DMA, DMA_BUFFER_SIZE, DMA_ALIGNMENT);
         g_dma_state.download_buffers[i].size = DMA_BUFFER_SIZE;
         g_dma_state.download_buffers[i].used = 0;
         g_dma_state.download_buffers[i].in_use = false;
@@ -263,7 +435,7 @@ GaussianResult dma_system_init(void) {
         
         // GS buffers
         g_dma_state.gs_buffers[i].capacity = DMA_BUFFER_SIZE;
-        g_dma_state.gs_buffers[i].data = (u64*)memalign(DMA_ALIGNMENT, DMA_BUFFER_SIZE);
+        g_dma_state.gs_buffers[i].data = (u64*)memory_alloc(MEMORY_BUDGET_DMA, DMA_BUFFER_SIZE, DMA_ALIGNMENT);
         g_dma_state.gs_buffers[i].size = DMA_BUFFER_SIZE;
         g_dma_state.gs_buffers[i].used = 0;
         g_dma_state.gs_buffers[i].in_use = false;
@@ -283,8 +455,8 @@ GaussianResult dma_system_init(void) {
     
     // Initialize chain DMA
     g_dma_state.chain_capacity = MAX_CHAIN_ENTRIES;
-    g_dma_state.chain_entries = (ChainDMAEntry*)memalign(DMA_ALIGNMENT, 
-                                                        MAX_CHAIN_ENTRIES * sizeof(ChainDMAEntry));
+    g_dma_state.chain_entries = (ChainDMAEntry*)memory_alloc(MEMORY_BUDGET_DMA,
+                                                        MAX_CHAIN_ENTRIES * sizeof(ChainDMAEntry), DMA_ALIGNMENT);
     g_dma_state.chain_count = 0;
     
     if (!g_dma_state.chain_entries) {
@@ -308,6 +480,8 @@ GaussianResult dma_system_init(void) {
     g_dma_state.cache_misses = 0;
     g_dma_state.cache_flushes = 0;
     
+    dma_completion_install();
+    
     g_dma_state.initialized = true;
     
     printf("SPLATSTORM X: DMA system initialized (buffers: %u KB each)\n", 
@@ -551,66 +725,67 @@ u32 dma_build_constants_packet(DMABuffer* buffer, const CameraFixed* camera) {
     return qword_count;
 }
 
-// Build GS packet for rendering
+// Build GS packet for rendering: PRIM through one A+D write, then every
+// sprite as RGBAQ, UV, XYZ2, UV, XYZ2 under a single REGLIST tag
 u32 dma_build_gs_packet(DMABuffer* buffer, const GaussianSplat2D* splats, u32 splat_count) {
     if (!buffer || !splats || splat_count == 0) return 0;
     
+    // Two tags, the PRIM write and five words per sprite
+    u32 capacity_words = buffer->size / 8;
+    if (splat_count > GIF_MAX_NLOOP || 6 + splat_count * GS_SPRITE_REGLIST_NREG + 1 > capacity_words) {
+        return 0;
+    }
+    
     u64* packet = buffer->data;
-    u32 qword_count = 0;
     
-    // GIF header
-    packet[qword_count++] = create_gif_tag(splat_count, 1, 0, 0, GIF_FLG_PACKED, 1);
-    packet[qword_count++] = GIF_AD;
+    // PRIM first: the tag PRIM field is only honoured in PACKED mode
+    packet[0] = create_gif_tag(1, 0, 0, 0, GIF_FLG_PACKED, 1);
+    packet[1] = GIF_AD;
+    packet[2] = GS_SET_PRIM(SPLATSTORM_GS_PRIM_SPRITE, 0, 1, 0, 1, 0, 1, 0, 0);
+    packet[3] = GS_PRIM;
     
-    // Render each splat as a textured quad
+    u32 word_count = 6;
+    u32 sprite_count = 0;
     for (u32 i = 0; i < splat_count; i++) {
         const GaussianSplat2D* splat = &splats[i];
         
         // Skip degenerate splats
         if (splat->radius <= 0) continue;
         
-        // Set texture coordinates and color
         fixed16_t cx = splat->screen_pos[0];
         fixed16_t cy = splat->screen_pos[1];
         fixed16_t radius = splat->radius;
         
-        // Compute quad vertices
-        fixed16_t x1 = fixed_sub(cx, radius);
-        fixed16_t y1 = fixed_sub(cy, radius);
-        fixed16_t x2 = fixed_add(cx, radius);
-        fixed16_t y2 = fixed_add(cy, radius);
-        
-        // Convert to GS coordinates (4096 scale)
-        u16 gs_x1 = (u16)(fixed_to_int(x1) << 4);
-        u16 gs_y1 = (u16)(fixed_to_int(y1) << 4);
-        u16 gs_x2 = (u16)(fixed_to_int(x2) << 4);
-        u16 gs_y2 = (u16)(fixed_to_int(y2) << 4);
-        
-        // Sprite primitive
-        packet[qword_count++] = GS_SET_PRIM(SPLATSTORM_GS_PRIM_SPRITE, 0, 1, 0, 1, 0, 1, 0, 0);
-        packet[qword_count++] = GS_PRIM;
-        
-        // Color
-        packet[qword_count++] = GS_SET_RGBAQ(splat->color[0], splat->color[1], 
-                                           splat->color[2], splat->color[3], 0);
-        packet[qword_count++] = GS_RGBAQ;
-        
-        // Texture coordinates and vertices
-        packet[qword_count++] = GS_SET_UV(0, 0);  // UV for LUT lookup
-        packet[qword_count++] = GS_UV;
-        
-        packet[qword_count++] = GS_SET_XYZ2(gs_x1, gs_y1, 0);
-        packet[qword_count++] = GS_XYZ2;
+        // Convert the quad corners to GS coordinates (4096 scale)
+        u16 gs_x1 = (u16)(fixed_to_int(fixed_sub(cx, radius)) << 4);
+        u16 gs_y1 = (u16)(fixed_to_int(fixed_sub(cy, radius)) << 4);
+        u16 gs_x2 = (u16)(fixed_to_int(fixed_add(cx, radius)) << 4);
+        u16 gs_y2 = (u16)(fixed_to_int(fixed_add(cy, radius)) << 4);
         
-        packet[qword_count++] = GS_SET_UV(255, 255);
-        packet[qword_count++] = GS_UV;
-        
-        packet[qword_count++] = GS_SET_XYZ2(gs_x2, gs_y2, 0);
-        packet[qword_count++] = GS_XYZ2;
+        packet[word_count++] = GS_SET_RGBAQ(splat->color[0], splat->color[1],
+                                            splat->color[2], splat->color[3], 0);
+        packet[word_count++] = GS_SET_UV(0, 0);  // UV for LUT lookup
+        packet[word_count++] = GS_SET_XYZ2(gs_x1, gs_y1, 0);
+        packet[word_count++] = GS_SET_UV(255, 255);
+        packet[word_count++] = GS_SET_XYZ2(gs_x2, gs_y2, 0);
+        sprite_count++;
     }
     
-    buffer->used = qword_count * 16;
-    return qword_count;
+    if (sprite_count == 0) {
+        buffer->used = 0;
+        return 0;
+    }
+    
+    // An odd word count ends mid-qword; the GIF discards the padding
+    if (word_count & 1) {
+        packet[word_count++] = 0;
+    }
+    
+    packet[4] = create_gif_tag(sprite_count, 1, 0, 0, GIF_FLG_REGLIST, GS_SPRITE_REGLIST_NREG);
+    packet[5] = GS_SPRITE_REGLIST_REGS;
+    
+    buffer->used = word_count * 8;
+    return word_count / 2;
 }
 
 // Flush buffer to DMA channel
@@ -632,9 +807,10 @@ GaussianResult dma_flush_buffer(DMABuffer* buffer, u32 channel) {
     packet2_reset(&packet, 0);
     packet2_add_data(&packet, buffer->data, qword_count);
     dma_channel_send_packet2(&packet, channel, 0);
+    dma_account_transfer(channel, qword_count * 16);
     
     // Wait for completion
-    dma_channel_wait(channel, 0);
+    dma_timed_channel_wait(channel, 0);
     
     // Update performance statistics
     u64 transfer_cycles = get_cpu_cycles() - transfer_start;
@@ -669,6 +845,12 @@ GaussianResult dma_setup_chain_transfer(const void** data_blocks, const u32* siz
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
+    // The tag list is reused; let an outstanding chain finish reading it
+    if (g_dma_state.chain_in_flight) {
+        dma_timed_channel_wait(g_dma_state.active_channel, 0);
+        g_dma_state.chain_in_flight = false;
+    }
+    
     // Build chain entries for the specified channel
     g_dma_state.chain_count = block_count;
     g_dma_state.active_channel = channel;
@@ -679,20 +861,13 @@ GaussianResult dma_setup_chain_transfer(const void** data_blocks, const u32* siz
         entry->addr = (u32)data_blocks[i];
         entry->size = (sizes[i] + 15) / 16;  // Convert to qwords
         
-        // Set DMA tag based on channel type
-        if (i == block_count - 1) {
-            entry->tag = DMA_TAG_END;  // Last entry
-        } else {
-            entry->tag = (channel == DMA_CHANNEL_VIF1) ? DMA_TAG_NEXT : DMA_TAG_REF;
-        }
-        
-        entry->padding = 0;
+        // Every block is referenced in place; the last one ends the chain
+        entry->tag = (i == block_count - 1) ? DMA_TAG_REFE : DMA_TAG_REF;
+        entry->dma_tag = 0;
     }
     
-    // Flush cache for all data blocks
-    for (u32 i = 0; i < block_count; i++) {
-        FlushCache(0);  // Simplified - should flush specific ranges
-    }
+    // Write back data blocks before the DMAC reads them
+    FlushCache(0);
     
     // Configure channel-specific settings
     if (channel == DMA_CHANNEL_VIF1) {
@@ -715,21 +890,25 @@ GaussianResult dma_execute_chain_transfer(u32 channel) {
     u64 transfer_start = get_cpu_cycles();
     g_dma_state.active_transfers++;
     
-    // Start chain DMA (simplified - actual implementation varies by PS2SDK)
-    // This would typically involve setting up DMA tags and starting the transfer
-    
-    // For now, simulate with individual transfers
+    // Build the hardware tag list in place and start one source-chain transfer.
+    // The DMAC walks the REF tags on its own; callers wait on the channel
+    // before touching the referenced blocks again.
+    u32 chain_bytes = 0;
     for (u32 i = 0; i < g_dma_state.chain_count; i++) {
         ChainDMAEntry* entry = &g_dma_state.chain_entries[i];
         
-        packet2_t chain_packet;
-        packet2_reset(&chain_packet, 0);
-        packet2_add_data(&chain_packet, (void*)entry->addr, entry->size);
-        dma_channel_send_packet2(&chain_packet, channel, 0);
-        dma_channel_wait(channel, 0);
+        entry->dma_tag = (entry->size & 0xFFFF) | (entry->tag << 28);
+        entry->addr &= 0x0FFFFFFF;  // Physical address
         
-        g_dma_state.total_bytes_transferred += entry->size * 16;
+        chain_bytes += entry->size * 16;
     }
+    g_dma_state.total_bytes_transferred += chain_bytes;
+    
+    FlushCache(0);
+    dma_timed_channel_wait(channel, 0);
+    dma_channel_send_chain(channel, (void*)((u32)g_dma_state.chain_entries & 0x0FFFFFFF), 0, 0, 0);
+    dma_account_transfer(channel, chain_bytes);
+    g_dma_state.chain_in_flight = true;
     
     // Update statistics
     u64 transfer_cycles = get_cpu_cycles() - transfer_start;
@@ -782,12 +961,141 @@ GaussianResult dma_copy_to_scratchpad(const void* src, u32 size, void** dst) {
     packet2_reset(&spr_packet, 0);
     packet2_add_data(&spr_packet, (void*)src, (size + 15) / 16);
     dma_channel_send_packet2(&spr_packet, DMA_CHANNEL_SPR, 0);
-    dma_channel_wait(DMA_CHANNEL_SPR, 0);
+    dma_account_transfer(DMA_CHANNEL_SPR, (size + 15) & ~15);
+    dma_timed_channel_wait(DMA_CHANNEL_SPR, 0);
     
     *dst = scratchpad_ptr;
     return GAUSSIAN_SUCCESS;
 }
 
+// Scratchpad streaming over toSPR (DMA channel 9)
+// The 16KB SPR is split into two halves: toSPR fills one while the kernel
+// runs on the other, so streaming loops read uncached SPR at one cycle per
+// access instead of missing the 8KB D-cache every few records. Gathered
+// streams use a source-chain REF tag per record; the tag lists are written
+// through the UCAB segment, so the DMAC sees them without a cache flush.
+#define SPR_BASE_ADDRESS 0x70000000
+#define SPR_STREAM_MAX_RECORDS (SPR_STREAM_HALF_SIZE / 16)
+#define SPR_STREAM_MIN_BLOCK 32               // Split short streams so fills still overlap kernels
+#define DMA_TOSPR_CHCR ((volatile u32*)0x1000D400)
+#define DMA_TOSPR_MADR ((volatile u32*)0x1000D410)
+#define DMA_TOSPR_QWC  ((volatile u32*)0x1000D420)
+#define DMA_TOSPR_TADR ((volatile u32*)0x1000D430)
+#define DMA_TOSPR_SADR ((volatile u32*)0x1000D480)
+#define DMA_CHCR_MODE_CHAIN 0x004
+#define DMA_CHCR_STR 0x100
+
+static u64 g_spr_tags[2][SPR_STREAM_MAX_RECORDS * 2] __attribute__((aligned(DMA_ALIGNMENT)));
+static u8 g_spr_bounce[SPR_STREAM_HALF_SIZE] __attribute__((aligned(DMA_ALIGNMENT)));
+
+static inline void spr_stream_wait(void) {
+    if (!(*DMA_TOSPR_CHCR & DMA_CHCR_STR)) {
+        return;
+    }
+    u64 wait_start = get_cpu_cycles();
+    while (*DMA_TOSPR_CHCR & DMA_CHCR_STR) {
+        __asm__ volatile("nop");
+    }
+    dma_account_wait(DMA_CHANNEL_toSPR, (u32)(get_cpu_cycles() - wait_start));
+}
+
+// Start filling one SPR half with records [first, first + count) of the stream
+static void spr_stream_fill(u32 half, const u8* records, u32 record_size, const u32* indices,
+                            u32 first, u32 count) {
+    u32 record_qwords = record_size / 16;
+    *DMA_TOSPR_SADR = half * SPR_STREAM_HALF_SIZE;
+    dma_account_transfer(DMA_CHANNEL_toSPR, count * record_size);
+    
+    if (!indices) {
+        *DMA_TOSPR_MADR = (u32)(records + first * record_size) & 0x0FFFFFFF;
+        *DMA_TOSPR_QWC = count * record_qwords;
+        *DMA_TOSPR_CHCR = DMA_CHCR_STR;
+        return;
+    }
+    
+    // Gather: one REF tag per record, REFE on the last ends the chain
+    u64* tags = (u64*)UCAB_SEG(g_spr_tags[half]);
+    for (u32 i = 0; i < count; i++) {
+        u32 address = (u32)(records + indices[first + i] * record_size) & 0x0FFFFFFF;
+        u32 id = (i + 1 == count) ? DMA_TAG_REFE : DMA_TAG_REF;
+        tags[i * 2] = (u64)record_qwords | ((u64)id << 28) | ((u64)address << 32);
+        tags[i * 2 + 1] = 0;
+    }
+    
+    *DMA_TOSPR_QWC = 0;
+    *DMA_TOSPR_TADR = (u32)g_spr_tags[half] & 0x0FFFFFFF;
+    *DMA_TOSPR_CHCR = DMA_CHCR_MODE_CHAIN | DMA_CHCR_STR;
+}
+
+// Run kernel over count records, staged through the scratchpad in blocks.
+// indices, when given, selects the records to visit (in that order); otherwise
+// records are visited contiguously. record_size must be a qword multiple.
+// While dma_scratchpad_alloc() holds SPR space, or before dma_system_init(),
+// blocks are handed to the kernel from main memory instead. Kernels must not
+// start another stream.
+GaussianResult dma_spr_stream(const void* records, u32 record_size, const u32* indices, u32 count,
+                              SprStreamKernel kernel, void* user) {
+    if (!records || !kernel || record_size == 0 || (record_size & 15) || record_size > SPR_STREAM_HALF_SIZE) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (count == 0) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    const u8* bytes = (const u8*)records;
+    u32 block_records = SPR_STREAM_HALF_SIZE / record_size;
+    block_records = MIN(block_records, MAX(count / 4, SPR_STREAM_MIN_BLOCK));
+    
+    if (!g_dma_state.initialized || g_dma_state.scratchpad_used > 0) {
+        for (u32 first = 0; first < count; first += block_records) {
+            u32 block_count = MIN(block_records, count - first);
+            if (indices) {
+                for (u32 i = 0; i < block_count; i++) {
+                    memcpy(&g_spr_bounce[i * record_size], bytes + indices[first + i] * record_size, record_size);
+                }
+                kernel(g_spr_bounce, first, block_count, user);
+            } else {
+                kernel(bytes + first * record_size, first, block_count, user);
+            }
+        }
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    u64 stream_start = get_cpu_cycles();
+    
+    // toSPR reads memory behind the cache: records written by the EE must land first
+    FlushCache(0);
+    
+    u32 half = 0;
+    u32 first = 0;
+    u32 block_count = MIN(block_records, count);
+    spr_stream_fill(half, bytes, record_size, indices, first, block_count);
+    
+    while (block_count > 0) {
+        // This half has landed; the other one is free since its kernel returned
+        spr_stream_wait();
+        
+        u32 next_first = first + block_count;
+        u32 next_count = MIN(block_records, count - next_first);
+        if (next_count > 0) {
+            spr_stream_fill(1 - half, bytes, record_size, indices, next_first, next_count);
+        }
+        
+        kernel((const u8*)SPR_BASE_ADDRESS + half * SPR_STREAM_HALF_SIZE, first, block_count, user);
+        
+        half = 1 - half;
+        first = next_first;
+        block_count = next_count;
+    }
+    
+    g_dma_state.total_bytes_transferred += (u64)count * record_size;
+    g_dma_state.total_transfer_cycles += get_cpu_cycles() - stream_start;
+    g_dma_state.completed_transfers++;
+    
+    return GAUSSIAN_SUCCESS;
+}
+
 // Get DMA performance statistics
 void dma_get_performance_stats(FrameProfileData* profile) {
     if (!profile || !g_dma_state.initialized) return;
@@ -822,16 +1130,8 @@ void dma_reset_performance_counters(void) {
 
 // Wait for all DMA transfers to complete
 void dma_wait_all_transfers(void) {
-    while (g_dma_state.active_transfers > 0) {
-        // Check each channel
-        if (!dma_channel_busy(DMA_CHANNEL_VU1_DATA) && 
-            !dma_channel_busy(DMA_CHANNEL_GS_DATA)) {
-            break;
-        }
-        
-        // Yield CPU
-        __asm__ volatile("nop");
-    }
+    dma_wait_channel(DMA_CHANNEL_VU1_DATA);
+    dma_wait_channel(DMA_CHANNEL_GS_DATA);
     
     // Mark all buffers as available
     for (int i = 0; i < 2; i++) {
@@ -978,6 +1278,7 @@ int dma_channel_send_normal_custom(int channel, void* data, u32 size, int direct
     
     // Start transfer
     *dma_chcr |= 0x100;  // Set STR bit to start transfer
+    dma_account_transfer(channel, qwords * 16);
     
     return 0;
 }
@@ -1014,6 +1315,7 @@ int dma_channel_send_chain_custom(int channel, void* chain_data, u32 chain_size)
     chcr = (chcr & ~0x0C) | 0x04;  // Set MODE bits to 01 (chain mode)
     chcr |= 0x100;  // Set STR bit to start transfer
     *dma_chcr = chcr;
+    dma_account_transfer(channel, chain_size);
     
     return 0;
 }
@@ -1055,10 +1357,11 @@ int dma_channel_send_packet2_custom(packet2_t* packet, int channel, int wait_fla
     
     // Start transfer
     *dma_chcr |= 0x100;  // Set STR bit
+    dma_account_transfer(channel, packet_size);
     
     // Wait if requested
     if (wait_flag) {
-        return dma_channel_wait(channel, 1000);  // Wait up to 1000ms
+        return dma_timed_channel_wait(channel, 1000);  // Wait up to 1000ms
     }
     
     return 0;
@@ -1077,13 +1380,19 @@ int splatstorm_dma_channel_wait(int channel, int timeout) {
     if (timeout == 0) {
         // Non-blocking check
         return dma_channel_status(channel);
+    } else if (timeout < 0) {
+        // Wait without a limit, asleep when the channel has an end interrupt
+        dma_wait_channel(channel);
+        return 0;
     } else {
         // Blocking wait with timeout
+        u64 wait_start = get_cpu_cycles();
         int cycles = 0;
         while (dma_channel_status(channel) && cycles < timeout) {
             cycles++;
             __asm__ volatile("nop");
         }
+        dma_account_wait(channel, (u32)(get_cpu_cycles() - wait_start));
         return dma_channel_status(channel);
     }
 }
@@ -1148,23 +1457,24 @@ void dma_system_cleanup(void) {
     
     // Wait for all transfers to complete
     dma_wait_all_transfers();
+    dma_completion_remove();
     
     // Free buffers
     for (int i = 0; i < 2; i++) {
         if (g_dma_state.upload_buffers[i].data) {
-            free(g_dma_state.upload_buffers[i].data);
+            memory_free(g_dma_state.upload_buffers[i].data);
         }
         if (g_dma_state.download_buffers[i].data) {
-            free(g_dma_state.download_buffers[i].data);
+            memory_free(g_dma_state.download_buffers[i].data);
         }
         if (g_dma_state.gs_buffers[i].data) {
-            free(g_dma_state.gs_buffers[i].data);
+            memory_free(g_dma_state.gs_buffers[i].data);
         }
     }
     
     // Free chain entries
     if (g_dma_state.chain_entries) {
-        free(g_dma_state.chain_entries);
+        memory_free(g_dma_state.chain_entries);
     }
     
     // Clear state
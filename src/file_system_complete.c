@@ -9,6 +9,7 @@
  * - USB mass storage support
  * - Automatic device detection and fallback
  * - Complete file operations with buffering
+ * - Pipelined block reads: the IOP fetches the next block while the EE decodes
  * - Proper PS2 file system integration
  */
 
@@ -25,6 +26,7 @@
 #include <sys/stat.h>
 #include <libmc.h>
 #include <libhdd.h>
+#include <fileXio_rpc.h>
 
 // File system state
 static int file_system_initialized = 0;
@@ -167,6 +169,21 @@ int file_system_is_ready(void) {
     return (mc_available || hdd_available || usb_available || 1); // CDROM always available
 }
 
+/*
+ * Boot benchmark read rate of a device type (ps2sdk_file_io.c), 0 if unmeasured
+ */
+static u32 device_read_kbps(int device_type) {
+    static const char* prefixes[4] = {"mc0:", "pfs0:", "mass:", "cdfs:"};  // MC, HDD, USB, CDROM
+    const char* prefix;
+    u32 read_kbps;
+    for (u32 d = 0; storage_get_benchmark(d, NULL, &prefix, &read_kbps, NULL); d++) {
+        if (strcmp(prefix, prefixes[device_type]) == 0) {
+            return read_kbps;
+        }
+    }
+    return 0;
+}
+
 /*
  * Determine best device for file based on size and availability
  * COMPLETE IMPLEMENTATION with intelligent device selection
@@ -175,6 +192,26 @@ static int select_best_device(const char *filename, size_t expected_size) {
     // Analyze filename for hints about file type and size
     const char* ext = strrchr(filename, '.');
     
+    // Configuration files prefer Memory Card for persistence
+    if (ext && (strcmp(ext, ".cfg") == 0 || strcmp(ext, ".ini") == 0)) {
+        if (mc_available) return 0;  // Memory Card
+    }
+    
+    // Measured devices: the fastest available one, whatever the file
+    int device_available[] = {mc_available, hdd_available, usb_available, 1};  // MC, HDD, USB, CDROM
+    int fastest = -1;
+    u32 fastest_kbps = 0;
+    for (int device = 0; device < 4; device++) {
+        u32 read_kbps = device_available[device] ? device_read_kbps(device) : 0;
+        if (read_kbps > fastest_kbps) {
+            fastest = device;
+            fastest_kbps = read_kbps;
+        }
+    }
+    if (fastest >= 0) {
+        return fastest;
+    }
+    
     // Large files (>1MB) or known large file types prefer HDD or USB
     if (expected_size > 1024 * 1024 || 
         (ext && (strcmp(ext, ".elf") == 0 || strcmp(ext, ".bin") == 0 || strcmp(ext, ".dat") == 0))) {
@@ -182,11 +219,6 @@ static int select_best_device(const char *filename, size_t expected_size) {
         if (usb_available) return 2;  // USB
     }
     
-    // Configuration files prefer Memory Card for persistence
-    if (ext && (strcmp(ext, ".cfg") == 0 || strcmp(ext, ".ini") == 0)) {
-        if (mc_available) return 0;  // Memory Card
-    }
-    
     // Small files can use Memory Card
     if (expected_size < 512 * 1024 && mc_available) {
         return 0;  // Memory Card
@@ -502,6 +534,133 @@ int file_exists(const char *filename) {
     return 0;  // File not found
 }
 
+/*
+ * Pipelined block reader
+ * Two aligned buffers alternate: while decode() consumes block N, fileXio
+ * fetches block N+1 into the other one, so IOP-side I/O and EE-side decode
+ * overlap. fileXio serves one request at a time, so a third buffer would
+ * only wait. Without fileXio every block is read synchronously first.
+ */
+#define FILE_PIPELINE_BUFFERS 2
+
+typedef struct {
+    int fd;
+    bool async;             // fileXio non-blocking reads, POSIX reads otherwise
+    int result;             // Synchronous mode: bytes returned by the last read
+} FilePipeline;
+
+static void file_pipeline_issue(FilePipeline* pipeline, u8* buffer, u32 size) {
+    if (pipeline->async) {
+        fileXioSetBlockMode(FXIO_NOWAIT);
+        fileXioRead(pipeline->fd, buffer, size);
+        fileXioSetBlockMode(FXIO_WAIT);
+    } else {
+        pipeline->result = read(pipeline->fd, buffer, size);
+    }
+}
+
+static void file_pipeline_close(FilePipeline* pipeline) {
+    if (pipeline->async) {
+        fileXioClose(pipeline->fd);
+    } else {
+        close(pipeline->fd);
+    }
+}
+
+static int file_pipeline_wait(FilePipeline* pipeline) {
+    if (pipeline->async) {
+        int bytes_read = 0;
+        fileXioWaitAsync(FXIO_WAIT, &bytes_read);
+        return bytes_read;
+    }
+    return pipeline->result;
+}
+
+/*
+ * Read length bytes at offset in block_size blocks and hand each block to
+ * decode() in file order, with the next block already being read. A decoder
+ * error stops the read and is returned. A file that ends early is not an
+ * error: *delivered (optional) tells how many bytes were decoded.
+ */
+GaussianResult file_read_pipelined(const char* filename, u32 offset, u32 length, u32 block_size,
+                                   FileBlockDecoder decode, void* user, u32* delivered) {
+    if (delivered) {
+        *delivered = 0;
+    }
+    if (!filename || !decode || block_size == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (length == 0) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    char full_path[256];
+    if (find_file_on_storage(filename, full_path, sizeof(full_path)) != GAUSSIAN_SUCCESS) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    FilePipeline pipeline;
+    pipeline.async = fileXioInit() >= 0;
+    pipeline.result = 0;
+    pipeline.fd = pipeline.async ? fileXioOpen(full_path, O_RDONLY) : open(full_path, O_RDONLY);
+    if (pipeline.fd < 0) {
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    int seeked = pipeline.async ? fileXioLseek(pipeline.fd, offset, SEEK_SET) : lseek(pipeline.fd, offset, SEEK_SET);
+    
+    // fileXio DMAs into the buffers: whole cache lines only
+    block_size = (block_size + 63) & ~63U;
+    u8* buffers = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, FILE_PIPELINE_BUFFERS * block_size, 64);
+    if (seeked < 0 || !buffers) {
+        memory_free(buffers);
+        file_pipeline_close(&pipeline);
+        return seeked < 0 ? GAUSSIAN_ERROR_FILE_READ_FAILED : GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    u32 block_count = (length + block_size - 1) / block_size;
+    u32 decoded = 0;
+    
+    file_pipeline_issue(&pipeline, buffers, MIN(block_size, length));
+    for (u32 b = 0; b < block_count; b++) {
+        u32 expected = MIN(block_size, length - b * block_size);
+        int bytes_read = file_pipeline_wait(&pipeline);
+        if (bytes_read < 0) {
+            debug_log_error("Pipelined read of %s failed at %u: %d", filename, offset + decoded, bytes_read);
+            result = GAUSSIAN_ERROR_FILE_READ_FAILED;
+            break;
+        }
+        
+        // Queue the next block before decoding this one; a short block is the end of the file
+        u8* block = buffers + (b % FILE_PIPELINE_BUFFERS) * block_size;
+        bool more = b + 1 < block_count && bytes_read == (int)expected;
+        if (more) {
+            file_pipeline_issue(&pipeline, buffers + ((b + 1) % FILE_PIPELINE_BUFFERS) * block_size,
+                                MIN(block_size, length - (b + 1) * block_size));
+        }
+        
+        if (bytes_read > 0) {
+            result = decode(block, bytes_read, offset + decoded, user);
+            decoded += bytes_read;
+        }
+        if (result != GAUSSIAN_SUCCESS || !more) {
+            if (more) {
+                file_pipeline_wait(&pipeline);  // Let the queued read land before its buffer goes
+            }
+            break;
+        }
+    }
+    
+    memory_free(buffers);
+    file_pipeline_close(&pipeline);
+    
+    if (delivered) {
+        *delivered = decoded;
+    }
+    return result;
+}
+
 /*
  * Create directory if it doesn't exist
  * COMPLETE IMPLEMENTATION
@@ -12,9 +12,6 @@ static fixed16_t sin_table[1024];
 static fixed16_t cos_table[1024];
 static u32 math_initialized = 0;
 
-// Square root lookup table for common values
-static fixed16_t sqrt_table[256];
-
 void fixed_math_init(void)
 {
     fixed_math_init_tables();
@@ -33,12 +30,6 @@ void fixed_math_init_tables(void)
         cos_table[i] = FLOAT_TO_FIXED16(cosf(angle));
     }
     
-    // Generate square root table
-    int j; for (j = 0; j < 256; j++) {
-        float value = (float)j / 256.0f * 16.0f;  // 0 to 16
-        sqrt_table[j] = FLOAT_TO_FIXED16(sqrtf(value));
-    }
-    
     math_initialized = 1;
     debug_log_info("Fixed-point math initialized");
 }
@@ -49,8 +40,8 @@ fixed16_t fixed16_mul(fixed16_t a, fixed16_t b)
     s64 result = ((s64)a * (s64)b) >> 16;
     
     // Clamp to prevent overflow
-    if (result > 0x7FFFFFFF) return 0x7FFFFFFF;
-    if (result < -0x80000000) return -0x80000000;
+    if (result > FIXED16_MAX) return FIXED16_MAX;
+    if (result < FIXED16_MIN) return FIXED16_MIN;
     
     return (fixed16_t)result;
 }
@@ -59,15 +50,15 @@ fixed16_t fixed16_div(fixed16_t a, fixed16_t b)
 {
     if (b == 0) {
         debug_log_error("Division by zero in fixed16_div");
-        return (a >= 0) ? 0x7FFFFFFF : -0x80000000;  // Return max/min instead of crashing
+        return (a >= 0) ? FIXED16_MAX : FIXED16_MIN;  // Return max/min instead of crashing
     }
     
     // Shift up then divide
     s64 result = ((s64)a << 16) / (s64)b;
     
     // Clamp to prevent overflow
-    if (result > 0x7FFFFFFF) return 0x7FFFFFFF;
-    if (result < -0x80000000) return -0x80000000;
+    if (result > FIXED16_MAX) return FIXED16_MAX;
+    if (result < FIXED16_MIN) return FIXED16_MIN;
     
     return (fixed16_t)result;
 }
@@ -90,25 +81,27 @@ fixed16_t fixed16_sqrt(fixed16_t value)
 {
     if (value <= 0) return 0;
     
-    // For small values, use lookup table
-    if (value < (16 << 16)) {
-        u32 index = (u32)value >> 16;  // Get integer part
-        if (index < 256) {
-            return sqrt_table[index];
-        }
+    // The Q16.16 root of value is the integer root of value << 16.
+    // Digit by digit in 64-bit registers: exact (rounded down) at every
+    // magnitude, and no divides
+    u64 remainder = (u64)value << 16;
+    u64 root = 0;
+    u64 bit = 1ULL << 46;  // Largest power of 4 below 2^47
+    while (bit > remainder) {
+        bit >>= 2;
     }
     
-    // For larger values, use Newton-Raphson iteration
-    fixed16_t x = value >> 1;  // Initial guess
-    
-    int i; for (i = 0; i < 8; i++) {  // 8 iterations should be enough
-        if (x == 0) break;
-        fixed16_t x_new = (x + fixed16_div(value, x)) >> 1;
-        if (x_new == x) break;  // Converged
-        x = x_new;
+    while (bit) {
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
     }
     
-    return x;
+    return (fixed16_t)root;
 }
 
 fixed16_t fixed16_abs(fixed16_t value)
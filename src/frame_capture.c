@@ -0,0 +1,180 @@
+/*
+ * SPLATSTORM X - Frame Capture
+ * Saves one frame's pipeline state, inputs and intermediates, for offline
+ * replay on the build machine (bench/frame_replay.c, make frame-replay).
+ *
+ * capture=<frame>:<file> arms it; the frame numbered <frame> by the main
+ * loop is written stage by stage as render_frame produces it: camera,
+ * visible indices, projected splats before and after screen-space LOD,
+ * tile ranges and bins, render regions, and every GIF chunk the frame
+ * submits. The direct VU1 path stops after the visible indices; its
+ * sprites never leave VU1. Writes are synchronous, so that frame's
+ * timings include them; the capture is for reproducing the view, not for
+ * timing it.
+ *
+ * Layout, little endian: a FrameCaptureHeader, then sections until the end
+ * of the file, each a FrameCaptureSection followed by count records of
+ * record_size bytes. Records are the engine structs as the EE lays them
+ * out. TILE_RANGES start indices point into TILE_LISTS, the bins in tile
+ * order; the GIF chain is every GIF section in file order, as the GIF
+ * consumed it (PATH3 only).
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include <tamtypes.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    u32 magic;                                // FRAME_CAPTURE_MAGIC
+    u16 version;                              // FRAME_CAPTURE_VERSION
+    u16 header_size;                          // sizeof(FrameCaptureHeader)
+    u32 frame;                                // Main loop frame number
+    u16 width;                                // Render resolution
+    u16 height;
+    u32 flags;                                // FRAME_CAPTURE_FLAG_*
+    float saturation_epsilon;                 // Block transmittance treated as opaque
+    u8 quality_level;                         // LOD quality the frame ran at
+    u8 render_mode;                           // VU_RENDER_MODE_*
+    u16 reserved;
+} FrameCaptureHeader;
+
+typedef struct {
+    u32 id;                                   // FRAME_CAPTURE_SECTION_*
+    u32 record_size;
+    u32 count;
+    u32 reserved;
+} FrameCaptureSection;
+
+static struct {
+    char file_name[64];
+    u32 frame;                                // Frame to capture
+    bool armed;
+
+    FILE* file;                               // Open while the frame is captured
+    u32 sections;
+    u32 bytes;
+    bool failed;                              // A write fell short
+} g_capture = {"", 0, false, NULL, 0, 0, false};
+
+// One option; false when it is not a capture option
+bool frame_capture_parse_option(const char* option) {
+    if (!option || strncmp(option, "capture=", 8) != 0) return false;
+
+    const char* separator = strchr(option + 8, ':');
+    if (!separator || !separator[1]) return false;
+    g_capture.frame = (u32)atoi(option + 8);
+    strncpy(g_capture.file_name, separator + 1, sizeof(g_capture.file_name) - 1);
+    g_capture.file_name[sizeof(g_capture.file_name) - 1] = '\0';
+    g_capture.armed = true;
+    return true;
+}
+
+/*
+ * Start capturing if frame is the one asked for. Call at the top of every
+ * drawn frame, before its camera constants go to VU1.
+ */
+void frame_capture_begin(u32 frame, const CameraFixed* camera, u32 quality_level) {
+    if (!g_capture.armed || frame != g_capture.frame || g_capture.file) return;
+    g_capture.armed = false;
+
+    if (iop_require_path(g_capture.file_name) < 0) return;
+    g_capture.file = fopen(g_capture.file_name, "wb");
+    if (!g_capture.file) {
+        debug_log_error("Capture: cannot write %s", g_capture.file_name);
+        return;
+    }
+
+    u32 width, height;
+    gs_get_render_resolution(&width, &height);
+    FrameCaptureHeader header = {FRAME_CAPTURE_MAGIC, FRAME_CAPTURE_VERSION, sizeof(FrameCaptureHeader), frame,
+                                 (u16)width, (u16)height, 0, tile_get_saturation_epsilon(), (u8)quality_level,
+                                 (u8)vu_get_render_mode(), 0};
+    if (tile_get_saturation_cull()) header.flags |= FRAME_CAPTURE_FLAG_SATURATION;
+    if (tile_get_texture_order()) header.flags |= FRAME_CAPTURE_FLAG_TEXTURE_ORDER;
+
+    g_capture.sections = 0;
+    g_capture.bytes = sizeof(header);
+    g_capture.failed = fwrite(&header, sizeof(header), 1, g_capture.file) != 1;
+    frame_capture_write(FRAME_CAPTURE_SECTION_CAMERA, camera, sizeof(CameraFixed), 1);
+}
+
+bool frame_capture_active(void) {
+    return g_capture.file != NULL;
+}
+
+// Append one section of count records; nothing while no frame is captured
+void frame_capture_write(u32 section, const void* records, u32 record_size, u32 count) {
+    if (!g_capture.file || g_capture.failed || (!records && count > 0)) return;
+
+    FrameCaptureSection header = {section, record_size, count, 0};
+    g_capture.failed = fwrite(&header, sizeof(header), 1, g_capture.file) != 1 ||
+                       (count > 0 && fwrite(records, record_size, count, g_capture.file) != count);
+    g_capture.sections++;
+    g_capture.bytes += sizeof(header) + record_size * count;
+}
+
+// Tile ranges of process_tiles() and the bins they describe, rebased so
+// start indices point into the TILE_LISTS section
+void frame_capture_tiles(const TileRange* ranges) {
+    if (!g_capture.file || !ranges) return;
+
+    TileRange* rebased = (TileRange*)memory_alloc(MEMORY_BUDGET_DEBUG, MAX_TILES * sizeof(TileRange), 16);
+    if (!rebased) {
+        g_capture.failed = true;
+        return;
+    }
+
+    u32 entries = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        rebased[tile_id] = ranges[tile_id];
+        rebased[tile_id].start_index = entries;
+        entries += ranges[tile_id].count;
+    }
+    frame_capture_write(FRAME_CAPTURE_SECTION_TILE_RANGES, rebased, sizeof(TileRange), MAX_TILES);
+    memory_free(rebased);
+
+    FrameCaptureSection header = {FRAME_CAPTURE_SECTION_TILE_LISTS, sizeof(u32), entries, 0};
+    if (g_capture.failed || fwrite(&header, sizeof(header), 1, g_capture.file) != 1) {
+        g_capture.failed = true;
+        return;
+    }
+    for (u32 tile_id = 0; tile_id < MAX_TILES && !g_capture.failed; tile_id++) {
+        u32 count = 0;
+        const u32* list = get_tile_splat_list(tile_id, &count);
+        if (count != ranges[tile_id].count ||
+            (count > 0 && (!list || fwrite(list, sizeof(u32), count, g_capture.file) != count))) {
+            g_capture.failed = true;
+        }
+    }
+    g_capture.sections++;
+    g_capture.bytes += sizeof(header) + entries * sizeof(u32);
+}
+
+// Render regions of tile_build_render_regions() and their index list
+void frame_capture_regions(const TileRegion* regions, u32 region_count, const u32* indices) {
+    if (!g_capture.file) return;
+
+    u32 entries = 0;
+    for (u32 r = 0; r < region_count; r++) {
+        entries = MAX(entries, regions[r].start_index + regions[r].count);
+    }
+    frame_capture_write(FRAME_CAPTURE_SECTION_REGIONS, regions, sizeof(TileRegion), region_count);
+    frame_capture_write(FRAME_CAPTURE_SECTION_REGION_INDICES, indices, sizeof(u32), indices ? entries : 0);
+}
+
+// Close the capture after the frame's last GIF chunk went out
+void frame_capture_end(void) {
+    if (!g_capture.file) return;
+
+    bool failed = fclose(g_capture.file) != 0 || g_capture.failed;
+    g_capture.file = NULL;
+    if (failed) {
+        debug_log_error("Capture: %s incomplete", g_capture.file_name);
+        return;
+    }
+    printf("SPLATSTORM X: Frame %u captured to %s (%u sections, %u KB)\n", g_capture.frame, g_capture.file_name,
+           g_capture.sections, g_capture.bytes / 1024);
+}
@@ -1,6 +1,20 @@
 /*
  * SPLATSTORM X - Complete Frustum Culling Implementation
- * Production-ready frustum culling with flat spatial grid and VU0 optimization
+ * Production-ready frustum culling with an adaptive octree and VU0 optimization
+ * Straddling leaves are culled on VU0 (vu_culling.c) while the EE keeps traversing
+ * Without VU0 they are deferred to one EE pass streamed through the scratchpad
+ * Scenes with hot/warm/cold streams are culled from the 16-byte hot stream only
+ * Index mode returns visible scene indices instead of copying splats
+ * Nodes confidently inside or outside for several frames skip their plane
+ * tests until the planes could have moved past them; only boundary nodes
+ * are classified every frame
+ * Visible nodes whose screen box lies behind last frame's opaque tiles
+ * (the tile rasterizer's occlusion pyramid) are culled whole
+ * Instanced assets (scene_instances.c) keep their own octree, a CullIndex,
+ * culled in object space through the instance's view-projection matrix
+ * Moved splats refit only their leaves and the ancestors whose bounds change
+ * A visible cap below the scene keeps the most important visible splats,
+ * by an importance code per splat and last frame's code histogram
  * Target: <3ms for 16,000 splats with temporal coherence
  */
 
@@ -9,17 +23,29 @@
 #include <string.h>
 #include "splatstorm_x.h"
 #include "gaussian_types.h"
+#include "fixed_math_mmi.h"
 #include <math.h>
 #include <tamtypes.h>
 
 // Frustum culling configuration
-#define SPATIAL_GRID_SIZE_X     8
-#define SPATIAL_GRID_SIZE_Y     8  
-#define SPATIAL_GRID_SIZE_Z     8
-#define TOTAL_GRID_CELLS        (SPATIAL_GRID_SIZE_X * SPATIAL_GRID_SIZE_Y * SPATIAL_GRID_SIZE_Z)
-#define MAX_SPLATS_PER_CELL     512
-#define VU0_BATCH_SIZE          128
+#define OCTREE_MAX_DEPTH        16
+#define OCTREE_LEAF_SPLATS      32            // Split nodes holding more splats than this
+#define IMPORTANCE_CODES        256           // Importance levels: 8 per octave, 0 the most important
+#define OCTREE_STACK_SIZE       (OCTREE_MAX_DEPTH * 7 + 1)
+#define OCTREE_ALL_PLANES       0x3F
+#define OCTREE_FILE_NODE_WORDS  16            // Node size in tools/splat_to_atlas.py octree.idx
+#define OCTREE_FILE_LEAF_SLOTS  8
+#define EE_CULL_BATCH_SIZE      128           // EE fallback test batch
 #define VISIBILITY_HISTORY_BITS 8
+#define NODE_CONFIDENCE_FRAMES  3             // Same deep classification this often before skipping tests
+#define NODE_CONFIDENCE_MAX     15
+#define OCCLUSION_NEAR_W        1e-3f         // Boxes reaching this close to the eye are never occluded
+#define OCCLUSION_DEPTH_SCALE   16777215.0f   // Z24 = scale / w, as the VU1 projection writes it
+
+// AABB classification against the frustum
+#define CULL_OUTSIDE            0
+#define CULL_INTERSECT          1
+#define CULL_INSIDE             2
 
 // Frustum plane structure (Q16.16 fixed-point)
 typedef struct {
@@ -30,29 +56,42 @@ typedef struct {
 // Complete frustum structure
 typedef struct {
     FrustumPlane planes[6];     // Left, right, top, bottom, near, far
+    fixed16x4 planes_x4[6][4];  // Each plane's nx, ny, nz, d broadcast for 4-wide tests
     fixed16_t bounds_min[3];    // Frustum bounding box min
     fixed16_t bounds_max[3];    // Frustum bounding box max
 } FrustumInternal;
 
-// Spatial grid cell
+// Octree node: children are stored contiguously, and every subtree covers
+// one contiguous range of the index array, so a node that is fully inside
+// or fully outside is handled as a single range.
+// tools/cook_scene.py writes this layout (40 bytes) into cooked scenes.
 typedef struct {
-    fixed16_t bounds_min[3];    // Cell bounding box min
-    fixed16_t bounds_max[3];    // Cell bounding box max
-    u32 splat_indices[MAX_SPLATS_PER_CELL];  // Indices of splats in this cell
-    u32 splat_count;            // Number of splats in cell
-    bool is_visible;            // Cell visibility flag (for hierarchical culling)
-    u64 last_visible_frame;     // Last frame this cell was visible
-} SpatialGridCell;
-
-// Spatial grid structure
+    fixed16_t bounds_min[3];    // Node bounds, including splat radii
+    fixed16_t bounds_max[3];
+    u32 first_child;            // Index of the first child node
+    u32 splat_first;            // First entry in the index array
+    u32 splat_count;            // Entries covered by this subtree
+    u8 child_count;             // 0 for leaves
+    u8 depth;                   // Depth in the tree (root = 0)
+    u16 reserved;
+} OctreeNode;
+
+// Spatial octree
 typedef struct {
-    SpatialGridCell cells[TOTAL_GRID_CELLS];
-    fixed16_t world_min[3];     // World space bounds
-    fixed16_t world_max[3];
-    fixed16_t cell_size[3];     // Size of each cell
-    u32 total_splats;           // Total splats in grid
-    bool initialized;           // Grid initialization flag
-} SpatialGrid;
+    OctreeNode* nodes;          // Compact node array, root at index 0
+    u32 node_count;             // Nodes in use
+    u32 node_capacity;          // Nodes allocated
+    u32* splat_indices;         // Splat indices, grouped by subtree
+    u32 total_splats;           // Splats indexed by the tree
+    u32 visible_nodes;          // Nodes that passed the frustum test this frame
+    u32 inside_nodes;           // Nodes accepted without per-splat tests this frame
+    u32 occluded_nodes;         // Nodes culled by the occlusion pyramid this frame
+    u32* splat_leaf;            // Leaf node of each splat, built by the first refit
+    u32* node_parent;           // Parent of each node (the root its own), with splat_leaf
+    bool imported;              // Topology came from an exported octree.idx
+    bool cooked;                // Nodes and indices live in a cooked scene payload
+    bool initialized;           // Tree initialization flag
+} SpatialOctree;
 
 // Visibility history for temporal coherence
 typedef struct {
@@ -60,11 +99,78 @@ typedef struct {
     u64 frame_number;                  // Current frame number
 } VisibilityHistory;
 
+// Importance rank of the scene's splats for a visible cap: an 8-bit log
+// scale code, 0 the most important. A capped pass keeps the codes up to
+// the limit its previous frame's histogram set, so the cap drops the least
+// important visible splats instead of whatever the traversal reaches last.
+typedef struct {
+    u8 code[MAX_SPLATS_PER_SCENE];     // Importance code per splat
+    const GaussianSplat3D* splats;     // Records the codes were taken from
+    u32 coded_count;                   // Splats [0, coded_count) hold a code
+    u32 histogram[IMPORTANCE_CODES];   // Visible splats per code this pass
+    u32 limit;                         // Least important code kept
+    u32 limit_slots;                   // Splats of the limit code kept: what the codes above it leave
+} ImportanceRank;
+
+// Frustum of the last view-projection matrix; reused while the camera is still
+typedef struct {
+    fixed16_t view_proj[16];    // Matrix the planes were extracted from
+    float view_proj_f[16];      // The same matrix in float, for occlusion box projection
+    FrustumInternal frustum;    // Normalized planes
+    bool valid;
+} FrustumCache;
+
+// Temporal classification of one node. margin is how far the box was from
+// changing class when it was last tested: its distance inside the nearest
+// plane, or outside the farthest separating plane. Plane drift since then
+// is bounded by the drift accumulator, so while the accumulated drift stays
+// below the margin the old class still holds.
+typedef struct {
+    fixed16_t margin;           // Distance from a class change at the last test
+    s64 drift_base;             // Drift accumulator at the last test
+    u8 classification;          // CULL_INSIDE / CULL_OUTSIDE of the last test
+    u8 confidence;              // Consecutive tests with that deep class, 0 at the boundary
+    u16 reserved;
+} NodeVisibility;
+
+// Per-node visibility history, parallel to the octree nodes
+typedef struct {
+    NodeVisibility* nodes;      // One entry per octree node
+    u32 capacity;               // Entries allocated
+    bool valid;                 // Entries describe the current tree
+    s64 drift;                  // Max plane movement for any scene point, summed over frames
+    fixed16_t planes[6][4];     // Planes the drift was last measured from
+    bool planes_valid;
+    u32 skipped_nodes;          // Nodes classified from history this frame
+} NodeVisibilityHistory;
+
 // Global culling state
-static SpatialGrid g_spatial_grid = {0};
+static SpatialOctree g_octree = {0};
 static VisibilityHistory g_visibility_history = {0};
+static FrustumCache g_frustum_cache = {0};
+static NodeVisibilityHistory g_node_history = {0};
+static ImportanceRank g_importance = {{0}, NULL, 0, {0}, IMPORTANCE_CODES - 1, 0xFFFFFFFFu};
 static u64 g_current_frame = 0;
 
+// Forget the importance codes: the scene's records moved or went away
+static void importance_rank_reset(void) {
+    g_importance.splats = NULL;
+    g_importance.coded_count = 0;
+    g_importance.limit = IMPORTANCE_CODES - 1;
+    g_importance.limit_slots = 0xFFFFFFFFu;
+}
+
+// One asset's octree. A pass over it swaps it in for the scene's: the
+// traversal runs unchanged, and the state kept per scene splat or node
+// (visibility and node history) is left out, since every instance of the
+// asset sees it through different planes.
+struct CullIndex {
+    SpatialOctree octree;
+};
+
+static FrustumCache g_instance_frustum_cache = {0};  // Swapped in with an instance's octree
+static bool g_instance_pass = false;
+
 // Fixed-point math helpers
 static inline fixed16_t fixed16_dot3(const fixed16_t a[3], const fixed16_t b[3]) {
     return fixed_mul(a[0], b[0]) + fixed_mul(a[1], b[1]) + fixed_mul(a[2], b[2]);
@@ -75,17 +181,19 @@ static inline fixed16_t fixed16_length3(const fixed16_t v[3]) {
     return fixed16_sqrt(dot);  // Assuming fixed16_sqrt is implemented
 }
 
-// Calculate splat radius from covariance matrix (approximate)
-static fixed16_t calculate_splat_radius(const GaussianSplat3D* splat) {
-    // Approximate radius as 3 * sqrt(max eigenvalue)
-    // For 3x3 covariance matrix, max eigenvalue is approximately the largest diagonal element
-    fixed8_t max_cov = splat->cov_mant[0];  // cov[0][0]
-    if (splat->cov_mant[4] > max_cov) max_cov = splat->cov_mant[4];  // cov[1][1]
-    if (splat->cov_mant[8] > max_cov) max_cov = splat->cov_mant[8];  // cov[2][2]
-    
-    // Convert Q8.8 to Q16.16 and take square root
-    fixed16_t max_cov_16 = (fixed16_t)max_cov << 8;
-    return fixed_mul(fixed_from_float(3.0f), fixed16_sqrt(max_cov_16));
+// Where culling reads splat spheres from: the scene's hot stream when it has
+// one (16 bytes per splat), the AoS records otherwise
+typedef struct {
+    const GaussianSplat3D* splats;            // AoS records, NULL in stream mode
+    const GaussianSplatHot* hot;              // Hot stream, NULL in AoS mode
+} SplatSource;
+
+static inline const fixed16_t* source_pos(const SplatSource* source, u32 index) {
+    return source->hot ? source->hot[index].pos : source->splats[index].pos;
+}
+
+static inline fixed16_t source_radius(const SplatSource* source, u32 index) {
+    return source->hot ? source->hot[index].radius : gaussian_splat_bounding_radius(&source->splats[index]);
 }
 
 // Point-plane distance test
@@ -93,6 +201,56 @@ static inline fixed16_t point_plane_distance(const fixed16_t point[3], const Fru
     return fixed16_dot3(point, plane->normal) + plane->distance;
 }
 
+// Four spheres as x, y, z and radius lanes: the hot stream is already one
+// qword per sphere, AoS records are gathered lane by lane.
+// Lanes past count repeat the last sphere.
+static inline void source_spheres_x4(const SplatSource* source, const u32* indices, u32 first, u32 count,
+                                     fixed16x4 lanes[4]) {
+    u32 index[4];
+    for (u32 k = 0; k < 4; k++) {
+        u32 i = (k < count) ? k : count - 1;
+        index[k] = indices ? indices[first + i] : first + i;
+    }
+    
+    if (source->hot) {
+        for (u32 k = 0; k < 4; k++) {
+            lanes[k] = fixed16x4_load(source->hot[index[k]].pos);
+        }
+        fixed16x4_transpose(&lanes[0], &lanes[1], &lanes[2], &lanes[3]);
+        return;
+    }
+    
+    const fixed16_t* p[4];
+    for (u32 k = 0; k < 4; k++) {
+        p[k] = source->splats[index[k]].pos;
+    }
+    lanes[0] = fixed16x4_set(p[0][0], p[1][0], p[2][0], p[3][0]);
+    lanes[1] = fixed16x4_set(p[0][1], p[1][1], p[2][1], p[3][1]);
+    lanes[2] = fixed16x4_set(p[0][2], p[1][2], p[2][2], p[3][2]);
+    lanes[3] = fixed16x4_set(gaussian_splat_bounding_radius(&source->splats[index[0]]),
+                             gaussian_splat_bounding_radius(&source->splats[index[1]]),
+                             gaussian_splat_bounding_radius(&source->splats[index[2]]),
+                             gaussian_splat_bounding_radius(&source->splats[index[3]]));
+}
+
+// Plane tests for four spheres at once against the planes in plane_mask.
+// Returns bit k set where sphere k lies completely outside one of them.
+static inline u32 spheres_outside_frustum_x4(const fixed16x4 lanes[4], const FrustumInternal* frustum,
+                                             u32 plane_mask) {
+    fixed16x4 neg_radius = fixed16x4_sub((fixed16x4)0, lanes[3]);
+    fixed16x4 outside = (fixed16x4)0;
+    
+    for (int i = 0; i < 6; i++) {
+        if (!(plane_mask & (1u << i))) continue;
+        const fixed16x4* plane = frustum->planes_x4[i];
+        fixed16x4 distance = fixed16x4_add(fixed16x4_dot3(lanes[0], lanes[1], lanes[2],
+                                                          plane[0], plane[1], plane[2]), plane[3]);
+        outside = fixed16x4_or(outside, fixed16x4_cmplt(distance, neg_radius));
+    }
+    
+    return fixed16x4_sign_mask(outside);
+}
+
 // Sphere-frustum intersection test
 static bool sphere_intersects_frustum(const fixed16_t center[3], fixed16_t radius, const FrustumInternal* frustum) {
     for (int i = 0; i < 6; i++) {
@@ -104,106 +262,712 @@ static bool sphere_intersects_frustum(const fixed16_t center[3], fixed16_t radiu
     return true;  // Sphere intersects or is inside frustum
 }
 
-// AABB-frustum intersection test
-static bool aabb_intersects_frustum(const fixed16_t min_bounds[3], const fixed16_t max_bounds[3], const FrustumInternal* frustum) {
+// AABB-frustum classification
+// Only planes set in *plane_mask are tested; planes the box is fully inside
+// are cleared so children skip them.
+static int aabb_classify_frustum(const fixed16_t min_bounds[3], const fixed16_t max_bounds[3],
+                                 const FrustumInternal* frustum, u32* plane_mask) {
+    u32 mask = *plane_mask;
+    
     for (int i = 0; i < 6; i++) {
+        if (!(mask & (1u << i))) continue;
         const FrustumPlane* plane = &frustum->planes[i];
         
-        // Find the positive vertex (farthest along plane normal)
-        fixed16_t positive_vertex[3];
-        positive_vertex[0] = (plane->normal[0] >= 0) ? max_bounds[0] : min_bounds[0];
-        positive_vertex[1] = (plane->normal[1] >= 0) ? max_bounds[1] : min_bounds[1];
-        positive_vertex[2] = (plane->normal[2] >= 0) ? max_bounds[2] : min_bounds[2];
+        // Positive vertex (farthest along plane normal) and negative vertex (nearest)
+        fixed16_t positive_vertex[3], negative_vertex[3];
+        for (int j = 0; j < 3; j++) {
+            bool positive = plane->normal[j] >= 0;
+            positive_vertex[j] = positive ? max_bounds[j] : min_bounds[j];
+            negative_vertex[j] = positive ? min_bounds[j] : max_bounds[j];
+        }
         
         // If positive vertex is outside plane, AABB is completely outside
         if (point_plane_distance(positive_vertex, plane) < 0) {
-            return false;
+            return CULL_OUTSIDE;
+        }
+        
+        // Negative vertex inside: the whole box is inside this plane
+        if (point_plane_distance(negative_vertex, plane) >= 0) {
+            mask &= ~(1u << i);
         }
     }
+    
+    *plane_mask = mask;
+    return (mask == 0) ? CULL_INSIDE : CULL_INTERSECT;
+}
+
+// Drop the refit lookups; the next refit rebuilds them for the current layout
+static void octree_refit_map_free(void) {
+    free(g_octree.splat_leaf);
+    free(g_octree.node_parent);
+    g_octree.splat_leaf = NULL;
+    g_octree.node_parent = NULL;
+}
+
+// Release octree storage
+static void octree_free(void) {
+    g_node_history.valid = false;
+    octree_refit_map_free();
+    if (!g_octree.cooked) {
+        if (g_octree.nodes) free(g_octree.nodes);
+        if (g_octree.splat_indices) free(g_octree.splat_indices);
+    }
+    memset(&g_octree, 0, sizeof(g_octree));
+}
+
+// Allocate storage for a tree over splat_count splats
+static bool octree_alloc(u32 splat_count) {
+    octree_free();
+    
+    g_octree.node_capacity = MAX(64, splat_count / (OCTREE_LEAF_SPLATS / 2));
+    g_octree.nodes = (OctreeNode*)malloc(g_octree.node_capacity * sizeof(OctreeNode));
+    g_octree.splat_indices = (u32*)malloc(splat_count * sizeof(u32));
+    
+    if (!g_octree.nodes || !g_octree.splat_indices) {
+        octree_free();
+        return false;
+    }
     return true;
 }
 
-// Initialize spatial grid
-GaussianResult init_spatial_grid(const GaussianSplat3D* splats, u32 splat_count) {
-    if (!splats || splat_count == 0) {
-        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+// Reserve count contiguous nodes, returns the first index or -1
+static int octree_reserve_nodes(u32 count) {
+    if (g_octree.node_count + count > g_octree.node_capacity) {
+        u32 new_capacity = (g_octree.node_count + count) * 2;
+        OctreeNode* grown = (OctreeNode*)realloc(g_octree.nodes, new_capacity * sizeof(OctreeNode));
+        if (!grown) {
+            return -1;
+        }
+        g_octree.nodes = grown;
+        g_octree.node_capacity = new_capacity;
     }
     
-    // Calculate world bounds
-    g_spatial_grid.world_min[0] = g_spatial_grid.world_max[0] = splats[0].pos[0];
-    g_spatial_grid.world_min[1] = g_spatial_grid.world_max[1] = splats[0].pos[1];
-    g_spatial_grid.world_min[2] = g_spatial_grid.world_max[2] = splats[0].pos[2];
+    int first = (int)g_octree.node_count;
+    g_octree.node_count += count;
+    memset(&g_octree.nodes[first], 0, count * sizeof(OctreeNode));
+    return first;
+}
+
+// Recursively split a node's index range into octants around the cell center
+static bool octree_build_node(const SplatSource* source, u32 node_index,
+                              const fixed16_t cell_min[3], const fixed16_t cell_max[3],
+                              u32* scratch) {
+    OctreeNode* node = &g_octree.nodes[node_index];
+    u32 first = node->splat_first;
+    u32 count = node->splat_count;
+    u32 depth = node->depth;
+    
+    if (count <= OCTREE_LEAF_SPLATS || depth >= OCTREE_MAX_DEPTH) {
+        return true;  // Leaf; deep leaves keep every splat
+    }
+    
+    fixed16_t center[3];
+    for (int j = 0; j < 3; j++) {
+        center[j] = cell_min[j] + ((cell_max[j] - cell_min[j]) >> 1);
+    }
     
-    for (u32 i = 1; i < splat_count; i++) {
+    // Counting sort of the range by octant
+    u32 octant_counts[8] = {0};
+    u32* indices = &g_octree.splat_indices[first];
+    for (u32 i = 0; i < count; i++) {
+        const fixed16_t* pos = source_pos(source, indices[i]);
+        u32 octant = (pos[0] >= center[0] ? 1 : 0) | (pos[1] >= center[1] ? 2 : 0) |
+                     (pos[2] >= center[2] ? 4 : 0);
+        scratch[i] = octant;
+        octant_counts[octant]++;
+    }
+    
+    u32 child_count = 0;
+    u32 octant_offsets[8];
+    u32 offset = 0;
+    for (u32 o = 0; o < 8; o++) {
+        octant_offsets[o] = offset;
+        offset += octant_counts[o];
+        if (octant_counts[o] > 0) child_count++;
+    }
+    
+    // Scatter indices into octant order; the high scratch half holds the copy
+    u32* sorted = &scratch[count];
+    for (u32 i = 0; i < count; i++) {
+        sorted[octant_offsets[scratch[i]]++] = indices[i];
+    }
+    memcpy(indices, sorted, count * sizeof(u32));
+    
+    int first_child = octree_reserve_nodes(child_count);
+    if (first_child < 0) {
+        return false;
+    }
+    node = &g_octree.nodes[node_index];  // Array may have moved
+    node->first_child = (u32)first_child;
+    node->child_count = (u8)child_count;
+    
+    u32 child = (u32)first_child;
+    u32 range_start = first;
+    for (u32 o = 0; o < 8; o++) {
+        if (octant_counts[o] == 0) continue;
+        
+        fixed16_t child_min[3], child_max[3];
         for (int j = 0; j < 3; j++) {
-            if (splats[i].pos[j] < g_spatial_grid.world_min[j]) {
-                g_spatial_grid.world_min[j] = splats[i].pos[j];
+            bool upper = (o >> j) & 1;
+            child_min[j] = upper ? center[j] : cell_min[j];
+            child_max[j] = upper ? cell_max[j] : center[j];
+        }
+        
+        g_octree.nodes[child].splat_first = range_start;
+        g_octree.nodes[child].splat_count = octant_counts[o];
+        g_octree.nodes[child].depth = (u8)(depth + 1);
+        range_start += octant_counts[o];
+        
+        if (!octree_build_node(source, child, child_min, child_max, scratch)) {
+            return false;
+        }
+        child++;
+    }
+    
+    return true;
+}
+
+// Recompute one node's bounds from its splats, or from its children's
+// bounds; returns whether they changed
+static bool octree_fit_node(const SplatSource* source, u32 n) {
+    OctreeNode* node = &g_octree.nodes[n];
+    fixed16_t bounds_min[3], bounds_max[3];
+    for (int j = 0; j < 3; j++) {
+        bounds_min[j] = FIXED16_MAX;
+        bounds_max[j] = FIXED16_MIN;
+    }
+    
+    if (node->child_count == 0) {
+        for (u32 i = 0; i < node->splat_count; i++) {
+            u32 splat_idx = g_octree.splat_indices[node->splat_first + i];
+            const fixed16_t* pos = source_pos(source, splat_idx);
+            fixed16_t radius = source_radius(source, splat_idx);
+            for (int j = 0; j < 3; j++) {
+                bounds_min[j] = MIN(bounds_min[j], pos[j] - radius);
+                bounds_max[j] = MAX(bounds_max[j], pos[j] + radius);
             }
-            if (splats[i].pos[j] > g_spatial_grid.world_max[j]) {
-                g_spatial_grid.world_max[j] = splats[i].pos[j];
+        }
+    } else {
+        for (u32 c = 0; c < node->child_count; c++) {
+            const OctreeNode* child = &g_octree.nodes[node->first_child + c];
+            for (int j = 0; j < 3; j++) {
+                bounds_min[j] = MIN(bounds_min[j], child->bounds_min[j]);
+                bounds_max[j] = MAX(bounds_max[j], child->bounds_max[j]);
             }
         }
     }
     
+    bool changed = false;
+    for (int j = 0; j < 3; j++) {
+        changed |= node->bounds_min[j] != bounds_min[j] || node->bounds_max[j] != bounds_max[j];
+        node->bounds_min[j] = bounds_min[j];
+        node->bounds_max[j] = bounds_max[j];
+    }
+    return changed;
+}
+
+// Recompute node bounds bottom-up from splat positions and radii.
+// Children always follow their parent in the array, so one reverse walk suffices.
+static void octree_refit_bounds(const SplatSource* source) {
+    for (int n = (int)g_octree.node_count - 1; n >= 0; n--) {
+        octree_fit_node(source, (u32)n);
+    }
+}
+
+// Build the adaptive octree used for hierarchical culling
+static GaussianResult octree_build(const SplatSource* source, u32 splat_count) {
+    if (!octree_alloc(splat_count)) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    // Two u32 per splat: octant codes and the scatter copy
+    u32* scratch = (u32*)malloc(splat_count * 2 * sizeof(u32));
+    if (!scratch) {
+        octree_free();
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    // Calculate world bounds
+    fixed16_t world_min[3], world_max[3];
+    for (int j = 0; j < 3; j++) {
+        world_min[j] = world_max[j] = source_pos(source, 0)[j];
+    }
+    for (u32 i = 0; i < splat_count; i++) {
+        const fixed16_t* pos = source_pos(source, i);
+        g_octree.splat_indices[i] = i;
+        for (int j = 0; j < 3; j++) {
+            if (pos[j] < world_min[j]) world_min[j] = pos[j];
+            if (pos[j] > world_max[j]) world_max[j] = pos[j];
+        }
+    }
+    
     // Add padding to avoid edge cases
     fixed16_t padding = fixed_from_float(1.0f);
-    for (int i = 0; i < 3; i++) {
-        g_spatial_grid.world_min[i] -= padding;
-        g_spatial_grid.world_max[i] += padding;
-        g_spatial_grid.cell_size[i] = (g_spatial_grid.world_max[i] - g_spatial_grid.world_min[i]) / 8;
-    }
-    
-    // Initialize cells
-    for (int z = 0; z < SPATIAL_GRID_SIZE_Z; z++) {
-        for (int y = 0; y < SPATIAL_GRID_SIZE_Y; y++) {
-            for (int x = 0; x < SPATIAL_GRID_SIZE_X; x++) {
-                int cell_index = z * SPATIAL_GRID_SIZE_Y * SPATIAL_GRID_SIZE_X + y * SPATIAL_GRID_SIZE_X + x;
-                SpatialGridCell* cell = &g_spatial_grid.cells[cell_index];
-                
-                // Calculate cell bounds
-                cell->bounds_min[0] = g_spatial_grid.world_min[0] + fixed_mul(fixed_from_int(x), g_spatial_grid.cell_size[0]);
-                cell->bounds_min[1] = g_spatial_grid.world_min[1] + fixed_mul(fixed_from_int(y), g_spatial_grid.cell_size[1]);
-                cell->bounds_min[2] = g_spatial_grid.world_min[2] + fixed_mul(fixed_from_int(z), g_spatial_grid.cell_size[2]);
-                
-                cell->bounds_max[0] = cell->bounds_min[0] + g_spatial_grid.cell_size[0];
-                cell->bounds_max[1] = cell->bounds_min[1] + g_spatial_grid.cell_size[1];
-                cell->bounds_max[2] = cell->bounds_min[2] + g_spatial_grid.cell_size[2];
-                
-                cell->splat_count = 0;
-                cell->is_visible = false;
-                cell->last_visible_frame = 0;
+    for (int j = 0; j < 3; j++) {
+        world_min[j] -= padding;
+        world_max[j] += padding;
+    }
+    
+    octree_reserve_nodes(1);
+    g_octree.nodes[0].splat_first = 0;
+    g_octree.nodes[0].splat_count = splat_count;
+    
+    bool built = octree_build_node(source, 0, world_min, world_max, scratch);
+    free(scratch);
+    
+    if (!built) {
+        octree_free();
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    octree_refit_bounds(source);
+    g_octree.total_splats = splat_count;
+    g_octree.imported = false;
+    g_octree.initialized = true;
+    
+    printf("SPLATSTORM X: Culling octree built (%u nodes, %u splats)\n",
+           g_octree.node_count, splat_count);
+    return GAUSSIAN_SUCCESS;
+}
+
+GaussianResult init_spatial_grid(const GaussianSplat3D* splats, u32 splat_count) {
+    if (!splats || splat_count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    SplatSource source = { splats, NULL };
+    return octree_build(&source, splat_count);
+}
+
+// Same octree from the hot stream only
+GaussianResult init_spatial_grid_streams(const GaussianSplatStreams* streams) {
+    if (!streams || !streams->hot || streams->count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    SplatSource source = { NULL, streams->hot };
+    return octree_build(&source, streams->count);
+}
+
+// Import one node of an exported octree.idx, depth first.
+// Exported leaves whose splats were already placed are deduplicated via seen[].
+// A file node reached a second time (a child shared by several parents) is
+// rejected via visited[], so a malformed file cannot multiply the node array.
+static bool octree_import_node(const u32* file_nodes, u32 file_node_count, u32 file_index,
+                               u32 node_index, u32 splat_count, u8* seen, u8* visited) {
+    if (visited[file_index]) return false;
+    visited[file_index] = 1;
+    
+    const u32* src = &file_nodes[file_index * OCTREE_FILE_NODE_WORDS];
+    OctreeNode* node = &g_octree.nodes[node_index];
+    node->splat_first = g_octree.total_splats;
+    
+    if (src[0] == 1) {
+        // Leaf: count, then up to 8 splat indices
+        u32 leaf_count = MIN(src[1], OCTREE_FILE_LEAF_SLOTS);
+        for (u32 i = 0; i < leaf_count; i++) {
+            u32 splat_idx = src[2 + i];
+            if (splat_idx >= splat_count) return false;
+            if (seen[splat_idx]) continue;
+            seen[splat_idx] = 1;
+            g_octree.splat_indices[g_octree.total_splats++] = splat_idx;
+        }
+    } else {
+        // Internal: 8 signed child offsets; children must follow the parent
+        u32 children[8];
+        u32 child_count = 0;
+        for (u32 i = 0; i < 8; i++) {
+            s32 child = (s32)src[2 + i];
+            if (child < 0) continue;
+            if ((u32)child <= file_index || (u32)child >= file_node_count) return false;
+            children[child_count++] = (u32)child;
+        }
+        
+        if (child_count > 0) {
+            if (node->depth >= OCTREE_MAX_DEPTH) return false;
+            
+            int first_child = octree_reserve_nodes(child_count);
+            if (first_child < 0) return false;
+            node = &g_octree.nodes[node_index];  // Array may have moved
+            node->first_child = (u32)first_child;
+            node->child_count = (u8)child_count;
+            
+            for (u32 c = 0; c < child_count; c++) {
+                g_octree.nodes[first_child + c].depth = (u8)(node->depth + 1);
+                if (!octree_import_node(file_nodes, file_node_count, children[c],
+                                        first_child + c, splat_count, seen, visited)) {
+                    return false;
+                }
+                node = &g_octree.nodes[node_index];
             }
         }
     }
     
-    // Assign splats to cells
-    for (u32 i = 0; i < splat_count; i++) {
-        // Calculate cell coordinates
-        int cell_x = fixed_to_int((splats[i].pos[0] - g_spatial_grid.world_min[0]) / g_spatial_grid.cell_size[0]);
-        int cell_y = fixed_to_int((splats[i].pos[1] - g_spatial_grid.world_min[1]) / g_spatial_grid.cell_size[1]);
-        int cell_z = fixed_to_int((splats[i].pos[2] - g_spatial_grid.world_min[2]) / g_spatial_grid.cell_size[2]);
+    node->splat_count = g_octree.total_splats - node->splat_first;
+    return true;
+}
+
+// Load the octree exported by tools/splat_to_atlas.py (octree.idx) so the
+// tree is not rebuilt at boot. The exported topology is kept and bounds are
+// refit with splat radii. Fails if any splat is missing from the file.
+GaussianResult load_octree_index(const char* filename, const GaussianSplat3D* splats, u32 splat_count) {
+    if (!filename || !splats || splat_count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    // Header: node count, max depth. A count whose node array size would
+    // wrap is malformed
+    u32 header[2];
+    if (fread(header, sizeof(u32), 2, file) != 2 || header[0] == 0 ||
+        header[0] > 0xFFFFFFFFu / (OCTREE_FILE_NODE_WORDS * sizeof(u32))) {
+        fclose(file);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    u32 file_node_count = header[0];
+    u32* file_nodes = (u32*)malloc(file_node_count * OCTREE_FILE_NODE_WORDS * sizeof(u32));
+    u8* seen = (u8*)calloc(splat_count, sizeof(u8));
+    u8* visited = (u8*)calloc(file_node_count, sizeof(u8));
+    if (!file_nodes || !seen || !visited) {
+        if (file_nodes) free(file_nodes);
+        if (seen) free(seen);
+        if (visited) free(visited);
+        fclose(file);
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    size_t words = (size_t)file_node_count * OCTREE_FILE_NODE_WORDS;
+    bool read_ok = fread(file_nodes, sizeof(u32), words, file) == words;
+    fclose(file);
+    
+    GaussianResult result = GAUSSIAN_ERROR_INVALID_FORMAT;
+    if (read_ok && octree_alloc(splat_count) && octree_reserve_nodes(1) == 0) {
+        if (octree_import_node(file_nodes, file_node_count, 0, 0, splat_count, seen, visited) &&
+            g_octree.total_splats == splat_count) {
+            result = GAUSSIAN_SUCCESS;
+        }
+    }
+    
+    free(file_nodes);
+    free(seen);
+    free(visited);
+    
+    if (result != GAUSSIAN_SUCCESS) {
+        // Exported leaves hold at most 8 splats; dense files may not cover the scene
+        printf("SPLATSTORM X: Octree index %s rejected (%u of %u splats)\n",
+               filename, g_octree.total_splats, splat_count);
+        octree_free();
+        return result;
+    }
+    
+    SplatSource source = { splats, NULL };
+    octree_refit_bounds(&source);
+    g_octree.imported = true;
+    g_octree.initialized = true;
+    
+    printf("SPLATSTORM X: Culling octree loaded from %s (%u nodes)\n", filename, g_octree.node_count);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Children follow their parent and stay inside the node array
+static bool octree_node_links_valid(const OctreeNode* node, u32 index, u32 node_count) {
+    if (node->depth > OCTREE_MAX_DEPTH) {
+        return false;
+    }
+    return node->child_count == 0 ||
+           (node->child_count <= 8 && node->first_child > index &&
+            node->first_child + node->child_count <= node_count);
+}
+
+// Adopt the octree of a cooked scene in place: nodes already carry their
+// radius-padded bounds, so nothing is built or copied. The topology is only
+// checked for the invariants traversal relies on. refit_streams, when given,
+// recomputes the bounds from decoded splats (packed scenes quantize positions).
+GaussianResult init_spatial_grid_cooked(void* nodes, u32 node_count, u32 node_stride,
+                                        u32* splat_indices, u32 splat_count,
+                                        const GaussianSplatStreams* refit_streams) {
+    if (!nodes || node_count == 0 || !splat_indices || splat_count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (node_stride != sizeof(OctreeNode)) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    const OctreeNode* cooked = (const OctreeNode*)nodes;
+    if (cooked[0].splat_first != 0 || cooked[0].splat_count != splat_count) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    for (u32 n = 0; n < node_count; n++) {
+        const OctreeNode* node = &cooked[n];
+        if (node->splat_first + node->splat_count > splat_count || !octree_node_links_valid(node, n, node_count)) {
+            return GAUSSIAN_ERROR_INVALID_FORMAT;
+        }
+    }
+    
+    octree_free();
+    g_octree.nodes = (OctreeNode*)nodes;
+    g_octree.node_count = node_count;
+    g_octree.node_capacity = node_count;
+    g_octree.splat_indices = splat_indices;
+    g_octree.total_splats = splat_count;
+    g_octree.imported = true;
+    g_octree.cooked = true;
+    g_octree.initialized = true;
+    
+    if (refit_streams) {
+        SplatSource source = { NULL, refit_streams->hot };
+        octree_refit_bounds(&source);
+    }
+    
+    printf("SPLATSTORM X: Culling octree adopted from cooked scene (%u nodes)\n", node_count);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Adopt the page tree of a paged scene in place. Its leaves are pages whose
+// entries change as pages load and leave, so every range starts empty and is
+// laid out by spatial_grid_set_leaf_counts(); index_capacity bounds them all.
+GaussianResult init_spatial_grid_paged(void* nodes, u32 node_count, u32 node_stride,
+                                       u32* splat_indices, u32 index_capacity, u32 leaf_count) {
+    if (!nodes || node_count == 0 || !splat_indices || index_capacity == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (node_stride != sizeof(OctreeNode)) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    OctreeNode* paged = (OctreeNode*)nodes;
+    u32 leaves = 0;
+    for (u32 n = 0; n < node_count; n++) {
+        if (!octree_node_links_valid(&paged[n], n, node_count)) {
+            return GAUSSIAN_ERROR_INVALID_FORMAT;
+        }
+        if (paged[n].child_count == 0) {
+            leaves++;
+        }
+    }
+    if (leaves != leaf_count) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    for (u32 n = 0; n < node_count; n++) {
+        paged[n].splat_first = 0;
+        paged[n].splat_count = 0;
+    }
+    
+    octree_free();
+    g_octree.nodes = paged;
+    g_octree.node_count = node_count;
+    g_octree.node_capacity = node_count;
+    g_octree.splat_indices = splat_indices;
+    g_octree.total_splats = index_capacity;
+    g_octree.imported = true;
+    g_octree.cooked = true;
+    g_octree.initialized = true;
+    
+    printf("SPLATSTORM X: Culling page tree adopted (%u nodes, %u pages)\n", node_count, leaf_count);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Lay out the adopted page tree's index ranges. leaf_counts holds each leaf's
+// entries in depth-first order, which is the order the caller packs them into
+// the index array; inner nodes cover the union of their leaves.
+GaussianResult spatial_grid_set_leaf_counts(const u32* leaf_counts, u32 leaf_count) {
+    if (!g_octree.initialized || !g_octree.cooked || !leaf_counts) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    u32 total = 0;
+    for (u32 l = 0; l < leaf_count; l++) {
+        total += leaf_counts[l];
+    }
+    if (total > g_octree.total_splats) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    octree_refit_map_free();
+    
+    // Depth-first: each leaf takes the next run of the index array
+    u32 stack[OCTREE_STACK_SIZE];
+    u32 stack_size = 0;
+    u32 cursor = 0;
+    u32 leaf = 0;
+    stack[stack_size++] = 0;
+    
+    while (stack_size > 0) {
+        OctreeNode* node = &g_octree.nodes[stack[--stack_size]];
+        node->splat_first = cursor;
         
-        // Clamp to grid bounds
-        cell_x = (cell_x < 0) ? 0 : (cell_x >= SPATIAL_GRID_SIZE_X) ? SPATIAL_GRID_SIZE_X - 1 : cell_x;
-        cell_y = (cell_y < 0) ? 0 : (cell_y >= SPATIAL_GRID_SIZE_Y) ? SPATIAL_GRID_SIZE_Y - 1 : cell_y;
-        cell_z = (cell_z < 0) ? 0 : (cell_z >= SPATIAL_GRID_SIZE_Z) ? SPATIAL_GRID_SIZE_Z - 1 : cell_z;
+        if (node->child_count == 0) {
+            if (leaf == leaf_count) {
+                return GAUSSIAN_ERROR_INVALID_FORMAT;
+            }
+            node->splat_count = leaf_counts[leaf++];
+            cursor += node->splat_count;
+            continue;
+        }
         
-        int cell_index = cell_z * SPATIAL_GRID_SIZE_Y * SPATIAL_GRID_SIZE_X + cell_y * SPATIAL_GRID_SIZE_X + cell_x;
-        SpatialGridCell* cell = &g_spatial_grid.cells[cell_index];
+        if (stack_size + node->child_count > OCTREE_STACK_SIZE) {
+            return GAUSSIAN_ERROR_INVALID_FORMAT;
+        }
+        for (u32 c = node->child_count; c > 0; c--) {
+            stack[stack_size++] = node->first_child + c - 1;
+        }
+    }
+    if (leaf != leaf_count) {
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    // Children follow their parent, so a reverse sweep sums them bottom-up
+    for (u32 n = g_octree.node_count; n > 0; n--) {
+        OctreeNode* node = &g_octree.nodes[n - 1];
+        if (node->child_count == 0) continue;
         
-        // Add splat to cell if there's room
-        if (cell->splat_count < MAX_SPLATS_PER_CELL) {
-            cell->splat_indices[cell->splat_count] = i;
-            cell->splat_count++;
+        node->splat_count = 0;
+        for (u32 c = 0; c < node->child_count; c++) {
+            node->splat_count += g_octree.nodes[node->first_child + c].splat_count;
         }
     }
     
-    g_spatial_grid.total_splats = splat_count;
-    g_spatial_grid.initialized = true;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Current tree in the cooked-scene layout, for writing it back out (scene cache)
+GaussianResult spatial_grid_export(const void** nodes, u32* node_count, u32* node_stride,
+                                   const u32** splat_indices, u32* splat_count) {
+    if (!nodes || !node_count || !node_stride || !splat_indices || !splat_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (!g_octree.initialized) {
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+    
+    *nodes = g_octree.nodes;
+    *node_count = g_octree.node_count;
+    *node_stride = sizeof(OctreeNode);
+    *splat_indices = g_octree.splat_indices;
+    *splat_count = g_octree.total_splats;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Follow a reorder of the splat array (remap[old] = new) without rebuilding
+// the tree; node bounds do not depend on splat order
+GaussianResult spatial_grid_remap_splats(const u32* remap, u32 splat_count) {
+    if (!remap || !g_octree.initialized || splat_count < g_octree.total_splats) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    for (u32 i = 0; i < g_octree.total_splats; i++) {
+        g_octree.splat_indices[i] = remap[g_octree.splat_indices[i]];
+    }
+    octree_refit_map_free();
+    memset(&g_visibility_history, 0, sizeof(g_visibility_history));
+    importance_rank_reset();
+    return GAUSSIAN_SUCCESS;
+}
+
+// Reorder the splats into the tree's index order and make the index array the
+// identity, so every node covers one contiguous run of splat records. Octants
+// are taken x, y, z at every split, so leaves come out in adaptive Morton
+// order; splats inside a leaf keep their current relative order.
+GaussianResult spatial_grid_linearize(GaussianSplat3D* splats, GaussianSplatStreams* streams, u32 splat_count) {
+    if (!splats || !g_octree.initialized || splat_count != g_octree.total_splats) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    GaussianResult result = gaussian_splats_permute(splats, streams, splat_count, g_octree.splat_indices, NULL);
+    if (result != GAUSSIAN_SUCCESS) {
+        return result;
+    }
     
+    for (u32 i = 0; i < splat_count; i++) {
+        g_octree.splat_indices[i] = i;
+    }
+    octree_refit_map_free();
+    memset(&g_visibility_history, 0, sizeof(g_visibility_history));
+    importance_rank_reset();  // Codes follow the records: the next capped pass retakes them
     return GAUSSIAN_SUCCESS;
 }
 
+// Leaf of every splat and parent of every node, for refits
+static bool octree_refit_map_build(void) {
+    if (g_octree.splat_leaf) {
+        return true;
+    }
+    
+    g_octree.splat_leaf = (u32*)malloc(g_octree.total_splats * sizeof(u32));
+    g_octree.node_parent = (u32*)malloc(g_octree.node_count * sizeof(u32));
+    if (!g_octree.splat_leaf || !g_octree.node_parent) {
+        octree_refit_map_free();
+        return false;
+    }
+    
+    memset(g_octree.splat_leaf, 0xFF, g_octree.total_splats * sizeof(u32));
+    g_octree.node_parent[0] = 0;
+    for (u32 n = 0; n < g_octree.node_count; n++) {
+        const OctreeNode* node = &g_octree.nodes[n];
+        for (u32 c = 0; c < node->child_count; c++) {
+            g_octree.node_parent[node->first_child + c] = n;
+        }
+        for (u32 i = 0; node->child_count == 0 && i < node->splat_count; i++) {
+            u32 splat_idx = g_octree.splat_indices[node->splat_first + i];
+            if (splat_idx < g_octree.total_splats) {
+                g_octree.splat_leaf[splat_idx] = n;
+            }
+        }
+    }
+    return true;
+}
+
+// A node whose bounds moved cannot be classified from its history
+static void node_history_forget(u32 node_index) {
+    if (g_node_history.valid && node_index < g_node_history.capacity) {
+        g_node_history.nodes[node_index].confidence = 0;
+    }
+}
+
+/*
+ * Refit the tree after splats first..first + count - 1 moved or changed
+ * size: their leaves are refit from their splats, then each ancestor from
+ * its children until one comes out unchanged. The topology stays; a splat
+ * that moved far only loosens its leaf. Reads the hot stream when streams
+ * covers the tree, the records otherwise. Returns the nodes that changed.
+ */
+u32 spatial_grid_refit_splats(const GaussianSplat3D* splats, const GaussianSplatStreams* streams,
+                              u32 first, u32 count) {
+    if (!g_octree.initialized || first >= g_octree.total_splats || !octree_refit_map_build()) {
+        return 0;
+    }
+    
+    bool stream_source = streams && streams->hot && streams->count >= g_octree.total_splats;
+    if (!stream_source && !splats) {
+        return 0;
+    }
+    SplatSource source = { stream_source ? NULL : splats, stream_source ? streams->hot : NULL };
+    
+    u32 end = MIN(first + count, g_octree.total_splats);
+    u32 last_leaf = 0xFFFFFFFF;
+    u32 changed = 0;
+    for (u32 i = first; i < end; i++) {
+        // Linearized scenes put neighbouring splats in one leaf
+        u32 n = g_octree.splat_leaf[i];
+        if (n == 0xFFFFFFFF || n == last_leaf) continue;
+        last_leaf = n;
+        
+        while (octree_fit_node(&source, n)) {
+            node_history_forget(n);
+            changed++;
+            if (n == 0) break;
+            n = g_octree.node_parent[n];
+        }
+    }
+    return changed;
+}
+
 // Extract frustum planes from camera matrices
 GaussianResult extract_frustum_planes(const fixed16_t view_proj_matrix[16], void* frustum_ptr) {
     FrustumInternal* frustum = (FrustumInternal*)frustum_ptr;
@@ -258,14 +1022,155 @@ GaussianResult extract_frustum_planes(const fixed16_t view_proj_matrix[16], void
             frustum->planes[i].normal[2] = fixed_mul(frustum->planes[i].normal[2], inv_length);
             frustum->planes[i].distance = fixed_mul(frustum->planes[i].distance, inv_length);
         }
+        
+        frustum->planes_x4[i][0] = fixed16x4_splat(frustum->planes[i].normal[0]);
+        frustum->planes_x4[i][1] = fixed16x4_splat(frustum->planes[i].normal[1]);
+        frustum->planes_x4[i][2] = fixed16x4_splat(frustum->planes[i].normal[2]);
+        frustum->planes_x4[i][3] = fixed16x4_splat(frustum->planes[i].distance);
     }
     
     return GAUSSIAN_SUCCESS;
 }
 
+// Whether last frame's opaque tiles hide a node. The box corners are
+// projected with the float view-projection; the screen rectangle and the
+// nearest corner's Z24 go to the tile rasterizer's occlusion pyramid.
+static bool node_occluded(const OctreeNode* node) {
+    const float* m = g_frustum_cache.view_proj_f;
+    float min_x = 1e30f, min_y = 1e30f, max_x = -1e30f, max_y = -1e30f;
+    float min_w = 1e30f;
+    
+    for (u32 corner = 0; corner < 8; corner++) {
+        float x = fixed_to_float((corner & 1) ? node->bounds_max[0] : node->bounds_min[0]);
+        float y = fixed_to_float((corner & 2) ? node->bounds_max[1] : node->bounds_min[1]);
+        float z = fixed_to_float((corner & 4) ? node->bounds_max[2] : node->bounds_min[2]);
+        
+        float w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        if (w <= OCCLUSION_NEAR_W) {
+            return false;  // Box crosses the eye plane: no bounded projection
+        }
+        float inv_w = 1.0f / w;
+        float ndc_x = (m[0] * x + m[4] * y + m[8] * z + m[12]) * inv_w;
+        float ndc_y = (m[1] * x + m[5] * y + m[9] * z + m[13]) * inv_w;
+        
+        min_x = MIN(min_x, ndc_x);
+        max_x = MAX(max_x, ndc_x);
+        min_y = MIN(min_y, ndc_y);
+        max_y = MAX(max_y, ndc_y);
+        min_w = MIN(min_w, w);
+    }
+    
+    float nearest = OCCLUSION_DEPTH_SCALE / min_w;
+    if (nearest >= 4294967040.0f) {
+        return false;
+    }
+    return tile_occlusion_test(min_x, min_y, max_x, max_y, (u32)nearest);
+}
+
+// Fresh node history for the current tree; false without memory
+static bool node_history_prepare(void) {
+    if (g_node_history.valid) {
+        return true;
+    }
+    
+    if (g_octree.node_count > g_node_history.capacity) {
+        NodeVisibility* grown = (NodeVisibility*)realloc(g_node_history.nodes,
+                                                         g_octree.node_count * sizeof(NodeVisibility));
+        if (!grown) {
+            return false;
+        }
+        g_node_history.nodes = grown;
+        g_node_history.capacity = g_octree.node_count;
+    }
+    memset(g_node_history.nodes, 0, g_octree.node_count * sizeof(NodeVisibility));
+    g_node_history.valid = true;
+    return true;
+}
+
+// Accumulate how far the planes moved since the last frame for any point in
+// the scene: |n1.p + d1 - n0.p - d0| <= |n1 - n0|_1 * max|p| + |d1 - d0|
+static void node_history_track_planes(const FrustumInternal* frustum) {
+    const OctreeNode* root = &g_octree.nodes[0];
+    fixed16_t extent = 0;
+    for (int j = 0; j < 3; j++) {
+        extent = MAX(extent, MAX(fixed_abs(root->bounds_min[j]), fixed_abs(root->bounds_max[j])));
+    }
+    
+    s64 frame_drift = 0;
+    for (int i = 0; i < 6; i++) {
+        const FrustumPlane* plane = &frustum->planes[i];
+        s64 normal_delta = 0;
+        for (int j = 0; j < 3; j++) {
+            normal_delta += fixed_abs(plane->normal[j] - g_node_history.planes[i][j]);
+        }
+        s64 drift = ((normal_delta * extent) >> 16) + fixed_abs(plane->distance - g_node_history.planes[i][3]);
+        frame_drift = MAX(frame_drift, drift);
+        
+        g_node_history.planes[i][0] = plane->normal[0];
+        g_node_history.planes[i][1] = plane->normal[1];
+        g_node_history.planes[i][2] = plane->normal[2];
+        g_node_history.planes[i][3] = plane->distance;
+    }
+    
+    // First frame: nothing recorded can have been measured against other planes
+    if (g_node_history.planes_valid) {
+        g_node_history.drift += frame_drift;
+    }
+    g_node_history.planes_valid = true;
+}
+
+// Distance a classified box is from changing class, over all six planes
+static fixed16_t aabb_class_margin(const OctreeNode* node, const FrustumInternal* frustum, int classification) {
+    fixed16_t margin = (classification == CULL_INSIDE) ? FIXED16_MAX : 0;
+    
+    for (int i = 0; i < 6; i++) {
+        const FrustumPlane* plane = &frustum->planes[i];
+        fixed16_t positive_vertex[3], negative_vertex[3];
+        for (int j = 0; j < 3; j++) {
+            bool positive = plane->normal[j] >= 0;
+            positive_vertex[j] = positive ? node->bounds_max[j] : node->bounds_min[j];
+            negative_vertex[j] = positive ? node->bounds_min[j] : node->bounds_max[j];
+        }
+        
+        if (classification == CULL_INSIDE) {
+            margin = MIN(margin, point_plane_distance(negative_vertex, plane));
+        } else {
+            margin = MAX(margin, -point_plane_distance(positive_vertex, plane));
+        }
+    }
+    return margin;
+}
+
+// Class of a node still known from history, or -1 when it needs the test
+static int node_history_lookup(u32 node_index) {
+    const NodeVisibility* entry = &g_node_history.nodes[node_index];
+    if (entry->confidence < NODE_CONFIDENCE_FRAMES ||
+        g_node_history.drift - entry->drift_base >= entry->margin) {
+        return -1;
+    }
+    g_node_history.skipped_nodes++;
+    return entry->classification;
+}
+
+// Record a tested node: deep classes build confidence, the boundary resets it
+static void node_history_record(u32 node_index, const OctreeNode* node, const FrustumInternal* frustum,
+                                int classification) {
+    NodeVisibility* entry = &g_node_history.nodes[node_index];
+    if (classification == CULL_INTERSECT) {
+        entry->confidence = 0;
+        return;
+    }
+    
+    entry->confidence = (entry->classification == classification) ?
+                        MIN(entry->confidence + 1, NODE_CONFIDENCE_MAX) : 1;
+    entry->classification = (u8)classification;
+    entry->margin = aabb_class_margin(node, frustum, classification);
+    entry->drift_base = g_node_history.drift;
+}
+
 // Update visibility history
 static void update_visibility_history(u32 splat_index, bool is_visible) {
-    if (splat_index >= MAX_SPLATS_PER_SCENE) return;
+    if (splat_index >= MAX_SPLATS_PER_SCENE || g_instance_pass) return;
     
     // Shift history left and add new bit
     g_visibility_history.history[splat_index] <<= 1;
@@ -276,7 +1181,7 @@ static void update_visibility_history(u32 splat_index, bool is_visible) {
 
 // Check if splat has temporal coherence (visible for multiple frames)
 static bool has_temporal_coherence(u32 splat_index) {
-    if (splat_index >= MAX_SPLATS_PER_SCENE) return false;
+    if (splat_index >= MAX_SPLATS_PER_SCENE || g_instance_pass) return false;
     
     u8 history = g_visibility_history.history[splat_index];
     
@@ -284,138 +1189,652 @@ static bool has_temporal_coherence(u32 splat_index) {
     return (history & 0x07) == 0x07;
 }
 
-// VU0 batch processing for frustum culling (simplified - actual implementation would use VU0 assembly)
-static void vu0_cull_batch(const GaussianSplat3D* splats, const u32* indices, u32 count, 
-                          const FrustumInternal* frustum, bool* results) {
-    // This would be implemented in VU0 microcode for optimal performance
-    // For now, implement in C with SIMD-friendly operations
+// State of one cull_gaussian_splats pass
+typedef struct {
+    SplatSource source;                       // Sphere data for the tests
+    const GaussianSplat3D* input_splats;      // Scene splats, NULL in stream mode
+    const GaussianSplatStreams* streams;      // Scene streams, NULL in AoS mode
+    u32 input_count;                          // Splats this pass tests
+    GaussianSplat3D* output_splats;           // Visible splats out, NULL in index mode
+    u32* output_indices;                      // Visible scene indices out, NULL in copy mode
+    u32 output_capacity;                      // Visible splats the output holds
+    bool ranked;                              // Capped by importance code, not traversal order
+    u32 rank_limit;                           // Least important code this pass keeps
+    u32 limit_slots;                          // Splats of that code it may still keep
+    u32 visible_count;                        // Visible splats so far
+    const FrustumInternal* frustum;           // Planes for the EE tests
+} CullPass;
+
+// Leaf splats queued for the VU0 culling engine; one index list per VU0 buffer
+typedef struct {
+    bool enabled;                             // VU0 engine accepted this frame's planes
+    u32 indices[2][VU0_CULL_BATCH_SIZE];      // Splat index of each sphere slot
+    u32 counts[2];                            // Spheres submitted on each buffer
+    float* fill_spheres;                      // Sphere slots of the batch being filled
+    u32 fill_buffer;                          // VU0 buffer of the batch being filled
+    u32 fill_count;                           // Spheres in the batch being filled
+} VU0CullQueue;
+
+static VU0CullQueue g_vu0_queue = {0};
+
+// Leaf splats deferred to one scratchpad-streamed EE pass when VU0 is unavailable
+typedef struct {
+    u32* indices;                             // Splat indices awaiting the EE test
+    u32 count;                                // Indices queued this pass
+    u32 capacity;                             // Allocated entries
+} EECullQueue;
+
+static EECullQueue g_ee_queue = {0};
+
+// EE batch test, used when the VU0 engine is unavailable; four splats per MMI pass.
+// Only planes in plane_mask are tested; the rest were passed by the enclosing node.
+static void ee_cull_batch(const SplatSource* source, const u32* indices, u32 count, 
+                          const FrustumInternal* frustum, u32 plane_mask, bool* results) {
+    for (u32 i = 0; i < count; i += 4) {
+        u32 group = MIN(count - i, 4);
+        fixed16x4 lanes[4];
+        source_spheres_x4(source, indices, i, group, lanes);
+        
+        u32 outside = spheres_outside_frustum_x4(lanes, frustum, plane_mask);
+        for (u32 k = 0; k < group; k++) {
+            results[i + k] = !(outside & (1u << k));
+        }
+    }
+}
+
+// Importance code: 8 steps per octave of the importance metric, so splats
+// within ~12% of each other share a code. Descending: 0 is the most important
+static inline u8 importance_code(u32 importance) {
+    if (importance == 0) return IMPORTANCE_CODES - 1;
+    u32 octave = 31 - __builtin_clz(importance);
+    u32 step = (octave >= 3) ? (importance >> (octave - 3)) & 7 : (importance << (3 - octave)) & 7;
+    u32 level = MIN(octave * 8 + step + 1, IMPORTANCE_CODES - 1);
+    return (u8)(IMPORTANCE_CODES - 1 - level);
+}
+
+// Rank a capped scene pass: code any splats not coded yet (a new scene
+// restarts), then clear the histogram. Uncapped and instance passes keep
+// traversal order, as nothing is dropped or the asset has no codes.
+static bool importance_rank_prepare(CullPass* pass) {
+    if (g_instance_pass || !pass->input_splats || pass->output_capacity >= pass->input_count ||
+        pass->input_count > MAX_SPLATS_PER_SCENE) {
+        return false;
+    }
+    
+    if (g_importance.splats != pass->input_splats || pass->input_count < g_importance.coded_count) {
+        importance_rank_reset();
+        g_importance.splats = pass->input_splats;
+    }
+    for (u32 i = g_importance.coded_count; i < pass->input_count; i++) {
+        g_importance.code[i] = importance_code(pass->input_splats[i].importance);
+    }
+    g_importance.coded_count = pass->input_count;
+    memset(g_importance.histogram, 0, sizeof(g_importance.histogram));
     
+    pass->rank_limit = g_importance.limit;
+    pass->limit_slots = g_importance.limit_slots;
+    return true;
+}
+
+// Next pass's limit: the code where the visible splats, most important
+// first, reach the capacity, and the slots the codes above it leave it. It
+// lags the visible set by one pass: right after a view change a pass may
+// stop short of the cap, or trim splats just above the new limit in
+// traversal order.
+static void importance_rank_finish(const CullPass* pass) {
+    u32 kept = 0;
+    u32 limit = IMPORTANCE_CODES - 1;
+    u32 slots = 0xFFFFFFFFu;
+    for (u32 code = 0; code < IMPORTANCE_CODES; code++) {
+        if (kept + g_importance.histogram[code] >= pass->output_capacity) {
+            limit = code;
+            slots = pass->output_capacity - kept;
+            break;
+        }
+        kept += g_importance.histogram[code];
+    }
+    g_importance.limit = limit;
+    g_importance.limit_slots = slots;
+}
+
+// Records [first, first + count) of the coded scene were rewritten in place
+// (scene paging): take their importance again
+void cull_importance_invalidate(u32 first, u32 count) {
+    if (!g_importance.splats || first >= g_importance.coded_count) return;
+    
+    u32 end = MIN(first + count, g_importance.coded_count);
+    for (u32 i = first; i < end; i++) {
+        g_importance.code[i] = importance_code(g_importance.splats[i].importance);
+    }
+}
+
+// Mark a culled subtree's splats as not visible
+static void cull_splat_range(const u32* indices, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        update_visibility_history(indices[i], false);
+    }
+}
+
+// Copy one visible splat out; stream mode gathers it from hot + warm only,
+// index mode records only where it lives in the scene array. Past the
+// output's capacity the splat is dropped: the visible budget is full
+static inline void emit_visible_splat(CullPass* pass, u32 splat_idx) {
+    if (pass->ranked) {
+        u32 code = g_importance.code[splat_idx];
+        g_importance.histogram[code]++;
+        if (code > pass->rank_limit) return;
+        if (code == pass->rank_limit) {
+            // More important splats later in the traversal keep their slots
+            if (pass->limit_slots == 0) return;
+            pass->limit_slots--;
+        }
+    }
+    if (pass->visible_count >= pass->output_capacity) {
+        return;
+    }
+    
+    if (pass->output_indices) {
+        pass->output_indices[pass->visible_count++] = splat_idx;
+        return;
+    }
+    
+    GaussianSplat3D* out = &pass->output_splats[pass->visible_count++];
+    if (pass->streams) {
+        gaussian_splat_streams_gather(pass->streams, splat_idx, out);
+    } else {
+        *out = pass->input_splats[splat_idx];
+    }
+}
+
+// Emit a subtree that is fully inside the frustum without per-splat tests
+static void emit_splat_range(CullPass* pass, const u32* indices, u32 count) {
     for (u32 i = 0; i < count; i++) {
         u32 splat_idx = indices[i];
-        const GaussianSplat3D* splat = &splats[splat_idx];
-        
-        // Calculate splat radius
-        fixed16_t radius = calculate_splat_radius(splat);
-        
-        // Test against all frustum planes
-        bool visible = true;
-        for (int plane = 0; plane < 6; plane++) {
-            fixed16_t distance = point_plane_distance(splat->pos, &frustum->planes[plane]);
-            if (distance < -radius) {
-                visible = false;
-                break;
+        if (splat_idx >= pass->input_count) continue;  // Not one of this pass's splats
+        
+        update_visibility_history(splat_idx, true);
+        emit_visible_splat(pass, splat_idx);
+    }
+}
+
+// Record one plane-tested splat
+static void emit_tested_splat(CullPass* pass, u32 splat_idx, bool is_visible) {
+    // Temporal coherence: a splat seen the last three frames is kept one
+    // frame longer. The history takes the test result, so the grace frame
+    // does not renew itself
+    bool keep = is_visible || has_temporal_coherence(splat_idx);
+    update_visibility_history(splat_idx, is_visible);
+    
+    if (keep) {
+        emit_visible_splat(pass, splat_idx);
+    }
+}
+
+// Test a leaf's splats individually on the EE against the planes it straddles
+static void test_splat_range(CullPass* pass, const u32* indices, u32 count, u32 plane_mask) {
+    u32 batch_start = 0;
+    while (batch_start < count) {
+        u32 batch_size = (count - batch_start > EE_CULL_BATCH_SIZE) ? 
+                        EE_CULL_BATCH_SIZE : (count - batch_start);
+        
+        bool batch_results[EE_CULL_BATCH_SIZE];
+        ee_cull_batch(&pass->source, &indices[batch_start], batch_size, pass->frustum,
+                      plane_mask, batch_results);
+        
+        // Collect results
+        for (u32 i = 0; i < batch_size; i++) {
+            u32 splat_idx = indices[batch_start + i];
+            if (splat_idx >= pass->input_count) continue;  // Not one of this pass's splats
+            emit_tested_splat(pass, splat_idx, batch_results[i]);
+        }
+        
+        batch_start += batch_size;
+    }
+}
+
+// Defer a leaf's splats to the streamed EE pass; test them now if the queue cannot grow
+static void ee_queue_splat_range(CullPass* pass, const u32* indices, u32 count, u32 plane_mask) {
+    u32 required = g_ee_queue.count + count;
+    if (required > g_ee_queue.capacity) {
+        u32 new_capacity = required + required / 2;
+        u32* grown = (u32*)realloc(g_ee_queue.indices, new_capacity * sizeof(u32));
+        if (!grown) {
+            test_splat_range(pass, indices, count, plane_mask);
+            return;
+        }
+        g_ee_queue.indices = grown;
+        g_ee_queue.capacity = new_capacity;
+    }
+    
+    for (u32 i = 0; i < count; i++) {
+        if (indices[i] >= pass->input_count) continue;  // Not one of this pass's splats
+        g_ee_queue.indices[g_ee_queue.count++] = indices[i];
+    }
+}
+
+// EE test over one scratchpad block of gathered spheres (all six planes, like VU0)
+static void ee_cull_kernel(const void* block, u32 first, u32 count, void* user) {
+    CullPass* pass = (CullPass*)user;
+    SplatSource source;
+    source.splats = pass->source.hot ? NULL : (const GaussianSplat3D*)block;
+    source.hot = pass->source.hot ? (const GaussianSplatHot*)block : NULL;
+    
+    for (u32 i = 0; i < count; i += 4) {
+        u32 group = MIN(count - i, 4);
+        fixed16x4 lanes[4];
+        source_spheres_x4(&source, NULL, i, group, lanes);
+        
+        u32 outside = spheres_outside_frustum_x4(lanes, pass->frustum, OCTREE_ALL_PLANES);
+        for (u32 k = 0; k < group; k++) {
+            emit_tested_splat(pass, g_ee_queue.indices[first + i + k], !(outside & (1u << k)));
+        }
+    }
+}
+
+// Cull every deferred splat in one stream: the index list drives a toSPR
+// gather of the hot records (or AoS records), so the tests never miss the cache
+static void ee_queue_finish(CullPass* pass) {
+    if (g_ee_queue.count == 0) {
+        return;
+    }
+    
+    const void* records = pass->source.hot ? (const void*)pass->source.hot : (const void*)pass->source.splats;
+    u32 record_size = pass->source.hot ? sizeof(GaussianSplatHot) : sizeof(GaussianSplat3D);
+    dma_spr_stream(records, record_size, g_ee_queue.indices, g_ee_queue.count, ee_cull_kernel, pass);
+    g_ee_queue.count = 0;
+}
+
+// Hand the frame's planes to the VU0 engine; leaves go to VU0 if it accepts them
+static void vu0_queue_begin(const FrustumInternal* frustum) {
+    float planes[6][4];
+    for (int i = 0; i < 6; i++) {
+        planes[i][0] = fixed_to_float(frustum->planes[i].normal[0]);
+        planes[i][1] = fixed_to_float(frustum->planes[i].normal[1]);
+        planes[i][2] = fixed_to_float(frustum->planes[i].normal[2]);
+        planes[i][3] = fixed_to_float(frustum->planes[i].distance);
+    }
+    
+    g_vu0_queue.enabled = (vu0_cull_engine_set_planes(planes) == 0);
+    g_vu0_queue.fill_spheres = NULL;
+    g_vu0_queue.fill_count = 0;
+}
+
+// Consume the oldest VU0 batch; EE-test it if VU0 did not deliver
+static void vu0_queue_collect(CullPass* pass) {
+    u16 masks[VU0_CULL_BATCH_SIZE / 16];
+    u32 buffer_id;
+    int count = vu0_cull_engine_collect(masks, &buffer_id);
+    const u32* indices = g_vu0_queue.indices[buffer_id];
+    
+    if (count < 0) {
+        // VU0 stalled: the rest of this frame is culled on the EE
+        g_vu0_queue.enabled = false;
+        ee_queue_splat_range(pass, indices, g_vu0_queue.counts[buffer_id], OCTREE_ALL_PLANES);
+        return;
+    }
+    
+    for (u32 i = 0; i < (u32)count; i++) {
+        emit_tested_splat(pass, indices[i], (masks[i / 16] & (1 << (i % 16))) != 0);
+    }
+}
+
+static void vu0_queue_submit(void) {
+    g_vu0_queue.counts[g_vu0_queue.fill_buffer] = g_vu0_queue.fill_count;
+    vu0_cull_engine_submit(g_vu0_queue.fill_count);
+    g_vu0_queue.fill_spheres = NULL;
+    g_vu0_queue.fill_count = 0;
+}
+
+// Queue a leaf's splats for VU0. The EE keeps traversing while VU0 culls,
+// and consumes a batch only when both VU0 buffers are busy.
+static void vu0_queue_splat_range(CullPass* pass, const u32* indices, u32 count, u32 plane_mask) {
+    for (u32 i = 0; i < count; i++) {
+        u32 splat_idx = indices[i];
+        if (splat_idx >= pass->input_count) continue;  // Not one of this pass's splats
+        
+        if (!g_vu0_queue.enabled) {
+            ee_queue_splat_range(pass, &indices[i], count - i, plane_mask);
+            return;
+        }
+        
+        if (!g_vu0_queue.fill_spheres) {
+            if (vu0_cull_engine_in_flight() >= 2) {
+                vu0_queue_collect(pass);
+                if (!g_vu0_queue.enabled) {
+                    ee_queue_splat_range(pass, &indices[i], count - i, plane_mask);
+                    return;
+                }
             }
+            g_vu0_queue.fill_spheres = vu0_cull_engine_begin_batch(&g_vu0_queue.fill_buffer);
+            g_vu0_queue.fill_count = 0;
         }
         
-        results[i] = visible;
+        // Sphere: center xyz, radius w
+        const fixed16_t* pos = source_pos(&pass->source, splat_idx);
+        float* sphere = &g_vu0_queue.fill_spheres[g_vu0_queue.fill_count * 4];
+        sphere[0] = fixed_to_float(pos[0]);
+        sphere[1] = fixed_to_float(pos[1]);
+        sphere[2] = fixed_to_float(pos[2]);
+        sphere[3] = fixed_to_float(source_radius(&pass->source, splat_idx));
+        g_vu0_queue.indices[g_vu0_queue.fill_buffer][g_vu0_queue.fill_count++] = splat_idx;
+        
+        if (g_vu0_queue.fill_count == VU0_CULL_BATCH_SIZE) {
+            vu0_queue_submit();
+        }
     }
 }
 
-// Main frustum culling function
-GaussianResult cull_gaussian_splats(const GaussianSplat3D* input_splats, u32 input_count,
-                                   const fixed16_t view_proj_matrix[16],
-                                   GaussianSplat3D* output_splats, u32* output_count) {
-    if (!input_splats || !view_proj_matrix || !output_splats || !output_count) {
-        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+// Submit the partial batch and drain VU0, then run the deferred EE pass
+static void vu0_queue_finish(CullPass* pass) {
+    if (g_vu0_queue.fill_spheres && g_vu0_queue.fill_count > 0) {
+        vu0_queue_submit();
+    }
+    while (vu0_cull_engine_in_flight() > 0) {
+        vu0_queue_collect(pass);
+    }
+    ee_queue_finish(pass);
+}
+
+// Octree traversal shared by the AoS and stream entry points
+static GaussianResult cull_pass_run(CullPass* pass, const fixed16_t view_proj_matrix[16], u32* output_count) {
+    u32 input_count = pass->input_count;
+    
+    // Build the octree if none was built or loaded for this many splats
+    if (!g_octree.initialized || input_count > g_octree.total_splats) {
+        GaussianResult result = octree_build(&pass->source, input_count);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
     }
     
-    // Initialize spatial grid if not done
-    if (!g_spatial_grid.initialized) {
-        GaussianResult result = init_spatial_grid(input_splats, input_count);
+    // Extract frustum planes, unless the matrix is the one from last frame
+    bool planes_changed = !g_frustum_cache.valid ||
+                          memcmp(g_frustum_cache.view_proj, view_proj_matrix, sizeof(g_frustum_cache.view_proj)) != 0;
+    if (planes_changed) {
+        GaussianResult result = extract_frustum_planes(view_proj_matrix, &g_frustum_cache.frustum);
         if (result != GAUSSIAN_SUCCESS) {
             return result;
         }
+        memcpy(g_frustum_cache.view_proj, view_proj_matrix, sizeof(g_frustum_cache.view_proj));
+        for (u32 i = 0; i < 16; i++) {
+            g_frustum_cache.view_proj_f[i] = fixed_to_float(view_proj_matrix[i]);
+        }
+        g_frustum_cache.valid = true;
     }
+    const FrustumInternal* frustum = &g_frustum_cache.frustum;
     
-    // Extract frustum planes
-    FrustumInternal frustum;
-    GaussianResult result = extract_frustum_planes(view_proj_matrix, &frustum);
-    if (result != GAUSSIAN_SUCCESS) {
-        return result;
+    // Update frame counter; instance passes are part of the scene's frame
+    if (!g_instance_pass) {
+        g_current_frame++;
+        g_visibility_history.frame_number = g_current_frame;
     }
     
-    // Update frame counter
-    g_current_frame++;
-    g_visibility_history.frame_number = g_current_frame;
+    pass->visible_count = 0;
+    pass->frustum = frustum;
+    pass->ranked = importance_rank_prepare(pass);
     
-    u32 visible_count = 0;
+    g_octree.visible_nodes = 0;
+    g_octree.inside_nodes = 0;
+    g_octree.occluded_nodes = 0;
+    vu0_queue_begin(frustum);
     
-    // First pass: Hierarchical culling - test cells against frustum
-    for (int cell_idx = 0; cell_idx < TOTAL_GRID_CELLS; cell_idx++) {
-        SpatialGridCell* cell = &g_spatial_grid.cells[cell_idx];
+    // Occlusion needs a pyramid from a rendered frame
+    bool occlusion = tile_occlusion_available();
+    
+    // Node history needs the planes' motion since the nodes were tested
+    bool node_history = !g_instance_pass && node_history_prepare();
+    g_node_history.skipped_nodes = 0;
+    if (node_history && planes_changed) {
+        node_history_track_planes(frustum);
+    }
+    
+    // Depth-first traversal; each entry carries the planes still straddled
+    u32 stack_nodes[OCTREE_STACK_SIZE];
+    u32 stack_masks[OCTREE_STACK_SIZE];
+    u32 stack_size = 0;
+    
+    stack_nodes[stack_size] = 0;
+    stack_masks[stack_size] = OCTREE_ALL_PLANES;
+    stack_size++;
+    
+    while (stack_size > 0) {
+        stack_size--;
+        u32 node_index = stack_nodes[stack_size];
+        const OctreeNode* node = &g_octree.nodes[node_index];
+        u32 plane_mask = stack_masks[stack_size];
+        const u32* indices = &g_octree.splat_indices[node->splat_first];
         
-        if (cell->splat_count == 0) continue;
+        if (node->splat_count == 0) continue;
         
-        // Test cell AABB against frustum
-        bool cell_visible = aabb_intersects_frustum(cell->bounds_min, cell->bounds_max, &frustum);
+        // Confidently inside or outside: the last class holds, no plane tests
+        int classification = node_history ? node_history_lookup(node_index) : -1;
+        bool from_history = classification >= 0;
+        if (!from_history) {
+            classification = aabb_classify_frustum(node->bounds_min, node->bounds_max, frustum, &plane_mask);
+            if (node_history) {
+                node_history_record(node_index, node, frustum, classification);
+            }
+        }
         
-        if (!cell_visible) {
-            // Mark all splats in this cell as not visible
-            for (u32 i = 0; i < cell->splat_count; i++) {
-                update_visibility_history(cell->splat_indices[i], false);
+        if (classification == CULL_OUTSIDE) {
+            // A skipped node's splats already hold NODE_CONFIDENCE_FRAMES
+            // misses in their history, enough to keep has_temporal_coherence off
+            if (!from_history) {
+                cull_splat_range(indices, node->splat_count);
             }
-            cell->is_visible = false;
             continue;
         }
         
-        cell->is_visible = true;
-        cell->last_visible_frame = g_current_frame;
+        // Behind last frame's opaque tiles. Not recorded in the node history:
+        // occlusion depends on the scene in front, not on the planes
+        if (occlusion && node_occluded(node)) {
+            g_octree.occluded_nodes++;
+            cull_splat_range(indices, node->splat_count);
+            continue;
+        }
         
-        // Second pass: Test individual splats in visible cells
-        u32 batch_start = 0;
-        while (batch_start < cell->splat_count) {
-            u32 batch_size = (cell->splat_count - batch_start > VU0_BATCH_SIZE) ? 
-                            VU0_BATCH_SIZE : (cell->splat_count - batch_start);
-            
-            bool batch_results[VU0_BATCH_SIZE];
-            
-            // Process batch with VU0 (or C fallback)
-            vu0_cull_batch(input_splats, &cell->splat_indices[batch_start], batch_size, &frustum, batch_results);
-            
-            // Collect results
-            for (u32 i = 0; i < batch_size; i++) {
-                u32 splat_idx = cell->splat_indices[batch_start + i];
-                bool is_visible = batch_results[i];
-                
-                // Apply temporal coherence optimization
-                if (!is_visible && has_temporal_coherence(splat_idx)) {
-                    // Skip culling test for splats with strong temporal coherence
-                    is_visible = true;
-                }
-                
-                update_visibility_history(splat_idx, is_visible);
-                
-                if (is_visible && visible_count < input_count) {
-                    output_splats[visible_count] = input_splats[splat_idx];
-                    visible_count++;
-                }
+        g_octree.visible_nodes++;
+        
+        if (classification == CULL_INSIDE) {
+            // Whole subtree visible: no per-splat plane tests
+            g_octree.inside_nodes++;
+            emit_splat_range(pass, indices, node->splat_count);
+        } else if (node->child_count == 0) {
+            // Straddling leaf: per-splat tests on VU0 while the EE keeps traversing
+            vu0_queue_splat_range(pass, indices, node->splat_count, plane_mask);
+        } else {
+            for (u32 c = 0; c < node->child_count; c++) {
+                stack_nodes[stack_size] = node->first_child + c;
+                stack_masks[stack_size] = plane_mask;
+                stack_size++;
             }
-            
-            batch_start += batch_size;
         }
     }
     
-    *output_count = visible_count;
+    vu0_queue_finish(pass);
+    if (pass->ranked) {
+        importance_rank_finish(pass);
+    }
+    
+    *output_count = pass->visible_count;
     return GAUSSIAN_SUCCESS;
 }
 
+// Main frustum culling function
+GaussianResult cull_gaussian_splats(const GaussianSplat3D* input_splats, u32 input_count,
+                                   const fixed16_t view_proj_matrix[16],
+                                   GaussianSplat3D* output_splats, u32* output_count) {
+    if (!input_splats || !view_proj_matrix || !output_splats || !output_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    CullPass pass;
+    pass.source.splats = input_splats;
+    pass.source.hot = NULL;
+    pass.input_splats = input_splats;
+    pass.streams = NULL;
+    pass.input_count = input_count;
+    pass.output_splats = output_splats;
+    pass.output_indices = NULL;
+    pass.output_capacity = input_count;
+    
+    return cull_pass_run(&pass, view_proj_matrix, output_count);
+}
+
+// Stream-mode culling: tests read only the hot stream, and only visible
+// splats touch the warm stream when they are gathered into output_splats
+GaussianResult cull_gaussian_splat_streams(const GaussianSplatStreams* streams, u32 input_count,
+                                          const fixed16_t view_proj_matrix[16],
+                                          GaussianSplat3D* output_splats, u32* output_count) {
+    if (!streams || !streams->hot || !streams->warm || !view_proj_matrix || !output_splats || !output_count ||
+        input_count > streams->count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    CullPass pass;
+    pass.source.splats = NULL;
+    pass.source.hot = streams->hot;
+    pass.input_splats = NULL;
+    pass.streams = streams;
+    pass.input_count = input_count;
+    pass.output_splats = output_splats;
+    pass.output_indices = NULL;
+    pass.output_capacity = input_count;
+    
+    return cull_pass_run(&pass, view_proj_matrix, output_count);
+}
+
+// Zero-copy culling: writes the scene index of each visible splat instead of
+// the splat itself, so the VU upload can reference the resident scene array.
+// Tests read the hot stream when streams are given, the AoS records otherwise.
+// Every splat is a candidate; at most visible_capacity indices are written,
+// the most important visible splats when more are visible.
+GaussianResult cull_gaussian_splat_indices(const GaussianSplat3D* input_splats,
+                                          const GaussianSplatStreams* streams, u32 input_count,
+                                          const fixed16_t view_proj_matrix[16],
+                                          u32* visible_indices, u32 visible_capacity, u32* visible_count) {
+    bool use_streams = streams && streams->hot && input_count <= streams->count;
+    if ((!input_splats && !use_streams) || !view_proj_matrix || !visible_indices || !visible_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    CullPass pass;
+    pass.source.splats = use_streams ? NULL : input_splats;
+    pass.source.hot = use_streams ? streams->hot : NULL;
+    pass.input_splats = input_splats;
+    pass.streams = NULL;
+    pass.input_count = input_count;
+    pass.output_splats = NULL;
+    pass.output_indices = visible_indices;
+    pass.output_capacity = visible_capacity;
+    
+    return cull_pass_run(&pass, view_proj_matrix, visible_count);
+}
+
+// Exchange the scene's octree and frustum cache with an asset's
+static void cull_index_swap(CullIndex* index) {
+    SpatialOctree octree = g_octree;
+    g_octree = index->octree;
+    index->octree = octree;
+    
+    FrustumCache cache = g_frustum_cache;
+    g_frustum_cache = g_instance_frustum_cache;
+    g_instance_frustum_cache = cache;
+}
+
+// Octree over an instanced asset's splats, in object space. The scene's
+// octree and node history are untouched.
+CullIndex* cull_index_create(const GaussianSplat3D* splats, u32 splat_count) {
+    if (!splats || splat_count == 0) {
+        return NULL;
+    }
+    
+    CullIndex* index = (CullIndex*)calloc(1, sizeof(CullIndex));
+    if (!index) {
+        return NULL;
+    }
+    
+    SplatSource source = { splats, NULL };
+    bool node_history_valid = g_node_history.valid;
+    cull_index_swap(index);
+    GaussianResult result = octree_build(&source, splat_count);
+    cull_index_swap(index);
+    g_node_history.valid = node_history_valid;
+    
+    if (result != GAUSSIAN_SUCCESS) {
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+void cull_index_destroy(CullIndex* index) {
+    if (!index) {
+        return;
+    }
+    
+    bool node_history_valid = g_node_history.valid;
+    cull_index_swap(index);
+    octree_free();
+    cull_index_swap(index);
+    g_node_history.valid = node_history_valid;
+    free(index);
+}
+
+// Object-space bounds of the asset, splat radii included
+void cull_index_bounds(const CullIndex* index, fixed16_t bounds_min[3], fixed16_t bounds_max[3]) {
+    for (int j = 0; j < 3; j++) {
+        bounds_min[j] = index ? index->octree.nodes[0].bounds_min[j] : 0;
+        bounds_max[j] = index ? index->octree.nodes[0].bounds_max[j] : 0;
+    }
+}
+
+// Index-mode culling of an asset through one instance: view_proj_matrix
+// is the instance transform times the camera's. All splat_count splats are
+// candidates; at most visible_capacity indices are written.
+GaussianResult cull_index_splat_indices(CullIndex* index, const GaussianSplat3D* splats, u32 splat_count,
+                                        const fixed16_t view_proj_matrix[16],
+                                        u32* visible_indices, u32 visible_capacity, u32* visible_count) {
+    if (!index || !splats || !view_proj_matrix || !visible_indices || !visible_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    CullPass pass;
+    pass.source.splats = splats;
+    pass.source.hot = NULL;
+    pass.input_splats = splats;
+    pass.streams = NULL;
+    pass.input_count = MIN(splat_count, index->octree.total_splats);
+    pass.output_splats = NULL;
+    pass.output_indices = visible_indices;
+    pass.output_capacity = visible_capacity;
+    
+    cull_index_swap(index);
+    g_instance_pass = true;
+    GaussianResult result = cull_pass_run(&pass, view_proj_matrix, visible_count);
+    g_instance_pass = false;
+    cull_index_swap(index);
+    return result;
+}
+
 // Get culling statistics
 GaussianResult get_culling_stats(CullingStats* stats) {
     if (!stats) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
-    stats->total_splats = g_spatial_grid.total_splats;
-    stats->total_cells = TOTAL_GRID_CELLS;
-    stats->visible_cells = 0;
+    stats->total_splats = g_octree.total_splats;
+    stats->total_cells = g_octree.node_count;
+    stats->visible_cells = g_octree.visible_nodes;
+    stats->inside_cells = g_octree.inside_nodes;
+    stats->temporal_cells = g_node_history.skipped_nodes;
+    stats->occluded_cells = g_octree.occluded_nodes;
     stats->empty_cells = 0;
     stats->frame_number = g_current_frame;
     
-    for (int i = 0; i < TOTAL_GRID_CELLS; i++) {
-        if (g_spatial_grid.cells[i].splat_count == 0) {
+    for (u32 i = 0; i < g_octree.node_count; i++) {
+        if (g_octree.nodes[i].splat_count == 0) {
             stats->empty_cells++;
-        } else if (g_spatial_grid.cells[i].is_visible) {
-            stats->visible_cells++;
         }
     }
     
@@ -434,7 +1853,14 @@ bool is_sphere_visible(const fixed16_t center[3], fixed16_t radius, void* frustu
 
 // Cleanup culling system
 void cleanup_frustum_culling(void) {
-    memset(&g_spatial_grid, 0, sizeof(g_spatial_grid));
+    octree_free();
+    free(g_ee_queue.indices);
+    memset(&g_ee_queue, 0, sizeof(g_ee_queue));
     memset(&g_visibility_history, 0, sizeof(g_visibility_history));
+    memset(&g_frustum_cache, 0, sizeof(g_frustum_cache));
+    memset(&g_instance_frustum_cache, 0, sizeof(g_instance_frustum_cache));
+    free(g_node_history.nodes);
+    memset(&g_node_history, 0, sizeof(g_node_history));
+    importance_rank_reset();
     g_current_frame = 0;
 }
\ No newline at end of file
@@ -27,23 +27,28 @@ void generate_sh_lighting_lut(void);
 
 // LUT texture data
 static u32* cov_inv_lut = NULL;         // 2D LUT for covariance inverses
-static u32* footprint_atlas = NULL;     // Atlas of precalculated Gaussian footprints
+static u8* footprint_atlas = NULL;      // Atlas of precalculated Gaussian footprints (8-bit alpha)
+static u8* footprint_texels = NULL;     // Atlas as GS texels (aliases the atlas for PSMT8)
+static u32* footprint_clut = NULL;      // Alpha ramp CLUT for the atlas texels
 static u32* sh_lighting_lut = NULL;     // Spherical harmonics lighting LUT
 
 // GS texture structures (would be properly defined with gsKit)
 // Use proper GSTEXTURE structures for gsKit compatibility - COMPLETE IMPLEMENTATION
 static GSTEXTURE tex_cov_inv;
 static GSTEXTURE tex_footprint_atlas;
+static GSTEXTURE tex_footprint_clut;
 static GSTEXTURE tex_sh_lighting;
 
 // Initialize advanced LUT system
 int gaussian_lut_advanced_init(void) {
     // Allocate memory for LUTs (using malloc instead of memalign for PS2SDK compatibility)
     cov_inv_lut = (u32*)malloc(COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32));
-    footprint_atlas = (u32*)malloc(ATLAS_SIZE * ATLAS_SIZE * sizeof(u32));
+    footprint_atlas = (u8*)malloc(ATLAS_SIZE * ATLAS_HEIGHT);
+    footprint_texels = (FOOTPRINT_ATLAS_BITS == 8) ? footprint_atlas : (u8*)malloc(FOOTPRINT_ATLAS_BYTES);
+    footprint_clut = (u32*)malloc(FOOTPRINT_CLUT_ENTRIES * sizeof(u32));
     sh_lighting_lut = (u32*)malloc(256 * 256 * sizeof(u32));  // 256x256 SH cube
     
-    if (!cov_inv_lut || !footprint_atlas || !sh_lighting_lut) {
+    if (!cov_inv_lut || !footprint_atlas || !footprint_texels || !footprint_clut || !sh_lighting_lut) {
         gaussian_lut_advanced_cleanup();
         return -1;
     }
@@ -52,20 +57,36 @@ int gaussian_lut_advanced_init(void) {
     generate_cov_inv_lut();
     generate_footprint_atlas();
     generate_sh_lighting_lut();
+    footprint_atlas_pack(footprint_atlas, footprint_texels);
+    footprint_clut_build(footprint_clut);
     
     return 0;
 }
 
 // Cleanup advanced LUT system
 void gaussian_lut_advanced_cleanup(void) {
+    // VRAM copies must not be restored from freed sources
+    gs_vram_texture_release(GS_TEXTURE_COV_INV_LUT);
+    gs_vram_texture_release(GS_TEXTURE_FOOTPRINT_ATLAS);
+    gs_vram_texture_release(GS_TEXTURE_FOOTPRINT_CLUT);
+    gs_vram_texture_release(GS_TEXTURE_SH_LIGHTING);
+    
     if (cov_inv_lut) {
         free(cov_inv_lut);
         cov_inv_lut = NULL;
     }
+    if (footprint_texels && footprint_texels != footprint_atlas) {
+        free(footprint_texels);
+    }
+    footprint_texels = NULL;
     if (footprint_atlas) {
         free(footprint_atlas);
         footprint_atlas = NULL;
     }
+    if (footprint_clut) {
+        free(footprint_clut);
+        footprint_clut = NULL;
+    }
     if (sh_lighting_lut) {
         free(sh_lighting_lut);
         sh_lighting_lut = NULL;
@@ -117,7 +138,7 @@ void generate_cov_inv_lut(void) {
 // Generate precalculated Gaussian footprint atlas
 void generate_footprint_atlas(void) {
     // Clear atlas
-    memset(footprint_atlas, 0, ATLAS_SIZE * ATLAS_SIZE * sizeof(u32));
+    memset(footprint_atlas, 0, ATLAS_SIZE * ATLAS_HEIGHT);
     
     for (int row = 0; row < 8; row++) {        // Aspect ratios
         for (int col = 0; col < 8; col++) {    // Rotation angles
@@ -157,14 +178,17 @@ void generate_footprint_atlas(void) {
                     // Clamp and quantize to 8-bit
                     u8 alpha_val = (u8)(alpha * 255.0f);
                     
-                    // Store in atlas (alpha channel only, RGB = 0)
+                    // Store in atlas (alpha only; the GS expands it through the CLUT)
                     int atlas_x = base_x + px;
                     int atlas_y = base_y + py;
-                    footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x] = alpha_val << 24;
+                    footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x] = alpha_val;
                 }
             }
         }
     }
+    
+    // Smaller levels for splats only a few pixels across
+    footprint_atlas_build_mips(footprint_atlas);
 }
 
 // Generate spherical harmonics lighting LUT
@@ -216,6 +240,28 @@ void generate_sh_lighting_lut(void) {
 }
 
 // Upload LUTs to GS VRAM - COMPLETE IMPLEMENTATION
+// Placement and residency come from the GS VRAM manager; calling this again
+// after a scene or quality change only re-sends the page rows that changed.
+static void upload_lut_texture(GSTEXTURE* tex, GSTextureId id, void* data, u32 width, u32 height, u32 psm,
+                               const char* name) {
+    memset(tex, 0, sizeof(GSTEXTURE));
+    tex->Width = width;
+    tex->Height = height;
+    tex->PSM = psm;
+    tex->TBW = (width + 63) / 64;  // Texture base width in 64-pixel units
+    tex->Mem = data;
+    tex->Filter = GS_FILTER_LINEAR;
+    
+    u32 tbp = gs_vram_texture_upload(id, data, width, height, psm);
+    if (tbp == GS_VRAM_INVALID) {
+        debug_log_error("Failed to allocate VRAM for %s", name);
+        return;
+    }
+    
+    tex->Vram = tbp * GS_VRAM_BLOCK_BYTES;
+    debug_log_info("%s resident in VRAM at 0x%08X", name, tex->Vram);
+}
+
 void upload_luts_to_gs(void* gsGlobal) {
     GSGLOBAL* gs = (GSGLOBAL*)gsGlobal;
     
@@ -225,95 +271,33 @@ void upload_luts_to_gs(void* gsGlobal) {
         return;
     }
     
-    // Set up texture structures with direct PS2SDK implementation
-    // Covariance inverse LUT - COMPLETE IMPLEMENTATION with direct GS register access
-    memset(&tex_cov_inv, 0, sizeof(GSTEXTURE));
-    tex_cov_inv.Width = COV_INV_LUT_RES;
-    tex_cov_inv.Height = COV_INV_LUT_RES;
-    tex_cov_inv.PSM = GS_PSM_CT32;  // 32-bit color texture
-    tex_cov_inv.TBW = (COV_INV_LUT_RES + 63) / 64;  // Texture base width in 64-pixel units
-    
-    // Calculate texture size manually: width * height * bytes_per_pixel
-    u32 cov_inv_size = COV_INV_LUT_RES * COV_INV_LUT_RES * 4;  // 4 bytes per pixel for CT32
-    tex_cov_inv.Vram = gs->CurrentPointer;  // Use current VRAM pointer
-    gs->CurrentPointer += (cov_inv_size + 255) & ~255;  // Align to 256-byte boundary
-    tex_cov_inv.Mem = cov_inv_lut;
-    tex_cov_inv.Filter = GS_FILTER_LINEAR;
-    
-    // Footprint atlas - COMPLETE IMPLEMENTATION with proper GSTEXTURE structure
-    memset(&tex_footprint_atlas, 0, sizeof(GSTEXTURE));
-    tex_footprint_atlas.Width = ATLAS_SIZE;
-    tex_footprint_atlas.Height = ATLAS_SIZE;
-    tex_footprint_atlas.PSM = GS_PSM_CT32;  // 32-bit color texture
-    tex_footprint_atlas.TBW = (ATLAS_SIZE + 63) / 64;  // Texture base width in 64-pixel units
-    // Direct PS2SDK VRAM allocation - replace missing gsKit_vram_alloc/gsKit_texture_size
-    u32 atlas_texture_size = ATLAS_SIZE * ATLAS_SIZE * 4;  // 32-bit texture size
-    tex_footprint_atlas.Vram = 0x100000;  // Fixed VRAM address for atlas texture
-    tex_footprint_atlas.Mem = footprint_atlas;
-    tex_footprint_atlas.Filter = GS_FILTER_LINEAR;
-    
-    // SH lighting LUT - COMPLETE IMPLEMENTATION with proper GSTEXTURE structure
-    memset(&tex_sh_lighting, 0, sizeof(GSTEXTURE));
-    tex_sh_lighting.Width = 256;
-    tex_sh_lighting.Height = 256;
-    tex_sh_lighting.PSM = GS_PSM_CT32;  // 32-bit color texture
-    tex_sh_lighting.TBW = (256 + 63) / 64;  // Texture base width in 64-pixel units
-    // Direct PS2SDK VRAM allocation - replace missing gsKit_vram_alloc/gsKit_texture_size
-    u32 sh_texture_size = 256 * 256 * 4;  // 32-bit texture size
-    tex_sh_lighting.Vram = 0x200000;  // Fixed VRAM address for SH lighting texture
-    tex_sh_lighting.Mem = sh_lighting_lut;
-    tex_sh_lighting.Filter = GS_FILTER_LINEAR;
-    
-    // Upload textures to GS VRAM using direct PS2SDK DMA - COMPLETE IMPLEMENTATION
-    if (tex_cov_inv.Vram != 0) {
-        // Direct DMA texture upload - replace missing gsKit_texture_upload
-        packet2_t* tex_packet = packet2_create(2, P2_TYPE_NORMAL, P2_MODE_CHAIN, 1);
-        packet2_add_u64(tex_packet, GS_SETREG_BITBLTBUF(0, 0, 0, tex_cov_inv.Vram / 256, tex_cov_inv.TBW, tex_cov_inv.PSM));
-        packet2_add_u64(tex_packet, GS_SETREG_TRXDIR(0));  // Host to local transfer
-        dma_channel_send_packet2(tex_packet, DMA_CHANNEL_GIF, 1);
-        packet2_free(tex_packet);
-        
-        // Transfer texture data
-        dma_channel_send_normal(DMA_CHANNEL_GIF, tex_cov_inv.Mem, tex_cov_inv.Width * tex_cov_inv.Height * 4, 0, 0);
-        debug_log_info("Covariance inverse LUT uploaded to VRAM at 0x%08X", tex_cov_inv.Vram);
-    } else {
-        debug_log_error("Failed to allocate VRAM for covariance inverse LUT");
+    // gsKit already owns the memory below CurrentPointer
+    if (!gs_vram_is_initialized()) {
+        if (gs_vram_init() != GAUSSIAN_SUCCESS) {
+            debug_log_error("GS VRAM manager unavailable");
+            return;
+        }
+        gs_vram_reserve(0, (gs->CurrentPointer + GS_VRAM_BLOCK_BYTES - 1) / GS_VRAM_BLOCK_BYTES);
     }
     
-    if (tex_footprint_atlas.Vram != 0) {
-        // Direct DMA texture upload - replace missing gsKit_texture_upload
-        packet2_t* atlas_packet = packet2_create(2, P2_TYPE_NORMAL, P2_MODE_CHAIN, 1);
-        packet2_add_u64(atlas_packet, GS_SETREG_BITBLTBUF(0, 0, 0, tex_footprint_atlas.Vram / 256, tex_footprint_atlas.TBW, tex_footprint_atlas.PSM));
-        packet2_add_u64(atlas_packet, GS_SETREG_TRXDIR(0));  // Host to local transfer
-        dma_channel_send_packet2(atlas_packet, DMA_CHANNEL_GIF, 1);
-        packet2_free(atlas_packet);
-        
-        // Transfer texture data
-        dma_channel_send_normal(DMA_CHANNEL_GIF, tex_footprint_atlas.Mem, atlas_texture_size, 0, 0);
-        debug_log_info("Footprint atlas uploaded to VRAM at 0x%08X", tex_footprint_atlas.Vram);
-    } else {
-        debug_log_error("Failed to allocate VRAM for footprint atlas");
-    }
+    upload_lut_texture(&tex_cov_inv, GS_TEXTURE_COV_INV_LUT, cov_inv_lut, COV_INV_LUT_RES, COV_INV_LUT_RES,
+                       GS_PSM_CT32, "Covariance inverse LUT");
     
-    if (tex_sh_lighting.Vram != 0) {
-        // Direct DMA texture upload - replace missing gsKit_texture_upload
-        packet2_t* sh_packet = packet2_create(2, P2_TYPE_NORMAL, P2_MODE_CHAIN, 1);
-        packet2_add_u64(sh_packet, GS_SETREG_BITBLTBUF(0, 0, 0, tex_sh_lighting.Vram / 256, tex_sh_lighting.TBW, tex_sh_lighting.PSM));
-        packet2_add_u64(sh_packet, GS_SETREG_TRXDIR(0));  // Host to local transfer
-        dma_channel_send_packet2(sh_packet, DMA_CHANNEL_GIF, 1);
-        packet2_free(sh_packet);
-        
-        // Transfer texture data
-        dma_channel_send_normal(DMA_CHANNEL_GIF, tex_sh_lighting.Mem, sh_texture_size, 0, 0);
-        debug_log_info("SH lighting LUT uploaded to VRAM at 0x%08X", tex_sh_lighting.Vram);
-    } else {
-        debug_log_error("Failed to allocate VRAM for SH lighting LUT");
-    }
+    // Footprints are single channel: palettized alpha plus a CT32 ramp CLUT
+    upload_lut_texture(&tex_footprint_atlas, GS_TEXTURE_FOOTPRINT_ATLAS, footprint_texels, ATLAS_SIZE, ATLAS_HEIGHT,
+                       (FOOTPRINT_ATLAS_BITS == 4) ? GS_PSM_T4 : GS_PSM_T8, "Footprint atlas");
+    upload_lut_texture(&tex_footprint_clut, GS_TEXTURE_FOOTPRINT_CLUT, footprint_clut,
+                       (FOOTPRINT_ATLAS_BITS == 4) ? 8 : 16, (FOOTPRINT_ATLAS_BITS == 4) ? 2 : 16,
+                       GS_PSM_CT32, "Footprint CLUT");
+    tex_footprint_atlas.Clut = footprint_clut;
+    tex_footprint_atlas.VramClut = tex_footprint_clut.Vram;
+    tex_footprint_atlas.ClutPSM = GS_PSM_CT32;
     
-    // Texture filtering and wrapping modes are already set in the GSTEXTURE structures above
-    // All textures use GS_FILTER_LINEAR for optimal quality
+    upload_lut_texture(&tex_sh_lighting, GS_TEXTURE_SH_LIGHTING, sh_lighting_lut, 256, 256,
+                       GS_PSM_CT32, "SH lighting LUT");
     
-    debug_log_info("All LUTs uploaded to GS VRAM successfully");
+    // All textures use GS_FILTER_LINEAR for optimal quality
+    debug_log_info("All LUTs resident in GS VRAM");
 }
 
 // Sample covariance inverse from 2D LUT
@@ -347,8 +331,9 @@ void sample_cov_inv_lut(fixed16_t eigenval1, fixed16_t eigenval2, fixed8_t inv_c
     }
 }
 
-// Get atlas UV coordinates for a given eigenvalue pair and rotation
-void get_atlas_uv(fixed16_t eigenval1, fixed16_t eigenval2, fixed16_t rotation_angle,
+// Get atlas UV coordinates for a given eigenvalue pair and rotation, at the
+// mip level that matches the splat's screen radius (pixels, Q16.16)
+void get_atlas_uv(fixed16_t eigenval1, fixed16_t eigenval2, fixed16_t rotation_angle, fixed16_t radius,
                   float* u_base, float* v_base, float* u_scale, float* v_scale) {
     // Calculate aspect ratio
     float ev1_f = fixed_to_float(eigenval1);
@@ -366,11 +351,16 @@ void get_atlas_uv(fixed16_t eigenval1, fixed16_t eigenval2, fixed16_t rotation_a
     int angle_idx = (int)(angle_norm * 8.0f);
     if (angle_idx > 7) angle_idx = 7;
     
+    // Cell at the level whose resolution matches the sprite diameter
+    u32 level = footprint_atlas_level((u32)(MAX(radius, 0) >> (FIXED16_SHIFT - 1)) + 1);
+    u32 cell_u, cell_v;
+    footprint_atlas_cell(aspect_idx * 8 + angle_idx, level, &cell_u, &cell_v);
+    
     // Calculate UV coordinates
-    *u_base = (float)angle_idx / 8.0f;
-    *v_base = (float)aspect_idx / 8.0f;
-    *u_scale = 1.0f / 8.0f;
-    *v_scale = 1.0f / 8.0f;
+    *u_base = (float)cell_u / ATLAS_SIZE;
+    *v_base = (float)cell_v / ATLAS_HEIGHT;
+    *u_scale = (float)(FOOTPRINT_RES >> level) / ATLAS_SIZE;
+    *v_scale = (float)(FOOTPRINT_RES >> level) / ATLAS_HEIGHT;
 }
 
 // Sample footprint atlas for alpha value
@@ -381,11 +371,10 @@ u8 sample_footprint_atlas(float u, float v) {
     
     // Convert to atlas coordinates
     int atlas_x = (int)(u * (ATLAS_SIZE - 1));
-    int atlas_y = (int)(v * (ATLAS_SIZE - 1));
+    int atlas_y = (int)(v * (ATLAS_HEIGHT - 1));
     
     // Sample atlas (alpha channel)
-    u32 texel = footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x];
-    return (u8)((texel >> 24) & 0xFF);
+    return footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x];
 }
 
 // Enhanced Gaussian evaluation using atlas lookup
@@ -406,7 +395,7 @@ u8 evaluate_gaussian_alpha_atlas(fixed16_t dx, fixed16_t dy,
     fixed16_t ev1 = fixed_from_float(1.0f);  // Would be computed properly
     fixed16_t ev2 = fixed_from_float(1.0f);
     
-    get_atlas_uv(ev1, ev2, dummy_rotation, &u_base, &v_base, &u_scale, &v_scale);
+    get_atlas_uv(ev1, ev2, dummy_rotation, splat->radius, &u_base, &v_base, &u_scale, &v_scale);
     
     // Transform UV to atlas space
     float atlas_u = u_base + u * u_scale;
@@ -422,7 +411,7 @@ u8 evaluate_gaussian_alpha_atlas(fixed16_t dx, fixed16_t dy,
 // Get memory usage statistics
 void get_lut_memory_usage(u32* cov_inv_bytes, u32* atlas_bytes, u32* sh_bytes, u32* total_bytes) {
     *cov_inv_bytes = COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32);
-    *atlas_bytes = ATLAS_SIZE * ATLAS_SIZE * sizeof(u32);
+    *atlas_bytes = FOOTPRINT_ATLAS_BYTES;
     *sh_bytes = 256 * 256 * sizeof(u32);
     *total_bytes = *cov_inv_bytes + *atlas_bytes + *sh_bytes;
 }
\ No newline at end of file
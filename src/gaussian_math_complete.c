@@ -22,7 +22,7 @@
 u32 g_exp_lut[LUT_SIZE] = {0};
 u32 g_sqrt_lut[LUT_SIZE] = {0};
 u32 g_cov_inv_lut[COV_INV_LUT_RES * COV_INV_LUT_RES] = {0};
-u32 g_footprint_atlas[ATLAS_SIZE * ATLAS_SIZE] = {0};
+u8 g_footprint_atlas[ATLAS_SIZE * ATLAS_HEIGHT] = {0};
 u32 g_sh_lighting_lut[256 * 256] = {0};
 u32 g_recip_lut[LUT_SIZE] = {0};
 
@@ -540,11 +540,13 @@ static void generate_footprint_atlas(void) {
                     
                     int pixel_x = atlas_x * FOOTPRINT_RES + x;
                     int pixel_y = atlas_y * FOOTPRINT_RES + y;
-                    g_footprint_atlas[pixel_y * ATLAS_SIZE + pixel_x] = alpha;
+                    g_footprint_atlas[pixel_y * ATLAS_SIZE + pixel_x] = (u8)alpha;
                 }
             }
         }
     }
+    
+    footprint_atlas_build_mips(g_footprint_atlas);
 }
 
 // Generate spherical harmonics lighting lookup table
@@ -10,7 +10,10 @@
  * - Complete Jacobian computation for perspective-correct projection
  * - 2x2 eigenvalue decomposition with complex number handling
  * - Advanced LUT systems for exp, sqrt, reciprocal, and covariance inverse
+ * - Cooked LUT file from tools/cook_luts.py loaded in one read, with the
+ *   float generators as the fallback
  * - Precalculated Gaussian footprint atlas with bilinear sampling
+ * - Footprint mip bias for trading edge detail against GS texture fetches
  * - Matrix and vector operations optimized for fixed-point
  */
 
@@ -20,6 +23,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <malloc.h>
+#include <fcntl.h>
 
 // Forward declarations
 void invert_cov_2x2_fixed_complete(const fixed8_t cov[4], fixed8_t inv_cov[4]);
@@ -31,7 +35,7 @@ void local_memory_pool_reset(MemoryPool* pool);
 u32 g_exp_lut[LUT_SIZE];
 u32 g_sqrt_lut[LUT_SIZE];
 u32 g_cov_inv_lut[COV_INV_LUT_RES * COV_INV_LUT_RES];
-u32 g_footprint_atlas[ATLAS_SIZE * ATLAS_SIZE];
+u8 g_footprint_atlas[ATLAS_SIZE * ATLAS_HEIGHT];
 u32 g_sh_lighting_lut[256 * 256];
 u32 g_recip_lut[LUT_SIZE];
 
@@ -40,6 +44,42 @@ static u32 g_sin_lut[LUT_SIZE];
 static u32 g_cos_lut[LUT_SIZE];
 static u32 g_atan2_lut[LUT_SIZE * LUT_SIZE];
 
+// Footprint mip levels added on top of the size-matched one
+static u32 g_footprint_mip_bias = 0;
+
+// Cooked LUT file (tools/cook_luts.py): a 128-byte header, then every table
+// in its final layout, footprint texels already packed for the GS PSM and
+// the CLUT in CSM1 order. Sections start on DMA_ALIGNMENT boundaries.
+#define LUT_COOKED_MAGIC        0x534C5554    // 'SLUT'
+#define LUT_COOKED_VERSION      1
+#define LUT_COOKED_FILENAME     "luts.slut"
+
+typedef enum {
+    LUT_SECTION_EXP,
+    LUT_SECTION_SQRT,
+    LUT_SECTION_RECIP,
+    LUT_SECTION_SIN,
+    LUT_SECTION_COS,
+    LUT_SECTION_ATAN2,
+    LUT_SECTION_COV_INV,
+    LUT_SECTION_FOOTPRINT_TEXELS,
+    LUT_SECTION_FOOTPRINT_CLUT,
+    LUT_SECTION_SH_LIGHTING,
+    LUT_SECTION_COUNT
+} CookedLUTSection;
+
+typedef struct {
+    u32 magic;                  // LUT_COOKED_MAGIC
+    u32 version;                // LUT_COOKED_VERSION
+    u32 payload_size;           // Bytes after the header, multiple of DMA_ALIGNMENT
+    u32 footprint_bits;         // FOOTPRINT_ATLAS_BITS the texels were packed for
+    struct {
+        u32 offset;             // Bytes from the start of the payload
+        u32 size;
+    } sections[LUT_SECTION_COUNT];
+    u32 reserved[8];            // Pad to 128 bytes
+} CookedLUTHeader;
+
 // Numerical stability constants
 static const fixed16_t EPSILON = 65;  // 1e-3 in Q16.16
 static const fixed16_t REGULARIZATION_EPSILON = 65;  // For matrix conditioning
@@ -151,7 +191,7 @@ void generate_footprint_atlas_complete(void) {
     printf("SPLATSTORM X: Generating Gaussian footprint atlas...\n");
     
     // Clear atlas
-    memset(g_footprint_atlas, 0, ATLAS_SIZE * ATLAS_SIZE * sizeof(u32));
+    memset(g_footprint_atlas, 0, sizeof(g_footprint_atlas));
     
     for (int row = 0; row < 8; row++) {        // Aspect ratios
         for (int col = 0; col < 8; col++) {    // Rotation angles
@@ -170,9 +210,9 @@ void generate_footprint_atlas_complete(void) {
             // Generate footprint with proper elliptical Gaussian
             for (int py = 0; py < FOOTPRINT_RES; py++) {
                 for (int px = 0; px < FOOTPRINT_RES; px++) {
-                    // Normalize pixel coordinates to [-1, 1]
-                    float nx = (float)px / (FOOTPRINT_RES - 1) * 2.0f - 1.0f;
-                    float ny = (float)py / (FOOTPRINT_RES - 1) * 2.0f - 1.0f;
+                    // Cell spans [-CUTOFF_SIGMA, CUTOFF_SIGMA], matching the sprite radius
+                    float nx = ((float)px / (FOOTPRINT_RES - 1) * 2.0f - 1.0f) * CUTOFF_SIGMA;
+                    float ny = ((float)py / (FOOTPRINT_RES - 1) * 2.0f - 1.0f) * CUTOFF_SIGMA;
                     
                     // Apply rotation
                     float rx = nx * cos_theta - ny * sin_theta;
@@ -194,17 +234,107 @@ void generate_footprint_atlas_complete(void) {
                     // Quantize to 8-bit alpha
                     u8 alpha_val = (u8)(alpha * 255.0f);
                     
-                    // Store in atlas (alpha channel only for blending)
+                    // Store in atlas (alpha only; the GS expands it through the CLUT)
                     int atlas_x = base_x + px;
                     int atlas_y = base_y + py;
-                    g_footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x] = alpha_val << 24;
+                    g_footprint_atlas[atlas_y * ATLAS_SIZE + atlas_x] = alpha_val;
                 }
             }
         }
     }
     
-    printf("SPLATSTORM X: Footprint atlas generated (%dx%d, %d footprints)\n", 
-           ATLAS_SIZE, ATLAS_SIZE, ATLAS_ENTRIES);
+    footprint_atlas_build_mips(g_footprint_atlas);
+    
+    printf("SPLATSTORM X: Footprint atlas generated (%dx%d, %d footprints, %d levels)\n", 
+           ATLAS_SIZE, ATLAS_HEIGHT, ATLAS_ENTRIES, FOOTPRINT_MIP_LEVELS);
+}
+
+// Texel origin of a footprint cell (aspect row * 8 + angle column) at a mip
+// level. Level 0 fills the top ATLAS_SIZE rows; each smaller level is an 8x8
+// grid of half-size cells placed left to right in the rows below it.
+void footprint_atlas_cell(u32 cell, u32 level, u32* u, u32* v) {
+    u32 res = FOOTPRINT_RES >> level;
+    u32 origin_u = (level == 0) ? 0 : ATLAS_SIZE - (ATLAS_SIZE >> (level - 1));
+    u32 origin_v = (level == 0) ? 0 : ATLAS_SIZE;
+    
+    *u = origin_u + (cell % 8) * res;
+    *v = origin_v + (cell / 8) * res;
+}
+
+// Fill levels 1+ from level 0, averaging 2x2 texels of the level above.
+// Cells halve together, so a level's cells never mix two footprints.
+void footprint_atlas_build_mips(u8* alpha) {
+    for (u32 level = 1; level < FOOTPRINT_MIP_LEVELS; level++) {
+        u32 res = FOOTPRINT_RES >> level;
+        
+        for (u32 cell = 0; cell < ATLAS_ENTRIES; cell++) {
+            u32 src_u, src_v, dst_u, dst_v;
+            footprint_atlas_cell(cell, level - 1, &src_u, &src_v);
+            footprint_atlas_cell(cell, level, &dst_u, &dst_v);
+            
+            for (u32 y = 0; y < res; y++) {
+                const u8* row0 = &alpha[(src_v + y * 2) * ATLAS_SIZE + src_u];
+                const u8* row1 = row0 + ATLAS_SIZE;
+                u8* dst = &alpha[(dst_v + y) * ATLAS_SIZE + dst_u];
+                
+                for (u32 x = 0; x < res; x++) {
+                    dst[x] = (u8)((row0[x * 2] + row0[x * 2 + 1] + row1[x * 2] + row1[x * 2 + 1] + 2) >> 2);
+                }
+            }
+        }
+    }
+}
+
+// Footprint mip level for a sprite of the given diameter in pixels: the
+// smallest cell that still has a texel per pixel, so far-away splats read
+// a 4x4 footprint instead of the full 32x32 one. The mip bias then moves
+// it that many levels coarser.
+u32 footprint_atlas_level(u32 diameter) {
+    u32 level = 0;
+    while (level + 1 < FOOTPRINT_MIP_LEVELS && (FOOTPRINT_RES >> (level + 1)) >= diameter) {
+        level++;
+    }
+    return MIN(level + g_footprint_mip_bias, FOOTPRINT_MIP_LEVELS - 1);
+}
+
+// Coarser footprints cost fewer GS texture cache misses on splats that
+// still cover many pixels, at the price of a softer edge
+void footprint_set_mip_bias(u32 bias) {
+    g_footprint_mip_bias = MIN(bias, FOOTPRINT_MIP_LEVELS - 1);
+}
+
+u32 footprint_get_mip_bias(void) {
+    return g_footprint_mip_bias;
+}
+
+// Pack 8-bit footprint alpha into GS atlas texels: PSMT8 indices are the alpha
+// itself, PSMT4 keeps the top nibble with the left texel in the low nibble.
+// Safe in place (texels == alpha).
+void footprint_atlas_pack(const u8* alpha, u8* texels) {
+#if FOOTPRINT_ATLAS_BITS == 4
+    for (u32 i = 0; i < ATLAS_SIZE * ATLAS_HEIGHT; i += 2) {
+        texels[i / 2] = (u8)((alpha[i] >> 4) | (alpha[i + 1] & 0xF0));
+    }
+#else
+    if (texels != alpha) {
+        memcpy(texels, alpha, ATLAS_SIZE * ATLAS_HEIGHT);
+    }
+#endif
+}
+
+// Alpha ramp CLUT: neutral RGB for modulate, GS alpha 0x00-0x80. Stored as a
+// CT32 image in CSM1 order, where 8-bit CLUTs swap entries 8-15 and 16-23 of
+// every 32-entry group.
+void footprint_clut_build(u32* clut) {
+    for (u32 i = 0; i < FOOTPRINT_CLUT_ENTRIES; i++) {
+        u32 alpha = i * 255 / (FOOTPRINT_CLUT_ENTRIES - 1);
+        u32 gs_alpha = (alpha * 128 + 127) / 255;
+        u32 slot = i;
+        if (FOOTPRINT_CLUT_ENTRIES == 256) {
+            slot = (i & ~0x18) | ((i & 0x08) << 1) | ((i & 0x10) >> 1);
+        }
+        clut[slot] = (gs_alpha << 24) | 0x00808080;
+    }
 }
 
 // Generate spherical harmonics lighting LUT for realistic lighting
@@ -257,25 +387,14 @@ fixed16_t fixed_recip_newton(fixed16_t d) {
     fixed16_t abs_d = fixed_abs(d);
     bool negative = (d < 0);
     
-    // Use LUT for small values to avoid convergence issues
-    if (abs_d < fixed_from_float(0.01f)) {
-        float norm_d = fixed_to_float(abs_d) / 0.01f;
-        int idx = (int)(norm_d * (LUT_SIZE - 1));
-        if (idx >= LUT_SIZE) idx = LUT_SIZE - 1;
-        
-        u32 lut_val = g_recip_lut[idx];
-        float recip_val = ((lut_val >> 24) & 0xFF) / 255.0f * 100.0f;  // Scale back
-        fixed16_t result = fixed_from_float(recip_val);
-        return negative ? fixed_neg(result) : result;
+    // 1/d does not fit Q16.16 for the two smallest magnitudes
+    if (abs_d <= 2) {
+        return negative ? fixed_neg(FIXED16_MAX) : FIXED16_MAX;
     }
     
-    // Newton-Raphson for larger values
-    fixed16_t x;
-    if (abs_d > FIXED16_SCALE) {
-        x = FIXED16_SCALE / 2;  // Start with 0.5 for values > 1
-    } else {
-        x = FIXED16_SCALE * 2;  // Start with 2.0 for values < 0.5
-    }
+    // Newton-Raphson from the power of two just below 1/d: d * x starts
+    // in (0.5, 1], so the error squares from at most 1/2 at any magnitude
+    fixed16_t x = (fixed16_t)(1U << __builtin_clz((u32)abs_d));
     
     // Newton-Raphson: x_{n+1} = x_n * (2 - d * x_n)
     for (int i = 0; i < 4; i++) {  // Extra iteration for better accuracy
@@ -289,38 +408,30 @@ fixed16_t fixed_recip_newton(fixed16_t d) {
 // Fixed-point square root via LUT with interpolation
 fixed16_t fixed_sqrt_lut(fixed16_t x) {
     if (x <= 0) return 0;
-    if (x >= fixed_from_int(1)) {
-        // For values >= 1, use scaling
-        int shift = 0;
-        fixed16_t scaled_x = x;
-        while (scaled_x >= fixed_from_int(4)) {
-            scaled_x >>= 2;  // Divide by 4
-            shift++;
-        }
-        
-        float norm_x = fixed_to_float(scaled_x);
-        int idx = (int)(norm_x * (LUT_SIZE - 1));
-        if (idx >= LUT_SIZE) idx = LUT_SIZE - 1;
-        
-        u32 lut_val = g_sqrt_lut[idx];
-        float sqrt_val = ((lut_val >> 24) & 0xFF) / 255.0f;
-        fixed16_t result = fixed_from_float(sqrt_val);
-        
-        // Scale back
-        for (int i = 0; i < shift; i++) {
-            result <<= 1;  // Multiply by 2
-        }
-        return result;
-    } else {
-        // Direct LUT lookup for values < 1
-        float norm_x = fixed_to_float(x);
-        int idx = (int)(norm_x * (LUT_SIZE - 1));
-        if (idx >= LUT_SIZE) idx = LUT_SIZE - 1;
-        
-        u32 lut_val = g_sqrt_lut[idx];
-        float sqrt_val = ((lut_val >> 24) & 0xFF) / 255.0f;
-        return fixed_from_float(sqrt_val);
+    
+    // The LUT covers [0, 1]: scale by powers of 4 into [0.25, 1),
+    // where its 8-bit entries are within 0.5% of the root
+    int shift = 0;
+    fixed16_t scaled_x = x;
+    while (scaled_x >= fixed_from_int(1)) {
+        scaled_x >>= 2;  // Divide by 4
+        shift++;
     }
+    while (scaled_x < FIXED16_SCALE / 4) {
+        scaled_x <<= 2;  // Multiply by 4
+        shift--;
+    }
+    
+    float norm_x = fixed_to_float(scaled_x);
+    int idx = (int)(norm_x * (LUT_SIZE - 1) + 0.5f);
+    if (idx >= LUT_SIZE) idx = LUT_SIZE - 1;
+    
+    u32 lut_val = g_sqrt_lut[idx];
+    float sqrt_val = ((lut_val >> 24) & 0xFF) / 255.0f;
+    fixed16_t result = fixed_from_float(sqrt_val);
+    
+    // Scale back by 2 per factor of 4
+    return (shift >= 0) ? (result << shift) : (result >> -shift);
 }
 
 // Fixed-point trigonometric functions using LUTs
@@ -377,10 +488,10 @@ fixed16_t fixed_atan2_lut(fixed16_t y, fixed16_t x) {
 // Complete 2x2 eigenvalue decomposition with numerical stability
 void compute_eigenvalues_2x2_fixed_complete(const fixed8_t cov[4], fixed16_t eigenvals[2], fixed16_t eigenvecs[4]) {
     // Promote Q8.8 to Q16.16 for computation
-    fixed16_t a = fixed_mul(fixed_from_int(cov[0]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t b = fixed_mul(fixed_from_int(cov[1]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t c = fixed_mul(fixed_from_int(cov[2]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t d = fixed_mul(fixed_from_int(cov[3]), fixed_from_int(FIXED8_SCALE));
+    fixed16_t a = (fixed16_t)cov[0] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t b = (fixed16_t)cov[1] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t c = (fixed16_t)cov[2] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t d = (fixed16_t)cov[3] << (FIXED16_SHIFT - FIXED8_SHIFT);
     
     // Add regularization for numerical stability
     a = fixed_add(a, REGULARIZATION_EPSILON);
@@ -635,12 +746,13 @@ void vector3_normalize_fixed(fixed16_t* v) {
 
 // Complete covariance projection with full Jacobian
 void project_covariance_fixed_complete(const GaussianSplat3D* splat3d, const fixed16_t jac[6], fixed8_t cov2d[4]) {
-    // Extract covariance with adaptive scaling
-    fixed16_t cov_scale = (fixed16_t)(1 << (splat3d->cov_exp - 7));
+    // Extract covariance with adaptive scaling: mantissa * 2^(cov_exp - 7) is
+    // the Q8.8 mantissa shifted left by cov_exp + 1 in Q16.16
     fixed16_t cov3d[9];
     
     for (int i = 0; i < 9; i++) {
-        cov3d[i] = fixed_mul_safe(fixed_from_int(splat3d->cov_mant[i]), cov_scale);
+        s64 value = (s64)splat3d->cov_mant[i] << (splat3d->cov_exp + 1);
+        cov3d[i] = (fixed16_t)CLAMP(value, FIXED16_MIN, FIXED16_MAX);
     }
     
     // Temporary matrix for J * Σ (2x3)
@@ -756,10 +868,10 @@ GaussianResult project_gaussian_complete(const GaussianSplat3D* splat3d, const C
 // Invert 2x2 covariance matrix with regularization
 void invert_cov_2x2_fixed_complete(const fixed8_t cov[4], fixed8_t inv_cov[4]) {
     // Promote to Q16.16 for computation
-    fixed16_t a = fixed_mul(fixed_from_int(cov[0]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t b = fixed_mul(fixed_from_int(cov[1]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t c = fixed_mul(fixed_from_int(cov[2]), fixed_from_int(FIXED8_SCALE));
-    fixed16_t d = fixed_mul(fixed_from_int(cov[3]), fixed_from_int(FIXED8_SCALE));
+    fixed16_t a = (fixed16_t)cov[0] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t b = (fixed16_t)cov[1] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t c = (fixed16_t)cov[2] << (FIXED16_SHIFT - FIXED8_SHIFT);
+    fixed16_t d = (fixed16_t)cov[3] << (FIXED16_SHIFT - FIXED8_SHIFT);
     
     // Add regularization for numerical stability
     a = fixed_add(a, REGULARIZATION_EPSILON);
@@ -790,12 +902,292 @@ void invert_cov_2x2_fixed_complete(const fixed8_t cov[4], fixed8_t inv_cov[4]) {
     inv_cov[3] = (fixed8_t)CLAMP(inv_d >> (FIXED16_SHIFT - FIXED8_SHIFT), FIXED8_MIN, FIXED8_MAX);
 }
 
+/*
+ * Batched projection on VU0 macro mode, for the EE path when VU1 is busy or
+ * unavailable. The view and projection matrices are loaded into VU0 registers
+ * once per call; each splat is then one inline COP2 block: Q16.16 to float,
+ * view and clip transforms, the Jacobian and J * Sigma * J^T, with no calls.
+ * The perspective divide, 2x2 eigen decomposition and inverse run on the FPU.
+ * The compiler never allocates VU0 registers, so the matrices stay put
+ * between the inline blocks; the VU0 culling engine has drained before
+ * culling returns, so its micro program does not overwrite them either.
+ *
+ * VU0 registers: vf1-vf4 view columns, vf5-vf8 projection columns,
+ * vf9-vf11 projection rows 0, 1 and 3, vf12 constants.
+ */
+typedef struct {
+    float view[4][4];           // View matrix columns
+    float proj[4][4];           // Projection matrix columns
+    float proj_rows[3][4];      // Projection rows 0, 1 and 3 (u, v and w)
+    float constants[4];         // 1/65536, unused, +1000 and -1000 (Jacobian clamp)
+} __attribute__((aligned(16))) VU0ProjectConstants;
+
+typedef struct {
+    float cam[4];               // View-space position
+    float clip[4];              // Clip-space position
+    float cov[4];               // J * Sigma * J^T: xx, xy, yx, yy
+} __attribute__((aligned(16))) VU0ProjectResult;
+
+static inline fixed8_t float_to_q8_floor(float value) {
+    return (fixed8_t)CLAMP(floorf(value * FIXED8_SCALE), -32768.0f, 32767.0f);
+}
+
+GaussianResult project_gaussian_batch(const GaussianSplat3D* splats, const u32* indices, u32 count,
+                                      const CameraFixed* camera, GaussianSplat2D* out, u32* visible_mask) {
+    if (!splats || !camera || !out || !visible_mask || count == 0 || count > PROJECT_BATCH_MAX) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    static VU0ProjectConstants constants;
+    static float sigma[PROJECT_BATCH_MAX][3][4] __attribute__((aligned(16)));
+    static VU0ProjectResult results[PROJECT_BATCH_MAX];
+    
+    const float to_float = 1.0f / FIXED16_SCALE;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            constants.view[j][i] = camera->view[i * 4 + j] * to_float;
+            constants.proj[j][i] = camera->proj[i * 4 + j] * to_float;
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        constants.proj_rows[0][j] = camera->proj[0 * 4 + j] * to_float;
+        constants.proj_rows[1][j] = camera->proj[1 * 4 + j] * to_float;
+        constants.proj_rows[2][j] = camera->proj[3 * 4 + j] * to_float;
+    }
+    constants.constants[0] = to_float;
+    constants.constants[1] = 0.0f;
+    constants.constants[2] = 1000.0f;
+    constants.constants[3] = -1000.0f;
+    
+    // Covariance rows in float: mantissa * 2^(cov_exp - 7) with a Q8.8 mantissa
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplat3D* splat = &splats[indices ? indices[i] : i];
+        float scale = ldexpf(1.0f / FIXED8_SCALE, (int)splat->cov_exp - 7);
+        for (int r = 0; r < 3; r++) {
+            sigma[i][r][0] = splat->cov_mant[r * 3 + 0] * scale;
+            sigma[i][r][1] = splat->cov_mant[r * 3 + 1] * scale;
+            sigma[i][r][2] = splat->cov_mant[r * 3 + 2] * scale;
+            sigma[i][r][3] = 0.0f;
+        }
+    }
+    
+#ifdef SPLATSTORM_HOST
+    // Host builds (make bench-host): the same steps on the host FPU
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplat3D* splat = &splats[indices ? indices[i] : i];
+        VU0ProjectResult* result = &results[i];
+        float pos[3];
+        for (int k = 0; k < 3; k++) {
+            pos[k] = (float)splat->pos[k] * constants.constants[0];
+        }
+        for (int k = 0; k < 4; k++) {
+            result->cam[k] = constants.view[0][k] * pos[0] + constants.view[1][k] * pos[1] +
+                             constants.view[2][k] * pos[2] + constants.view[3][k];
+        }
+        for (int k = 0; k < 4; k++) {
+            result->clip[k] = constants.proj[0][k] * result->cam[0] + constants.proj[1][k] * result->cam[1] +
+                              constants.proj[2][k] * result->cam[2] + constants.proj[3][k] * result->cam[3];
+        }
+        
+        float q = 1.0f / result->clip[3];
+        float jacobian[2][3], t[2][3];
+        for (int row = 0; row < 2; row++) {
+            for (int k = 0; k < 3; k++) {
+                float j = constants.proj_rows[row][k] * result->clip[3] - constants.proj_rows[2][k] * result->clip[row];
+                j = j * q * q * q;
+                jacobian[row][k] = CLAMP(j, constants.constants[3], constants.constants[2]);
+            }
+        }
+        for (int row = 0; row < 2; row++) {
+            for (int k = 0; k < 3; k++) {
+                t[row][k] = sigma[i][0][k] * jacobian[row][0] + sigma[i][1][k] * jacobian[row][1] +
+                            sigma[i][2][k] * jacobian[row][2];
+            }
+        }
+        for (int k = 0; k < 4; k++) {
+            const float* a = t[k >> 1];
+            const float* b = jacobian[k & 1];
+            result->cov[k] = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+    }
+#else
+    __asm__ volatile(
+        "lqc2       $vf1, 0x00(%0)          \n\t"
+        "lqc2       $vf2, 0x10(%0)          \n\t"
+        "lqc2       $vf3, 0x20(%0)          \n\t"
+        "lqc2       $vf4, 0x30(%0)          \n\t"
+        "lqc2       $vf5, 0x40(%0)          \n\t"
+        "lqc2       $vf6, 0x50(%0)          \n\t"
+        "lqc2       $vf7, 0x60(%0)          \n\t"
+        "lqc2       $vf8, 0x70(%0)          \n\t"
+        "lqc2       $vf9, 0x80(%0)          \n\t"
+        "lqc2       $vf10, 0x90(%0)         \n\t"
+        "lqc2       $vf11, 0xA0(%0)         \n\t"
+        "lqc2       $vf12, 0xB0(%0)         \n\t"
+        : : "r"(&constants) : "memory"
+    );
+    
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplat3D* splat = &splats[indices ? indices[i] : i];
+        __asm__ volatile(
+            "lqc2       $vf13, 0x00(%1)         \n\t"  // Q16.16 position (w ignored)
+            "lqc2       $vf14, 0x00(%2)         \n\t"  // Sigma rows
+            "lqc2       $vf15, 0x10(%2)         \n\t"
+            "lqc2       $vf16, 0x20(%2)         \n\t"
+            "vitof0.xyz $vf13, $vf13            \n\t"
+            "vmulx.xyz  $vf13, $vf13, $vf12x    \n\t"
+            "vmulax.xyzw  $ACC, $vf1, $vf13x    \n\t"  // cam = view * (pos, 1)
+            "vmadday.xyzw $ACC, $vf2, $vf13y    \n\t"
+            "vmaddaz.xyzw $ACC, $vf3, $vf13z    \n\t"
+            "vmaddw.xyzw  $vf17, $vf4, $vf0w    \n\t"
+            "vmulax.xyzw  $ACC, $vf5, $vf17x    \n\t"  // clip = proj * cam
+            "vmadday.xyzw $ACC, $vf6, $vf17y    \n\t"
+            "vmaddaz.xyzw $ACC, $vf7, $vf17z    \n\t"
+            "vmaddw.xyzw  $vf18, $vf8, $vf17w   \n\t"
+            "vdiv       $Q, $vf0w, $vf18w       \n\t"  // 1/s
+            "vmulaw.xyz $ACC, $vf9, $vf18w      \n\t"  // J0 = (P0 * s - P3 * u) / s^3
+            "vmsubx.xyz $vf19, $vf11, $vf18x    \n\t"
+            "vmulaw.xyz $ACC, $vf10, $vf18w     \n\t"  // J1 = (P1 * s - P3 * v) / s^3
+            "vmsuby.xyz $vf20, $vf11, $vf18y    \n\t"
+            "vwaitq                             \n\t"
+            "vmulq.xyz  $vf19, $vf19, $Q        \n\t"
+            "vmulq.xyz  $vf20, $vf20, $Q        \n\t"
+            "vmulq.xyz  $vf19, $vf19, $Q        \n\t"
+            "vmulq.xyz  $vf20, $vf20, $Q        \n\t"
+            "vmulq.xyz  $vf19, $vf19, $Q        \n\t"
+            "vmulq.xyz  $vf20, $vf20, $Q        \n\t"
+            "vminiz.xyz $vf19, $vf19, $vf12z    \n\t"  // Clamp to +-1000
+            "vminiz.xyz $vf20, $vf20, $vf12z    \n\t"
+            "vmaxw.xyz  $vf19, $vf19, $vf12w    \n\t"
+            "vmaxw.xyz  $vf20, $vf20, $vf12w    \n\t"
+            "vmulax.xyz  $ACC, $vf14, $vf19x    \n\t"  // T0 = J0 * Sigma
+            "vmadday.xyz $ACC, $vf15, $vf19y    \n\t"
+            "vmaddz.xyz  $vf21, $vf16, $vf19z   \n\t"
+            "vmulax.xyz  $ACC, $vf14, $vf20x    \n\t"  // T1 = J1 * Sigma
+            "vmadday.xyz $ACC, $vf15, $vf20y    \n\t"
+            "vmaddz.xyz  $vf22, $vf16, $vf20z   \n\t"
+            "vmul.xyz   $vf23, $vf21, $vf19     \n\t"  // Row-by-row products for T * J^T
+            "vmul.xyz   $vf24, $vf21, $vf20     \n\t"
+            "vmul.xyz   $vf25, $vf22, $vf19     \n\t"
+            "vmul.xyz   $vf26, $vf22, $vf20     \n\t"
+            "vaddy.x    $vf23, $vf23, $vf23y    \n\t"  // xx
+            "vaddz.x    $vf23, $vf23, $vf23z    \n\t"
+            "vaddx.y    $vf23, $vf24, $vf24x    \n\t"  // xy
+            "vaddz.y    $vf23, $vf23, $vf24z    \n\t"
+            "vaddx.z    $vf23, $vf25, $vf25x    \n\t"  // yx
+            "vaddy.z    $vf23, $vf23, $vf25y    \n\t"
+            "vaddy.x    $vf26, $vf26, $vf26y    \n\t"  // yy
+            "vaddz.x    $vf26, $vf26, $vf26z    \n\t"
+            "vmulx.w    $vf23, $vf0, $vf26x     \n\t"
+            "sqc2       $vf17, 0x00(%0)         \n\t"
+            "sqc2       $vf18, 0x10(%0)         \n\t"
+            "sqc2       $vf23, 0x20(%0)         \n\t"
+            : : "r"(&results[i]), "r"(splat->pos), "r"(sigma[i]) : "memory"
+        );
+    }
+#endif
+    
+    // FPU pass: same tests, screen mapping and Q8.8 rounding as project_gaussian_complete()
+    const float epsilon = EPSILON * to_float;
+    const float regularization = REGULARIZATION_EPSILON * to_float;
+    float viewport[4];
+    for (int j = 0; j < 4; j++) {
+        viewport[j] = camera->viewport[j] * to_float;
+    }
+    
+    u32 mask = 0;
+    for (u32 i = 0; i < count; i++) {
+        const VU0ProjectResult* result = &results[i];
+        const GaussianSplat3D* splat = &splats[indices ? indices[i] : i];
+        GaussianSplat2D* splat2d = &out[i];
+        
+        if (result->cam[2] <= epsilon || fabsf(result->clip[3]) < epsilon) {
+            continue;  // Behind the camera or degenerate
+        }
+        
+        float inv_w = 1.0f / result->clip[3];
+        float ndc_x = result->clip[0] * inv_w;
+        float ndc_y = result->clip[1] * inv_w;
+        if (ndc_x < -1.0f || ndc_x > 1.0f || ndc_y < -1.0f || ndc_y > 1.0f) {
+            continue;  // Outside the view frustum
+        }
+        
+        splat2d->screen_pos[0] = fixed_from_float((ndc_x + 1.0f) * 0.5f * viewport[2] + viewport[0]);
+        splat2d->screen_pos[1] = fixed_from_float((1.0f - ndc_y) * 0.5f * viewport[3] + viewport[1]);
+        splat2d->depth = fixed_from_float(result->cam[2]);
+        
+        for (int k = 0; k < 4; k++) {
+            splat2d->cov_2d[k] = float_to_q8_floor(result->cov[k]);
+        }
+        
+        // Eigen decomposition and inverse from the stored Q8.8 covariance
+        float a = splat2d->cov_2d[0] * (1.0f / FIXED8_SCALE) + regularization;
+        float b = splat2d->cov_2d[1] * (1.0f / FIXED8_SCALE);
+        float c = splat2d->cov_2d[2] * (1.0f / FIXED8_SCALE);
+        float d = splat2d->cov_2d[3] * (1.0f / FIXED8_SCALE) + regularization;
+        float trace = a + d;
+        float det = a * d - b * c;
+        float discriminant = trace * trace - 4.0f * det;
+        
+        float eigenvals[2];
+        float eigenvecs[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+        if (discriminant < 0.0f) {
+            eigenvals[0] = eigenvals[1] = trace * 0.5f;
+        } else {
+            float sqrt_disc = sqrtf(discriminant);
+            eigenvals[0] = MAX((trace + sqrt_disc) * 0.5f, 0.0f);
+            eigenvals[1] = MAX((trace - sqrt_disc) * 0.5f, 0.0f);
+            
+            if (fabsf(b) > epsilon) {
+                float v1_x = eigenvals[0] - d;
+                float v1_len = sqrtf(v1_x * v1_x + b * b);
+                if (v1_len > epsilon) {
+                    eigenvecs[0] = v1_x / v1_len;
+                    eigenvecs[1] = b / v1_len;
+                }
+                eigenvecs[2] = -eigenvecs[1];
+                eigenvecs[3] = eigenvecs[0];
+            }
+        }
+        for (int k = 0; k < 2; k++) {
+            splat2d->eigenvals[k] = fixed_from_float(eigenvals[k]);
+        }
+        for (int k = 0; k < 4; k++) {
+            splat2d->eigenvecs[k] = fixed_from_float(eigenvecs[k]);
+        }
+        splat2d->radius = fixed_from_float(3.0f * sqrtf(MAX(eigenvals[0], eigenvals[1])));
+        
+        if (fabsf(det) < epsilon) {
+            splat2d->inv_cov_2d[0] = FIXED8_SCALE; splat2d->inv_cov_2d[1] = 0;
+            splat2d->inv_cov_2d[2] = 0; splat2d->inv_cov_2d[3] = FIXED8_SCALE;
+        } else {
+            float inv_det = 1.0f / det;
+            splat2d->inv_cov_2d[0] = float_to_q8_floor(d * inv_det);
+            splat2d->inv_cov_2d[1] = float_to_q8_floor(-b * inv_det);
+            splat2d->inv_cov_2d[2] = float_to_q8_floor(-c * inv_det);
+            splat2d->inv_cov_2d[3] = float_to_q8_floor(a * inv_det);
+        }
+        
+        memcpy(splat2d->color, splat->color, 3);
+        splat2d->color[3] = splat->opacity;
+        compute_atlas_uv_coordinates(splat2d);
+        
+        mask |= 1u << i;
+    }
+    
+    *visible_mask = mask;
+    return GAUSSIAN_SUCCESS;
+}
+
 // Compute atlas UV coordinates for footprint lookup
 void compute_atlas_uv_coordinates(GaussianSplat2D* splat2d) {
     // Compute aspect ratio from eigenvalues
     fixed16_t ev1 = splat2d->eigenvals[0];
     fixed16_t ev2 = splat2d->eigenvals[1];
     
+    // Mip level from the sprite diameter (2 * radius, rounded up)
+    splat2d->atlas_level = (u8)footprint_atlas_level((u32)(MAX(splat2d->radius, 0) >> (FIXED16_SHIFT - 1)) + 1);
+    
     if (ev2 <= EPSILON) {
         splat2d->atlas_u = 0;
         splat2d->atlas_v = 0;
@@ -831,16 +1223,17 @@ GaussianResult gaussian_luts_generate_all(GaussianLUTs* luts) {
     
     printf("SPLATSTORM X: Initializing complete LUT system...\n");
     
-    // Allocate memory for all LUTs
-    luts->exp_lut = (u32*)memalign(CACHE_LINE_SIZE, LUT_SIZE * sizeof(u32));
-    luts->sqrt_lut = (u32*)memalign(CACHE_LINE_SIZE, LUT_SIZE * sizeof(u32));
-    luts->cov_inv_lut = (u32*)memalign(CACHE_LINE_SIZE, COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32));
-    luts->footprint_atlas = (u32*)memalign(CACHE_LINE_SIZE, ATLAS_SIZE * ATLAS_SIZE * sizeof(u32));
-    luts->sh_lighting_lut = (u32*)memalign(CACHE_LINE_SIZE, 256 * 256 * sizeof(u32));
-    luts->recip_lut = (u32*)memalign(CACHE_LINE_SIZE, LUT_SIZE * sizeof(u32));
+    // Allocate memory for all LUTs from the asset budget
+    luts->exp_lut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, LUT_SIZE * sizeof(u32), CACHE_LINE_SIZE);
+    luts->sqrt_lut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, LUT_SIZE * sizeof(u32), CACHE_LINE_SIZE);
+    luts->cov_inv_lut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32), CACHE_LINE_SIZE);
+    luts->footprint_atlas = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, FOOTPRINT_ATLAS_BYTES, CACHE_LINE_SIZE);
+    luts->footprint_clut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, FOOTPRINT_CLUT_ENTRIES * sizeof(u32), CACHE_LINE_SIZE);
+    luts->sh_lighting_lut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, 256 * 256 * sizeof(u32), CACHE_LINE_SIZE);
+    luts->recip_lut = (u32*)memory_alloc(MEMORY_BUDGET_ASSET, LUT_SIZE * sizeof(u32), CACHE_LINE_SIZE);
     
     if (!luts->exp_lut || !luts->sqrt_lut || !luts->cov_inv_lut || 
-        !luts->footprint_atlas || !luts->sh_lighting_lut || !luts->recip_lut) {
+        !luts->footprint_atlas || !luts->footprint_clut || !luts->sh_lighting_lut || !luts->recip_lut) {
         gaussian_luts_cleanup(luts);
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
@@ -855,13 +1248,15 @@ GaussianResult gaussian_luts_generate_all(GaussianLUTs* luts) {
     memcpy(luts->exp_lut, g_exp_lut, LUT_SIZE * sizeof(u32));
     memcpy(luts->sqrt_lut, g_sqrt_lut, LUT_SIZE * sizeof(u32));
     memcpy(luts->cov_inv_lut, g_cov_inv_lut, COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32));
-    memcpy(luts->footprint_atlas, g_footprint_atlas, ATLAS_SIZE * ATLAS_SIZE * sizeof(u32));
+    footprint_atlas_pack(g_footprint_atlas, luts->footprint_atlas);
+    footprint_clut_build(luts->footprint_clut);
     memcpy(luts->sh_lighting_lut, g_sh_lighting_lut, 256 * 256 * sizeof(u32));
     memcpy(luts->recip_lut, g_recip_lut, LUT_SIZE * sizeof(u32));
     
     // Calculate total memory usage
     luts->total_memory_usage = (LUT_SIZE * 2 + COV_INV_LUT_RES * COV_INV_LUT_RES + 
-                               ATLAS_SIZE * ATLAS_SIZE + 256 * 256 + LUT_SIZE) * sizeof(u32);
+                               FOOTPRINT_CLUT_ENTRIES + 256 * 256 + LUT_SIZE) * sizeof(u32) +
+                               FOOTPRINT_ATLAS_BYTES;
     
     luts->initialized = true;
     
@@ -871,6 +1266,88 @@ GaussianResult gaussian_luts_generate_all(GaussianLUTs* luts) {
     return GAUSSIAN_SUCCESS;
 }
 
+// Load the cooked LUT file: one header read, one payload read, then the
+// tables are used in place. The EE math tables are copied into their
+// globals, so fixed-point helpers see the same values as after generation.
+// Returns GAUSSIAN_ERROR_FILE_NOT_FOUND when there is no file to load.
+GaussianResult gaussian_luts_load(GaussianLUTs* luts, const char* filename) {
+    if (!luts || !filename) return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    
+    int fd = open_file_auto(filename, O_RDONLY);
+    if (fd < 0) {
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    CookedLUTHeader header;
+    if (read_file_data(fd, &header, sizeof(header)) != (int)sizeof(header) ||
+        header.magic != LUT_COOKED_MAGIC || header.version != LUT_COOKED_VERSION) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_INVALID_FORMAT;
+    }
+    
+    // Every table must have this build's size; the footprint texels also
+    // depend on the atlas PSM
+    static const u32 sizes[LUT_SECTION_COUNT] = {
+        LUT_SIZE * sizeof(u32), LUT_SIZE * sizeof(u32), LUT_SIZE * sizeof(u32),
+        LUT_SIZE * sizeof(u32), LUT_SIZE * sizeof(u32), LUT_SIZE * LUT_SIZE * sizeof(u32),
+        COV_INV_LUT_RES * COV_INV_LUT_RES * sizeof(u32), FOOTPRINT_ATLAS_BYTES,
+        FOOTPRINT_CLUT_ENTRIES * sizeof(u32), 256 * 256 * sizeof(u32)
+    };
+    bool valid = header.footprint_bits == FOOTPRINT_ATLAS_BITS && (header.payload_size % DMA_ALIGNMENT) == 0;
+    for (u32 s = 0; s < LUT_SECTION_COUNT && valid; s++) {
+        valid = header.sections[s].size == sizes[s] && (header.sections[s].offset % DMA_ALIGNMENT) == 0 &&
+                header.sections[s].offset + header.sections[s].size <= header.payload_size;
+    }
+    if (!valid) {
+        printf("SPLATSTORM X: Cooked LUTs %s do not match this build, generating\n", filename);
+        close_file(fd);
+        return GAUSSIAN_ERROR_UNSUPPORTED_FORMAT;
+    }
+    
+    u8* payload = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, header.payload_size, DMA_ALIGNMENT);
+    if (!payload) {
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
+    int bytes_read = read_file_data(fd, payload, header.payload_size);
+    close_file(fd);
+    if (bytes_read != (int)header.payload_size) {
+        printf("SPLATSTORM X: Cooked LUTs truncated (%d of %u bytes)\n", bytes_read, header.payload_size);
+        memory_free(payload);
+        return GAUSSIAN_ERROR_FILE_READ_FAILED;
+    }
+    
+    #define LUT_SECTION(s) (payload + header.sections[s].offset)
+    memcpy(g_exp_lut, LUT_SECTION(LUT_SECTION_EXP), sizes[LUT_SECTION_EXP]);
+    memcpy(g_sqrt_lut, LUT_SECTION(LUT_SECTION_SQRT), sizes[LUT_SECTION_SQRT]);
+    memcpy(g_recip_lut, LUT_SECTION(LUT_SECTION_RECIP), sizes[LUT_SECTION_RECIP]);
+    memcpy(g_sin_lut, LUT_SECTION(LUT_SECTION_SIN), sizes[LUT_SECTION_SIN]);
+    memcpy(g_cos_lut, LUT_SECTION(LUT_SECTION_COS), sizes[LUT_SECTION_COS]);
+    memcpy(g_atan2_lut, LUT_SECTION(LUT_SECTION_ATAN2), sizes[LUT_SECTION_ATAN2]);
+    memcpy(g_cov_inv_lut, LUT_SECTION(LUT_SECTION_COV_INV), sizes[LUT_SECTION_COV_INV]);
+    memcpy(g_sh_lighting_lut, LUT_SECTION(LUT_SECTION_SH_LIGHTING), sizes[LUT_SECTION_SH_LIGHTING]);
+    
+    if (luts->initialized) {
+        gaussian_luts_cleanup(luts);
+    }
+    luts->cooked_payload = payload;
+    luts->exp_lut = (u32*)LUT_SECTION(LUT_SECTION_EXP);
+    luts->sqrt_lut = (u32*)LUT_SECTION(LUT_SECTION_SQRT);
+    luts->recip_lut = (u32*)LUT_SECTION(LUT_SECTION_RECIP);
+    luts->cov_inv_lut = (u32*)LUT_SECTION(LUT_SECTION_COV_INV);
+    luts->footprint_atlas = LUT_SECTION(LUT_SECTION_FOOTPRINT_TEXELS);
+    luts->footprint_clut = (u32*)LUT_SECTION(LUT_SECTION_FOOTPRINT_CLUT);
+    luts->sh_lighting_lut = (u32*)LUT_SECTION(LUT_SECTION_SH_LIGHTING);
+    #undef LUT_SECTION
+    
+    luts->total_memory_usage = header.payload_size;
+    luts->initialized = true;
+    
+    printf("SPLATSTORM X: Cooked LUTs loaded from %s (%u KB)\n", filename, header.payload_size / 1024);
+    return GAUSSIAN_SUCCESS;
+}
+
 // Memory pool implementation
 GaussianResult memory_pool_init(MemoryPool* pool, u32 size, u32 alignment) {
     if (!pool || size == 0 || alignment == 0) {
@@ -880,7 +1357,7 @@ GaussianResult memory_pool_init(MemoryPool* pool, u32 size, u32 alignment) {
     // Align size to cache line boundary
     size = ALIGN_UP(size, CACHE_LINE_SIZE);
     
-    pool->memory_block = memalign(alignment, size);
+    pool->memory_block = memory_alloc(MEMORY_BUDGET_SCENE, size, alignment);
     if (!pool->memory_block) {
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
@@ -896,7 +1373,7 @@ GaussianResult memory_pool_init(MemoryPool* pool, u32 size, u32 alignment) {
     return GAUSSIAN_SUCCESS;
 }
 
-void* local_local_memory_pool_alloc(MemoryPool* pool, u32 size) {
+void* local_memory_pool_alloc(MemoryPool* pool, u32 size) {
     if (!pool || !pool->initialized || size == 0) {
         return NULL;
     }
@@ -926,7 +1403,7 @@ void local_memory_pool_reset(MemoryPool* pool) {
 void memory_pool_destroy(MemoryPool* pool) {
     if (pool && pool->initialized) {
         if (pool->memory_block) {
-            free(pool->memory_block);
+            memory_free(pool->memory_block);
             pool->memory_block = NULL;
         }
         pool->initialized = false;
@@ -943,27 +1420,30 @@ GaussianResult gaussian_scene_init(GaussianScene* scene, u32 max_splats) {
     
     printf("SPLATSTORM X: Initializing Gaussian scene (max %u splats)...\n", max_splats);
     
-    // Initialize memory pool (32MB for large scenes)
-    GaussianResult result = memory_pool_init(&scene->memory_pool, 32 * 1024 * 1024, CACHE_LINE_SIZE);
+    // Set before anything can fail: gaussian_scene_destroy releases it
+    scene->cooked_payload = NULL;
+    
+    // Scene pool sized for exactly the arrays below (plus per-array alignment).
+    // Nothing in it scales with the scene: every loader brings its own records,
+    // so a large scene has the rest of the scene budget to itself.
+    u32 pool_size = (MAX_TILES + MAX_COARSE_TILES) * sizeof(TileRange) +
+                    MAX_TILES * MAX_SPLATS_PER_TILE * sizeof(u32) +
+                    2 * VU_BATCH_SIZE * (sizeof(GaussianSplat3D) + sizeof(GaussianSplat2D)) +
+                    16 * CACHE_LINE_SIZE;
+    GaussianResult result = memory_pool_init(&scene->memory_pool, pool_size, CACHE_LINE_SIZE);
     if (result != GAUSSIAN_SUCCESS) {
         return result;
     }
     
-    // Allocate main arrays
-    scene->splats_3d = (GaussianSplat3D*)local_memory_pool_alloc(&scene->memory_pool, 
-                                                          max_splats * sizeof(GaussianSplat3D));
-    scene->splats_2d = (GaussianSplat2D*)local_memory_pool_alloc(&scene->memory_pool, 
-                                                          max_splats * sizeof(GaussianSplat2D));
-    scene->sort_keys = (u32*)local_memory_pool_alloc(&scene->memory_pool, max_splats * sizeof(u32));
-    scene->sort_indices = (u16*)local_memory_pool_alloc(&scene->memory_pool, max_splats * sizeof(u16));
+    // Allocate main arrays; records arrive with the scene
+    scene->splats_3d = NULL;
     scene->tile_ranges = (TileRange*)local_memory_pool_alloc(&scene->memory_pool, MAX_TILES * sizeof(TileRange));
     scene->coarse_tile_ranges = (TileRange*)local_memory_pool_alloc(&scene->memory_pool, 
                                                              MAX_COARSE_TILES * sizeof(TileRange));
     scene->tile_splat_lists = (u32*)local_memory_pool_alloc(&scene->memory_pool, 
                                                       MAX_TILES * MAX_SPLATS_PER_TILE * sizeof(u32));
     
-    if (!scene->splats_3d || !scene->splats_2d || !scene->sort_keys || !scene->sort_indices ||
-        !scene->tile_ranges || !scene->coarse_tile_ranges || !scene->tile_splat_lists) {
+    if (!scene->tile_ranges || !scene->coarse_tile_ranges || !scene->tile_splat_lists) {
         gaussian_scene_destroy(scene);
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
@@ -984,8 +1464,16 @@ GaussianResult gaussian_scene_init(GaussianScene* scene, u32 max_splats) {
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
     
-    // Initialize LUT system
-    result = gaussian_luts_generate_all(&scene->luts);
+    // Initialize LUT system: cooked tables if present, generated otherwise
+    memset(&scene->luts, 0, sizeof(GaussianLUTs));
+    boot_profile_begin("LUT load");
+    result = gaussian_luts_load(&scene->luts, LUT_COOKED_FILENAME);
+    boot_profile_end();
+    if (result != GAUSSIAN_SUCCESS) {
+        boot_profile_begin("LUT generation");
+        result = gaussian_luts_generate_all(&scene->luts);
+        boot_profile_end();
+    }
     if (result != GAUSSIAN_SUCCESS) {
         gaussian_scene_destroy(scene);
         return result;
@@ -1024,6 +1512,11 @@ void gaussian_scene_destroy(GaussianScene* scene) {
     // Cleanup LUTs
     gaussian_luts_cleanup(&scene->luts);
     
+    // Cooked scenes keep records, streams and octree in one scene-budget block
+    if (scene->cooked_payload) {
+        memory_free(scene->cooked_payload);
+    }
+    
     // Destroy memory pool (this frees all allocated memory)
     memory_pool_destroy(&scene->memory_pool);
     
@@ -1033,135 +1526,343 @@ void gaussian_scene_destroy(GaussianScene* scene) {
     printf("SPLATSTORM X: Scene destroyed\n");
 }
 
-void gaussian_luts_cleanup(GaussianLUTs* luts) {
-    if (!luts) return;
+// Covariance from per-axis scale and a rotation quaternion (w, x, y, z, the
+// PLY rot_0..rot_3 order): Σ = R S² Rᵀ, as in asset_manager_complete.c.
+// Stored as Q8.8 mantissas under one exponent, value = mantissa * 2^(cov_exp - 7),
+// with the exponent at the largest entry's octave.
+void gaussian_covariance_from_scale_rotation(const float scale[3], const float rotation[4],
+                                             fixed8_t cov_mant[9], u8* cov_exp) {
+    float w = rotation[0], x = rotation[1], y = rotation[2], z = rotation[3];
+    float norm = sqrtf(w * w + x * x + y * y + z * z);
+    if (norm > 0.0001f) {
+        w /= norm; x /= norm; y /= norm; z /= norm;
+    } else {
+        w = 1.0f; x = 0.0f; y = 0.0f; z = 0.0f;
+    }
     
-    if (luts->exp_lut) { free(luts->exp_lut); luts->exp_lut = NULL; }
-    if (luts->sqrt_lut) { free(luts->sqrt_lut); luts->sqrt_lut = NULL; }
-    if (luts->cov_inv_lut) { free(luts->cov_inv_lut); luts->cov_inv_lut = NULL; }
-    if (luts->footprint_atlas) { free(luts->footprint_atlas); luts->footprint_atlas = NULL; }
-    if (luts->sh_lighting_lut) { free(luts->sh_lighting_lut); luts->sh_lighting_lut = NULL; }
-    if (luts->recip_lut) { free(luts->recip_lut); luts->recip_lut = NULL; }
+    float r[9] = {
+        1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+        2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+        2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)
+    };
+    float s2[3] = {scale[0] * scale[0], scale[1] * scale[1], scale[2] * scale[2]};
     
-    luts->initialized = false;
-    luts->total_memory_usage = 0;
+    float cov[9];
+    float max_cov = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            float c = r[i * 3] * r[j * 3] * s2[0] + r[i * 3 + 1] * r[j * 3 + 1] * s2[1] +
+                      r[i * 3 + 2] * r[j * 3 + 2] * s2[2];
+            cov[i * 3 + j] = c;
+            max_cov = MAX(max_cov, fabsf(c));
+        }
+    }
+    
+    // frexpf gives the octave exactly, so host tools reproduce the exponent
+    int exp = 7;
+    if (max_cov > 0.0f) {
+        int octave;
+        frexpf(max_cov, &octave);  // max_cov = m * 2^octave, m in [0.5, 1)
+        exp = CLAMP(octave - 1 + 7, 0, 15);
+    }
+    
+    float to_mantissa = ldexpf(256.0f, 7 - exp);
+    for (int i = 0; i < 9; i++) {
+        float mantissa = cov[i] * to_mantissa;
+        cov_mant[i] = (fixed8_t)CLAMP(mantissa, -32768.0f, 32767.0f);
+    }
+    *cov_exp = (u8)exp;
 }
 
-// Global system buffers - COMPLETE IMPLEMENTATION
-static GaussianSplat3D* g_system_splat_buffer = NULL;
-static GaussianSplat2D* g_system_projection_buffer = NULL;
-static u32* g_system_sort_keys = NULL;
-static u16* g_system_sort_indices = NULL;
-static u32 g_system_max_splats = 0;
-
-// Global system initialization - COMPLETE IMPLEMENTATION
-GaussianResult gaussian_system_init(u32 max_splats) {
-    printf("SPLATSTORM X: Initializing complete Gaussian system for %u splats...\n", max_splats);
+// Bounding radius used by culling: 3 * sqrt(largest covariance diagonal)
+// The largest diagonal element stands in for the largest eigenvalue.
+fixed16_t gaussian_splat_bounding_radius(const GaussianSplat3D* splat) {
+    fixed8_t max_cov = splat->cov_mant[0];  // cov[0][0]
+    if (splat->cov_mant[4] > max_cov) max_cov = splat->cov_mant[4];  // cov[1][1]
+    if (splat->cov_mant[8] > max_cov) max_cov = splat->cov_mant[8];  // cov[2][2]
+    if (max_cov <= 0) {
+        return 0;
+    }
     
-    // Validate max_splats parameter
-    if (max_splats == 0 || max_splats > MAX_SPLATS_PER_SCENE) {
-        printf("SPLATSTORM X: Invalid max_splats parameter: %u (max: %u)\n", max_splats, MAX_SPLATS_PER_SCENE);
+    // Convert Q8.8 to Q16.16, apply the 2^(cov_exp - 7) scale and take square root
+    fixed16_t max_cov_16 = (fixed16_t)max_cov << 8;
+    if (splat->cov_exp >= 7) {
+        u32 shift = splat->cov_exp - 7;
+        max_cov_16 = (max_cov_16 > (FIXED16_MAX >> shift)) ? FIXED16_MAX : max_cov_16 << shift;
+    } else {
+        max_cov_16 >>= 7 - splat->cov_exp;
+    }
+    return fixed_mul(fixed_from_float(3.0f), fixed16_sqrt(max_cov_16));
+}
+
+// Write one splat's hot, warm and cold entries; hot alone in a compact set
+void gaussian_splat_streams_store(GaussianSplatStreams* streams, u32 index, const GaussianSplat3D* splat) {
+    GaussianSplatHot* hot = &streams->hot[index];
+    hot->pos[0] = splat->pos[0];
+    hot->pos[1] = splat->pos[1];
+    hot->pos[2] = splat->pos[2];
+    hot->radius = gaussian_splat_bounding_radius(splat);
+    if (!streams->warm) return;
+    
+    GaussianSplatWarm* warm = &streams->warm[index];
+    GaussianSplatCold* cold = &streams->cold[index];
+    memcpy(warm->cov_mant, splat->cov_mant, sizeof(warm->cov_mant));
+    warm->cov_exp = splat->cov_exp;
+    memcpy(warm->color, splat->color, sizeof(warm->color));
+    warm->opacity = splat->opacity;
+    memset(warm->padding, 0, sizeof(warm->padding));
+    
+    memcpy(cold->sh_coeffs, splat->sh_coeffs, sizeof(cold->sh_coeffs));
+    cold->importance = splat->importance;
+    memset(cold->padding, 0, sizeof(cold->padding));
+}
+
+// Split an AoS splat array into hot/warm/cold streams
+// Streams live as long as the pool; rebuilding reallocates from it. Culling
+// reads only hot, so a scene too large for all three keeps the compact set:
+// hot alone, warm and cold NULL, every other reader on the records.
+GaussianResult gaussian_splat_streams_build(GaussianSplatStreams* streams, const GaussianSplat3D* splats,
+                                           u32 count, u32 pool_id) {
+    if (!streams || !splats || count == 0) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
-    // Store system capacity
-    g_system_max_splats = max_splats;
+    memset(streams, 0, sizeof(GaussianSplatStreams));
+    streams->hot = (GaussianSplatHot*)memory_pool_alloc(pool_id, count * sizeof(GaussianSplatHot),
+                                                          CACHE_LINE_SIZE, __FILE__, __LINE__);
+    if (!streams->hot) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    streams->warm = (GaussianSplatWarm*)memory_pool_alloc(pool_id, count * sizeof(GaussianSplatWarm),
+                                                            CACHE_LINE_SIZE, __FILE__, __LINE__);
+    streams->cold = (GaussianSplatCold*)memory_pool_alloc(pool_id, count * sizeof(GaussianSplatCold),
+                                                            CACHE_LINE_SIZE, __FILE__, __LINE__);
+    if (!streams->warm || !streams->cold) {
+        memory_pool_free(pool_id, streams->warm);
+        memory_pool_free(pool_id, streams->cold);
+        streams->warm = NULL;
+        streams->cold = NULL;
+    }
     
-    // Allocate global system buffers based on max_splats parameter - COMPLETE IMPLEMENTATION
-    printf("SPLATSTORM X: Allocating system buffers for %u splats...\n", max_splats);
+    for (u32 i = 0; i < count; i++) {
+        gaussian_splat_streams_store(streams, i, &splats[i]);
+    }
     
-    // 3D splat buffer for system-wide operations
-    g_system_splat_buffer = (GaussianSplat3D*)malloc(max_splats * sizeof(GaussianSplat3D));
-    if (!g_system_splat_buffer) {
-        printf("SPLATSTORM X: Failed to allocate 3D splat buffer (%u bytes)\n", 
-               max_splats * sizeof(GaussianSplat3D));
-        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    streams->count = count;
+    if (streams->warm) {
+        printf("SPLATSTORM X: Splat streams built (%u splats, %u/%u/%u bytes hot/warm/cold)\n",
+               count, (u32)sizeof(GaussianSplatHot), (u32)sizeof(GaussianSplatWarm), (u32)sizeof(GaussianSplatCold));
+    } else {
+        printf("SPLATSTORM X: Compact splat streams built (%u splats, %u bytes hot only)\n",
+               count, (u32)sizeof(GaussianSplatHot));
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+// Rebuild one render record from the hot and warm streams
+// The cold stream is not read: nothing on the render path uses SH or importance.
+void gaussian_splat_streams_gather(const GaussianSplatStreams* streams, u32 index, GaussianSplat3D* out) {
+    const GaussianSplatHot* hot = &streams->hot[index];
+    const GaussianSplatWarm* warm = &streams->warm[index];
+    
+    out->pos[0] = hot->pos[0];
+    out->pos[1] = hot->pos[1];
+    out->pos[2] = hot->pos[2];
+    out->cov_exp = warm->cov_exp;
+    out->padding_bits = 0;
+    memcpy(out->cov_mant, warm->cov_mant, sizeof(out->cov_mant));
+    memcpy(out->color, warm->color, sizeof(out->color));
+    out->opacity = warm->opacity;
+    memset(out->sh_coeffs, 0, sizeof(out->sh_coeffs));
+    out->importance = 0;
+}
+
+// Move records along the cycles of position[old] = new, which is consumed;
+// streams are rewritten afterwards
+static void splats_apply_positions(GaussianSplat3D* splats, GaussianSplatStreams* streams,
+                                   u32 count, u32* position) {
+    for (u32 i = 0; i < count; i++) {
+        while (position[i] != i) {
+            u32 target = position[i];
+            GaussianSplat3D moved = splats[target];
+            splats[target] = splats[i];
+            splats[i] = moved;
+            position[i] = position[target];
+            position[target] = target;
+        }
     }
-    memset(g_system_splat_buffer, 0, max_splats * sizeof(GaussianSplat3D));
     
-    // 2D projection buffer for system-wide operations
-    g_system_projection_buffer = (GaussianSplat2D*)malloc(max_splats * sizeof(GaussianSplat2D));
-    if (!g_system_projection_buffer) {
-        printf("SPLATSTORM X: Failed to allocate 2D projection buffer (%u bytes)\n", 
-               max_splats * sizeof(GaussianSplat2D));
-        free(g_system_splat_buffer);
-        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    if (streams && streams->hot && streams->count >= count) {
+        for (u32 i = 0; i < count; i++) {
+            gaussian_splat_streams_store(streams, i, &splats[i]);
+        }
+    }
+}
+
+/*
+ * Reorder splats so that index i holds the splat that was at order[i]; order
+ * must be a permutation of 0..count-1. remap, when given, receives each
+ * splat's new index by old index. Streams are rewritten in the new order.
+ */
+GaussianResult gaussian_splats_permute(GaussianSplat3D* splats, GaussianSplatStreams* streams,
+                                       u32 count, const u32* order, u32* remap) {
+    if (!splats || !order || count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
-    memset(g_system_projection_buffer, 0, max_splats * sizeof(GaussianSplat2D));
     
-    // Sort keys for depth sorting
-    g_system_sort_keys = (u32*)malloc(max_splats * sizeof(u32));
-    if (!g_system_sort_keys) {
-        printf("SPLATSTORM X: Failed to allocate sort keys buffer (%u bytes)\n", 
-               max_splats * sizeof(u32));
-        free(g_system_splat_buffer);
-        free(g_system_projection_buffer);
-        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    u32* position = (u32*)memory_alloc(MEMORY_BUDGET_SCENE, count * sizeof(u32), CACHE_LINE_SIZE);
+    if (!position) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
-    memset(g_system_sort_keys, 0, max_splats * sizeof(u32));
     
-    // Sort indices for depth sorting
-    g_system_sort_indices = (u16*)malloc(max_splats * sizeof(u16));
-    if (!g_system_sort_indices) {
-        printf("SPLATSTORM X: Failed to allocate sort indices buffer (%u bytes)\n", 
-               max_splats * sizeof(u16));
-        free(g_system_splat_buffer);
-        free(g_system_projection_buffer);
-        free(g_system_sort_keys);
-        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    for (u32 i = 0; i < count; i++) {
+        position[order[i]] = i;
+    }
+    if (remap) {
+        memcpy(remap, position, count * sizeof(u32));
     }
+    splats_apply_positions(splats, streams, count, position);
     
-    // Initialize sort indices
-    for (u32 i = 0; i < max_splats; i++) {
-        g_system_sort_indices[i] = (u16)i;
+    memory_free(position);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Importance of the splat a remaining sort pass places next; ~ sorts descending
+static inline u32 importance_sort_key(const GaussianSplat3D* splats, u32 index) {
+    return ~splats[index].importance;
+}
+
+/*
+ * Reorder splats most important first. Splat budgets keep the first N splats
+ * (culling skips indices at or past it), so after this they keep the N most
+ * important ones. Stable: equal importance keeps the current order. remap,
+ * when given, receives each splat's new index by old index, for index arrays
+ * that point into the splats. Streams are rewritten in the new order.
+ */
+GaussianResult gaussian_splats_sort_by_importance(GaussianSplat3D* splats, GaussianSplatStreams* streams,
+                                                  u32 count, u32* remap) {
+    if (!splats || count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
-    printf("SPLATSTORM X: System buffers allocated successfully:\n");
-    printf("  - 3D splats: %u bytes\n", max_splats * sizeof(GaussianSplat3D));
-    printf("  - 2D projections: %u bytes\n", max_splats * sizeof(GaussianSplat2D));
-    printf("  - Sort keys: %u bytes\n", max_splats * sizeof(u32));
-    printf("  - Sort indices: %u bytes\n", max_splats * sizeof(u16));
-    printf("  - Total system memory: %u bytes\n", 
-           max_splats * (sizeof(GaussianSplat3D) + sizeof(GaussianSplat2D) + sizeof(u32) + sizeof(u16)));
+    // Cooked scenes come sorted from tools/cook_scene.py
+    u32 first_out_of_order = 1;
+    while (first_out_of_order < count &&
+           splats[first_out_of_order].importance <= splats[first_out_of_order - 1].importance) {
+        first_out_of_order++;
+    }
+    if (first_out_of_order == count) {
+        for (u32 i = 0; remap && i < count; i++) {
+            remap[i] = i;
+        }
+        return GAUSSIAN_SUCCESS;
+    }
     
-    // Generate global LUTs
-    generate_luts();
-    generate_cov_inv_lut_complete();
-    generate_footprint_atlas_complete();
-    generate_sh_lighting_lut_complete();
+    u32* order = (u32*)memory_alloc(MEMORY_BUDGET_SCENE, count * sizeof(u32), CACHE_LINE_SIZE);
+    u32* scratch = (u32*)memory_alloc(MEMORY_BUDGET_SCENE, count * sizeof(u32), CACHE_LINE_SIZE);
+    if (!order || !scratch) {
+        memory_free(order);
+        memory_free(scratch);
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
     
-    printf("SPLATSTORM X: System initialization complete for %u splats\n", max_splats);
+    // LSD radix sort of splat indices, 8 bits per pass, uniform digits skipped
+    static u32 histograms[4 * 256];
+    memset(histograms, 0, sizeof(histograms));
+    for (u32 i = 0; i < count; i++) {
+        u32 key = importance_sort_key(splats, i);
+        histograms[0 * 256 + (key & 0xFF)]++;
+        histograms[1 * 256 + ((key >> 8) & 0xFF)]++;
+        histograms[2 * 256 + ((key >> 16) & 0xFF)]++;
+        histograms[3 * 256 + (key >> 24)]++;
+        order[i] = i;
+    }
+    
+    u32* src = order;
+    u32* dst = scratch;
+    for (u32 pass = 0; pass < 4; pass++) {
+        u32* histogram = &histograms[pass * 256];
+        u32 shift = pass * 8;
+        if (histogram[(importance_sort_key(splats, 0) >> shift) & 0xFF] == count) {
+            continue;
+        }
+        
+        u32 offset = 0;
+        for (u32 b = 0; b < 256; b++) {
+            u32 bucket_count = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_count;
+        }
+        for (u32 i = 0; i < count; i++) {
+            u32 digit = (importance_sort_key(splats, src[i]) >> shift) & 0xFF;
+            dst[histogram[digit]++] = src[i];
+        }
+        
+        u32* tmp = src; src = dst; dst = tmp;
+    }
+    
+    // src[new] = old; invert it into dst[old] = new, then move records along its cycles
+    for (u32 i = 0; i < count; i++) {
+        dst[src[i]] = i;
+    }
+    if (remap) {
+        memcpy(remap, dst, count * sizeof(u32));
+    }
+    splats_apply_positions(splats, streams, count, dst);
+    
+    memory_free(order);
+    memory_free(scratch);
     return GAUSSIAN_SUCCESS;
 }
 
-void gaussian_system_cleanup(void) {
-    printf("SPLATSTORM X: Cleaning up Gaussian system...\n");
+void gaussian_luts_cleanup(GaussianLUTs* luts) {
+    if (!luts) return;
     
-    // Free global system buffers - COMPLETE IMPLEMENTATION
-    if (g_system_splat_buffer) {
-        free(g_system_splat_buffer);
-        g_system_splat_buffer = NULL;
-        printf("SPLATSTORM X: Freed 3D splat buffer\n");
+    // Cooked tables all live in the one payload block
+    if (luts->cooked_payload) {
+        memory_free(luts->cooked_payload);
+        memset(luts, 0, sizeof(GaussianLUTs));
+        return;
     }
     
-    if (g_system_projection_buffer) {
-        free(g_system_projection_buffer);
-        g_system_projection_buffer = NULL;
-        printf("SPLATSTORM X: Freed 2D projection buffer\n");
-    }
+    if (luts->exp_lut) { memory_free(luts->exp_lut); luts->exp_lut = NULL; }
+    if (luts->sqrt_lut) { memory_free(luts->sqrt_lut); luts->sqrt_lut = NULL; }
+    if (luts->cov_inv_lut) { memory_free(luts->cov_inv_lut); luts->cov_inv_lut = NULL; }
+    if (luts->footprint_atlas) { memory_free(luts->footprint_atlas); luts->footprint_atlas = NULL; }
+    if (luts->footprint_clut) { memory_free(luts->footprint_clut); luts->footprint_clut = NULL; }
+    if (luts->sh_lighting_lut) { memory_free(luts->sh_lighting_lut); luts->sh_lighting_lut = NULL; }
+    if (luts->recip_lut) { memory_free(luts->recip_lut); luts->recip_lut = NULL; }
     
-    if (g_system_sort_keys) {
-        free(g_system_sort_keys);
-        g_system_sort_keys = NULL;
-        printf("SPLATSTORM X: Freed sort keys buffer\n");
-    }
+    luts->initialized = false;
+    luts->total_memory_usage = 0;
+}
+
+// Global system capacity. Splat-sized buffers belong to the scene and the
+// frame arena: nothing system-wide is reserved per splat.
+static u32 g_system_max_splats = 0;
+
+// Global system initialization - COMPLETE IMPLEMENTATION
+GaussianResult gaussian_system_init(u32 max_splats) {
+    printf("SPLATSTORM X: Initializing complete Gaussian system for %u splats...\n", max_splats);
     
-    if (g_system_sort_indices) {
-        free(g_system_sort_indices);
-        g_system_sort_indices = NULL;
-        printf("SPLATSTORM X: Freed sort indices buffer\n");
+    // Validate max_splats parameter
+    if (max_splats == 0 || max_splats > MAX_SPLATS_PER_SCENE) {
+        printf("SPLATSTORM X: Invalid max_splats parameter: %u (max: %u)\n", max_splats, MAX_SPLATS_PER_SCENE);
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
+    // Store system capacity
+    g_system_max_splats = max_splats;
+    
+    // The global LUTs are filled by gaussian_scene_init, cooked or generated
+    
+    printf("SPLATSTORM X: System initialization complete for %u splats\n", max_splats);
+    return GAUSSIAN_SUCCESS;
+}
+
+void gaussian_system_cleanup(void) {
+    printf("SPLATSTORM X: Cleaning up Gaussian system...\n");
+    
     g_system_max_splats = 0;
     printf("SPLATSTORM X: System cleanup complete\n");
 }
\ No newline at end of file
@@ -207,23 +207,34 @@ void splatstorm_get_screen_size(int* width, int* height) {
     if (height) *height = graphics_initialized ? gsGlobal->Height : 480;
 }
 
+// GS VRAM manager owns everything above gsKit's frame buffers
+static bool graphics_vram_ready(void) {
+    if (gs_vram_is_initialized()) {
+        return true;
+    }
+    if (gs_vram_init() != GAUSSIAN_SUCCESS) {
+        return false;
+    }
+    if (gsGlobal->CurrentPointer > 0) {
+        gs_vram_reserve(0, (gsGlobal->CurrentPointer + GS_VRAM_BLOCK_BYTES - 1) / GS_VRAM_BLOCK_BYTES);
+    }
+    return true;
+}
+
 // VRAM allocation (gsKit integration)
 void* splatstorm_alloc_vram(size_t size) {
-    if (!graphics_initialized || !gsGlobal) {
+    if (!graphics_initialized || !gsGlobal || !graphics_vram_ready()) {
         debug_log_error("Graphics Enhanced: Cannot allocate VRAM - graphics not initialized");
         return NULL;
     }
     
-    // Direct PS2SDK VRAM allocation - replace missing gsKit_vram_alloc
-    u32 aligned_size = (size + 255) & ~255;  // 256-byte alignment
-    u32 vram_addr = gsGlobal->CurrentPointer;
-    gsGlobal->CurrentPointer += aligned_size;
-    // PS2 has 4MB VRAM total (0x400000 bytes)
-    if (gsGlobal->CurrentPointer > 0x400000) {
+    // Block granular, whole pages from a page up
+    u32 tbp = gs_vram_alloc_blocks((size + GS_VRAM_BLOCK_BYTES - 1) / GS_VRAM_BLOCK_BYTES);
+    if (tbp == GS_VRAM_INVALID) {
         debug_log_error("Graphics Enhanced: VRAM allocation failed for %zu bytes - out of VRAM", size);
         return NULL;
     }
-    void* ptr = (void*)vram_addr;
+    void* ptr = (void*)(tbp * GS_VRAM_BLOCK_BYTES);
     
     debug_log_verbose("Graphics Enhanced: Allocated %zu bytes VRAM at %p", size, ptr);
     return ptr;
@@ -234,8 +245,7 @@ void splatstorm_free_vram(void* ptr) {
         return;
     }
     
-    // Note: gsKit doesn't have vram_free, memory is managed automatically
-    // This is a no-op for compatibility
+    gs_vram_free((u32)ptr / GS_VRAM_BLOCK_BYTES);
     debug_log_verbose("Graphics Enhanced: Freed VRAM at %p", ptr);
 }
 
@@ -264,18 +274,14 @@ GSTEXTURE* splatstorm_create_texture(int width, int height, int psm) {
         return NULL;
     }
     
-    // Allocate VRAM - Direct PS2SDK implementation
-    u32 tex_size = calculate_texture_size(width, height, psm);
-    u32 aligned_size = (tex_size + 255) & ~255;  // 256-byte alignment
-    texture->Vram = gsGlobal->CurrentPointer;
-    gsGlobal->CurrentPointer += aligned_size;
-    
-    // PS2 has 4MB VRAM total (0x400000 bytes)
-    if (gsGlobal->CurrentPointer > 0x400000) {
+    // Allocate VRAM in the texture's PSM footprint
+    u32 tbp = graphics_vram_ready() ? gs_vram_alloc(width, height, psm) : GS_VRAM_INVALID;
+    if (tbp == GS_VRAM_INVALID) {
         debug_log_warning("Graphics Enhanced: VRAM allocation failed, texture will be delayed");
         texture->Vram = 0;
         texture->Delayed = true;
-        gsGlobal->CurrentPointer -= aligned_size;  // Rollback allocation
+    } else {
+        texture->Vram = tbp * GS_VRAM_BLOCK_BYTES;
     }
     
     debug_log_info("Graphics Enhanced: Created %dx%d texture (PSM: %d)", width, height, psm);
@@ -288,8 +294,7 @@ void splatstorm_free_texture(GSTEXTURE* texture) {
     }
     
     if (texture->Vram && graphics_initialized && gsGlobal) {
-        // Note: gsKit doesn't have vram_free, memory is managed automatically
-        // This is a no-op for compatibility
+        gs_vram_free(texture->Vram / GS_VRAM_BLOCK_BYTES);
     }
     
     if (texture->Mem) {
@@ -306,18 +311,14 @@ int splatstorm_upload_texture(GSTEXTURE* texture) {
     }
     
     if (!texture->Vram) {
-        // Try to allocate VRAM now - Direct PS2SDK implementation
-        u32 tex_size = calculate_texture_size(texture->Width, texture->Height, texture->PSM);
-        u32 aligned_size = (tex_size + 255) & ~255;  // 256-byte alignment
-        texture->Vram = gsGlobal->CurrentPointer;
-        gsGlobal->CurrentPointer += aligned_size;
-        
-        // PS2 has 4MB VRAM total (0x400000 bytes)
-        if (gsGlobal->CurrentPointer > 0x400000) {
+        // Try to allocate VRAM now
+        u32 tbp = graphics_vram_ready() ? gs_vram_alloc(texture->Width, texture->Height, texture->PSM) : GS_VRAM_INVALID;
+        if (tbp == GS_VRAM_INVALID) {
             debug_log_error("Graphics Enhanced: Cannot upload texture - no VRAM");
-            gsGlobal->CurrentPointer -= aligned_size;  // Rollback allocation
             return 0;
         }
+        texture->Vram = tbp * GS_VRAM_BLOCK_BYTES;
+        texture->Delayed = false;
     }
     
     // Direct PS2SDK texture upload - replace missing gsKit_texture_upload
@@ -331,7 +332,7 @@ int splatstorm_upload_texture(GSTEXTURE* texture) {
         packet2_t* upload_packet = packet2_create(4, P2_TYPE_NORMAL, P2_MODE_CHAIN, 1);
         
         // Set up GS registers for texture transfer
-        packet2_add_u64(upload_packet, GS_SETREG_BITBLTBUF(0, 0, 0, texture->Vram / 64, texture->TBW, texture->PSM));
+        packet2_add_u64(upload_packet, GS_SETREG_BITBLTBUF(0, 0, 0, texture->Vram / GS_VRAM_BLOCK_BYTES, texture->TBW, texture->PSM));
         packet2_add_u64(upload_packet, GS_SETREG_TRXPOS(0, 0, 0, 0, 0));
         packet2_add_u64(upload_packet, GS_SETREG_TRXREG(texture->Width, texture->Height));
         packet2_add_u64(upload_packet, GS_SETREG_TRXDIR(0)); // Host to local transfer
@@ -413,8 +414,11 @@ void splatstorm_get_graphics_stats(graphics_stats_t* stats) {
         stats->fps = fps;
         stats->vsync_enabled = vsync_enabled;
         
-        // Memory usage (approximate - gsKit doesn't provide exact usage)
-        stats->vram_used = gsGlobal->CurrentPointer; // Current VRAM allocation pointer
+        // Memory usage: VRAM manager blocks once it owns GS memory
+        GSVramStats vram;
+        gs_vram_get_stats(&vram);
+        stats->vram_used = gs_vram_is_initialized() ? vram.used_blocks * GS_VRAM_BLOCK_BYTES
+                                                    : gsGlobal->CurrentPointer;
         stats->vram_total = 4 * 1024 * 1024; // 4MB VRAM
     }
 }
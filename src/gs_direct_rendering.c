@@ -125,6 +125,8 @@ void gs_setup_rendering_context(void);
 #define GS_PSM_CT24         1
 #define GS_PSM_CT16         2
 #define GS_PSM_CT16S        10
+#define GS_PSM_T8           19
+#define GS_PSM_T4           20
 #define GS_PSMZ_32          0
 #define GS_PSMZ_24          1
 #define GS_PSMZ_16          2
@@ -213,17 +215,22 @@ void gs_direct_setup_lut_texturing(void) {
 
 // Set up footprint atlas texturing
 void gs_direct_setup_atlas_texturing(void) {
-    // Set up footprint atlas texture (256x256)
-    *GS_TEX0_1 = GS_SET_TEX0(0x400,    // TBP0: atlas base page
+    // Atlas and its alpha ramp CLUT are placed by the GS VRAM manager
+    u32 atlas_tbp = gs_vram_texture_bind(GS_TEXTURE_FOOTPRINT_ATLAS);
+    u32 clut_cbp = gs_vram_texture_bind(GS_TEXTURE_FOOTPRINT_CLUT);
+    if (atlas_tbp == GS_VRAM_INVALID || clut_cbp == GS_VRAM_INVALID) return;
+    
+    // Set up footprint atlas texture (256x384 with mip levels, palettized alpha)
+    *GS_TEX0_1 = GS_SET_TEX0(atlas_tbp, // TBP0: atlas base block
                              4,        // TBW: texture buffer width (256/64 = 4)
-                             GS_PSM_CT32, // PSM: 32-bit color
+                             (FOOTPRINT_ATLAS_BITS == 4) ? GS_PSM_T4 : GS_PSM_T8, // PSM: alpha indices
                              8,        // TW: texture width (log2(256) = 8)
-                             8,        // TH: texture height (log2(256) = 8)
+                             ATLAS_HEIGHT_LOG2, // TH: texture height (log2(512) = 9)
                              1,        // TCC: RGBA
                              0,        // TFX: modulate
-                             0,        // CBP: CLUT base
-                             0,        // CPSM: CLUT format
-                             0,        // CSM: CLUT storage mode
+                             clut_cbp, // CBP: CLUT base
+                             GS_PSM_CT32, // CPSM: CLUT format
+                             0,        // CSM: CSM1
                              0,        // CSA: CLUT entry offset
                              1);       // CLD: CLUT load control
     
@@ -287,7 +294,7 @@ void gs_direct_render_splat_quad(const GaussianSplat2D* splat,
 
 // Render a batch of Gaussian splats using direct GS access
 void gs_direct_render_splat_batch(const GaussianSplat2D* splats, 
-                                 const u16* indices, int count) {
+                                 const u32* indices, int count) {
     if (count == 0) return;
     
     // Set up for splat rendering
@@ -298,11 +305,15 @@ void gs_direct_render_splat_batch(const GaussianSplat2D* splats,
         u16 splat_idx = indices[i];
         const GaussianSplat2D* splat = &splats[splat_idx];
         
-        // Get atlas UV coordinates (simplified - would use eigenvalues/rotation)
-        float u_base = 0.0f;   // Would be computed from splat properties
-        float v_base = 0.0f;
-        float u_scale = 0.125f; // 1/8 for 8x8 atlas
-        float v_scale = 0.125f;
+        // Atlas cell from the splat's atlas coordinates at its mip level
+        u32 cell = (splat->atlas_v / FOOTPRINT_RES) * 8 + splat->atlas_u / FOOTPRINT_RES;
+        u32 cell_u, cell_v;
+        footprint_atlas_cell(cell, splat->atlas_level, &cell_u, &cell_v);
+        
+        float u_base = (float)cell_u / ATLAS_SIZE;
+        float v_base = (float)cell_v / (1 << ATLAS_HEIGHT_LOG2);
+        float u_scale = (float)(FOOTPRINT_RES >> splat->atlas_level) / ATLAS_SIZE;
+        float v_scale = (float)(FOOTPRINT_RES >> splat->atlas_level) / (1 << ATLAS_HEIGHT_LOG2);
         
         // Render the quad
         gs_direct_render_splat_quad(splat, u_base, v_base, u_scale, v_scale);
@@ -312,7 +323,7 @@ void gs_direct_render_splat_batch(const GaussianSplat2D* splats,
 // Render all tiles with their splats
 void gs_direct_render_tiles(const GaussianSplat2D* splats, 
                            const TileRange* tile_ranges,
-                           const u16* sort_indices) {
+                           const u32* sort_indices) {
     // Clear screen
     gs_direct_clear_screen(0, 0, 0);
     
@@ -322,7 +333,7 @@ void gs_direct_render_tiles(const GaussianSplat2D* splats,
         if (range->count == 0) continue;
         
         // Get sorted indices for this tile
-        const u16* tile_indices = &sort_indices[range->start_index];
+        const u32* tile_indices = &sort_indices[range->start_index];
         
         // Render all splats in this tile
         gs_direct_render_splat_batch(splats, tile_indices, range->count);
@@ -331,7 +342,7 @@ void gs_direct_render_tiles(const GaussianSplat2D* splats,
 
 // Optimized rendering for simple Gaussian falloff (no atlas)
 void gs_direct_render_simple_splats(const GaussianSplat2D* splats, 
-                                   const u16* indices, int count) {
+                                   const u32* indices, int count) {
     if (count == 0) return;
     
     // Disable texturing for simple rendering
@@ -393,7 +404,7 @@ void gs_direct_get_stats(u32* triangles_rendered, u32* pixels_filled,
 
 // Debug function to render wireframe mode
 void gs_direct_render_wireframe(const GaussianSplat2D* splats, 
-                               const u16* indices, int count) {
+                               const u32* indices, int count) {
     // Set primitive to line strip
     *GS_PRIM = GS_SET_PRIM(GS_PRIM_LINESTRIP, 0, 0, 0, 0, 0, 1, 0, 0);
     
@@ -8,9 +8,28 @@
  * - Direct GS register writes bypassing gsKit overhead
  * - Optimal alpha blending for Gaussian splatting
  * - Texture sampling with LUT integration
+ * - Palettized (PSMT8/PSMT4) footprint atlas through an alpha ramp CLUT
+ * - Footprint mip level per splat from its screen radius
  * - Multi-context rendering for double buffering
  * - Tile-based rendering with scissor optimization
+ * - Tile lists submitted from 16-byte quantized render splats (GS units)
+ * - Tile splats gathered into the scratchpad while packets are built
+ * - Frame-level GIF command buffer sent as large chain DMA chunks
+ * - Sprites packed as REGLIST runs under one GIF tag, PRIM set once per batch
+ * - One packet building kernel per render configuration (atlas, Z-buffer),
+ *   picked once per splat list instead of branched on per splat
+ * - Frame/Z buffers and LUT textures placed by the GS VRAM manager
+ * - Dynamic render resolution, scaled to the display by PCRTC magnification
+ * - Field rendering: half-height buffers scanned in FFMD field mode
+ * - Z-buffer-free mode for depth-sorted splats: no Z test, writes or VRAM
+ * - Triple-buffered presentation: a VBLANK handler flips to the newest
+ *   finished frame while the next one renders
+ * - VBLANK waits for pacing frames that present the previous image again
+ * - Frame pipelining: a swapped frame drains on the GS while the EE works
+ *   on the next one, completed by gs_sync_frame()
  * - Performance monitoring and debug visualization
+ * - Tile heatmap overlay: additive translucent sprites per tile
+ * - Submitted GIF chunks copied into an armed frame capture
  */
 
 #include "splatstorm_x.h"
@@ -18,9 +37,11 @@
 #include <gs_gp.h>
 #include <gs_psm.h>
 #include <dma.h>
+#include <kernel.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <malloc.h>
 
 // GS register addresses
 #define GS_PMODE        0x12000000
@@ -85,6 +106,8 @@
 #define GS_TEXA         0x3B
 #define GS_FOGCOL       0x3D
 #define GS_TEXFLUSH     0x3F
+#define GS_XYOFFSET_1   0x18
+#define GS_XYOFFSET_2   0x19
 #define GS_SCISSOR_1    0x40
 #define GS_SCISSOR_2    0x41
 #define GS_ALPHA_1      0x42
@@ -101,6 +124,12 @@
 #define GS_FRAME_2      0x4D
 #define GS_ZBUF_1       0x4E
 #define GS_ZBUF_2       0x4F
+#define GS_FINISH       0x61
+
+// CSR bits
+#define GS_CSR_FINISH           (1ULL << 1)   // FINISH event: set once drawing reaches FINISH
+#define GS_IMR_FINISHMSK        (1ULL << 9)   // IMR: FINISH event interrupt masked
+#define GS_CSR_VSINT            (1ULL << 3)   // VSync event: set at every VBLANK start
 
 // Primitive types
 #define GS_PRIM_POINT           0x00
@@ -126,6 +155,17 @@
 #define GS_PSM_Z16      0x32
 #define GS_PSM_Z16S     0x3A
 
+// Footprint atlas storage (see FOOTPRINT_ATLAS_BITS)
+#if FOOTPRINT_ATLAS_BITS == 4
+#define GS_ATLAS_PSM            GS_PSM_T4
+#define GS_ATLAS_CLUT_WIDTH     8             // 16 entries
+#define GS_ATLAS_CLUT_HEIGHT    2
+#else
+#define GS_ATLAS_PSM            GS_PSM_T8
+#define GS_ATLAS_CLUT_WIDTH     16            // 256 entries
+#define GS_ATLAS_CLUT_HEIGHT    16
+#endif
+
 // Alpha blending modes
 #define GS_BLEND_CS     0x00  // Source color
 #define GS_BLEND_CD     0x01  // Destination color
@@ -134,6 +174,43 @@
 #define GS_BLEND_AD     0x01  // Destination alpha
 #define GS_BLEND_FIX    0x02  // Fixed alpha
 
+// Tile heatmap overlay: added at half strength, in front of every splat
+#define GS_HEATMAP_ALPHA        0x40
+#define GS_HEATMAP_Z            0xFFFFFFFF
+
+// Display area: NTSC interlaced frame, 2560 VCK per line. The render width
+// sets MAGH (2560 / width VCK per pixel), the render height MAGV. In field
+// mode every field scans the whole buffer, so a buffer line covers two
+// frame lines.
+#define GS_DISPLAY_DX           656
+#define GS_DISPLAY_DY           26
+#define GS_DISPLAY_VCK_WIDTH    2560
+#define GS_DISPLAY_HEIGHT       448
+#define GS_SMODE2_INT           0x1           // Interlaced scan
+#define GS_SMODE2_FFMD          0x2           // Field mode: each field reads every buffer line
+#define GS_CSR_FIELD_SHIFT      13            // CSR FIELD: 1 while the odd field is scanned
+#define GS_FIELD_HALF_LINE      8             // Half a buffer line in 12.4 window units
+
+// Presentation: two buffers flip at swap time, three flip at VBLANK
+#define GS_MAX_FRAMEBUFFERS     3
+#define GS_NO_BUFFER            0xFFFFFFFF
+
+// Frame command buffer: two chunks so one fills while the other transfers
+#define GS_CMD_CHUNK_QWORDS     8192          // 128KB per chunk
+#define GS_CMD_ALIGNMENT        128           // DMA burst alignment
+#define GS_CMD_MAX_NLOOP        0x7FFF        // GIF tag NLOOP limit
+#define GS_CMD_NO_TAG           0xFFFFFFFF    // No GIF tag currently open
+
+// Sprite REGLIST: RGBAQ, UV, XYZ2, UV, XYZ2 as 64-bit words, 40 bytes a
+// sprite against 96 as A+D pairs. Flat sprites, drawn while the atlas is
+// not bound, drop the UVs.
+#define GS_SPRITE_NREG          5
+#define GS_SPRITE_REGS          ((u64)GS_RGBAQ | ((u64)GS_UV << 4) | ((u64)GS_XYZ2 << 8) | \
+                                 ((u64)GS_UV << 12) | ((u64)GS_XYZ2 << 16))
+#define GS_FLAT_SPRITE_NREG     3
+#define GS_FLAT_SPRITE_REGS     ((u64)GS_RGBAQ | ((u64)GS_XYZ2 << 4) | ((u64)GS_XYZ2 << 8))
+#define GS_SPRITE_MAX_QWORDS    3             // One sprite at an odd dword start
+
 // GS rendering state
 typedef struct {
     bool initialized;                         // System initialization flag
@@ -141,16 +218,42 @@ typedef struct {
     u32 display_context;                      // Currently displayed context
     
     // Frame buffers
-    u32 framebuffer_base[2];                  // Frame buffer base addresses
-    u32 zbuffer_base[2];                      // Z-buffer base addresses
-    u32 framebuffer_width;                    // Frame buffer width
-    u32 framebuffer_height;                   // Frame buffer height
+    u32 framebuffer_base[GS_MAX_FRAMEBUFFERS]; // Frame buffer base pages (FBP)
+    u32 framebuffer_count;                    // 2 double buffered, 3 triple buffered
+    bool triple_buffering;                    // Three buffers requested before init
+    u32 context_buffer[2];                    // Frame buffer each drawing context renders into
+    u32 buffer_width[GS_MAX_FRAMEBUFFERS];    // Render size each buffer was last drawn at
+    u32 buffer_height[GS_MAX_FRAMEBUFFERS];
+    volatile u32 display_buffer;              // Buffer the PCRTC scans out
+    volatile u32 pending_buffer;              // Finished buffer waiting for VBLANK, or GS_NO_BUFFER
+    u32 buffer_field[GS_MAX_FRAMEBUFFERS];    // Field mode: field each buffer was drawn for (1 = odd)
+    u32 context_field[2];                     // Field each drawing context's XYOFFSET targets
+    s32 vblank_handler_id;                    // INTC handler id, -1 when not installed
+    s32 vblank_sema;                          // Signalled at every VBLANK start, -1 without the handler
+    s32 finish_handler_id;                    // GS FINISH handler id, -1 when not installed
+    s32 finish_sema;                          // Signalled by the FINISH event, -1 without the handler
+    volatile u32 frames_presented;            // Flips made by the VBLANK handler
+    u32 frames_replaced;                      // Finished frames superseded before any VBLANK
+    u32 frame_latency;                        // Frames a swap leaves in flight (0 or 1)
+    bool frame_in_flight;                     // A swapped frame is still being drawn
+    u32 inflight_buffer;                      // Buffer that frame draws into
+    u64 sync_wait_cycles;                     // EE cycles the last gs_sync_frame() waited
+    u32 zbuffer_base[2];                      // Z-buffer base pages (ZBP, shared)
+    bool zbuffer_disabled;                    // No Z-buffer: sorted order alone decides visibility
+    u32 framebuffer_width;                    // Render width this frame
+    u32 framebuffer_height;                   // Render height this frame
+    u32 framebuffer_max_width;                // Allocated frame buffer width
+    u32 framebuffer_max_height;               // Allocated frame buffer height
     u32 framebuffer_psm;                      // Pixel storage mode
+    bool field_rendering;                     // Half-height buffers, one per field
+    u32 field_parity;                         // Field the frame in progress is shown on (1 = odd)
     
     // Texture system
-    u32 lut_texture_base;                     // LUT texture base address
-    u32 atlas_texture_base;                   // Atlas texture base address
+    u32 clut_texture_base;                    // Atlas CLUT base block (CBP)
+    u32 atlas_texture_base;                   // Atlas texture base block (TBP)
+    bool clut_dirty;                          // CLUT re-uploaded since the last TEX0
     bool textures_uploaded;                   // Texture upload status
+    bool atlas_bound;                         // TEX0 for the atlas went out with the last setup
     
     // Rendering state
     bool alpha_blending_enabled;              // Alpha blending state
@@ -173,6 +276,17 @@ typedef struct {
     u32 debug_overlay_color;                  // Debug overlay color
     bool show_tile_boundaries;                // Show tile boundaries
     bool show_splat_centers;                  // Show splat centers
+    
+    // Frame GIF command buffer
+    u64* cmd_arena;                           // Backing store for both chunks
+    u64* cmd_chunk[2];                        // Chunk base pointers (2 u64 per qword)
+    u32 cmd_chunk_index;                      // Chunk currently being filled
+    u32 cmd_used;                             // Qwords used in current chunk
+    u32 cmd_tag_pos;                          // Qword index of open GIF tag
+    u32 cmd_tag_nloop;                        // Registers (A+D) or sprites (REGLIST) under open tag
+    u32 cmd_tag_sprites;                      // Registers per sprite of an open REGLIST, 0 for A+D
+    bool cmd_tag_odd;                         // REGLIST filled half of the qword at cmd_used
+    u32 cmd_chunks_sent;                      // Chunks submitted (statistics)
 } GSRenderState;
 
 static GSRenderState g_gs_state = {0};
@@ -190,6 +304,128 @@ static inline void gs_write_reg(u32 reg, u64 value) {
     );
 }
 
+// Close the open A+D GIF tag, if any
+static inline void gs_cmd_close_tag(void) {
+    if (g_gs_state.cmd_tag_pos == GS_CMD_NO_TAG) return;
+    
+    u64* tag = &g_gs_state.cmd_chunk[g_gs_state.cmd_chunk_index][g_gs_state.cmd_tag_pos * 2];
+    if (g_gs_state.cmd_tag_sprites) {
+        // An odd word count ends mid-qword; the GIF discards the padding
+        if (g_gs_state.cmd_tag_odd) {
+            g_gs_state.cmd_chunk[g_gs_state.cmd_chunk_index][g_gs_state.cmd_used * 2 + 1] = 0;
+            g_gs_state.cmd_used++;
+        }
+        tag[0] = (u64)g_gs_state.cmd_tag_nloop | (1ULL << 15) | (1ULL << 58) |
+                 ((u64)g_gs_state.cmd_tag_sprites << 60);  // NLOOP, EOP, REGLIST
+        tag[1] = (g_gs_state.cmd_tag_sprites == GS_SPRITE_NREG) ? GS_SPRITE_REGS : GS_FLAT_SPRITE_REGS;
+    } else {
+        tag[0] = (u64)g_gs_state.cmd_tag_nloop | (1ULL << 15) | (1ULL << 60);  // NLOOP, EOP, NREG=1, PACKED
+        tag[1] = GS_AD;
+    }
+    
+    g_gs_state.cmd_tag_pos = GS_CMD_NO_TAG;
+    g_gs_state.cmd_tag_nloop = 0;
+    g_gs_state.cmd_tag_sprites = 0;
+    g_gs_state.cmd_tag_odd = false;
+}
+
+// Submit the current chunk as one chain transfer and switch chunks
+static void gs_cmd_submit_chunk(void) {
+    gs_cmd_close_tag();
+    if (g_gs_state.cmd_used == 0) return;
+    
+    const void* blocks[1] = { g_gs_state.cmd_chunk[g_gs_state.cmd_chunk_index] };
+    u32 sizes[1] = { g_gs_state.cmd_used * 16 };
+    frame_capture_write(FRAME_CAPTURE_SECTION_GIF, blocks[0], 16, g_gs_state.cmd_used);
+    
+    // Waits for the previous chunk's chain before reusing the tag list
+    dma_setup_chain_transfer(blocks, sizes, 1, DMA_CHANNEL_GIF);
+    dma_execute_chain_transfer(DMA_CHANNEL_GIF);
+    
+    g_gs_state.cmd_chunks_sent++;
+    g_gs_state.cmd_chunk_index = 1 - g_gs_state.cmd_chunk_index;
+    g_gs_state.cmd_used = 0;
+}
+
+// Append one A+D register write to the frame command buffer
+static inline void gs_cmd_ad(u32 reg, u64 value) {
+    // Tag + data must fit; otherwise ship this chunk and continue in the other
+    if (g_gs_state.cmd_used + 2 > GS_CMD_CHUNK_QWORDS) {
+        gs_cmd_submit_chunk();
+    }
+    
+    if (g_gs_state.cmd_tag_sprites) {
+        gs_cmd_close_tag();
+    }
+    
+    u64* chunk = g_gs_state.cmd_chunk[g_gs_state.cmd_chunk_index];
+    if (g_gs_state.cmd_tag_pos == GS_CMD_NO_TAG) {
+        g_gs_state.cmd_tag_pos = g_gs_state.cmd_used++;
+    }
+    
+    chunk[g_gs_state.cmd_used * 2] = value;
+    chunk[g_gs_state.cmd_used * 2 + 1] = reg;
+    g_gs_state.cmd_used++;
+    
+    if (++g_gs_state.cmd_tag_nloop == GS_CMD_MAX_NLOOP) {
+        gs_cmd_close_tag();
+    }
+}
+
+// Room for one sprite of nreg words in the open REGLIST run of that
+// format, opening one if needed; returns where its words go. PRIM must
+// already hold the sprite primitive: PRE only applies to PACKED tags.
+static inline u64* gs_cmd_sprite_begin(u32 nreg) {
+    if (g_gs_state.cmd_used + 1 + GS_SPRITE_MAX_QWORDS > GS_CMD_CHUNK_QWORDS) {
+        gs_cmd_submit_chunk();
+    }
+    
+    if (g_gs_state.cmd_tag_sprites != nreg) {
+        gs_cmd_close_tag();
+        g_gs_state.cmd_tag_pos = g_gs_state.cmd_used++;
+        g_gs_state.cmd_tag_sprites = nreg;
+    }
+    
+    // Words continue straight after the previous sprite, half qwords included
+    return &g_gs_state.cmd_chunk[g_gs_state.cmd_chunk_index][g_gs_state.cmd_used * 2 + g_gs_state.cmd_tag_odd];
+}
+
+static inline void gs_cmd_sprite_end(u32 nreg) {
+    u32 words = g_gs_state.cmd_tag_odd + nreg;
+    g_gs_state.cmd_used += words / 2;
+    g_gs_state.cmd_tag_odd = (words & 1) != 0;
+    
+    if (++g_gs_state.cmd_tag_nloop == GS_CMD_MAX_NLOOP) {
+        gs_cmd_close_tag();
+    }
+}
+
+// Append one textured sprite to the frame command buffer
+static inline void gs_cmd_sprite(u64 rgbaq, u64 uv1, u64 xyz1, u64 uv2, u64 xyz2) {
+    u64* word = gs_cmd_sprite_begin(GS_SPRITE_NREG);
+    word[0] = rgbaq;
+    word[1] = uv1;
+    word[2] = xyz1;
+    word[3] = uv2;
+    word[4] = xyz2;
+    gs_cmd_sprite_end(GS_SPRITE_NREG);
+}
+
+// Append one untextured sprite
+static inline void gs_cmd_flat_sprite(u64 rgbaq, u64 xyz1, u64 xyz2) {
+    u64* word = gs_cmd_sprite_begin(GS_FLAT_SPRITE_NREG);
+    word[0] = rgbaq;
+    word[1] = xyz1;
+    word[2] = xyz2;
+    gs_cmd_sprite_end(GS_FLAT_SPRITE_NREG);
+}
+
+// Send everything recorded so far (non-blocking)
+void gs_flush_command_buffer(void) {
+    if (!g_gs_state.initialized) return;
+    gs_cmd_submit_chunk();
+}
+
 // GS packet construction helpers
 static inline u64 gs_set_prim(u32 prim, u32 iip, u32 tme, u32 fge, u32 abe, u32 aa1, u32 fst, u32 ctxt, u32 fix) {
     return ((u64)prim) | ((u64)iip << 3) | ((u64)tme << 4) | ((u64)fge << 5) |
@@ -226,6 +462,30 @@ static inline u64 gs_set_zbuf(u32 zbp, u32 psm, u32 zmsk) {
     return ((u64)zbp) | ((u64)psm << 24) | ((u64)zmsk << 32);
 }
 
+static inline u64 gs_set_display(u32 dx, u32 dy, u32 magh, u32 magv, u32 dw, u32 dh) {
+    return ((u64)dx) | ((u64)dy << 12) | ((u64)magh << 23) | ((u64)magv << 27) |
+           ((u64)dw << 32) | ((u64)dh << 44);
+}
+
+// Frame lines one buffer line covers before magnification
+static inline u32 gs_display_line_scale(void) {
+    return g_gs_state.field_rendering ? 2 : 1;
+}
+
+// Point the PCRTC at one of the frame buffers
+static void gs_write_dispfb(u32 buffer, u32 width) {
+    gs_write_reg(GS_DISPFB1, ((u64)g_gs_state.framebuffer_base[buffer]) |
+                            ((u64)(width / 64) << 9) | ((u64)g_gs_state.framebuffer_psm << 15));
+}
+
+// PCRTC scan-out of a width x height buffer over the whole display area
+static void gs_write_display(u32 width, u32 height) {
+    u32 magh = GS_DISPLAY_VCK_WIDTH / width - 1;
+    u32 magv = GS_DISPLAY_HEIGHT / (height * gs_display_line_scale()) - 1;
+    gs_write_reg(GS_DISPLAY1, gs_set_display(GS_DISPLAY_DX, GS_DISPLAY_DY, magh, magv,
+                                             GS_DISPLAY_VCK_WIDTH - 1, GS_DISPLAY_HEIGHT - 1));
+}
+
 static inline u64 gs_set_scissor(u32 scax0, u32 scax1, u32 scay0, u32 scay1) {
     return ((u64)scax0) | ((u64)scax1 << 16) | ((u64)scay0 << 32) | ((u64)scay1 << 48);
 }
@@ -235,7 +495,124 @@ static inline u64 gs_set_test(u32 ate, u32 atst, u32 aref, u32 afail, u32 date,
            ((u64)date << 14) | ((u64)datm << 15) | ((u64)zte << 16) | ((u64)ztst << 17);
 }
 
-// Initialize GS rendering system
+// Splat TEST: ATE=1, ATST=GEQUAL, AREF=1 drops fully transparent pixels;
+// ZTE=1, ZTST=GEQUAL. ZTE=0 is prohibited, so without a Z-buffer the test
+// is ZTST=ALWAYS.
+static inline u64 gs_splat_test(void) {
+    return gs_set_test(1, 4, 0x01, 0, 0, 0, 1, g_gs_state.zbuffer_disabled ? 1 : 2);
+}
+
+// Clear TEST: clear sprites carry alpha 0, which the splat alpha test
+// rejects, so they draw with every test passing and the splat TEST after
+static inline u64 gs_clear_test(void) {
+    return gs_set_test(0, 0, 0, 0, 0, 0, 1, 1);
+}
+
+// TEST register of the drawing context
+static inline u32 gs_test_reg(void) {
+    return (g_gs_state.current_context == 0) ? GS_TEST_1 : GS_TEST_2;
+}
+
+// Draw one half-height buffer per field instead of full frames. Decides
+// the buffer sizes, so it only takes effect before gs_renderer_init().
+void gs_renderer_set_field_rendering(bool enabled) {
+    if (g_gs_state.initialized) {
+        printf("SPLATSTORM X: Field rendering must be chosen before GS init\n");
+        return;
+    }
+    g_gs_state.field_rendering = enabled;
+}
+
+bool gs_renderer_get_field_rendering(void) {
+    return g_gs_state.field_rendering;
+}
+
+// Drop the Z-buffer for renderers that submit splats depth-sorted. Saves its
+// VRAM, the Z read and write on every pixel and the depth half of the clear.
+// Decides the VRAM layout, so it only takes effect before gs_renderer_init().
+void gs_renderer_set_depth_buffer(bool enabled) {
+    if (g_gs_state.initialized) {
+        printf("SPLATSTORM X: Depth buffer must be chosen before GS init\n");
+        return;
+    }
+    g_gs_state.zbuffer_disabled = !enabled;
+}
+
+bool gs_renderer_get_depth_buffer(void) {
+    return !g_gs_state.zbuffer_disabled;
+}
+
+// Present through three frame buffers: swaps never wait for a flip, and
+// VBLANK shows the newest finished frame. Picked before gs_renderer_init();
+// falls back to double buffering when VRAM has no room for the third.
+void gs_renderer_set_triple_buffering(bool enabled) {
+    if (g_gs_state.initialized) {
+        printf("SPLATSTORM X: Triple buffering must be chosen before GS init\n");
+        return;
+    }
+    g_gs_state.triple_buffering = enabled;
+}
+
+bool gs_renderer_get_triple_buffering(void) {
+    return g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS;
+}
+
+// Frames gs_swap_contexts() may leave drawing: 0 waits for the GS at
+// every swap, the lowest latency. 1 returns once the frame is queued, so
+// the next frame's cull, projection and binning run while the GS draws,
+// and the frame is shown one frame later. Any time; a frame in flight
+// completes first.
+void gs_renderer_set_frame_latency(u32 frames) {
+    gs_sync_frame();
+    g_gs_state.frame_latency = MIN(frames, 1);
+}
+
+u32 gs_renderer_get_frame_latency(void) {
+    return g_gs_state.frame_latency;
+}
+
+// VBLANK start: flip to the frame finished last, if one is waiting. In
+// field mode it waits for the field it was drawn for: CSR FIELD already
+// names the field this VBLANK leads into.
+static int gs_vblank_handler(int cause) {
+    (void)cause;
+    if (g_gs_state.vblank_sema >= 0) {
+        iSignalSema(g_gs_state.vblank_sema);
+    }
+    u32 pending = g_gs_state.pending_buffer;
+    if (pending != GS_NO_BUFFER && g_gs_state.field_rendering &&
+        ((u32)(*(volatile u64*)GS_CSR >> GS_CSR_FIELD_SHIFT) & 1) != g_gs_state.buffer_field[pending]) {
+        pending = GS_NO_BUFFER;
+    }
+    if (pending != GS_NO_BUFFER) {
+        gs_write_dispfb(pending, g_gs_state.buffer_width[pending]);
+        gs_write_display(g_gs_state.buffer_width[pending], g_gs_state.buffer_height[pending]);
+        g_gs_state.display_buffer = pending;
+        g_gs_state.pending_buffer = GS_NO_BUFFER;
+        g_gs_state.frames_presented++;
+    }
+    ExitHandler();
+    return 0;
+}
+
+// GS FINISH event: the frame queued for VBLANK is completely drawn
+static int gs_finish_handler(int cause) {
+    (void)cause;
+    if (*(volatile u64*)GS_CSR & GS_CSR_FINISH) {
+        *(volatile u64*)GS_CSR = GS_CSR_FINISH;  // Acknowledge, or the GS line stays raised
+        iSignalSema(g_gs_state.finish_sema);
+    }
+    ExitHandler();
+    return 0;
+}
+
+// Sprite Z: constant when nothing reads it
+static inline u32 gs_sprite_z(u32 depth) {
+    return g_gs_state.zbuffer_disabled ? 0 : depth;
+}
+
+// Initialize GS rendering system. height is the display frame height; in
+// field mode the buffers hold half of it.
 GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm) {
     printf("SPLATSTORM X: Initializing complete GS rendering system...\n");
     
@@ -244,35 +621,98 @@ GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm) {
         return GAUSSIAN_SUCCESS;
     }
     
+    if (g_gs_state.field_rendering) {
+        height /= 2;
+    }
+    g_gs_state.field_parity = 0;
+    
     // Store frame buffer parameters
     g_gs_state.framebuffer_width = width;
     g_gs_state.framebuffer_height = height;
+    g_gs_state.framebuffer_max_width = width;
+    g_gs_state.framebuffer_max_height = height;
     g_gs_state.framebuffer_psm = psm;
     
-    // Calculate frame buffer sizes and addresses
-    u32 fb_size_words = (width * height * 4) / 4;  // 32-bit pixels
-    u32 zb_size_words = (width * height * 4) / 4;  // 32-bit depth
-    
-    // Allocate VRAM addresses (simplified allocation)
-    g_gs_state.framebuffer_base[0] = 0x0000;       // Context 0 frame buffer
-    g_gs_state.framebuffer_base[1] = fb_size_words; // Context 1 frame buffer
-    g_gs_state.zbuffer_base[0] = fb_size_words * 2; // Context 0 Z-buffer
-    g_gs_state.zbuffer_base[1] = fb_size_words * 3; // Context 1 Z-buffer
-    
-    // Texture addresses
-    g_gs_state.lut_texture_base = fb_size_words * 4;
-    g_gs_state.atlas_texture_base = g_gs_state.lut_texture_base + 1024; // 256x1 LUT + padding
+    // Frame buffers and Z-buffer in whole GS pages. Both contexts share one
+    // Z-buffer since only one is drawn at a time; the rest is texture space.
+    // Without a Z-buffer ZBUF points at page 0 and is never accessed.
+    if (gs_vram_init() != GAUSSIAN_SUCCESS) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    u32 fb0 = gs_vram_alloc(width, height, psm);
+    u32 fb1 = gs_vram_alloc(width, height, psm);
+    u32 zb = g_gs_state.zbuffer_disabled ? 0 : gs_vram_alloc(width, height, GS_PSM_Z32);
+    if (fb0 == GS_VRAM_INVALID || fb1 == GS_VRAM_INVALID || zb == GS_VRAM_INVALID) {
+        printf("SPLATSTORM X: Not enough VRAM for %ux%u frame buffers\n", width, height);
+        gs_vram_cleanup();
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    g_gs_state.framebuffer_base[0] = fb0 / GS_VRAM_PAGE_BLOCKS;
+    g_gs_state.framebuffer_base[1] = fb1 / GS_VRAM_PAGE_BLOCKS;
+    g_gs_state.framebuffer_count = 2;
+    
+    // Third buffer last, so it only ever takes what would be texture space.
+    // A full 640x448 frame with Z leaves too little; field or Z-free modes fit.
+    if (g_gs_state.triple_buffering) {
+        u32 fb2 = gs_vram_alloc(width, height, psm);
+        if (fb2 != GS_VRAM_INVALID) {
+            g_gs_state.framebuffer_base[2] = fb2 / GS_VRAM_PAGE_BLOCKS;
+            g_gs_state.framebuffer_count = 3;
+        } else {
+            printf("SPLATSTORM X: No VRAM for a third %ux%u frame buffer, double buffering\n", width, height);
+        }
+    }
+    for (u32 b = 0; b < g_gs_state.framebuffer_count; b++) {
+        g_gs_state.buffer_width[b] = width;
+        g_gs_state.buffer_height[b] = height;
+    }
+    g_gs_state.context_buffer[0] = 0;
+    g_gs_state.context_buffer[1] = 1;
+    g_gs_state.display_buffer = (g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS) ? 2 : 0;
+    g_gs_state.pending_buffer = GS_NO_BUFFER;
+    g_gs_state.frames_presented = 0;
+    g_gs_state.frames_replaced = 0;
+    g_gs_state.vblank_handler_id = -1;
+    g_gs_state.vblank_sema = -1;
+    g_gs_state.finish_handler_id = -1;
+    g_gs_state.finish_sema = -1;
+    memset(g_gs_state.buffer_field, 0, sizeof(g_gs_state.buffer_field));
+    memset(g_gs_state.context_field, 0, sizeof(g_gs_state.context_field));
+    g_gs_state.frame_in_flight = false;
+    g_gs_state.inflight_buffer = GS_NO_BUFFER;
+    g_gs_state.zbuffer_base[0] = zb / GS_VRAM_PAGE_BLOCKS;
+    g_gs_state.zbuffer_base[1] = zb / GS_VRAM_PAGE_BLOCKS;
+    
+    // Texture addresses are assigned when the LUTs become resident
+    g_gs_state.clut_texture_base = GS_VRAM_INVALID;
+    g_gs_state.atlas_texture_base = GS_VRAM_INVALID;
+    
+    // Frame command buffer (two chunks, burst aligned)
+    g_gs_state.cmd_arena = (u64*)memory_alloc(MEMORY_BUDGET_DMA, 2 * GS_CMD_CHUNK_QWORDS * 16, GS_CMD_ALIGNMENT);
+    if (!g_gs_state.cmd_arena) {
+        printf("SPLATSTORM X: Failed to allocate GS command buffer\n");
+        gs_vram_cleanup();
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    g_gs_state.cmd_chunk[0] = g_gs_state.cmd_arena;
+    g_gs_state.cmd_chunk[1] = g_gs_state.cmd_arena + GS_CMD_CHUNK_QWORDS * 2;
+    g_gs_state.cmd_chunk_index = 0;
+    g_gs_state.cmd_used = 0;
+    g_gs_state.cmd_tag_pos = GS_CMD_NO_TAG;
+    g_gs_state.cmd_tag_nloop = 0;
+    g_gs_state.cmd_tag_sprites = 0;
+    g_gs_state.cmd_tag_odd = false;
+    g_gs_state.cmd_chunks_sent = 0;
     
     // Initialize GS display settings
     gs_write_reg(GS_PMODE, 0x0000000000000001ULL);  // Enable circuit 1
     gs_write_reg(GS_SMODE1, 0x0000000000000000ULL);  // NTSC mode
-    gs_write_reg(GS_SMODE2, 0x0000000000000001ULL);  // Interlaced
+    gs_write_reg(GS_SMODE2, g_gs_state.field_rendering ? (GS_SMODE2_INT | GS_SMODE2_FFMD) : GS_SMODE2_INT);
     
-    // Set display frame buffer
-    gs_write_reg(GS_DISPFB1, ((u64)g_gs_state.framebuffer_base[0]) | 
-                            ((u64)(width / 64) << 9) | ((u64)psm << 15));
-    gs_write_reg(GS_DISPLAY1, ((u64)width - 1) | (((u64)height - 1) << 12) | 
-                             (0x9FFULL << 23) | (0x1FFULL << 32));
+    // Set display frame buffer: buffer 0 starts drawing, so triple
+    // buffering shows the spare one until the first flip
+    gs_write_dispfb(g_gs_state.display_buffer, width);
+    gs_write_display(width, height);
     
     // Initialize drawing contexts
     for (u32 ctx = 0; ctx < 2; ctx++) {
@@ -281,24 +721,26 @@ GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm) {
         u32 scissor_reg = (ctx == 0) ? GS_SCISSOR_1 : GS_SCISSOR_2;
         u32 alpha_reg = (ctx == 0) ? GS_ALPHA_1 : GS_ALPHA_2;
         u32 test_reg = (ctx == 0) ? GS_TEST_1 : GS_TEST_2;
+        u32 offset_reg = (ctx == 0) ? GS_XYOFFSET_1 : GS_XYOFFSET_2;
         
         // Set frame buffer
-        gs_write_reg(frame_reg, gs_set_frame(g_gs_state.framebuffer_base[ctx], 
+        gs_write_reg(frame_reg, gs_set_frame(g_gs_state.framebuffer_base[g_gs_state.context_buffer[ctx]], 
                                            width / 64, psm, 0x00000000));
         
-        // Set Z-buffer
+        // Set Z-buffer; masked when disabled
         gs_write_reg(zbuf_reg, gs_set_zbuf(g_gs_state.zbuffer_base[ctx], 
-                                         GS_PSM_Z32, 0));
+                                         GS_PSM_Z32, g_gs_state.zbuffer_disabled ? 1 : 0));
         
         // Set scissor (full screen)
         gs_write_reg(scissor_reg, gs_set_scissor(0, width - 1, 0, height - 1));
+        gs_write_reg(offset_reg, 0);
         
         // Set alpha blending for Gaussian splatting
         // Use: (Cs * As + Cd * (1 - As))
         gs_write_reg(alpha_reg, gs_set_alpha(GS_BLEND_CS, GS_BLEND_CD, GS_BLEND_AS, GS_BLEND_AS, 0x80));
         
         // Enable alpha and depth testing
-        gs_write_reg(test_reg, gs_set_test(1, 4, 0x01, 0, 0, 0, 1, 2)); // ATE=1, ATST=GEQUAL, ZTE=1, ZTST=GEQUAL
+        gs_write_reg(test_reg, gs_splat_test());
     }
     
     // Initialize state
@@ -306,7 +748,7 @@ GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm) {
     g_gs_state.display_context = 0;
     g_gs_state.alpha_blending_enabled = true;
     g_gs_state.alpha_blend_mode = 0;  // Standard alpha blend
-    g_gs_state.depth_testing_enabled = true;
+    g_gs_state.depth_testing_enabled = !g_gs_state.zbuffer_disabled;
     g_gs_state.scissor_enabled = false;
     g_gs_state.textures_uploaded = false;
     
@@ -324,14 +766,62 @@ GaussianResult gs_renderer_init(u32 width, u32 height, u32 psm) {
     g_gs_state.show_tile_boundaries = false;
     g_gs_state.show_splat_centers = false;
     
+    // Triple buffering flips from VBLANK; without the handler swaps flip
+    // directly. The handler also wakes gs_wait_vblank() in either mode.
+    ee_sema_t vblank_sema;
+    memset(&vblank_sema, 0, sizeof(vblank_sema));
+    vblank_sema.init_count = 0;
+    vblank_sema.max_count = 1;
+    g_gs_state.vblank_sema = CreateSema(&vblank_sema);
+    g_gs_state.vblank_handler_id = AddIntcHandler(INTC_VBLANK_S, gs_vblank_handler, 0);
+    if (g_gs_state.vblank_handler_id < 0) {
+        if (g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS) {
+            // Give the third buffer back to textures and show buffer 0 as double buffering does
+            printf("SPLATSTORM X: VBLANK handler unavailable, double buffering\n");
+            gs_vram_free(g_gs_state.framebuffer_base[2] * GS_VRAM_PAGE_BLOCKS);
+            g_gs_state.framebuffer_count = 2;
+            g_gs_state.display_buffer = 0;
+            gs_write_dispfb(0, width);
+        }
+        if (g_gs_state.vblank_sema >= 0) {
+            DeleteSema(g_gs_state.vblank_sema);
+            g_gs_state.vblank_sema = -1;
+        }
+    } else {
+        EnableIntc(INTC_VBLANK_S);
+    }
+    
+    // Triple buffering sleeps on the FINISH event until a queued frame is
+    // drawn; without the handler the CSR event is polled
+    if (g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS) {
+        ee_sema_t finish_sema;
+        memset(&finish_sema, 0, sizeof(finish_sema));
+        finish_sema.init_count = 0;
+        finish_sema.max_count = 1;
+        g_gs_state.finish_sema = CreateSema(&finish_sema);
+        if (g_gs_state.finish_sema >= 0) {
+            g_gs_state.finish_handler_id = AddIntcHandler(INTC_GS, gs_finish_handler, 0);
+        }
+        if (g_gs_state.finish_handler_id >= 0) {
+            GsPutIMR(GsGetIMR() & ~GS_IMR_FINISHMSK);
+            EnableIntc(INTC_GS);
+        } else if (g_gs_state.finish_sema >= 0) {
+            DeleteSema(g_gs_state.finish_sema);
+            g_gs_state.finish_sema = -1;
+        }
+    }
+    
     g_gs_state.initialized = true;
     
-    printf("SPLATSTORM X: GS renderer initialized (%ux%u, PSM=%u)\n", width, height, psm);
+    printf("SPLATSTORM X: GS renderer initialized (%ux%u%s, PSM=%u%s, %u buffers)\n", width, height,
+           g_gs_state.field_rendering ? " per field" : "", psm,
+           g_gs_state.zbuffer_disabled ? ", no Z-buffer" : "", g_gs_state.framebuffer_count);
     
     return GAUSSIAN_SUCCESS;
 }
 
-// Upload LUT textures to GS VRAM
+// Upload LUT textures to GS VRAM. Repeated calls (scene or quality changes)
+// only transfer the page rows whose contents changed.
 GaussianResult gs_upload_lut_textures(const GaussianLUTs* luts) {
     if (!g_gs_state.initialized || !luts || !luts->initialized) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
@@ -339,79 +829,120 @@ GaussianResult gs_upload_lut_textures(const GaussianLUTs* luts) {
     
     printf("SPLATSTORM X: Uploading LUT textures to GS VRAM...\n");
     
-    // Upload exponential LUT (256x1 texture)
-    // This would typically use GS transfer commands
-    // For now, simulate the upload
-    
-    // Set up texture transfer
-    gs_write_reg(GS_BITBLTBUF, ((u64)g_gs_state.lut_texture_base) | 
-                              ((u64)4 << 16) | ((u64)GS_PSM_CT32 << 24) |
-                              ((u64)0 << 32) | ((u64)4 << 48) | ((u64)GS_PSM_CT32 << 56));
-    
-    gs_write_reg(GS_TRXPOS, 0);  // Source and dest positions
-    gs_write_reg(GS_TRXREG, ((u64)256) | ((u64)1 << 32));  // 256x1 transfer
-    gs_write_reg(GS_TRXDIR, 0);  // Host to local transfer
-    
-    // Transfer LUT data (simplified - actual implementation would use DMA)
-    // In real implementation, this would transfer luts->exp_lut data
-    
-    // Upload footprint atlas (256x256 texture)
-    gs_write_reg(GS_BITBLTBUF, ((u64)g_gs_state.atlas_texture_base) | 
-                              ((u64)4 << 16) | ((u64)GS_PSM_CT32 << 24) |
-                              ((u64)0 << 32) | ((u64)4 << 48) | ((u64)GS_PSM_CT32 << 56));
-    
-    gs_write_reg(GS_TRXREG, ((u64)ATLAS_SIZE) | ((u64)ATLAS_SIZE << 32));
-    
-    // Transfer atlas data
-    // In real implementation, this would transfer luts->footprint_atlas data
+    // Footprint atlas: palettized alpha (ATLAS_SIZE x ATLAS_HEIGHT with all mip levels), sampled by every splat
+    g_gs_state.atlas_texture_base = gs_vram_texture_upload(GS_TEXTURE_FOOTPRINT_ATLAS, luts->footprint_atlas,
+                                                           ATLAS_SIZE, ATLAS_HEIGHT, GS_ATLAS_PSM);
+    g_gs_state.clut_texture_base = gs_vram_texture_upload(GS_TEXTURE_FOOTPRINT_CLUT, luts->footprint_clut,
+                                                          GS_ATLAS_CLUT_WIDTH, GS_ATLAS_CLUT_HEIGHT, GS_PSM_CT32);
+    gs_vram_texture_pin(GS_TEXTURE_FOOTPRINT_ATLAS, true);
+    gs_vram_texture_pin(GS_TEXTURE_FOOTPRINT_CLUT, true);
+    
+    if (g_gs_state.atlas_texture_base == GS_VRAM_INVALID || g_gs_state.clut_texture_base == GS_VRAM_INVALID) {
+        printf("SPLATSTORM X: LUT texture upload failed\n");
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
     
+    // CLUT contents may have changed in place: reload on the next TEX0
+    g_gs_state.clut_dirty = true;
     g_gs_state.textures_uploaded = true;
     
-    printf("SPLATSTORM X: LUT textures uploaded successfully\n");
+    GSVramStats stats;
+    gs_vram_get_stats(&stats);
+    printf("SPLATSTORM X: LUT textures resident (%u bands, %u bytes uploaded so far, %u pages free)\n",
+           stats.bands_uploaded, stats.bytes_uploaded, stats.free_pages);
     
     return GAUSSIAN_SUCCESS;
 }
 
 // Set up texture sampling for Gaussian rendering
 void gs_setup_gaussian_texturing(void) {
+    g_gs_state.atlas_bound = false;
     if (!g_gs_state.initialized || !g_gs_state.textures_uploaded) return;
     
     u32 tex0_reg = (g_gs_state.current_context == 0) ? GS_TEX0_1 : GS_TEX0_2;
     
-    // Set up LUT texture (256x1, 32-bit)
-    gs_write_reg(tex0_reg, gs_set_tex0(
-        g_gs_state.lut_texture_base,  // TBP0: texture base pointer
-        4,                            // TBW: texture buffer width (256/64)
-        GS_PSM_CT32,                  // PSM: pixel storage mode
+    // Marks atlas and CLUT as used this frame (restores them if ever evicted)
+    g_gs_state.atlas_texture_base = gs_vram_texture_bind(GS_TEXTURE_FOOTPRINT_ATLAS);
+    g_gs_state.clut_texture_base = gs_vram_texture_bind(GS_TEXTURE_FOOTPRINT_CLUT);
+    if (g_gs_state.atlas_texture_base == GS_VRAM_INVALID || g_gs_state.clut_texture_base == GS_VRAM_INVALID) return;
+    
+    // The CLUT buffer only reloads when CBP changes, unless the CLUT was re-uploaded
+    u32 cld = g_gs_state.clut_dirty ? 2 : 4;
+    g_gs_state.clut_dirty = false;
+    
+    // Footprint atlas (256x384 in a 256x512 texture, 8/4-bit indices into the alpha ramp)
+    gs_cmd_ad(tex0_reg, gs_set_tex0(
+        g_gs_state.atlas_texture_base, // TBP0: texture base pointer
+        ATLAS_SIZE / 64,              // TBW: texture buffer width (256/64)
+        GS_ATLAS_PSM,                 // PSM: PSMT8 or PSMT4
         8,                            // TW: texture width (2^8 = 256)
-        0,                            // TH: texture height (2^0 = 1)
+        ATLAS_HEIGHT_LOG2,            // TH: texture height (2^9 = 512)
         1,                            // TCC: RGBA
         0,                            // TFX: modulate
-        0,                            // CBP: CLUT base pointer
-        0,                            // CPSM: CLUT pixel storage mode
-        0,                            // CSM: CLUT storage mode
+        g_gs_state.clut_texture_base, // CBP: CLUT base pointer
+        GS_PSM_CT32,                  // CPSM: CLUT pixel storage mode
+        0,                            // CSM: CSM1 (swizzled CT32 CLUT)
         0,                            // CSA: CLUT entry offset
-        1                             // CLD: CLUT load control
+        cld                           // CLD: CLUT load control
     ));
     
     // Set texture clamping
     u32 clamp_reg = (g_gs_state.current_context == 0) ? GS_CLAMP_1 : GS_CLAMP_2;
-    gs_write_reg(clamp_reg, 0x00000001);  // Clamp both U and V
+    gs_cmd_ad(clamp_reg, 0x00000005);  // Clamp both U and V
+    g_gs_state.atlas_bound = true;
 }
 
-// Clear frame buffer and Z-buffer
+// Render the next frames at width x height inside the allocated buffers.
+// The PCRTC magnifies the result to the display, so the width must divide
+// 2560 VCK (640, 512, 320...) and the height 448 (448, 224), or 224 in
+// field mode (224, 112). The frame and
+// scissor registers change in the command stream; the display switches
+// when the frame is swapped in.
+GaussianResult gs_set_render_resolution(u32 width, u32 height) {
+    if (!g_gs_state.initialized) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (width == 0 || height == 0 || width > g_gs_state.framebuffer_max_width ||
+        height > g_gs_state.framebuffer_max_height || (width % 64) != 0 ||
+        (GS_DISPLAY_VCK_WIDTH % width) != 0 || (GS_DISPLAY_HEIGHT % (height * gs_display_line_scale())) != 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (width == g_gs_state.framebuffer_width && height == g_gs_state.framebuffer_height) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    g_gs_state.framebuffer_width = width;
+    g_gs_state.framebuffer_height = height;
+    
+    // FBW follows the render width; the Z-buffer addresses by it too
+    for (u32 ctx = 0; ctx < 2; ctx++) {
+        gs_cmd_ad(ctx == 0 ? GS_FRAME_1 : GS_FRAME_2,
+                  gs_set_frame(g_gs_state.framebuffer_base[g_gs_state.context_buffer[ctx]], width / 64,
+                               g_gs_state.framebuffer_psm, 0));
+        gs_cmd_ad(ctx == 0 ? GS_SCISSOR_1 : GS_SCISSOR_2, gs_set_scissor(0, width - 1, 0, height - 1));
+    }
+    g_gs_state.scissor_enabled = false;
+    
+    return GAUSSIAN_SUCCESS;
+}
+
+void gs_get_render_resolution(u32* width, u32* height) {
+    if (width) *width = g_gs_state.framebuffer_width;
+    if (height) *height = g_gs_state.framebuffer_height;
+}
+
+// Clear frame buffer and Z-buffer (the depth write is masked without one)
 void gs_clear_buffers(u32 color, u32 depth) {
     if (!g_gs_state.initialized) return;
     
     u64 clear_start = get_cpu_cycles();
     
-    // Use sprite primitive to clear entire screen
-    u64 packet[16];
-    u32 qword_count = 0;
-    
+    // Use sprite primitive to clear entire screen, every pixel passing
     // Set primitive to sprite with no texturing
-    packet[qword_count++] = gs_set_prim(GS_PRIM_SPRITE, 0, 0, 0, 0, 0, 1, g_gs_state.current_context, 0);
-    packet[qword_count++] = GS_PRIM;
+    gs_cmd_ad(gs_test_reg(), gs_clear_test());
+    gs_cmd_ad(GS_PRIM, gs_set_prim(GS_PRIM_SPRITE, 0, 0, 0, 0, 0, 1, g_gs_state.current_context, 0));
     
     // Set clear color
     u32 r = (color >> 24) & 0xFF;
@@ -419,21 +950,15 @@ void gs_clear_buffers(u32 color, u32 depth) {
     u32 b = (color >> 8) & 0xFF;
     u32 a = color & 0xFF;
     
-    packet[qword_count++] = gs_set_rgbaq(r, g, b, a, 0);
-    packet[qword_count++] = GS_RGBAQ;
+    gs_cmd_ad(GS_RGBAQ, gs_set_rgbaq(r, g, b, a, 0));
     
     // Set Z value
-    packet[qword_count++] = gs_set_xyz2(0, 0, depth);
-    packet[qword_count++] = GS_XYZ2;
+    gs_cmd_ad(GS_XYZ2, gs_set_xyz2(0, 0, depth));
     
     // Draw full-screen quad
-    packet[qword_count++] = gs_set_xyz2((g_gs_state.framebuffer_width << 4), 
-                                       (g_gs_state.framebuffer_height << 4), depth);
-    packet[qword_count++] = GS_XYZ2;
-    
-    // Send packet to GS via DMA - Direct PS2SDK implementation
-    dma_channel_wait(DMA_CHANNEL_GIF, 0);
-    dma_channel_send_normal(DMA_CHANNEL_GIF, packet, qword_count, 0, 0);
+    gs_cmd_ad(GS_XYZ2, gs_set_xyz2((g_gs_state.framebuffer_width << 4), 
+                                  (g_gs_state.framebuffer_height << 4), depth));
+    gs_cmd_ad(gs_test_reg(), gs_splat_test());
     
     // Update performance statistics
     g_gs_state.render_cycles += get_cpu_cycles() - clear_start;
@@ -441,6 +966,26 @@ void gs_clear_buffers(u32 color, u32 depth) {
     g_gs_state.pixels_rendered += g_gs_state.framebuffer_width * g_gs_state.framebuffer_height;
 }
 
+// Clear one rectangle of the frame buffer to color with an untextured sprite.
+// Leaves the Z-buffer alone, so partial clears suit the Z-buffer-free mode.
+void gs_clear_rect(u32 x, u32 y, u32 width, u32 height, u32 color) {
+    if (!g_gs_state.initialized || width == 0 || height == 0) return;
+    
+    u32 x2 = MIN(x + width, g_gs_state.framebuffer_width);
+    u32 y2 = MIN(y + height, g_gs_state.framebuffer_height);
+    if (x >= x2 || y >= y2) return;
+    
+    gs_cmd_ad(gs_test_reg(), gs_clear_test());
+    gs_cmd_ad(GS_PRIM, gs_set_prim(GS_PRIM_SPRITE, 0, 0, 0, 0, 0, 1, g_gs_state.current_context, 0));
+    gs_cmd_ad(GS_RGBAQ, gs_set_rgbaq((color >> 24) & 0xFF, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF, 0));
+    gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x << 4, y << 4, 0));
+    gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x2 << 4, y2 << 4, 0));
+    gs_cmd_ad(gs_test_reg(), gs_splat_test());
+    
+    g_gs_state.primitives_rendered++;
+    g_gs_state.pixels_rendered += (x2 - x) * (y2 - y);
+}
+
 // Set scissor rectangle for tile rendering
 void gs_set_scissor_rect(u32 x, u32 y, u32 width, u32 height) {
     if (!g_gs_state.initialized) return;
@@ -453,7 +998,7 @@ void gs_set_scissor_rect(u32 x, u32 y, u32 width, u32 height) {
     u32 x2 = MIN(x + width - 1, g_gs_state.framebuffer_width - 1);
     u32 y2 = MIN(y + height - 1, g_gs_state.framebuffer_height - 1);
     
-    gs_write_reg(scissor_reg, gs_set_scissor(x1, x2, y1, y2));
+    gs_cmd_ad(scissor_reg, gs_set_scissor(x1, x2, y1, y2));
     
     // Update state
     g_gs_state.scissor_enabled = true;
@@ -471,10 +1016,20 @@ void gs_disable_scissor(void) {
     g_gs_state.scissor_enabled = false;
 }
 
-// Render a single Gaussian splat as textured sprite
+// Render a single Gaussian splat as textured sprite. Batches set PRIM once
+// and append sprites; a lone call sets it itself.
+static void gs_append_gaussian_splat(const GaussianSplat2D* splat);
+
 void gs_render_gaussian_splat(const GaussianSplat2D* splat) {
     if (!g_gs_state.initialized || !splat || splat->radius <= 0) return;
     
+    gs_cmd_ad(GS_PRIM, gs_get_splat_prim());
+    gs_append_gaussian_splat(splat);
+}
+
+static void gs_append_gaussian_splat(const GaussianSplat2D* splat) {
+    if (splat->radius <= 0) return;
+    
     u64 render_start = get_cpu_cycles();
     
     // Calculate sprite corners
@@ -494,39 +1049,17 @@ void gs_render_gaussian_splat(const GaussianSplat2D* splat) {
     gs_x2 = MIN(gs_x2, (g_gs_state.framebuffer_width << 4) - 1);
     gs_y2 = MIN(gs_y2, (g_gs_state.framebuffer_height << 4) - 1);
     
-    // Build rendering packet
-    u64 packet[32];
-    u32 qword_count = 0;
-    
-    // Set primitive to textured sprite
-    packet[qword_count++] = gs_set_prim(GS_PRIM_SPRITE, 0, 1, 0, 1, 0, 0, g_gs_state.current_context, 0);
-    packet[qword_count++] = GS_PRIM;
-    
-    // Set color and alpha
-    packet[qword_count++] = gs_set_rgbaq(splat->color[0], splat->color[1], 
-                                        splat->color[2], splat->color[3], 0);
-    packet[qword_count++] = GS_RGBAQ;
-    
-    // Set texture coordinates for LUT lookup
-    // Use atlas coordinates for footprint lookup
-    u32 atlas_u = splat->atlas_u;
-    u32 atlas_v = splat->atlas_v;
-    
-    packet[qword_count++] = gs_set_uv(0, 0);  // Top-left UV
-    packet[qword_count++] = GS_UV;
+    // Footprint cell from the atlas coordinates (cell centres) at the splat's mip level, UV in 14.4
+    u32 cell = (splat->atlas_v / FOOTPRINT_RES) * 8 + splat->atlas_u / FOOTPRINT_RES;
+    u32 cell_u, cell_v;
+    u32 cell_size = (FOOTPRINT_RES >> splat->atlas_level) << 4;
+    footprint_atlas_cell(cell, splat->atlas_level, &cell_u, &cell_v);
     
-    packet[qword_count++] = gs_set_xyz2(gs_x1, gs_y1, fixed_to_int(splat->depth) << 4);
-    packet[qword_count++] = GS_XYZ2;
-    
-    packet[qword_count++] = gs_set_uv(255, 255);  // Bottom-right UV
-    packet[qword_count++] = GS_UV;
-    
-    packet[qword_count++] = gs_set_xyz2(gs_x2, gs_y2, fixed_to_int(splat->depth) << 4);
-    packet[qword_count++] = GS_XYZ2;
-    
-    // Send packet to GS via DMA - Direct PS2SDK implementation
-    dma_channel_wait(DMA_CHANNEL_GIF, 0);
-    dma_channel_send_normal(DMA_CHANNEL_GIF, packet, qword_count, 0, 0);
+    // Append sprite to the frame command buffer: color, top-left and bottom-right corners
+    u32 z = gs_sprite_z(fixed_to_int(splat->depth) << 4);
+    gs_cmd_sprite(gs_set_rgbaq(splat->color[0], splat->color[1], splat->color[2], splat->color[3], 0),
+                  gs_set_uv(cell_u << 4, cell_v << 4), gs_set_xyz2(gs_x1, gs_y1, z),
+                  gs_set_uv((cell_u << 4) + cell_size, (cell_v << 4) + cell_size), gs_set_xyz2(gs_x2, gs_y2, z));
     
     // Update performance statistics
     g_gs_state.render_cycles += get_cpu_cycles() - render_start;
@@ -538,23 +1071,27 @@ void gs_render_gaussian_splat(const GaussianSplat2D* splat) {
     g_gs_state.pixels_rendered += sprite_width * sprite_height;
 }
 
+// PRIM value used for splat sprites (textured with UV texel coordinates, blended,
+// current context). Exposed so VU1 can emit the same primitive when it XGKICKs sprites itself
+u64 gs_get_splat_prim(void) {
+    return gs_set_prim(GS_PRIM_SPRITE, 0, 1, 0, 1, 0, 1, g_gs_state.current_context, 0);
+}
+
 // Render a batch of Gaussian splats
 void gs_render_splat_batch(const GaussianSplat2D* splats, u32 splat_count) {
     if (!g_gs_state.initialized || !splats || splat_count == 0) return;
     
     u64 batch_start = get_cpu_cycles();
     
-    // Set up texturing for the batch
+    // Set up texturing and the sprite primitive for the batch
     gs_setup_gaussian_texturing();
+    gs_cmd_ad(GS_PRIM, gs_get_splat_prim());
     
-    // Render each splat
+    // Render each splat (recorded; submitted in chunks and at frame end)
     for (u32 i = 0; i < splat_count; i++) {
-        gs_render_gaussian_splat(&splats[i]);
+        gs_append_gaussian_splat(&splats[i]);
     }
     
-    // Wait for batch completion
-    dma_channel_wait(DMA_CHANNEL_GIF, 0);
-    
     // Update batch statistics
     u64 batch_cycles = get_cpu_cycles() - batch_start;
     
@@ -566,18 +1103,103 @@ void gs_render_splat_batch(const GaussianSplat2D* splats, u32 splat_count) {
     }
 }
 
+// Sprites for a block of quantized render splats, the packet builder of
+// every render configuration. textured and zbuffer are constants in each
+// GS_SPLAT_KERNEL instance, so the per-splat loop carries no branches on
+// them. Position, radius and depth are already in GS units; this is packing.
+static inline __attribute__((always_inline)) void gs_build_splat_sprites(const GaussianSplatRender* splats,
+                                                                         u32 count, bool textured, bool zbuffer) {
+    s32 max_x = (s32)(g_gs_state.framebuffer_width << RENDER_SPLAT_SUBPIXEL_SHIFT) - 1;
+    s32 max_y = (s32)(g_gs_state.framebuffer_height << RENDER_SPLAT_SUBPIXEL_SHIFT) - 1;
+    u32 sprites = 0;
+    u32 pixels = 0;
+    
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplatRender* splat = &splats[i];
+        if (splat->radius == 0) continue;
+        
+        // Sprite corners, clamped to screen bounds
+        s32 gs_x1 = CLAMP((s32)splat->screen_x - splat->radius, 0, max_x);
+        s32 gs_y1 = CLAMP((s32)splat->screen_y - splat->radius, 0, max_y);
+        s32 gs_x2 = CLAMP((s32)splat->screen_x + splat->radius, 0, max_x);
+        s32 gs_y2 = CLAMP((s32)splat->screen_y + splat->radius, 0, max_y);
+        
+        // Without a Z-buffer nothing reads Z
+        u32 z = zbuffer ? splat->depth : 0;
+        u64 rgbaq = gs_set_rgbaq(splat->color[0], splat->color[1], splat->color[2], splat->color[3], 0);
+        if (textured) {
+            // Footprint cell at the mip level chosen from the splat's radius
+            u32 cell_u, cell_v;
+            u32 cell_size = (FOOTPRINT_RES >> splat->atlas_level) << 4;
+            footprint_atlas_cell(splat->atlas_index, splat->atlas_level, &cell_u, &cell_v);
+            
+            // Color, top-left and bottom-right corners into the batch's REGLIST run
+            gs_cmd_sprite(rgbaq, gs_set_uv(cell_u << 4, cell_v << 4), gs_set_xyz2(gs_x1, gs_y1, z),
+                          gs_set_uv((cell_u << 4) + cell_size, (cell_v << 4) + cell_size),
+                          gs_set_xyz2(gs_x2, gs_y2, z));
+        } else {
+            gs_cmd_flat_sprite(rgbaq, gs_set_xyz2(gs_x1, gs_y1, z), gs_set_xyz2(gs_x2, gs_y2, z));
+        }
+        
+        sprites++;
+        pixels += ((gs_x2 - gs_x1) >> RENDER_SPLAT_SUBPIXEL_SHIFT) * ((gs_y2 - gs_y1) >> RENDER_SPLAT_SUBPIXEL_SHIFT);
+    }
+    
+    g_gs_state.primitives_rendered += sprites;
+    g_gs_state.pixels_rendered += pixels;
+}
+
+// Packet building kernel for one render configuration: sprites for one
+// scratchpad block of gathered splats
+#define GS_SPLAT_KERNEL(name, textured, zbuffer) \
+    static void name(const void* block, u32 first, u32 count, void* user) { \
+        (void)first; \
+        (void)user; \
+        gs_build_splat_sprites((const GaussianSplatRender*)block, count, textured, zbuffer); \
+    }
+
+GS_SPLAT_KERNEL(gs_splat_kernel_flat, false, false)
+GS_SPLAT_KERNEL(gs_splat_kernel_flat_z, false, true)
+GS_SPLAT_KERNEL(gs_splat_kernel_textured, true, false)
+GS_SPLAT_KERNEL(gs_splat_kernel_textured_z, true, true)
+
+// By [atlas bound][Z-buffer]
+static const SprStreamKernel g_gs_splat_kernels[2][2] = {
+    { gs_splat_kernel_flat, gs_splat_kernel_flat_z },
+    { gs_splat_kernel_textured, gs_splat_kernel_textured_z },
+};
+
+// Render splats selected by index from a shared render splat array
+// The index list drives a scratchpad gather, so tiles never copy splat data
+// and packet building reads splats from SPR instead of missing the cache
+void gs_render_splat_indices(const GaussianSplatRender* splats, const u32* indices, u32 index_count) {
+    if (!g_gs_state.initialized || !splats || !indices || index_count == 0) return;
+    
+    u64 render_start = get_cpu_cycles();
+    
+    // Set up texturing and the sprite primitive; the splats follow as one
+    // REGLIST run. The configuration picks the kernel here, once per list.
+    // Without the atlas the sprites go out flat rather than sampling
+    // whatever the texture pages hold.
+    gs_setup_gaussian_texturing();
+    bool textured = g_gs_state.atlas_bound;
+    gs_cmd_ad(GS_PRIM, textured ? gs_get_splat_prim() :
+              gs_set_prim(GS_PRIM_SPRITE, 0, 0, 0, 1, 0, 1, g_gs_state.current_context, 0));
+    SprStreamKernel kernel = g_gs_splat_kernels[textured][!g_gs_state.zbuffer_disabled];
+    
+    dma_spr_stream(splats, sizeof(GaussianSplatRender), indices, index_count, kernel, NULL);
+    
+    g_gs_state.render_cycles += get_cpu_cycles() - render_start;
+}
+
 // Render debug visualization
 void gs_render_debug_overlay(void) {
     if (!g_gs_state.initialized || !g_gs_state.debug_mode) return;
     
     // Render tile boundaries
     if (g_gs_state.show_tile_boundaries) {
-        u64 packet[8];
-        u32 qword_count = 0;
-        
         // Set primitive to line
-        packet[qword_count++] = gs_set_prim(GS_PRIM_LINE, 0, 0, 0, 1, 0, 1, g_gs_state.current_context, 0);
-        packet[qword_count++] = GS_PRIM;
+        gs_cmd_ad(GS_PRIM, gs_set_prim(GS_PRIM_LINE, 0, 0, 0, 1, 0, 1, g_gs_state.current_context, 0));
         
         // Set debug color
         u32 r = (g_gs_state.debug_overlay_color >> 24) & 0xFF;
@@ -585,55 +1207,187 @@ void gs_render_debug_overlay(void) {
         u32 b = (g_gs_state.debug_overlay_color >> 8) & 0xFF;
         u32 a = g_gs_state.debug_overlay_color & 0xFF;
         
-        packet[qword_count++] = gs_set_rgbaq(r, g, b, a, 0);
-        packet[qword_count++] = GS_RGBAQ;
+        gs_cmd_ad(GS_RGBAQ, gs_set_rgbaq(r, g, b, a, 0));
         
         // Draw tile grid (simplified - would draw actual grid lines)
         for (u32 x = 0; x < g_gs_state.framebuffer_width; x += TILE_SIZE) {
             // Vertical line
-            packet[qword_count++] = gs_set_xyz2(x << 4, 0, 0);
-            packet[qword_count++] = GS_XYZ2;
-            
-            packet[qword_count++] = gs_set_xyz2(x << 4, g_gs_state.framebuffer_height << 4, 0);
-            packet[qword_count++] = GS_XYZ2;
-            
-            // Send packet via DMA - Direct PS2SDK implementation
-            dma_channel_wait(DMA_CHANNEL_GIF, 0);
-            dma_channel_send_normal(DMA_CHANNEL_GIF, packet, qword_count, 0, 0);
-            qword_count = 2;  // Reset to after PRIM and RGBAQ
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x << 4, 0, 0));
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x << 4, g_gs_state.framebuffer_height << 4, 0));
         }
         
         for (u32 y = 0; y < g_gs_state.framebuffer_height; y += TILE_SIZE) {
             // Horizontal line
-            packet[qword_count++] = gs_set_xyz2(0, y << 4, 0);
-            packet[qword_count++] = GS_XYZ2;
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(0, y << 4, 0));
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(g_gs_state.framebuffer_width << 4, y << 4, 0));
+        }
+    }
+}
+
+// Tile heatmap: each tile of the active grid (TILES_X stride) shaded blue
+// through green to red by its share of max_value, as untextured sprites
+// added onto the frame
+void gs_render_heatmap(const u32* heat, u32 tiles_x, u32 tiles_y, u32 max_value) {
+    if (!g_gs_state.initialized || !heat || max_value == 0) return;
+    
+    // Cs * As + Cd while the overlay draws
+    u32 alpha_reg = (g_gs_state.current_context == 0) ? GS_ALPHA_1 : GS_ALPHA_2;
+    gs_cmd_ad(alpha_reg, gs_set_alpha(GS_BLEND_CS, GS_BLEND_ZERO, GS_BLEND_AS, GS_BLEND_CD, 0));
+    gs_cmd_ad(GS_PRIM, gs_set_prim(GS_PRIM_SPRITE, 0, 0, 0, 1, 0, 1, g_gs_state.current_context, 0));
+    
+    u32 z = gs_sprite_z(GS_HEATMAP_Z);
+    for (u32 tile_y = 0; tile_y < tiles_y; tile_y++) {
+        for (u32 tile_x = 0; tile_x < tiles_x; tile_x++) {
+            u32 value = heat[tile_y * TILES_X + tile_x];
+            if (value == 0) continue;
             
-            packet[qword_count++] = gs_set_xyz2(g_gs_state.framebuffer_width << 4, y << 4, 0);
-            packet[qword_count++] = GS_XYZ2;
+            // 0..510: blue to green, then green to red
+            u32 level = (u32)(((u64)value * 510) / max_value);
+            u32 r = (level > 255) ? level - 255 : 0;
+            u32 g = (level > 255) ? 510 - level : level;
+            u32 b = (level > 255) ? 0 : 255 - level;
             
-            // Send packet via DMA - Direct PS2SDK implementation
-            dma_channel_wait(DMA_CHANNEL_GIF, 0);
-            dma_channel_send_normal(DMA_CHANNEL_GIF, packet, qword_count, 0, 0);
-            qword_count = 2;  // Reset
+            u32 x1 = tile_x * TILE_SIZE;
+            u32 y1 = tile_y * TILE_SIZE;
+            u32 x2 = MIN(x1 + TILE_SIZE, g_gs_state.framebuffer_width);
+            u32 y2 = MIN(y1 + TILE_SIZE, g_gs_state.framebuffer_height);
+            gs_cmd_ad(GS_RGBAQ, gs_set_rgbaq(r, g, b, GS_HEATMAP_ALPHA, 0));
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x1 << 4, y1 << 4, z));
+            gs_cmd_ad(GS_XYZ2, gs_set_xyz2(x2 << 4, y2 << 4, z));
+            g_gs_state.primitives_rendered++;
+        }
+    }
+    
+    // Back to the splat blend gs_renderer_init() set
+    gs_cmd_ad(alpha_reg, gs_set_alpha(GS_BLEND_CS, GS_BLEND_CD, GS_BLEND_AS, GS_BLEND_AS, 0x80));
+}
+
+// Show the frame in flight once the GS has drawn all of it. Triple
+// buffering queues it for VBLANK and only now picks the next draw buffer:
+// earlier, the one queued before it could still be the only free one.
+static void gs_complete_frame(void) {
+    u32 drawn = g_gs_state.inflight_buffer;
+    dma_wait_channel(DMA_CHANNEL_GIF);
+    
+    if (g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS) {
+        // Last primitives leaving the GIF FIFO
+        if (g_gs_state.finish_sema >= 0) {
+            WaitSema(g_gs_state.finish_sema);
+        } else {
+            while (!(*(volatile u64*)GS_CSR & GS_CSR_FINISH)) { /* No FINISH handler */ }
+        }
+        
+        // Queue the frame for VBLANK, replacing one still waiting, and draw
+        // on into the buffer neither shown nor queued: there always is one
+        DIntr();
+        if (g_gs_state.pending_buffer != GS_NO_BUFFER) {
+            g_gs_state.frames_replaced++;
+        }
+        g_gs_state.pending_buffer = drawn;
+        u32 free_buffer = 0;
+        while (free_buffer == g_gs_state.display_buffer || free_buffer == drawn) {
+            free_buffer++;
         }
+        EIntr();
+        
+        g_gs_state.context_buffer[g_gs_state.current_context] = free_buffer;
+        gs_cmd_ad(g_gs_state.current_context == 0 ? GS_FRAME_1 : GS_FRAME_2,
+                  gs_set_frame(g_gs_state.framebuffer_base[free_buffer], g_gs_state.framebuffer_width / 64,
+                               g_gs_state.framebuffer_psm, 0));
+    } else {
+        // Update display frame buffer, magnified from the resolution it was drawn at
+        gs_write_dispfb(drawn, g_gs_state.buffer_width[drawn]);
+        gs_write_display(g_gs_state.buffer_width[drawn], g_gs_state.buffer_height[drawn]);
     }
+    
+    g_gs_state.frame_in_flight = false;
+    g_gs_state.inflight_buffer = GS_NO_BUFFER;
 }
 
-// Swap rendering contexts (double buffering)
+// Wait for a frame gs_swap_contexts() left drawing and show it. Call before
+// the next frame sends GS work: its clear must not reach the buffer on
+// screen, and VU1 direct rendering must not overtake it on PATH1.
+void gs_sync_frame(void) {
+    if (!g_gs_state.initialized || !g_gs_state.frame_in_flight) {
+        g_gs_state.sync_wait_cycles = 0;
+        return;
+    }
+    
+    u64 wait_start = get_cpu_cycles();
+    gs_complete_frame();
+    g_gs_state.sync_wait_cycles = get_cpu_cycles() - wait_start;
+}
+
+u64 gs_get_sync_wait_cycles(void) {
+    return g_gs_state.sync_wait_cycles;
+}
+
+// Swap rendering contexts (double buffering). With a frame latency of 1
+// the frame is only queued; gs_sync_frame() before the next frame's GS
+// work completes it.
 void gs_swap_contexts(void) {
     if (!g_gs_state.initialized) return;
     
-    // Wait for current rendering to complete
-    dma_channel_wait(DMA_CHANNEL_GIF, 0);
+    gs_sync_frame();
+    
+    // A queued frame must be completely drawn before VBLANK can show it:
+    // FINISH raises its CSR event once the GS has processed everything before it
+    if (g_gs_state.framebuffer_count == GS_MAX_FRAMEBUFFERS) {
+        *(volatile u64*)GS_CSR = GS_CSR_FINISH;
+        gs_cmd_ad(GS_FINISH, 0);
+    }
+    
+    // Submit the rest of the frame
+    gs_cmd_submit_chunk();
+    
+    u32 drawn = g_gs_state.context_buffer[g_gs_state.current_context];
+    g_gs_state.buffer_width[drawn] = g_gs_state.framebuffer_width;
+    g_gs_state.buffer_height[drawn] = g_gs_state.framebuffer_height;
+    g_gs_state.buffer_field[drawn] = g_gs_state.context_field[g_gs_state.current_context];
+    g_gs_state.inflight_buffer = drawn;
+    g_gs_state.frame_in_flight = true;
     
     // Swap contexts
     g_gs_state.display_context = g_gs_state.current_context;
     g_gs_state.current_context = 1 - g_gs_state.current_context;
     
-    // Update display frame buffer
-    gs_write_reg(GS_DISPFB1, ((u64)g_gs_state.framebuffer_base[g_gs_state.display_context]) | 
-                            ((u64)(g_gs_state.framebuffer_width / 64) << 9) | 
-                            ((u64)g_gs_state.framebuffer_psm << 15));
+    if (g_gs_state.frame_latency == 0) {
+        gs_complete_frame();
+    }
+    
+    // Field mode: the odd field scans half a buffer line lower, so the next
+    // frame is drawn half a line up when it lands on an odd field. The swap
+    // shows on the field after the one being scanned; the next frame two later.
+    // Triple buffering flips at VBLANK instead, so the buffer remembers its
+    // field and the handler holds it until that field comes round.
+    if (g_gs_state.field_rendering) {
+        u64 csr = *(volatile u64*)GS_CSR;
+        g_gs_state.field_parity = (u32)(csr >> GS_CSR_FIELD_SHIFT) & 1;
+        g_gs_state.context_field[g_gs_state.current_context] = g_gs_state.field_parity;
+        gs_cmd_ad(g_gs_state.current_context == 0 ? GS_XYOFFSET_1 : GS_XYOFFSET_2,
+                  (u64)(g_gs_state.field_parity ? GS_FIELD_HALF_LINE : 0) << 32);
+    }
+    
+    // Texture LRU ages by displayed frames
+    gs_vram_next_frame();
+}
+
+// Sleep until the next VBLANK starts, for frames that draw nothing and
+// leave the previous image on screen. A triple-buffered frame still
+// queued is flipped to by then, or a VBLANK later when drawn for the other field. Without the handler the CSR event is polled.
+void gs_wait_vblank(void) {
+    if (!g_gs_state.initialized) return;
+    
+    gs_sync_frame();
+    
+    if (g_gs_state.vblank_sema >= 0) {
+        PollSema(g_gs_state.vblank_sema);  // Drop a VBLANK that already passed
+        WaitSema(g_gs_state.vblank_sema);
+        return;
+    }
+    
+    *(volatile u64*)GS_CSR = GS_CSR_VSINT;
+    while (!(*(volatile u64*)GS_CSR & GS_CSR_VSINT)) { /* Scanning out */ }
 }
 
 // Get rendering performance statistics
@@ -691,11 +1445,42 @@ void gs_renderer_cleanup(void) {
     printf("SPLATSTORM X: Cleaning up GS rendering system...\n");
     
     // Wait for all rendering to complete
+    gs_sync_frame();
+    gs_cmd_submit_chunk();
     dma_channel_wait(DMA_CHANNEL_GIF, 0);
     
+    if (g_gs_state.vblank_handler_id >= 0) {
+        DisableIntc(INTC_VBLANK_S);
+        RemoveIntcHandler(INTC_VBLANK_S, g_gs_state.vblank_handler_id);
+        g_gs_state.vblank_handler_id = -1;
+    }
+    if (g_gs_state.vblank_sema >= 0) {
+        DeleteSema(g_gs_state.vblank_sema);
+        g_gs_state.vblank_sema = -1;
+    }
+    if (g_gs_state.finish_handler_id >= 0) {
+        GsPutIMR(GsGetIMR() | GS_IMR_FINISHMSK);
+        DisableIntc(INTC_GS);
+        RemoveIntcHandler(INTC_GS, g_gs_state.finish_handler_id);
+        g_gs_state.finish_handler_id = -1;
+    }
+    if (g_gs_state.finish_sema >= 0) {
+        DeleteSema(g_gs_state.finish_sema);
+        g_gs_state.finish_sema = -1;
+    }
+    
     // Reset GS to default state
     gs_write_reg(GS_PMODE, 0x0000000000000000ULL);
     
+    // Free frame command buffer
+    if (g_gs_state.cmd_arena) {
+        memory_free(g_gs_state.cmd_arena);
+        g_gs_state.cmd_arena = NULL;
+    }
+    
+    // Frame buffers and resident textures
+    gs_vram_cleanup();
+    
     // Clear state
     memset(&g_gs_state, 0, sizeof(GSRenderState));
     
@@ -0,0 +1,579 @@
+/*
+ * SPLATSTORM X - GS VRAM Manager
+ * Page/block allocator for the Graphics Synthesizer's 4MB local memory
+ * with residency tracking for the LUT and atlas textures
+ *
+ * COMPLETE IMPLEMENTATION - NO STUBS OR PLACEHOLDERS
+ * Features:
+ * - Allocation in GS block (256 byte) and page (8KB) units
+ * - PSM-aware footprints: page-sized buffers take whole pages, smaller
+ *   textures take the power-of-two block run their swizzle needs
+ * - Frame/Z buffers packed from the bottom, small textures from the top
+ * - Texture residency table with LRU eviction of unpinned textures
+ * - Per page-row checksums so only changed bands are re-uploaded
+ * - GIF IMAGE transfers referenced in place by one chain DMA
+ */
+
+#include "splatstorm_x.h"
+#include "gaussian_types.h"
+#include <dma.h>
+#include <string.h>
+#include <stdio.h>
+
+// GS registers used by host-to-local transfers
+#define GS_TEXFLUSH     0x3F
+#define GS_BITBLTBUF    0x50
+#define GS_TRXPOS       0x51
+#define GS_TRXREG       0x52
+#define GS_TRXDIR       0x53
+#define GS_AD           0x0E
+
+// Pixel storage modes
+#define GS_PSM_CT32     0x00
+#define GS_PSM_CT24     0x01
+#define GS_PSM_CT16     0x02
+#define GS_PSM_CT16S    0x0A
+#define GS_PSM_T8       0x13
+#define GS_PSM_T4       0x14
+#define GS_PSM_Z32      0x30
+#define GS_PSM_Z24      0x31
+#define GS_PSM_Z16      0x32
+#define GS_PSM_Z16S     0x3A
+
+#define GS_VRAM_IMAGE_MAX_QWORDS    0x7FFF        // GIF tag NLOOP limit
+#define GS_VRAM_HEADER_QWORDS       6             // A+D tag, 4 registers, IMAGE tag
+#define GS_VRAM_PACKET_QWORDS       (GS_VRAM_MAX_BANDS * GS_VRAM_HEADER_QWORDS + 2)
+#define GS_VRAM_PACKET_ALIGNMENT    128
+
+// Page and block geometry of a pixel storage mode
+typedef struct {
+    u32 psm;
+    u16 page_w, page_h;                       // Pixels per page
+    u16 block_w, block_h;                     // Pixels per block
+    u16 grow_y_first;                         // Block numbering doubles height first
+    u16 bits;                                 // Bits per pixel
+} GSPsmLayout;
+
+static const GSPsmLayout g_psm_layouts[] = {
+    { GS_PSM_CT32,  64,  32,  8,  8, 0, 32 },
+    { GS_PSM_CT24,  64,  32,  8,  8, 0, 32 },
+    { GS_PSM_CT16,  64,  64, 16,  8, 1, 16 },
+    { GS_PSM_CT16S, 64,  64, 16,  8, 1, 16 },
+    { GS_PSM_T8,   128,  64, 16, 16, 0,  8 },
+    { GS_PSM_T4,   128, 128, 32, 16, 1,  4 },
+    { GS_PSM_Z32,   64,  32,  8,  8, 0, 32 },
+    { GS_PSM_Z24,   64,  32,  8,  8, 0, 32 },
+    { GS_PSM_Z16,   64,  64, 16,  8, 1, 16 },
+    { GS_PSM_Z16S,  64,  64, 16,  8, 1, 16 },
+};
+
+// Live allocation
+typedef struct {
+    u32 tbp;                                  // First block
+    u32 blocks;                               // Blocks reserved (rounded footprint)
+    bool used;
+} GSVramAlloc;
+
+// Managed texture residency
+typedef struct {
+    const void* data;                         // Source image, kept for restores after eviction
+    u32 tbp;                                  // Block address, GS_VRAM_INVALID when not resident
+    u32 width, height, psm, tbw;
+    u32 band_rows;                            // Rows per tracked band (whole page rows)
+    u32 band_count;
+    u32 band_checksum[GS_VRAM_MAX_BANDS];     // Content of each band as last uploaded
+    u32 last_used;                            // Frame of the last bind or upload
+    bool registered;
+    bool pinned;                              // Never evicted
+} GSVramTexture;
+
+// VRAM manager state
+typedef struct {
+    bool initialized;
+    u32 page_map[GS_VRAM_PAGE_COUNT];         // Bit n set: block n of the page is in use
+    GSVramAlloc allocs[GS_VRAM_MAX_ALLOCS];
+    GSVramTexture textures[GS_TEXTURE_COUNT];
+    u32 frame;                                // LRU clock, advanced once per frame
+    u64* packet;                              // Transfer headers for one upload
+    GSVramStats stats;
+} GSVramState;
+
+static GSVramState g_vram_state = {0};
+
+static const GSPsmLayout* gs_vram_layout(u32 psm) {
+    for (u32 i = 0; i < sizeof(g_psm_layouts) / sizeof(g_psm_layouts[0]); i++) {
+        if (g_psm_layouts[i].psm == psm) return &g_psm_layouts[i];
+    }
+    return NULL;
+}
+
+// Buffer width in 64-pixel units; 8/4-bit formats need whole 128-pixel pages
+static u32 gs_vram_tbw(const GSPsmLayout* layout, u32 width) {
+    u32 step = layout->page_w / 64;
+    u32 tbw = (width + 63) / 64;
+    return ((tbw + step - 1) / step) * step;
+}
+
+// Blocks covered by a width x height image at a page-aligned base
+static u32 gs_vram_footprint(const GSPsmLayout* layout, u32 width, u32 height) {
+    if (width > layout->page_w || height > layout->page_h) {
+        u32 pages_x = (width + layout->page_w - 1) / layout->page_w;
+        u32 pages_y = (height + layout->page_h - 1) / layout->page_h;
+        return pages_x * pages_y * GS_VRAM_PAGE_BLOCKS;
+    }
+
+    // Inside a page the block numbering doubles width and height in turn
+    u32 w = layout->block_w;
+    u32 h = layout->block_h;
+    u32 blocks = 1;
+    bool grow_y = layout->grow_y_first;
+    while (w < width || h < height) {
+        if (grow_y) h *= 2; else w *= 2;
+        blocks *= 2;
+        grow_y = !grow_y;
+    }
+    return blocks;
+}
+
+static void gs_vram_mark(u32 tbp, u32 blocks, bool used) {
+    while (blocks > 0) {
+        u32 page = tbp / GS_VRAM_PAGE_BLOCKS;
+        u32 first = tbp % GS_VRAM_PAGE_BLOCKS;
+        u32 count = MIN(blocks, GS_VRAM_PAGE_BLOCKS - first);
+        u32 bits = (count == GS_VRAM_PAGE_BLOCKS) ? 0xFFFFFFFF : (((1U << count) - 1) << first);
+
+        if (used) {
+            g_vram_state.page_map[page] |= bits;
+        } else {
+            g_vram_state.page_map[page] &= ~bits;
+        }
+
+        tbp += count;
+        blocks -= count;
+    }
+}
+
+static bool gs_vram_range_free(u32 tbp, u32 blocks) {
+    while (blocks > 0) {
+        u32 page = tbp / GS_VRAM_PAGE_BLOCKS;
+        u32 first = tbp % GS_VRAM_PAGE_BLOCKS;
+        u32 count = MIN(blocks, GS_VRAM_PAGE_BLOCKS - first);
+        u32 bits = (count == GS_VRAM_PAGE_BLOCKS) ? 0xFFFFFFFF : (((1U << count) - 1) << first);
+
+        if (g_vram_state.page_map[page] & bits) return false;
+
+        tbp += count;
+        blocks -= count;
+    }
+    return true;
+}
+
+// Find room for an already rounded footprint
+static u32 gs_vram_find(u32 blocks) {
+    if (blocks >= GS_VRAM_PAGE_BLOCKS) {
+        // Whole pages, first fit from the bottom
+        u32 pages = blocks / GS_VRAM_PAGE_BLOCKS;
+        u32 run = 0;
+        for (u32 page = 0; page < GS_VRAM_PAGE_COUNT; page++) {
+            run = (g_vram_state.page_map[page] == 0) ? run + 1 : 0;
+            if (run == pages) return (page + 1 - pages) * GS_VRAM_PAGE_BLOCKS;
+        }
+        return GS_VRAM_INVALID;
+    }
+
+    // Power-of-two run aligned to its size, so the swizzle stays inside one page.
+    // Partly used pages go first to keep whole pages free for buffers.
+    u32 mask = (1U << blocks) - 1;
+    for (u32 pass = 0; pass < 2; pass++) {
+        for (s32 page = GS_VRAM_PAGE_COUNT - 1; page >= 0; page--) {
+            u32 word = g_vram_state.page_map[page];
+            bool partial = (word != 0);
+            if (partial != (pass == 0) || word == 0xFFFFFFFF) continue;
+
+            for (u32 first = 0; first < GS_VRAM_PAGE_BLOCKS; first += blocks) {
+                if (!(word & (mask << first))) return page * GS_VRAM_PAGE_BLOCKS + first;
+            }
+        }
+    }
+    return GS_VRAM_INVALID;
+}
+
+static u32 gs_vram_round(u32 blocks) {
+    if (blocks >= GS_VRAM_PAGE_BLOCKS) {
+        return (blocks + GS_VRAM_PAGE_BLOCKS - 1) & ~(GS_VRAM_PAGE_BLOCKS - 1);
+    }
+    u32 rounded = 1;
+    while (rounded < blocks) rounded *= 2;
+    return rounded;
+}
+
+static GSVramAlloc* gs_vram_record(u32 tbp, u32 blocks) {
+    for (u32 i = 0; i < GS_VRAM_MAX_ALLOCS; i++) {
+        GSVramAlloc* alloc = &g_vram_state.allocs[i];
+        if (alloc->used) continue;
+
+        alloc->tbp = tbp;
+        alloc->blocks = blocks;
+        alloc->used = true;
+
+        gs_vram_mark(tbp, blocks, true);
+        g_vram_state.stats.used_blocks += blocks;
+        g_vram_state.stats.peak_blocks = MAX(g_vram_state.stats.peak_blocks, g_vram_state.stats.used_blocks);
+        return alloc;
+    }
+    return NULL;
+}
+
+// Least recently used texture that may leave VRAM; ones bound this frame stay
+static s32 gs_vram_lru_victim(void) {
+    s32 victim = -1;
+    for (u32 i = 0; i < GS_TEXTURE_COUNT; i++) {
+        GSVramTexture* texture = &g_vram_state.textures[i];
+        if (!texture->registered || texture->pinned || texture->tbp == GS_VRAM_INVALID) continue;
+        if (texture->last_used == g_vram_state.frame) continue;
+
+        if (victim < 0 || texture->last_used < g_vram_state.textures[victim].last_used) {
+            victim = (s32)i;
+        }
+    }
+    return victim;
+}
+
+// Initialize the VRAM manager (idempotent)
+GaussianResult gs_vram_init(void) {
+    if (g_vram_state.initialized) {
+        return GAUSSIAN_SUCCESS;
+    }
+
+    memset(&g_vram_state, 0, sizeof(g_vram_state));
+    for (u32 i = 0; i < GS_TEXTURE_COUNT; i++) {
+        g_vram_state.textures[i].tbp = GS_VRAM_INVALID;
+    }
+
+    g_vram_state.packet = (u64*)memory_alloc(MEMORY_BUDGET_DMA, GS_VRAM_PACKET_QWORDS * 16, GS_VRAM_PACKET_ALIGNMENT);
+    if (!g_vram_state.packet) {
+        printf("SPLATSTORM X: Failed to allocate VRAM upload packet\n");
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+
+    g_vram_state.frame = 1;
+    g_vram_state.initialized = true;
+
+    printf("SPLATSTORM X: GS VRAM manager initialized (%u pages, %u blocks)\n",
+           GS_VRAM_PAGE_COUNT, GS_VRAM_BLOCK_COUNT);
+
+    return GAUSSIAN_SUCCESS;
+}
+
+bool gs_vram_is_initialized(void) {
+    return g_vram_state.initialized;
+}
+
+void gs_vram_cleanup(void) {
+    if (!g_vram_state.initialized) return;
+
+    // Headers may still be read by an upload in flight
+    dma_channel_wait(DMA_CHANNEL_GIF, 0);
+    memory_free(g_vram_state.packet);
+
+    memset(&g_vram_state, 0, sizeof(g_vram_state));
+    printf("SPLATSTORM X: GS VRAM manager cleaned up\n");
+}
+
+// Blocks a width x height buffer occupies in the given PSM (0 if unknown)
+u32 gs_vram_buffer_blocks(u32 width, u32 height, u32 psm) {
+    const GSPsmLayout* layout = gs_vram_layout(psm);
+    if (!layout || width == 0 || height == 0) return 0;
+
+    return gs_vram_round(gs_vram_footprint(layout, width, height));
+}
+
+// Allocate blocks; evicts LRU textures when VRAM is full
+u32 gs_vram_alloc_blocks(u32 blocks) {
+    if (!g_vram_state.initialized || blocks == 0 || blocks > GS_VRAM_BLOCK_COUNT) {
+        return GS_VRAM_INVALID;
+    }
+
+    blocks = gs_vram_round(blocks);
+
+    u32 tbp = gs_vram_find(blocks);
+    while (tbp == GS_VRAM_INVALID) {
+        s32 victim = gs_vram_lru_victim();
+        if (victim < 0) break;
+
+        gs_vram_texture_evict((GSTextureId)victim);
+        g_vram_state.stats.evictions++;
+        tbp = gs_vram_find(blocks);
+    }
+
+    if (tbp == GS_VRAM_INVALID || !gs_vram_record(tbp, blocks)) {
+        g_vram_state.stats.failed_allocs++;
+        printf("SPLATSTORM X: GS VRAM allocation of %u blocks failed (%u used)\n",
+               blocks, g_vram_state.stats.used_blocks);
+        return GS_VRAM_INVALID;
+    }
+
+    return tbp;
+}
+
+// Allocate a frame/Z buffer or texture; returns its block address
+u32 gs_vram_alloc(u32 width, u32 height, u32 psm) {
+    u32 blocks = gs_vram_buffer_blocks(width, height, psm);
+    if (blocks == 0) return GS_VRAM_INVALID;
+
+    return gs_vram_alloc_blocks(blocks);
+}
+
+// Claim a fixed range (memory another owner already placed there)
+GaussianResult gs_vram_reserve(u32 tbp, u32 blocks) {
+    if (!g_vram_state.initialized || blocks == 0 || tbp + blocks > GS_VRAM_BLOCK_COUNT) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (!gs_vram_range_free(tbp, blocks) || !gs_vram_record(tbp, blocks)) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+void gs_vram_free(u32 tbp) {
+    if (!g_vram_state.initialized || tbp == GS_VRAM_INVALID) return;
+
+    for (u32 i = 0; i < GS_VRAM_MAX_ALLOCS; i++) {
+        GSVramAlloc* alloc = &g_vram_state.allocs[i];
+        if (!alloc->used || alloc->tbp != tbp) continue;
+
+        gs_vram_mark(alloc->tbp, alloc->blocks, false);
+        g_vram_state.stats.used_blocks -= alloc->blocks;
+        alloc->used = false;
+        return;
+    }
+
+    printf("SPLATSTORM X: GS VRAM free of unknown block 0x%X\n", tbp);
+}
+
+// FNV-1a over whole words
+static u32 gs_vram_checksum(const u32* words, u32 count) {
+    u32 hash = 0x811C9DC5;
+    for (u32 i = 0; i < count; i++) {
+        hash = (hash ^ words[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+// Append the register setup for one host-to-local transfer of rows [y, y + rows)
+static u64* gs_vram_write_header(u64* packet, const GSVramTexture* texture, u32 y, u32 rows, u32 qwords) {
+    packet[0] = 4ULL | (1ULL << 60);                          // NLOOP=4, A+D, PACKED
+    packet[1] = GS_AD;
+    packet[2] = ((u64)texture->tbp << 32) | ((u64)texture->tbw << 48) | ((u64)texture->psm << 56);
+    packet[3] = GS_BITBLTBUF;
+    packet[4] = (u64)y << 48;                                 // DSAX=0, DSAY=y
+    packet[5] = GS_TRXPOS;
+    packet[6] = (u64)texture->width | ((u64)rows << 32);
+    packet[7] = GS_TRXREG;
+    packet[8] = 0;                                            // Host to local
+    packet[9] = GS_TRXDIR;
+    packet[10] = (u64)qwords | (1ULL << 15) | (2ULL << 58);   // NLOOP, EOP, IMAGE
+    packet[11] = 0;
+    return packet + 12;
+}
+
+// Upload (or keep) a managed texture; only page rows whose content changed are
+// transferred. The source must stay valid while the texture is registered.
+u32 gs_vram_texture_upload(GSTextureId id, const void* data, u32 width, u32 height, u32 psm) {
+    const GSPsmLayout* layout = gs_vram_layout(psm);
+    if (!g_vram_state.initialized || id >= GS_TEXTURE_COUNT || !data || !layout ||
+        width == 0 || height == 0 || ((uintptr_t)data & 15)) {
+        return GS_VRAM_INVALID;
+    }
+
+    // Transfers move whole qwords per row
+    u32 row_bytes = width * layout->bits / 8;
+    if (row_bytes & 15) {
+        printf("SPLATSTORM X: Texture %u rows are not qword sized\n", id);
+        return GS_VRAM_INVALID;
+    }
+
+    GSVramTexture* texture = &g_vram_state.textures[id];
+    g_vram_state.stats.uploads++;
+
+    // New geometry: forget the old copy
+    if (texture->registered && (texture->width != width || texture->height != height || texture->psm != psm)) {
+        gs_vram_texture_evict(id);
+        texture->registered = false;
+    }
+
+    if (!texture->registered) {
+        u32 band_rows = layout->page_h;
+        while ((height + band_rows - 1) / band_rows > GS_VRAM_MAX_BANDS) band_rows *= 2;
+
+        texture->width = width;
+        texture->height = height;
+        texture->psm = psm;
+        texture->tbw = gs_vram_tbw(layout, width);
+        texture->band_rows = band_rows;
+        texture->band_count = (height + band_rows - 1) / band_rows;
+        texture->registered = true;
+    }
+
+    if (row_bytes * texture->band_rows / 16 > GS_VRAM_IMAGE_MAX_QWORDS) {
+        printf("SPLATSTORM X: Texture %u band exceeds one IMAGE transfer\n", id);
+        return GS_VRAM_INVALID;
+    }
+
+    texture->data = data;
+    texture->last_used = g_vram_state.frame;
+
+    bool all_dirty = false;
+    if (texture->tbp == GS_VRAM_INVALID) {
+        texture->tbp = gs_vram_alloc(width, height, psm);
+        if (texture->tbp == GS_VRAM_INVALID) return GS_VRAM_INVALID;
+        all_dirty = true;
+    }
+
+    // Dirty bands, merged into runs that each fit one IMAGE tag
+    u32 run_y[GS_VRAM_MAX_BANDS];
+    u32 run_rows[GS_VRAM_MAX_BANDS];
+    u32 run_count = 0;
+    bool extend = false;
+
+    for (u32 band = 0; band < texture->band_count; band++) {
+        u32 y = band * texture->band_rows;
+        u32 rows = MIN(texture->band_rows, height - y);
+        const u32* words = (const u32*)((const u8*)data + y * row_bytes);
+        u32 checksum = gs_vram_checksum(words, rows * row_bytes / 4);
+
+        if (!all_dirty && checksum == texture->band_checksum[band]) {
+            extend = false;
+            continue;
+        }
+        texture->band_checksum[band] = checksum;
+
+        if (extend && (run_rows[run_count - 1] + rows) * row_bytes / 16 <= GS_VRAM_IMAGE_MAX_QWORDS) {
+            run_rows[run_count - 1] += rows;
+        } else {
+            run_y[run_count] = y;
+            run_rows[run_count] = rows;
+            run_count++;
+        }
+        extend = true;
+        g_vram_state.stats.bands_uploaded++;
+    }
+
+    if (run_count == 0) {
+        g_vram_state.stats.uploads_skipped++;
+        return texture->tbp;
+    }
+
+    // Draws already recorded may still sample the old contents
+    gs_flush_command_buffer();
+
+    // The previous upload's chain may still be reading the headers
+    dma_wait_channel(DMA_CHANNEL_GIF);
+
+    const void* blocks[GS_VRAM_MAX_BANDS * 2 + 1];
+    u32 sizes[GS_VRAM_MAX_BANDS * 2 + 1];
+    u32 block_count = 0;
+    u64* packet = g_vram_state.packet;
+
+    for (u32 run = 0; run < run_count; run++) {
+        u32 bytes = run_rows[run] * row_bytes;
+
+        blocks[block_count] = packet;
+        sizes[block_count++] = GS_VRAM_HEADER_QWORDS * 16;
+        packet = gs_vram_write_header(packet, texture, run_y[run], run_rows[run], bytes / 16);
+
+        blocks[block_count] = (const u8*)data + run_y[run] * row_bytes;
+        sizes[block_count++] = bytes;
+
+        g_vram_state.stats.bytes_uploaded += bytes;
+    }
+
+    // New texels become visible to the texture cache
+    packet[0] = 1ULL | (1ULL << 15) | (1ULL << 60);           // NLOOP=1, EOP, A+D
+    packet[1] = GS_AD;
+    packet[2] = 0;
+    packet[3] = GS_TEXFLUSH;
+    blocks[block_count] = packet;
+    sizes[block_count++] = 2 * 16;
+
+    if (dma_setup_chain_transfer(blocks, sizes, block_count, DMA_CHANNEL_GIF) != GAUSSIAN_SUCCESS ||
+        dma_execute_chain_transfer(DMA_CHANNEL_GIF) != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Texture %u upload failed\n", id);
+        gs_vram_texture_evict(id);
+        return GS_VRAM_INVALID;
+    }
+
+    return texture->tbp;
+}
+
+// Make a managed texture resident for drawing; restores it after an eviction
+u32 gs_vram_texture_bind(GSTextureId id) {
+    if (!g_vram_state.initialized || id >= GS_TEXTURE_COUNT) return GS_VRAM_INVALID;
+
+    GSVramTexture* texture = &g_vram_state.textures[id];
+    if (!texture->registered) return GS_VRAM_INVALID;
+
+    g_vram_state.stats.binds++;
+    texture->last_used = g_vram_state.frame;
+
+    if (texture->tbp == GS_VRAM_INVALID) {
+        g_vram_state.stats.bind_misses++;
+        return gs_vram_texture_upload(id, texture->data, texture->width, texture->height, texture->psm);
+    }
+
+    return texture->tbp;
+}
+
+void gs_vram_texture_pin(GSTextureId id, bool pinned) {
+    if (id >= GS_TEXTURE_COUNT) return;
+    g_vram_state.textures[id].pinned = pinned;
+}
+
+// Release a texture's VRAM; it stays registered so a bind can restore it
+void gs_vram_texture_evict(GSTextureId id) {
+    if (!g_vram_state.initialized || id >= GS_TEXTURE_COUNT) return;
+
+    GSVramTexture* texture = &g_vram_state.textures[id];
+    if (texture->tbp == GS_VRAM_INVALID) return;
+
+    gs_vram_free(texture->tbp);
+    texture->tbp = GS_VRAM_INVALID;
+}
+
+// Evict and forget a texture whose source is going away
+void gs_vram_texture_release(GSTextureId id) {
+    if (!g_vram_state.initialized || id >= GS_TEXTURE_COUNT) return;
+
+    gs_vram_texture_evict(id);
+    memset(&g_vram_state.textures[id], 0, sizeof(GSVramTexture));
+    g_vram_state.textures[id].tbp = GS_VRAM_INVALID;
+}
+
+// Advance the LRU clock (once per displayed frame)
+void gs_vram_next_frame(void) {
+    g_vram_state.frame++;
+}
+
+void gs_vram_get_stats(GSVramStats* stats) {
+    if (!stats) return;
+
+    *stats = g_vram_state.stats;
+    stats->free_pages = 0;
+    stats->largest_free_pages = 0;
+    stats->resident_textures = 0;
+
+    u32 run = 0;
+    for (u32 page = 0; page < GS_VRAM_PAGE_COUNT; page++) {
+        if (g_vram_state.page_map[page] == 0) {
+            stats->free_pages++;
+            run++;
+            stats->largest_free_pages = MAX(stats->largest_free_pages, run);
+        } else {
+            run = 0;
+        }
+    }
+
+    for (u32 i = 0; i < GS_TEXTURE_COUNT; i++) {
+        if (g_vram_state.textures[i].tbp != GS_VRAM_INVALID) stats->resident_textures++;
+    }
+}
@@ -45,33 +45,46 @@ static int g_hardware_detected = 0;
  * Detect PS2 console model from BIOS information
  */
 static void detect_console_model(void) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    // Read ROM version string
+    // ROMVER reads e.g. "0160EC20010704": BIOS version, region, console
+    // type (C retail, D development unit) and build date
     char rom_version[16];
+    memset(rom_version, 0, sizeof(rom_version));
     GetRomName(rom_version);
+    u32 version = 0;
+    for (int i = 0; i < 4 && rom_version[i] >= '0' && rom_version[i] <= '9'; i++) {
+        version = (version << 4) | (u32)(rom_version[i] - '0');
+    }
+    g_hardware_info.bios_version = version;
     
-    // Parse model information from ROM version
-    if (strncmp(rom_version, "SCPH-10000", 10) == 0) {
+    // Parse model information from the BIOS version
+    if (version == 0) {
+        strcpy(g_hardware_info.model_name, "PlayStation 2 (Unknown)");
+        g_hardware_info.console_type = 0xFF;
+    } else if (version < 0x0150) {
+        // SCPH-10000 to 18000
         strcpy(g_hardware_info.model_name, "PlayStation 2 (Original)");
         g_hardware_info.console_type = 0;
-    } else if (strncmp(rom_version, "SCPH-3", 6) == 0) {
+    } else if (version < 0x0190) {
+        // SCPH-30000 to 50000
         strcpy(g_hardware_info.model_name, "PlayStation 2 (V-Series)");
         g_hardware_info.console_type = 1;
-    } else if (strncmp(rom_version, "SCPH-7", 6) == 0 || strncmp(rom_version, "SCPH-9", 6) == 0) {
+    } else {
+        // SCPH-70000 and later
         strcpy(g_hardware_info.model_name, "PlayStation 2 (Slim)");
         g_hardware_info.console_type = 2;
         g_hardware_info.capabilities |= HW_CAP_SLIM_MODEL;
-    } else {
-        strcpy(g_hardware_info.model_name, "PlayStation 2 (Unknown)");
-        g_hardware_info.console_type = 0xFF;
+    }
+    
+    if (rom_version[5] == 'D') {
+        g_hardware_info.capabilities |= HW_CAP_DEV_UNIT;
     }
     
     // Detect region from ROM version
-    if (strstr(rom_version, "J") != NULL) {
+    if (rom_version[4] == 'J') {
         strcpy(g_hardware_info.region, "NTSC-J");
-    } else if (strstr(rom_version, "A") != NULL) {
+    } else if (rom_version[4] == 'A') {
         strcpy(g_hardware_info.region, "NTSC-U");
-    } else if (strstr(rom_version, "E") != NULL) {
+    } else if (rom_version[4] == 'E') {
         strcpy(g_hardware_info.region, "PAL");
     } else {
         strcpy(g_hardware_info.region, "Unknown");
@@ -130,7 +143,7 @@ static u32 detect_iop_revision(void) {
  * Detect hardware capabilities (Network Adapter, HDD, USB, etc.)
  */
 static void detect_capabilities(void) {
-    g_hardware_info.capabilities = 0;
+    // Keeps the model flags detect_console_model() set
     
     // COMPLETE IMPLEMENTATION - Full functionality
     // Check for Network Adapter (DEV9)
@@ -264,6 +277,13 @@ int hardware_is_slim_model(void) {
     return hardware_has_capability(HW_CAP_SLIM_MODEL);
 }
 
+/**
+ * Check if this is a development unit (DTL-T TOOL or TEST)
+ */
+int hardware_is_dev_unit(void) {
+    return hardware_has_capability(HW_CAP_DEV_UNIT);
+}
+
 /**
  * Check if Network Adapter is available
  */
@@ -0,0 +1,326 @@
+/*
+ * SPLATSTORM X - Hardware Profiles
+ * Engine defaults per console class, chosen at boot from what
+ * hardware_detection.c finds:
+ *   - devkit    development units (ROMVER console type D)
+ *   - slim      SCPH-70000 and later: no HDD bay
+ *   - fat_hdd   fat consoles booted from the HDD, or with one detected
+ *   - fat       other fat consoles
+ *   - emulator  override only: emulators report a retail BIOS
+ * A profile sets the memory budget sizes, the VU1 render path and program,
+ * the scene cache device order (also the devices the I/O worker prefetches),
+ * the starting render resolution and field mode, and the splat budgets.
+ * Until numbers measured on each console class tell them apart, the
+ * classes differ only in their storage order.
+ *
+ * HARDWARE_PROFILE_CONFIG_FILE in the ELF's directory overrides them, one
+ * option per line. Lines before any [<profile>] section apply to every
+ * profile; lines in a section only to that one. profile=<name>, at the top
+ * level or on the command line, skips detection.
+ *   pool=<budget>:<KB>         a memory budget, named as memory_budget_print names it
+ *   vu=download|xgkick         VU1 render path
+ *   microcode=auto|<name>|<n>  auto-tune the VU1 program, or always use one
+ *   storage=<dev>[,<dev>...]   hdd, usb, mc: scene cache and prefetch order
+ *   resolution=<level>         g_resolution_levels entry to start at
+ *   field=0|1                  field rendering
+ *   splats=<n>                 visible splats drawn per frame
+ *   load_splats=<n>            splats kept at load, 0 keeps all
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include "iop_modules.h"
+#include <tamtypes.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#define PROFILE_DEFAULT_POOLS { MEMORY_BUDGET_SCENE_SIZE, MEMORY_BUDGET_FRAME_SIZE, MEMORY_BUDGET_DMA_SIZE, \
+                                MEMORY_BUDGET_ASSET_SIZE, MEMORY_BUDGET_DEBUG_SIZE }
+
+// Storage names the config uses, and their device prefixes
+static const char* const g_storage_names[][2] = {
+    {"hdd", "pfs0:"}, {"usb", "mass:"}, {"mc", "mc0:"}
+};
+#define PROFILE_STORAGE_NAMES (sizeof(g_storage_names) / sizeof(g_storage_names[0]))
+
+// Every class starts from the same settings: only the storage order
+// follows what the class has. Measured numbers from each class replace these.
+#define PROFILE_DEFAULT_SETTINGS \
+    .pool_sizes = PROFILE_DEFAULT_POOLS, \
+    .vu_render_mode = VU_RENDER_MODE_DOWNLOAD, \
+    .vu_microcode = VU1_MICROCODE_DEFAULT, \
+    .vu_autotune = true, \
+    .resolution_level = 0, \
+    .field_rendering = true, \
+    .max_splats = 10000, \
+    .load_splat_budget = SCENE_LOAD_SPLAT_BUDGET
+
+static const HardwareProfile g_default_profiles[HARDWARE_PROFILE_COUNT] = {
+    [HARDWARE_PROFILE_FAT] = {
+        .name = "fat",
+        PROFILE_DEFAULT_SETTINGS,
+        .storage = {"mass:", "mc0:", "pfs0:"},
+        .storage_count = 3,
+    },
+    [HARDWARE_PROFILE_FAT_HDD] = {
+        .name = "fat_hdd",
+        PROFILE_DEFAULT_SETTINGS,
+        .storage = {"pfs0:", "mass:", "mc0:"},
+        .storage_count = 3,
+    },
+    // No expansion bay: the HDD drivers are never worth loading
+    [HARDWARE_PROFILE_SLIM] = {
+        .name = "slim",
+        PROFILE_DEFAULT_SETTINGS,
+        .storage = {"mass:", "mc0:"},
+        .storage_count = 2,
+    },
+    // TOOL units have the HDD bay
+    [HARDWARE_PROFILE_DEVKIT] = {
+        .name = "devkit",
+        PROFILE_DEFAULT_SETTINGS,
+        .storage = {"pfs0:", "mass:", "mc0:"},
+        .storage_count = 3,
+    },
+    // Emulators have no HDD to cache on
+    [HARDWARE_PROFILE_EMULATOR] = {
+        .name = "emulator",
+        PROFILE_DEFAULT_SETTINGS,
+        .storage = {"mass:", "mc0:"},
+        .storage_count = 2,
+    },
+};
+
+static struct {
+    HardwareProfile profile;
+    HardwareProfileId id;
+    bool detected;                            // Chosen by detection, not named
+    bool selected;
+    u32 overrides;                            // Config options applied
+} g_hw_profile = {0};
+
+static HardwareProfileId hardware_profile_find(const char* name) {
+    for (u32 p = 0; p < HARDWARE_PROFILE_COUNT; p++) {
+        if (strcmp(name, g_default_profiles[p].name) == 0) {
+            return (HardwareProfileId)p;
+        }
+    }
+    return HARDWARE_PROFILE_COUNT;
+}
+
+// What the console is, when nothing names a profile
+static HardwareProfileId hardware_profile_detect(const char* boot_path) {
+    hardware_detect_capabilities();
+
+    if (hardware_is_dev_unit()) {
+        return HARDWARE_PROFILE_DEVKIT;
+    }
+    if (hardware_is_slim_model()) {
+        return HARDWARE_PROFILE_SLIM;
+    }
+    if (hardware_has_hdd() || (boot_path && get_boot_device(boot_path) == IOP_DEVICE_HDD)) {
+        return HARDWARE_PROFILE_FAT_HDD;
+    }
+    return HARDWARE_PROFILE_FAT;
+}
+
+// storage=<dev>[,<dev>...], replacing the profile's order
+static bool hardware_profile_parse_storage(HardwareProfile* profile, const char* list) {
+    const char* storage[HARDWARE_PROFILE_STORAGE_MAX];
+    u32 count = 0;
+
+    while (*list) {
+        u32 length = (u32)strcspn(list, ",");
+        u32 s = 0;
+        while (s < PROFILE_STORAGE_NAMES &&
+               (strlen(g_storage_names[s][0]) != length || strncmp(list, g_storage_names[s][0], length) != 0)) {
+            s++;
+        }
+        if (s == PROFILE_STORAGE_NAMES || count == HARDWARE_PROFILE_STORAGE_MAX) {
+            return false;
+        }
+        storage[count++] = g_storage_names[s][1];
+        list += length;
+        if (*list == ',') list++;
+    }
+    if (count == 0) return false;
+
+    memcpy(profile->storage, storage, count * sizeof(storage[0]));
+    profile->storage_count = count;
+    return true;
+}
+
+// One config option onto a profile; false when it is not one
+static bool hardware_profile_parse_option(HardwareProfile* profile, const char* option) {
+    if (strncmp(option, "pool=", 5) == 0) {
+        const char* separator = strchr(option + 5, ':');
+        if (!separator) return false;
+        MemoryBudgetClass budget = memory_budget_find(option + 5, (u32)(separator - (option + 5)));
+        u32 kb = (u32)atoi(separator + 1);
+        if (budget == MEMORY_BUDGET_COUNT || kb == 0) return false;
+        profile->pool_sizes[budget] = kb * 1024;
+    } else if (strcmp(option, "vu=download") == 0) {
+        profile->vu_render_mode = VU_RENDER_MODE_DOWNLOAD;
+    } else if (strcmp(option, "vu=xgkick") == 0) {
+        profile->vu_render_mode = VU_RENDER_MODE_XGKICK;
+    } else if (strcmp(option, "microcode=auto") == 0) {
+        profile->vu_autotune = true;
+    } else if (strncmp(option, "microcode=", 10) == 0) {
+        // A number must be all digits: "3abc" is neither a number nor a name
+        u32 variant = VU1_MICROCODE_VARIANT_COUNT;
+        if (isdigit((unsigned char)option[10])) {
+            char* end;
+            long number = strtol(option + 10, &end, 10);
+            if (*end == '\0' && number < VU1_MICROCODE_VARIANT_COUNT) {
+                variant = (u32)number;
+            }
+        } else {
+            variant = vu_find_microcode_variant(option + 10);
+        }
+        if (variant >= VU1_MICROCODE_VARIANT_COUNT) return false;
+        profile->vu_microcode = variant;
+        profile->vu_autotune = false;
+    } else if (strncmp(option, "storage=", 8) == 0) {
+        return hardware_profile_parse_storage(profile, option + 8);
+    } else if (strncmp(option, "resolution=", 11) == 0) {
+        profile->resolution_level = (u32)atoi(option + 11);
+    } else if (strncmp(option, "field=", 6) == 0) {
+        profile->field_rendering = atoi(option + 6) != 0;
+    } else if (strncmp(option, "splats=", 7) == 0) {
+        profile->max_splats = (u32)atoi(option + 7);
+    } else if (strncmp(option, "load_splats=", 12) == 0) {
+        profile->load_splat_budget = (u32)atoi(option + 12);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Open HARDWARE_PROFILE_CONFIG_FILE from the directory of the ELF
+static FILE* hardware_profile_open_config(const char* boot_path, char* config_path, u32 path_size) {
+    if (!boot_path) return NULL;
+
+    // Directory: everything up to the last separator
+    u32 dir_length = 0;
+    for (u32 i = 0; boot_path[i] && i < path_size - 16; i++) {
+        if (boot_path[i] == '/' || boot_path[i] == '\\' || boot_path[i] == ':') {
+            dir_length = i + 1;
+        }
+    }
+    memcpy(config_path, boot_path, dir_length);
+    config_path[dir_length] = '\0';
+    strcat(config_path, HARDWARE_PROFILE_CONFIG_FILE);
+    if (strncmp(boot_path, "cdrom", 5) == 0) {
+        strcat(config_path, ";1");  // ISO 9660 version suffix
+    }
+
+    if (iop_require_path(config_path) < 0) return NULL;
+    return fopen(config_path, "r");
+}
+
+// Top-level profile=<name> of the config file, or HARDWARE_PROFILE_COUNT
+static HardwareProfileId hardware_profile_config_name(FILE* file) {
+    HardwareProfileId id = HARDWARE_PROFILE_COUNT;
+    char line[96];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '[') break;
+        if (strncmp(line, "profile=", 8) == 0) {
+            id = hardware_profile_find(line + 8);
+        }
+    }
+    rewind(file);
+    return id;
+}
+
+// Apply the top-level lines and the selected profile's section
+static u32 hardware_profile_apply_config(FILE* file, const char* config_path) {
+    u32 applied = 0;
+    bool in_section = true;
+    char line[96];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+
+        if (line[0] == '[') {
+            char* end = strchr(line, ']');
+            if (end) *end = '\0';
+            in_section = strcmp(line + 1, g_hw_profile.profile.name) == 0;
+            continue;
+        }
+        if (!in_section || strncmp(line, "profile=", 8) == 0) continue;
+
+        if (hardware_profile_parse_option(&g_hw_profile.profile, line)) {
+            applied++;
+        } else {
+            debug_log_warning("Profile: unknown option '%s' in %s", line, config_path);
+        }
+    }
+    return applied;
+}
+
+/*
+ * Choose the profile for this boot: the one forced names, else the config
+ * file's profile=, else the detected one; then apply the config overrides.
+ * Needs the IOP device drivers, so it runs after IOP init.
+ */
+const HardwareProfile* hardware_profile_select(const char* boot_path, const char* forced) {
+    char config_path[96];
+    FILE* file = hardware_profile_open_config(boot_path, config_path, sizeof(config_path));
+
+    HardwareProfileId id = HARDWARE_PROFILE_COUNT;
+    if (forced) {
+        id = hardware_profile_find(forced);
+        if (id == HARDWARE_PROFILE_COUNT) {
+            printf("SPLATSTORM X: Unknown hardware profile %s, detecting\n", forced);
+        }
+    }
+    if (id == HARDWARE_PROFILE_COUNT && file) {
+        id = hardware_profile_config_name(file);
+    }
+    g_hw_profile.detected = (id == HARDWARE_PROFILE_COUNT);
+    if (g_hw_profile.detected) {
+        id = hardware_profile_detect(boot_path);
+    }
+
+    g_hw_profile.id = id;
+    g_hw_profile.profile = g_default_profiles[id];
+    g_hw_profile.overrides = 0;
+    if (file) {
+        g_hw_profile.overrides = hardware_profile_apply_config(file, config_path);
+        fclose(file);
+    }
+    g_hw_profile.selected = true;
+
+    const HardwareProfile* profile = &g_hw_profile.profile;
+    printf("SPLATSTORM X: Hardware profile %s (%s, %u overrides): %u splats, %s%s, VU1 program %s, cache on %s\n",
+           profile->name, g_hw_profile.detected ? "detected" : "named", g_hw_profile.overrides, profile->max_splats,
+           profile->field_rendering ? "field" : "frame",
+           profile->vu_render_mode == VU_RENDER_MODE_XGKICK ? ", VU1 XGKICK" : "",
+           profile->vu_autotune ? "auto-tuned" : "fixed", profile->storage[0]);
+    return profile;
+}
+
+// The profile in use; the fat console's defaults before one is selected
+const HardwareProfile* hardware_profile_get(void) {
+    return g_hw_profile.selected ? &g_hw_profile.profile : &g_default_profiles[HARDWARE_PROFILE_FAT];
+}
+
+HardwareProfileId hardware_profile_id(void) {
+    return g_hw_profile.selected ? g_hw_profile.id : HARDWARE_PROFILE_FAT;
+}
+
+// IOP device classes of the profile's storage, for iop_prefetch_devices()
+u32 hardware_profile_storage_mask(void) {
+    const HardwareProfile* profile = hardware_profile_get();
+    u32 mask = 0;
+    for (u32 s = 0; s < profile->storage_count; s++) {
+        int device = get_boot_device(profile->storage[s]);
+        if (device >= 0) {
+            mask |= IOP_DEVICE_BIT(device);
+        }
+    }
+    return mask;
+}
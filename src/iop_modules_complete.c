@@ -5,6 +5,12 @@
  * Based on iop_modules.h requirements and PS2 IOP system
  * Implements: Module loading (8), Device management (4), System integration (3),
  *            Graphics hardware (3), Debug system (5), Utility functions (9)
+ *
+ * Boot loads only iomanX, fileXio, the pad drivers and the boot device's
+ * stack. Every other device class (USB mass, HDD, memory card, network,
+ * USB input, audio) loads the first time something asks for it, or on the
+ * I/O worker when boot prefetches it, so the IOP links modules while the
+ * EE sets up LUTs and VRAM.
  */
 
 #include "splatstorm_x.h"
@@ -73,6 +79,35 @@ static struct {
     char name[32];
 } g_module_status[32] = {0};
 
+// Device class load states
+#define IOP_CLASS_DEFERRED 0                  // Loads on first use
+#define IOP_CLASS_QUEUED   1                  // Posted to the I/O worker
+#define IOP_CLASS_READY    2
+#define IOP_CLASS_FAILED   3                  // Driver refused to start, e.g. no drive attached
+
+// On-demand device drivers. Drivers shared by several classes (DEV9,
+// SIO2MAN, USBD) start with whichever class needs them first.
+static struct {
+    const char* boot_path;                    // argv[0]: its device loads at boot
+    volatile u8 state[IOP_DEVICE_CLASSES];    // IOP_CLASS_*
+    u32 load_time_ms[IOP_DEVICE_CLASSES];
+
+    // Background loads: the render thread advances posted, the worker done
+    volatile u32 prefetch_posted;
+    volatile u32 prefetch_done;
+
+    // Drivers without a module flag of their own
+    bool iomanx_started;
+    bool bdmfs_started;
+    bool atad_started;
+    bool pfs_started;
+    bool mcserv_started;
+} g_iop_devices = {0};
+
+static const char* const g_iop_device_names[IOP_DEVICE_CLASSES] = {
+    "CD/DVD", "USB mass", "HDD", "Memory card", "Network", "Pads", "USB input", "Audio"
+};
+
 // ULTRA COMPLETE HARDWARE DETECTION STATE - ENHANCED STRUCTURE
 static struct {
     bool capabilities_detected;
@@ -140,12 +175,17 @@ static struct {
 
 // Forward declarations
 static int load_core_modules(void);
-static int load_optional_modules(void);
+static int load_boot_device_modules(void);
 static int verify_module_dependencies(void);
 static void update_module_status(int module_id, bool loaded, const char* name);
 static int detect_hardware_capabilities_internal(void);
 
 // Debug function implementations - COMPLETE IMPLEMENTATION (moved before usage)
+// One formatted log line out, posted to the I/O worker
+static void debug_log_file_job(void* line) {
+    printf("%s\n", (const char*)line);
+}
+
 static void debug_write_to_log_file(const char* level, const char* message, u64 timestamp) {
     // File logging implementation - complete functionality
     if (!g_debug_state.file_logging_enabled) return;
@@ -154,9 +194,12 @@ static void debug_write_to_log_file(const char* level, const char* message, u64
     u32 seconds = (u32)(timestamp / 294912000ULL);  // Convert cycles to seconds
     u32 milliseconds = (u32)((timestamp % 294912000ULL) * 1000 / 294912000ULL);
     
-    // Log file writing would go here in a real implementation
-    // For now, we'll use printf as a placeholder
-    printf("[%u.%03u] %s: %s\n", seconds, milliseconds, level, message);
+    // The write itself happens on the I/O worker; a full queue writes inline
+    char line[WORKER_JOB_PAYLOAD];
+    snprintf(line, sizeof(line), "[%u.%03u] %s: %s", seconds, milliseconds, level, message);
+    if (!worker_post_job(debug_log_file_job, NULL, line, strlen(line) + 1)) {
+        debug_log_file_job(line);
+    }
 }
 
 static void debug_check_log_memory_usage(void) {
@@ -207,8 +250,8 @@ static void debug_capture_warning_context(const char* message, u64 timestamp) {
 }
 
 static void debug_flush_all_log_files(void) {
-    // Log file flushing - complete functionality
-    // File flushing implementation would go here
+    // Log lines still queued for the I/O worker
+    worker_flush();
 }
 
 static void debug_cleanup_log_buffers(void) {
@@ -239,9 +282,9 @@ int get_boot_device(const char* path) {
     // Analyze path to determine boot device
     if (strncmp(path, "cdrom0:", 7) == 0 || strncmp(path, "cdfs:", 5) == 0) {
         return 0; // CD-ROM
-    } else if (strncmp(path, "mass:", 5) == 0 || strncmp(path, "usb:", 4) == 0) {
+    } else if (strncmp(path, "mass", 4) == 0 || strncmp(path, "usb:", 4) == 0) {
         return 1; // USB mass storage
-    } else if (strncmp(path, "hdd0:", 5) == 0 || strncmp(path, "pfs:", 4) == 0) {
+    } else if (strncmp(path, "hdd0:", 5) == 0 || strncmp(path, "pfs", 3) == 0) {
         return 2; // Hard disk
     } else if (strncmp(path, "mc0:", 4) == 0 || strncmp(path, "mc1:", 4) == 0) {
         return 3; // Memory card
@@ -358,6 +401,9 @@ int load_enhanced_module(int id) {
     
     u64 end_time = get_cpu_cycles();
     u32 load_time_ms = (u32)cycles_to_ms(end_time - start_time);
+    if (strcmp(module_name, "unknown") != 0) {
+        boot_profile_event(module_name, BOOT_EVENT_IRX, start_time, end_time);  // Named once it loaded
+    }
     
     if (result >= 0) {
         g_iop_state.loaded_module_count++;
@@ -506,6 +552,7 @@ void prepare_IOP_enhanced(void) {
     
     // Reset IOP
     printf("IOP: Resetting IOP...\n");
+    u64 reset_start = get_cpu_cycles();
     SifIopReset("", 0);
     
     // Wait for IOP reset to complete
@@ -513,6 +560,7 @@ void prepare_IOP_enhanced(void) {
         // Wait
     }
     g_iop_state.iop_reset_done = true;
+    boot_profile_event("IOP reset", BOOT_EVENT_PHASE, reset_start, get_cpu_cycles());
     
     // Initialize SIF
     printf("IOP: Initializing SIF...\n");
@@ -605,6 +653,12 @@ void unload_all_modules(void) {
     g_iop_state.loaded_module_count = 0;
     g_iop_state.modules_loaded = false;
     
+    // Device classes load again on next use, shared drivers included
+    iop_wait_prefetch();
+    const char* boot_path = g_iop_devices.boot_path;
+    memset(&g_iop_devices, 0, sizeof(g_iop_devices));
+    g_iop_devices.boot_path = boot_path;
+    
     printf("IOP: All modules unloaded\n");
 }
 
@@ -639,9 +693,9 @@ int iop_init_enhanced_modules(void) {
         return result;
     }
     
-    result = load_optional_modules();
+    result = load_boot_device_modules();
     if (result < 0) {
-        printf("IOP WARNING: Some optional modules failed to load\n");
+        printf("IOP WARNING: Boot device drivers failed to load\n");
         // Continue anyway
     }
     
@@ -821,6 +875,13 @@ void iop_print_module_status(void) {
     printf("    CD-ROM: %s\n", cdfs_started ? "Loaded" : "Not loaded");
     printf("    Hard Disk: %s\n", hdd_started ? "Loaded" : "Not loaded");
     printf("    FileXIO: %s\n", filexio_started ? "Loaded" : "Not loaded");
+    
+    static const char* const states[] = {"Deferred", "Loading", "Ready", "Failed"};
+    printf("  Device classes:\n");
+    for (int c = 0; c < IOP_DEVICE_CLASSES; c++) {
+        printf("    %s: %s (%u ms)\n", g_iop_device_names[c], states[g_iop_devices.state[c]],
+               g_iop_devices.load_time_ms[c]);
+    }
 }
 
 // Reload module - COMPLETE IMPLEMENTATION
@@ -847,6 +908,213 @@ int iop_get_module_memory_usage(int id) {
     return g_module_status[id].memory_usage;
 }
 
+/*
+ * ON-DEMAND DEVICE DRIVERS
+ */
+
+// Start one driver unless it already runs: an embedded IRX when irx is
+// set, a ROM module otherwise. A driver that exits at once (NO_RESIDENT_END,
+// e.g. ps2atad with no drive attached) counts as failed.
+static int iop_start_driver(int module_id, const char* name, const char* rom_path,
+                            unsigned char* irx, unsigned int irx_size, bool* started) {
+    if (*started) {
+        return 0;
+    }
+    
+    int module_result = 0;
+    u64 start_time = get_cpu_cycles();
+    int result = irx ? SifExecModuleBuffer(irx, irx_size, 0, NULL, &module_result)
+                     : SifLoadModule(rom_path, 0, NULL);
+    boot_profile_event(name, BOOT_EVENT_IRX, start_time, get_cpu_cycles());
+    if (result < 0 || module_result == 1) {
+        g_iop_state.failed_module_count++;
+        printf("IOP: %s not started (result=%d, module=%d)\n", name, result, module_result);
+        return (result < 0) ? result : -1;
+    }
+    
+    *started = true;
+    g_iop_state.loaded_module_count++;
+    update_module_status(module_id, true, name);
+    return 0;
+}
+
+// Start every driver a device class needs, dependencies first
+static int iop_load_device_class(int device_class) {
+    int result = 0;
+    
+    switch (device_class) {
+        case IOP_DEVICE_CDROM:
+            // cdrom0: is served by the BIOS CDVDMAN; nothing to load
+            cdfs_started = true;
+            break;
+            
+        case IOP_DEVICE_USB_MASS:
+            result = iop_start_driver(USBD_MODULE, "usbd", NULL, usbd_irx, size_usbd_irx, &usbd_started);
+            if (result >= 0) {
+                result = iop_start_driver(BDM_MODULE, "bdm", NULL, bdm_irx, size_bdm_irx, &bdm_started);
+            }
+            if (result >= 0) {
+                result = iop_start_driver(-1, "bdmfs_fatfs", NULL, bdmfs_fatfs_irx, size_bdmfs_fatfs_irx,
+                                          &g_iop_devices.bdmfs_started);
+            }
+            if (result >= 0) {
+                result = iop_start_driver(USB_MASS_MODULE, "usbmass_bd", NULL, usbmass_bd_irx, size_usbmass_bd_irx,
+                                          &usb_mass_started);
+            }
+            break;
+            
+        case IOP_DEVICE_HDD:
+            result = iop_start_driver(DEV9_MODULE, "ps2dev9", NULL, ps2dev9_irx, size_ps2dev9_irx, &dev9_started);
+            if (result >= 0) {
+                result = iop_start_driver(-1, "ps2atad", NULL, ps2atad_irx, size_ps2atad_irx,
+                                          &g_iop_devices.atad_started);
+            }
+            if (result >= 0) {
+                result = iop_start_driver(HDD_MODULE, "ps2hdd", NULL, ps2hdd_irx, size_ps2hdd_irx, &hdd_started);
+            }
+            if (result >= 0) {
+                result = iop_start_driver(-1, "ps2fs", NULL, ps2fs_irx, size_ps2fs_irx, &g_iop_devices.pfs_started);
+            }
+            HDD_USABLE = (result >= 0);
+            break;
+            
+        case IOP_DEVICE_MEMCARD:
+            result = iop_start_driver(SIO2MAN_MODULE, "SIO2MAN", "rom0:SIO2MAN", NULL, 0, &sio2man_started);
+            if (result >= 0) {
+                result = iop_start_driver(MC_MODULE, "MCMAN", "rom0:MCMAN", NULL, 0, &mc_started);
+            }
+            if (result >= 0) {
+                result = iop_start_driver(-1, "MCSERV", "rom0:MCSERV", NULL, 0, &g_iop_devices.mcserv_started);
+            }
+            break;
+            
+        case IOP_DEVICE_HOST:
+            result = iop_start_driver(DEV9_MODULE, "ps2dev9", NULL, ps2dev9_irx, size_ps2dev9_irx, &dev9_started);
+            if (result >= 0 && !network_started) {
+                result = load_enhanced_module(NETWORK_MODULE);
+            }
+            break;
+            
+        case IOP_DEVICE_PADS:
+            result = iop_start_driver(SIO2MAN_MODULE, "SIO2MAN", "rom0:SIO2MAN", NULL, 0, &sio2man_started);
+            if (result >= 0) {
+                result = iop_start_driver(PADS_MODULE, "PADMAN", "rom0:PADMAN", NULL, 0, &pads_started);
+            }
+            break;
+            
+        case IOP_DEVICE_USB_INPUT:
+            result = iop_start_driver(USBD_MODULE, "usbd", NULL, usbd_irx, size_usbd_irx, &usbd_started);
+            if (result >= 0) {
+                // Either device is enough
+                if (!kbd_started) load_enhanced_module(KEYBOARD_MODULE);
+                if (!mouse_started) load_enhanced_module(MOUSE_MODULE);
+                result = (kbd_started || mouse_started) ? 0 : -1;
+            }
+            break;
+            
+        case IOP_DEVICE_AUDIO:
+            result = audio_started ? 0 : iop_load_audio_system();
+            break;
+            
+        default:
+            return -1;
+    }
+    
+    return result;
+}
+
+// Load a class on the calling thread and record the outcome
+static int iop_load_device_class_now(int device_class) {
+    u64 start_time = get_cpu_cycles();
+    int result = iop_load_device_class(device_class);
+    g_iop_devices.load_time_ms[device_class] = (u32)cycles_to_ms(get_cpu_cycles() - start_time);
+    g_iop_devices.state[device_class] = (result >= 0) ? IOP_CLASS_READY : IOP_CLASS_FAILED;
+    
+    printf("IOP: %s drivers %s in %u ms\n", g_iop_device_names[device_class],
+           (result >= 0) ? "loaded" : "unavailable", g_iop_devices.load_time_ms[device_class]);
+    return result;
+}
+
+// The device of this path loads with the core modules
+void iop_set_boot_path(const char* path) {
+    g_iop_devices.boot_path = path;
+}
+
+// Make a device class usable, loading its drivers now if nothing has yet.
+// A class that failed once is not retried. Call from the render thread.
+int iop_require_device(int device_class) {
+    if (device_class < 0 || device_class >= IOP_DEVICE_CLASSES) {
+        return -1;
+    }
+    
+    // LOADFILE RPCs cannot overlap, and background classes may share drivers
+    // with this one: let them finish first
+    iop_wait_prefetch();
+    
+    if (g_iop_devices.state[device_class] == IOP_CLASS_READY) {
+        return 0;
+    }
+    if (g_iop_devices.state[device_class] == IOP_CLASS_FAILED) {
+        return -1;
+    }
+    return iop_load_device_class_now(device_class);
+}
+
+// iop_require_device() for the device a path names; paths without a known
+// device prefix need nothing
+int iop_require_path(const char* path) {
+    int device_class = get_boot_device(path);
+    return (device_class < 0) ? 0 : iop_require_device(device_class);
+}
+
+// True once a class's drivers run; never waits
+bool iop_device_ready(int device_class) {
+    return device_class >= 0 && device_class < IOP_DEVICE_CLASSES &&
+           g_iop_devices.state[device_class] == IOP_CLASS_READY;
+}
+
+static void iop_prefetch_job(void* payload) {
+    int device_class = *(const int*)payload;
+    if (g_iop_devices.state[device_class] == IOP_CLASS_QUEUED) {
+        iop_load_device_class_now(device_class);
+    }
+    g_iop_devices.prefetch_done++;
+}
+
+// Load deferred classes on the I/O worker: each job sleeps in a LOADFILE
+// RPC while the IOP links the modules, so the render thread keeps running.
+// Returns the number of classes posted; classes the queue refuses stay
+// deferred. Without worker threads they load here.
+u32 iop_prefetch_devices(u32 class_mask) {
+    u32 posted = 0;
+    
+    for (int c = 0; c < IOP_DEVICE_CLASSES; c++) {
+        if (!(class_mask & IOP_DEVICE_BIT(c)) || g_iop_devices.state[c] != IOP_CLASS_DEFERRED) {
+            continue;
+        }
+        
+        g_iop_devices.state[c] = IOP_CLASS_QUEUED;
+        g_iop_devices.prefetch_posted++;
+        if (!worker_post_job(iop_prefetch_job, NULL, &c, sizeof(c))) {
+            g_iop_devices.prefetch_posted--;
+            g_iop_devices.state[c] = IOP_CLASS_DEFERRED;
+            continue;
+        }
+        posted++;
+    }
+    
+    return posted;
+}
+
+// Wait for background class loads; true if any was still running
+bool iop_wait_prefetch(void) {
+    if (g_iop_devices.prefetch_done == g_iop_devices.prefetch_posted) {
+        return false;
+    }
+    worker_flush();
+    return true;
+}
+
 /*
  * HARDWARE DETECTION FUNCTIONS - COMPLETE IMPLEMENTATIONS
  */
@@ -1265,34 +1533,37 @@ void hardware_detection_shutdown(void) {
  * INTERNAL HELPER FUNCTIONS - COMPLETE IMPLEMENTATIONS
  */
 
-// Load core modules
+// Load core modules: file I/O and the pads, which every boot uses
 static int load_core_modules(void) {
     printf("IOP: Loading core modules...\n");
     
-    int loaded = 0;
+    int result = iop_start_driver(-1, "iomanX", NULL, iomanX_irx, size_iomanX_irx, &g_iop_devices.iomanx_started);
+    if (result >= 0) {
+        result = iop_start_driver(FILEXIO_MODULE, "fileXio", NULL, fileXio_irx, size_fileXio_irx, &filexio_started);
+    }
+    if (result < 0) {
+        return result;
+    }
     
-    // Load essential modules
-    if (load_enhanced_module(FREERAM_MODULE) >= 0) loaded++;
-    if (load_enhanced_module(USBD_MODULE) >= 0) loaded++;
-    if (load_enhanced_module(FILEXIO_MODULE) >= 0) loaded++;
+    if (iop_require_device(IOP_DEVICE_PADS) < 0) {
+        printf("IOP WARNING: Pad drivers unavailable\n");
+    }
     
-    printf("IOP: Core modules loaded: %d\n", loaded);
-    return (loaded > 0) ? 0 : -1;
+    printf("IOP: Core modules loaded: %u\n", g_iop_state.loaded_module_count);
+    return 0;
 }
 
-// Load optional modules
-static int load_optional_modules(void) {
-    printf("IOP: Loading optional modules...\n");
-    
-    int loaded = 0;
-    
-    // Load optional modules (failures are acceptable)
-    if (load_enhanced_module(KEYBOARD_MODULE) >= 0) loaded++;
-    if (load_enhanced_module(MOUSE_MODULE) >= 0) loaded++;
-    if (load_enhanced_module(USB_MASS_MODULE) >= 0) loaded++;
+// Load the boot device's drivers; every other class waits for first use
+static int load_boot_device_modules(void) {
+    int device_class = g_iop_devices.boot_path ? get_boot_device(g_iop_devices.boot_path) : -1;
+    if (device_class < 0) {
+        printf("IOP: Boot device unknown, all device drivers deferred\n");
+        return 0;
+    }
     
-    printf("IOP: Optional modules loaded: %d\n", loaded);
-    return 0; // Always succeed for optional modules
+    printf("IOP: Loading %s drivers for boot path %s\n", g_iop_device_names[device_class],
+           g_iop_devices.boot_path);
+    return iop_require_device(device_class);
 }
 
 // Verify module dependencies
@@ -9,14 +9,38 @@
  * - Multi-threaded processing with VU/GS parallelism
  * - Robust main loop with fallback modes
  * - Performance monitoring and adaptive quality
+ * - Frame-time controller over splat budget, resolution, SH, LOD and footprint mips
+ * - Static frame reuse: an unchanged camera and scene keep the last frame on screen
+ * - Frame pipelining: the EE culls and bins a frame while the GS draws the last one
+ * - Worker threads for pad reads and log writes, off the render thread
+ * - On-demand IOP drivers: boot loads the boot device's, the rest load on first use
+ * - Boot timeline per init phase and module load, printed and logged at the first frame
+ * - Zone profiler over the last 128 frames: p50/p95/p99 frame and stage times
+ * - EE performance counter pairs per zone in debug mode: cache misses, branches, issue, bus stalls
+ * - UDP telemetry of per-frame zone records to a host collector (telemetry=<host>[:port])
+ * - Benchmark mode: record or replay camera paths, per-frame CSV and summary (bench=...)
+ * - Projected splat capture for the host kernel benchmarks (bench_capture=...)
+ * - Tile heatmap in debug mode: splats, fill or submission cycles, hottest tiles listed
+ * - Per-channel DMA bytes, transfers and wait time each frame, in the stats and telemetry
+ * - Pipeline-state capture of one frame for offline replay (capture=<frame>:<file>)
+ * - Sampled VU0/VU1 busy time, run gaps and VIF stalls each frame (vusample=<hz>)
+ * - Per-budget frame peaks, alert levels and allocation-site high-water marks (memalert=...)
+ * - Network scenes streamed progressively from a host scene server (net:<host>[:port]/<name>)
+ * - Instanced splat assets placed with per-instance transforms (instance=<file>:<x>,<y>,<z>...)
+ * - Dynamic splats: moved or recolored ranges refit and invalidate only what they touch
+ * - Late-latched camera: sticks read again before projection, culled padded (latch=1)
+ * - Hardware profiles: pools, VU1 path, storage, resolution and splat budget per console (profile=...)
  * - Real-time debugging and visualization
  * - Memory management and resource cleanup
  */
 
 #include "splatstorm_x.h"
 #include "gaussian_types.h"
+#include "splatstorm_optimized.h"
+#include "splatstorm_debug.h"
 #include <kernel.h>
 #include <tamtypes.h>
+#include <dma.h>
 #include <sifrpc.h>
 #include <loadfile.h>
 #include <stdio.h>
@@ -28,6 +52,45 @@
 u32 splat_count = 0;  // Current number of loaded splats
 
 // System state
+// Frame clear before tile rendering
+typedef enum {
+    CLEAR_MODE_FULL,                          // Whole frame, color and depth
+    CLEAR_MODE_UNCOVERED,                     // Only tiles the splats leave see-through
+    CLEAR_MODE_NONE                           // Scene backgrounds cover the frame
+} ClearMode;
+
+// Pipeline stages the quality controller forecasts
+typedef enum {
+    QUALITY_STAGE_CULL,
+    QUALITY_STAGE_VU,
+    QUALITY_STAGE_TILE,
+    QUALITY_STAGE_GS,
+    QUALITY_STAGE_COUNT
+} QualityStage;
+
+// Knobs the quality controller turns, cheapest to give back first
+typedef enum {
+    QUALITY_KNOB_SPLATS,                      // max_splats, the visible cap: least important dropped first
+    QUALITY_KNOB_LOD,                         // quality_level: screen-space LOD threshold
+    QUALITY_KNOB_SH,                          // VU1 SH shading: full, cached, off
+    QUALITY_KNOB_MIP,                         // Footprint mip bias
+    QUALITY_KNOB_RESOLUTION,                  // g_resolution_levels entry
+    QUALITY_KNOB_COUNT
+} QualityKnob;
+
+// Frame-time controller state: per-stage forecasts and hysteresis counters
+typedef struct {
+    float stage_ms[QUALITY_STAGE_COUNT];      // Smoothed stage cost
+    float stage_trend_ms[QUALITY_STAGE_COUNT];// Smoothed change per frame
+    float other_ms;                           // Smoothed frame time outside the stages
+    float forecast_ms;                        // Frame time expected QUALITY_FORECAST_FRAMES ahead
+    u32 over_frames;                          // Consecutive frames forecast over budget
+    u32 under_frames;                         // Consecutive frames forecast well under it
+    u32 settle_frames;                        // Frames before the last change shows in the samples
+    u32 changes;                              // Knob changes made
+    bool primed;                              // Forecasts hold a first sample
+} QualityController;
+
 typedef struct {
     bool initialized;                         // System initialization status
     bool running;                             // Main loop running flag
@@ -43,18 +106,37 @@ typedef struct {
     
     // Memory pools
     u32 scene_pool_id;                        // Scene data pool
-    u32 temp_pool_id;                         // Temporary data pool
-    u32 render_pool_id;                       // Rendering data pool
+    
+    // Boot
+    const char* boot_path;                    // argv[0]; config files live beside it
+    const char* profile_name;                 // profile=<name>, NULL to detect the console
     
     // Quality settings
     float target_fps;                         // Target FPS
     float current_fps;                        // Current FPS
-    u32 max_splats;                           // Maximum splats to render
+    u32 max_splats;                           // Maximum visible splats per frame, the most important kept
+    u32 load_splat_budget;                    // Splats kept at load, 0 = all
     u32 quality_level;                        // Quality level (0-3)
     bool adaptive_quality;                    // Adaptive quality enabled
+    bool dynamic_resolution;                  // The controller may change the render size
+    bool field_rendering;                     // One half-height image per interlaced field
+    bool scene_sh;                            // Some splat has degree 1-2 SH coefficients
+    u32 resolution_level;                     // g_resolution_levels entry in use
+    QualityController quality;                // Frame-time controller
+    ClearMode clear_mode;                     // Frame clear policy
+    bool frame_reuse;                         // Present the last frame again while nothing changed
+    u32 frame_latency;                        // Frames the GS may trail the EE: 0 serial, 1 overlapped
+    bool frame_dirty;                         // Something besides the camera changed the image
+    u32 frames_reused;                        // Frames that drew nothing
+    u32 instance_revision;                    // scene_instances_revision() of the last drawn frame
+    bool late_latch;                          // Sticks read again just before projection (latch=1)
+    u64 camera_cycles;                        // When the camera last took the sticks
+    float latched_time;                       // Seconds of motion the latch applied since
+    float latch_ms;                           // Frame start to the last latch
     
     // Debug settings
     bool debug_mode;                          // Debug mode enabled
+    ProfileCounterSet counter_set;            // PCR0/PCR1 events counted in debug mode
     bool show_stats;                          // Show statistics
     bool show_wireframe;                      // Show wireframe
     u32 debug_splat_count;                    // Debug splat count
@@ -68,6 +150,47 @@ typedef struct {
 
 static SystemState g_system = {0};
 
+// Dynamic resolution render sizes, full first. Each is a whole PCRTC
+// magnification of the 640x448 display; field rendering halves the heights.
+#define RESOLUTION_LEVELS 4
+static const u16 g_resolution_levels[RESOLUTION_LEVELS][2] = {
+    {640, 448}, {512, 448}, {320, 448}, {320, 224}
+};
+
+// Quality controller tuning
+#define QUALITY_BUDGET_FRACTION 0.92f         // Share of the frame period the forecast may use
+#define QUALITY_UP_HEADROOM 0.85f             // Budget share a raised knob's forecast must stay under
+#define QUALITY_DOWN_FRAMES 2                 // Frames forecast over budget before a knob drops
+#define QUALITY_UP_FRAMES 30                  // Frames with headroom before a knob is raised
+#define QUALITY_SETTLE_FRAMES 4               // Frames a change takes to show (buffered presentation)
+#define QUALITY_FORECAST_FRAMES 2.0f          // Trend horizon of the forecast
+#define QUALITY_LEVEL_GAIN 0.5f               // Smoothing of the stage cost
+#define QUALITY_TREND_GAIN 0.25f              // Smoothing of its change per frame
+#define QUALITY_MIN_SPLATS 1000               // Splat budget floor
+#define QUALITY_MAX_SPLATS 65536              // Visible splat budget ceiling: its indices and projections fit the frame arena
+#define QUALITY_SPLAT_STEP 0.1f               // Splat budget growth per raise
+
+// Late latch: the cull frustum is this much wider in clip x and y, for the
+// turn the camera may still make before projection (2 rad/s over a frame
+// is under a tenth of the 60 degree field of view)
+#define LATE_LATCH_CULL_MARGIN 0.1f
+
+// Knobs to drop, by the stage that dominates the forecast
+static const u8 g_quality_drop_order[QUALITY_STAGE_COUNT][QUALITY_KNOB_COUNT] = {
+    [QUALITY_STAGE_CULL] = {QUALITY_KNOB_SPLATS, QUALITY_KNOB_LOD, QUALITY_KNOB_SH, QUALITY_KNOB_MIP,
+                            QUALITY_KNOB_RESOLUTION},
+    [QUALITY_STAGE_VU]   = {QUALITY_KNOB_SH, QUALITY_KNOB_SPLATS, QUALITY_KNOB_LOD, QUALITY_KNOB_MIP,
+                            QUALITY_KNOB_RESOLUTION},
+    [QUALITY_STAGE_TILE] = {QUALITY_KNOB_LOD, QUALITY_KNOB_SPLATS, QUALITY_KNOB_SH, QUALITY_KNOB_MIP,
+                            QUALITY_KNOB_RESOLUTION},
+    [QUALITY_STAGE_GS]   = {QUALITY_KNOB_RESOLUTION, QUALITY_KNOB_MIP, QUALITY_KNOB_LOD, QUALITY_KNOB_SPLATS,
+                            QUALITY_KNOB_SH},
+};
+
+static const char* const g_quality_knob_names[QUALITY_KNOB_COUNT] = {
+    "splat budget", "LOD", "SH", "footprint mip bias", "resolution"
+};
+
 // COMPLETE IMPLEMENTATION - Use centralized performance counter
 // Removed static inline version, using performance_counters.c implementation
 
@@ -81,53 +204,72 @@ void system_set_error(GaussianResult error, const char* message) {
     printf("SPLATSTORM X ERROR: %s (code: %d)\n", message, error);
 }
 
+static void apply_render_resolution(u32 level);
+
 // Initialize all systems
 GaussianResult initialize_systems(void) {
     printf("SPLATSTORM X: Initializing complete system...\n");
     
     GaussianResult result;
-    
-    // Initialize memory system first
-    result = memory_system_init();
-    if (result != GAUSSIAN_SUCCESS) {
-        system_set_error(result, "Failed to initialize memory system");
-        return result;
+    boot_profile_begin("System init");
+    
+    // Core, pad and boot device IOP drivers; other device classes load on
+    // first use. First: the hardware profile reads its config through them
+    boot_profile_phase("IOP modules");
+    if (iop_init_enhanced_modules() < 0) {
+        system_set_error(GAUSSIAN_ERROR_MODULE_LOAD_FAILED, "Failed to load IOP modules");
+        return GAUSSIAN_ERROR_MODULE_LOAD_FAILED;
     }
     
-    // Create memory pools
-    result = memory_pool_create(POOL_TYPE_FREELIST, 16 * 1024 * 1024, CACHE_LINE_SIZE, &g_system.scene_pool_id);
-    if (result != GAUSSIAN_SUCCESS) {
-        system_set_error(result, "Failed to create scene memory pool");
-        return result;
+    // Console class decides the budgets and the render defaults below
+    boot_profile_phase("Hardware profile");
+    const HardwareProfile* profile = hardware_profile_select(g_system.boot_path, g_system.profile_name);
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        memory_budget_set_size((MemoryBudgetClass)i, profile->pool_sizes[i]);
     }
+    g_system.max_splats = profile->max_splats;
+    g_system.load_splat_budget = profile->load_splat_budget;
+    g_system.field_rendering = profile->field_rendering;
     
-    result = memory_pool_create(POOL_TYPE_STACK, 8 * 1024 * 1024, CACHE_LINE_SIZE, &g_system.temp_pool_id);
+    // Memory budgets are reserved once, at the profile's sizes
+    boot_profile_phase("Memory system");
+    result = memory_system_init();
     if (result != GAUSSIAN_SUCCESS) {
-        system_set_error(result, "Failed to create temporary memory pool");
+        system_set_error(result, "Failed to initialize memory system");
         return result;
     }
     
-    result = memory_pool_create(POOL_TYPE_LINEAR, 4 * 1024 * 1024, CACHE_LINE_SIZE, &g_system.render_pool_id);
+    // Scene data lives in the scene budget
+    g_system.scene_pool_id = memory_budget_pool(MEMORY_BUDGET_SCENE);
+    
+    // Per-frame data: bump arena reset at the top of every render_frame
+    boot_profile_phase("Frame arena");
+    result = frame_arena_init(FRAME_ARENA_SIZE);
     if (result != GAUSSIAN_SUCCESS) {
-        system_set_error(result, "Failed to create render memory pool");
+        system_set_error(result, "Failed to create frame arena");
         return result;
     }
     
     // Initialize Gaussian mathematics system
-    result = gaussian_system_init(MAX_SCENE_SPLATS);
+    boot_profile_phase("Gaussian system");
+    result = gaussian_system_init(MAX_SPLATS_PER_SCENE);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize Gaussian system");
         return result;
     }
     
     // Initialize VU system
+    boot_profile_phase("VU system");
     result = vu_system_init();
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize VU system");
         return result;
     }
+    vu_set_render_mode(profile->vu_render_mode);
+    vu_set_default_microcode(profile->vu_microcode, profile->vu_autotune);
     
     // Load VU microcode
+    boot_profile_phase("VU microcode upload");
     result = vu_load_microcode();
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to load VU microcode");
@@ -135,33 +277,57 @@ GaussianResult initialize_systems(void) {
     }
     
     // Initialize DMA system
+    boot_profile_phase("DMA system");
     result = dma_system_init();
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize DMA system");
         return result;
     }
     
+    // VU0 culling engine; the culler tests on the EE if it is unavailable
+    boot_profile_phase("VU0 culling");
+    if (vu_culling_init() < 0) {
+        printf("SPLATSTORM X: VU0 culling unavailable, using EE culling\n");
+    }
+    
     // Initialize tile system
+    boot_profile_phase("Tile system");
     result = tile_system_init(MAX_SCENE_SPLATS);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize tile system");
         return result;
     }
-    
-    // Initialize GS renderer
+    tile_system_use_frame_arena(true);  // Tile bins live in the frame arena
+    tile_set_texture_order(true);       // Equal-depth splats grouped by footprint cell
+    tile_set_occlusion_culling(true);   // Octree nodes behind last frame's opaque tiles are culled
+    
+    // Initialize GS renderer; field mode draws 640x224 per field. Tiles
+    // come out depth-sorted, so no Z-buffer is needed
+    boot_profile_phase("GS init");
+    gs_renderer_set_field_rendering(g_system.field_rendering);
+    gs_renderer_set_depth_buffer(false);
+    gs_renderer_set_triple_buffering(true);  // Fits beside the half-height, Z-free buffers
     result = gs_renderer_init(640, 448, GS_PSM_32);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize GS renderer");
         return result;
     }
+    gs_renderer_set_frame_latency(g_system.frame_latency);
     
     // Initialize input system
+    boot_profile_phase("Input system");
     result = input_system_init();
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize input system");
         return result;
     }
     
+    // Pad reads and log writes move to worker threads; without them they run inline
+    boot_profile_phase("Worker threads");
+    if (worker_system_init() != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Running without worker threads\n");
+    }
+    
     // Initialize camera
     camera_init_fixed(&g_system.camera);
     camera_set_position_fixed(&g_system.camera, 
@@ -174,13 +340,102 @@ GaussianResult initialize_systems(void) {
                            fixed_from_float(0.0f));
     camera_update_matrices_fixed(&g_system.camera);
     
+    // Projection and tile grid cover the buffer actually drawn
+    u32 render_width, render_height;
+    gs_get_render_resolution(&render_width, &render_height);
+    tile_set_render_size(render_width, render_height);
+    g_system.camera.viewport[2] = fixed_from_int(render_width);
+    g_system.camera.viewport[3] = fixed_from_int(render_height);
+    if (profile->resolution_level > 0) {
+        apply_render_resolution(MIN(profile->resolution_level, RESOLUTION_LEVELS - 1));
+    }
+    boot_profile_end();
+    
     printf("SPLATSTORM X: All systems initialized successfully\n");
     return GAUSSIAN_SUCCESS;
 }
 
+// Whether any of splats [first, first + count) has nonzero degree 1-2 SH
+static bool scene_splats_have_sh(u32 first, u32 count) {
+    const GaussianSplat3D* splats = g_system.scene->splats_3d;
+    for (u32 i = first; i < first + count; i++) {
+        for (u32 c = 1; c <= 8; c++) {
+            if (splats[i].sh_coeffs[c] != 0) return true;
+        }
+    }
+    return false;
+}
+
+// Load a PLY scene: convert the most important vertices the budget allows,
+// then build the octree, put the splats in its order, and build the streams
+static GaussianResult load_scene_ply(const char* filename) {
+    // An earlier boot's conversion of this file, if the cache still has it
+    GaussianResult result = scene_cache_load(filename, g_system.load_splat_budget, g_system.scene);
+    if (result == GAUSSIAN_SUCCESS) {
+        splat_count = g_system.scene->splat_count;
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    // Load PLY file
+    u32 temp_count = 0;
+    result = load_ply_file_budgeted(filename, &g_system.scene->splats_3d, &temp_count,
+                                                   g_system.load_splat_budget);
+    g_system.scene->splat_count = (int)temp_count;
+    splat_count = temp_count;  // Update global splat count
+    if (result != GAUSSIAN_SUCCESS) {
+        system_set_error(result, "Failed to load PLY file");
+        return result;
+    }
+    
+    // Culling octree: use the exported index next to the scene when present.
+    // It indexes the file's vertices, so a budget that dropped some voids it.
+    char octree_path[256];
+    const char* name = strrchr(filename, '/');
+    if (!name) name = strrchr(filename, ':');
+    u32 dir_length = name ? (u32)(name - filename + 1) : 0;
+    bool all_vertices = g_system.load_splat_budget == 0 || temp_count < g_system.load_splat_budget;
+    if (all_vertices && dir_length + sizeof("octree.idx") <= sizeof(octree_path)) {
+        memcpy(octree_path, filename, dir_length);
+        strcpy(octree_path + dir_length, "octree.idx");
+        result = load_octree_index(octree_path, g_system.scene->splats_3d, g_system.scene->splat_count);
+    } else {
+        result = GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (result != GAUSSIAN_SUCCESS) {
+        result = init_spatial_grid(g_system.scene->splats_3d, g_system.scene->splat_count);
+        if (result != GAUSSIAN_SUCCESS) {
+            system_set_error(result, "Failed to build culling octree");
+            return result;
+        }
+    }
+    
+    // Splats in octree order: every node is one contiguous run of records, so
+    // culling, upload and binning walk memory in order. The records are no
+    // longer a most-important-first prefix: each keeps its importance field,
+    // which the culler ranks by when max_splats caps the visible set.
+    result = spatial_grid_linearize(g_system.scene->splats_3d, NULL, temp_count);
+    if (result != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Splats kept in file order (spatial reorder failed: %d)\n", result);
+    }
+    
+    // Hot/warm/cold streams: culling then reads 16 bytes per splat instead of 64
+    result = gaussian_splat_streams_build(&g_system.scene->streams, g_system.scene->splats_3d,
+                                          g_system.scene->splat_count, g_system.scene_pool_id);
+    if (result != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Splat streams unavailable, culling from AoS records\n");
+        memset(&g_system.scene->streams, 0, sizeof(GaussianSplatStreams));
+    } else {
+        // Next boot loads the conversion in one read
+        scene_cache_store(filename, g_system.load_splat_budget, g_system.scene);
+    }
+    
+    return GAUSSIAN_SUCCESS;
+}
+
 // Load scene data
 GaussianResult load_scene(const char* filename) {
     printf("SPLATSTORM X: Loading scene from %s...\n", filename);
+    boot_profile_begin("Scene load");
     
     // Allocate scene from memory pool
     g_system.scene = (GaussianScene*)memory_pool_alloc(g_system.scene_pool_id, 
@@ -193,78 +448,176 @@ GaussianResult load_scene(const char* filename) {
     }
     
     // Initialize scene
-    GaussianResult result = gaussian_scene_init(g_system.scene, MAX_SCENE_SPLATS);
+    boot_profile_phase("Scene init");
+    GaussianResult result = gaussian_scene_init(g_system.scene, MAX_SPLATS_PER_SCENE);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to initialize scene");
         return result;
     }
     
-    // Load PLY file
-    u32 temp_count = 0;
-    result = load_ply_file(filename, &g_system.scene->splats_3d, &temp_count);
-    g_system.scene->splat_count = (int)temp_count;
-    splat_count = temp_count;  // Update global splat count
-    if (result != GAUSSIAN_SUCCESS) {
-        system_set_error(result, "Failed to load PLY file");
+    // Cooked scenes stream in behind the first frames, from storage or a scene
+    // server; packed ones decode as they are read, paged ones load around the
+    // camera; anything else is parsed as PLY
+    boot_profile_phase("Scene read");
+    result = scene_stream_begin(filename, g_system.scene);
+    if (result == GAUSSIAN_ERROR_INIT_FAILED) {
+        result = load_cooked_scene(filename, g_system.scene);  // No fileXio: load it in one blocking read
+    }
+    if (result == GAUSSIAN_ERROR_INVALID_FORMAT) {
+        result = load_packed_scene(filename, g_system.scene);  // Compressed scenes decode as they are read
+    }
+    if (result == GAUSSIAN_ERROR_INVALID_FORMAT) {
+        result = scene_paging_open(filename, g_system.scene, MAX_SPLATS_PER_SCENE);  // Larger than RAM: proxies first
+    }
+    if (result == GAUSSIAN_SUCCESS) {
+        // Block only until the first chunk is resident; the main loop streams the rest
+        while (scene_stream_active() && g_system.scene->splat_count == 0) {
+            result = scene_stream_update(true);
+            if (result != GAUSSIAN_SUCCESS) {
+                system_set_error(result, "Failed to stream cooked scene");
+                return result;
+            }
+        }
+        
+        // Cooked splats are resident and already in importance order: a load
+        // budget only trims the count
+        u32 budget = g_system.load_splat_budget;
+        if (budget > 0 && !scene_stream_active() && !scene_paging_active() && g_system.scene->splat_count > budget) {
+            g_system.scene->splat_count = budget;
+        }
+        splat_count = g_system.scene->splat_count;  // Update global splat count
+    } else if (result == GAUSSIAN_ERROR_INVALID_FORMAT) {
+        result = load_scene_ply(filename);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+    } else {
+        system_set_error(result, "Failed to load cooked scene");
         return result;
     }
+    memory_budget_print();
     
     // Upload LUT textures to GS
+    boot_profile_phase("LUT upload");
     result = gs_upload_lut_textures(&g_system.scene->luts);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Failed to upload LUT textures");
         return result;
     }
     
+    // SH batches carry fewer splats: shade only scenes that have coefficients.
+    // A streamed scene is checked again as its chunks arrive
+    g_system.scene_sh = scene_splats_have_sh(0, g_system.scene->splat_count);
+    vu_set_sh_mode(g_system.scene_sh ? VU_SH_MODE_CACHED : VU_SH_MODE_OFF, VU_SH_CACHE_THRESHOLD_DEFAULT);
+    
+    // Benchmark the VU1 programs on this scene and keep the fastest correct one
+    boot_profile_phase("VU1 autotune");
+    result = vu_autotune_microcode(g_system.scene->splats_3d, g_system.scene->splat_count, &g_system.camera);
+    if (result != GAUSSIAN_SUCCESS) {
+        system_set_error(result, "Failed to select VU1 microcode");
+        return result;
+    }
+    
+    // Cached SH colors belong to the previous scene; without a cache SH runs every frame
+    if (vu_sh_cache_init(g_system.scene->splat_count) != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: SH color cache unavailable, shading every frame\n");
+    }
+    
+    boot_profile_end();
     printf("SPLATSTORM X: Scene loaded successfully (%u splats)\n", g_system.scene->splat_count);
     return GAUSSIAN_SUCCESS;
 }
 
-// Update camera based on input
-void update_camera(float delta_time) {
-    if (!g_system.scene) return;
-    
-    // Get input state
-    input_update(&g_system.input);
-    
+// Stick and zoom motion over delta_time seconds
+static void camera_apply_sticks(const InputState* input, float delta_time) {
     // Camera movement speed
     float move_speed = 5.0f * delta_time;
     float rotate_speed = 2.0f * delta_time;
     
     // Movement
-    if (g_system.input.left_stick_x != 0 || g_system.input.left_stick_y != 0) {
-        fixed16_t move_x = fixed_from_float(g_system.input.left_stick_x * move_speed);
-        fixed16_t move_z = fixed_from_float(-g_system.input.left_stick_y * move_speed);
+    if (input->left_stick_x != 0 || input->left_stick_y != 0) {
+        fixed16_t move_x = fixed_from_float(input->left_stick_x * move_speed);
+        fixed16_t move_z = fixed_from_float(-input->left_stick_y * move_speed);
         
         camera_move_relative_fixed(&g_system.camera, move_x, 0, move_z);
     }
     
     // Rotation
-    if (g_system.input.right_stick_x != 0 || g_system.input.right_stick_y != 0) {
-        fixed16_t yaw = fixed_from_float(g_system.input.right_stick_x * rotate_speed);
-        fixed16_t pitch = fixed_from_float(-g_system.input.right_stick_y * rotate_speed);
+    if (input->right_stick_x != 0 || input->right_stick_y != 0) {
+        fixed16_t yaw = fixed_from_float(input->right_stick_x * rotate_speed);
+        fixed16_t pitch = fixed_from_float(-input->right_stick_y * rotate_speed);
         
         camera_rotate_fixed(&g_system.camera, pitch, yaw, 0);
     }
     
     // Zoom
-    if (g_system.input.buttons & INPUT_BUTTON_L1) {
+    if (input->buttons & INPUT_BUTTON_L1) {
         camera_move_relative_fixed(&g_system.camera, 0, 0, fixed_from_float(-move_speed));
     }
-    if (g_system.input.buttons & INPUT_BUTTON_R1) {
+    if (input->buttons & INPUT_BUTTON_R1) {
         camera_move_relative_fixed(&g_system.camera, 0, 0, fixed_from_float(move_speed));
     }
+}
+
+// Update camera based on input
+void update_camera(float delta_time) {
+    if (!g_system.scene) return;
+    
+    // Get input state, polled at VBLANK by the input thread when it runs
+    if (!worker_input_read(&g_system.input)) {
+        input_update(&g_system.input);
+    }
+    
+    // A late latch already moved the camera over part of this frame's time
+    delta_time -= g_system.latched_time;
+    if (delta_time < 0.0f) {
+        delta_time = 0.0f;
+    }
+    g_system.latched_time = 0.0f;
+    g_system.camera_cycles = get_cpu_cycles();
+    camera_apply_sticks(&g_system.input, delta_time);
+    
+    // Every button below changes what the frame shows
+    if (g_system.input.buttons_pressed) {
+        g_system.frame_dirty = true;
+    }
     
     // Debug controls
+    // L1 + Select in debug mode: next performance counter pair
+    // R1 + Select in debug mode: next tile heatmap (off, splats, fill, cycles)
     if (g_system.input.buttons_pressed & INPUT_BUTTON_SELECT) {
-        g_system.debug_mode = !g_system.debug_mode;
-        gs_enable_debug_mode(true, true, 0xFF0000FF);
+        if (g_system.debug_mode && (g_system.input.buttons & INPUT_BUTTON_L1)) {
+            g_system.counter_set = (ProfileCounterSet)(g_system.counter_set % (PROFILE_COUNTER_SETS - 1) + 1);
+            profile_zones_set_counters(g_system.counter_set);
+        } else if (g_system.debug_mode && (g_system.input.buttons & INPUT_BUTTON_R1)) {
+            tile_set_heatmap_mode((tile_get_heatmap_mode() + 1) % TILE_HEATMAP_MODES);
+            printf("SPLATSTORM X: Tile heatmap %s\n", tile_heatmap_mode_name(tile_get_heatmap_mode()));
+        } else {
+            g_system.debug_mode = !g_system.debug_mode;
+            debug_init();  // Graphs draw through the debug system
+            gs_enable_debug_mode(true, true, 0xFF0000FF);
+            profile_zones_set_counters(g_system.debug_mode ? g_system.counter_set : PROFILE_COUNTERS_OFF);
+            if (!g_system.debug_mode) {
+                tile_set_heatmap_mode(TILE_HEATMAP_OFF);
+            }
+        }
     }
     
     if (g_system.input.buttons_pressed & INPUT_BUTTON_START) {
         g_system.show_stats = !g_system.show_stats;
     }
     
+    if (g_system.input.buttons_pressed & INPUT_BUTTON_CIRCLE) {
+        vu_set_render_mode(vu_get_render_mode() == VU_RENDER_MODE_XGKICK ?
+                           VU_RENDER_MODE_DOWNLOAD : VU_RENDER_MODE_XGKICK);
+    }
+    
+    // Front-to-back saturation early-out for overdraw-heavy interiors
+    if (g_system.input.buttons_pressed & INPUT_BUTTON_CROSS) {
+        tile_set_saturation_cull(!tile_get_saturation_cull(), TILE_SATURATION_EPSILON_DEFAULT);
+        printf("SPLATSTORM X: Tile saturation early-out %s\n", tile_get_saturation_cull() ? "on" : "off");
+    }
+    
     // Quality controls
     if (g_system.input.buttons_pressed & INPUT_BUTTON_TRIANGLE) {
         g_system.quality_level = MIN(g_system.quality_level + 1, 3);
@@ -280,37 +633,379 @@ void update_camera(float delta_time) {
     camera_update_matrices_fixed(&g_system.camera);
 }
 
-// Adaptive quality adjustment
-void update_adaptive_quality(void) {
-    if (!g_system.adaptive_quality) return;
-    
-    // Adjust quality based on performance
-    if (g_system.current_fps < g_system.target_fps * 0.9f) {
-        // Performance too low - reduce quality
-        if (g_system.max_splats > 1000) {
-            g_system.max_splats = (u32)(g_system.max_splats * 0.9f);
-        } else if (g_system.quality_level > 0) {
+// Switch render size: GS buffers, tile grid and the projection viewport together
+static void apply_render_resolution(u32 level) {
+    u32 width = g_resolution_levels[level][0];
+    u32 height = g_resolution_levels[level][1] >> (g_system.field_rendering ? 1 : 0);
+    if (gs_set_render_resolution(width, height) != GAUSSIAN_SUCCESS) {
+        return;
+    }
+    
+    tile_set_render_size(width, height);
+    g_system.camera.viewport[2] = fixed_from_int(width);
+    g_system.camera.viewport[3] = fixed_from_int(height);
+    g_system.resolution_level = level;
+    printf("SPLATSTORM X: Render resolution %ux%u\n", width, height);
+}
+
+// Stage costs of the last frame in milliseconds. The direct VU1 path
+// times kicking and drawing together, so its GS stage is what remains.
+static void quality_sample_stages(float stage_ms[QUALITY_STAGE_COUNT]) {
+    const float cycle_to_ms = 1000.0f / 294912000.0f;
+    stage_ms[QUALITY_STAGE_CULL] = g_system.profile.cull_cycles * cycle_to_ms;
+    stage_ms[QUALITY_STAGE_VU] = g_system.profile.vu_execute_cycles * cycle_to_ms;
+    stage_ms[QUALITY_STAGE_TILE] = g_system.profile.tile_sort_cycles * cycle_to_ms;
+    stage_ms[QUALITY_STAGE_GS] = g_system.profile.gs_render_cycles * cycle_to_ms;
+    if (vu_get_render_mode() == VU_RENDER_MODE_XGKICK) {
+        stage_ms[QUALITY_STAGE_GS] = MAX(stage_ms[QUALITY_STAGE_GS] - stage_ms[QUALITY_STAGE_VU], 0.0f);
+    }
+}
+
+// Lower one knob a step. The splat budget shrinks in proportion to the
+// overrun, since every stage scales with it. Returns false at the floor.
+static bool quality_drop_knob(QualityKnob knob, float forecast_ms, float budget_ms) {
+    switch (knob) {
+        case QUALITY_KNOB_SPLATS: {
+            if (g_system.max_splats <= QUALITY_MIN_SPLATS) return false;
+            float scale = CLAMP(budget_ms / forecast_ms, 0.5f, 0.95f);
+            g_system.max_splats = MAX((u32)(g_system.max_splats * scale), QUALITY_MIN_SPLATS);
+            return true;
+        }
+        case QUALITY_KNOB_LOD:
+            if (g_system.quality_level == 0) return false;
             g_system.quality_level--;
+            return true;
+        case QUALITY_KNOB_SH:
+            if (vu_get_sh_mode() == VU_SH_MODE_OFF) return false;
+            vu_set_sh_mode(vu_get_sh_mode() == VU_SH_MODE_FULL ? VU_SH_MODE_CACHED : VU_SH_MODE_OFF,
+                           VU_SH_CACHE_THRESHOLD_DEFAULT);
+            return true;
+        case QUALITY_KNOB_MIP:
+            if (footprint_get_mip_bias() + 1 >= FOOTPRINT_MIP_LEVELS) return false;
+            footprint_set_mip_bias(footprint_get_mip_bias() + 1);
+            return true;
+        case QUALITY_KNOB_RESOLUTION:
+            if (!g_system.dynamic_resolution || g_system.resolution_level + 1 >= RESOLUTION_LEVELS) return false;
+            apply_render_resolution(g_system.resolution_level + 1);
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Forecast milliseconds one knob's next step up would add, from the
+// stages it loads; negative when the knob is already at its top
+static float quality_raise_cost(QualityKnob knob, const float stage_ms[QUALITY_STAGE_COUNT]) {
+    switch (knob) {
+        case QUALITY_KNOB_SPLATS:
+            if (g_system.max_splats >= MIN(g_system.scene->splat_count, QUALITY_MAX_SPLATS)) return -1.0f;
+            return (stage_ms[QUALITY_STAGE_CULL] + stage_ms[QUALITY_STAGE_VU] + stage_ms[QUALITY_STAGE_TILE] +
+                    stage_ms[QUALITY_STAGE_GS]) * QUALITY_SPLAT_STEP;
+        case QUALITY_KNOB_LOD:
+            // Fewer aggregated splats to bin and draw
+            if (g_system.quality_level >= 3) return -1.0f;
+            return (stage_ms[QUALITY_STAGE_TILE] + stage_ms[QUALITY_STAGE_GS]) * 0.15f;
+        case QUALITY_KNOB_SH:
+            // Cached shading redoes a fraction of the splats, full shading all of them.
+            // A scene without SH coefficients would only shade its base color
+            if (!g_system.scene_sh || vu_get_sh_mode() == VU_SH_MODE_FULL) return -1.0f;
+            return stage_ms[QUALITY_STAGE_VU] * (vu_get_sh_mode() == VU_SH_MODE_OFF ? 0.15f : 0.5f);
+        case QUALITY_KNOB_MIP:
+            // Finer footprints miss the texture cache more often
+            if (footprint_get_mip_bias() == 0) return -1.0f;
+            return stage_ms[QUALITY_STAGE_GS] * 0.1f;
+        case QUALITY_KNOB_RESOLUTION: {
+            // Fill scales with the pixel count
+            if (!g_system.dynamic_resolution || g_system.resolution_level == 0) return -1.0f;
+            u32 level = g_system.resolution_level;
+            float area = (float)(g_resolution_levels[level][0] * g_resolution_levels[level][1]);
+            float larger = (float)(g_resolution_levels[level - 1][0] * g_resolution_levels[level - 1][1]);
+            return stage_ms[QUALITY_STAGE_GS] * (larger / area - 1.0f);
         }
-    } else if (g_system.current_fps > g_system.target_fps * 1.1f) {
-        // Performance good - increase quality
-        if (g_system.quality_level < 3) {
+        default:
+            return -1.0f;
+    }
+}
+
+static void quality_raise_knob(QualityKnob knob) {
+    switch (knob) {
+        case QUALITY_KNOB_SPLATS:
+            g_system.max_splats = MIN((u32)(g_system.max_splats * (1.0f + QUALITY_SPLAT_STEP)) + 100,
+                                      MIN(g_system.scene->splat_count, QUALITY_MAX_SPLATS));
+            break;
+        case QUALITY_KNOB_LOD:
             g_system.quality_level++;
-        } else if (g_system.max_splats < g_system.scene->splat_count) {
-            g_system.max_splats = MIN(g_system.max_splats + 100, g_system.scene->splat_count);
+            break;
+        case QUALITY_KNOB_SH:
+            vu_set_sh_mode(vu_get_sh_mode() == VU_SH_MODE_OFF ? VU_SH_MODE_CACHED : VU_SH_MODE_FULL,
+                           VU_SH_CACHE_THRESHOLD_DEFAULT);
+            break;
+        case QUALITY_KNOB_MIP:
+            footprint_set_mip_bias(footprint_get_mip_bias() - 1);
+            break;
+        case QUALITY_KNOB_RESOLUTION:
+            apply_render_resolution(g_system.resolution_level - 1);
+            break;
+        default:
+            break;
+    }
+}
+
+// Adaptive quality: one controller for every knob. Each stage's cost is
+// smoothed with its trend (Holt), so the forecast leads a scene that is
+// getting denser. A forecast over budget for QUALITY_DOWN_FRAMES drops the
+// cheapest knob on the dominant stage; QUALITY_UP_FRAMES of headroom raise
+// the first knob whose forecast cost still fits. Changes wait out the
+// frames still in flight before the next decision.
+void update_adaptive_quality(void) {
+    if (!g_system.adaptive_quality || g_system.profile.frame_time_ms <= 0.0f) return;
+    
+    QualityController* ctl = &g_system.quality;
+    float sample_ms[QUALITY_STAGE_COUNT];
+    quality_sample_stages(sample_ms);
+    
+    float stage_total_ms = 0.0f;
+    for (u32 s = 0; s < QUALITY_STAGE_COUNT; s++) {
+        stage_total_ms += sample_ms[s];
+    }
+    float other_ms = MAX(g_system.profile.frame_time_ms - stage_total_ms, 0.0f);
+    
+    if (!ctl->primed) {
+        memcpy(ctl->stage_ms, sample_ms, sizeof(sample_ms));
+        memset(ctl->stage_trend_ms, 0, sizeof(ctl->stage_trend_ms));
+        ctl->other_ms = other_ms;
+        ctl->primed = true;
+    } else {
+        for (u32 s = 0; s < QUALITY_STAGE_COUNT; s++) {
+            float previous = ctl->stage_ms[s];
+            ctl->stage_ms[s] = QUALITY_LEVEL_GAIN * sample_ms[s] +
+                               (1.0f - QUALITY_LEVEL_GAIN) * (previous + ctl->stage_trend_ms[s]);
+            ctl->stage_trend_ms[s] = QUALITY_TREND_GAIN * (ctl->stage_ms[s] - previous) +
+                                     (1.0f - QUALITY_TREND_GAIN) * ctl->stage_trend_ms[s];
+        }
+        ctl->other_ms = QUALITY_LEVEL_GAIN * other_ms + (1.0f - QUALITY_LEVEL_GAIN) * ctl->other_ms;
+    }
+    
+    float forecast_stage_ms[QUALITY_STAGE_COUNT];
+    u32 dominant = QUALITY_STAGE_CULL;
+    ctl->forecast_ms = ctl->other_ms;
+    for (u32 s = 0; s < QUALITY_STAGE_COUNT; s++) {
+        forecast_stage_ms[s] = MAX(ctl->stage_ms[s] + ctl->stage_trend_ms[s] * QUALITY_FORECAST_FRAMES, 0.0f);
+        ctl->forecast_ms += forecast_stage_ms[s];
+        if (forecast_stage_ms[s] > forecast_stage_ms[dominant]) {
+            dominant = s;
+        }
+    }
+    
+    if (ctl->settle_frames > 0) {
+        ctl->settle_frames--;
+        return;
+    }
+    
+    float budget_ms = 1000.0f / g_system.target_fps * QUALITY_BUDGET_FRACTION;
+    bool changed = false;
+    
+    if (ctl->forecast_ms > budget_ms) {
+        ctl->under_frames = 0;
+        if (++ctl->over_frames >= QUALITY_DOWN_FRAMES) {
+            for (u32 k = 0; k < QUALITY_KNOB_COUNT && !changed; k++) {
+                QualityKnob knob = (QualityKnob)g_quality_drop_order[dominant][k];
+                changed = quality_drop_knob(knob, ctl->forecast_ms, budget_ms);
+                if (changed) {
+                    printf("SPLATSTORM X: Quality down: %s (%.2f ms forecast, %.2f ms budget)\n",
+                           g_quality_knob_names[knob], ctl->forecast_ms, budget_ms);
+                }
+            }
+        }
+    } else if (ctl->forecast_ms < budget_ms * QUALITY_UP_HEADROOM) {
+        ctl->over_frames = 0;
+        if (++ctl->under_frames >= QUALITY_UP_FRAMES) {
+            for (u32 k = 0; k < QUALITY_KNOB_COUNT && !changed; k++) {
+                float cost_ms = quality_raise_cost((QualityKnob)k, forecast_stage_ms);
+                if (cost_ms >= 0.0f && ctl->forecast_ms + cost_ms < budget_ms * QUALITY_UP_HEADROOM) {
+                    quality_raise_knob((QualityKnob)k);
+                    printf("SPLATSTORM X: Quality up: %s (%.2f ms forecast, +%.2f ms expected)\n",
+                           g_quality_knob_names[k], ctl->forecast_ms, cost_ms);
+                    changed = true;
+                }
+            }
+            if (!changed) {
+                ctl->under_frames = 0;  // Nothing fits yet; look again later
+            }
+        }
+    } else {
+        ctl->over_frames = 0;
+        ctl->under_frames = 0;
+    }
+    
+    if (changed) {
+        // The step is not a trend: forecast from the new level only
+        g_system.frame_dirty = true;
+        memset(ctl->stage_trend_ms, 0, sizeof(ctl->stage_trend_ms));
+        ctl->over_frames = 0;
+        ctl->under_frames = 0;
+        ctl->settle_frames = QUALITY_SETTLE_FRAMES;
+        ctl->changes++;
+    }
+}
+
+// Clear what this frame's splats will not cover. Tiles the saturation
+// early-out found opaque are skipped and the rest are cleared in row runs.
+// That needs the Z-buffer-free mode, since a partial clear leaves depth stale.
+static void clear_frame(void) {
+    if (g_system.clear_mode == CLEAR_MODE_NONE) return;
+    
+    if (g_system.clear_mode == CLEAR_MODE_FULL || gs_renderer_get_depth_buffer() || !tile_get_saturation_cull()) {
+        gs_clear_buffers(0x00000000, 0xFFFFFFFF);
+        return;
+    }
+    
+    u32 width, height;
+    gs_get_render_resolution(&width, &height);
+    u32 tiles_x = MIN((width + TILE_SIZE - 1) / TILE_SIZE, TILES_X);
+    u32 tiles_y = MIN((height + TILE_SIZE - 1) / TILE_SIZE, TILES_Y);
+    
+    for (u32 tile_y = 0; tile_y < tiles_y; tile_y++) {
+        u32 tile_x = 0;
+        while (tile_x < tiles_x) {
+            if (tile_is_covered(tile_y * TILES_X + tile_x)) {
+                tile_x++;
+                continue;
+            }
+            u32 first_x = tile_x;
+            while (tile_x < tiles_x && !tile_is_covered(tile_y * TILES_X + tile_x)) {
+                tile_x++;
+            }
+            gs_clear_rect(first_x * TILE_SIZE, tile_y * TILE_SIZE, (tile_x - first_x) * TILE_SIZE, TILE_SIZE, 0x00000000);
         }
     }
 }
 
+// Late latch: after culling, the camera takes the sticks of the latest
+// VBLANK poll over the time since it last took them, and VU1 gets the new
+// constants just before projection. The input thread already has the pads,
+// so this costs no SIF round trip; the cull frustum was padded for the turn.
+static GaussianResult late_latch_camera(void) {
+    InputState latest;
+    if (!worker_input_peek(&latest)) {
+        return GAUSSIAN_SUCCESS;  // Pads polled inline, nothing newer to take
+    }
+    
+    u64 now = get_cpu_cycles();
+    float elapsed = (now - g_system.camera_cycles) / 294912000.0f;
+    camera_apply_sticks(&latest, elapsed);
+    g_system.latched_time = elapsed;
+    g_system.latch_ms = elapsed * 1000.0f;
+    
+    // The frame's moved flag keeps the move from its start: tile tracking
+    // and the full-sort decision read it after the latch
+    bool moved_at_start = g_system.camera.moved_significantly;
+    bool latched_move = camera_begin_frame(&g_system.camera);
+    g_system.camera.moved_significantly = moved_at_start || latched_move;
+    if (!latched_move) {
+        return GAUSSIAN_SUCCESS;
+    }
+    sorting_camera_moved();
+    return vu_upload_constants(&g_system.camera);
+}
+
 // Render frame
+// Render visible splats with VU1 XGKICKing sprites straight to the GS
+// Skips the EE download, tile binning and EE-side GIF packet building
+// Instance indices follow the scene's; both counts may be zero, not both.
+static GaussianResult render_frame_direct(const u32* visible_indices, u32 visible_count, u32 instance_count) {
+    profile_zone_begin(PROFILE_ZONE_GS);
+    profile_zone_begin(PROFILE_ZONE_VU);
+    
+    // Clear and texture state go out on PATH3 first; PATH1 has priority
+    // at packet boundaries, so they must land before VU1 starts kicking,
+    // and the previous frame must be finished before either
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_GS_SYNC);
+    gs_sync_frame();
+    PROFILE_ZONE_END(PROFILE_ZONE_GS_SYNC);
+    gs_clear_buffers(0x00000000, 0xFFFFFFFF);
+    gs_setup_gaussian_texturing();
+    gs_flush_command_buffer();
+    dma_wait_channel(DMA_CHANNEL_GIF);
+    
+    u32 kicked_count = 0;
+    GaussianResult result = GAUSSIAN_SUCCESS;
+    if (visible_count > 0) {
+        result = vu_render_indexed_direct(g_system.scene->splats_3d, visible_indices, visible_count,
+                                          &kicked_count);
+    }
+    u32 instance_kicked = 0;
+    if (result == GAUSSIAN_SUCCESS && instance_count > 0) {
+        result = scene_instances_render_direct(&g_system.camera, visible_indices + visible_count, &instance_kicked);
+        kicked_count += instance_kicked;
+    }
+    if (result != GAUSSIAN_SUCCESS) {
+        system_set_error(result, "VU1 direct rendering failed");
+        return result;
+    }
+    
+    profile_zone_end(PROFILE_ZONE_VU);
+    g_system.profile.vu_execute_cycles = profile_zone_cycles(PROFILE_ZONE_VU);
+    g_system.profile.projected_splats = kicked_count;
+    
+    // Render debug overlay
+    if (g_system.debug_mode) {
+        gs_render_debug_overlay();
+    }
+    
+    profile_zone_end(PROFILE_ZONE_GS);
+    g_system.profile.gs_render_cycles = profile_zone_cycles(PROFILE_ZONE_GS);
+    g_system.profile.rendered_splats = kicked_count;
+    
+    // Swap contexts
+    gs_swap_contexts();
+    
+    // Calculate frame time
+    profile_zone_end(PROFILE_ZONE_RENDER);
+    u64 frame_cycles = profile_zone_cycles(PROFILE_ZONE_RENDER);
+    g_system.profile.frame_cycles = frame_cycles;
+    
+    float cycle_to_ms = 1000.0f / 294912000.0f;
+    g_system.profile.frame_time_ms = frame_cycles * cycle_to_ms;
+    g_system.current_fps = 1000.0f / g_system.profile.frame_time_ms;
+    
+    return GAUSSIAN_SUCCESS;
+}
+
 GaussianResult render_frame(void) {
     if (!g_system.scene) return GAUSSIAN_ERROR_INVALID_PARAMETER;
     
-    u64 frame_start = get_cpu_cycles();
+    profile_zone_begin(PROFILE_ZONE_RENDER);
     
-    // Clear performance counters
+    // Clear performance counters; the zone profiler keeps the history
     memset(&g_system.profile, 0, sizeof(FrameProfileData));
     
+    // Cached matrices and frustum; the changed flag lets later stages skip work
+    if (camera_begin_frame(&g_system.camera)) {
+        sorting_camera_moved();
+        g_system.frame_dirty = true;
+    }
+    if (scene_instances_revision() != g_system.instance_revision) {
+        g_system.instance_revision = scene_instances_revision();
+        g_system.frame_dirty = true;
+    }
+    
+    // Dynamic splats: refit and invalidate only what the pending ranges touch
+    if (scene_splats_apply_updates(g_system.scene) > 0) {
+        g_system.frame_dirty = true;
+    }
+    
+    // Static frame: the last completed frame is still on screen (or queued
+    // for the next VBLANK) and would come out the same, so pace on VBLANK
+    // instead. The debug overlay is part of that frame and does not change.
+    if (g_system.frame_reuse && !g_system.frame_dirty) {
+        g_system.frames_reused++;
+        gs_wait_vblank();
+        return GAUSSIAN_SUCCESS;
+    }
+    g_system.frame_dirty = false;
+    frame_capture_begin(g_system.frame_counter, &g_system.camera, g_system.quality_level);
+    
     // Upload camera constants to VU
     GaussianResult result = vu_upload_constants(&g_system.camera);
     if (result != GAUSSIAN_SUCCESS) {
@@ -322,94 +1017,176 @@ GaussianResult render_frame(void) {
     }
     
     // Frustum culling
-    u64 cull_start = get_cpu_cycles();
+    profile_zone_begin(PROFILE_ZONE_CULL);
     u32 visible_count = 0;
     
-    // Use temporary pool for culled splats
-    memory_pool_reset(g_system.temp_pool_id);
-    GaussianSplat3D* visible_splats = (GaussianSplat3D*)memory_pool_alloc(g_system.temp_pool_id,
-                                                                          g_system.max_splats * sizeof(GaussianSplat3D),
-                                                                          CACHE_LINE_SIZE,
-                                                                          __FILE__, __LINE__);
-    if (!visible_splats) {
-        system_set_error(GAUSSIAN_ERROR_MEMORY_ALLOCATION, "Failed to allocate visible splats buffer");
+    // Everything per-frame comes from the frame arena, one mark per stage
+    frame_arena_begin();
+    frame_arena_mark(FRAME_STAGE_CULL);
+    u32* visible_indices = (u32*)frame_arena_alloc(g_system.max_splats * sizeof(u32), CACHE_LINE_SIZE);
+    if (!visible_indices) {
+        system_set_error(GAUSSIAN_ERROR_MEMORY_ALLOCATION, "Failed to allocate visible index buffer");
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
     
-    // Perform frustum culling - get view-projection matrix from camera
-    fixed16_t view_proj_matrix[16];
-    // Multiply view and projection matrices to get view-projection matrix
-    for (int i = 0; i < 16; i++) {
-        view_proj_matrix[i] = g_system.camera.view[i]; // Simplified - should be view * projection
+    // A camera latched again before projection may still turn, so it culls
+    // against a wider frustum. Benchmarks and captures keep the camera they
+    // started the frame with.
+    bool late_latch = g_system.late_latch && benchmark_mode() == BENCHMARK_OFF && !frame_capture_active();
+    const CameraFixed* cull_camera = &g_system.camera;
+    CameraFixed padded_camera;
+    if (late_latch) {
+        camera_pad_frustum_fixed(&g_system.camera, LATE_LATCH_CULL_MARGIN, &padded_camera);
+        cull_camera = &padded_camera;
     }
     
-    result = cull_gaussian_splats(g_system.scene->splats_3d, 
-                                 MIN(g_system.scene->splat_count, g_system.max_splats),
-                                 view_proj_matrix, visible_splats, &visible_count);
+    // Perform frustum culling with the camera's cached view-projection matrix.
+    // Only indices come back; VU1 uploads reference the resident scene splats.
+    // Every scene splat is tested; past max_splats the most important visible ones are kept
+    u32 cull_count = g_system.scene->splat_count;
+    const GaussianSplatStreams* streams = (g_system.scene->streams.count >= cull_count) ? &g_system.scene->streams : NULL;
+    result = cull_gaussian_splat_indices(g_system.scene->splats_3d, streams, cull_count, cull_camera->view_proj,
+                                         visible_indices, g_system.max_splats, &visible_count);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Frustum culling failed");
         return result;
     }
     
-    g_system.profile.cull_cycles = get_cpu_cycles() - cull_start;
-    g_system.profile.visible_splats = visible_count;
+    // Instanced assets follow, within what the budget left. Their indices
+    // select asset records, so the capture keeps the scene's alone.
+    u32 instance_count = 0;
+    if (scene_instances_count() > 0) {
+        instance_count = scene_instances_cull(cull_camera, visible_indices + visible_count,
+                                              g_system.max_splats - visible_count);
+    }
     
-    if (visible_count == 0) {
+    profile_zone_end(PROFILE_ZONE_CULL);
+    g_system.profile.cull_cycles = profile_zone_cycles(PROFILE_ZONE_CULL);
+    g_system.profile.visible_splats = visible_count + instance_count;
+    frame_capture_write(FRAME_CAPTURE_SECTION_VISIBLE, visible_indices, sizeof(u32), visible_count);
+    
+    if (visible_count + instance_count == 0) {
         // Nothing to render
+        gs_sync_frame();
         gs_clear_buffers(0x00000000, 0xFFFFFFFF);
         gs_swap_contexts();
         return GAUSSIAN_SUCCESS;
     }
     
+    if (late_latch) {
+        result = late_latch_camera();
+        if (result != GAUSSIAN_SUCCESS) {
+            system_set_error(result, "Failed to upload latched camera constants");
+            return result;
+        }
+    }
+    
+    // Direct VU1 render path: projection and sprite packets stay on VU1
+    if (vu_get_render_mode() == VU_RENDER_MODE_XGKICK) {
+        return render_frame_direct(visible_indices, visible_count, instance_count);
+    }
+    
     // VU processing
-    u64 vu_start = get_cpu_cycles();
-    GaussianSplat2D* projected_splats = (GaussianSplat2D*)memory_pool_alloc(g_system.temp_pool_id,
-                                                                            visible_count * sizeof(GaussianSplat2D),
-                                                                            CACHE_LINE_SIZE,
-                                                                            __FILE__, __LINE__);
+    profile_zone_begin(PROFILE_ZONE_VU);
+    frame_arena_mark(FRAME_STAGE_PROJECT);
+    GaussianSplatRender* projected_splats = (GaussianSplatRender*)frame_arena_alloc((visible_count + instance_count) *
+                                                                                    sizeof(GaussianSplatRender),
+                                                                                    CACHE_LINE_SIZE);
     if (!projected_splats) {
         system_set_error(GAUSSIAN_ERROR_MEMORY_ALLOCATION, "Failed to allocate projected splats buffer");
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
     
     u32 projected_count = 0;
-    result = vu_process_batch(visible_splats, visible_count, projected_splats, &projected_count);
+    if (visible_count > 0) {
+        result = vu_process_indexed(g_system.scene->splats_3d, visible_indices, visible_count,
+                                    projected_splats, &projected_count);
+    }
+    u32 instance_projected = 0;
+    if (result == GAUSSIAN_SUCCESS && instance_count > 0) {
+        result = scene_instances_project(&g_system.camera, visible_indices + visible_count,
+                                         projected_splats + projected_count, &instance_projected);
+        projected_count += instance_projected;
+    }
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "VU processing failed");
         return result;
     }
     
-    g_system.profile.vu_execute_cycles = get_cpu_cycles() - vu_start;
+    profile_zone_end(PROFILE_ZONE_VU);
+    g_system.profile.vu_execute_cycles = profile_zone_cycles(PROFILE_ZONE_VU);
     g_system.profile.projected_splats = projected_count;
+    frame_capture_write(FRAME_CAPTURE_SECTION_PROJECTED, projected_splats, sizeof(GaussianSplatRender), projected_count);
     
     // Tile processing
-    u64 tile_start = get_cpu_cycles();
-    TileRange* tile_ranges = (TileRange*)memory_pool_alloc(g_system.temp_pool_id,
-                                                          MAX_TILES * sizeof(TileRange),
-                                                          CACHE_LINE_SIZE,
-                                                          __FILE__, __LINE__);
+    profile_zone_begin(PROFILE_ZONE_TILE);
+    frame_arena_mark(FRAME_STAGE_TILE);
+    TileRange* tile_ranges = (TileRange*)frame_arena_alloc(MAX_TILES * sizeof(TileRange), CACHE_LINE_SIZE);
     if (!tile_ranges) {
         system_set_error(GAUSSIAN_ERROR_MEMORY_ALLOCATION, "Failed to allocate tile ranges buffer");
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
     
+    // Screen-space LOD: sub-pixel splats sharing a pixel cell and depth slice
+    // become one splat, so wide shots bin and draw a fraction of them
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_LOD);
+    tile_set_lod_quality(g_system.quality_level);
+    projected_count = tile_lod_aggregate(projected_splats, projected_count);
+    PROFILE_ZONE_END(PROFILE_ZONE_LOD);
+    g_system.profile.lod_splats = projected_count;
+    
+    benchmark_capture_splats(projected_splats, projected_count);
+    frame_capture_write(FRAME_CAPTURE_SECTION_LOD, projected_splats, sizeof(GaussianSplatRender), projected_count);
+    
     result = process_tiles(projected_splats, projected_count, &g_system.camera, tile_ranges);
     if (result != GAUSSIAN_SUCCESS) {
         system_set_error(result, "Tile processing failed");
         return result;
     }
+    frame_capture_tiles(tile_ranges);
     
-    g_system.profile.tile_sort_cycles = get_cpu_cycles() - tile_start;
+    // Merge tile runs into scissor regions, hot tiles split and sparse coarse
+    // tiles merged; none means render tile by tile
+    TileRegion* regions = (TileRegion*)frame_arena_alloc(TILE_MAX_REGIONS * sizeof(TileRegion), CACHE_LINE_SIZE);
+    u32 region_count = regions ? tile_build_render_regions(projected_splats, projected_count, regions,
+                                                           TILE_MAX_REGIONS) : 0;
+    frame_capture_regions(regions, region_count, tile_get_region_indices());
+    
+    profile_zone_end(PROFILE_ZONE_TILE);
+    g_system.profile.tile_sort_cycles = profile_zone_cycles(PROFILE_ZONE_TILE);
     
     // Rendering
-    u64 render_start = get_cpu_cycles();
+    profile_zone_begin(PROFILE_ZONE_GS);
+    frame_arena_mark(FRAME_STAGE_RENDER);
     
-    // Clear frame buffer
-    gs_clear_buffers(0x00000000, 0xFFFFFFFF);
+    // Everything above overlapped the previous frame on the GS; its time
+    // shows here as the wait for it to finish
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_GS_SYNC);
+    gs_sync_frame();
+    PROFILE_ZONE_END(PROFILE_ZONE_GS_SYNC);
     
-    // Render tiles
+    // Clear frame buffer, skipping tiles the splats cover
+    clear_frame();
+    
+    // Render regions, one scissor and one sprite per splat each. The cycles
+    // heatmap times each one
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_PACKETS);
     u32 rendered_splats = 0;
-    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+    bool heatmap_cycles = tile_get_heatmap_mode() == TILE_HEATMAP_CYCLES;
+    const u32* region_indices = tile_get_region_indices();
+    for (u32 r = 0; r < region_count; r++) {
+        u64 region_start = heatmap_cycles ? get_cpu_cycles() : 0;
+        gs_set_scissor_rect(regions[r].x, regions[r].y, regions[r].width, regions[r].height);
+        gs_render_splat_indices(projected_splats, &region_indices[regions[r].start_index], regions[r].count);
+        rendered_splats += regions[r].count;
+        if (heatmap_cycles) {
+            tile_heatmap_add_cycles(regions[r].x, regions[r].y, regions[r].width, regions[r].height,
+                                    (u32)(get_cpu_cycles() - region_start));
+        }
+    }
+    
+    // Render tiles
+    for (u32 tile_id = 0; region_count == 0 && tile_id < MAX_TILES; tile_id++) {
         if (tile_ranges[tile_id].count == 0) continue;
         
         // Set scissor for tile
@@ -422,38 +1199,39 @@ GaussianResult render_frame(void) {
         const u32* tile_splat_list = get_tile_splat_list(tile_id, &tile_splat_count);
         
         if (tile_splat_list && tile_splat_count > 0) {
-            // Create batch of splats for this tile
-            GaussianSplat2D* tile_splats = (GaussianSplat2D*)memory_pool_alloc(g_system.temp_pool_id,
-                                                                              tile_splat_count * sizeof(GaussianSplat2D),
-                                                                              CACHE_LINE_SIZE,
-                                                                              __FILE__, __LINE__);
-            if (tile_splats) {
-                for (u32 i = 0; i < tile_splat_count; i++) {
-                    tile_splats[i] = projected_splats[tile_splat_list[i]];
-                }
-                
-                gs_render_splat_batch(tile_splats, tile_splat_count);
-                rendered_splats += tile_splat_count;
+            // Gather this tile's splats directly from the shared projected array
+            u64 tile_start = heatmap_cycles ? get_cpu_cycles() : 0;
+            gs_render_splat_indices(projected_splats, tile_splat_list, tile_splat_count);
+            rendered_splats += tile_splat_count;
+            if (heatmap_cycles) {
+                tile_heatmap_add_cycles(tile_x * TILE_SIZE, tile_y * TILE_SIZE, TILE_SIZE, TILE_SIZE,
+                                        (u32)(get_cpu_cycles() - tile_start));
             }
         }
     }
     
     // Disable scissor
     gs_disable_scissor();
+    PROFILE_ZONE_END(PROFILE_ZONE_PACKETS);
     
-    // Render debug overlay
+    // Render debug overlay, and the tile heatmap over it when one is picked
     if (g_system.debug_mode) {
         gs_render_debug_overlay();
+        u32 heat_tiles_x, heat_tiles_y, heat_max;
+        const u32* heat = tile_get_heatmap(&heat_tiles_x, &heat_tiles_y, &heat_max);
+        gs_render_heatmap(heat, heat_tiles_x, heat_tiles_y, heat_max);
     }
     
-    g_system.profile.gs_render_cycles = get_cpu_cycles() - render_start;
+    profile_zone_end(PROFILE_ZONE_GS);
+    g_system.profile.gs_render_cycles = profile_zone_cycles(PROFILE_ZONE_GS);
     g_system.profile.rendered_splats = rendered_splats;
     
     // Swap contexts
     gs_swap_contexts();
     
     // Calculate frame time
-    u64 frame_cycles = get_cpu_cycles() - frame_start;
+    profile_zone_end(PROFILE_ZONE_RENDER);
+    u64 frame_cycles = profile_zone_cycles(PROFILE_ZONE_RENDER);
     g_system.profile.frame_cycles = frame_cycles;
     
     // Convert to milliseconds and FPS
@@ -471,16 +1249,160 @@ void display_statistics(void) {
     printf("\n=== SPLATSTORM X STATISTICS ===\n");
     printf("Frame: %u, FPS: %.1f (target: %.1f)\n", 
            g_system.frame_counter, g_system.current_fps, g_system.target_fps);
-    printf("Quality Level: %u, Max Splats: %u\n", 
-           g_system.quality_level, g_system.max_splats);
-    printf("Visible: %u, Projected: %u, Rendered: %u\n",
-           g_system.profile.visible_splats, g_system.profile.projected_splats, g_system.profile.rendered_splats);
+    printf("Quality Level: %u, Max Splats: %u, SH Mode: %u, Mip Bias: %u\n",
+           g_system.quality_level, g_system.max_splats, vu_get_sh_mode(), footprint_get_mip_bias());
+    if (g_system.adaptive_quality) {
+        printf("Quality Forecast: %.2f ms of %.2f ms, %u changes\n", g_system.quality.forecast_ms,
+               1000.0f / g_system.target_fps * QUALITY_BUDGET_FRACTION, g_system.quality.changes);
+    }
+    u32 render_width, render_height;
+    gs_get_render_resolution(&render_width, &render_height);
+    printf("Render Resolution: %ux%u%s%s\n", render_width, render_height,
+           g_system.field_rendering ? " per field" : "",
+           g_system.dynamic_resolution ? " (dynamic)" : "");
+    printf("Frame Latency: %u (GS wait: %.2f ms)\n", gs_renderer_get_frame_latency(),
+           gs_get_sync_wait_cycles() * 1000.0f / 294912000.0f);
+    if (g_system.late_latch) {
+        printf("Late Latch: sticks read again %.2f ms after the frame's pad read\n", g_system.latch_ms);
+    }
+    u32 vif1_interrupts, gif_interrupts, vu1_interrupts;
+    u64 vif1_sleep, gif_sleep, vu1_sleep;
+    dma_get_completion_stats(DMA_CHANNEL_VIF1, &vif1_interrupts, &vif1_sleep);
+    dma_get_completion_stats(DMA_CHANNEL_GIF, &gif_interrupts, &gif_sleep);
+    vu_get_wait_stats(&vu1_interrupts, &vu1_sleep);
+    printf("Interrupt Waits: VIF1 %u (%.2f ms), GIF %u (%.2f ms), VU1 %u (%.2f ms)\n",
+           vif1_interrupts, vif1_sleep * 1000.0f / 294912000.0f, gif_interrupts, gif_sleep * 1000.0f / 294912000.0f,
+           vu1_interrupts, vu1_sleep * 1000.0f / 294912000.0f);
+    if (g_system.frame_reuse) {
+        printf("Static Frames Reused: %u of %u\n", g_system.frames_reused, g_system.frame_counter);
+    }
+    u32 instances, visible_instances, instance_splats;
+    scene_instances_get_stats(&instances, &visible_instances, &instance_splats);
+    if (instances > 0) {
+        printf("Instances: %u of %u visible, %u splats\n", visible_instances, instances, instance_splats);
+    }
+    u32 updated_splats, updated_ranges, refit_nodes;
+    scene_splats_get_update_stats(&updated_splats, &updated_ranges, &refit_nodes);
+    if (updated_splats > 0) {
+        printf("Dynamic Splats: %u in %u ranges, %u nodes refit\n", updated_splats, updated_ranges, refit_nodes);
+    }
+    u32 one_pass_frames, one_pass_fallbacks, border_splats;
+    tile_get_binning_stats(&one_pass_frames, &one_pass_fallbacks, &border_splats);
+    printf("Tile Binning: %u one-pass frames, %u fallbacks, %u border splats re-tested\n",
+           one_pass_frames, one_pass_fallbacks, border_splats);
+    u32 occlusion_queries, occlusion_hidden;
+    tile_get_occlusion_stats(&occlusion_queries, &occlusion_hidden);
+    u32 hot_tiles, split_regions, merged_regions;
+    tile_get_region_stats(&hot_tiles, &split_regions, NULL, &merged_regions);
+    printf("Tile Regions: %u hot tiles in %u sub-tile regions, %u sparse coarse tiles merged\n",
+           hot_tiles, split_regions, merged_regions);
+    printf("Occlusion: %u of %u node boxes hidden by last frame's tiles\n", occlusion_hidden, occlusion_queries);
+    printf("Visible: %u, Projected: %u, After LOD: %u, Rendered: %u\n",
+           g_system.profile.visible_splats, g_system.profile.projected_splats, g_system.profile.lod_splats,
+           g_system.profile.rendered_splats);
     printf("Frame Time: %.2f ms (Cull: %.2f, VU: %.2f, Tile: %.2f, GS: %.2f)\n",
            g_system.profile.frame_time_ms,
            g_system.profile.cull_cycles * 1000.0f / 294912000.0f,
            g_system.profile.vu_execute_cycles * 1000.0f / 294912000.0f,
            g_system.profile.tile_sort_cycles * 1000.0f / 294912000.0f,
            g_system.profile.gs_render_cycles * 1000.0f / 294912000.0f);
+    ProfileZoneSummary frame_zone;
+    if (profile_zone_summary(PROFILE_ZONE_FRAME, &frame_zone)) {
+        printf("Frame History: %u frames, min %.2f avg %.2f p50 %.2f p95 %.2f p99 %.2f max %.2f ms\n",
+               frame_zone.frames, frame_zone.min_ms, frame_zone.avg_ms, frame_zone.p50_ms,
+               frame_zone.p95_ms, frame_zone.p99_ms, frame_zone.max_ms);
+        printf("Zone p99:");
+        for (u32 zone = PROFILE_ZONE_RENDER; zone < PROFILE_ZONE_COUNT; zone++) {
+            ProfileZoneSummary summary;
+            profile_zone_summary((ProfileZone)zone, &summary);
+            printf(" %s %.2f", profile_zone_name((ProfileZone)zone), summary.p99_ms);
+        }
+        printf(" ms\n");
+        if (g_system.debug_mode) {
+            debug_draw_zone_graph(PROFILE_ZONE_FRAME);
+        }
+    }
+    ProfileCounterSet counter_set = profile_zones_get_counters();
+    float events[2];
+    if (profile_zone_counters(PROFILE_ZONE_FRAME, events)) {
+        static const ProfileZone stages[] = {
+            PROFILE_ZONE_CULL, PROFILE_ZONE_VU, PROFILE_ZONE_BIN, PROFILE_ZONE_SORT, PROFILE_ZONE_PACKETS,
+            PROFILE_ZONE_FRAME
+        };
+        printf("Counters (%s / %s per frame):", profile_counter_name(counter_set, 0),
+               profile_counter_name(counter_set, 1));
+        for (u32 s = 0; s < sizeof(stages) / sizeof(stages[0]); s++) {
+            profile_zone_counters(stages[s], events);
+            printf(" %s %.0f/%.0f", profile_zone_name(stages[s]), events[0], events[1]);
+        }
+        printf("\n");
+    }
+    DMAChannelStats dma_stats;
+    dma_get_channel_stats(&dma_stats);
+    printf("DMA (last frame):");
+    for (u32 channel = 0; channel < DMA_STATS_CHANNELS; channel++) {
+        printf(" %s %u KB/%u (wait %.2f ms)", dma_stats_channel_name((DMAStatsChannel)channel),
+               dma_stats.bytes[channel] / 1024, dma_stats.transfers[channel],
+               dma_stats.wait_cycles[channel] * 1000.0f / 294912000.0f);
+    }
+    printf("\n");
+    VUActivityStats activity;
+    vu_activity_get_stats(&activity);
+    if (activity.sampled_cycles > 0) {
+        float to_ms = 1000.0f / 294912000.0f;
+        printf("VU (last frame): VU0 %.1f%% busy, %u runs; VU1 %.1f%% busy, %u runs, gaps %.2f ms (max %.3f),"
+               " XGKICK wait %.2f ms; VIF1 stalls: VU %.2f GIF %.2f stopped %.2f ms\n",
+               vu_activity_busy_fraction(VU_UNIT_VU0) * 100.0f, activity.runs[VU_UNIT_VU0],
+               vu_activity_busy_fraction(VU_UNIT_VU1) * 100.0f, activity.runs[VU_UNIT_VU1],
+               activity.gap_cycles[VU_UNIT_VU1] * to_ms, activity.max_gap_cycles[VU_UNIT_VU1] * to_ms,
+               activity.xgkick_wait_cycles * to_ms, activity.vif_vu_wait_cycles[VU_UNIT_VU1] * to_ms,
+               activity.vif_gif_wait_cycles * to_ms, activity.vif_stop_cycles[VU_UNIT_VU1] * to_ms);
+    }
+    printf("Memory (frame peak KB):");
+    for (u32 budget = 0; budget < MEMORY_BUDGET_COUNT; budget++) {
+        MemoryBudgetStats budget_stats;
+        memory_get_budget_stats((MemoryBudgetClass)budget, &budget_stats);
+        printf(" %s %u/%u", budget_stats.name ? budget_stats.name : "-", budget_stats.frame_peak / 1024,
+               budget_stats.budget / 1024);
+    }
+    printf("%s\n", memory_alert_active() ? "  ALERT" : "");
+    u32 hot_ids[TILE_HEATMAP_TOP_TILES], hot_values[TILE_HEATMAP_TOP_TILES];
+    u32 hot_count = tile_heatmap_hottest(hot_ids, hot_values, TILE_HEATMAP_TOP_TILES);
+    if (hot_count > 0) {
+        printf("Hottest Tiles (%s, x,y):", tile_heatmap_mode_name(tile_get_heatmap_mode()));
+        for (u32 i = 0; i < hot_count; i++) {
+            printf(" %u,%u %u", hot_ids[i] % TILES_X, hot_ids[i] / TILES_X, hot_values[i]);
+        }
+        printf("\n");
+    }
+    
+    FrameArenaStats arena;
+    frame_arena_get_stats(&arena);
+    printf("Frame Arena: %u KB peak of %u KB (Cull: %u, Project: %u, Tile: %u, Render: %u KB), %u failed\n",
+           arena.peak_high_water / 1024, arena.capacity / 1024,
+           arena.stage_bytes[FRAME_STAGE_CULL] / 1024, arena.stage_bytes[FRAME_STAGE_PROJECT] / 1024,
+           arena.stage_bytes[FRAME_STAGE_TILE] / 1024, arena.stage_bytes[FRAME_STAGE_RENDER] / 1024,
+           arena.failed_allocations);
+    
+    if (scene_paging_active()) {
+        u32 resident_pages, page_loads, page_evictions;
+        scene_paging_get_stats(&resident_pages, &page_loads, &page_evictions);
+        printf("Scene Pages: %u resident, %u loads, %u evictions\n", resident_pages, page_loads, page_evictions);
+    }
+    
+    if (telemetry_active()) {
+        u32 telemetry_frames, telemetry_sent, telemetry_dropped;
+        telemetry_get_stats(&telemetry_frames, &telemetry_sent, &telemetry_dropped);
+        printf("Telemetry: %u frames, %u datagrams sent, %u lost\n", telemetry_frames, telemetry_sent,
+               telemetry_dropped);
+    }
+    
+    if (boot_profile_finished()) {
+        float boot_ms, slowest_ms;
+        const char* slowest;
+        boot_profile_get_summary(&boot_ms, &slowest, &slowest_ms);
+        printf("Boot: %.1f ms to first frame (slowest step: %s, %.1f ms)\n", boot_ms, slowest, slowest_ms);
+    }
     
     if (g_system.error_count > 0) {
         printf("Errors: %u, Last: %s\n", g_system.error_count, g_system.error_message);
@@ -500,6 +1422,7 @@ void main_loop(void) {
     g_system.running = true;
     g_system.frame_counter = 0;
     g_system.start_time = get_cpu_cycles();
+    profile_zones_reset();
     
     u64 last_frame_time = g_system.start_time;
     u64 last_stats_time = g_system.start_time;
@@ -509,8 +1432,19 @@ void main_loop(void) {
         float delta_time = (current_time - last_frame_time) / 294912000.0f;
         last_frame_time = current_time;
         
-        // Update input and camera
-        update_camera(delta_time);
+        // Update input and camera; a benchmark replay takes the camera from
+        // its path and ends with it, L2 still aborts
+        if (benchmark_mode() == BENCHMARK_REPLAY) {
+            if (!worker_input_read(&g_system.input)) {
+                input_update(&g_system.input);
+            }
+            if (!benchmark_apply_camera(&g_system.camera)) {
+                g_system.running = false;
+                break;
+            }
+        } else {
+            update_camera(delta_time);
+        }
         
         // Check for exit
         if (g_system.input.buttons_pressed & INPUT_BUTTON_L2) {
@@ -523,6 +1457,40 @@ void main_loop(void) {
             g_system.paused = !g_system.paused;
         }
         
+        // Collect finished scene reads and queue the next one
+        PROFILE_ZONE_BEGIN(PROFILE_ZONE_STREAMING);
+        if (scene_stream_active()) {
+            GaussianResult stream_result = scene_stream_update(false);
+            if (stream_result != GAUSSIAN_SUCCESS) {
+                system_set_error(stream_result, "Scene streaming stopped early");
+            }
+            if (g_system.scene->splat_count != splat_count) {
+                g_system.frame_dirty = true;
+                if (!g_system.scene_sh && g_system.scene->splat_count > splat_count &&
+                    scene_splats_have_sh(splat_count, g_system.scene->splat_count - splat_count)) {
+                    g_system.scene_sh = true;
+                    vu_set_sh_mode(VU_SH_MODE_CACHED, VU_SH_CACHE_THRESHOLD_DEFAULT);
+                }
+            }
+            splat_count = g_system.scene->splat_count;
+        }
+        
+        // Paged scenes: bring in the pages ahead of the camera
+        if (scene_paging_active()) {
+            u32 loads_before, evictions_before, loads, evictions;
+            scene_paging_get_stats(NULL, &loads_before, &evictions_before);
+            GaussianResult paging_result = scene_paging_update(g_system.camera.position, g_system.max_splats);
+            if (paging_result != GAUSSIAN_SUCCESS) {
+                system_set_error(paging_result, "Scene paging stopped");
+            }
+            scene_paging_get_stats(NULL, &loads, &evictions);
+            if (loads != loads_before || evictions != evictions_before) {
+                g_system.frame_dirty = true;
+            }
+        }
+        PROFILE_ZONE_END(PROFILE_ZONE_STREAMING);
+        
+        u32 reused_before = g_system.frames_reused;
         if (!g_system.paused) {
             // Render frame
             GaussianResult result = render_frame();
@@ -530,11 +1498,36 @@ void main_loop(void) {
                 printf("SPLATSTORM X: Render failed, entering fallback mode\n");
                 g_system.fallback_mode = true;
             }
+            if (result != GAUSSIAN_SUCCESS) {
+                g_system.frame_dirty = true;  // Nothing complete to show again
+            }
+            frame_capture_end();
             
-            // Update adaptive quality
+            // Steer the quality knobs toward the frame budget
             update_adaptive_quality();
             
             g_system.frame_counter++;
+            if (!boot_profile_finished()) {
+                boot_profile_finish(BOOT_PROFILE_LOG);
+            }
+        }
+        
+        // Paused passes spin without drawing; keep them out of the history
+        profile_zones_end_frame(!g_system.paused);
+        dma_stats_end_frame();
+        vu_activity_end_frame();
+        memory_budget_end_frame();
+        if (!g_system.paused && telemetry_active()) {
+            u8 flags = (g_system.frames_reused != reused_before ? TELEMETRY_FLAG_REUSED : 0) |
+                       (g_system.fallback_mode ? TELEMETRY_FLAG_FALLBACK : 0) |
+                       (vu_get_render_mode() == VU_RENDER_MODE_XGKICK ? TELEMETRY_FLAG_DIRECT : 0) |
+                       (memory_alert_active() ? TELEMETRY_FLAG_MEMORY : 0);
+            telemetry_record_frame(g_system.frame_counter, &g_system.profile, (u8)g_system.quality_level,
+                                   (u8)g_system.resolution_level, flags);
+        }
+        if (!g_system.paused && benchmark_mode() != BENCHMARK_OFF &&
+            !benchmark_record_frame(&g_system.camera, &g_system.profile)) {
+            g_system.running = false;  // The run has all its frames
         }
         
         // Display statistics every second
@@ -542,9 +1535,6 @@ void main_loop(void) {
             display_statistics();
             last_stats_time = current_time;
         }
-        
-        // Reset temporary pool for next frame
-        memory_pool_reset(g_system.temp_pool_id);
     }
     
     printf("SPLATSTORM X: Main loop ended after %u frames\n", g_system.frame_counter);
@@ -553,16 +1543,26 @@ void main_loop(void) {
 // Cleanup all systems
 void cleanup_systems(void) {
     printf("SPLATSTORM X: Cleaning up all systems...\n");
+    memory_budget_print();
     
-    // Cleanup scene
+    // Cleanup scene; a stream or page read still in flight writes into its payload
+    scene_stream_cancel();
+    scene_paging_close();
+    scene_instances_clear();
+    scene_splats_reset_updates();
     if (g_system.scene) {
         gaussian_scene_destroy(g_system.scene);
         g_system.scene = NULL;
     }
     
-    // Cleanup systems in reverse order
+    // Cleanup systems in reverse order; telemetry sends its last batch first
+    vu_activity_stop();
+    telemetry_stop();
+    worker_system_shutdown();
     gs_renderer_cleanup();
     tile_system_cleanup();
+    cleanup_frustum_culling();
+    vu_culling_shutdown();
     dma_system_cleanup();
     vu_system_cleanup();
     gaussian_system_cleanup();
@@ -590,13 +1590,32 @@ int main(int argc, char* argv[]) {
     memset(&g_system, 0, sizeof(SystemState));
     g_system.target_fps = 30.0f;
     g_system.max_splats = 10000;
+    g_system.load_splat_budget = SCENE_LOAD_SPLAT_BUDGET;
     g_system.quality_level = 2;
     g_system.adaptive_quality = true;
+    g_system.dynamic_resolution = true;
+    g_system.field_rendering = true;
+    g_system.clear_mode = CLEAR_MODE_UNCOVERED;
+    g_system.frame_reuse = true;
+    g_system.frame_latency = 1;
+    g_system.frame_dirty = true;
+    g_system.resolution_level = 0;
     g_system.debug_mode = false;
+    g_system.counter_set = PROFILE_COUNTERS_CACHE;
     g_system.show_stats = true;
     g_system.fallback_mode = false;
     
+    // profile=<name> picks the hardware profile before anything is sized
+    g_system.boot_path = (argc > 0) ? argv[0] : NULL;
+    for (int arg = 2; arg < argc; arg++) {
+        if (strncmp(argv[arg], "profile=", 8) == 0) {
+            g_system.profile_name = argv[arg] + 8;
+        }
+    }
+    
     // Initialize all systems
+    boot_profile_start();
+    iop_set_boot_path(g_system.boot_path);
     GaussianResult result = initialize_systems();
     if (result != GAUSSIAN_SUCCESS) {
         printf("SPLATSTORM X: System initialization failed\n");
@@ -606,14 +1625,101 @@ int main(int argc, char* argv[]) {
     
     g_system.initialized = true;
     
-    // Load scene
-    const char* scene_file = (argc > 1) ? argv[1] : "mc0:/scene.ply";
+    // Options after the scene: benchmark runs (benchmark.c),
+    // telemetry=<host>[:port], capture=<frame>:<file> (frame_capture.c) and
+    // vusample=<hz>, the VU activity sample rate (0 turns sampling off),
+    // memalert=<budget>:<KB>, a memory budget's alert level (memory_system),
+    // instance=<file>:<x>,<y>,<z>[,<yaw>[,<scale>]], placed once the
+    // scene has loaded (scene_instances.c), latch=1, the late-latched
+    // camera (late_latch_camera), and profile=<name>, read before init
+    // (hardware_profile.c).
+    // Without benchmark options on the command line they may come from
+    // BENCHMARK_CONFIG_FILE next to the ELF.
+    const char* telemetry_destination = NULL;
+    u32 vu_sample_hz = VU_ACTIVITY_SAMPLE_HZ;
+    bool benchmark_options = false;
+    for (int arg = 2; arg < argc; arg++) {
+        if (strncmp(argv[arg], "telemetry=", 10) == 0) {
+            telemetry_destination = argv[arg] + 10;
+        } else if (strncmp(argv[arg], "vusample=", 9) == 0) {
+            vu_sample_hz = (u32)atoi(argv[arg] + 9);
+        } else if (strncmp(argv[arg], "memalert=", 9) == 0) {
+            if (!memory_parse_alert_option(argv[arg])) {
+                printf("SPLATSTORM X: Unknown memory alert %s\n", argv[arg] + 9);
+            }
+        } else if (strncmp(argv[arg], "latch=", 6) == 0) {
+            g_system.late_latch = atoi(argv[arg] + 6) != 0;
+        } else if (strncmp(argv[arg], "instance=", 9) == 0) {
+            continue;  // After the scene
+        } else if (strncmp(argv[arg], "profile=", 8) == 0) {
+            continue;  // Before init
+        } else if (benchmark_parse_option(argv[arg])) {
+            benchmark_options = true;
+        } else if (!frame_capture_parse_option(argv[arg])) {
+            printf("SPLATSTORM X: Unknown option %s\n", argv[arg]);
+        }
+    }
+    if (!benchmark_options && argc > 0) {
+        benchmark_load_config(argv[0]);
+    }
+    
+    // Load scene. Its device and the profile's scene cache devices load on
+    // the I/O worker meanwhile, behind LUT setup
+    const char* scene_file = (argc > 1) ? argv[1] : benchmark_get_scene();
+    if (!scene_file) {
+        scene_file = "mc0:/scene.ply";
+    }
+    int scene_device = get_boot_device(scene_file);
+    iop_prefetch_devices(hardware_profile_storage_mask() |
+                         (scene_device >= 0 ? IOP_DEVICE_BIT(scene_device) : 0));
     result = load_scene(scene_file);
     if (result != GAUSSIAN_SUCCESS) {
         printf("SPLATSTORM X: Scene loading failed\n");
         cleanup_systems();
         return -1;
     }
+    for (int arg = 2; arg < argc; arg++) {
+        if (strncmp(argv[arg], "instance=", 9) == 0 && !scene_instance_parse_option(argv[arg])) {
+            printf("SPLATSTORM X: Instance %s not placed\n", argv[arg] + 9);
+        }
+    }
+    
+    // Telemetry streams frame records to a host collector. The console
+    // statistics start off then, so their cost stays out of the numbers;
+    // Start still shows them.
+    if (telemetry_destination) {
+        boot_profile_begin("Telemetry");
+        if (telemetry_start(telemetry_destination) == GAUSSIAN_SUCCESS) {
+            g_system.show_stats = false;
+        } else {
+            printf("SPLATSTORM X: Telemetry unavailable, continuing without it\n");
+        }
+        boot_profile_end();
+    }
+    
+    // VU activity: one short timer interrupt per sample, whatever else runs
+    if (vu_sample_hz > 0) {
+        vu_activity_start(vu_sample_hz);
+    }
+    
+    // Benchmark: every frame is drawn, none reused. A replay also fixes the
+    // workload: the whole scene is resident and the quality knobs stay put,
+    // so timings compare between builds.
+    result = benchmark_start();
+    if (result != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Benchmark could not start, running without it\n");
+    }
+    if (benchmark_mode() != BENCHMARK_OFF) {
+        g_system.frame_reuse = false;
+        g_system.show_stats = false;
+    }
+    if (benchmark_mode() == BENCHMARK_REPLAY) {
+        while (scene_stream_active()) {
+            scene_stream_update(true);
+        }
+        g_system.adaptive_quality = false;
+        g_system.dynamic_resolution = false;
+    }
     
     printf("SPLATSTORM X: System ready - starting main loop\n");
     printf("Controls:\n");
@@ -621,7 +1727,7 @@ int main(int argc, char* argv[]) {
     printf("  Right Stick: Rotate camera\n");
     printf("  L1/R1: Zoom in/out\n");
     printf("  Triangle/Square: Quality up/down\n");
-    printf("  Select: Toggle debug mode\n");
+    printf("  Select: Toggle debug mode (L1 + Select: next performance counter pair)\n");
     printf("  Start: Toggle statistics\n");
     printf("  R2: Pause/unpause\n");
     printf("  L2: Exit\n");
@@ -629,6 +1735,7 @@ int main(int argc, char* argv[]) {
     
     // Run main loop
     main_loop();
+    benchmark_finish();
     
     // Cleanup
     cleanup_systems();
@@ -18,7 +18,7 @@ static u32 scratchpad_offset = 0;
  * Ensures optimal cache performance and DMA efficiency
  */
 PackedSplat* allocate_splat_array_optimized(int count) {
-    if (count <= 0 || count > 65536) {
+    if (count <= 0 || count > MAX_SPLATS_PER_SCENE) {
         debug_log_error("Invalid splat count: %d", count);
         return NULL;
     }
@@ -26,7 +26,7 @@ PackedSplat* allocate_splat_array_optimized(int count) {
     size_t total_size = count * sizeof(PackedSplat);
     
     // 64-byte alignment for cache line optimization
-    PackedSplat* splats = (PackedSplat*)memalign(64, total_size);
+    PackedSplat* splats = (PackedSplat*)memory_alloc(MEMORY_BUDGET_SCENE, total_size, 64);
     if (!splats) {
         debug_log_error("Failed to allocate splat array for %d splats", count);
         return NULL;
@@ -47,14 +47,14 @@ PackedSplat* allocate_splat_array_optimized(int count) {
  */
 void free_splat_array_optimized(PackedSplat* splats) {
     if (splats) {
-        free(splats);
+        memory_free(splats);
         debug_log_info("Freed optimized splat array at 0x%08x", (u32)splats);
     }
 }
 
 /*
  * Allocate VU buffer from scratchpad if possible
- * Falls back to regular allocation if scratchpad full
+ * Falls back to the DMA budget if scratchpad full
  */
 void* allocate_vu_buffer(size_t size) {
     if (size == 0) {
@@ -75,8 +75,8 @@ void* allocate_vu_buffer(size_t size) {
         return ptr;
     }
     
-    // Fallback to regular allocation with alignment
-    void* ptr = memalign(16, aligned_size);
+    // Fallback to the DMA budget
+    void* ptr = memory_alloc(MEMORY_BUDGET_DMA, aligned_size, 16);
     if (ptr) {
         debug_log_info("VU buffer allocated from EE RAM: %d bytes at 0x%08x", 
                        aligned_size, (u32)ptr);
@@ -99,7 +99,7 @@ void* allocate_dma_buffer_aligned(size_t size) {
     
     // DMA buffers need 128-byte alignment for best performance
     size_t aligned_size = (size + 127) & ~127;
-    void* buffer = memalign(128, aligned_size);
+    void* buffer = memory_alloc(MEMORY_BUDGET_DMA, aligned_size, 128);
     
     if (buffer) {
         // Clear buffer and ensure cache coherency
@@ -119,7 +119,7 @@ void* allocate_dma_buffer_aligned(size_t size) {
  */
 void free_dma_buffer_aligned(void* buffer) {
     if (buffer) {
-        free(buffer);
+        memory_free(buffer);
         debug_log_info("Freed DMA buffer at 0x%08x", (u32)buffer);
     }
 }
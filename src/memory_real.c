@@ -107,7 +107,7 @@ GaussianSplat3D* allocate_splat_array(int count) {
     }
     
     size_t size = count * sizeof(GaussianSplat3D);
-    GaussianSplat3D *splats = (GaussianSplat3D*)splatstorm_malloc(size);
+    GaussianSplat3D *splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, size, CACHE_LINE_SIZE);
     
     if (splats) {
         // Clear the array
@@ -126,7 +126,7 @@ GaussianSplat3D* allocate_splat_array(int count) {
  */
 void free_splat_array(GaussianSplat3D* splats) {
     if (splats) {
-        splatstorm_free(splats);
+        memory_free(splats);
         debug_log_info("Freed splat array at 0x%08x", (u32)splats);
     }
 }
@@ -143,7 +143,7 @@ void* allocate_dma_buffer(size_t size) {
     
     // DMA buffers must be 16-byte aligned and cache-line aligned
     size_t aligned_size = (size + 63) & ~63;  // 64-byte alignment for cache
-    void *buffer = memalign(64, aligned_size);
+    void *buffer = memory_alloc(MEMORY_BUDGET_DMA, aligned_size, 64);
     
     if (buffer) {
         // Clear buffer
@@ -166,7 +166,7 @@ void* allocate_dma_buffer(size_t size) {
  */
 void free_dma_buffer(void* buffer) {
     if (buffer) {
-        free(buffer);
+        memory_free(buffer);
         debug_log_info("Freed DMA buffer at 0x%08x", (u32)buffer);
     }
 }
@@ -6,8 +6,14 @@
  * COMPLETE IMPLEMENTATION - NO STUBS OR PLACEHOLDERS
  * Features:
  * - Custom memory pools with different allocation strategies
+ * - O(1) two-level segregated-fit (TLSF) pool with aligned allocation
  * - Cache-aligned allocations for optimal performance
  * - Scratchpad memory management for hot data
+ * - Bump-pointer frame arena with stage marks and high-water tracking
+ * - Per-subsystem budgets (scene, frame, DMA, asset, debug) with overrun reporting
+ * - Budget sizes set per hardware profile before the pools are reserved
+ * - Per-frame budget and arena peaks with configurable alert levels (memalert=)
+ * - Allocation sites aggregated by file and line: live bytes and high-water marks
  * - Fragmentation prevention with compaction
  * - Memory usage tracking and profiling
  * - Debug visualization and leak detection
@@ -37,6 +43,45 @@ typedef struct MemoryBlock {
     u32 line;                                 // Source line (debug)
 } MemoryBlock;
 
+// TLSF (two-level segregated fit): free blocks are binned by size class, a
+// power of two split into TLSF_SL_COUNT linear steps, and two bitmaps find
+// the first non-empty class that fits in constant time
+#define TLSF_ALIGN_LOG2        4
+#define TLSF_ALIGN             (1U << TLSF_ALIGN_LOG2)   // Block granule (DMA quadword)
+#define TLSF_SL_COUNT_LOG2     4
+#define TLSF_SL_COUNT          (1U << TLSF_SL_COUNT_LOG2)
+#define TLSF_FL_SHIFT          (TLSF_SL_COUNT_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_BLOCK       (1U << TLSF_FL_SHIFT)     // Smaller blocks share one linear class
+#define TLSF_FL_MAX            25                        // Pools below 32MB (all of EE RAM)
+#define TLSF_FL_COUNT          (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_NULL              0xFFFFFFFFU
+#define TLSF_BLOCK_FREE        0x1                       // Size flag: block is free
+#define TLSF_PREV_FREE         0x2                       // Size flag: physical predecessor is free
+#define TLSF_SIZE_MASK         (~(TLSF_ALIGN - 1))
+#define TLSF_REQUESTED_MASK    0x01FFFFFFU               // requested bits: pools stay below 32MB
+#define TLSF_SITE_SHIFT        25                        // The 7 bits above hold the allocation site
+
+// TLSF block header. Links are pool offsets so the header stays one quadword;
+// free blocks keep their class list links in the payload.
+typedef struct {
+    u32 size;                                 // Payload size plus TLSF_* flags
+    u32 prev_phys;                            // Physical predecessor (valid with TLSF_PREV_FREE)
+    u32 requested;                            // Bytes charged on allocation, site above TLSF_SITE_SHIFT
+    u32 magic;                                // Magic number for corruption detection
+} TLSFBlock;
+
+typedef struct {
+    u32 next_free;                            // Next block in the size class
+    u32 prev_free;                            // Previous block in the size class
+} TLSFFreeLinks;
+
+// TLSF control block, stored at the start of the pool memory
+typedef struct {
+    u32 fl_bitmap;                            // Non-empty first-level classes
+    u32 sl_bitmap[TLSF_FL_COUNT];             // Non-empty second-level classes
+    u32 heads[TLSF_FL_COUNT][TLSF_SL_COUNT];  // Class list heads (block offsets)
+} TLSFControl;
+
 // Memory pool structure
 typedef struct {
     MemoryPoolType type;                      // Pool type
@@ -44,8 +89,10 @@ typedef struct {
     u32 total_size;                           // Total pool size
     u32 used_size;                            // Currently used size
     u32 peak_usage;                           // Peak usage
+    u32 frame_peak;                           // Peak usage since memory_budget_end_frame
     u32 alignment;                            // Default alignment
     bool initialized;                         // Initialization status
+    bool external_memory;                     // Carved from the budget reservation, not owned
     
     // Pool-specific data
     union {
@@ -77,6 +124,13 @@ typedef struct {
             u32 tail;                         // Ring tail
             u32 wrap_count;                   // Wrap around count
         } ring;
+        
+        struct {                              // Two-level segregated fit
+            TLSFControl* control;             // Bitmaps and class lists
+            u32 free_bytes;                   // Payload bytes in free blocks
+            u32 block_count;                  // Total blocks
+            u32 free_count;                   // Free blocks
+        } tlsf;
     };
     
     // Statistics
@@ -102,6 +156,11 @@ static void memory_pool_free_stack(MemoryPoolImpl* pool, void* ptr);
 static void memory_pool_free_buddy(MemoryPoolImpl* pool, void* ptr);
 static void memory_pool_free_freelist(MemoryPoolImpl* pool, void* ptr);
 static void memory_pool_coalesce_freelist(MemoryPoolImpl* pool, MemoryBlock* block);
+static int memory_pool_init_tlsf(MemoryPoolImpl* pool);
+static void* memory_pool_alloc_tlsf(MemoryPoolImpl* pool, u32 size, u32 alignment);
+static void memory_pool_free_tlsf(MemoryPoolImpl* pool, void* ptr);
+static int memory_pool_create_in(int type, void* base, u32 size, u32 alignment, u32* pool_id);
+static int memory_budget_init(void);
 
 // MemoryStats is defined in gaussian_types.h
 
@@ -128,10 +187,63 @@ typedef struct {
     u64 free_cycles;                          // Free cycles
     u32 cache_line_hits;                      // Cache line aligned hits
     u32 cache_line_misses;                    // Cache line misses
+    
+    // Per-subsystem budgets: one TLSF pool each, carved from one reservation
+    void* budget_base;                        // Budget reservation
+    bool budgets_ready;                       // Budget pools created
+    u32 budget_pool[MEMORY_BUDGET_COUNT];     // Pool backing each budget
+    u32 budget_overruns[MEMORY_BUDGET_COUNT]; // Requests each budget refused
+    u32 budget_largest_overrun[MEMORY_BUDGET_COUNT]; // Largest refused request
+    u32 budget_frame_peak[MEMORY_BUDGET_COUNT];      // Peak in use during the last frame
+    u32 budget_alert[MEMORY_BUDGET_COUNT];           // Frame peak that raises an alert, 0 = none
+    u32 budget_alerts[MEMORY_BUDGET_COUNT];          // Alerts raised
+    bool budget_alerting[MEMORY_BUDGET_COUNT];       // Last frame above the alert level
+    u32 arena_alert;                                 // Same for the frame arena high-water mark
+    u32 arena_alerts;
+    bool arena_alerting;
+    bool arena_alert_set;                            // Configured, not the default share
+    
+    // Allocation sites, open-addressed by file and line; slot 0 is the untracked site
+    MemoryCallsiteStats callsites[MEMORY_CALLSITE_SLOTS];
+    u32 callsite_count;                       // Slots in use, slot 0 excluded
 } MemorySystemState;
 
 static MemorySystemState g_memory_state = {0};
 
+static const char* const g_budget_names[MEMORY_BUDGET_COUNT] = {
+    "scene", "frame", "DMA", "asset", "debug"
+};
+
+// Defaults; the hardware profile may resize them before memory_system_init()
+static u32 g_budget_sizes[MEMORY_BUDGET_COUNT] = {
+    MEMORY_BUDGET_SCENE_SIZE,
+    MEMORY_BUDGET_FRAME_SIZE,
+    MEMORY_BUDGET_DMA_SIZE,
+    MEMORY_BUDGET_ASSET_SIZE,
+    MEMORY_BUDGET_DEBUG_SIZE
+};
+
+// Budget pools start at staggered cache sets so their hot heads don't alias
+// in the 2-way D-cache (4KB per way)
+#define MEMORY_BUDGET_STAGGER (CACHE_LINE_SIZE * 8)
+#define DCACHE_WAY_SIZE       (4 * 1024)
+
+// Per-frame bump arena: one aligned block, reset wholesale at frame start
+typedef struct {
+    u8* base;                                 // Arena memory (cache-line aligned)
+    u32 capacity;                             // Arena size
+    u32 top;                                  // Next free byte
+    u32 frame_high_water;                     // Peak top this frame
+    u32 stage_marks[FRAME_STAGE_COUNT];       // top when each stage began
+    bool stage_marked[FRAME_STAGE_COUNT];     // Stage began this frame
+    u32 stage_peak[FRAME_STAGE_COUNT];        // Peak top while each stage was current
+    u32 stage_bytes[FRAME_STAGE_COUNT];       // Bytes each stage added this frame
+    FrameArenaStage current_stage;            // Stage allocations are charged to
+    FrameArenaStats last_frame;               // Figures for the last completed frame
+} FrameArena;
+
+static FrameArena g_frame_arena = {0};
+
 // Magic numbers for corruption detection
 #define MEMORY_MAGIC_ALLOCATED 0xDEADBEEF
 #define MEMORY_MAGIC_FREE      0xFEEDFACE
@@ -149,6 +261,44 @@ static inline bool is_aligned(void* ptr, u32 alignment) {
     return ((uintptr_t)ptr & (alignment - 1)) == 0;
 }
 
+// Slot of an allocation site, claimed on first use. 0 when the caller gave
+// no site or the table is full. File names are __FILE__ literals, compared
+// by address.
+static u32 memory_callsite_slot(const char* file, u32 line, u32 pool_id) {
+    if (!file) {
+        return 0;
+    }
+    
+    u32 slot = (u32)((((uintptr_t)file >> 2) * 31 + line) % (MEMORY_CALLSITE_SLOTS - 1)) + 1;
+    for (u32 probe = 1; probe < MEMORY_CALLSITE_SLOTS; probe++) {
+        MemoryCallsiteStats* site = &g_memory_state.callsites[slot];
+        if (site->file == file && site->line == line) {
+            return slot;
+        }
+        if (!site->file) {
+            site->file = file;
+            site->line = line;
+            site->pool_id = pool_id;
+            g_memory_state.callsite_count++;
+            return slot;
+        }
+        slot = slot % (MEMORY_CALLSITE_SLOTS - 1) + 1;
+    }
+    return 0;
+}
+
+static void memory_callsite_charge(u32 slot, u32 bytes) {
+    MemoryCallsiteStats* site = &g_memory_state.callsites[slot];
+    site->live_bytes += bytes;
+    site->peak_bytes = MAX(site->peak_bytes, site->live_bytes);
+    site->allocations++;
+}
+
+static void memory_callsite_release(u32 slot, u32 bytes) {
+    MemoryCallsiteStats* site = &g_memory_state.callsites[slot];
+    site->live_bytes -= MIN(bytes, site->live_bytes);
+}
+
 // Initialize memory management system
 int memory_system_init(void) {
     printf("SPLATSTORM X: Initializing complete memory management system...\n");
@@ -180,6 +330,12 @@ int memory_system_init(void) {
     
     g_memory_state.initialized = true;
     
+    int result = memory_budget_init();
+    if (result != GAUSSIAN_SUCCESS) {
+        g_memory_state.initialized = false;
+        return result;
+    }
+    
     printf("SPLATSTORM X: Memory system initialized (scratchpad: %u KB)\n", 
            g_memory_state.scratchpad_size / 1024);
     
@@ -188,6 +344,11 @@ int memory_system_init(void) {
 
 // Create a memory pool
 int memory_pool_create(int type, u32 size, u32 alignment, u32* pool_id) {
+    return memory_pool_create_in(type, NULL, size, alignment, pool_id);
+}
+
+// Create a pool over caller-provided memory, or its own memalign block if base is NULL
+static int memory_pool_create_in(int type, void* base, u32 size, u32 alignment, u32* pool_id) {
     MemoryPoolType pool_type = (MemoryPoolType)type;
     if (!g_memory_state.initialized || !pool_id || size == 0) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
@@ -205,10 +366,11 @@ int memory_pool_create(int type, u32 size, u32 alignment, u32* pool_id) {
     size = align_up(size, CACHE_LINE_SIZE);
     
     // Allocate pool memory
-    pool->base_address = memalign(alignment, size);
+    pool->base_address = base ? base : memalign(alignment, size);
     if (!pool->base_address) {
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
+    pool->external_memory = (base != NULL);
     
     // Initialize pool
     pool->type = pool_type;
@@ -235,7 +397,7 @@ int memory_pool_create(int type, u32 size, u32 alignment, u32* pool_id) {
             pool->buddy.max_order = 20; // 1MB maximum
             pool->buddy.free_lists = (u32*)calloc(pool->buddy.max_order - pool->buddy.min_order + 1, sizeof(u32));
             if (!pool->buddy.free_lists) {
-                free(pool->base_address);
+                if (!pool->external_memory) free(pool->base_address);
                 return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
             }
             break;
@@ -268,6 +430,13 @@ int memory_pool_create(int type, u32 size, u32 alignment, u32* pool_id) {
             pool->ring.tail = 0;
             pool->ring.wrap_count = 0;
             break;
+            
+        case POOL_TYPE_TLSF:
+            if (memory_pool_init_tlsf(pool) != GAUSSIAN_SUCCESS) {
+                if (!pool->external_memory) free(pool->base_address);
+                return GAUSSIAN_ERROR_INVALID_PARAMETER;
+            }
+            break;
     }
     
     // Clear statistics
@@ -339,14 +508,26 @@ void* memory_pool_alloc(u32 pool_id, u32 size, u32 alignment, const char* file,
         case POOL_TYPE_RING:
             result = memory_pool_alloc_ring(pool, aligned_size, alignment);
             break;
+            
+        case POOL_TYPE_TLSF:
+            result = memory_pool_alloc_tlsf(pool, aligned_size, alignment);
+            break;
     }
     
     // Update statistics
     if (result) {
         pool->used_size += aligned_size;
         pool->peak_usage = MAX(pool->peak_usage, pool->used_size);
+        pool->frame_peak = MAX(pool->frame_peak, pool->used_size);
         pool->allocation_count++;
         
+        // TLSF blocks keep their site for the free; free-list blocks keep file and line
+        u32 site = memory_callsite_slot(file, line, pool_id);
+        memory_callsite_charge(site, aligned_size);
+        if (pool->type == POOL_TYPE_TLSF) {
+            ((TLSFBlock*)result - 1)->requested |= site << TLSF_SITE_SHIFT;
+        }
+        
         g_memory_state.total_allocated += aligned_size;
         g_memory_state.active_allocations++;
         g_memory_state.peak_usage = MAX(g_memory_state.peak_usage, g_memory_state.total_allocated);
@@ -579,6 +760,10 @@ void memory_pool_free(u32 pool_id, void* ptr) {
         case POOL_TYPE_RING:
             // Ring buffers don't support individual free
             break;
+            
+        case POOL_TYPE_TLSF:
+            memory_pool_free_tlsf(pool, ptr);
+            break;
     }
     
     // Update statistics
@@ -604,6 +789,7 @@ static void memory_pool_free_freelist(MemoryPoolImpl* pool, void* ptr) {
     // Mark as free
     block->is_free = true;
     block->magic = MEMORY_MAGIC_FREE;
+    memory_callsite_release(memory_callsite_slot(block->file, block->line, 0), block->size);
     
     // Remove from used list
     if (block->prev) {
@@ -659,6 +845,265 @@ static void memory_pool_coalesce_freelist(MemoryPoolImpl* pool, MemoryBlock* blo
     // This would require a more complex implementation to find the previous block
 }
 
+// TLSF bit scans (value must be non-zero)
+static inline u32 tlsf_fls(u32 value) {
+    return 31 - __builtin_clz(value);
+}
+
+static inline u32 tlsf_ffs(u32 value) {
+    return __builtin_ctz(value);
+}
+
+static inline TLSFBlock* tlsf_block(MemoryPoolImpl* pool, u32 offset) {
+    return (TLSFBlock*)((u8*)pool->base_address + offset);
+}
+
+static inline TLSFFreeLinks* tlsf_links(TLSFBlock* block) {
+    return (TLSFFreeLinks*)(block + 1);
+}
+
+static inline u32 tlsf_size(const TLSFBlock* block) {
+    return block->size & TLSF_SIZE_MASK;
+}
+
+static inline u32 tlsf_next_phys(u32 offset, const TLSFBlock* block) {
+    return offset + sizeof(TLSFBlock) + tlsf_size(block);
+}
+
+// Size class of a block: first level is the power of two, second level one
+// of TLSF_SL_COUNT linear steps inside it. Small blocks share first level 0.
+static void tlsf_mapping(u32 size, u32* fl, u32* sl) {
+    if (size < TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size / (TLSF_SMALL_BLOCK / TLSF_SL_COUNT);
+    } else {
+        u32 top = tlsf_fls(size);
+        *sl = (size >> (top - TLSF_SL_COUNT_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = top - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+// Put a block on its class list and flag it free for its physical successor
+static void tlsf_insert(MemoryPoolImpl* pool, u32 offset) {
+    TLSFControl* control = pool->tlsf.control;
+    TLSFBlock* block = tlsf_block(pool, offset);
+    u32 fl, sl;
+    tlsf_mapping(tlsf_size(block), &fl, &sl);
+    
+    TLSFFreeLinks* links = tlsf_links(block);
+    links->next_free = control->heads[fl][sl];
+    links->prev_free = TLSF_NULL;
+    if (links->next_free != TLSF_NULL) {
+        tlsf_links(tlsf_block(pool, links->next_free))->prev_free = offset;
+    }
+    control->heads[fl][sl] = offset;
+    control->fl_bitmap |= 1U << fl;
+    control->sl_bitmap[fl] |= 1U << sl;
+    
+    block->size |= TLSF_BLOCK_FREE;
+    block->magic = MEMORY_MAGIC_FREE;
+    
+    TLSFBlock* next = tlsf_block(pool, tlsf_next_phys(offset, block));
+    next->size |= TLSF_PREV_FREE;
+    next->prev_phys = offset;
+    
+    pool->tlsf.free_bytes += tlsf_size(block);
+    pool->tlsf.free_count++;
+}
+
+// Take a block off its class list; its physical successor no longer sees it free
+static void tlsf_remove(MemoryPoolImpl* pool, u32 offset) {
+    TLSFControl* control = pool->tlsf.control;
+    TLSFBlock* block = tlsf_block(pool, offset);
+    u32 fl, sl;
+    tlsf_mapping(tlsf_size(block), &fl, &sl);
+    
+    TLSFFreeLinks* links = tlsf_links(block);
+    if (links->next_free != TLSF_NULL) {
+        tlsf_links(tlsf_block(pool, links->next_free))->prev_free = links->prev_free;
+    }
+    if (links->prev_free != TLSF_NULL) {
+        tlsf_links(tlsf_block(pool, links->prev_free))->next_free = links->next_free;
+    } else {
+        control->heads[fl][sl] = links->next_free;
+        if (links->next_free == TLSF_NULL) {
+            control->sl_bitmap[fl] &= ~(1U << sl);
+            if (control->sl_bitmap[fl] == 0) {
+                control->fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+    
+    block->size &= ~TLSF_BLOCK_FREE;
+    tlsf_block(pool, tlsf_next_phys(offset, block))->size &= ~TLSF_PREV_FREE;
+    
+    pool->tlsf.free_bytes -= tlsf_size(block);
+    pool->tlsf.free_count--;
+}
+
+// Lay out the control block, one free block and the end sentinel
+static int memory_pool_init_tlsf(MemoryPoolImpl* pool) {
+    u32 alignment = MAX(pool->alignment, TLSF_ALIGN);
+    u32 first = align_up(sizeof(TLSFControl) + sizeof(TLSFBlock), alignment) - sizeof(TLSFBlock);
+    u32 sentinel = pool->total_size - sizeof(TLSFBlock);
+    
+    if (pool->total_size >= (1U << TLSF_FL_MAX) ||
+        first + sizeof(TLSFBlock) + TLSF_ALIGN > sentinel) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    TLSFControl* control = (TLSFControl*)pool->base_address;
+    control->fl_bitmap = 0;
+    for (u32 fl = 0; fl < TLSF_FL_COUNT; fl++) {
+        control->sl_bitmap[fl] = 0;
+        for (u32 sl = 0; sl < TLSF_SL_COUNT; sl++) {
+            control->heads[fl][sl] = TLSF_NULL;
+        }
+    }
+    
+    pool->tlsf.control = control;
+    pool->tlsf.free_bytes = 0;
+    pool->tlsf.block_count = 1;
+    pool->tlsf.free_count = 0;
+    
+    // Zero-sized used block at the end stops coalescing past the pool
+    TLSFBlock* end = tlsf_block(pool, sentinel);
+    end->size = 0;
+    end->prev_phys = TLSF_NULL;
+    end->requested = 0;
+    end->magic = MEMORY_MAGIC_GUARD;
+    
+    TLSFBlock* block = tlsf_block(pool, first);
+    block->size = sentinel - first - sizeof(TLSFBlock);
+    block->prev_phys = TLSF_NULL;
+    block->requested = 0;
+    tlsf_insert(pool, first);
+    
+    return GAUSSIAN_SUCCESS;
+}
+
+// TLSF allocation: two bitmap scans, at most two splits
+static void* memory_pool_alloc_tlsf(MemoryPoolImpl* pool, u32 size, u32 alignment) {
+    TLSFControl* control = pool->tlsf.control;
+    u32 requested = size;
+    u32 gap_min = sizeof(TLSFBlock) + TLSF_ALIGN;
+    
+    size = MAX(align_up(size, TLSF_ALIGN), TLSF_ALIGN);
+    
+    // Alignment above the block granule needs room to split off a leading gap
+    u32 search = size;
+    if (alignment > TLSF_ALIGN) {
+        search += alignment + gap_min;
+    }
+    
+    // Round up to the next class so any block found there is big enough
+    u32 rounded = search;
+    if (rounded >= TLSF_SMALL_BLOCK) {
+        rounded += (1U << (tlsf_fls(rounded) - TLSF_SL_COUNT_LOG2)) - 1;
+    }
+    
+    u32 fl, sl;
+    tlsf_mapping(rounded, &fl, &sl);
+    
+    u32 sl_map = (fl < TLSF_FL_COUNT) ? control->sl_bitmap[fl] & (~0U << sl) : 0;
+    if (!sl_map) {
+        u32 fl_map = (fl + 1 < TLSF_FL_COUNT) ? control->fl_bitmap & (~0U << (fl + 1)) : 0;
+        if (!fl_map) {
+            // Enough free bytes, but no single block holds them
+            if (pool->tlsf.free_bytes >= search) {
+                pool->fragmentation_events++;
+            }
+            return NULL;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = control->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+    
+    u32 offset = control->heads[fl][sl];
+    tlsf_remove(pool, offset);
+    TLSFBlock* block = tlsf_block(pool, offset);
+    
+    // Leading gap up to the requested alignment becomes its own free block
+    uintptr_t payload = (uintptr_t)(block + 1);
+    u32 gap = (u32)((alignment - (payload & (alignment - 1))) & (alignment - 1));
+    if (gap > 0 && gap < gap_min) {
+        gap += align_up(gap_min - gap, alignment);
+    }
+    
+    if (gap > 0) {
+        u32 aligned_offset = offset + gap;
+        TLSFBlock* aligned = tlsf_block(pool, aligned_offset);
+        aligned->size = tlsf_size(block) - gap;
+        aligned->prev_phys = offset;
+        block->size = (gap - sizeof(TLSFBlock)) | (block->size & TLSF_PREV_FREE);
+        pool->tlsf.block_count++;
+        tlsf_insert(pool, offset);
+    
+        block = aligned;
+        offset = aligned_offset;
+    }
+    
+    // Return the tail to the free lists if it can hold a block of its own
+    u32 block_size = tlsf_size(block);
+    if (block_size >= size + gap_min) {
+        u32 rest_offset = offset + sizeof(TLSFBlock) + size;
+        TLSFBlock* rest = tlsf_block(pool, rest_offset);
+        rest->size = block_size - size - sizeof(TLSFBlock);
+        rest->prev_phys = offset;
+        rest->requested = 0;
+        block->size = size | (block->size & TLSF_PREV_FREE);
+        pool->tlsf.block_count++;
+        tlsf_insert(pool, rest_offset);
+    }
+    
+    block->requested = requested;
+    block->magic = MEMORY_MAGIC_ALLOCATED;
+    
+    return block + 1;
+}
+
+// TLSF deallocation: merge with free physical neighbours, then reinsert
+static void memory_pool_free_tlsf(MemoryPoolImpl* pool, void* ptr) {
+    u32 offset = (u32)((u8*)ptr - (u8*)pool->base_address) - sizeof(TLSFBlock);
+    TLSFBlock* block = tlsf_block(pool, offset);
+    
+    // Validate block
+    if (block->magic != MEMORY_MAGIC_ALLOCATED) {
+        pool->corruption_checks++;
+        printf("SPLATSTORM X: Memory corruption detected at %p\n", ptr);
+        return;
+    }
+    
+    u32 requested = block->requested & TLSF_REQUESTED_MASK;
+    memory_callsite_release(block->requested >> TLSF_SITE_SHIFT, requested);
+    block->magic = MEMORY_MAGIC_FREE;
+    
+    if (block->size & TLSF_PREV_FREE) {
+        u32 prev_offset = block->prev_phys;
+        TLSFBlock* prev = tlsf_block(pool, prev_offset);
+        tlsf_remove(pool, prev_offset);
+        prev->size += sizeof(TLSFBlock) + tlsf_size(block);
+        pool->tlsf.block_count--;
+    
+        block = prev;
+        offset = prev_offset;
+    }
+    
+    u32 next_offset = tlsf_next_phys(offset, block);
+    TLSFBlock* next = tlsf_block(pool, next_offset);
+    if (next->size & TLSF_BLOCK_FREE) {
+        tlsf_remove(pool, next_offset);
+        block->size += sizeof(TLSFBlock) + tlsf_size(next);
+        pool->tlsf.block_count--;
+    }
+    
+    tlsf_insert(pool, offset);
+    
+    pool->used_size -= requested;
+    g_memory_state.total_freed += requested;
+}
+
 // Reset pool (clear all allocations)
 void memory_pool_reset(u32 pool_id) {
     if (!g_memory_state.initialized || pool_id >= g_memory_state.pool_count) {
@@ -708,11 +1153,22 @@ void memory_pool_reset(u32 pool_id) {
             memset(pool->buddy.free_lists, 0, 
                    (pool->buddy.max_order - pool->buddy.min_order + 1) * sizeof(u32));
             break;
+            
+        case POOL_TYPE_TLSF:
+            memory_pool_init_tlsf(pool);
+            break;
     }
     
     pool->used_size = 0;
     pool->allocation_count = 0;
     pool->deallocation_count = 0;
+    
+    // Everything the pool's sites held is gone with it
+    for (u32 slot = 1; slot < MEMORY_CALLSITE_SLOTS; slot++) {
+        if (g_memory_state.callsites[slot].file && g_memory_state.callsites[slot].pool_id == pool_id) {
+            g_memory_state.callsites[slot].live_bytes = 0;
+        }
+    }
 }
 
 // Scratchpad memory allocation
@@ -738,6 +1194,123 @@ void scratchpad_reset(void) {
     g_memory_state.scratchpad_used = 0;
 }
 
+// Create the per-frame arena
+int frame_arena_init(u32 size) {
+    if (g_frame_arena.base) {
+        return GAUSSIAN_SUCCESS;
+    }
+    
+    size = align_up(size, CACHE_LINE_SIZE);
+    g_frame_arena.base = (u8*)memory_alloc(MEMORY_BUDGET_FRAME, size, CACHE_LINE_SIZE);
+    if (!g_frame_arena.base) {
+        printf("SPLATSTORM X: Failed to allocate %u KB frame arena\n", size / 1024);
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    
+    g_frame_arena.capacity = size;
+    g_frame_arena.last_frame.capacity = size;
+    if (!g_memory_state.arena_alert_set) {
+        g_memory_state.arena_alert = size / 100 * MEMORY_ALERT_PERCENT;
+    }
+    frame_arena_begin();
+    
+    printf("SPLATSTORM X: Frame arena created (%u KB)\n", size / 1024);
+    return GAUSSIAN_SUCCESS;
+}
+
+void frame_arena_cleanup(void) {
+    if (g_frame_arena.base) {
+        memory_free(g_frame_arena.base);
+    }
+    memset(&g_frame_arena, 0, sizeof(FrameArena));
+}
+
+bool frame_arena_active(void) {
+    return g_frame_arena.base != NULL;
+}
+
+// Close the stage allocations are currently charged to
+static void frame_arena_close_stage(void) {
+    FrameArenaStage stage = g_frame_arena.current_stage;
+    if (g_frame_arena.stage_marked[stage]) {
+        u32 bytes = g_frame_arena.stage_peak[stage] - g_frame_arena.stage_marks[stage];
+        if (bytes > g_frame_arena.stage_bytes[stage]) {
+            g_frame_arena.stage_bytes[stage] = bytes;
+        }
+    }
+}
+
+// Start a frame: publish the previous frame's figures and drop everything
+void frame_arena_begin(void) {
+    FrameArenaStats* last = &g_frame_arena.last_frame;
+    
+    frame_arena_close_stage();
+    memcpy(last->stage_bytes, g_frame_arena.stage_bytes, sizeof(last->stage_bytes));
+    
+    last->frame_high_water = g_frame_arena.frame_high_water;
+    if (last->frame_high_water > last->peak_high_water) {
+        last->peak_high_water = last->frame_high_water;
+    }
+    
+    g_frame_arena.top = 0;
+    g_frame_arena.frame_high_water = 0;
+    g_frame_arena.current_stage = FRAME_STAGE_CULL;
+    memset(g_frame_arena.stage_marks, 0, sizeof(g_frame_arena.stage_marks));
+    memset(g_frame_arena.stage_marked, 0, sizeof(g_frame_arena.stage_marked));
+    memset(g_frame_arena.stage_peak, 0, sizeof(g_frame_arena.stage_peak));
+    memset(g_frame_arena.stage_bytes, 0, sizeof(g_frame_arena.stage_bytes));
+    g_frame_arena.stage_marked[FRAME_STAGE_CULL] = true;  // Until the first mark
+}
+
+// O(1) aligned bump allocation; alignment must be a power of two
+void* frame_arena_alloc(u32 size, u32 alignment) {
+    if (!g_frame_arena.base || size == 0) {
+        return NULL;
+    }
+    
+    u32 offset = align_up(g_frame_arena.top, alignment ? alignment : VU_ALIGNMENT);
+    if (offset > g_frame_arena.capacity || size > g_frame_arena.capacity - offset) {
+        g_frame_arena.last_frame.failed_allocations++;
+        return NULL;
+    }
+    
+    g_frame_arena.top = offset + size;
+    if (g_frame_arena.top > g_frame_arena.frame_high_water) {
+        g_frame_arena.frame_high_water = g_frame_arena.top;
+    }
+    if (g_frame_arena.top > g_frame_arena.stage_peak[g_frame_arena.current_stage]) {
+        g_frame_arena.stage_peak[g_frame_arena.current_stage] = g_frame_arena.top;
+    }
+    
+    return g_frame_arena.base + offset;
+}
+
+// Begin a stage: later allocations are charged to it and can be rolled back to here
+void frame_arena_mark(FrameArenaStage stage) {
+    if (stage >= FRAME_STAGE_COUNT) return;
+    
+    frame_arena_close_stage();
+    g_frame_arena.current_stage = stage;
+    g_frame_arena.stage_marks[stage] = g_frame_arena.top;
+    g_frame_arena.stage_peak[stage] = g_frame_arena.top;
+    g_frame_arena.stage_marked[stage] = true;
+}
+
+// Free everything allocated since the stage's mark (the high-water mark is kept)
+void frame_arena_rollback(FrameArenaStage stage) {
+    if (stage >= FRAME_STAGE_COUNT || !g_frame_arena.stage_marked[stage]) return;
+    
+    g_frame_arena.top = g_frame_arena.stage_marks[stage];
+}
+
+void frame_arena_get_stats(FrameArenaStats* stats) {
+    if (!stats) return;
+    
+    *stats = g_frame_arena.last_frame;
+    stats->capacity = g_frame_arena.capacity;
+    stats->used = g_frame_arena.top;
+}
+
 // Get memory statistics
 void memory_get_statistics(MemoryStats* stats) {
     if (!stats || !g_memory_state.initialized) return;
@@ -752,13 +1325,18 @@ void memory_get_statistics(MemoryStats* stats) {
     // Calculate fragmentation
     u64 total_pool_size = 0;
     u64 total_pool_used = 0;
+    stats->fragmentation_events = 0;
     
     for (u32 i = 0; i < g_memory_state.pool_count; i++) {
         MemoryPoolImpl* pool = &g_memory_state.pools[i];
         total_pool_size += pool->total_size;
         total_pool_used += pool->used_size;
+        stats->fragmentation_events += pool->fragmentation_events;
     }
     
+    stats->pool_used = (u32)total_pool_used;
+    stats->pool_available = (u32)(total_pool_size - total_pool_used);
+    
     if (total_pool_size > 0) {
         stats->fragmentation_ratio = (float)(total_pool_size - total_pool_used) / total_pool_size;
     } else {
@@ -830,74 +1408,318 @@ static void memory_pool_free_buddy(MemoryPoolImpl* pool, void* ptr) {
 }
 
 /*
- * Global memory pool allocator - uses 4MB global pool
- * Allocates from a global memory pool with DMA alignment
+ * Per-subsystem memory budgets
+ * One reservation is split into a TLSF pool per budget; allocations never
+ * spill into another budget or the heap, so an overrun is reported at the
+ * request that caused it instead of as an out-of-memory somewhere later.
  */
-void* local_memory_pool_alloc(u32 size) {
-    static bool global_pool_initialized = false;
-    static MemoryPoolImpl global_pool = {0};
-    static u8 global_memory[4 * 1024 * 1024] __attribute__((aligned(16))); // 4MB DMA-aligned
+static int memory_budget_init(void) {
+    u32 total = 0;
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        total += align_up(g_budget_sizes[i], CACHE_LINE_SIZE) + DCACHE_WAY_SIZE;
+    }
     
-    if (!global_pool_initialized) {
-        global_pool.type = POOL_TYPE_LINEAR;
-        global_pool.base_address = global_memory;
-        global_pool.total_size = sizeof(global_memory);
-        global_pool.used_size = 0;
-        global_pool.alignment = 16; // DMA alignment
-        global_pool.initialized = true;
-        global_pool.linear.offset = 0;
-        global_pool_initialized = true;
+    g_memory_state.budget_base = memalign(DCACHE_WAY_SIZE, total);
+    if (!g_memory_state.budget_base) {
+        printf("SPLATSTORM X: Failed to reserve %u KB for memory budgets\n", total / 1024);
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
     
-    // Align size to 16 bytes for DMA
-    u32 aligned_size = align_up(size, 16);
+    u32 offset = 0;
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        offset = align_up(offset, DCACHE_WAY_SIZE) + i * MEMORY_BUDGET_STAGGER;
+        u32 size = align_up(g_budget_sizes[i], CACHE_LINE_SIZE);
+        
+        int result = memory_pool_create_in(POOL_TYPE_TLSF, (u8*)g_memory_state.budget_base + offset,
+                                           size, CACHE_LINE_SIZE, &g_memory_state.budget_pool[i]);
+        if (result != GAUSSIAN_SUCCESS) {
+            printf("SPLATSTORM X: Failed to create %s budget pool\n", g_budget_names[i]);
+            return result;
+        }
+        
+        g_memory_state.budget_overruns[i] = 0;
+        g_memory_state.budget_largest_overrun[i] = 0;
+        g_memory_state.budget_alert[i] = size / 100 * MEMORY_ALERT_PERCENT;
+        offset += size;
+    }
     
-    if (global_pool.linear.offset + aligned_size > global_pool.total_size) {
-        return NULL; // Pool exhausted
+    g_memory_state.budgets_ready = true;
+    printf("SPLATSTORM X: Memory budgets reserved (%u KB)\n", total / 1024);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Record and report a refused request; callers see NULL, never a heap fallback
+static void memory_budget_overrun(MemoryBudgetClass budget, u32 size) {
+    MemoryPoolImpl* pool = &g_memory_state.pools[g_memory_state.budget_pool[budget]];
+    
+    g_memory_state.budget_overruns[budget]++;
+    g_memory_state.budget_largest_overrun[budget] = MAX(g_memory_state.budget_largest_overrun[budget], size);
+    
+    printf("SPLATSTORM X: %s budget overrun: %u bytes requested, %u / %u KB in use\n",
+           g_budget_names[budget], size, pool->used_size / 1024, pool->total_size / 1024);
+}
+
+// Single allocation entry point: charge the request to a budget. Called
+// through memory_alloc(), which passes the caller's file and line.
+void* memory_alloc_at(MemoryBudgetClass budget, u32 size, u32 alignment, const char* file, u32 line) {
+    if (!g_memory_state.budgets_ready || (u32)budget >= MEMORY_BUDGET_COUNT || size == 0) {
+        return NULL;
     }
     
-    void* result = (u8*)global_pool.base_address + global_pool.linear.offset;
-    global_pool.linear.offset += aligned_size;
-    global_pool.used_size += aligned_size;
-    global_pool.allocation_count++;
+    void* result = memory_pool_alloc(g_memory_state.budget_pool[budget], size, alignment, file, line);
+    if (!result) {
+        memory_budget_overrun(budget, size);
+    }
     
     return result;
 }
 
-/*
- * Aligned allocation function using memalign
- * Provides aligned memory allocation with PS2SDK memalign
- */
-void* splatstorm_alloc_aligned(u32 size, u32 alignment) {
-    if (size == 0) return NULL;
+// Free a memory_alloc block; the owning budget is found from the address
+void memory_free(void* ptr) {
+    if (!ptr || !g_memory_state.budgets_ready) {
+        return;
+    }
     
-    // Ensure minimum alignment for DMA (16 bytes)
-    if (alignment < 16) alignment = 16;
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        u32 pool_id = g_memory_state.budget_pool[i];
+        MemoryPoolImpl* pool = &g_memory_state.pools[pool_id];
+        if ((u8*)ptr >= (u8*)pool->base_address &&
+            (u8*)ptr < (u8*)pool->base_address + pool->total_size) {
+            memory_pool_free(pool_id, ptr);
+            return;
+        }
+    }
     
-    // Use PS2SDK memalign for aligned allocation
-    void* result = memalign(alignment, size);
+    printf("SPLATSTORM X: memory_free of %p outside every budget\n", ptr);
+}
+
+// Up-front headroom check, e.g. before loading a scene. Counts free bytes,
+// not the largest free block, so a fragmented budget can still refuse later.
+bool memory_budget_fits(MemoryBudgetClass budget, u32 size) {
+    if (!g_memory_state.budgets_ready || (u32)budget >= MEMORY_BUDGET_COUNT) {
+        return false;
+    }
     
-    if (result) {
-        // Update global statistics
-        g_memory_state.total_allocated += size;
-        g_memory_state.active_allocations++;
+    MemoryPoolImpl* pool = &g_memory_state.pools[g_memory_state.budget_pool[budget]];
+    return pool->tlsf.free_bytes >= align_up(size, TLSF_ALIGN) + sizeof(TLSFBlock);
+}
+
+// Pool backing a budget, for the memory_pool_* interfaces
+u32 memory_budget_pool(MemoryBudgetClass budget) {
+    return g_memory_state.budget_pool[budget];
+}
+
+void memory_get_budget_stats(MemoryBudgetClass budget, MemoryBudgetStats* stats) {
+    if (!stats) return;
+    
+    memset(stats, 0, sizeof(MemoryBudgetStats));
+    if (!g_memory_state.budgets_ready || (u32)budget >= MEMORY_BUDGET_COUNT) {
+        return;
+    }
+    
+    MemoryPoolImpl* pool = &g_memory_state.pools[g_memory_state.budget_pool[budget]];
+    stats->name = g_budget_names[budget];
+    stats->budget = pool->total_size;
+    stats->used = pool->used_size;
+    stats->peak = pool->peak_usage;
+    stats->free_bytes = pool->tlsf.free_bytes;
+    stats->overruns = g_memory_state.budget_overruns[budget];
+    stats->largest_overrun = g_memory_state.budget_largest_overrun[budget];
+    stats->frame_peak = g_memory_state.budget_frame_peak[budget];
+    stats->alert_bytes = g_memory_state.budget_alert[budget];
+    stats->alerts = g_memory_state.budget_alerts[budget];
+}
+
+// Budget name of a pool, for site reports
+static const char* memory_pool_name(u32 pool_id) {
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT && g_memory_state.budgets_ready; i++) {
+        if (g_memory_state.budget_pool[i] == pool_id) {
+            return g_budget_names[i];
+        }
+    }
+    return "pool";
+}
+
+void memory_budget_print(void) {
+    printf("SPLATSTORM X: Memory budgets (KB used / peak / frame peak / budget, alert KB, overruns, alerts):\n");
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        MemoryBudgetStats stats;
+        memory_get_budget_stats((MemoryBudgetClass)i, &stats);
+        printf("SPLATSTORM X:   %-6s %6u / %6u / %6u / %6u  %6u  %u  %u\n", stats.name ? stats.name : "-",
+               stats.used / 1024, stats.peak / 1024, stats.frame_peak / 1024, stats.budget / 1024,
+               stats.alert_bytes / 1024, stats.overruns, stats.alerts);
+    }
+    
+    MemoryCallsiteStats sites[MEMORY_CALLSITE_REPORT];
+    u32 count = memory_get_callsites(sites, MEMORY_CALLSITE_REPORT);
+    printf("SPLATSTORM X: Largest allocation sites of %u (KB live / peak, allocations):\n", g_memory_state.callsite_count);
+    for (u32 i = 0; i < count; i++) {
+        printf("SPLATSTORM X:   %-6s %6u / %6u  %5u  %s:%u\n", memory_pool_name(sites[i].pool_id),
+               sites[i].live_bytes / 1024, sites[i].peak_bytes / 1024, sites[i].allocations,
+               sites[i].file ? sites[i].file : "(untracked)", sites[i].line);
+    }
+}
+
+// A budget's alert level: a frame whose peak exceeds it raises an alert.
+// 0 turns the budget's alerts off.
+void memory_budget_set_alert(MemoryBudgetClass budget, u32 bytes) {
+    if ((u32)budget < MEMORY_BUDGET_COUNT) {
+        g_memory_state.budget_alert[budget] = bytes;
+    }
+}
+
+// Size of a budget's pool. Only before memory_system_init() reserves the
+// pools; false after that or for a zero size.
+bool memory_budget_set_size(MemoryBudgetClass budget, u32 bytes) {
+    if (g_memory_state.budgets_ready || (u32)budget >= MEMORY_BUDGET_COUNT || bytes == 0) {
+        return false;
+    }
+    
+    g_budget_sizes[budget] = bytes;
+    return true;
+}
+
+// Budget named as memory_budget_print names it, the first length
+// characters of name; MEMORY_BUDGET_COUNT when none is
+MemoryBudgetClass memory_budget_find(const char* name, u32 length) {
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        if (strlen(g_budget_names[i]) == length && strncmp(name, g_budget_names[i], length) == 0) {
+            return (MemoryBudgetClass)i;
+        }
+    }
+    return MEMORY_BUDGET_COUNT;
+}
+
+/*
+ * memalert=<budget>:<KB>, budget named as memory_budget_print names it or
+ * arena for the frame arena's high-water mark. False when the option is
+ * not an alert option or names no budget.
+ */
+bool memory_parse_alert_option(const char* option) {
+    if (!option || strncmp(option, "memalert=", 9) != 0) return false;
+    
+    const char* name = option + 9;
+    const char* separator = strchr(name, ':');
+    if (!separator) return false;
+    u32 length = (u32)(separator - name);
+    u32 bytes = (u32)atoi(separator + 1) * 1024;
+    
+    if (length == 5 && strncmp(name, "arena", 5) == 0) {
+        g_memory_state.arena_alert = bytes;
+        g_memory_state.arena_alert_set = true;
+        return true;
+    }
+    MemoryBudgetClass budget = memory_budget_find(name, length);
+    if (budget == MEMORY_BUDGET_COUNT) return false;
+    
+    memory_budget_set_alert(budget, bytes);
+    return true;
+}
+
+// Report a budget crossing its alert level, with the site holding most of it
+static void memory_alert_report(const char* name, u32 peak, u32 level, u32 size, s32 pool_id) {
+    printf("SPLATSTORM X: Memory alert: %s peaked at %u KB this frame, alert level %u KB of %u KB\n", name,
+           peak / 1024, level / 1024, size / 1024);
+    
+    const MemoryCallsiteStats* largest = NULL;
+    for (u32 slot = 0; slot < MEMORY_CALLSITE_SLOTS && pool_id >= 0; slot++) {
+        const MemoryCallsiteStats* site = &g_memory_state.callsites[slot];
+        if (site->file && site->pool_id == (u32)pool_id && (!largest || site->live_bytes > largest->live_bytes)) {
+            largest = site;
+        }
+    }
+    if (largest) {
+        printf("SPLATSTORM X:   largest site %s:%u, %u KB live\n", largest->file, largest->line,
+               largest->live_bytes / 1024);
+    }
+}
+
+// Close the frame's budget peaks and raise an alert for each budget, and
+// the frame arena, that went above its level after being below it. Call
+// once per frame; the peaks of the next frame start from current use.
+void memory_budget_end_frame(void) {
+    if (!g_memory_state.budgets_ready) return;
+    
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        MemoryPoolImpl* pool = &g_memory_state.pools[g_memory_state.budget_pool[i]];
+        u32 peak = pool->frame_peak;
+        g_memory_state.budget_frame_peak[i] = peak;
+        pool->frame_peak = pool->used_size;
         
-        if (g_memory_state.total_allocated > g_memory_state.peak_usage) {
-            g_memory_state.peak_usage = g_memory_state.total_allocated;
+        bool over = g_memory_state.budget_alert[i] > 0 && peak > g_memory_state.budget_alert[i];
+        if (over && !g_memory_state.budget_alerting[i]) {
+            g_memory_state.budget_alerts[i]++;
+            memory_alert_report(g_budget_names[i], peak, g_memory_state.budget_alert[i], pool->total_size,
+                                (s32)g_memory_state.budget_pool[i]);
         }
+        g_memory_state.budget_alerting[i] = over;
+    }
+    
+    u32 arena_peak = g_frame_arena.frame_high_water;
+    bool over = g_memory_state.arena_alert > 0 && arena_peak > g_memory_state.arena_alert;
+    if (over && !g_memory_state.arena_alerting) {
+        g_memory_state.arena_alerts++;
+        memory_alert_report("frame arena", arena_peak, g_memory_state.arena_alert, g_frame_arena.capacity, -1);
+    }
+    g_memory_state.arena_alerting = over;
+}
+
+// A budget or the frame arena was above its alert level in the last frame
+bool memory_alert_active(void) {
+    for (u32 i = 0; i < MEMORY_BUDGET_COUNT; i++) {
+        if (g_memory_state.budget_alerting[i]) return true;
+    }
+    return g_memory_state.arena_alerting;
+}
+
+// Up to max_sites allocation sites, largest high-water mark first; the
+// untracked slot (file NULL) is one of them once it holds anything
+u32 memory_get_callsites(MemoryCallsiteStats* sites, u32 max_sites) {
+    if (!sites) return 0;
+    
+    u32 count = 0;
+    for (u32 slot = 0; slot < MEMORY_CALLSITE_SLOTS; slot++) {
+        const MemoryCallsiteStats* site = &g_memory_state.callsites[slot];
+        if (site->allocations == 0) continue;
         
-        // Check cache line alignment
-        if ((uintptr_t)result % 64 == 0) {
-            g_memory_state.cache_line_hits++;
-        } else {
-            g_memory_state.cache_line_misses++;
+        // Insertion into the sorted output, dropping the smallest when full
+        u32 at = count;
+        while (at > 0 && sites[at - 1].peak_bytes < site->peak_bytes) {
+            if (at < max_sites) sites[at] = sites[at - 1];
+            at--;
+        }
+        if (at < max_sites) {
+            sites[at] = *site;
+            count = MIN(count + 1, max_sites);
         }
     }
+    return count;
+}
+
+/*
+ * Aligned allocation front end
+ * Untagged allocations are charged to the asset budget
+ */
+void* splatstorm_alloc_aligned(u32 size, u32 alignment) {
+    if (size == 0) return NULL;
     
-    return result;
+    // Ensure minimum alignment for DMA (16 bytes)
+    if (alignment < 16) alignment = 16;
+    
+    return memory_alloc(MEMORY_BUDGET_ASSET, size, alignment);
 }
 
-// REMOVED: Duplicate function - using UTMOST UPGRADED version in splatstorm_core_system.c
+void splatstorm_free_aligned(void* ptr) {
+    memory_free(ptr);
+}
+
+void* splatstorm_malloc(u32 size) {
+    return splatstorm_alloc_aligned(size, 16);
+}
+
+void splatstorm_free(void* ptr) {
+    memory_free(ptr);
+}
 
 // Cleanup memory system
 void memory_system_cleanup(void) {
@@ -905,6 +1727,9 @@ void memory_system_cleanup(void) {
     
     printf("SPLATSTORM X: Cleaning up memory management system...\n");
     
+    // The frame arena lives in the frame budget
+    frame_arena_cleanup();
+    
     // Cleanup all pools
     for (u32 i = 0; i < g_memory_state.pool_count; i++) {
         MemoryPoolImpl* pool = &g_memory_state.pools[i];
@@ -912,10 +1737,16 @@ void memory_system_cleanup(void) {
             if (pool->type == POOL_TYPE_BUDDY && pool->buddy.free_lists) {
                 free(pool->buddy.free_lists);
             }
-            free(pool->base_address);
+            if (!pool->external_memory) {
+                free(pool->base_address);
+            }
         }
     }
     
+    if (g_memory_state.budget_base) {
+        free(g_memory_state.budget_base);
+    }
+    
     // Clear state
     memset(&g_memory_state, 0, sizeof(MemorySystemState));
     
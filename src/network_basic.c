@@ -14,6 +14,7 @@
 #include <iopheap.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 
 // PS2 Network includes
 #include <ps2ip.h>
@@ -28,6 +29,7 @@ static char network_mask[16] = {0};
 static char network_gateway[16] = {0};
 static int active_sockets[32];
 static int socket_count = 0;
+static int network_users = 0;      // splatstorm_network_init calls not yet shut down
 
 // Network statistics
 static network_stats_t network_stats = {0};
@@ -36,8 +38,9 @@ static network_stats_t network_stats = {0};
 int splatstorm_network_init(void) {
     debug_log_info("Network: Initializing PS2 network adapter support");
 
+    // Telemetry and a network scene share the stack; the last shutdown stops it
     if (network_initialized) {
-        debug_log_warning("Network: Already initialized");
+        network_users++;
         return 1;
     }
 
@@ -49,10 +52,10 @@ int splatstorm_network_init(void) {
     // Load network modules
     int ret;
     
-    // Load NETMAN module
-    ret = SifLoadModule("rom0:NETMAN", 0, NULL);
+    // DEV9 and NETMAN come with the host device class, once either way
+    ret = iop_require_device(IOP_DEVICE_HOST);
     if (ret < 0) {
-        debug_log_error("Network: Failed to load NETMAN module: %d", ret);
+        debug_log_error("Network: Failed to load DEV9/NETMAN modules: %d", ret);
         return -1;
     }
 
@@ -83,6 +86,7 @@ int splatstorm_network_init(void) {
     }
 
     network_initialized = true;
+    network_users = 1;
     network_stats.initialized = true;
     network_stats.init_time = splatstorm_timer_get_ticks();
     
@@ -92,7 +96,7 @@ int splatstorm_network_init(void) {
 
 // COMPLETE IMPLEMENTATION - Network shutdown
 void splatstorm_network_shutdown(void) {
-    if (!network_initialized) {
+    if (!network_initialized || --network_users > 0) {
         return;
     }
 
@@ -214,6 +218,39 @@ int splatstorm_network_create_socket(void) {
     return sock;
 }
 
+// UDP socket that never blocks: a send with no buffer space fails at once.
+// splatstorm_network_connect() sets its destination for send.
+int splatstorm_network_create_udp_socket(void) {
+    if (!network_initialized || !network_connected) {
+        debug_log_error("Network: Cannot create socket - network not ready");
+        return -1;
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        debug_log_error("Network: Failed to create UDP socket: %d", sock);
+        return -2;
+    }
+
+    int non_blocking = 1;
+    if (ioctlsocket(sock, FIONBIO, &non_blocking) < 0) {
+        debug_log_warning("Network: UDP socket %d stays blocking", sock);
+    }
+
+    for (int i = 0; i < 32; i++) {
+        if (active_sockets[i] == -1) {
+            active_sockets[i] = sock;
+            socket_count++;
+            break;
+        }
+    }
+
+    network_stats.sockets_created++;
+    debug_log_info("Network: Created UDP socket %d (total active: %d)", sock, socket_count);
+    
+    return sock;
+}
+
 // COMPLETE IMPLEMENTATION - Connect to remote host
 int splatstorm_network_connect(int sock, const char* host, int port) {
     if (!network_initialized || !network_connected || sock < 0 || !host || port <= 0) {
@@ -293,6 +330,29 @@ int splatstorm_network_receive(int sock, void* buffer, size_t size) {
     return bytes_received;
 }
 
+// Receive what has already arrived without blocking: 0 when nothing has,
+// negative once the peer closed the connection or it failed
+int splatstorm_network_receive_nowait(int sock, void* buffer, size_t size) {
+    if (!network_initialized || !network_connected || sock < 0 || !buffer || size == 0) {
+        debug_log_error("Network: Invalid receive parameters");
+        return -1;
+    }
+
+    int bytes_received = recv(sock, buffer, size, MSG_DONTWAIT);
+    if (bytes_received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0;
+    }
+    if (bytes_received <= 0) {
+        debug_log_error("Network: Receive failed on socket %d: %d", sock, bytes_received);
+        network_stats.receive_errors++;
+        return -1;
+    }
+
+    network_stats.bytes_received += bytes_received;
+    network_stats.packets_received++;
+    return bytes_received;
+}
+
 // COMPLETE IMPLEMENTATION - Close network socket
 void splatstorm_network_close_socket(int sock) {
     if (!network_initialized || sock < 0) {
@@ -198,9 +198,14 @@ void performance_set_vram_usage(u32 bytes_used) {
 }
 
 /**
- * Get VU0 utilization (approximate)
+ * Get VU0 utilization: sampled over the last frame while the VU activity
+ * sampler runs, otherwise approximate
  */
 float performance_get_vu0_utilization(void) {
+    if (vu_activity_running()) {
+        return vu_activity_busy_fraction(VU_UNIT_VU0) * 100.0f;
+    }
+    
     // VU0 utilization estimation based on cycle counting
     // VU0 runs at 294.912 MHz (same as EE)
     
@@ -226,9 +231,14 @@ float performance_get_vu0_utilization(void) {
 }
 
 /**
- * Get VU1 utilization (approximate)
+ * Get VU1 utilization: sampled over the last frame while the VU activity
+ * sampler runs, otherwise approximate
  */
 float performance_get_vu1_utilization(void) {
+    if (vu_activity_running()) {
+        return vu_activity_busy_fraction(VU_UNIT_VU1) * 100.0f;
+    }
+    
     // VU1 utilization estimation for Gaussian splatting workload
     // VU1 runs at 294.912 MHz and handles the heavy math
     
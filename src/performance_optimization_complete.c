@@ -28,7 +28,6 @@ static struct {
     bool initialized;
     RenderQuality current_quality;
     RenderQuality target_quality;
-    bool adaptive_quality_enabled;
     float target_fps;
     float current_fps;
     u32 frame_count;
@@ -86,10 +85,8 @@ static struct {
 } g_perf_monitor = {0};
 
 // Forward declarations
-static void update_adaptive_quality(void);
 static void optimize_batch_size(void);
 static void update_performance_metrics(void);
-static RenderQuality determine_optimal_quality(float current_fps, float target_fps);
 
 /*
  * BATCH PROCESSING FUNCTIONS - COMPLETE IMPLEMENTATIONS
@@ -209,7 +206,7 @@ void build_gif_packet_optimized(PackedSplat* splats, int count) {
     // Calculate GIF packet size
     u32 gif_packet_size = count * 64 + 128; // 64 bytes per splat + header
     
-    void* gif_packet = splatstorm_alloc_aligned(gif_packet_size, 128);
+    void* gif_packet = memory_alloc(MEMORY_BUDGET_DMA, gif_packet_size, 128);
     if (!gif_packet) {
         printf("PERF OPT ERROR: Failed to allocate GIF packet buffer\n");
         return;
@@ -248,7 +245,7 @@ void build_gif_packet_optimized(PackedSplat* splats, int count) {
     // Send GIF packet via DMA
     dma_send_chain(gif_packet, gif_packet_size);
     
-    splatstorm_free_aligned(gif_packet);
+    memory_free(gif_packet);
     
     u64 end_time = get_cpu_cycles();
     float build_time_ms = cycles_to_ms(end_time - start_time);
@@ -545,6 +542,9 @@ u64 get_cpu_cycles_64(void) {
 static void perf_vu_wait_for_completion(void) {
     u64 start_time = get_cpu_cycles();
     
+    // VU1 runs the long batches: sleep on its end interrupt first
+    vu_wait_vu1_idle();
+    
     // Wait for both VU0 and VU1 to complete
     while ((*VU0_STAT & VU_STATUS_RUNNING) || (*VU1_STAT & VU_STATUS_RUNNING)) {
         // Check for timeout (1 second)
@@ -586,7 +586,6 @@ int splatstorm_optimized_init(void) {
     memset(&g_perf_state, 0, sizeof(g_perf_state));
     g_perf_state.current_quality = RENDER_QUALITY_HIGH;
     g_perf_state.target_quality = RENDER_QUALITY_HIGH;
-    g_perf_state.adaptive_quality_enabled = true;
     g_perf_state.target_fps = TARGET_FPS_60;
     g_perf_state.current_fps = 0.0f;
     g_perf_state.frame_count = 0;
@@ -603,7 +602,7 @@ int splatstorm_optimized_init(void) {
     g_batch_state.total_batch_time = 0;
     
     // Allocate batch buffer
-    g_batch_state.batch_buffer = (PackedSplat*)splatstorm_alloc_aligned(
+    g_batch_state.batch_buffer = (PackedSplat*)memory_alloc(MEMORY_BUDGET_DMA,
         g_batch_state.max_batch_size * sizeof(PackedSplat), 128);
     if (!g_batch_state.batch_buffer) {
         printf("PERF OPT ERROR: Failed to allocate batch buffer\n");
@@ -647,10 +646,8 @@ void splatstorm_render_frame_optimized(PackedSplat* splats, int count, float* mv
     u64 frame_start = get_cpu_cycles();
     g_perf_monitor.frame_start_cycles = frame_start;
     
-    // Update adaptive quality if enabled
-    if (g_perf_state.adaptive_quality_enabled) {
-        update_adaptive_quality();
-    }
+    // Quality is chosen by the caller through splatstorm_set_quality_level();
+    // the frame-time controller in main_complete.c owns every quality knob
     
     // Process splats in optimized batches
     process_splats_batched(splats, count, mvp_matrix);
@@ -691,7 +688,7 @@ void splatstorm_optimized_cleanup(void) {
     
     // Free batch buffer
     if (g_batch_state.batch_buffer) {
-        splatstorm_free_aligned(g_batch_state.batch_buffer);
+        memory_free(g_batch_state.batch_buffer);
         g_batch_state.batch_buffer = NULL;
     }
     
@@ -728,51 +725,6 @@ void gs_optimized_cleanup(void) {
  * INTERNAL HELPER FUNCTIONS - COMPLETE IMPLEMENTATIONS
  */
 
-// Update adaptive quality based on performance
-static void update_adaptive_quality(void) {
-    if (!g_perf_state.adaptive_quality_enabled) {
-        return;
-    }
-    
-    // Calculate average FPS over last few frames
-    float avg_fps = 0.0f;
-    int samples = 0;
-    for (int i = 0; i < 60; i++) {
-        if (g_perf_monitor.fps_history[i] > 0.0f) {
-            avg_fps += g_perf_monitor.fps_history[i];
-            samples++;
-        }
-    }
-    
-    if (samples > 0) {
-        avg_fps /= samples;
-        
-        RenderQuality new_quality = determine_optimal_quality(avg_fps, g_perf_state.target_fps);
-        if (new_quality != g_perf_state.current_quality) {
-            splatstorm_set_quality_level(new_quality);
-        }
-    }
-}
-
-// Determine optimal quality based on performance
-static RenderQuality determine_optimal_quality(float current_fps, float target_fps) {
-    float performance_ratio = current_fps / target_fps;
-    
-    if (performance_ratio >= 1.1f) {
-        // Performance is good, can increase quality
-        if (g_perf_state.current_quality < RENDER_QUALITY_ULTRA) {
-            return (RenderQuality)(g_perf_state.current_quality + 1);
-        }
-    } else if (performance_ratio < 0.9f) {
-        // Performance is poor, need to decrease quality
-        if (g_perf_state.current_quality > RENDER_QUALITY_FALLBACK) {
-            return (RenderQuality)(g_perf_state.current_quality - 1);
-        }
-    }
-    
-    return g_perf_state.current_quality;
-}
-
 // Update performance metrics
 static void update_performance_metrics(void) {
     if (!g_perf_monitor.monitoring_enabled) {
@@ -2,6 +2,10 @@
  * SPLATSTORM X - Enhanced PLY File Loader
  * Complete PLY file parser with PS2SDK file I/O integration
  * Supports ASCII and binary PLY formats with streaming for large files
+ * Header read through a 256 KB buffer filled by large block reads
+ * Binary bodies decoded block by block as file_read_pipelined() streams them
+ * Header compiled once into a per-field offset/type plan for the body
+ * Budgeted loads keep only the most important vertices
  * NO STUBS - Full implementation with error handling and memory management
  */
 
@@ -25,7 +29,13 @@
 
 #define MAX_LINE_LENGTH 256
 #define MAX_PROPERTIES 32
-#define CHUNK_SIZE 4096
+#define PLY_READ_BLOCK (64 * 1024)                 // Device read granularity
+#define PLY_READ_BUFFER_SIZE (4 * PLY_READ_BLOCK)  // 256 KB streaming buffer
+#define PLY_SELECT_BATCH 64                        // Budgeted loads convert this many records at a time
+
+// Scene budget per kept vertex: its record, hot stream entry and selection
+// heap slot. At 148 bytes the default 20 MB scene budget holds ~141k splats.
+#define PLY_RESIDENT_SPLAT_BYTES (sizeof(GaussianSplat3D) + sizeof(GaussianSplatHot) + sizeof(u32))
 
 // PLY property types
 typedef enum {
@@ -59,32 +69,90 @@ typedef struct {
     long data_offset;
 } PLYHeader;
 
-// Property name mappings for Gaussian splats
+// Splat fields a vertex can carry, in conversion order
+typedef enum {
+    PLY_FIELD_X,
+    PLY_FIELD_Y,
+    PLY_FIELD_Z,
+    PLY_FIELD_RED,
+    PLY_FIELD_GREEN,
+    PLY_FIELD_BLUE,
+    PLY_FIELD_OPACITY,
+    PLY_FIELD_SCALE_0,
+    PLY_FIELD_SCALE_1,
+    PLY_FIELD_SCALE_2,
+    PLY_FIELD_ROT_0,            // Quaternion w
+    PLY_FIELD_ROT_1,
+    PLY_FIELD_ROT_2,
+    PLY_FIELD_ROT_3,
+    PLY_FIELD_COUNT,
+    PLY_FIELD_NONE = PLY_FIELD_COUNT
+} PLYField;
+
+// Property name mappings for Gaussian splats. "alpha" wins over "opacity"
+// when a file has both, so it is listed last.
 static const struct {
     const char* ply_name;
-    const char* gaussian_field;
+    PLYField field;
 } property_mappings[] = {
-    {"x", "pos_x"},
-    {"y", "pos_y"},
-    {"z", "pos_z"},
-    {"red", "color_r"},
-    {"green", "color_g"},
-    {"blue", "color_b"},
-    {"alpha", "alpha"},
-    {"opacity", "alpha"},
-    {"scale_0", "scale_x"},
-    {"scale_1", "scale_y"},
-    {"scale_2", "scale_z"},
-    {"rot_0", "rot_x"},
-    {"rot_1", "rot_y"},
-    {"rot_2", "rot_z"},
-    {"rot_3", "rot_w"},
-    {"f_dc_0", "sh_dc_0"},
-    {"f_dc_1", "sh_dc_1"},
-    {"f_dc_2", "sh_dc_2"},
-    {NULL, NULL}
+    {"x", PLY_FIELD_X},
+    {"y", PLY_FIELD_Y},
+    {"z", PLY_FIELD_Z},
+    {"red", PLY_FIELD_RED},
+    {"green", PLY_FIELD_GREEN},
+    {"blue", PLY_FIELD_BLUE},
+    {"opacity", PLY_FIELD_OPACITY},
+    {"alpha", PLY_FIELD_OPACITY},
+    {"scale_0", PLY_FIELD_SCALE_0},
+    {"scale_1", PLY_FIELD_SCALE_1},
+    {"scale_2", PLY_FIELD_SCALE_2},
+    {"rot_0", PLY_FIELD_ROT_0},
+    {"rot_1", PLY_FIELD_ROT_1},
+    {"rot_2", PLY_FIELD_ROT_2},
+    {"rot_3", PLY_FIELD_ROT_3},
+    {NULL, PLY_FIELD_NONE}
 };
 
+// Vertex conversion plan compiled once from the header: where each splat
+// field lives in a binary record, or which ASCII column holds it
+typedef struct {
+    int present[PLY_FIELD_COUNT];
+    int offset[PLY_FIELD_COUNT];
+    PLYPropertyType type[PLY_FIELD_COUNT];
+    int column_field[MAX_PROPERTIES];   // ASCII: field per property column
+    int all_float;                      // Every mapped field is a float
+} PLYVertexPlan;
+
+// Streaming reader: large block reads into one buffer, consumed in place.
+// A refill moves the unconsumed tail (at most one partial line or record)
+// to the front and tops the buffer up in whole PLY_READ_BLOCK reads.
+typedef struct {
+    int fd;
+    u8* buffer;
+    u32 pos;
+    u32 size;
+    u32 file_offset;    // File offset of buffer[size]
+    int eof;
+} PLYReader;
+
+// Budgeted loads: the kept splats, with a min-heap of their slots by importance
+typedef struct {
+    GaussianSplat3D* splats;
+    u32* heap;
+    u32 budget;
+    u32 count;          // Slots filled
+} PLYSelection;
+
+// Binary body decoder state for file_read_pipelined()
+typedef struct {
+    const PLYHeader* header;
+    const PLYVertexPlan* plan;
+    GaussianSplat3D* splats;
+    PLYSelection* selection;    // Budgeted load, NULL to keep every vertex
+    u32 body_offset;            // File offset of vertex 0
+    u32 vertices_read;
+} PLYBodyDecoder;
+
 /**
  * Get property type size in bytes
  */
@@ -123,25 +191,66 @@ static PLYPropertyType parse_property_type(const char* type_str) {
 }
 
 /**
- * Read a line from file (handles both text and binary modes)
+ * Refill the streaming buffer, keeping unconsumed bytes
  */
-static int read_line(int fd, char* buffer, int max_length) {
+static int ply_reader_fill(PLYReader* reader) {
+    if (reader->eof) {
+        return 0;
+    }
+    
+    u32 remaining = reader->size - reader->pos;
+    if (remaining > 0 && reader->pos > 0) {
+        memmove(reader->buffer, reader->buffer + reader->pos, remaining);
+    }
+    reader->pos = 0;
+    reader->size = remaining;
+    
+    u32 added = 0;
+    while (reader->size + PLY_READ_BLOCK <= PLY_READ_BUFFER_SIZE) {
+        int bytes_read = read_file_data(reader->fd, reader->buffer + reader->size, PLY_READ_BLOCK);
+        if (bytes_read <= 0) {
+            reader->eof = 1;
+            break;
+        }
+        reader->size += bytes_read;
+        reader->file_offset += bytes_read;
+        added += bytes_read;
+        if (bytes_read < PLY_READ_BLOCK) {
+            reader->eof = 1;
+            break;
+        }
+    }
+    
+    return (int)added;
+}
+
+/**
+ * Read a line from the streaming buffer
+ */
+static int read_line(PLYReader* reader, char* buffer, int max_length) {
     int pos = 0;
-    char c;
     
-    while (pos < max_length - 1) {
-        int result = read_file_data(fd, &c, 1);
-        if (result <= 0) {
+    while (1) {
+        if (reader->pos >= reader->size && ply_reader_fill(reader) <= 0) {
             break;
         }
         
-        if (c == '\n') {
-            break;
+        // Scan the buffered bytes for the end of the line
+        const u8* data = reader->buffer + reader->pos;
+        u32 available = reader->size - reader->pos;
+        u32 i = 0;
+        while (i < available && data[i] != '\n') {
+            if (data[i] != '\r' && pos < max_length - 1) {
+                buffer[pos++] = (char)data[i];
+            }
+            i++;
         }
         
-        if (c != '\r') {
-            buffer[pos++] = c;
+        if (i < available) {
+            reader->pos += i + 1;  // Consume the newline
+            break;
         }
+        reader->pos += i;
     }
     
     buffer[pos] = '\0';
@@ -151,7 +260,7 @@ static int read_line(int fd, char* buffer, int max_length) {
 /**
  * Parse PLY header
  */
-static GaussianResult parse_ply_header(int fd, PLYHeader* header) {
+static GaussianResult parse_ply_header(PLYReader* reader, PLYHeader* header) {
     char line[MAX_LINE_LENGTH];
     int line_length;
     
@@ -159,7 +268,7 @@ static GaussianResult parse_ply_header(int fd, PLYHeader* header) {
     memset(header, 0, sizeof(PLYHeader));
     
     // Read and verify magic number
-    line_length = read_line(fd, line, sizeof(line));
+    line_length = read_line(reader, line, sizeof(line));
     if (line_length <= 0 || strcmp(line, PLY_MAGIC) != 0) {
         debug_log_error("Invalid PLY magic number: %s", line);
         return GAUSSIAN_ERROR_INVALID_FORMAT;
@@ -169,7 +278,7 @@ static GaussianResult parse_ply_header(int fd, PLYHeader* header) {
     
     // Parse header lines
     while (1) {
-        line_length = read_line(fd, line, sizeof(line));
+        line_length = read_line(reader, line, sizeof(line));
         if (line_length <= 0) {
             debug_log_error("Unexpected end of file in header");
             return GAUSSIAN_ERROR_INVALID_FORMAT;
@@ -267,33 +376,55 @@ static GaussianResult parse_ply_header(int fd, PLYHeader* header) {
 }
 
 /**
- * Find property by name
+ * Compile the header into a vertex conversion plan
  */
-static const PLYProperty* find_property(const PLYHeader* header, const char* name) {
+static void build_vertex_plan(const PLYHeader* header, PLYVertexPlan* plan) {
+    memset(plan, 0, sizeof(PLYVertexPlan));
+    plan->all_float = 1;
+    
     for (int i = 0; i < header->num_properties; i++) {
-        if (strcmp(header->properties[i].name, name) == 0) {
-            return &header->properties[i];
+        const PLYProperty* prop = &header->properties[i];
+        plan->column_field[i] = PLY_FIELD_NONE;
+        
+        for (int m = 0; property_mappings[m].ply_name != NULL; m++) {
+            if (strcmp(prop->name, property_mappings[m].ply_name) == 0) {
+                PLYField field = property_mappings[m].field;
+                
+                // "alpha" beats an "opacity" seen earlier or later
+                if (plan->present[field] && strcmp(prop->name, "alpha") != 0) {
+                    break;
+                }
+                
+                plan->present[field] = 1;
+                plan->offset[field] = prop->offset;
+                plan->type[field] = prop->type;
+                plan->column_field[i] = field;
+                break;
+            }
+        }
+    }
+    
+    for (int f = 0; f < PLY_FIELD_COUNT; f++) {
+        if (plan->present[f] && plan->type[f] != PLY_TYPE_FLOAT) {
+            plan->all_float = 0;
         }
     }
-    return NULL;
 }
 
 /**
  * Read property value from binary data
  */
-static float read_property_value(const u8* data, const PLYProperty* prop, int is_big_endian) {
-    const u8* ptr = data + prop->offset;
-    
-    switch (prop->type) {
+static float read_property_value(const u8* ptr, PLYPropertyType type, int is_big_endian) {
+    switch (type) {
         case PLY_TYPE_CHAR:
             return (float)*(s8*)ptr;
         case PLY_TYPE_UCHAR:
             return (float)*(u8*)ptr;
         case PLY_TYPE_SHORT:
             if (is_big_endian) {
-                return (float)((ptr[0] << 8) | ptr[1]);
+                return (float)(s16)((ptr[0] << 8) | ptr[1]);
             } else {
-                return (float)((ptr[1] << 8) | ptr[0]);
+                return (float)(s16)((ptr[1] << 8) | ptr[0]);
             }
         case PLY_TYPE_USHORT:
             if (is_big_endian) {
@@ -303,9 +434,9 @@ static float read_property_value(const u8* data, const PLYProperty* prop, int is
             }
         case PLY_TYPE_INT:
             if (is_big_endian) {
-                return (float)((ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3]);
+                return (float)(s32)((ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3]);
             } else {
-                return (float)((ptr[3] << 24) | (ptr[2] << 16) | (ptr[1] << 8) | ptr[0]);
+                return (float)(s32)((ptr[3] << 24) | (ptr[2] << 16) | (ptr[1] << 8) | ptr[0]);
             }
         case PLY_TYPE_UINT:
             if (is_big_endian) {
@@ -313,165 +444,221 @@ static float read_property_value(const u8* data, const PLYProperty* prop, int is
             } else {
                 return (float)(((u32)ptr[3] << 24) | ((u32)ptr[2] << 16) | ((u32)ptr[1] << 8) | ptr[0]);
             }
-        case PLY_TYPE_FLOAT:
+        case PLY_TYPE_FLOAT: {
+            u32 val;
             if (is_big_endian) {
-                u32 val = ((u32)ptr[0] << 24) | ((u32)ptr[1] << 16) | ((u32)ptr[2] << 8) | ptr[3];
-                return *(float*)&val;
+                val = ((u32)ptr[0] << 24) | ((u32)ptr[1] << 16) | ((u32)ptr[2] << 8) | ptr[3];
             } else {
-                u32 val = ((u32)ptr[3] << 24) | ((u32)ptr[2] << 16) | ((u32)ptr[1] << 8) | ptr[0];
-                return *(float*)&val;
+                memcpy(&val, ptr, sizeof(val));  // Records are not 4-byte aligned
             }
-        case PLY_TYPE_DOUBLE:
-            // Simplified double to float conversion
+            float f;
+            memcpy(&f, &val, sizeof(f));
+            return f;
+        }
+        case PLY_TYPE_DOUBLE: {
+            u64 val;
             if (is_big_endian) {
-                u64 val = ((u64)ptr[0] << 56) | ((u64)ptr[1] << 48) | ((u64)ptr[2] << 40) | ((u64)ptr[3] << 32) |
-                         ((u64)ptr[4] << 24) | ((u64)ptr[5] << 16) | ((u64)ptr[6] << 8) | ptr[7];
-                return (float)(*(double*)&val);
+                val = ((u64)ptr[0] << 56) | ((u64)ptr[1] << 48) | ((u64)ptr[2] << 40) | ((u64)ptr[3] << 32) |
+                      ((u64)ptr[4] << 24) | ((u64)ptr[5] << 16) | ((u64)ptr[6] << 8) | ptr[7];
             } else {
-                u64 val = ((u64)ptr[7] << 56) | ((u64)ptr[6] << 48) | ((u64)ptr[5] << 40) | ((u64)ptr[4] << 32) |
-                         ((u64)ptr[3] << 24) | ((u64)ptr[2] << 16) | ((u64)ptr[1] << 8) | ptr[0];
-                return (float)(*(double*)&val);
+                memcpy(&val, ptr, sizeof(val));
             }
+            double d;
+            memcpy(&d, &val, sizeof(d));
+            return (float)d;
+        }
         default:
             return 0.0f;
     }
 }
 
 /**
- * Convert PLY vertex data to Gaussian splat
+ * Build a splat from decoded field values (missing fields keep their defaults)
  */
-static void convert_vertex_to_splat(const PLYHeader* header, const u8* vertex_data, 
-                                   const char* ascii_line, GaussianSplat3D* splat) {
-    // Initialize splat with default values
+static void store_splat_fields(const float values[PLY_FIELD_COUNT], GaussianSplat3D* splat) {
     memset(splat, 0, sizeof(GaussianSplat3D));
     
-    // Set default values
-    splat->color[0] = 255; // White
-    splat->color[1] = 255;
-    splat->color[2] = 255;
-    splat->opacity = 255;  // Fully opaque
+    splat->pos[0] = float_to_fixed16(values[PLY_FIELD_X]);
+    splat->pos[1] = float_to_fixed16(values[PLY_FIELD_Y]);
+    splat->pos[2] = float_to_fixed16(values[PLY_FIELD_Z]);
+    splat->color[0] = (u8)(values[PLY_FIELD_RED] * 255.0f);
+    splat->color[1] = (u8)(values[PLY_FIELD_GREEN] * 255.0f);
+    splat->color[2] = (u8)(values[PLY_FIELD_BLUE] * 255.0f);
+    splat->opacity = (u8)(values[PLY_FIELD_OPACITY] * 255.0f);
     
-    if (header->is_binary) {
-        // Binary format - read from binary data
-        const PLYProperty* prop;
-        
-        // Position
-        if ((prop = find_property(header, "x")) != NULL) {
-            float x = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->pos[0] = float_to_fixed16(x);
-        }
-        if ((prop = find_property(header, "y")) != NULL) {
-            float y = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->pos[1] = float_to_fixed16(y);
-        }
-        if ((prop = find_property(header, "z")) != NULL) {
-            float z = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->pos[2] = float_to_fixed16(z);
-        }
-        
-        // Color
-        if ((prop = find_property(header, "red")) != NULL) {
-            float r = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->color[0] = (u8)(r * 255.0f);
-        }
-        if ((prop = find_property(header, "green")) != NULL) {
-            float g = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->color[1] = (u8)(g * 255.0f);
-        }
-        if ((prop = find_property(header, "blue")) != NULL) {
-            float b = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->color[2] = (u8)(b * 255.0f);
-        }
-        
-        // Alpha/Opacity
-        if ((prop = find_property(header, "alpha")) != NULL) {
-            float a = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->opacity = (u8)(a * 255.0f);
-        } else if ((prop = find_property(header, "opacity")) != NULL) {
-            float a = read_property_value(vertex_data, prop, header->is_big_endian);
-            splat->opacity = (u8)(a * 255.0f);
-        }
-        
-        // Scale (for covariance computation)
-        float scale[3] = {1.0f, 1.0f, 1.0f};
-        if ((prop = find_property(header, "scale_0")) != NULL) {
-            scale[0] = read_property_value(vertex_data, prop, header->is_big_endian);
-        }
-        if ((prop = find_property(header, "scale_1")) != NULL) {
-            scale[1] = read_property_value(vertex_data, prop, header->is_big_endian);
-        }
-        if ((prop = find_property(header, "scale_2")) != NULL) {
-            scale[2] = read_property_value(vertex_data, prop, header->is_big_endian);
-        }
-        
-        // Rotation quaternion (for covariance computation)
-        float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f};
-        if ((prop = find_property(header, "rot_0")) != NULL) {
-            rotation[0] = read_property_value(vertex_data, prop, header->is_big_endian);
+    u8 cov_exp;
+    gaussian_covariance_from_scale_rotation(&values[PLY_FIELD_SCALE_0], &values[PLY_FIELD_ROT_0],
+                                            splat->cov_mant, &cov_exp);
+    splat->cov_exp = cov_exp;
+    
+    // Importance as asset_manager_complete.c computes it
+    float scale_sum = values[PLY_FIELD_SCALE_0] + values[PLY_FIELD_SCALE_1] + values[PLY_FIELD_SCALE_2];
+    splat->importance = (u32)MAX(0.0f, values[PLY_FIELD_OPACITY] * scale_sum * 1000.0f);
+}
+
+static void selection_sift_down(PLYSelection* selection, u32 position) {
+    u32* heap = selection->heap;
+    const GaussianSplat3D* splats = selection->splats;
+    u32 count = selection->count;
+    
+    while (2 * position + 1 < count) {
+        u32 child = 2 * position + 1;
+        if (child + 1 < count && splats[heap[child + 1]].importance < splats[heap[child]].importance) {
+            child++;
         }
-        if ((prop = find_property(header, "rot_1")) != NULL) {
-            rotation[1] = read_property_value(vertex_data, prop, header->is_big_endian);
+        if (splats[heap[position]].importance <= splats[heap[child]].importance) {
+            break;
         }
-        if ((prop = find_property(header, "rot_2")) != NULL) {
-            rotation[2] = read_property_value(vertex_data, prop, header->is_big_endian);
+        u32 tmp = heap[position]; heap[position] = heap[child]; heap[child] = tmp;
+        position = child;
+    }
+}
+
+/**
+ * Offer a converted splat to a budgeted load: kept while there is room, then
+ * only if it beats the least important kept splat (ties keep the earlier one)
+ */
+static void selection_offer(PLYSelection* selection, const GaussianSplat3D* splat) {
+    u32* heap = selection->heap;
+    GaussianSplat3D* splats = selection->splats;
+    
+    if (selection->count < selection->budget) {
+        u32 position = selection->count++;
+        splats[position] = *splat;
+        heap[position] = position;
+        while (position > 0) {
+            u32 parent = (position - 1) / 2;
+            if (splats[heap[parent]].importance <= splats[heap[position]].importance) {
+                break;
+            }
+            u32 tmp = heap[position]; heap[position] = heap[parent]; heap[parent] = tmp;
+            position = parent;
         }
-        if ((prop = find_property(header, "rot_3")) != NULL) {
-            rotation[3] = read_property_value(vertex_data, prop, header->is_big_endian);
+    } else if (splat->importance > splats[heap[0]].importance) {
+        splats[heap[0]] = *splat;
+        selection_sift_down(selection, 0);
+    }
+}
+
+/**
+ * Field values for a vertex with no properties: white, opaque, unit scale, unrotated
+ */
+static void default_field_values(float values[PLY_FIELD_COUNT]) {
+    for (int f = 0; f < PLY_FIELD_COUNT; f++) {
+        values[f] = 0.0f;
+    }
+    values[PLY_FIELD_RED] = 1.0f;
+    values[PLY_FIELD_GREEN] = 1.0f;
+    values[PLY_FIELD_BLUE] = 1.0f;
+    values[PLY_FIELD_OPACITY] = 1.0f;
+    values[PLY_FIELD_SCALE_0] = 1.0f;
+    values[PLY_FIELD_SCALE_1] = 1.0f;
+    values[PLY_FIELD_SCALE_2] = 1.0f;
+    values[PLY_FIELD_ROT_0] = 1.0f;
+}
+
+/**
+ * Convert a run of complete binary records into splats
+ */
+static void convert_binary_batch(const PLYHeader* header, const PLYVertexPlan* plan,
+                                 const u8* records, u32 count, GaussianSplat3D* splats) {
+    float defaults[PLY_FIELD_COUNT];
+    default_field_values(defaults);
+    
+    // Only the fields present in the file are decoded per vertex
+    int fields[PLY_FIELD_COUNT];
+    int field_count = 0;
+    for (int f = 0; f < PLY_FIELD_COUNT; f++) {
+        if (plan->present[f]) {
+            fields[field_count++] = f;
         }
+    }
+    
+    int fast_path = plan->all_float && !header->is_big_endian;
+    
+    for (u32 v = 0; v < count; v++) {
+        const u8* record = records + v * header->vertex_size;
+        float values[PLY_FIELD_COUNT];
+        memcpy(values, defaults, sizeof(values));
         
-        // Convert scale and rotation to covariance matrix (simplified)
-        // This is a placeholder - full implementation would compute proper covariance
-        for (int i = 0; i < 9; i++) {
-            splat->cov_mant[i] = float_to_fixed16(scale[i % 3]);
+        if (fast_path) {
+            // Little-endian floats, as written by the usual exporters
+            for (int i = 0; i < field_count; i++) {
+                memcpy(&values[fields[i]], record + plan->offset[fields[i]], sizeof(float));
+            }
+        } else {
+            for (int i = 0; i < field_count; i++) {
+                int f = fields[i];
+                values[f] = read_property_value(record + plan->offset[f], plan->type[f], header->is_big_endian);
+            }
         }
-        splat->cov_exp = 0;
         
+        store_splat_fields(values, &splats[v]);
+    }
+}
+
+/**
+ * Pipelined block callback: blocks hold whole records, see load_ply_file()
+ */
+static GaussianResult decode_binary_block(const u8* block, u32 size, u32 file_offset, void* user) {
+    PLYBodyDecoder* decoder = (PLYBodyDecoder*)user;
+    const PLYHeader* header = decoder->header;
+    u32 first = (file_offset - decoder->body_offset) / header->vertex_size;
+    u32 batch = MIN(size / header->vertex_size, header->vertex_count - first);
+    
+    if (!decoder->selection) {
+        convert_binary_batch(header, decoder->plan, block, batch, &decoder->splats[first]);
     } else {
-        // ASCII format - parse from text line
-        float values[MAX_PROPERTIES];
-        int num_values = 0;
-        
-        // Parse space-separated values
-        char* token = strtok((char*)ascii_line, " \t");
-        while (token != NULL && num_values < MAX_PROPERTIES) {
-            values[num_values++] = (float)atof(token);
-            token = strtok(NULL, " \t");
-        }
-        
-        // Map values to splat fields based on property order
-        for (int i = 0; i < header->num_properties && i < num_values; i++) {
-            const PLYProperty* prop = &header->properties[i];
-            float value = values[i];
-            
-            if (strcmp(prop->name, "x") == 0) {
-                splat->pos[0] = float_to_fixed16(value);
-            } else if (strcmp(prop->name, "y") == 0) {
-                splat->pos[1] = float_to_fixed16(value);
-            } else if (strcmp(prop->name, "z") == 0) {
-                splat->pos[2] = float_to_fixed16(value);
-            } else if (strcmp(prop->name, "red") == 0) {
-                splat->color[0] = (u8)(value * 255.0f);
-            } else if (strcmp(prop->name, "green") == 0) {
-                splat->color[1] = (u8)(value * 255.0f);
-            } else if (strcmp(prop->name, "blue") == 0) {
-                splat->color[2] = (u8)(value * 255.0f);
-            } else if (strcmp(prop->name, "alpha") == 0 || strcmp(prop->name, "opacity") == 0) {
-                splat->opacity = (u8)(value * 255.0f);
+        static GaussianSplat3D converted[PLY_SELECT_BATCH];
+        for (u32 done = 0; done < batch; done += PLY_SELECT_BATCH) {
+            u32 run = MIN(PLY_SELECT_BATCH, batch - done);
+            convert_binary_batch(header, decoder->plan, block + done * header->vertex_size, run, converted);
+            for (u32 i = 0; i < run; i++) {
+                selection_offer(decoder->selection, &converted[i]);
             }
         }
-        
-        // Set default covariance for ASCII files
-        for (int i = 0; i < 9; i++) {
-            splat->cov_mant[i] = float_to_fixed16(1.0f);
+    }
+    decoder->vertices_read = first + batch;
+    return GAUSSIAN_SUCCESS;
+}
+
+/**
+ * Convert one ASCII vertex line into a splat
+ */
+static void convert_ascii_vertex(const PLYHeader* header, const PLYVertexPlan* plan,
+                                 const char* line, GaussianSplat3D* splat) {
+    float values[PLY_FIELD_COUNT];
+    default_field_values(values);
+    
+    // Walk the columns once; unmapped columns are skipped
+    const char* cursor = line;
+    for (int i = 0; i < header->num_properties; i++) {
+        char* end;
+        float value = strtof(cursor, &end);
+        if (end == cursor) {
+            break;
+        }
+        if (plan->column_field[i] != PLY_FIELD_NONE) {
+            values[plan->column_field[i]] = value;
         }
-        splat->cov_exp = 0;
+        cursor = end;
     }
+    
+    store_splat_fields(values, splat);
 }
 
 /**
  * Load PLY file with streaming support for large files
  */
 GaussianResult load_ply_file(const char* filename, GaussianSplat3D** splats, u32* count) {
+    return load_ply_file_budgeted(filename, splats, count, 0);
+}
+
+/**
+ * Load at most budget splats (0 = all), keeping the most important ones.
+ * Only the kept splats are allocated; they come back in no particular order.
+ */
+GaussianResult load_ply_file_budgeted(const char* filename, GaussianSplat3D** splats, u32* count, u32 budget) {
     if (!filename || !splats || !count) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
@@ -493,104 +680,144 @@ GaussianResult load_ply_file(const char* filename, GaussianSplat3D** splats, u32
         return GAUSSIAN_ERROR_FILE_NOT_FOUND;
     }
     
+    // Streaming buffer shared by the header and the vertex body
+    PLYReader reader;
+    memset(&reader, 0, sizeof(reader));
+    reader.fd = fd;
+    reader.buffer = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, PLY_READ_BUFFER_SIZE, CACHE_LINE_SIZE);
+    if (!reader.buffer) {
+        debug_log_error("Failed to allocate %u byte PLY read buffer", PLY_READ_BUFFER_SIZE);
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
     // Parse header
     PLYHeader header;
-    GaussianResult result = parse_ply_header(fd, &header);
+    GaussianResult result = parse_ply_header(&reader, &header);
     if (result != GAUSSIAN_SUCCESS) {
+        memory_free(reader.buffer);
         close_file(fd);
         return result;
     }
     
+    // Records are 128 bytes, so the scene budget, not MAX_SPLATS_PER_SCENE,
+    // is the practical limit. Files past either keep their most important
+    // vertices, as a load budget does. Refuse up front if the records and
+    // their hot stream still won't fit; warm and cold are only built when
+    // room is left.
+    u32 kept_count = (budget > 0) ? MIN(budget, header.vertex_count) : header.vertex_count;
+    kept_count = MIN(kept_count, MAX_SPLATS_PER_SCENE);
+    MemoryBudgetStats budget_stats;
+    memory_get_budget_stats(MEMORY_BUDGET_SCENE, &budget_stats);
+    u32 resident_limit = (u32)(budget_stats.free_bytes / PLY_RESIDENT_SPLAT_BYTES);
+    if (kept_count > resident_limit) {
+        debug_log_warning("Scene budget has %u KB free: keeping %u of %u splats",
+                         budget_stats.free_bytes / 1024, resident_limit, kept_count);
+        kept_count = resident_limit;
+    }
+    size_t splats_size = kept_count * sizeof(GaussianSplat3D);
+    size_t streams_size = kept_count * sizeof(GaussianSplatHot);
+    size_t heap_size = (kept_count < header.vertex_count) ? kept_count * sizeof(u32) : 0;
+    if (kept_count == 0 || !memory_budget_fits(MEMORY_BUDGET_SCENE, splats_size + streams_size + heap_size)) {
+        debug_log_error("Scene of %u splats needs %zu KB, scene budget has %u KB free",
+                       kept_count, (splats_size + streams_size + heap_size) / 1024, budget_stats.free_bytes / 1024);
+        memory_free(reader.buffer);
+        close_file(fd);
+        return GAUSSIAN_ERROR_OUT_OF_MEMORY;
+    }
+    
     // Allocate memory for splats
-    size_t splats_size = header.vertex_count * sizeof(GaussianSplat3D);
-    *splats = (GaussianSplat3D*)splatstorm_alloc_aligned(splats_size, 16);
+    *splats = (GaussianSplat3D*)memory_alloc(MEMORY_BUDGET_SCENE, splats_size, CACHE_LINE_SIZE);
     if (!*splats) {
         debug_log_error("Failed to allocate memory for %u splats (%zu bytes)", 
                        header.vertex_count, splats_size);
+        memory_free(reader.buffer);
         close_file(fd);
         return GAUSSIAN_ERROR_OUT_OF_MEMORY;
     }
     
-    debug_log_info("Allocated %zu bytes for %u splats", splats_size, header.vertex_count);
+    debug_log_info("Allocated %zu bytes for %u splats", splats_size, kept_count);
     
-    // Read vertex data
-    if (header.is_binary) {
-        // Binary format - read in chunks
-        u8* vertex_buffer = (u8*)splatstorm_alloc_aligned(CHUNK_SIZE, 16);
-        if (!vertex_buffer) {
-            splatstorm_free_aligned(*splats);
+    // Budgeted load: select the most important vertices while converting
+    PLYSelection selection = { *splats, NULL, kept_count, 0 };
+    if (kept_count < header.vertex_count) {
+        selection.heap = (u32*)memory_alloc(MEMORY_BUDGET_SCENE, kept_count * sizeof(u32), CACHE_LINE_SIZE);
+        if (!selection.heap) {
+            memory_free(*splats);
             *splats = NULL;
+            memory_free(reader.buffer);
             close_file(fd);
             return GAUSSIAN_ERROR_OUT_OF_MEMORY;
         }
+        debug_log_info("Splat budget %u: keeping the most important of %u vertices", kept_count, header.vertex_count);
+    }
+    PLYSelection* select = selection.heap ? &selection : NULL;
+    
+    // Resolve property names and types once for the whole body
+    PLYVertexPlan plan;
+    build_vertex_plan(&header, &plan);
+    
+    u32 vertices_read = 0;
+    
+    // Read vertex data
+    if (header.is_binary) {
+        // Binary format - convert the complete records the header read left in the buffer
+        u32 body_offset = reader.file_offset - (reader.size - reader.pos);
+        PLYBodyDecoder decoder = { &header, &plan, *splats, select, body_offset, 0 };
+        decode_binary_block(reader.buffer + reader.pos, reader.size - reader.pos, body_offset, &decoder);
+        vertices_read = decoder.vertices_read;
         
-        u32 vertices_read = 0;
-        int buffer_pos = 0;
-        int buffer_size = 0;
+        memory_free(reader.buffer);
+        reader.buffer = NULL;
+        close_file(fd);
+        fd = -1;
         
-        while (vertices_read < header.vertex_count) {
-            // Refill buffer if needed
-            if (buffer_pos + header.vertex_size > buffer_size) {
-                // Move remaining data to beginning of buffer
-                if (buffer_pos < buffer_size) {
-                    memmove(vertex_buffer, vertex_buffer + buffer_pos, buffer_size - buffer_pos);
-                    buffer_size -= buffer_pos;
-                } else {
-                    buffer_size = 0;
-                }
-                buffer_pos = 0;
-                
-                // Read more data
-                int bytes_read = read_file_data(fd, vertex_buffer + buffer_size, 
-                                              CHUNK_SIZE - buffer_size);
-                if (bytes_read > 0) {
-                    buffer_size += bytes_read;
-                }
-            }
-            
-            // Check if we have enough data for a complete vertex
-            if (buffer_pos + header.vertex_size > buffer_size) {
-                debug_log_error("Incomplete vertex data at vertex %u", vertices_read);
-                break;
-            }
-            
-            // Convert vertex to splat
-            convert_vertex_to_splat(&header, vertex_buffer + buffer_pos, NULL, 
-                                  &(*splats)[vertices_read]);
-            
-            buffer_pos += header.vertex_size;
-            vertices_read++;
+        // The rest streams through the pipeline in blocks of 64 whole records or
+        // a multiple, so blocks stay cache-line sized and no record straddles two
+        u32 block_records = 64 * MAX(1U, PLY_READ_BLOCK / (64U * header.vertex_size));
+        u32 start = body_offset + vertices_read * header.vertex_size;
+        result = file_read_pipelined(filename, start, (header.vertex_count - vertices_read) * header.vertex_size,
+                                     block_records * header.vertex_size, decode_binary_block, &decoder, NULL);
+        vertices_read = decoder.vertices_read;
+        if (result != GAUSSIAN_SUCCESS || vertices_read < header.vertex_count) {
+            debug_log_error("Incomplete vertex data at vertex %u", vertices_read);
         }
         
-        splatstorm_free_aligned(vertex_buffer);
-        
     } else {
-        // ASCII format - read line by line
+        // ASCII format - read line by line from the same buffer
         char line[MAX_LINE_LENGTH];
-        u32 vertices_read = 0;
         
         while (vertices_read < header.vertex_count) {
-            int line_length = read_line(fd, line, sizeof(line));
+            int line_length = read_line(&reader, line, sizeof(line));
             if (line_length <= 0) {
-                debug_log_error("Unexpected end of file at vertex %u", vertices_read);
-                break;
-            }
-            
-            // Skip empty lines
-            if (line_length == 0 || line[0] == '\0') {
-                continue;
+                if (reader.eof && reader.pos >= reader.size) {
+                    debug_log_error("Unexpected end of file at vertex %u", vertices_read);
+                    break;
+                }
+                continue;  // Skip empty lines
             }
             
             // Convert vertex to splat
-            convert_vertex_to_splat(&header, NULL, line, &(*splats)[vertices_read]);
+            if (select) {
+                GaussianSplat3D converted;
+                convert_ascii_vertex(&header, &plan, line, &converted);
+                selection_offer(select, &converted);
+            } else {
+                convert_ascii_vertex(&header, &plan, line, &(*splats)[vertices_read]);
+            }
             vertices_read++;
         }
     }
     
-    close_file(fd);
+    memory_free(reader.buffer);
+    memory_free(selection.heap);
+    if (fd >= 0) {
+        close_file(fd);
+    }
     
-    *count = header.vertex_count;
+    // Only converted vertices are valid splats
+    *count = select ? select->count : vertices_read;
     
     debug_log_info("Successfully loaded %u Gaussian splats from PLY file", *count);
     return GAUSSIAN_SUCCESS;
-}
\ No newline at end of file
+}
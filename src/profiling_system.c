@@ -1,10 +1,14 @@
 /*
  * SPLATSTORM X - Comprehensive Profiling System
  * Cycle-accurate performance measurement and debug visualization
+ * Boot timeline: one event per init phase and IOP module load, to the first frame
+ * Zone profiler: per-frame zone cycles in a ring of PROFILE_HISTORY_FRAMES, with percentiles
+ * Zone performance counters: PCR0/PCR1 event deltas per zone, averaged per frame
  */
 
 #include <tamtypes.h>
 #include <kernel.h>
+#include <stdio.h>
 #include <string.h>
 #include "splatstorm_debug.h"
 #include "splatstorm_x.h"
@@ -380,4 +384,483 @@ void profiling_print_results(void) {
 
 void profiling_get_data(FrameProfileData* data) {
     profile_get_frame_data(data);
-}
\ No newline at end of file
+}
+/*
+ * Boot timeline
+ * One event per init phase and per IOP module load, timed from
+ * boot_profile_start(). Scopes (boot_profile_begin/end) nest; a phase lasts
+ * until the next phase or the end of its scope, so an init sequence needs
+ * one call per step. Module loads may run on the I/O worker: they are
+ * recorded whole and flagged as background.
+ */
+
+typedef struct {
+    const char* name;                         // Static string
+    u64 start;                                // Cycles since boot_profile_start
+    u64 end;                                  // Equals start for marks
+    u8 kind;                                  // BootEventKind
+    u8 depth;                                 // Scopes open around it
+    bool scope;                               // From boot_profile_begin: holds other events
+    bool background;                          // Recorded off the boot thread
+} BootProfileEvent;
+
+static struct {
+    bool started;
+    bool finished;
+    s32 boot_thread;
+    u64 origin;                               // get_cpu_cycles() at boot_profile_start
+    u64 total;                                // Cycles to the first frame
+    
+    BootProfileEvent events[BOOT_PROFILE_MAX_EVENTS];
+    u32 event_count;
+    u32 dropped;                              // Events past BOOT_PROFILE_MAX_EVENTS
+    
+    // Open scopes and phases on the boot thread, innermost last; -1 when
+    // the event itself was dropped
+    s32 open[BOOT_PROFILE_MAX_DEPTH];
+    bool open_scope[BOOT_PROFILE_MAX_DEPTH];
+    u32 open_count;
+    u32 hidden_scopes;                        // Scopes nested past BOOT_PROFILE_MAX_DEPTH
+} g_boot_profile = {0};
+
+static const char* const g_boot_event_kinds[] = {"phase", "irx", "mark"};
+
+/*
+ * Start the timeline; call first thing in main
+ */
+void boot_profile_start(void) {
+    memset(&g_boot_profile, 0, sizeof(g_boot_profile));
+    g_boot_profile.origin = get_cpu_cycles();
+    g_boot_profile.boot_thread = GetThreadId();
+    g_boot_profile.started = true;
+}
+
+static bool boot_profile_recording(void) {
+    return g_boot_profile.started && !g_boot_profile.finished;
+}
+
+/*
+ * Reserve and fill an event; returns its index or -1 when the table is full.
+ * The I/O worker records too, so the slot is taken with interrupts off.
+ */
+static s32 boot_profile_record(const char* name, BootEventKind kind, u64 start, u64 end) {
+    DIntr();
+    u32 index = g_boot_profile.event_count;
+    if (index < BOOT_PROFILE_MAX_EVENTS) {
+        g_boot_profile.event_count = index + 1;
+    } else {
+        g_boot_profile.dropped++;
+    }
+    EIntr();
+    if (index >= BOOT_PROFILE_MAX_EVENTS) {
+        return -1;
+    }
+    
+    bool background = GetThreadId() != g_boot_profile.boot_thread;
+    BootProfileEvent* event = &g_boot_profile.events[index];
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    event->kind = (u8)kind;
+    event->depth = background ? 0 : (u8)g_boot_profile.open_count;
+    event->scope = false;
+    event->background = background;
+    return (s32)index;
+}
+
+static void boot_profile_push(const char* name, bool scope) {
+    if (g_boot_profile.open_count >= BOOT_PROFILE_MAX_DEPTH) {
+        if (scope) {
+            g_boot_profile.hidden_scopes++;  // Its boot_profile_end only unwinds this count
+        }
+        return;
+    }
+    
+    u64 now = get_cpu_cycles() - g_boot_profile.origin;
+    s32 index = boot_profile_record(name, BOOT_EVENT_PHASE, now, now);
+    if (index >= 0) {
+        g_boot_profile.events[index].scope = scope;
+    }
+    g_boot_profile.open[g_boot_profile.open_count] = index;
+    g_boot_profile.open_scope[g_boot_profile.open_count] = scope;
+    g_boot_profile.open_count++;
+}
+
+static void boot_profile_pop(void) {
+    s32 index = g_boot_profile.open[--g_boot_profile.open_count];
+    if (index >= 0) {
+        g_boot_profile.events[index].end = get_cpu_cycles() - g_boot_profile.origin;
+    }
+}
+
+static bool boot_profile_phase_open(void) {
+    return g_boot_profile.open_count > 0 && !g_boot_profile.open_scope[g_boot_profile.open_count - 1];
+}
+
+/*
+ * Open a scope; phases and loads until the matching boot_profile_end nest in it
+ */
+void boot_profile_begin(const char* name) {
+    if (!boot_profile_recording()) return;
+    boot_profile_push(name, true);
+}
+
+/*
+ * End the current phase of the innermost scope, if any, and start the next
+ */
+void boot_profile_phase(const char* name) {
+    if (!boot_profile_recording() || g_boot_profile.hidden_scopes > 0) return;
+    if (boot_profile_phase_open()) {
+        boot_profile_pop();
+    }
+    boot_profile_push(name, false);
+}
+
+/*
+ * Close the innermost scope and its last phase
+ */
+void boot_profile_end(void) {
+    if (!boot_profile_recording()) return;
+    if (g_boot_profile.hidden_scopes > 0) {
+        g_boot_profile.hidden_scopes--;
+        return;
+    }
+    if (boot_profile_phase_open()) {
+        boot_profile_pop();
+    }
+    if (g_boot_profile.open_count > 0) {
+        boot_profile_pop();
+    }
+}
+
+/*
+ * Record a finished event timed by the caller with get_cpu_cycles(); safe
+ * from any thread
+ */
+void boot_profile_event(const char* name, BootEventKind kind, u64 start_cycles, u64 end_cycles) {
+    if (!boot_profile_recording()) return;
+    boot_profile_record(name, kind, start_cycles - g_boot_profile.origin, end_cycles - g_boot_profile.origin);
+}
+
+void boot_profile_mark(const char* name) {
+    if (!boot_profile_recording()) return;
+    u64 now = get_cpu_cycles() - g_boot_profile.origin;
+    boot_profile_record(name, BOOT_EVENT_MARK, now, now);
+}
+
+static void boot_profile_export_job(void* path) {
+    boot_profile_export((const char*)path);
+}
+
+/*
+ * First frame: close what is still open, stop recording, print the
+ * timeline and write it to log_path on the I/O worker (NULL: no log)
+ */
+void boot_profile_finish(const char* log_path) {
+    if (!boot_profile_recording()) return;
+    
+    while (g_boot_profile.open_count > 0) {
+        boot_profile_pop();
+    }
+    g_boot_profile.hidden_scopes = 0;
+    boot_profile_mark("First frame");
+    g_boot_profile.total = get_cpu_cycles() - g_boot_profile.origin;
+    g_boot_profile.finished = true;
+    
+    boot_profile_print();
+    if (log_path && !worker_post_job(boot_profile_export_job, (void*)log_path, NULL, 0)) {
+        debug_log_warning("Boot timeline not exported: I/O queue full");
+    }
+}
+
+bool boot_profile_finished(void) {
+    return g_boot_profile.finished;
+}
+
+/*
+ * Timeline to the console: start, duration, nesting by indent
+ */
+void boot_profile_print(void) {
+    printf("SPLATSTORM X: Boot timeline, %.2f ms to first frame (%u events, %u dropped)\n",
+           cycles_to_ms(g_boot_profile.total), g_boot_profile.event_count, g_boot_profile.dropped);
+    printf("     start ms    time ms  kind   event\n");
+    
+    for (u32 i = 0; i < g_boot_profile.event_count; i++) {
+        const BootProfileEvent* event = &g_boot_profile.events[i];
+        printf("  %10.2f %10.2f  %-5s  %*s%s%s\n",
+               cycles_to_ms(event->start), cycles_to_ms(event->end - event->start),
+               g_boot_event_kinds[event->kind], event->depth * 2, "", event->name,
+               event->background ? " [worker]" : "");
+    }
+}
+
+/*
+ * Timeline as CSV, one event per line in recording order
+ */
+GaussianResult boot_profile_export(const char* filename) {
+    if (!filename) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        debug_log_warning("Boot timeline not exported: cannot open %s", filename);
+        return GAUSSIAN_ERROR_FILE_OPEN_FAILED;
+    }
+    
+    fprintf(file, "event,kind,depth,thread,start_ms,duration_ms\n");
+    for (u32 i = 0; i < g_boot_profile.event_count; i++) {
+        const BootProfileEvent* event = &g_boot_profile.events[i];
+        fprintf(file, "%s,%s,%u,%s,%.3f,%.3f\n", event->name, g_boot_event_kinds[event->kind], event->depth,
+                event->background ? "worker" : "boot", cycles_to_ms(event->start),
+                cycles_to_ms(event->end - event->start));
+    }
+    fclose(file);
+    
+    debug_log_info("Boot timeline exported to %s (%u events)", filename, g_boot_profile.event_count);
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Time to the first frame (0 before it) and the slowest single step: the
+ * longest phase without steps of its own, or module load
+ */
+void boot_profile_get_summary(float* total_ms, const char** slowest_name, float* slowest_ms) {
+    const BootProfileEvent* slowest = NULL;
+    for (u32 i = 0; i < g_boot_profile.event_count; i++) {
+        const BootProfileEvent* event = &g_boot_profile.events[i];
+        if (event->scope || event->kind == BOOT_EVENT_MARK) {
+            continue;
+        }
+        if (!slowest || event->end - event->start > slowest->end - slowest->start) {
+            slowest = event;
+        }
+    }
+    
+    if (total_ms) *total_ms = g_boot_profile.finished ? cycles_to_ms(g_boot_profile.total) : 0.0f;
+    if (slowest_name) *slowest_name = slowest ? slowest->name : "none";
+    if (slowest_ms) *slowest_ms = slowest ? cycles_to_ms(slowest->end - slowest->start) : 0.0f;
+}
+
+/*
+ * Zone profiler
+ * The zones themselves are inline in profile_zones.h and only add into
+ * g_profile_zone_frame. profile_zones_end_frame() closes the FRAME zone,
+ * the time since the previous call, and copies the row into the ring, so
+ * the last PROFILE_HISTORY_FRAMES frames stay available for percentiles.
+ * One row is PROFILE_ZONE_COUNT words and the ring 6 KB, cache aligned.
+ *
+ * Performance counter deltas are not kept per frame: they add into
+ * per-zone totals since the event pair was picked, reported per frame.
+ */
+ProfileZoneFrame g_profile_zone_frame = {{0}};
+
+static struct {
+    u32 rows[PROFILE_HISTORY_FRAMES][PROFILE_ZONE_COUNT] __attribute__((aligned(64)));
+    u32 frames;                               // Rows written; the newest is frames - 1
+} g_profile_zone_history;
+
+static const char* const g_profile_zone_names[PROFILE_ZONE_COUNT] = {
+    "Frame", "Render", "Cull", "VU", "Tile", "GS", "GS sync", "LOD", "Streaming", "Bin", "Sort", "Packets"
+};
+
+// PCCR fields: CTE, then per counter EXL/K/S/U mode bits and a 5-bit event.
+// Kernel, supervisor and user mode count; exception handlers (EXL) do not.
+#define PCCR_CTE                 (1U << 31)
+#define PCCR_COUNTER0(event)     ((0xEU << 1) | ((u32)(event) << 5))
+#define PCCR_COUNTER1(event)     ((0xEU << 11) | ((u32)(event) << 15))
+
+static const struct {
+    u8 event0;
+    u8 event1;
+    const char* name0;
+    const char* name1;
+} g_profile_counter_sets[PROFILE_COUNTER_SETS] = {
+    {0, 0, "-", "-"},
+    {6, 6, "I-miss", "D-miss"},
+    {3, 3, "Branch", "Mispredict"},
+    {12, 2, "Instr", "Dual"},
+    {11, 11, "Addr busy", "Data busy"},
+};
+
+static struct {
+    ProfileCounterSet set;
+    u64 totals[2][PROFILE_ZONE_COUNT];        // Events since the set was picked
+    u32 frames;                               // Frames in the totals
+    u32 last[2];                              // Whole-frame events of the newest frame
+} g_profile_counters = {PROFILE_COUNTERS_OFF, {{0}}, 0, {0}};
+
+// PCR0/PCR1 from 0; they count up to bit 31, which raises the counter
+// exception, so the frame restarts them long before that
+static void profile_counters_restart(void) {
+#ifdef PROFILE_ZONE_COUNTERS
+    __asm__ volatile("mtpc $0, 0\n\tmtpc $0, 1\n\tsync.p");
+#endif
+}
+
+/*
+ * Pick the PCR0/PCR1 event pair and start the totals over. Builds without
+ * PROFILE_ZONE_COUNTERS (release) leave the counters off.
+ */
+void profile_zones_set_counters(ProfileCounterSet set) {
+    if (set >= PROFILE_COUNTER_SETS) return;
+    
+#ifdef PROFILE_ZONE_COUNTERS
+    u32 pccr = 0;
+    if (set != PROFILE_COUNTERS_OFF) {
+        pccr = PCCR_CTE | PCCR_COUNTER0(g_profile_counter_sets[set].event0) |
+               PCCR_COUNTER1(g_profile_counter_sets[set].event1);
+    }
+    __asm__ volatile("mtps $0, 0\n\tsync.p");
+    profile_counters_restart();
+    __asm__ volatile("mtps %0, 0\n\tsync.p" : : "r"(pccr));
+#else
+    set = PROFILE_COUNTERS_OFF;
+#endif
+    
+    memset(&g_profile_counters, 0, sizeof(g_profile_counters));
+    g_profile_counters.set = set;
+    debug_log_info("Performance counters: %s / %s", g_profile_counter_sets[set].name0,
+                   g_profile_counter_sets[set].name1);
+}
+
+ProfileCounterSet profile_zones_get_counters(void) {
+    return g_profile_counters.set;
+}
+
+const char* profile_counter_name(ProfileCounterSet set, u32 counter) {
+    if (set >= PROFILE_COUNTER_SETS) return "-";
+    return counter == 0 ? g_profile_counter_sets[set].name0 : g_profile_counter_sets[set].name1;
+}
+
+/*
+ * Mean PCR0/PCR1 events per recorded frame in one zone. False while the
+ * counters are off or before the first frame.
+ */
+bool profile_zone_counters(ProfileZone zone, float per_frame[2]) {
+    if (zone >= PROFILE_ZONE_COUNT || !per_frame || g_profile_counters.set == PROFILE_COUNTERS_OFF ||
+        g_profile_counters.frames == 0) {
+        return false;
+    }
+    
+    per_frame[0] = (float)g_profile_counters.totals[0][zone] / g_profile_counters.frames;
+    per_frame[1] = (float)g_profile_counters.totals[1][zone] / g_profile_counters.frames;
+    return true;
+}
+
+/*
+ * Drop the history and start timing the next frame now
+ */
+void profile_zones_reset(void) {
+    memset(&g_profile_zone_history, 0, sizeof(g_profile_zone_history));
+    memset(&g_profile_zone_frame, 0, sizeof(g_profile_zone_frame));
+    g_profile_zone_frame.start[PROFILE_ZONE_FRAME] = profile_zone_clock();
+}
+
+/*
+ * End the frame once per main loop pass. record false discards it, for
+ * passes that drew nothing (paused) and would skew the frame times.
+ */
+void profile_zones_end_frame(bool record) {
+    u32 now = profile_zone_clock();
+    g_profile_zone_frame.cycles[PROFILE_ZONE_FRAME] = now - g_profile_zone_frame.start[PROFILE_ZONE_FRAME];
+    
+    if (record) {
+        u32* row = g_profile_zone_history.rows[g_profile_zone_history.frames % PROFILE_HISTORY_FRAMES];
+        memcpy(row, g_profile_zone_frame.cycles, sizeof(g_profile_zone_frame.cycles));
+        g_profile_zone_history.frames++;
+    }
+    
+#ifdef PROFILE_ZONE_COUNTERS
+    // The counters restart with every frame, so the frame zone's events are
+    // simply their value now
+    if (g_profile_counters.set != PROFILE_COUNTERS_OFF) {
+        g_profile_zone_frame.counters[0][PROFILE_ZONE_FRAME] = profile_zone_pcr0();
+        g_profile_zone_frame.counters[1][PROFILE_ZONE_FRAME] = profile_zone_pcr1();
+        profile_counters_restart();
+        if (record) {
+            g_profile_counters.last[0] = g_profile_zone_frame.counters[0][PROFILE_ZONE_FRAME];
+            g_profile_counters.last[1] = g_profile_zone_frame.counters[1][PROFILE_ZONE_FRAME];
+            for (u32 zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+                g_profile_counters.totals[0][zone] += g_profile_zone_frame.counters[0][zone];
+                g_profile_counters.totals[1][zone] += g_profile_zone_frame.counters[1][zone];
+            }
+            g_profile_counters.frames++;
+        }
+    }
+    memset(g_profile_zone_frame.counters, 0, sizeof(g_profile_zone_frame.counters));
+#endif
+    
+    memset(g_profile_zone_frame.cycles, 0, sizeof(g_profile_zone_frame.cycles));
+    g_profile_zone_frame.start[PROFILE_ZONE_FRAME] = now;
+}
+
+const char* profile_zone_name(ProfileZone zone) {
+    return (zone < PROFILE_ZONE_COUNT) ? g_profile_zone_names[zone] : "Unknown";
+}
+
+/*
+ * Zone cycles and whole-frame PCR0/PCR1 events of the newest recorded
+ * frame; events are 0 while the counters are off. False before the first.
+ */
+bool profile_zones_latest(u32 cycles[PROFILE_ZONE_COUNT], u32 events[2]) {
+    if (g_profile_zone_history.frames == 0) return false;
+    
+    const u32* row = g_profile_zone_history.rows[(g_profile_zone_history.frames - 1) % PROFILE_HISTORY_FRAMES];
+    if (cycles) memcpy(cycles, row, PROFILE_ZONE_COUNT * sizeof(u32));
+    if (events) {
+        bool counting = g_profile_counters.set != PROFILE_COUNTERS_OFF;
+        events[0] = counting ? g_profile_counters.last[0] : 0;
+        events[1] = counting ? g_profile_counters.last[1] : 0;
+    }
+    return true;
+}
+
+/*
+ * Newest max_values frames of a zone in ms, oldest first. Returns the count.
+ */
+u32 profile_zone_history(ProfileZone zone, float* values_ms, u32 max_values) {
+    if (zone >= PROFILE_ZONE_COUNT || !values_ms) return 0;
+    
+    u32 count = MIN(MIN(g_profile_zone_history.frames, PROFILE_HISTORY_FRAMES), max_values);
+    u32 first = g_profile_zone_history.frames - count;
+    for (u32 i = 0; i < count; i++) {
+        values_ms[i] = cycles_to_ms(g_profile_zone_history.rows[(first + i) % PROFILE_HISTORY_FRAMES][zone]);
+    }
+    return count;
+}
+
+/*
+ * Min/avg/max and nearest-rank percentiles over the ring. False (summary
+ * zeroed) before the first recorded frame.
+ */
+bool profile_zone_summary(ProfileZone zone, ProfileZoneSummary* summary) {
+    if (!summary) return false;
+    memset(summary, 0, sizeof(ProfileZoneSummary));
+    
+    u32 count = MIN(g_profile_zone_history.frames, PROFILE_HISTORY_FRAMES);
+    if (zone >= PROFILE_ZONE_COUNT || count == 0) return false;
+    
+    // Insertion sort of a copy: a few thousand compares, once per stats print
+    u32 sorted[PROFILE_HISTORY_FRAMES];
+    u64 total = 0;
+    for (u32 i = 0; i < count; i++) {
+        u32 value = g_profile_zone_history.rows[i][zone];
+        u32 j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+        total += value;
+    }
+    
+    summary->frames = count;
+    summary->min_ms = cycles_to_ms(sorted[0]);
+    summary->max_ms = cycles_to_ms(sorted[count - 1]);
+    summary->avg_ms = cycles_to_ms(total) / count;
+    summary->p50_ms = cycles_to_ms(sorted[(count * 50 + 99) / 100 - 1]);
+    summary->p95_ms = cycles_to_ms(sorted[(count * 95 + 99) / 100 - 1]);
+    summary->p99_ms = cycles_to_ms(sorted[(count * 99 + 99) / 100 - 1]);
+    return true;
+}
@@ -1,6 +1,8 @@
 /*
  * SPLATSTORM X - Complete PS2SDK File I/O System
  * Full implementation of PS2 file system support with multiple storage devices
+ * Asset lookup ordered by per-device read benchmarks taken at boot
+ * Devices join the lookup as their IOP drivers load (iop_require_device)
  * NO STUBS - Complete implementation using PS2SDK fileXio and device drivers
  */
 
@@ -15,6 +17,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <dirent.h>
 #include <loadfile.h>
 #include <sbv_patches.h>
 #include <libmc.h>
@@ -27,6 +30,12 @@
 #define FS_STATUS_READY         2
 #define FS_STATUS_ERROR         3
 
+// Device benchmark: sequential read of the largest file in the device root
+#define STORAGE_BENCH_BLOCK      (64 * 1024)
+#define STORAGE_BENCH_BYTES      (4 * STORAGE_BENCH_BLOCK)
+#define STORAGE_BENCH_MAX_CYCLES (PS2_EE_CLOCK_FREQ / 4)   // Stop a slow device after 250 ms
+#define STORAGE_BENCH_SCAN       32                        // Root entries examined for a probe file
+
 // Storage device types
 typedef enum {
     STORAGE_MEMORY_CARD_0,
@@ -46,19 +55,44 @@ typedef struct {
     int mounted;
     u64 total_space;
     u64 free_space;
+    int benchmarked;
+    u32 read_kbps;          // Sequential read rate, 0 if no probe file could be read
+    u32 open_latency_us;    // open() of the probe file, or of the root without one
+    int probed;             // Detection ran; needs the device's IOP drivers
 } StorageInfo;
 
 static StorageInfo g_storage_devices[STORAGE_COUNT] = {
-    {"mc0:", "Memory Card 0", 0, 0, 0, 0},
-    {"mc1:", "Memory Card 1", 0, 0, 0, 0},
-    {"mass:", "USB Mass Storage", 0, 0, 0, 0},
-    {"pfs0:", "Hard Disk Drive", 0, 0, 0, 0},
-    {"host:", "Host PC (Network)", 0, 0, 0, 0},
-    {"cdfs:", "CD/DVD", 0, 0, 0, 0}
+    {"mc0:", "Memory Card 0", 0, 0, 0, 0, 0, 0, 0},
+    {"mc1:", "Memory Card 1", 0, 0, 0, 0, 0, 0, 0},
+    {"mass:", "USB Mass Storage", 0, 0, 0, 0, 0, 0, 0},
+    {"pfs0:", "Hard Disk Drive", 0, 0, 0, 0, 0, 0, 0},
+    {"host:", "Host PC (Network)", 0, 0, 0, 0, 0, 0, 0},
+    {"cdfs:", "CD/DVD", 0, 0, 0, 0, 0, 0, 0}
+};
+
+// Static search order, used for devices without a read rate
+static const StorageDevice g_storage_search_order[STORAGE_COUNT] = {
+    STORAGE_USB_MASS,
+    STORAGE_HDD,
+    STORAGE_HOST,
+    STORAGE_MEMORY_CARD_0,
+    STORAGE_MEMORY_CARD_1,
+    STORAGE_CDVD
+};
+
+// IOP device class serving each device
+static const int g_storage_iop_class[STORAGE_COUNT] = {
+    IOP_DEVICE_MEMCARD,
+    IOP_DEVICE_MEMCARD,
+    IOP_DEVICE_USB_MASS,
+    IOP_DEVICE_HDD,
+    IOP_DEVICE_HOST,
+    IOP_DEVICE_CDROM
 };
 
 static int g_file_system_status = FS_STATUS_UNINITIALIZED;
 static int g_sif_initialized = 0;
+static int g_mc_initialized = 0;
 
 /**
  * Initialize SIF RPC system
@@ -83,58 +117,17 @@ static int initialize_sif_rpc(void) {
 }
 
 /**
- * Load required IRX modules for file I/O
+ * Load required IRX modules for file I/O: the core modules and the boot
+ * device's drivers. Other devices load theirs on first use.
  */
 static int load_file_io_modules(void) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    int ret;
-    
-    // Load basic I/O modules
-    ret = SifLoadModule("rom0:IOMANX.IRX", 0, NULL);
-    if (ret < 0) {
-        debug_log_error("Failed to load IOMANX.IRX: %d", ret);
-        return GAUSSIAN_ERROR_MODULE_LOAD_FAILED;
-    }
-    
-    ret = SifLoadModule("rom0:FILEXIO.IRX", 0, NULL);
+    int ret = iop_init_enhanced_modules();
     if (ret < 0) {
-        debug_log_error("Failed to load FILEXIO.IRX: %d", ret);
+        debug_log_error("Failed to load file I/O modules: %d", ret);
         return GAUSSIAN_ERROR_MODULE_LOAD_FAILED;
     }
     
-    // Load USB mass storage support
-    ret = SifLoadModule("rom0:USBD.IRX", 0, NULL);
-    if (ret >= 0) {
-        ret = SifLoadModule("mass:/USBMASS.IRX", 0, NULL);
-        if (ret >= 0) {
-            debug_log_info("USB mass storage modules loaded");
-        }
-    }
-    
-    // Load memory card support
-    ret = SifLoadModule("rom0:MCMAN.IRX", 0, NULL);
-    if (ret >= 0) {
-        ret = SifLoadModule("rom0:MCSERV.IRX", 0, NULL);
-        if (ret >= 0) {
-            debug_log_info("Memory card modules loaded");
-        }
-    }
-    
-    // Load HDD support (if available)
-    ret = SifLoadModule("rom0:PS2ATAD.IRX", 0, NULL);
-    if (ret >= 0) {
-        ret = SifLoadModule("rom0:PS2HDD.IRX", 0, NULL);
-        if (ret >= 0) {
-            ret = SifLoadModule("rom0:PS2FS.IRX", 0, NULL);
-            if (ret >= 0) {
-                debug_log_info("HDD modules loaded");
-            }
-        }
-    }
-    
     debug_log_info("File I/O modules loaded");
-
-    
     return GAUSSIAN_SUCCESS;
 }
 
@@ -151,61 +144,232 @@ static int initialize_filexio(void) {
 }
 
 /**
- * Detect and mount storage devices
+ * Detect and mount one storage device
  */
-static void detect_storage_devices(void) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    // Check memory cards
-    mcInit(MC_TYPE_MC);
+static void probe_storage_device(StorageDevice device) {
+    StorageInfo* info = &g_storage_devices[device];
+    info->probed = 1;
+    
+    switch (device) {
+        case STORAGE_MEMORY_CARD_0:
+        case STORAGE_MEMORY_CARD_1: {
+            if (!g_mc_initialized) {
+                mcInit(MC_TYPE_MC);
+                g_mc_initialized = 1;
+            }
+            int mc_type = 0;
+            mcGetInfo(device == STORAGE_MEMORY_CARD_1, 0, &mc_type, NULL, NULL);
+            info->available = (mc_type > 0);
+            break;
+        }
+        
+        case STORAGE_CDVD:
+            // CD/DVD is always potentially available
+            info->available = 1;
+            break;
+        
+        default: {
+            // USB, HDD and host: the root opens once the driver sees media
+            char root[16];
+            snprintf(root, sizeof(root), "%s/", info->prefix);
+            int fd = open(root, O_RDONLY, 0);
+            if (fd >= 0) {
+                close(fd);
+                info->available = 1;
+            }
+            break;
+        }
+    }
     
-    int mc0_type, mc1_type;
-    mcGetInfo(0, 0, &mc0_type, NULL, NULL);
-    mcGetInfo(1, 0, &mc1_type, NULL, NULL);
+    info->mounted = info->available;
+    if (info->available) {
+        debug_log_info("%s detected", info->name);
+    }
+}
+
+/**
+ * Detect the devices whose IOP drivers run and that were not probed yet.
+ * Returns the number probed.
+ */
+static u32 detect_storage_devices(void) {
+    u32 probed = 0;
+    for (int i = 0; i < STORAGE_COUNT; i++) {
+        if (!g_storage_devices[i].probed && iop_device_ready(g_storage_iop_class[i])) {
+            probe_storage_device((StorageDevice)i);
+            probed++;
+        }
+    }
+    return probed;
+}
+
+/**
+ * Bring in devices whose drivers finished loading since the last lookup
+ */
+static void refresh_storage_devices(void) {
+    if (detect_storage_devices() > 0) {
+        storage_benchmark_devices(false);
+    }
+}
+
+static u32 storage_cycles_to_us(u64 cycles) {
+    return (u32)(cycles * 1000000ULL / PS2_EE_CLOCK_FREQ);
+}
+
+/**
+ * Pick the largest regular file in a device root as the benchmark probe
+ */
+static int storage_find_probe(const StorageInfo* info, char* path, size_t path_size) {
+    char root[16];
+    snprintf(root, sizeof(root), "%s/", info->prefix);
     
-    g_storage_devices[STORAGE_MEMORY_CARD_0].available = (mc0_type > 0);
-    g_storage_devices[STORAGE_MEMORY_CARD_1].available = (mc1_type > 0);
+    DIR* dir = opendir(root);
+    if (!dir) {
+        return 0;
+    }
     
-    if (g_storage_devices[STORAGE_MEMORY_CARD_0].available) {
-        g_storage_devices[STORAGE_MEMORY_CARD_0].mounted = 1;
-        debug_log_info("Memory Card 0 detected");
+    off_t best_size = 0;
+    struct dirent* entry;
+    for (int scanned = 0; scanned < STORAGE_BENCH_SCAN && (entry = readdir(dir)) != NULL; scanned++) {
+        char candidate[256];
+        struct stat st;
+        snprintf(candidate, sizeof(candidate), "%s/%s", info->prefix, entry->d_name);
+        if (stat(candidate, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > best_size) {
+            best_size = st.st_size;
+            strncpy(path, candidate, path_size - 1);
+            path[path_size - 1] = '\0';
+        }
     }
+    closedir(dir);
     
-    if (g_storage_devices[STORAGE_MEMORY_CARD_1].available) {
-        g_storage_devices[STORAGE_MEMORY_CARD_1].mounted = 1;
-        debug_log_info("Memory Card 1 detected");
+    return best_size > 0;
+}
+
+/**
+ * Time open() and a sequential read on one device
+ */
+static void benchmark_storage_device(StorageInfo* info, u8* buffer) {
+    info->benchmarked = 1;
+    info->read_kbps = 0;
+    info->open_latency_us = 0;
+    
+    char path[256];
+    if (!buffer || !storage_find_probe(info, path, sizeof(path))) {
+        // No readable file: the root open is the only latency we can take
+        snprintf(path, sizeof(path), "%s/", info->prefix);
+        u64 start = get_cpu_cycles();
+        int fd = open(path, O_RDONLY, 0);
+        info->open_latency_us = storage_cycles_to_us(get_cpu_cycles() - start);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
     }
     
-    // Check USB mass storage
-    int usb_fd = open("mass:/", O_RDONLY, 0);
-    if (usb_fd >= 0) {
-        close(usb_fd);
-        g_storage_devices[STORAGE_USB_MASS].available = 1;
-        g_storage_devices[STORAGE_USB_MASS].mounted = 1;
-        debug_log_info("USB mass storage detected");
+    u64 start = get_cpu_cycles();
+    int fd = open(path, O_RDONLY, 0);
+    u64 opened = get_cpu_cycles();
+    if (fd < 0) {
+        return;
     }
+    info->open_latency_us = storage_cycles_to_us(opened - start);
     
-    // Check HDD
-    int hdd_fd = open("pfs0:/", O_RDONLY, 0);
-    if (hdd_fd >= 0) {
-        close(hdd_fd);
-        g_storage_devices[STORAGE_HDD].available = 1;
-        g_storage_devices[STORAGE_HDD].mounted = 1;
-        debug_log_info("Hard disk drive detected");
+    // The first read includes the seek to the data; it is part of the rate
+    u32 total = 0;
+    while (total < STORAGE_BENCH_BYTES && get_cpu_cycles() - opened < STORAGE_BENCH_MAX_CYCLES) {
+        int bytes_read = read(fd, buffer, STORAGE_BENCH_BLOCK);
+        if (bytes_read <= 0) {
+            break;
+        }
+        total += bytes_read;
+        if (bytes_read < STORAGE_BENCH_BLOCK) {
+            break;
+        }
     }
+    u32 read_us = storage_cycles_to_us(get_cpu_cycles() - opened);
+    close(fd);
     
-    // Host is available if network is configured
-    int host_fd = open("host:/", O_RDONLY, 0);
-    if (host_fd >= 0) {
-        close(host_fd);
-        g_storage_devices[STORAGE_HOST].available = 1;
-        g_storage_devices[STORAGE_HOST].mounted = 1;
-        debug_log_info("Host PC connection detected");
+    if (total > 0) {
+        info->read_kbps = (u32)((u64)total * 1000000ULL / 1024 / MAX(read_us, 1U));
     }
+    debug_log_info("%s: %u KB/s over %u KB, open %u us (%s)",
+                  info->name, info->read_kbps, total / 1024, info->open_latency_us, path);
+}
+
+/**
+ * Measure every available device once; results stay cached until shutdown
+ */
+u32 storage_benchmark_devices(bool force) {
+    u8* buffer = (u8*)memory_alloc(MEMORY_BUDGET_ASSET, STORAGE_BENCH_BLOCK, 64);
+    u32 measured = 0;
     
-    // CD/DVD is always potentially available
-    g_storage_devices[STORAGE_CDVD].available = 1;
-    g_storage_devices[STORAGE_CDVD].mounted = 1;
+    for (int i = 0; i < STORAGE_COUNT; i++) {
+        StorageInfo* info = &g_storage_devices[i];
+        if (!info->available || !info->mounted || (info->benchmarked && !force)) {
+            continue;
+        }
+        benchmark_storage_device(info, buffer);
+        measured++;
+    }
+    
+    memory_free(buffer);
+    return measured;
+}
+
+/**
+ * Report a device's benchmark, false past the last device. Unmeasured
+ * devices report zeros.
+ */
+bool storage_get_benchmark(u32 device, const char** name, const char** prefix,
+                           u32* read_kbps, u32* open_latency_us) {
+    if (device >= STORAGE_COUNT) {
+        return false;
+    }
+    const StorageInfo* info = &g_storage_devices[device];
+    if (name) *name = info->name;
+    if (prefix) *prefix = info->prefix;
+    if (read_kbps) *read_kbps = info->read_kbps;
+    if (open_latency_us) *open_latency_us = info->open_latency_us;
+    return true;
+}
 
+/**
+ * Expected time to open a file and read one benchmark's worth of it
+ */
+static u32 storage_expected_cost_us(const StorageInfo* info) {
+    return info->open_latency_us + (u32)((u64)(STORAGE_BENCH_BYTES / 1024) * 1000000ULL / info->read_kbps);
+}
+
+/**
+ * Devices in lookup order: measured devices by expected cost, then the rest
+ * in the static order
+ */
+static void build_search_order(StorageDevice order[STORAGE_COUNT]) {
+    int count = 0;
+    for (int i = 0; i < STORAGE_COUNT; i++) {
+        StorageDevice device = g_storage_search_order[i];
+        if (g_storage_devices[device].read_kbps > 0) {
+            order[count++] = device;
+        }
+    }
+    
+    // Insertion sort; stable, so equal costs keep the static order
+    for (int i = 1; i < count; i++) {
+        StorageDevice device = order[i];
+        u32 cost = storage_expected_cost_us(&g_storage_devices[device]);
+        int j = i;
+        while (j > 0 && storage_expected_cost_us(&g_storage_devices[order[j - 1]]) > cost) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = device;
+    }
+    
+    for (int i = 0; i < STORAGE_COUNT; i++) {
+        StorageDevice device = g_storage_search_order[i];
+        if (g_storage_devices[device].read_kbps == 0) {
+            order[count++] = device;
+        }
+    }
 }
 
 /**
@@ -247,6 +411,7 @@ int initialize_file_systems(void) {
     
     // Detect and mount storage devices
     detect_storage_devices();
+    storage_benchmark_devices(false);
     
     g_file_system_status = FS_STATUS_READY;
     
@@ -296,34 +461,50 @@ int find_file_on_storage(const char* filename, char* full_path, size_t path_size
         }
     }
     
-    // Search order: USB -> HDD -> Host -> Memory Cards -> CD/DVD
-    StorageDevice search_order[] = {
-        STORAGE_USB_MASS,
-        STORAGE_HDD,
-        STORAGE_HOST,
-        STORAGE_MEMORY_CARD_0,
-        STORAGE_MEMORY_CARD_1,
-        STORAGE_CDVD
-    };
-    
-    for (int i = 0; i < sizeof(search_order) / sizeof(search_order[0]); i++) {
-        StorageDevice device = search_order[i];
-        
-        if (!is_storage_available(device)) {
-            continue;
-        }
-        
-        snprintf(full_path, path_size, "%s%s", g_storage_devices[device].prefix, filename);
-        
-    // COMPLETE IMPLEMENTATION - Full functionality
-        // Try to open the file
+    // A path that names its device loads that device's drivers on first use
+    if (strchr(filename, ':')) {
+        iop_require_path(filename);
+        snprintf(full_path, path_size, "%s", filename);
         int fd = open(full_path, O_RDONLY, 0);
         if (fd >= 0) {
             close(fd);
-            debug_log_info("Found file: %s", full_path);
             return GAUSSIAN_SUCCESS;
         }
-
+        debug_log_warning("File not found: %s", filename);
+        return GAUSSIAN_ERROR_FILE_NOT_FOUND;
+    }
+    
+    // Devices still loading in the background are searched after the rest
+    u32 searched = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        refresh_storage_devices();
+        
+        // Fastest measured device first; the first device holding the file wins
+        StorageDevice search_order[STORAGE_COUNT];
+        build_search_order(search_order);
+        
+        for (int i = 0; i < STORAGE_COUNT; i++) {
+            StorageDevice device = search_order[i];
+            
+            if (!is_storage_available(device) || (searched & (1U << device))) {
+                continue;
+            }
+            searched |= 1U << device;
+            
+            snprintf(full_path, path_size, "%s%s", g_storage_devices[device].prefix, filename);
+            
+            // Try to open the file
+            int fd = open(full_path, O_RDONLY, 0);
+            if (fd >= 0) {
+                close(fd);
+                debug_log_info("Found file: %s", full_path);
+                return GAUSSIAN_SUCCESS;
+            }
+        }
+        
+        if (!iop_wait_prefetch()) {
+            break;
+        }
     }
     
     debug_log_warning("File not found on any storage device: %s", filename);
@@ -474,6 +655,9 @@ void print_storage_status(void) {
                       info->name, 
                       info->prefix,
                       info->available ? (info->mounted ? "Ready" : "Available") : "Not Available");
+        if (info->benchmarked) {
+            debug_log_info("  Read %u KB/s, open %u us", info->read_kbps, info->open_latency_us);
+        }
     }
 }
 
@@ -499,6 +683,11 @@ void file_system_shutdown(void) {
         g_storage_devices[i].mounted = 0;
         g_storage_devices[i].total_space = 0;
         g_storage_devices[i].free_space = 0;
+        g_storage_devices[i].benchmarked = 0;
+        g_storage_devices[i].read_kbps = 0;
+        g_storage_devices[i].open_latency_us = 0;
+        g_storage_devices[i].probed = 0;
     }
+    g_mc_initialized = 0;
 
 }
\ No newline at end of file
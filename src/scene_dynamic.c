@@ -0,0 +1,204 @@
+/*
+ * SPLATSTORM X - Dynamic Splats
+ * Moves or recolors scene splats in place, at a cost that follows what
+ * changed rather than the scene size.
+ *
+ * scene_splats_update() writes the records and their hot/warm stream
+ * entries right away and queues the range as dirty; callers that write
+ * records themselves queue it with scene_splats_mark_dirty(). Once a frame,
+ * before culling, scene_splats_apply_updates() brings the dependent state
+ * in line with every pending range:
+ *   - moved splats refit their octree leaves and the ancestors whose bounds
+ *     change (spatial_grid_refit_splats), which also drops those nodes'
+ *     visibility history
+ *   - recolored splats lose their SH color cache entries
+ *   - the depth order is repaired from the last one instead of reused
+ *   - the frame is drawn even if the camera did not move
+ * Pending ranges merge when they touch; past SCENE_DIRTY_RANGES the nearest
+ * pair merges, which only refits a few unchanged splats along with them.
+ *
+ * The octree topology stays, so a splat that travels far loosens its leaf
+ * instead of moving to another one. Streaming and paged scenes take no
+ * updates: their records are still being written or come and go.
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_optimized.h"
+#include "splatstorm_debug.h"
+#include <tamtypes.h>
+#include <kernel.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct {
+    u32 first;
+    u32 end;                                  // One past the last splat
+    u32 fields;                               // SPLAT_UPDATE_* seen in the range
+} DirtyRange;
+
+static struct {
+    DirtyRange ranges[SCENE_DIRTY_RANGES];
+    u32 range_count;
+
+    // Last application
+    u32 applied_splats;
+    u32 applied_ranges;
+    u32 refit_nodes;
+} g_dynamic = {0};
+
+// Gap between two ranges, 0 when they touch or overlap
+static u32 dirty_range_gap(const DirtyRange* a, u32 first, u32 end) {
+    if (end < a->first) return a->first - end;
+    if (first > a->end) return first - a->end;
+    return 0;
+}
+
+// Fold range r into the new range and drop it from the list
+static void dirty_range_absorb(u32 r, u32* first, u32* end, u32* fields) {
+    DirtyRange* range = &g_dynamic.ranges[r];
+    *first = MIN(*first, range->first);
+    *end = MAX(*end, range->end);
+    *fields |= range->fields;
+    g_dynamic.ranges[r] = g_dynamic.ranges[--g_dynamic.range_count];
+}
+
+static void dirty_range_add(u32 first, u32 end, u32 fields) {
+    // Merge every range the new one touches; a merge can reach further ones
+    for (u32 r = 0; r < g_dynamic.range_count;) {
+        if (dirty_range_gap(&g_dynamic.ranges[r], first, end) == 0) {
+            dirty_range_absorb(r, &first, &end, &fields);
+            r = 0;
+        } else {
+            r++;
+        }
+    }
+
+    // Full: merge with the nearest one
+    if (g_dynamic.range_count == SCENE_DIRTY_RANGES) {
+        u32 nearest = 0;
+        for (u32 r = 1; r < g_dynamic.range_count; r++) {
+            if (dirty_range_gap(&g_dynamic.ranges[r], first, end) <
+                dirty_range_gap(&g_dynamic.ranges[nearest], first, end)) {
+                nearest = r;
+            }
+        }
+        dirty_range_absorb(nearest, &first, &end, &fields);
+    }
+
+    DirtyRange* range = &g_dynamic.ranges[g_dynamic.range_count++];
+    range->first = first;
+    range->end = end;
+    range->fields = fields;
+}
+
+/*
+ * Queue splats first..first + count - 1 as changed in fields, after the
+ * caller wrote their records and stream entries.
+ */
+GaussianResult scene_splats_mark_dirty(const GaussianScene* scene, u32 first, u32 count, u32 fields) {
+    fields &= SPLAT_UPDATE_POSITION | SPLAT_UPDATE_COLOR | SPLAT_UPDATE_OPACITY;
+    if (!scene || count == 0 || fields == 0 || first >= scene->splat_count ||
+        count > scene->splat_count - first) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    if (scene_stream_active()) {
+        return GAUSSIAN_ERROR_BUSY;
+    }
+    if (scene_paging_active()) {
+        return GAUSSIAN_ERROR_UNSUPPORTED_FORMAT;
+    }
+
+    dirty_range_add(first, first + count, fields);
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Write the fields of updates[i] into splat first + i, for count splats,
+ * and queue the range. Takes effect from the next drawn frame.
+ */
+GaussianResult scene_splats_update(GaussianScene* scene, u32 first, u32 count, const SplatUpdate* updates,
+                                   u32 fields) {
+    if (!scene || !scene->splats_3d || !updates) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    // Validate before anything is written
+    GaussianResult result = scene_splats_mark_dirty(scene, first, count, fields);
+    if (result != GAUSSIAN_SUCCESS) {
+        return result;
+    }
+
+    GaussianSplatStreams* streams = (scene->streams.count >= first + count) ? &scene->streams : NULL;
+    for (u32 i = 0; i < count; i++) {
+        GaussianSplat3D* record = &scene->splats_3d[first + i];
+        const SplatUpdate* update = &updates[i];
+
+        if (fields & SPLAT_UPDATE_POSITION) {
+            memcpy(record->pos, update->pos, sizeof(record->pos));
+            if (streams) {
+                memcpy(streams->hot[first + i].pos, update->pos, sizeof(update->pos));
+            }
+        }
+        if (fields & SPLAT_UPDATE_COLOR) {
+            memcpy(record->color, update->color, sizeof(record->color));
+            if (streams && streams->warm) {
+                memcpy(streams->warm[first + i].color, update->color, sizeof(update->color));
+            }
+        }
+        if (fields & SPLAT_UPDATE_OPACITY) {
+            record->opacity = update->opacity;
+            if (streams && streams->warm) {
+                streams->warm[first + i].opacity = update->opacity;
+            }
+        }
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+/*
+ * Bring culling, shading and sorting state in line with the pending
+ * ranges. Call once a frame before culling; returns the splats applied,
+ * and anything but 0 means the frame has to be drawn.
+ */
+u32 scene_splats_apply_updates(GaussianScene* scene) {
+    g_dynamic.applied_splats = 0;
+    g_dynamic.applied_ranges = 0;
+    g_dynamic.refit_nodes = 0;
+    if (!scene || g_dynamic.range_count == 0) return 0;
+
+    const GaussianSplatStreams* streams = (scene->streams.count >= scene->splat_count) ? &scene->streams : NULL;
+    bool moved = false;
+    for (u32 r = 0; r < g_dynamic.range_count; r++) {
+        const DirtyRange* range = &g_dynamic.ranges[r];
+        u32 count = range->end - range->first;
+
+        if (range->fields & SPLAT_UPDATE_POSITION) {
+            g_dynamic.refit_nodes += spatial_grid_refit_splats(scene->splats_3d, streams, range->first, count);
+            moved = true;
+        }
+        if (range->fields & (SPLAT_UPDATE_COLOR | SPLAT_UPDATE_OPACITY)) {
+            vu_sh_cache_invalidate(range->first, count);
+        }
+        g_dynamic.applied_splats += count;
+    }
+    g_dynamic.applied_ranges = g_dynamic.range_count;
+    g_dynamic.range_count = 0;
+
+    // VIF1 reads the records straight from memory
+    FlushCache(0);
+    if (moved) {
+        sorting_splats_moved();
+    }
+    return g_dynamic.applied_splats;
+}
+
+// Drop pending ranges, for a scene about to go away
+void scene_splats_reset_updates(void) {
+    memset(&g_dynamic, 0, sizeof(g_dynamic));
+}
+
+void scene_splats_get_update_stats(u32* splats, u32* ranges, u32* nodes) {
+    if (splats) *splats = g_dynamic.applied_splats;
+    if (ranges) *ranges = g_dynamic.applied_ranges;
+    if (nodes) *nodes = g_dynamic.refit_nodes;
+}
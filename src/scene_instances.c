@@ -0,0 +1,317 @@
+/*
+ * SPLATSTORM X - Instanced Splat Assets
+ * Draws one splat cloud at many places without copying its records.
+ *
+ * An asset is a PLY file loaded once, in object space, with its own culling
+ * octree (a CullIndex, frustum_culling_complete.c). Instances reference an
+ * asset and carry an object-to-world transform, row vectors like the camera
+ * matrices, so translation is in m[12..14].
+ *
+ * Per frame, after the scene's own cull:
+ *   - instances whose world bounds miss the view frustum are skipped whole
+ *   - the rest cull the asset octree through transform * view_proj, so the
+ *     planes move into object space rather than the splats into world space
+ *   - VU1 projects each instance's visible splats with transform * view as
+ *     its view matrix (vu_upload_instance_constants), which carries both
+ *     positions and covariances
+ * The visible indices of all instances follow the scene's in one buffer,
+ * and their projections follow the scene's projected splats, so tiling,
+ * sorting and GS submission see one list.
+ *
+ * instance=<file>:<x>,<y>,<z>[,<yaw degrees>[,<scale>]] on the command line
+ * places one; instances of the same file share its asset.
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include <tamtypes.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+static struct {
+    SplatAsset assets[SCENE_MAX_ASSETS];
+    u32 asset_count;
+    SplatInstance instances[SCENE_MAX_INSTANCES];
+    u32 instance_count;
+    u32 revision;                             // Bumped when anything drawn changes
+
+    // Last frame
+    u32 visible_instances;
+    u32 visible_splats;
+} g_instances = {0};
+
+// World bounds of the asset box under the instance transform
+static void instance_update_bounds(SplatInstance* instance) {
+    const SplatAsset* asset = &g_instances.assets[instance->asset];
+    float m[16];
+    for (int i = 0; i < 16; i++) {
+        m[i] = fixed_to_float(instance->transform[i]);
+    }
+
+    float world_min[3] = { m[12], m[13], m[14] };
+    float world_max[3] = { m[12], m[13], m[14] };
+    for (int j = 0; j < 3; j++) {
+        // Each row scales one object axis: its extreme is at one box face
+        for (int i = 0; i < 3; i++) {
+            float a = fixed_to_float(asset->bounds_min[i]) * m[i*4 + j];
+            float b = fixed_to_float(asset->bounds_max[i]) * m[i*4 + j];
+            world_min[j] += MIN(a, b);
+            world_max[j] += MAX(a, b);
+        }
+        instance->bounds_min[j] = fixed_from_float(world_min[j]);
+        instance->bounds_max[j] = fixed_from_float(world_max[j]);
+    }
+}
+
+// Box against the camera's cached planes, inside positive
+static bool instance_bounds_visible(const SplatInstance* instance, const CameraFixed* camera) {
+    for (int p = 0; p < 6; p++) {
+        float distance = fixed_to_float(camera->frustum[p][3]);
+        for (int j = 0; j < 3; j++) {
+            float normal = fixed_to_float(camera->frustum[p][j]);
+            fixed16_t corner = (normal >= 0.0f) ? instance->bounds_max[j] : instance->bounds_min[j];
+            distance += normal * fixed_to_float(corner);
+        }
+        if (distance < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Load a PLY file as an asset, or find the one already loaded from it.
+ * Returns the asset index, -1 on failure.
+ */
+int scene_asset_load(const char* filename) {
+    if (!filename || !filename[0]) {
+        return -1;
+    }
+
+    for (u32 a = 0; a < g_instances.asset_count; a++) {
+        if (strcmp(g_instances.assets[a].name, filename) == 0) {
+            return (int)a;
+        }
+    }
+    if (g_instances.asset_count >= SCENE_MAX_ASSETS) {
+        debug_log_error("Instances: no room for asset %s", filename);
+        return -1;
+    }
+
+    SplatAsset* asset = &g_instances.assets[g_instances.asset_count];
+    memset(asset, 0, sizeof(SplatAsset));
+    GaussianResult result = load_ply_file(filename, &asset->splats, &asset->splat_count);
+    if (result != GAUSSIAN_SUCCESS || asset->splat_count == 0) {
+        debug_log_error("Instances: cannot load asset %s (%d)", filename, result);
+        if (asset->splats) {
+            memory_free(asset->splats);
+        }
+        asset->splats = NULL;
+        return -1;
+    }
+
+    asset->cull_index = cull_index_create(asset->splats, asset->splat_count);
+    if (!asset->cull_index) {
+        debug_log_error("Instances: cannot index asset %s", filename);
+        memory_free(asset->splats);
+        asset->splats = NULL;
+        return -1;
+    }
+    cull_index_bounds(asset->cull_index, asset->bounds_min, asset->bounds_max);
+    strncpy(asset->name, filename, sizeof(asset->name) - 1);
+
+    printf("SPLATSTORM X: Instanced asset %s, %u splats\n", filename, asset->splat_count);
+    return (int)g_instances.asset_count++;
+}
+
+// Place an asset; returns the instance index, -1 when the table is full
+int scene_instance_add(u32 asset, const fixed16_t transform[16]) {
+    if (asset >= g_instances.asset_count || !transform || g_instances.instance_count >= SCENE_MAX_INSTANCES) {
+        return -1;
+    }
+
+    SplatInstance* instance = &g_instances.instances[g_instances.instance_count];
+    memset(instance, 0, sizeof(SplatInstance));
+    instance->asset = asset;
+    instance->enabled = true;
+    memcpy(instance->transform, transform, sizeof(instance->transform));
+    instance_update_bounds(instance);
+    g_instances.revision++;
+    return (int)g_instances.instance_count++;
+}
+
+GaussianResult scene_instance_set_transform(u32 instance, const fixed16_t transform[16]) {
+    if (instance >= g_instances.instance_count || !transform) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(g_instances.instances[instance].transform, transform, sizeof(g_instances.instances[instance].transform));
+    instance_update_bounds(&g_instances.instances[instance]);
+    g_instances.revision++;
+    return GAUSSIAN_SUCCESS;
+}
+
+void scene_instance_set_enabled(u32 instance, bool enabled) {
+    if (instance >= g_instances.instance_count || g_instances.instances[instance].enabled == enabled) return;
+
+    g_instances.instances[instance].enabled = enabled;
+    g_instances.revision++;
+}
+
+// One option; false when it is not an instance option or it failed
+bool scene_instance_parse_option(const char* option) {
+    if (!option || strncmp(option, "instance=", 9) != 0) return false;
+
+    // The file name may hold a device colon, the placement never does
+    char filename[64];
+    const char* separator = strrchr(option + 9, ':');
+    if (!separator || (u32)(separator - (option + 9)) >= sizeof(filename)) return false;
+    memcpy(filename, option + 9, separator - (option + 9));
+    filename[separator - (option + 9)] = '\0';
+
+    float x = 0.0f, y = 0.0f, z = 0.0f, yaw = 0.0f, scale = 1.0f;
+    if (sscanf(separator + 1, "%f,%f,%f,%f,%f", &x, &y, &z, &yaw, &scale) < 3) return false;
+
+    int asset = scene_asset_load(filename);
+    if (asset < 0) return false;
+
+    // Yaw about +Y, then uniform scale; rows are the images of the object axes
+    float s = sinf(yaw * (float)M_PI / 180.0f) * scale;
+    float c = cosf(yaw * (float)M_PI / 180.0f) * scale;
+    fixed16_t transform[16] = {
+        fixed_from_float(c),  0,                        fixed_from_float(-s), 0,
+        0,                    fixed_from_float(scale),  0,                    0,
+        fixed_from_float(s),  0,                        fixed_from_float(c),  0,
+        fixed_from_float(x),  fixed_from_float(y),      fixed_from_float(z),  FIXED16_ONE,
+    };
+    return scene_instance_add((u32)asset, transform) >= 0;
+}
+
+u32 scene_instances_count(void) {
+    return g_instances.instance_count;
+}
+
+// Changes when an instance moves, appears or disappears
+u32 scene_instances_revision(void) {
+    return g_instances.revision;
+}
+
+/*
+ * Cull every enabled instance into visible_indices, at most capacity in
+ * all. Indices select records of the instance's asset; each instance's run
+ * is recorded for scene_instances_project(). Returns the indices written.
+ */
+u32 scene_instances_cull(const CameraFixed* camera, u32* visible_indices, u32 capacity) {
+    g_instances.visible_instances = 0;
+    g_instances.visible_splats = 0;
+    if (!camera || !visible_indices) return 0;
+
+    u32 used = 0;
+    for (u32 i = 0; i < g_instances.instance_count; i++) {
+        SplatInstance* instance = &g_instances.instances[i];
+        instance->visible_first = used;
+        instance->visible_count = 0;
+        if (!instance->enabled || used >= capacity || !instance_bounds_visible(instance, camera)) {
+            continue;
+        }
+
+        const SplatAsset* asset = &g_instances.assets[instance->asset];
+        fixed16_t view_proj[16];
+        matrix_multiply_4x4_fixed(instance->transform, camera->view_proj, view_proj);
+
+        u32 count = 0;
+        if (cull_index_splat_indices(asset->cull_index, asset->splats, asset->splat_count, view_proj,
+                                     &visible_indices[used], capacity - used, &count) != GAUSSIAN_SUCCESS) {
+            continue;
+        }
+
+        instance->visible_count = count;
+        used += count;
+        if (count > 0) {
+            g_instances.visible_instances++;
+        }
+    }
+
+    g_instances.visible_splats = used;
+    return used;
+}
+
+/*
+ * Project the splats scene_instances_cull() left in visible_indices into
+ * projected_splats, instance by instance. Each uploads its own constants;
+ * the next vu_upload_constants() brings back the camera's.
+ */
+GaussianResult scene_instances_project(CameraFixed* camera, const u32* visible_indices,
+                                       GaussianSplatRender* projected_splats, u32* projected_count) {
+    if (!camera || !visible_indices || !projected_splats || !projected_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    *projected_count = 0;
+    for (u32 i = 0; i < g_instances.instance_count; i++) {
+        const SplatInstance* instance = &g_instances.instances[i];
+        if (instance->visible_count == 0) continue;
+
+        int result = vu_upload_instance_constants(camera, instance->transform);
+        if (result != GAUSSIAN_SUCCESS) {
+            return (GaussianResult)result;
+        }
+
+        u32 count = 0;
+        result = vu_process_indexed(g_instances.assets[instance->asset].splats,
+                                    &visible_indices[instance->visible_first], instance->visible_count,
+                                    &projected_splats[*projected_count], &count);
+        if (result != GAUSSIAN_SUCCESS) {
+            return (GaussianResult)result;
+        }
+        *projected_count += count;
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+// The same on the direct VU1 path: sprites go straight to the GS
+GaussianResult scene_instances_render_direct(CameraFixed* camera, const u32* visible_indices, u32* kicked_count) {
+    if (!camera || !visible_indices || !kicked_count) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    *kicked_count = 0;
+    for (u32 i = 0; i < g_instances.instance_count; i++) {
+        const SplatInstance* instance = &g_instances.instances[i];
+        if (instance->visible_count == 0) continue;
+
+        int result = vu_upload_instance_constants(camera, instance->transform);
+        if (result != GAUSSIAN_SUCCESS) {
+            return (GaussianResult)result;
+        }
+
+        u32 count = 0;
+        result = vu_render_indexed_direct(g_instances.assets[instance->asset].splats,
+                                          &visible_indices[instance->visible_first], instance->visible_count,
+                                          &count);
+        if (result != GAUSSIAN_SUCCESS) {
+            return (GaussianResult)result;
+        }
+        *kicked_count += count;
+    }
+    return GAUSSIAN_SUCCESS;
+}
+
+void scene_instances_get_stats(u32* instances, u32* visible_instances, u32* visible_splats) {
+    if (instances) *instances = g_instances.instance_count;
+    if (visible_instances) *visible_instances = g_instances.visible_instances;
+    if (visible_splats) *visible_splats = g_instances.visible_splats;
+}
+
+// Drop every instance and free the assets
+void scene_instances_clear(void) {
+    for (u32 a = 0; a < g_instances.asset_count; a++) {
+        cull_index_destroy(g_instances.assets[a].cull_index);
+        memory_free(g_instances.assets[a].splats);
+    }
+    u32 revision = g_instances.revision + 1;
+    memset(&g_instances, 0, sizeof(g_instances));
+    g_instances.revision = revision;
+}
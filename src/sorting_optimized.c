@@ -1,6 +1,12 @@
 /*
  * SPLATSTORM X - Optimized Depth Sorting Implementation
- * Bucket sort with temporal coherence for efficient splat sorting
+ * Incremental depth sorting with temporal coherence
+ *
+ * Features:
+ * - Sorts 32-bit key/index pairs, the PackedSplat array is never moved
+ * - Incremental repair of the previous frame's order for small camera moves
+ * - Adaptive insertion/merge pass, close to linear on nearly sorted data
+ * - LSD radix sort fallback for first frames and large camera jumps
  */
 
 #include <tamtypes.h>
@@ -10,8 +16,22 @@
 #include "gaussian_types.h"
 #include "splatstorm_debug.h"
 #include "memory_optimized.h"
+#include "splatstorm_optimized.h"
 
-#define CLAMP(x, min, max) ((x) < (min) ? (min) : ((x) > (max) ? (max) : (x)))
+// Incremental sort tuning
+#define SORT_INSERTION_RUN          32      // Insertion-sorted chunk size before merging
+#define SORT_MOVE_BUDGET            4       // Element moves per splat before falling back to radix
+#define SORT_KEY_DROP_BITS          8       // Mantissa bits ignored: near-equal depths keep last order
+#define SORT_RADIX_BITS             8
+#define SORT_RADIX_BUCKETS          (1 << SORT_RADIX_BITS)
+#define SORT_RADIX_PASSES           4
+
+typedef enum {
+    SORT_MODE_NONE = 0,
+    SORT_MODE_SKIPPED,          // Camera still: previous order reused as is
+    SORT_MODE_INCREMENTAL,      // Previous order repaired
+    SORT_MODE_FULL              // Radix sort from scratch
+} SortMode;
 
 // Forward declarations
 static void radix_sort_splats(splat_t* splats, int* sorted_indices, int count);
@@ -19,11 +39,18 @@ static void quick_sort_splats_by_depth(splat_t* splats, int* sorted_indices, int
 
 typedef struct {
     PackedSplat* splats;
-    float* depths;
-    int* bucket_indices;
+    u32* order;                 // Splat indices, back-to-front
+    u32* keys;                  // Depth key of order[i]
+    u32* scratch_order;         // Merge/radix ping-pong buffers
+    u32* scratch_keys;
     int count;
+    int order_valid;            // order holds last frame's permutation
+    float depth_axis[4];        // View-space depth = dot(axis.xyz, pos) + axis.w
     u64 last_sort_frame;
     int camera_moved;
+    SortMode last_mode;
+    u32 last_descents;
+    u64 last_sort_cycles;
 } SortingContext;
 
 static SortingContext sorting_context = {0};
@@ -35,20 +62,29 @@ static u64 current_frame = 0;
 int sorting_system_init(PackedSplat* splats, int count) {
     sorting_context.splats = splats;
     sorting_context.count = count;
+    sorting_context.order_valid = 0;
     sorting_context.last_sort_frame = 0;
     sorting_context.camera_moved = 1;  // Force initial sort
-    
-    // Allocate depth array
-    sorting_context.depths = (float*)allocate_vu_buffer(count * sizeof(float));
-    if (!sorting_context.depths) {
-        debug_log_error("Failed to allocate depth array");
+    sorting_context.last_mode = SORT_MODE_NONE;
+    
+    // Camera looking down -Z until a view is set
+    sorting_context.depth_axis[0] = 0.0f;
+    sorting_context.depth_axis[1] = 0.0f;
+    sorting_context.depth_axis[2] = -1.0f;
+    sorting_context.depth_axis[3] = 0.0f;
+    
+    // Allocate key/index arrays
+    sorting_context.order = (u32*)allocate_vu_buffer(count * sizeof(u32));
+    sorting_context.keys = (u32*)allocate_vu_buffer(count * sizeof(u32));
+    if (!sorting_context.order || !sorting_context.keys) {
+        debug_log_error("Failed to allocate sort key/index arrays");
         return -1;
     }
     
-    // Allocate bucket indices
-    sorting_context.bucket_indices = (int*)allocate_vu_buffer(count * sizeof(int));
-    if (!sorting_context.bucket_indices) {
-        debug_log_error("Failed to allocate bucket indices");
+    sorting_context.scratch_order = (u32*)allocate_vu_buffer(count * sizeof(u32));
+    sorting_context.scratch_keys = (u32*)allocate_vu_buffer(count * sizeof(u32));
+    if (!sorting_context.scratch_order || !sorting_context.scratch_keys) {
+        debug_log_error("Failed to allocate sort scratch arrays");
         return -2;
     }
     
@@ -56,76 +92,240 @@ int sorting_system_init(PackedSplat* splats, int count) {
     return 0;
 }
 
-/*
- * Bucket sort with temporal coherence optimization
- */
-void bucket_sort_splats_optimized(void) {
-    static int buckets[NUM_DEPTH_BUCKETS + 1];
+// Map a depth to a key that sorts far-to-near as unsigned integers
+static inline u32 depth_to_key(float depth) {
+    union { float f; u32 u; } bits;
+    bits.f = depth;
+    
+    // Order-preserving float to unsigned, then inverted for back-to-front
+    u32 ordered = (bits.u & 0x80000000) ? ~bits.u : (bits.u | 0x80000000);
+    return ~ordered & ~((1u << SORT_KEY_DROP_BITS) - 1);
+}
+
+// Recompute keys for the current order, returns the number of descents
+static u32 compute_sort_keys(void) {
+    const PackedSplat* splats = sorting_context.splats;
+    const float* axis = sorting_context.depth_axis;
+    u32* order = sorting_context.order;
+    u32* keys = sorting_context.keys;
+    u32 count = (u32)sorting_context.count;
+    u32 descents = 0;
+    u32 prev = 0;
+    
+    for (u32 i = 0; i < count; i++) {
+        const float* pos = splats[order[i]].position;
+        float depth = axis[0] * pos[0] + axis[1] * pos[1] + axis[2] * pos[2] + axis[3];
+        u32 key = depth_to_key(depth);
+        keys[i] = key;
+        
+        if (key < prev) descents++;
+        prev = key;
+    }
     
-    current_frame++;
+    return descents;
+}
+
+// Stable insertion sort of keys/order in [start, end), returns elements moved
+static u32 insertion_sort_pairs(u32* keys, u32* order, u32 start, u32 end) {
+    u32 moves = 0;
     
-    // Skip sorting if camera hasn't moved significantly
-    if (sorting_context.last_sort_frame == current_frame - 1 && !sorting_context.camera_moved) {
-        debug_log_info("Skipping sort - temporal coherence");
-        return;
+    for (u32 i = start + 1; i < end; i++) {
+        u32 key = keys[i];
+        if (keys[i - 1] <= key) continue;  // Already in place: the common case
+        
+        u32 value = order[i];
+        u32 j = i;
+        while (j > start && keys[j - 1] > key) {
+            keys[j] = keys[j - 1];
+            order[j] = order[j - 1];
+            j--;
+        }
+        moves += i - j;
+        keys[j] = key;
+        order[j] = value;
     }
     
-    debug_log_info("Performing bucket sort for %d splats", sorting_context.count);
+    return moves;
+}
+
+// Stable merge of sorted [start, mid) and [mid, end), returns elements moved
+// Only the overlapping middle is touched: elements of the left run that are
+// already <= the right run's head and of the right run that are already
+// >= the left run's tail stay where they are.
+static u32 merge_pairs(u32* keys, u32* order, u32 start, u32 mid, u32 end) {
+    if (keys[mid - 1] <= keys[mid]) return 0;
+    
+    // First left element greater than the right head
+    u32 lo = start, hi = mid;
+    u32 right_head = keys[mid];
+    while (lo < hi) {
+        u32 m = lo + (hi - lo) / 2;
+        if (keys[m] <= right_head) lo = m + 1; else hi = m;
+    }
+    u32 left = lo;
+    
+    // First right element not less than the left tail
+    lo = mid; hi = end;
+    u32 left_tail = keys[mid - 1];
+    while (lo < hi) {
+        u32 m = lo + (hi - lo) / 2;
+        if (keys[m] < left_tail) lo = m + 1; else hi = m;
+    }
+    u32 right_end = lo;
+    
+    // Move the left overlap out, then merge forward into place
+    u32 left_count = mid - left;
+    u32* tmp_keys = sorting_context.scratch_keys;
+    u32* tmp_order = sorting_context.scratch_order;
+    memcpy(tmp_keys, &keys[left], left_count * sizeof(u32));
+    memcpy(tmp_order, &order[left], left_count * sizeof(u32));
+    
+    u32 a = 0, b = mid, dst = left;
+    while (a < left_count && b < right_end) {
+        if (keys[b] < tmp_keys[a]) {
+            keys[dst] = keys[b];
+            order[dst++] = order[b++];
+        } else {
+            keys[dst] = tmp_keys[a];
+            order[dst++] = tmp_order[a++];
+        }
+    }
+    while (a < left_count) {
+        keys[dst] = tmp_keys[a];
+        order[dst++] = tmp_order[a++];
+    }
     
-    // Clear bucket counters
-    memset(buckets, 0, sizeof(buckets));
+    return right_end - left;
+}
+
+// Repair a nearly sorted order: insertion-sort short chunks, then merge them
+// Gives up once the work exceeds the move budget; keys/order stay paired, so
+// the caller can finish with a full sort from wherever this stopped.
+static int incremental_sort_pairs(void) {
+    u32* keys = sorting_context.keys;
+    u32* order = sorting_context.order;
+    u32 count = (u32)sorting_context.count;
+    u32 budget = count * SORT_MOVE_BUDGET;
+    u32 moves = 0;
+    
+    for (u32 start = 0; start < count; start += SORT_INSERTION_RUN) {
+        u32 end = start + SORT_INSERTION_RUN;
+        if (end > count) end = count;
+        moves += insertion_sort_pairs(keys, order, start, end);
+        if (moves > budget) return 0;
+    }
     
-    // Extract depths and count splats per bucket
-    float min_depth = 999999.0f, max_depth = -999999.0f;
-    for (int i = 0; i < sorting_context.count; i++) {
-        float depth = sorting_context.splats[i].pos_color[2];  // Z coordinate
-        sorting_context.depths[i] = depth;
-        
-        if (depth < min_depth) min_depth = depth;
-        if (depth > max_depth) max_depth = depth;
+    for (u32 width = SORT_INSERTION_RUN; width < count; width *= 2) {
+        for (u32 start = 0; start + width < count; start += 2 * width) {
+            u32 end = start + 2 * width;
+            if (end > count) end = count;
+            moves += merge_pairs(keys, order, start, start + width, end);
+            if (moves > budget) return 0;
+        }
     }
     
-    // Normalize depths to bucket range
-    float depth_range = max_depth - min_depth;
-    if (depth_range < 0.001f) depth_range = 0.001f;  // Avoid division by zero
-    
-    // Count splats per bucket (back-to-front for alpha blending)
-    for (int i = 0; i < sorting_context.count; i++) {
-        float normalized_depth = (sorting_context.depths[i] - min_depth) / depth_range;
-        int bucket = (int)(normalized_depth * NUM_DEPTH_BUCKETS);
-        bucket = CLAMP(bucket, 0, NUM_DEPTH_BUCKETS - 1);
-        sorting_context.bucket_indices[i] = bucket;
-        buckets[bucket + 1]++;
+    return 1;
+}
+
+// LSD radix sort of keys/order, 8 bits per pass, uniform digits skipped
+static void radix_sort_pairs(void) {
+    static u32 histograms[SORT_RADIX_PASSES * SORT_RADIX_BUCKETS];
+    u32 count = (u32)sorting_context.count;
+    memset(histograms, 0, sizeof(histograms));
+    
+    u32* src_keys = sorting_context.keys;
+    u32* src_order = sorting_context.order;
+    u32* dst_keys = sorting_context.scratch_keys;
+    u32* dst_order = sorting_context.scratch_order;
+    
+    for (u32 i = 0; i < count; i++) {
+        u32 key = src_keys[i];
+        histograms[0 * SORT_RADIX_BUCKETS + (key & 0xFF)]++;
+        histograms[1 * SORT_RADIX_BUCKETS + ((key >> 8) & 0xFF)]++;
+        histograms[2 * SORT_RADIX_BUCKETS + ((key >> 16) & 0xFF)]++;
+        histograms[3 * SORT_RADIX_BUCKETS + (key >> 24)]++;
     }
     
-    // Prefix sum for bucket boundaries
-    for (int i = 1; i <= NUM_DEPTH_BUCKETS; i++) {
-        buckets[i] += buckets[i - 1];
+    for (u32 pass = 0; pass < SORT_RADIX_PASSES; pass++) {
+        u32* histogram = &histograms[pass * SORT_RADIX_BUCKETS];
+        u32 shift = pass * SORT_RADIX_BITS;
+        
+        if (histogram[(src_keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        
+        u32 offset = 0;
+        for (u32 b = 0; b < SORT_RADIX_BUCKETS; b++) {
+            u32 bucket_count = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_count;
+        }
+        
+        for (u32 i = 0; i < count; i++) {
+            u32 key = src_keys[i];
+            u32 dst = histogram[(key >> shift) & 0xFF]++;
+            dst_keys[dst] = key;
+            dst_order[dst] = src_order[i];
+        }
+        
+        u32* tmp = src_keys; src_keys = dst_keys; dst_keys = tmp;
+        tmp = src_order; src_order = dst_order; dst_order = tmp;
     }
     
-    // Allocate temporary buffer (use scratchpad if possible)
-    PackedSplat* temp = (PackedSplat*)allocate_vu_buffer(sorting_context.count * sizeof(PackedSplat));
-    if (!temp) {
-        debug_log_error("Failed to allocate temporary sort buffer");
+    // Keep the canonical pointers on the sorted data
+    sorting_context.keys = src_keys;
+    sorting_context.order = src_order;
+    sorting_context.scratch_keys = dst_keys;
+    sorting_context.scratch_order = dst_order;
+}
+
+/*
+ * Depth sort with temporal coherence optimization
+ * Camera still: keep last frame's order. Small move: recompute keys in last
+ * frame's order and repair it. First frame or large jump: full radix sort.
+ */
+void bucket_sort_splats_optimized(void) {
+    current_frame++;
+    
+    if (sorting_context.count <= 0 || !sorting_context.order) {
+        return;
+    }
+    
+    // Skip sorting if camera hasn't moved significantly
+    if (sorting_context.order_valid && !sorting_context.camera_moved) {
+        sorting_context.last_mode = SORT_MODE_SKIPPED;
+        sorting_context.last_sort_cycles = 0;
+        debug_log_info("Skipping sort - temporal coherence");
         return;
     }
     
-    // Distribute splats into buckets (back-to-front order for alpha blending)
-    for (int i = sorting_context.count - 1; i >= 0; i--) {
-        int bucket = sorting_context.bucket_indices[i];
-        int index = buckets[bucket + 1] - 1;
-        temp[index] = sorting_context.splats[i];
-        buckets[bucket + 1]--;
+    u64 sort_start = get_cpu_cycles();
+    
+    if (!sorting_context.order_valid) {
+        for (int i = 0; i < sorting_context.count; i++) {
+            sorting_context.order[i] = (u32)i;
+        }
     }
     
-    // Copy back to original array
-    memcpy(sorting_context.splats, temp, sorting_context.count * sizeof(PackedSplat));
+    u32 descents = compute_sort_keys();
+    sorting_context.last_descents = descents;
     
+    // Order from last frame: repair it, unless the camera moved too far
+    if (sorting_context.order_valid && (descents == 0 || incremental_sort_pairs())) {
+        sorting_context.last_mode = SORT_MODE_INCREMENTAL;
+    } else {
+        radix_sort_pairs();
+        sorting_context.last_mode = SORT_MODE_FULL;
+    }
+    
+    sorting_context.order_valid = 1;
     sorting_context.last_sort_frame = current_frame;
     sorting_context.camera_moved = 0;  // Reset camera moved flag
+    sorting_context.last_sort_cycles = get_cpu_cycles() - sort_start;
     
-    debug_log_info("Bucket sort completed: %d buckets, range %.3f to %.3f", 
-                   NUM_DEPTH_BUCKETS, min_depth, max_depth);
+    debug_log_info("Depth sort completed: %s, %u descents, %d splats",
+                   sorting_context.last_mode == SORT_MODE_FULL ? "full" : "incremental",
+                   descents, sorting_context.count);
 }
 
 /*
@@ -136,6 +336,31 @@ void sorting_camera_moved(void) {
     debug_log_info("Camera movement detected - will resort next frame");
 }
 
+/*
+ * Signal that splat positions changed: keys are recomputed and the last
+ * order is repaired next frame, so the cost follows how far splats moved
+ */
+void sorting_splats_moved(void) {
+    sorting_context.camera_moved = 1;
+}
+
+/*
+ * Set the view-space depth axis (third row of the view matrix, negated for
+ * a camera looking down -Z) and schedule a resort
+ */
+void sorting_set_depth_axis(const float axis[4]) {
+    if (!axis) return;
+    memcpy(sorting_context.depth_axis, axis, sizeof(sorting_context.depth_axis));
+    sorting_context.camera_moved = 1;
+}
+
+/*
+ * Back-to-front splat indices from the last sort, NULL before the first one
+ */
+const u32* sorting_get_order(void) {
+    return sorting_context.order_valid ? sorting_context.order : NULL;
+}
+
 // camera_moved_significantly function is implemented in tile_rasterizer_complete.c
 
 /*
@@ -143,8 +368,8 @@ void sorting_camera_moved(void) {
  */
 void get_sorting_stats(int* last_sort_frame, int* buckets_used, float* sort_time_ms) {
     if (last_sort_frame) *last_sort_frame = sorting_context.last_sort_frame;
-    if (buckets_used) *buckets_used = NUM_DEPTH_BUCKETS;
-    if (sort_time_ms) *sort_time_ms = 2.5f;  // Estimated sort time
+    if (buckets_used) *buckets_used = (sorting_context.last_mode == SORT_MODE_FULL) ? SORT_RADIX_BUCKETS : 0;
+    if (sort_time_ms) *sort_time_ms = (float)sorting_context.last_sort_cycles * 1000.0f / 294912000.0f;
 }
 
 /*
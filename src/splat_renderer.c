@@ -137,23 +137,23 @@ static int initialize_renderer(void) {
     debug_log_info("Initializing splat renderer...");
     
     // Allocate memory for rendering state
-    g_render_state.visible_splats = (splat_t*)splatstorm_malloc(
-        MAX_SPLATS_PER_BATCH * sizeof(splat_t));
+    g_render_state.visible_splats = (splat_t*)memory_alloc(MEMORY_BUDGET_FRAME,
+        MAX_SPLATS_PER_BATCH * sizeof(splat_t), 16);
     if (!g_render_state.visible_splats) {
         debug_log_error("Failed to allocate visible splats buffer");
         return -1;
     }
     
-    g_render_state.distances = (float*)splatstorm_malloc(
-        MAX_SPLATS_PER_BATCH * sizeof(float));
+    g_render_state.distances = (float*)memory_alloc(MEMORY_BUDGET_FRAME,
+        MAX_SPLATS_PER_BATCH * sizeof(float), 16);
     if (!g_render_state.distances) {
         debug_log_error("Failed to allocate distances buffer");
         cleanup_renderer();
         return -1;
     }
     
-    g_render_state.sort_indices = (u16*)splatstorm_malloc(
-        MAX_SPLATS_PER_BATCH * sizeof(u16));
+    g_render_state.sort_indices = (u16*)memory_alloc(MEMORY_BUDGET_FRAME,
+        MAX_SPLATS_PER_BATCH * sizeof(u16), 16);
     if (!g_render_state.sort_indices) {
         debug_log_error("Failed to allocate sort indices buffer");
         cleanup_renderer();
@@ -184,17 +184,17 @@ static int initialize_renderer(void) {
  */
 static void cleanup_renderer(void) {
     if (g_render_state.visible_splats) {
-        splatstorm_free(g_render_state.visible_splats);
+        memory_free(g_render_state.visible_splats);
         g_render_state.visible_splats = NULL;
     }
     
     if (g_render_state.distances) {
-        splatstorm_free(g_render_state.distances);
+        memory_free(g_render_state.distances);
         g_render_state.distances = NULL;
     }
     
     if (g_render_state.sort_indices) {
-        splatstorm_free(g_render_state.sort_indices);
+        memory_free(g_render_state.sort_indices);
         g_render_state.sort_indices = NULL;
     }
     
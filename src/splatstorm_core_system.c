@@ -869,6 +869,7 @@ void splatstorm_shutdown_all_systems(void) {
         g_memory.vram_used = 0;
         g_memory.total_allocations = 0;
         g_memory.total_frees = 0;
+        memory_system_cleanup();
         
         g_system_state.memory_initialized = false;
     }
@@ -976,142 +977,21 @@ int splatstorm_check_memory_integrity(void) {
 
 // Memory usage query - COMPLETE IMPLEMENTATION
 u32 splatstorm_get_memory_usage(void) {
-    return g_memory.main_heap_used;
+    MemoryStats stats;
+    memory_get_statistics(&stats);
+    return stats.pool_used;
 }
 
 // VRAM usage query - COMPLETE IMPLEMENTATION
 u32 splatstorm_get_vram_usage(void) {
+    GSVramStats stats;
+    gs_vram_get_stats(&stats);
+    g_memory.vram_used = stats.used_blocks * GS_VRAM_BLOCK_BYTES;
     return g_memory.vram_used;
 }
 
-// ENHANCED Aligned allocation - ULTRA COMPLETE IMPLEMENTATION WITH ADVANCED FEATURES
-void* splatstorm_alloc_aligned(u32 size, u32 alignment) {
-    if (size == 0 || alignment == 0) {
-        debug_log_error("Invalid allocation parameters: size=%u, alignment=%u", size, alignment);
-        return NULL;
-    }
-    
-    // Enhanced alignment validation and correction
-    if ((alignment & (alignment - 1)) != 0) {
-        // Find next power of 2
-        u32 corrected_alignment = 16;
-        while (corrected_alignment < alignment) {
-            corrected_alignment <<= 1;
-        }
-        debug_log_warning("Non-power-of-2 alignment %u corrected to %u", alignment, corrected_alignment);
-        alignment = corrected_alignment;
-    }
-    
-    // Advanced memory allocation with fallback strategies
-    void* ptr = memalign(alignment, size);
-    if (!ptr && alignment > 16) {
-        // Fallback to smaller alignment if allocation fails
-        debug_log_warning("High alignment allocation failed, trying 16-byte alignment");
-        ptr = memalign(16, size);
-    }
-    if (!ptr) {
-        // Final fallback to standard malloc
-        debug_log_warning("Aligned allocation failed, using standard malloc");
-        ptr = malloc(size);
-    }
-    
-    if (ptr) {
-        // Enhanced initialization with pattern for debugging
-        memset(ptr, 0xCD, size); // Debug pattern
-        memset(ptr, 0, size);    // Then zero it
-        
-        // Advanced memory tracking
-        g_memory.main_heap_used += size;
-        g_memory.total_allocations++;
-        g_memory.peak_allocation = (size > g_memory.peak_allocation) ? size : g_memory.peak_allocation;
-        
-        // Memory integrity checking
-        if (g_memory.total_allocations % 100 == 0) {
-            splatstorm_check_memory_integrity();
-        }
-        
-        debug_log_verbose("Allocated %u bytes at 0x%08X with %u-byte alignment", 
-                         size, (u32)ptr, alignment);
-    } else {
-        debug_log_error("Memory allocation failed: size=%u, alignment=%u", size, alignment);
-        g_memory.failed_allocations++;
-    }
-    
-    return ptr;
-}
-
-// ENHANCED Aligned free - ULTRA COMPLETE IMPLEMENTATION WITH ADVANCED VALIDATION
-void splatstorm_free_aligned(void* ptr) {
-    if (!ptr) {
-        debug_log_warning("Attempted to free NULL pointer");
-        return;
-    }
-    
-    // Advanced pointer validation
-    if ((u32)ptr < 0x00100000 || (u32)ptr > 0x02000000) {
-        debug_log_error("Invalid pointer address for free: 0x%08X", (u32)ptr);
-        return;
-    }
-    
-    // Enhanced memory pattern checking before free
-    u32* check_ptr = (u32*)ptr;
-    if (*check_ptr == 0xDEADBEEF) {
-        debug_log_error("Double-free detected at 0x%08X", (u32)ptr);
-        return;
-    }
-    
-    // Mark memory as freed with debug pattern
-    *check_ptr = 0xDEADBEEF;
-    
-    // Advanced memory tracking
-    g_memory.total_frees++;
-    g_memory.active_allocations = g_memory.total_allocations - g_memory.total_frees;
-    
-    // Perform actual free
-    free(ptr);
-    
-    // Periodic memory integrity check
-    if (g_memory.total_frees % 50 == 0) {
-        splatstorm_check_memory_integrity();
-    }
-    
-    debug_log_verbose("Freed memory at 0x%08X (Active allocations: %u)", 
-                     (u32)ptr, g_memory.active_allocations);
-}
-
-// ENHANCED Standard malloc wrapper - ULTRA COMPLETE IMPLEMENTATION WITH ADVANCED FEATURES
-void* splatstorm_malloc(u32 size) {
-    if (size == 0) {
-        debug_log_warning("Zero-size malloc requested, returning NULL");
-        return NULL;
-    }
-    
-    // Enhanced size validation and adjustment
-    if (size > 16 * 1024 * 1024) { // 16MB limit
-        debug_log_error("Excessive malloc size requested: %u bytes", size);
-        return NULL;
-    }
-    
-    // Align size to 16-byte boundary for optimal performance
-    u32 aligned_size = (size + 15) & ~15;
-    if (aligned_size != size) {
-        debug_log_verbose("Size %u aligned to %u for optimal performance", size, aligned_size);
-    }
-    
-    debug_log_verbose("Standard malloc: %u bytes (aligned to %u)", size, aligned_size);
-    return splatstorm_alloc_aligned(aligned_size, 16);
-}
-
-// ENHANCED Standard free wrapper - ULTRA COMPLETE IMPLEMENTATION WITH ADVANCED VALIDATION
-void splatstorm_free(void* ptr) {
-    if (!ptr) {
-        debug_log_verbose("Standard free called with NULL pointer (safe operation)");
-        return;
-    }
-    
-    debug_log_verbose("Standard free: 0x%08X", (u32)ptr);
-    splatstorm_free_aligned(ptr);
-}
+// splatstorm_alloc_aligned/free_aligned and splatstorm_malloc/free live in
+// memory_system_complete.c and allocate from the per-subsystem budgets
 
 /*
  * GRAPHICS SYSTEM FUNCTIONS - COMPLETE IMPLEMENTATIONS
@@ -1295,7 +1175,7 @@ void core_dma_build_display_list(splat_t* splats, u32 count) {
     // Calculate required buffer size
     u32 buffer_size = count * sizeof(splat_t) + 1024; // Extra space for headers
     
-    void* buffer = splatstorm_alloc_aligned(buffer_size, 128);
+    void* buffer = memory_alloc(MEMORY_BUDGET_DMA, buffer_size, 128);
     if (!buffer) {
         splatstorm_set_error(SPLATSTORM_ERROR_MEMORY, "Failed to allocate DMA display list buffer");
         return;
@@ -1313,7 +1193,7 @@ void core_dma_build_display_list(splat_t* splats, u32 count) {
     // Send via DMA
     dma_send_chain(buffer, buffer_size);
     
-    splatstorm_free_aligned(buffer);
+    memory_free(buffer);
 }
 
 // DMA display list builder wrapper - COMPLETE IMPLEMENTATION
@@ -1389,6 +1269,7 @@ void vu0_upload_microcode(u32* start, u32* end) {
     
     // Reset VU0 first
     vu0_reset();
+    vu_microcode_invalidate(VU_UNIT_VU0);
     
     // Upload microcode via DMA
     dma_channel_send_normal(DMA_CHANNEL_VIF1, start, qwords, 0, 0);
@@ -1407,8 +1288,9 @@ void vu1_upload_microcode(u32* start, u32* end) {
     u32 size = (u32)((u8*)end - (u8*)start);
     u32 qwords = (size + 15) / 16;
     
-    // Reset VU1 first
+    // Reset VU1 first; the microcode manager no longer knows what it holds
     vu1_reset();
+    vu_microcode_invalidate(VU_UNIT_VU1);
     
     // Upload microcode via DMA
     dma_channel_send_normal(DMA_CHANNEL_VIF1, start, qwords, 0, 0);
@@ -1643,15 +1525,16 @@ int mc_init_robust(void) {
 
 // Internal memory system initialization
 static GaussianResult initialize_memory_system_internal(void) {
-    // Initialize memory pools
-    g_memory.main_heap_size = 24 * 1024 * 1024; // 24MB main heap
-    g_memory.main_heap_base = malloc(g_memory.main_heap_size);
-    if (!g_memory.main_heap_base) {
+    // Budget pools replace the old private heap
+    if (memory_system_init() != GAUSSIAN_SUCCESS) {
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
     }
+    g_memory.main_heap_size = MEMORY_BUDGET_SCENE_SIZE + MEMORY_BUDGET_FRAME_SIZE + MEMORY_BUDGET_DMA_SIZE +
+                              MEMORY_BUDGET_ASSET_SIZE + MEMORY_BUDGET_DEBUG_SIZE;
+    g_memory.main_heap_base = NULL;
     
     g_memory.vram_size = 4 * 1024 * 1024; // 4MB VRAM
-    g_memory.vram_base = (void*)VRAM_FRAMEBUFFER;
+    g_memory.vram_base = NULL;            // GS memory is placed by gs_vram_alloc
     
     g_memory.main_heap_used = 0;
     g_memory.vram_used = 0;
@@ -339,17 +339,28 @@ void debug_draw_graph(const char* name, float* values, u32 count) {
         
         // Plot values at this height level
         float threshold = min_val + (max_val - min_val) * (9 - y) / 9.0f;
-        for (u32 i = 0; i < count && i < 50; i++) {
+        u32 columns = MIN(count, PROFILE_ZONE_GRAPH_FRAMES);
+        for (u32 i = 0; i < columns; i++) {
             if (values[i] >= threshold) {
                 graph_line[i + 2] = '*';
             }
         }
-        graph_line[count + 2] = '\0';
+        graph_line[columns + 2] = '\0';
         
         debug_draw_text(graph_x, graph_y + y * 10, graph_line);
     }
 }
 
+// Graph of a profiler zone over the newest recorded frames
+void debug_draw_zone_graph(ProfileZone zone) {
+    float values[PROFILE_ZONE_GRAPH_FRAMES];
+    u32 count = profile_zone_history(zone, values, PROFILE_ZONE_GRAPH_FRAMES);
+    
+    char name[32];
+    snprintf(name, sizeof(name), "%s ms", profile_zone_name(zone));
+    debug_draw_graph(name, values, count);
+}
+
 void debug_draw_text(u32 x, u32 y, const char* text) {
     if (!g_debug_initialized || !text) return;
     
@@ -748,29 +759,13 @@ void debug_save_frame_capture(const char* filename) {
     debug_log_info("Frame capture metadata saved to '%s'", filename);
     
     // COMPLETE IMPLEMENTATION - Full framebuffer capture functionality
-    // Read GS framebuffer memory directly
-    u32* framebuffer_data = (u32*)malloc(SCREEN_WIDTH * SCREEN_HEIGHT * 4);
-    if (framebuffer_data) {
+    // Read GS framebuffer memory directly, one row at a time so the
+    // capture fits the debug budget
+    u32* row_data = (u32*)memory_alloc(MEMORY_BUDGET_DEBUG, SCREEN_WIDTH * 4, 16);
+    if (row_data) {
         // Read framebuffer from GS memory (0x00100000 is typical framebuffer base)
         u32* gs_framebuffer = (u32*)0x00100000;
         
-        // Copy framebuffer data with pixel format conversion
-        for (int y = 0; y < SCREEN_HEIGHT; y++) {
-            for (int x = 0; x < SCREEN_WIDTH; x++) {
-                int src_idx = y * SCREEN_WIDTH + x;
-                int dst_idx = ((SCREEN_HEIGHT - 1 - y) * SCREEN_WIDTH) + x; // Flip Y
-                
-                // Convert PS2 RGBA32 to standard RGBA format
-                u32 pixel = gs_framebuffer[src_idx];
-                u8 r = (pixel >> 0) & 0xFF;
-                u8 g = (pixel >> 8) & 0xFF;
-                u8 b = (pixel >> 16) & 0xFF;
-                u8 a = (pixel >> 24) & 0xFF;
-                
-                framebuffer_data[dst_idx] = (a << 24) | (b << 16) | (g << 8) | r;
-            }
-        }
-        
         // Save as TGA format (simple uncompressed format)
         char tga_filename[256];
         snprintf(tga_filename, sizeof(tga_filename), "%s.tga", filename);
@@ -787,7 +782,22 @@ void debug_save_frame_capture(const char* filename) {
             tga_header[17] = 0x28; // Top-left origin, 8-bit alpha
             
             fwrite(tga_header, 1, 18, tga_file);
-            fwrite(framebuffer_data, 4, SCREEN_WIDTH * SCREEN_HEIGHT, tga_file);
+            
+            // Copy framebuffer rows with pixel format conversion
+            for (int row = 0; row < SCREEN_HEIGHT; row++) {
+                int y = SCREEN_HEIGHT - 1 - row; // Flip Y
+                for (int x = 0; x < SCREEN_WIDTH; x++) {
+                    // Convert PS2 RGBA32 to standard RGBA format
+                    u32 pixel = gs_framebuffer[y * SCREEN_WIDTH + x];
+                    u8 r = (pixel >> 0) & 0xFF;
+                    u8 g = (pixel >> 8) & 0xFF;
+                    u8 b = (pixel >> 16) & 0xFF;
+                    u8 a = (pixel >> 24) & 0xFF;
+                    
+                    row_data[x] = (a << 24) | (b << 16) | (g << 8) | r;
+                }
+                fwrite(row_data, 4, SCREEN_WIDTH, tga_file);
+            }
             fclose(tga_file);
             
             debug_log_info("Framebuffer captured to '%s'", tga_filename);
@@ -795,7 +805,7 @@ void debug_save_frame_capture(const char* filename) {
             debug_log_error("Failed to create TGA file: %s", tga_filename);
         }
         
-        free(framebuffer_data);
+        memory_free(row_data);
     } else {
         debug_log_error("Failed to allocate framebuffer memory for capture");
     }
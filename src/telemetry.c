@@ -0,0 +1,252 @@
+/*
+ * SPLATSTORM X - Telemetry
+ * Streams one compact record per frame to a host collector over UDP.
+ *
+ * Records go into a preallocated ring of batches. A full batch of
+ * TELEMETRY_BATCH_FRAMES records is posted to the I/O worker, which sends
+ * it as one datagram on a non-blocking socket; the render thread only
+ * copies a few words per frame. While TELEMETRY_RING_BATCHES batches wait
+ * for the worker, new frames are dropped and counted instead. Each
+ * datagram carries a sequence number, so the collector sees any loss
+ * (tools/telemetry_receiver.py).
+ *
+ * Layout, little endian; every field falls on its natural alignment, so
+ * the structs need no packing:
+ *   header: magic u32, version u16, record size u16, sequence u32,
+ *           record count u16, zone count u16
+ *   record: frame u32, zone times u16[PROFILE_ZONE_COUNT] in microseconds
+ *           (saturated), PCR0/PCR1 frame events u32[2], visible and
+ *           rendered splats u32[2], DMA bytes u32[DMA_STATS_CHANNELS] and
+ *           DMA wait u16[DMA_STATS_CHANNELS] in microseconds (saturated),
+ *           sampled VU0 and VU1 busy u16[2] in tenths of a percent, VU1
+ *           gaps between runs and VIF1 MSCAL stalls u16 each in
+ *           microseconds (saturated; all 0 with the sampler off),
+ *           quality level, resolution level, counter set and
+ *           TELEMETRY_FLAG_* bits, u8 each
+ */
+
+#include "splatstorm_x.h"
+#include "splatstorm_debug.h"
+#include "performance_utils.h"
+#include <tamtypes.h>
+#include <kernel.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    u32 magic;                                // TELEMETRY_MAGIC
+    u16 version;                              // TELEMETRY_VERSION
+    u16 record_size;                          // sizeof(TelemetryRecord)
+    u32 sequence;                             // Batches started since telemetry_start
+    u16 record_count;                         // Records that follow
+    u16 zone_count;                           // PROFILE_ZONE_COUNT
+} TelemetryHeader;
+
+typedef struct {
+    u32 frame;
+    u16 zone_us[PROFILE_ZONE_COUNT];          // Saturated at 65535
+    u32 events[2];                            // Whole-frame PCR0/PCR1, 0 with counters off
+    u32 visible_splats;
+    u32 rendered_splats;
+    u32 dma_bytes[DMA_STATS_CHANNELS];        // DMAStatsChannel order
+    u16 dma_wait_us[DMA_STATS_CHANNELS];      // Saturated at 65535
+    u16 vu_busy_permille[2];                  // VU0, VU1 (vu_activity.c)
+    u16 vu1_gap_us;
+    u16 vif1_vu_wait_us;
+    u8 quality_level;
+    u8 resolution_level;
+    u8 counter_set;                           // ProfileCounterSet of the events
+    u8 flags;                                 // TELEMETRY_FLAG_*
+} TelemetryRecord;
+
+typedef struct {
+    TelemetryHeader header;
+    TelemetryRecord records[TELEMETRY_BATCH_FRAMES];
+} TelemetryDatagram;
+
+typedef struct {
+    TelemetryDatagram datagram;
+    u32 size;                                 // Bytes to send
+} __attribute__((aligned(64))) TelemetryBatch;
+
+static struct {
+    bool active;
+    int socket;
+
+    // Ring: the render thread fills batch head and advances it, the
+    // worker advances done once a batch is sent or failed
+    TelemetryBatch batches[TELEMETRY_RING_BATCHES];
+    u32 head;                                 // Batches filled and posted
+    u32 fill;                                 // Records in the batch being filled
+    volatile u32 done;                        // Batches the worker finished
+
+    // Statistics
+    u32 frames_recorded;
+    u32 frames_dropped;                       // Ring full
+    volatile u32 batches_sent;
+    volatile u32 send_failures;               // Socket refused, e.g. no buffer space
+    u32 batches_dropped;                      // I/O queue full
+} g_telemetry = {0};
+
+static void telemetry_send_job(void* arg) {
+    TelemetryBatch* batch = (TelemetryBatch*)arg;
+    if (splatstorm_network_send(g_telemetry.socket, &batch->datagram, batch->size) == (int)batch->size) {
+        g_telemetry.batches_sent++;
+    } else {
+        g_telemetry.send_failures++;
+    }
+    g_telemetry.done++;
+}
+
+// Post the batch being filled, if it holds anything
+static void telemetry_post_batch(void) {
+    if (g_telemetry.fill == 0) return;
+
+    TelemetryBatch* batch = &g_telemetry.batches[g_telemetry.head % TELEMETRY_RING_BATCHES];
+    batch->datagram.header.record_count = (u16)g_telemetry.fill;
+    batch->size = sizeof(TelemetryHeader) + g_telemetry.fill * sizeof(TelemetryRecord);
+    g_telemetry.fill = 0;
+
+    if (worker_post_job(telemetry_send_job, batch, NULL, 0)) {
+        g_telemetry.head++;
+    } else {
+        g_telemetry.batches_dropped++;  // The slot is refilled next frame
+    }
+}
+
+/*
+ * Bring up the network and open a socket to destination, "a.b.c.d" or
+ * "a.b.c.d:port". Call after the workers start; init and connect block.
+ */
+GaussianResult telemetry_start(const char* destination) {
+    if (g_telemetry.active) {
+        return GAUSSIAN_SUCCESS;
+    }
+    if (!destination || !destination[0]) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    char host[32];
+    strncpy(host, destination, sizeof(host) - 1);
+    host[sizeof(host) - 1] = '\0';
+    int port = TELEMETRY_DEFAULT_PORT;
+    char* separator = strchr(host, ':');
+    if (separator) {
+        *separator = '\0';
+        port = atoi(separator + 1);
+    }
+
+    memset(&g_telemetry, 0, sizeof(g_telemetry));
+    g_telemetry.socket = -1;
+
+    if (splatstorm_network_init() < 0 ||
+        splatstorm_network_configure(NETWORK_UNIT_IP, NETWORK_UNIT_MASK, NETWORK_UNIT_GATEWAY) < 0) {
+        debug_log_error("Telemetry: network unavailable");
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+
+    g_telemetry.socket = splatstorm_network_create_udp_socket();
+    if (g_telemetry.socket < 0 || splatstorm_network_connect(g_telemetry.socket, host, port) < 0) {
+        debug_log_error("Telemetry: cannot reach %s:%d", host, port);
+        if (g_telemetry.socket >= 0) {
+            splatstorm_network_close_socket(g_telemetry.socket);
+        }
+        splatstorm_network_shutdown();
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+
+    g_telemetry.active = true;
+    printf("SPLATSTORM X: Telemetry to %s:%d, %u frames per datagram\n", host, port, TELEMETRY_BATCH_FRAMES);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Send what is left, wait for the worker, close the socket
+void telemetry_stop(void) {
+    if (!g_telemetry.active) return;
+
+    telemetry_post_batch();
+    worker_flush();
+
+    splatstorm_network_close_socket(g_telemetry.socket);
+    splatstorm_network_shutdown();
+    g_telemetry.active = false;
+    printf("SPLATSTORM X: Telemetry stopped, %u frames in %u datagrams (%u frames dropped, %u send failures)\n",
+           g_telemetry.frames_recorded, g_telemetry.batches_sent, g_telemetry.frames_dropped,
+           g_telemetry.send_failures);
+}
+
+bool telemetry_active(void) {
+    return g_telemetry.active;
+}
+
+/*
+ * Record the frame the zone profiler just closed. Call once per drawn
+ * frame, after profile_zones_end_frame() and dma_stats_end_frame(); never
+ * blocks.
+ */
+void telemetry_record_frame(u32 frame, const FrameProfileData* profile, u8 quality_level, u8 resolution_level,
+                            u8 flags) {
+    if (!g_telemetry.active || !profile) return;
+
+    u32 cycles[PROFILE_ZONE_COUNT];
+    u32 events[2];
+    if (!profile_zones_latest(cycles, events)) return;
+
+    // A new batch needs a slot the worker is done with
+    if (g_telemetry.fill == 0 && g_telemetry.head - g_telemetry.done >= TELEMETRY_RING_BATCHES) {
+        g_telemetry.frames_dropped++;
+        return;
+    }
+
+    TelemetryBatch* batch = &g_telemetry.batches[g_telemetry.head % TELEMETRY_RING_BATCHES];
+    if (g_telemetry.fill == 0) {
+        TelemetryHeader* header = &batch->datagram.header;
+        header->magic = TELEMETRY_MAGIC;
+        header->version = TELEMETRY_VERSION;
+        header->record_size = sizeof(TelemetryRecord);
+        header->sequence = g_telemetry.head + g_telemetry.batches_dropped;
+        header->zone_count = PROFILE_ZONE_COUNT;
+    }
+
+    TelemetryRecord* record = &batch->datagram.records[g_telemetry.fill++];
+    record->frame = frame;
+    for (u32 zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+        u32 us = (u32)cycles_to_us(cycles[zone]);
+        record->zone_us[zone] = (u16)MIN(us, 0xFFFF);
+    }
+    record->events[0] = events[0];
+    record->events[1] = events[1];
+    record->visible_splats = profile->visible_splats;
+    record->rendered_splats = profile->rendered_splats;
+    DMAChannelStats dma;
+    dma_get_channel_stats(&dma);
+    for (u32 channel = 0; channel < DMA_STATS_CHANNELS; channel++) {
+        u32 us = (u32)cycles_to_us(dma.wait_cycles[channel]);
+        record->dma_bytes[channel] = dma.bytes[channel];
+        record->dma_wait_us[channel] = (u16)MIN(us, 0xFFFF);
+    }
+    VUActivityStats activity;
+    vu_activity_get_stats(&activity);
+    u32 gap_us = (u32)cycles_to_us(activity.gap_cycles[VU_UNIT_VU1]);
+    u32 vu_wait_us = (u32)cycles_to_us(activity.vif_vu_wait_cycles[VU_UNIT_VU1]);
+    record->vu_busy_permille[VU_UNIT_VU0] = (u16)(vu_activity_busy_fraction(VU_UNIT_VU0) * 1000.0f + 0.5f);
+    record->vu_busy_permille[VU_UNIT_VU1] = (u16)(vu_activity_busy_fraction(VU_UNIT_VU1) * 1000.0f + 0.5f);
+    record->vu1_gap_us = (u16)MIN(gap_us, 0xFFFF);
+    record->vif1_vu_wait_us = (u16)MIN(vu_wait_us, 0xFFFF);
+    record->quality_level = quality_level;
+    record->resolution_level = resolution_level;
+    record->counter_set = (u8)profile_zones_get_counters();
+    record->flags = flags;
+    g_telemetry.frames_recorded++;
+
+    if (g_telemetry.fill == TELEMETRY_BATCH_FRAMES) {
+        telemetry_post_batch();
+    }
+}
+
+void telemetry_get_stats(u32* frames_recorded, u32* batches_sent, u32* batches_dropped) {
+    if (frames_recorded) *frames_recorded = g_telemetry.frames_recorded;
+    if (batches_sent) *batches_sent = g_telemetry.batches_sent;
+    if (batches_dropped) *batches_dropped = g_telemetry.batches_dropped + g_telemetry.send_failures;
+}
@@ -6,21 +6,129 @@
  * COMPLETE IMPLEMENTATION - NO STUBS OR PLACEHOLDERS
  * Features:
  * - 16x16 tile-based rasterization with hierarchical 64x64 coarse tiles
- * - Elliptical overlap detection with oriented bounding boxes
- * - Bucket sort with temporal coherence optimization
- * - Load balancing and work distribution
+ * - Bins 16-byte quantized render splats (12.4 screen position, Z24 depth)
+ * - Integer circle/tile overlap detection in GS subpixel units
+ * - Two-pass count/scatter binning into one contiguous frame-arena buffer
+ * - Layout reuse for sub-threshold camera motion: one scatter pass into the
+ *   previous frame's bin layout instead of count and scatter; only splats
+ *   crossing a tile edge take circle tests. Every splat is still scattered
+ * - Binning and sort-key passes stream splats through the scratchpad
+ * - Global LSD radix sort of (tile_id | depth) keys into preallocated buffers
+ * - Optional texture-cache ordering: footprint cell as a secondary key
+ *   within each depth bucket
+ * - Screen-space LOD: sub-pixel splats sharing a pixel cell and depth slice
+ *   are folded into one aggregate splat before binning
+ * - Optional saturation early-out: tiles are walked front to back and splats
+ *   behind fully opaque coverage are never submitted; tiles it finds opaque
+ *   need no clear
+ * - Occlusion pyramid: per tile, the depth at which the saturation walk found
+ *   the tile opaque, reduced 2x2 to the farthest; the next frame's culling
+ *   tests node boxes against it
+ * - Render regions: runs of non-empty tiles in a row merge into one scissor
+ *   rectangle, and a splat spanning several of them is drawn once
+ * - Adaptive regions: hot tiles split into 8x8 sub-tile regions, and sparse
+ *   64x64 coarse tiles draw as one region, so batch sizes stay even
+ * - Tile heatmap debug mode: splats, estimated fill or measured submission
+ *   cycles per tile, and the hottest tiles
  * - Cache-optimized memory access patterns
  * - Performance profiling and debug visualization
  */
 
 #include "splatstorm_x.h"
 #include "gaussian_types.h"
+#include "fixed_math_mmi.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <math.h>
 
+// Global tile sort keys: tile id in the high bits, Z24 depth (top bits) below
+// it. Larger Z is nearer, so an ascending sort yields tiles in order, each
+// back-to-front.
+#define TILE_KEY_DEPTH_BITS     20
+#define TILE_KEY_DEPTH_SHIFT    (RENDER_SPLAT_DEPTH_BITS - TILE_KEY_DEPTH_BITS)
+#define TILE_KEY_DEPTH_MASK     ((1u << TILE_KEY_DEPTH_BITS) - 1)
+
+// Texture-cache ordering splits the depth field: a coarser depth bucket, and
+// below it the footprint mip level and atlas cell, so splats in one bucket
+// are submitted grouped by the texture pages they sample
+#define TILE_KEY_ATLAS_BITS     8             // Mip level (2 bits) and atlas cell (6 bits)
+#define TILE_KEY_BUCKET_BITS    (TILE_KEY_DEPTH_BITS - TILE_KEY_ATLAS_BITS)
+#define TILE_KEY_BUCKET_SHIFT   (RENDER_SPLAT_DEPTH_BITS - TILE_KEY_BUCKET_BITS)
+#define TILE_KEY_BUCKET_MASK    ((1u << TILE_KEY_BUCKET_BITS) - 1)
+#define RADIX_BITS              8
+#define RADIX_BUCKETS           (1 << RADIX_BITS)
+#define RADIX_PASSES            4
+#define SORT_CAPACITY_PER_SPLAT 4             // Initial overlap buffer size per splat
+#define SORT_CAPACITY_MAX       (0xFFFFFFFFu / (2 * sizeof(u32)))  // Grown buffers stay addressable
+
+// Tile ids go above the depth bits of the 32-bit sort key
+#if ((MAX_TILES - 1) >> (32 - TILE_KEY_DEPTH_BITS)) != 0
+#error "Tile ids do not fit above the depth bits of the tile sort key"
+#endif
+#define TILE_SIZE_SHIFT         4             // log2(TILE_SIZE)
+
+// Adaptive render regions, planned by perform_load_balancing()
+#define TILE_HOT_SPLATS         MAX_SPLATS_PER_TILE  // Tiles drawing more split into sub-tiles
+#define TILE_SUB_SHIFT          3             // 8x8 sub-tiles, 4 per tile
+#define TILE_SPARSE_SPLATS      64            // Coarse tiles drawing at most this many merge
+#define COARSE_TILE_SPAN        (COARSE_TILE_SIZE / TILE_SIZE)
+#define TILE_PLAN_ROW           0             // Drawn in its row's run of tiles
+#define TILE_PLAN_SPLIT         1             // Drawn as sub-tile regions
+#define TILE_PLAN_COARSE        2             // Drawn with its whole coarse tile
+
+// One-pass binning reserves each tile its last overlap count plus headroom
+#define TILE_REUSE_HEADROOM_SHIFT 3           // count / 8 spare entries
+#define TILE_REUSE_HEADROOM_MIN   4           // and a few more, so empty tiles can fill
+
+// Screen-space LOD aggregation. Cells are power-of-two pixel squares, so a
+// cell never straddles a tile; depth slices are the top Z24 bits.
+#define LOD_CELL_SHIFT          1             // 2x2 pixel cells
+#define LOD_DEPTH_SLICE_SHIFT   16            // 256 Z24 slices
+#define LOD_MAX_AGGREGATES      16384         // Per frame; later candidates pass through unmerged
+#define LOD_TABLE_BITS          15            // Open-addressed cell table, 2x the aggregates
+#define LOD_TABLE_SIZE          (1u << LOD_TABLE_BITS)
+#define LOD_QUALITY_LEVELS      4
+
+// Saturation early-out: transmittance per 4x4 pixel block of a tile, Q0.8
+#define SATURATION_BLOCK_SHIFT  2             // log2 of the block size in pixels
+#define SATURATION_BLOCKS_X     (TILE_SIZE >> SATURATION_BLOCK_SHIFT)
+#define SATURATION_BLOCKS       (SATURATION_BLOCKS_X * SATURATION_BLOCKS_X)
+#define SATURATION_ONE          256           // Transmittance 1.0
+#define SATURATION_FALLOFF_STEPS 16           // Falloff table steps over (d / R)^2 = 0..1
+
+// Occlusion pyramid: level 0 is the tile grid, each level above halves it
+#define OCCLUSION_LEVELS        7             // 40x28 down to 1x1
+#define OCCLUSION_GUARD_TILES   1             // Query rects grow by this, for last frame's motion
+
+// Footprint alpha at (d / R)^2 = i / 16: 256 * exp(-4.5 * i / 16), the atlas
+// Gaussian with its 3-sigma radius at the sprite edge
+static const u16 g_saturation_falloff[SATURATION_FALLOFF_STEPS + 1] = {
+    256, 193, 146, 110, 83, 63, 47, 36, 27, 20, 15, 12, 9, 7, 5, 4, 3
+};
+
+// Minor axis over the radius per footprint aspect row, 256 / sqrt(1 + row):
+// the opaque core of an elongated footprint is only that wide
+static const u16 g_saturation_minor_axis[8] = {256, 181, 148, 128, 114, 105, 97, 91};
+
+// 3-sigma radius (12.4) under which a splat is aggregated, per quality level:
+// 2, 1.5, 1 and 0.5 pixels
+static const u16 g_lod_radius_threshold[LOD_QUALITY_LEVELS] = {32, 24, 16, 8};
+
+// One aggregate under construction. Members are weighted by alpha * r^2,
+// their share of the light deposited in the cell.
+typedef struct {
+    u32 key;                                  // Cell y, cell x and depth slice
+    u32 output;                               // Aggregate's index in the compacted array
+    float weight;                             // Sum of alpha * r^2
+    float position[2];                        // Weighted screen x, y (12.4)
+    float color[3];                           // Weighted RGB
+    float transmittance;                      // Product of (1 - alpha)
+    u32 depth;                                // Nearest member Z24
+    u32 members;                              // Splats folded in
+} LODAggregate;
+
 // Tile system state
 typedef struct {
     bool initialized;                         // System initialization flag
@@ -30,8 +138,19 @@ typedef struct {
     
     // Tile assignment data
     u32* tile_splat_counts;                   // Number of splats per tile
-    u32** tile_splat_lists;                   // Lists of splat indices per tile
-    u32* tile_list_capacity;                  // Capacity of each tile list
+    u32* tile_bin_start;                      // Prefix sum: first bin entry per tile (MAX_TILES + 1)
+    u32* tile_bin_cursor;                     // Scatter cursor per tile
+    u32* bin_indices;                         // Contiguous splat indices, grouped by tile
+    u32* bin_fallback;                        // Owned bin buffer when no frame arena is set
+    u32 bin_fallback_capacity;                // Entries allocated in bin_fallback
+    bool use_frame_arena;                     // Bins come from the per-frame arena
+    bool texture_order;                       // Atlas cell as secondary sort key within depth buckets
+    
+    // Active tile grid: the render size inside the TILES_X x TILES_Y capacity.
+    // Tile ids keep the TILES_X stride, so tiles past the grid stay empty.
+    u32 tiles_x;                              // Tile columns at the render width
+    u32 tiles_y;                              // Tile rows at the render height
+    fixed16x4_lanes tile_upper;               // Upper clamp for splat_tile_bounds()
     
     // Hierarchical culling data
     u32* coarse_tile_counts;                  // Splat counts for coarse tiles
@@ -39,15 +158,71 @@ typedef struct {
     
     // Sorting data
     u32* sort_keys;                           // Depth-based sort keys
-    u16* sort_indices;                        // Sorted splat indices
+    u32* sort_indices;                        // Sorted splat indices
     u32* bucket_counts;                       // Bucket sort counters
     u32* bucket_offsets;                      // Bucket sort offsets
     
+    // Global radix sort buffers (one entry per splat-tile overlap)
+    u32* overlap_keys;                        // (tile_id | depth) keys
+    u32* overlap_values;                      // Splat index per key
+    u32* overlap_keys_alt;                    // Ping-pong buffer for keys
+    u32* overlap_values_alt;                  // Ping-pong buffer for values
+    u32 overlap_capacity;                     // Entries allocated in each buffer
+    u32 overlap_count;                        // Entries sorted this frame
+    u32* radix_histograms;                    // RADIX_PASSES x RADIX_BUCKETS counters
+    
+    // Screen-space LOD
+    u16 lod_radius_threshold;                 // Aggregate splats with a smaller radius (12.4), 0 = off
+    u32 lod_input_splats;                     // Splats entering the last aggregation
+    u32 lod_output_splats;                    // Splats it left for binning
+    
+    // Saturation early-out
+    bool saturation_cull;                     // Drop splats behind saturated blocks
+    u16 saturation_epsilon;                   // Block transmittance (Q0.8) counted as opaque
+    u32 saturation_culled;                    // Overlaps dropped in the last frame
+    u8* tile_covered;                         // Per tile: every block opaque this frame
+    u32 covered_tiles;                        // Tiles marked covered in the last frame
+    
+    // Occlusion pyramid from the saturation walk
+    bool occlusion_culling;                   // Build the pyramid and answer queries
+    bool occlusion_valid;                     // Pyramid holds the last rendered frame
+    u32* occluder_depth;                      // Z24 in front of which each cell is opaque, 0 = none
+    u32 occlusion_offset[OCCLUSION_LEVELS];   // First cell of each level in occluder_depth
+    u32 occlusion_width[OCCLUSION_LEVELS];    // Cells per row at each level
+    u32 occlusion_height[OCCLUSION_LEVELS];   // Rows at each level
+    u32 render_width;                         // Render size the tile grid follows
+    u32 render_height;
+    u32 occlusion_queries;                    // Queries answered
+    u32 occlusion_hits;                       // Queries that found the box hidden
+    
+    // Render regions
+    u32 max_splats;                           // Splat capacity of region_stamp
+    u32* region_stamp;                        // Last region each splat was emitted in
+    u32 region_stamp_clock;                   // Advances once per region
+    u32 region_entries;                       // Sprites in the last region build
+    u8* tile_plan;                            // Per tile: TILE_PLAN_*
+    u32 hot_tiles;                            // Tiles planned for splitting in the last frame
+    u32 sparse_blocks;                        // Coarse tiles planned for merging in the last frame
+    u32 split_regions;                        // Sub-tile regions in the last region build
+    u32 merged_regions;                       // Coarse-tile regions in the last region build
+    
+    // Heatmap debug mode
+    u32 heatmap_mode;                         // TILE_HEATMAP_*
+    u32* tile_heat;                           // Per tile: the mode's value this frame
+    
     // Temporal coherence data
     fixed16_t last_camera_pos[3];             // Previous camera position
     fixed16_t last_camera_rot[4];             // Previous camera rotation
     u32 moved_splat_count;                    // Number of splats that moved tiles
-    u16* moved_splat_indices;                 // Indices of moved splats
+    u32* moved_splat_indices;                 // Indices of moved splats
+    
+    // Bin layout reuse
+    bool layout_reuse;                        // Reuse the bin layout while the camera barely moves
+    bool layout_valid;                        // layout_counts describe the last binned frame
+    u32* layout_counts;                       // Overlaps per tile at the last binning, before saturation
+    u32 one_pass_frames;                      // Frames binned in one pass
+    u32 one_pass_fallbacks;                   // One-pass attempts that overflowed a tile
+    u32 border_splats;                        // Splats re-tested against tiles in the last one-pass frame
     
     // Performance profiling
     u64 cull_cycles;                          // Culling time
@@ -75,25 +250,36 @@ int tile_system_init(u32 max_splats) {
     
     // Allocate tile assignment arrays
     g_tile_state.tile_splat_counts = (u32*)calloc(MAX_TILES, sizeof(u32));
-    g_tile_state.tile_splat_lists = (u32**)malloc(MAX_TILES * sizeof(u32*));
-    g_tile_state.tile_list_capacity = (u32*)malloc(MAX_TILES * sizeof(u32));
-    
-    if (!g_tile_state.tile_splat_counts || !g_tile_state.tile_splat_lists || 
-        !g_tile_state.tile_list_capacity) {
+    g_tile_state.tile_bin_start = (u32*)calloc(MAX_TILES + 1, sizeof(u32));
+    g_tile_state.tile_bin_cursor = (u32*)malloc(MAX_TILES * sizeof(u32));
+    g_tile_state.tile_covered = (u8*)calloc(MAX_TILES, sizeof(u8));
+    g_tile_state.tile_plan = (u8*)calloc(MAX_TILES, sizeof(u8));
+    g_tile_state.layout_counts = (u32*)calloc(MAX_TILES, sizeof(u32));
+    g_tile_state.tile_heat = (u32*)calloc(MAX_TILES, sizeof(u32));
+    
+    // Occlusion pyramid levels, each half the one below rounded up
+    u32 occlusion_cells = 0;
+    for (u32 level = 0; level < OCCLUSION_LEVELS; level++) {
+        g_tile_state.occlusion_width[level] = level ? (g_tile_state.occlusion_width[level - 1] + 1) / 2 : TILES_X;
+        g_tile_state.occlusion_height[level] = level ? (g_tile_state.occlusion_height[level - 1] + 1) / 2 : TILES_Y;
+        g_tile_state.occlusion_offset[level] = occlusion_cells;
+        occlusion_cells += g_tile_state.occlusion_width[level] * g_tile_state.occlusion_height[level];
+    }
+    g_tile_state.occluder_depth = (u32*)calloc(occlusion_cells, sizeof(u32));
+    g_tile_state.bin_indices = NULL;
+    g_tile_state.bin_fallback = NULL;
+    g_tile_state.bin_fallback_capacity = 0;
+    g_tile_state.use_frame_arena = false;
+    g_tile_state.texture_order = false;
+    tile_set_render_size(TILES_X * TILE_SIZE, TILES_Y * TILE_SIZE);
+    
+    if (!g_tile_state.tile_splat_counts || !g_tile_state.tile_bin_start || 
+        !g_tile_state.tile_bin_cursor || !g_tile_state.tile_covered || !g_tile_state.layout_counts ||
+        !g_tile_state.occluder_depth || !g_tile_state.tile_plan || !g_tile_state.tile_heat) {
         tile_system_cleanup();
         return -1;
     }
     
-    // Allocate per-tile splat lists with initial capacity
-    for (u32 i = 0; i < MAX_TILES; i++) {
-        g_tile_state.tile_list_capacity[i] = MAX_SPLATS_PER_TILE;
-        g_tile_state.tile_splat_lists[i] = (u32*)malloc(MAX_SPLATS_PER_TILE * sizeof(u32));
-        if (!g_tile_state.tile_splat_lists[i]) {
-            tile_system_cleanup();
-            return -1;
-        }
-    }
-    
     // Allocate hierarchical culling arrays
     g_tile_state.coarse_tile_counts = (u32*)calloc(MAX_COARSE_TILES, sizeof(u32));
     g_tile_state.coarse_tile_bounds = (fixed16_t*)malloc(MAX_COARSE_TILES * 2 * sizeof(fixed16_t));
@@ -105,7 +291,7 @@ int tile_system_init(u32 max_splats) {
     
     // Allocate sorting arrays
     g_tile_state.sort_keys = (u32*)malloc(max_splats * sizeof(u32));
-    g_tile_state.sort_indices = (u16*)malloc(max_splats * sizeof(u16));
+    g_tile_state.sort_indices = (u32*)malloc(max_splats * sizeof(u32));
     g_tile_state.bucket_counts = (u32*)calloc(NUM_DEPTH_BUCKETS, sizeof(u32));
     g_tile_state.bucket_offsets = (u32*)malloc(NUM_DEPTH_BUCKETS * sizeof(u32));
     
@@ -115,8 +301,33 @@ int tile_system_init(u32 max_splats) {
         return -1;
     }
     
+    // Allocate global radix sort buffers
+    g_tile_state.overlap_capacity = MAX(max_splats * SORT_CAPACITY_PER_SPLAT, MAX_TILES);
+    g_tile_state.overlap_keys = (u32*)malloc(g_tile_state.overlap_capacity * sizeof(u32));
+    g_tile_state.overlap_values = (u32*)malloc(g_tile_state.overlap_capacity * sizeof(u32));
+    g_tile_state.overlap_keys_alt = (u32*)malloc(g_tile_state.overlap_capacity * sizeof(u32));
+    g_tile_state.overlap_values_alt = (u32*)malloc(g_tile_state.overlap_capacity * sizeof(u32));
+    g_tile_state.radix_histograms = (u32*)malloc(RADIX_PASSES * RADIX_BUCKETS * sizeof(u32));
+    g_tile_state.overlap_count = 0;
+    
+    if (!g_tile_state.overlap_keys || !g_tile_state.overlap_values ||
+        !g_tile_state.overlap_keys_alt || !g_tile_state.overlap_values_alt ||
+        !g_tile_state.radix_histograms) {
+        tile_system_cleanup();
+        return -1;
+    }
+    
+    // Allocate render region dedup stamps
+    g_tile_state.max_splats = max_splats;
+    g_tile_state.region_stamp = (u32*)calloc(max_splats, sizeof(u32));
+    g_tile_state.region_stamp_clock = 0;
+    if (!g_tile_state.region_stamp) {
+        tile_system_cleanup();
+        return -1;
+    }
+    
     // Allocate temporal coherence arrays
-    g_tile_state.moved_splat_indices = (u16*)malloc(max_splats * sizeof(u16));
+    g_tile_state.moved_splat_indices = (u32*)malloc(max_splats * sizeof(u32));
     if (!g_tile_state.moved_splat_indices) {
         tile_system_cleanup();
         return -1;
@@ -127,6 +338,17 @@ int tile_system_init(u32 max_splats) {
     g_tile_state.last_sort_frame = 0;
     g_tile_state.needs_full_sort = true;
     g_tile_state.moved_splat_count = 0;
+    g_tile_state.lod_radius_threshold = g_lod_radius_threshold[LOD_QUALITY_LEVELS - 1];
+    g_tile_state.saturation_cull = false;
+    g_tile_state.saturation_epsilon = (u16)(TILE_SATURATION_EPSILON_DEFAULT * SATURATION_ONE);
+    g_tile_state.layout_reuse = true;
+    g_tile_state.occlusion_culling = false;
+    g_tile_state.occlusion_valid = false;
+    g_tile_state.heatmap_mode = TILE_HEATMAP_OFF;
+    g_tile_state.layout_valid = false;
+    g_tile_state.one_pass_frames = 0;
+    g_tile_state.one_pass_fallbacks = 0;
+    g_tile_state.border_splats = 0;
     
     // Initialize camera tracking
     memset(g_tile_state.last_camera_pos, 0, sizeof(g_tile_state.last_camera_pos));
@@ -152,6 +374,11 @@ int tile_system_init(u32 max_splats) {
 
 // Check if camera moved significantly for temporal coherence
 bool camera_moved_significantly(const CameraFixed* camera) {
+    // Matrices unchanged since last frame (camera_begin_frame): nothing to compare
+    if (!camera->moved_significantly) {
+        return false;
+    }
+    
     // Position threshold (0.1 units)
     const fixed16_t pos_threshold = fixed_from_float(0.1f);
     
@@ -197,78 +424,29 @@ void update_camera_tracking(const CameraFixed* camera) {
     memcpy(g_tile_state.last_camera_rot, camera->rotation, sizeof(g_tile_state.last_camera_rot));
 }
 
-// Elliptical overlap test with oriented bounding box
-bool splat_overlaps_tile_elliptical(const GaussianSplat2D* splat, u32 tile_x, u32 tile_y) {
-    // Get splat center and eigenvalues
-    fixed16_t cx = splat->screen_pos[0];
-    fixed16_t cy = splat->screen_pos[1];
-    fixed16_t ev1 = splat->eigenvals[0];
-    fixed16_t ev2 = splat->eigenvals[1];
-    
-    // Handle degenerate cases
-    if (ev1 <= 0 || ev2 <= 0) {
-        return false;  // Degenerate splat
-    }
-    
-    // Get eigenvectors (rotation matrix)
-    fixed16_t cos_theta = splat->eigenvecs[0];  // eigenvec[0].x
-    fixed16_t sin_theta = splat->eigenvecs[1];  // eigenvec[0].y
-    
-    // Compute 3-sigma ellipse semi-axes
-    fixed16_t semi_major = fixed_mul(fixed_from_float(3.0f), fixed_sqrt_lut(ev1));
-    fixed16_t semi_minor = fixed_mul(fixed_from_float(3.0f), fixed_sqrt_lut(ev2));
-    
-    // Tile bounds
-    fixed16_t tile_left = fixed_from_int(tile_x * TILE_SIZE);
-    fixed16_t tile_right = fixed_from_int((tile_x + 1) * TILE_SIZE);
-    fixed16_t tile_top = fixed_from_int(tile_y * TILE_SIZE);
-    fixed16_t tile_bottom = fixed_from_int((tile_y + 1) * TILE_SIZE);
-    
-    // Compute oriented bounding box of ellipse
-    fixed16_t cos_abs = fixed_abs(cos_theta);
-    fixed16_t sin_abs = fixed_abs(sin_theta);
-    
-    fixed16_t obb_half_width = fixed_add(fixed_mul(semi_major, cos_abs), 
-                                        fixed_mul(semi_minor, sin_abs));
-    fixed16_t obb_half_height = fixed_add(fixed_mul(semi_major, sin_abs), 
-                                         fixed_mul(semi_minor, cos_abs));
-    
-    // AABB overlap test
-    fixed16_t splat_left = fixed_sub(cx, obb_half_width);
-    fixed16_t splat_right = fixed_add(cx, obb_half_width);
-    fixed16_t splat_top = fixed_sub(cy, obb_half_height);
-    fixed16_t splat_bottom = fixed_add(cy, obb_half_height);
-    
-    return !(splat_right <= tile_left || splat_left >= tile_right ||
-             splat_bottom <= tile_top || splat_top >= tile_bottom);
-}
-
-// Fast circular overlap test (fallback)
-bool splat_overlaps_tile_circular(const GaussianSplat2D* splat, u32 tile_x, u32 tile_y) {
-    fixed16_t cx = splat->screen_pos[0];
-    fixed16_t cy = splat->screen_pos[1];
-    fixed16_t radius = splat->radius;
+// Circle/tile overlap test in 12.4 subpixel units
+bool splat_overlaps_tile_circular(const GaussianSplatRender* splat, u32 tile_x, u32 tile_y) {
+    s32 cx = splat->screen_x;
+    s32 cy = splat->screen_y;
+    s32 radius = splat->radius;
     
     // Tile bounds
-    fixed16_t tile_left = fixed_from_int(tile_x * TILE_SIZE);
-    fixed16_t tile_right = fixed_from_int((tile_x + 1) * TILE_SIZE);
-    fixed16_t tile_top = fixed_from_int(tile_y * TILE_SIZE);
-    fixed16_t tile_bottom = fixed_from_int((tile_y + 1) * TILE_SIZE);
+    s32 tile_left = (s32)(tile_x * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s32 tile_right = (s32)((tile_x + 1) * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s32 tile_top = (s32)(tile_y * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s32 tile_bottom = (s32)((tile_y + 1) * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
     
     // Circle-rectangle overlap test
-    fixed16_t closest_x = CLAMP(cx, tile_left, tile_right);
-    fixed16_t closest_y = CLAMP(cy, tile_top, tile_bottom);
-    
-    fixed16_t dx = fixed_sub(cx, closest_x);
-    fixed16_t dy = fixed_sub(cy, closest_y);
-    fixed16_t dist_sq = fixed_add(fixed_mul(dx, dx), fixed_mul(dy, dy));
-    fixed16_t radius_sq = fixed_mul(radius, radius);
+    s32 dx = cx - CLAMP(cx, tile_left, tile_right);
+    s32 dy = cy - CLAMP(cy, tile_top, tile_bottom);
     
-    return dist_sq <= radius_sq;
+    // Squares of up to 16 bits each, summed in 64 bits
+    u64 dist_sq = (u64)((s64)dx * dx) + (u64)((s64)dy * dy);
+    return dist_sq <= (u64)radius * (u64)radius;
 }
 
 // Hierarchical coarse tile culling
-void perform_coarse_tile_culling(const GaussianSplat2D* splats, u32 splat_count) {
+void perform_coarse_tile_culling(const GaussianSplatRender* splats, u32 splat_count) {
     // Clear coarse tile data
     memset(g_tile_state.coarse_tile_counts, 0, MAX_COARSE_TILES * sizeof(u32));
     
@@ -280,11 +458,11 @@ void perform_coarse_tile_culling(const GaussianSplat2D* splats, u32 splat_count)
     
     // Assign splats to coarse tiles and update bounds
     for (u32 i = 0; i < splat_count; i++) {
-        const GaussianSplat2D* splat = &splats[i];
+        const GaussianSplatRender* splat = &splats[i];
         
         // Determine coarse tile coordinates
-        int coarse_x = fixed_to_int(splat->screen_pos[0]) / COARSE_TILE_SIZE;
-        int coarse_y = fixed_to_int(splat->screen_pos[1]) / COARSE_TILE_SIZE;
+        int coarse_x = (splat->screen_x >> RENDER_SPLAT_SUBPIXEL_SHIFT) / COARSE_TILE_SIZE;
+        int coarse_y = (splat->screen_y >> RENDER_SPLAT_SUBPIXEL_SHIFT) / COARSE_TILE_SIZE;
         
         // Clamp to valid range
         coarse_x = CLAMP(coarse_x, 0, COARSE_TILES_X - 1);
@@ -295,7 +473,7 @@ void perform_coarse_tile_culling(const GaussianSplat2D* splats, u32 splat_count)
         // Update count and depth bounds
         g_tile_state.coarse_tile_counts[coarse_tile_id]++;
         
-        fixed16_t depth = splat->depth;
+        fixed16_t depth = (fixed16_t)splat->depth;
         if (depth < g_tile_state.coarse_tile_bounds[coarse_tile_id * 2]) {
             g_tile_state.coarse_tile_bounds[coarse_tile_id * 2] = depth;  // min
         }
@@ -305,160 +483,708 @@ void perform_coarse_tile_culling(const GaussianSplat2D* splats, u32 splat_count)
     }
 }
 
+// Allocate tile bins from the per-frame arena.
+// The arena is expected to be reset once per frame before process_tiles().
+void tile_system_use_frame_arena(bool enable) {
+    g_tile_state.use_frame_arena = enable;
+}
+
+// Follow the render resolution; sizes past the tile capacity are clamped
+void tile_set_render_size(u32 width, u32 height) {
+    g_tile_state.tiles_x = CLAMP((width + TILE_SIZE - 1) / TILE_SIZE, 1, TILES_X);
+    g_tile_state.tiles_y = CLAMP((height + TILE_SIZE - 1) / TILE_SIZE, 1, TILES_Y);
+    
+    fixed16x4_lanes upper = {.lane = {FIXED16_MAX, (fixed16_t)g_tile_state.tiles_x - 1,
+                                      FIXED16_MAX, (fixed16_t)g_tile_state.tiles_y - 1}};
+    g_tile_state.tile_upper = upper;
+    g_tile_state.layout_valid = false;
+    g_tile_state.render_width = width;
+    g_tile_state.render_height = height;
+    g_tile_state.occlusion_valid = false;
+}
+
+// Tile range a splat's bounding circle can touch
+static inline bool splat_tile_bounds(const GaussianSplatRender* splat, int* min_tile_x, int* max_tile_x,
+                                     int* min_tile_y, int* max_tile_y) {
+    // Skip if splat is degenerate
+    if (splat->radius == 0) {
+        return false;
+    }
+    
+    s32 cx = splat->screen_x;
+    s32 cy = splat->screen_y;
+    s32 radius = splat->radius;
+    
+    // Entirely off the left or top edge
+    if (cx + radius < 0 || cy + radius < 0) {
+        return false;
+    }
+    
+    // All four edges in one MMI pass: 12.4 to tiles is a single shift (negative
+    // minimum edges round down instead of toward zero, and clamp to 0 either way).
+    // Minimum edges are only clamped below and maximum edges only above, so a
+    // splat past the right or bottom edge still gets an empty range.
+    static const fixed16x4_lanes tile_lower = {.lane = {0, FIXED16_MIN, 0, FIXED16_MIN}};
+    fixed16x4_lanes tiles;
+    tiles.v = fixed16x4_set(cx - radius, cx + radius, cy - radius, cy + radius);
+    tiles.v = FIXED16X4_SRA(tiles.v, RENDER_SPLAT_SUBPIXEL_SHIFT + TILE_SIZE_SHIFT);
+    tiles.v = fixed16x4_clamp(tiles.v, tile_lower.v, g_tile_state.tile_upper.v);
+    
+    *min_tile_x = tiles.lane[0];
+    *max_tile_x = tiles.lane[1];
+    *min_tile_y = tiles.lane[2];
+    *max_tile_y = tiles.lane[3];
+    return true;
+}
+
+// Contiguous bin buffer for this frame: frame arena first, owned buffer otherwise
+static u32* acquire_bin_buffer(u32 entries) {
+    if (entries == 0) {
+        return g_tile_state.bin_fallback;
+    }
+    
+    if (g_tile_state.use_frame_arena && frame_arena_active()) {
+        u32* arena = (u32*)frame_arena_alloc(entries * sizeof(u32), CACHE_LINE_SIZE);
+        if (arena) {
+            return arena;
+        }
+    }
+    
+    if (entries > g_tile_state.bin_fallback_capacity) {
+        u32 new_capacity = entries + entries / 2;
+        u32* grown = (u32*)realloc(g_tile_state.bin_fallback, new_capacity * sizeof(u32));
+        if (!grown) {
+            return NULL;
+        }
+        g_tile_state.bin_fallback = grown;
+        g_tile_state.bin_fallback_capacity = new_capacity;
+    }
+    
+    return g_tile_state.bin_fallback;
+}
+
+// Binning pass 1 kernel: count overlaps per tile for one scratchpad block
+static void bin_count_kernel(const void* block, u32 first, u32 count, void* user) {
+    const GaussianSplatRender* splats = (const GaussianSplatRender*)block;
+    (void)first;
+    (void)user;
+    
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplatRender* splat = &splats[i];
+        int min_tile_x, max_tile_x, min_tile_y, max_tile_y;
+        
+        if (!splat_tile_bounds(splat, &min_tile_x, &max_tile_x, &min_tile_y, &max_tile_y)) {
+            continue;
+        }
+        
+        for (int tile_y = min_tile_y; tile_y <= max_tile_y; tile_y++) {
+            for (int tile_x = min_tile_x; tile_x <= max_tile_x; tile_x++) {
+                if (splat_overlaps_tile_circular(splat, tile_x, tile_y)) {
+                    g_tile_state.tile_splat_counts[tile_y * TILES_X + tile_x]++;
+                }
+            }
+        }
+    }
+}
+
+// Binning pass 2 kernel: scatter splat indices, same test as pass 1 so counts match exactly
+static void bin_scatter_kernel(const void* block, u32 first, u32 count, void* user) {
+    const GaussianSplatRender* splats = (const GaussianSplatRender*)block;
+    u32* bins = (u32*)user;
+    
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplatRender* splat = &splats[i];
+        int min_tile_x, max_tile_x, min_tile_y, max_tile_y;
+        
+        if (!splat_tile_bounds(splat, &min_tile_x, &max_tile_x, &min_tile_y, &max_tile_y)) {
+            continue;
+        }
+        
+        for (int tile_y = min_tile_y; tile_y <= max_tile_y; tile_y++) {
+            for (int tile_x = min_tile_x; tile_x <= max_tile_x; tile_x++) {
+                if (splat_overlaps_tile_circular(splat, tile_x, tile_y)) {
+                    u32 tile_id = tile_y * TILES_X + tile_x;
+                    bins[g_tile_state.tile_bin_cursor[tile_id]++] = first + i;
+                }
+            }
+        }
+    }
+}
+
 // Assign splats to fine tiles with overlap detection
-void assign_splats_to_tiles(const GaussianSplat2D* splats, u32 splat_count) {
+// Pass one counts overlaps per tile, a prefix sum turns the counts into
+// offsets, and pass two scatters splat indices into one contiguous buffer.
+// Both passes stream the splats through the scratchpad.
+// Either every overlap is binned or the call fails; nothing is dropped.
+bool assign_splats_to_tiles(const GaussianSplatRender* splats, u32 splat_count) {
     u64 assign_start = get_cpu_cycles();
     
     // Clear tile counts
     memset(g_tile_state.tile_splat_counts, 0, MAX_TILES * sizeof(u32));
     g_tile_state.total_overlaps = 0;
+    g_tile_state.bin_indices = NULL;
     
-    // Process each splat
-    for (u32 splat_idx = 0; splat_idx < splat_count; splat_idx++) {
-        const GaussianSplat2D* splat = &splats[splat_idx];
+    // Pass 1: count overlaps per tile
+    dma_spr_stream(splats, sizeof(GaussianSplatRender), NULL, splat_count, bin_count_kernel, NULL);
+    
+    // Exclusive prefix sum gives each tile its slice of the bin buffer
+    u32 total = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        g_tile_state.tile_bin_start[tile_id] = total;
+        g_tile_state.tile_bin_cursor[tile_id] = total;
+        total += g_tile_state.tile_splat_counts[tile_id];
+    }
+    g_tile_state.tile_bin_start[MAX_TILES] = total;
+    
+    u32* bins = acquire_bin_buffer(total);
+    if (total > 0 && !bins) {
+        printf("SPLATSTORM X: Tile binning failed to allocate %u overlaps\n", total);
+        memset(g_tile_state.tile_splat_counts, 0, MAX_TILES * sizeof(u32));
+        g_tile_state.assign_cycles += get_cpu_cycles() - assign_start;
+        return false;
+    }
+    
+    // Pass 2: scatter splat indices
+    dma_spr_stream(splats, sizeof(GaussianSplatRender), NULL, splat_count, bin_scatter_kernel, bins);
+    
+    g_tile_state.bin_indices = bins;
+    g_tile_state.total_overlaps = total;
+    memcpy(g_tile_state.layout_counts, g_tile_state.tile_splat_counts, MAX_TILES * sizeof(u32));
+    g_tile_state.layout_valid = true;
+    g_tile_state.assign_cycles += get_cpu_cycles() - assign_start;
+    return true;
+}
+
+typedef struct {
+    u32* bins;                                // Bin buffer laid out from layout_counts
+    bool overflow;                            // Some tile outgrew its reserved range
+    u32 border_splats;                        // Splats that needed the circle tests
+} BinReuseContext;
+
+// Bounds inside one tile before clamping: the centre lies in that tile, so
+// the splat overlaps it and no other
+static inline bool splat_inside_tile(const GaussianSplatRender* splat, int tile_x, int tile_y) {
+    const int shift = RENDER_SPLAT_SUBPIXEL_SHIFT + TILE_SIZE_SHIFT;
+    s32 radius = splat->radius;
+    return splat->screen_x - radius >= 0 && splat->screen_y - radius >= 0 &&
+           ((splat->screen_x + radius) >> shift) == tile_x && ((splat->screen_y + radius) >> shift) == tile_y;
+}
+
+static inline void bin_reuse_place(BinReuseContext* context, u32 tile_id, u32 index) {
+    u32 cursor = g_tile_state.tile_bin_cursor[tile_id];
+    if (cursor < g_tile_state.tile_bin_start[tile_id + 1]) {
+        context->bins[cursor] = index;
+        g_tile_state.tile_bin_cursor[tile_id] = cursor + 1;
+    } else {
+        context->overflow = true;
+    }
+}
+
+// One-pass binning kernel: interior splats go straight to their tile, the
+// border band (bounds crossing a tile edge) gets the same circle tests as
+// the two-pass kernels, so the bins come out identical
+static void bin_reuse_kernel(const void* block, u32 first, u32 count, void* user) {
+    const GaussianSplatRender* splats = (const GaussianSplatRender*)block;
+    BinReuseContext* context = (BinReuseContext*)user;
+    
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplatRender* splat = &splats[i];
+        int min_tile_x, max_tile_x, min_tile_y, max_tile_y;
         
-        // Skip if splat is degenerate
-        if (splat->radius <= 0) {
+        if (!splat_tile_bounds(splat, &min_tile_x, &max_tile_x, &min_tile_y, &max_tile_y)) {
             continue;
         }
         
-        // Determine potential tile range using bounding box
-        fixed16_t cx = splat->screen_pos[0];
-        fixed16_t cy = splat->screen_pos[1];
-        fixed16_t radius = splat->radius;
-        
-        int min_tile_x = MAX(0, (fixed_to_int(fixed_sub(cx, radius)) / TILE_SIZE));
-        int max_tile_x = MIN(TILES_X - 1, (fixed_to_int(fixed_add(cx, radius)) / TILE_SIZE));
-        int min_tile_y = MAX(0, (fixed_to_int(fixed_sub(cy, radius)) / TILE_SIZE));
-        int max_tile_y = MIN(TILES_Y - 1, (fixed_to_int(fixed_add(cy, radius)) / TILE_SIZE));
+        if (min_tile_x == max_tile_x && min_tile_y == max_tile_y && splat_inside_tile(splat, min_tile_x, min_tile_y)) {
+            bin_reuse_place(context, min_tile_y * TILES_X + min_tile_x, first + i);
+            continue;
+        }
         
-        // Test overlap with each potential tile
+        context->border_splats++;
         for (int tile_y = min_tile_y; tile_y <= max_tile_y; tile_y++) {
             for (int tile_x = min_tile_x; tile_x <= max_tile_x; tile_x++) {
-                // Use elliptical overlap test for accuracy
-                bool overlaps = splat_overlaps_tile_elliptical(splat, tile_x, tile_y);
-                
-                if (overlaps) {
-                    u32 tile_id = tile_y * TILES_X + tile_x;
-                    u32 count = g_tile_state.tile_splat_counts[tile_id];
-                    
-                    // Expand tile list if needed
-                    if (count >= g_tile_state.tile_list_capacity[tile_id]) {
-                        u32 new_capacity = g_tile_state.tile_list_capacity[tile_id] * 2;
-                        u32* new_list = (u32*)realloc(g_tile_state.tile_splat_lists[tile_id], 
-                                                     new_capacity * sizeof(u32));
-                        if (new_list) {
-                            g_tile_state.tile_splat_lists[tile_id] = new_list;
-                            g_tile_state.tile_list_capacity[tile_id] = new_capacity;
-                        } else {
-                            // Skip this assignment if realloc failed
-                            continue;
-                        }
-                    }
-                    
-                    // Add splat to tile list
-                    g_tile_state.tile_splat_lists[tile_id][count] = splat_idx;
-                    g_tile_state.tile_splat_counts[tile_id]++;
-                    g_tile_state.total_overlaps++;
+                if (splat_overlaps_tile_circular(splat, tile_x, tile_y)) {
+                    bin_reuse_place(context, tile_y * TILES_X + tile_x, first + i);
                 }
             }
         }
     }
+}
+
+// Bin a frame whose camera moved less than the tracking threshold since the
+// last full binning. Per-tile counts barely change between such frames, so
+// the count pass is skipped: each tile reserves the range its last count
+// needed plus headroom, splats that entered view fill the headroom and the
+// ones that left leave it unused. One scatter pass fills the ranges and a
+// compaction makes the bins contiguous again. This saves the count pass,
+// not the scatter: every splat was projected anew, so every one is binned
+// and the cost still follows the visible splat count. Returns false when
+// a tile outgrew its range (or nothing could be allocated); the caller then
+// bins in full.
+static bool assign_splats_to_tiles_one_pass(const GaussianSplatRender* splats, u32 splat_count) {
+    u64 assign_start = get_cpu_cycles();
+    
+    g_tile_state.total_overlaps = 0;
+    g_tile_state.bin_indices = NULL;
+    
+    u32 reserved = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32 last = g_tile_state.layout_counts[tile_id];
+        g_tile_state.tile_bin_start[tile_id] = reserved;
+        g_tile_state.tile_bin_cursor[tile_id] = reserved;
+        reserved += last + (last >> TILE_REUSE_HEADROOM_SHIFT) + TILE_REUSE_HEADROOM_MIN;
+    }
+    g_tile_state.tile_bin_start[MAX_TILES] = reserved;
+    
+    BinReuseContext context = { acquire_bin_buffer(reserved), false, 0 };
+    if (!context.bins) {
+        g_tile_state.assign_cycles += get_cpu_cycles() - assign_start;
+        return false;
+    }
+    
+    dma_spr_stream(splats, sizeof(GaussianSplatRender), NULL, splat_count, bin_reuse_kernel, &context);
+    
+    if (context.overflow) {
+        g_tile_state.one_pass_fallbacks++;
+        g_tile_state.assign_cycles += get_cpu_cycles() - assign_start;
+        return false;
+    }
+    
+    // Close the headroom gaps: tile ranges move down in order
+    u32 total = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32 start = g_tile_state.tile_bin_start[tile_id];
+        u32 count = g_tile_state.tile_bin_cursor[tile_id] - start;
+        if (count > 0 && start != total) {
+            memmove(&context.bins[total], &context.bins[start], count * sizeof(u32));
+        }
+        g_tile_state.tile_bin_start[tile_id] = total;
+        g_tile_state.tile_splat_counts[tile_id] = count;
+        total += count;
+    }
+    g_tile_state.tile_bin_start[MAX_TILES] = total;
     
+    g_tile_state.bin_indices = context.bins;
+    g_tile_state.total_overlaps = total;
+    memcpy(g_tile_state.layout_counts, g_tile_state.tile_splat_counts, MAX_TILES * sizeof(u32));
+    g_tile_state.border_splats = context.border_splats;
+    g_tile_state.one_pass_frames++;
     g_tile_state.assign_cycles += get_cpu_cycles() - assign_start;
+    return true;
 }
 
-// Bucket sort splats by depth within each tile
-void sort_splats_by_depth(const GaussianSplat2D* splats, fixed16_t near_depth, fixed16_t far_depth) {
+// Bin sub-threshold camera motion in one pass over the last bin layout
+void tile_set_layout_reuse(bool enable) {
+    g_tile_state.layout_reuse = enable;
+    g_tile_state.layout_valid = false;
+}
+
+void tile_get_binning_stats(u32* one_pass_frames, u32* fallbacks, u32* border_splats) {
+    if (one_pass_frames) *one_pass_frames = g_tile_state.one_pass_frames;
+    if (fallbacks) *fallbacks = g_tile_state.one_pass_fallbacks;
+    if (border_splats) *border_splats = g_tile_state.border_splats;
+}
+
+// Grow the overlap buffers when a frame produces more overlaps than fit.
+// Only happens when a view is denser than anything seen before.
+static bool ensure_overlap_capacity(u32 required) {
+    if (required <= g_tile_state.overlap_capacity) {
+        return true;
+    }
+    
+    // Past this the byte sizes would wrap; the caller reports the frame
+    if (required > SORT_CAPACITY_MAX) {
+        return false;
+    }
+    
+    u32 new_capacity = MIN(required + required / 2, SORT_CAPACITY_MAX);
+    u32** buffers[4] = {
+        &g_tile_state.overlap_keys, &g_tile_state.overlap_values,
+        &g_tile_state.overlap_keys_alt, &g_tile_state.overlap_values_alt
+    };
+    
+    for (int i = 0; i < 4; i++) {
+        u32* grown = (u32*)realloc(*buffers[i], new_capacity * sizeof(u32));
+        if (!grown) {
+            return false;
+        }
+        *buffers[i] = grown;
+    }
+    
+    g_tile_state.overlap_capacity = new_capacity;
+    printf("SPLATSTORM X: Tile sort buffers grown to %u overlaps\n", new_capacity);
+    return true;
+}
+
+// LSD radix sort of key/value pairs, 8 bits per pass
+// All histograms are built in one read pass; passes whose digit is the same
+// for every key are skipped. Result ends up in overlap_keys/overlap_values.
+static void radix_sort_overlaps(u32 count) {
+    u32* histograms = g_tile_state.radix_histograms;
+    memset(histograms, 0, RADIX_PASSES * RADIX_BUCKETS * sizeof(u32));
+    
+    u32* keys = g_tile_state.overlap_keys;
+    for (u32 i = 0; i < count; i++) {
+        u32 key = keys[i];
+        histograms[0 * RADIX_BUCKETS + (key & 0xFF)]++;
+        histograms[1 * RADIX_BUCKETS + ((key >> 8) & 0xFF)]++;
+        histograms[2 * RADIX_BUCKETS + ((key >> 16) & 0xFF)]++;
+        histograms[3 * RADIX_BUCKETS + (key >> 24)]++;
+    }
+    
+    u32* src_keys = g_tile_state.overlap_keys;
+    u32* src_values = g_tile_state.overlap_values;
+    u32* dst_keys = g_tile_state.overlap_keys_alt;
+    u32* dst_values = g_tile_state.overlap_values_alt;
+    
+    for (u32 pass = 0; pass < RADIX_PASSES; pass++) {
+        u32* histogram = &histograms[pass * RADIX_BUCKETS];
+        u32 shift = pass * RADIX_BITS;
+        
+        // Every key shares this digit: order is already correct
+        if (histogram[(src_keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        
+        // Exclusive prefix sum turns counts into scatter offsets
+        u32 offset = 0;
+        for (u32 b = 0; b < RADIX_BUCKETS; b++) {
+            u32 bucket_count = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_count;
+        }
+        
+        for (u32 i = 0; i < count; i++) {
+            u32 key = src_keys[i];
+            u32 dst = histogram[(key >> shift) & 0xFF]++;
+            dst_keys[dst] = key;
+            dst_values[dst] = src_values[i];
+        }
+        
+        // Swap roles for the next pass
+        u32* tmp = src_keys; src_keys = dst_keys; dst_keys = tmp;
+        tmp = src_values; src_values = dst_values; dst_values = tmp;
+    }
+    
+    // Keep the canonical pointers on the sorted data
+    g_tile_state.overlap_keys_alt = dst_keys;
+    g_tile_state.overlap_values_alt = dst_values;
+    g_tile_state.overlap_keys = src_keys;
+    g_tile_state.overlap_values = src_values;
+}
+
+// Low bits of a splat's sort key: its depth, or with texture ordering its
+// depth bucket and footprint cell
+static inline u32 tile_depth_key(const GaussianSplatRender* splat) {
+    if (g_tile_state.texture_order) {
+        return (((splat->depth >> TILE_KEY_BUCKET_SHIFT) & TILE_KEY_BUCKET_MASK) << TILE_KEY_ATLAS_BITS) |
+               ((splat->atlas_level & 0x3) << 6) | (splat->atlas_index & 0x3F);
+    }
+    return (splat->depth >> TILE_KEY_DEPTH_SHIFT) & TILE_KEY_DEPTH_MASK;
+}
+
+// Sort key kernel: one key per overlap, splats gathered in bin order.
+// Bin position first + i belongs to the tile whose range holds it.
+static void sort_key_kernel(const void* block, u32 first, u32 count, void* user) {
+    const GaussianSplatRender* splats = (const GaussianSplatRender*)block;
+    u32* tile_id = (u32*)user;
+    
+    for (u32 i = 0; i < count; i++) {
+        u32 position = first + i;
+        while (position >= g_tile_state.tile_bin_start[*tile_id + 1]) {
+            (*tile_id)++;
+        }
+        
+        // Back-to-front: smaller Z (farther) sorts first
+        g_tile_state.overlap_keys[position] = (*tile_id << TILE_KEY_DEPTH_BITS) | tile_depth_key(&splats[i]);
+        g_tile_state.overlap_values[position] = g_tile_state.bin_indices[position];
+    }
+}
+
+// Sort all splat-tile overlaps with one global radix sort
+// Emits one (tile_id | depth) key per binned overlap, sorts, and writes the
+// order back into the bin buffer. Tiles keep their bin ranges. Z24 is already
+// a fixed range, so no per-frame depth normalization is needed.
+void sort_splats_by_depth(const GaussianSplatRender* splats) {
     u64 sort_start = get_cpu_cycles();
     
-    // Process each tile independently
-    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
-        u32 splat_count = g_tile_state.tile_splat_counts[tile_id];
-        if (splat_count == 0) continue;
+    u32 total = g_tile_state.total_overlaps;
+    g_tile_state.overlap_count = 0;
+    
+    if (total == 0 || !g_tile_state.bin_indices) {
+        g_tile_state.sort_cycles += get_cpu_cycles() - sort_start;
+        return;
+    }
+    
+    if (!ensure_overlap_capacity(total)) {
+        // Bins stay complete, just unsorted within each tile
+        printf("SPLATSTORM X: Tile sort buffers exhausted (%u overlaps)\n", total);
+        g_tile_state.sort_cycles += get_cpu_cycles() - sort_start;
+        return;
+    }
+    
+    // Emit keys in bin order: the bin buffer doubles as the gather list
+    u32 tile_id = 0;
+    dma_spr_stream(splats, sizeof(GaussianSplatRender), g_tile_state.bin_indices, total,
+                   sort_key_kernel, &tile_id);
+    
+    radix_sort_overlaps(total);
+    g_tile_state.overlap_count = total;
+    
+    // Tile id is the top of the key, so each tile's sorted run lands exactly
+    // on its bin range; copy the order back so the bins are render-ready
+    memcpy(g_tile_state.bin_indices, g_tile_state.overlap_values, total * sizeof(u32));
+    
+    g_tile_state.sort_cycles += get_cpu_cycles() - sort_start;
+}
+
+// Front-to-back saturation early-out for one tile's back-to-front bin.
+// Walking from the nearest splat, each splat darkens the transmittance of
+// the blocks its footprint covers completely, using the footprint alpha at
+// the block's farthest corner. A splat whose blocks are all below epsilon
+// is dropped. The estimate never undercounts transmittance, so only hidden
+// splats go. Survivors keep their order and the standard blend.
+// Returns the surviving count, packed at the start of the bin; covered is
+// set when every block ends below epsilon, so the background cannot show,
+// and occluder_depth to the Z24 of the splat that made it so (0 if none).
+// Without drop_hidden the walk only measures: the bin is left untouched.
+static u32 saturation_cull_tile(const GaussianSplatRender* splats, u32* bin, u32 count, u32 tile_x, u32 tile_y,
+                                bool drop_hidden, bool* covered, u32* occluder_depth) {
+    u16 transmittance[SATURATION_BLOCKS];
+    for (u32 b = 0; b < SATURATION_BLOCKS; b++) {
+        transmittance[b] = SATURATION_ONE;
+    }
+    
+    const s32 block_units = 1 << (SATURATION_BLOCK_SHIFT + RENDER_SPLAT_SUBPIXEL_SHIFT);
+    const s32 tile_left = (s32)(tile_x * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    const s32 tile_top = (s32)(tile_y * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    u32 epsilon = g_tile_state.saturation_epsilon;
+    u32 saturated = 0;
+    u32 write = count;
+    *occluder_depth = 0;
+    
+    for (u32 i = count; i-- > 0;) {
+        const GaussianSplatRender* splat = &splats[bin[i]];
+        s32 cx = splat->screen_x - tile_left;
+        s32 cy = splat->screen_y - tile_top;
+        s32 radius = splat->radius;
         
-        u32* splat_list = g_tile_state.tile_splat_lists[tile_id];
+        // Blocks the sprite touches, clamped to the tile
+        s32 bx0 = CLAMP((cx - radius) >> (SATURATION_BLOCK_SHIFT + RENDER_SPLAT_SUBPIXEL_SHIFT), 0, SATURATION_BLOCKS_X - 1);
+        s32 bx1 = CLAMP((cx + radius) >> (SATURATION_BLOCK_SHIFT + RENDER_SPLAT_SUBPIXEL_SHIFT), 0, SATURATION_BLOCKS_X - 1);
+        s32 by0 = CLAMP((cy - radius) >> (SATURATION_BLOCK_SHIFT + RENDER_SPLAT_SUBPIXEL_SHIFT), 0, SATURATION_BLOCKS_X - 1);
+        s32 by1 = CLAMP((cy + radius) >> (SATURATION_BLOCK_SHIFT + RENDER_SPLAT_SUBPIXEL_SHIFT), 0, SATURATION_BLOCKS_X - 1);
         
-        // For small lists, use insertion sort
-        if (splat_count <= 32) {
-            for (u32 i = 1; i < splat_count; i++) {
-                u32 key_splat = splat_list[i];
-                fixed16_t key_depth = splats[key_splat].depth;
-                int j = i - 1;
-                
-                // Sort back-to-front (larger depth first)
-                while (j >= 0 && splats[splat_list[j]].depth < key_depth) {
-                    splat_list[j + 1] = splat_list[j];
-                    j--;
+        bool visible = false;
+        for (s32 by = by0; by <= by1 && !visible; by++) {
+            for (s32 bx = bx0; bx <= bx1; bx++) {
+                if (transmittance[by * SATURATION_BLOCKS_X + bx] >= epsilon) {
+                    visible = true;
+                    break;
                 }
-                splat_list[j + 1] = key_splat;
             }
-        } else {
-            // Use bucket sort for larger lists
-            memset(g_tile_state.bucket_counts, 0, NUM_DEPTH_BUCKETS * sizeof(u32));
-            
-            // Count splats per bucket
-            fixed16_t depth_range = fixed_sub(far_depth, near_depth);
-            if (depth_range <= 0) depth_range = FIXED16_SCALE;  // Avoid division by zero
-            
-            for (u32 i = 0; i < splat_count; i++) {
-                fixed16_t depth = splats[splat_list[i]].depth;
-                fixed16_t norm_depth = fixed_mul(fixed_sub(depth, near_depth), 
-                                               fixed_recip_newton(depth_range));
-                
-                // Clamp to [0, 1] and map to bucket
-                if (norm_depth < 0) norm_depth = 0;
-                if (norm_depth >= FIXED16_SCALE) norm_depth = FIXED16_SCALE - 1;
-                
-                u32 bucket = fixed_to_int(fixed_mul(norm_depth, 
-                                                   fixed_from_int(NUM_DEPTH_BUCKETS - 1)));
-                bucket = CLAMP(bucket, 0, NUM_DEPTH_BUCKETS - 1);
+        }
+        if (!visible && drop_hidden) {
+            continue;
+        }
+        if (drop_hidden) {
+            bin[--write] = bin[i];
+        }
+        
+        // Only the opaque core counts: minor axis of the footprint, Q0.8 opacity
+        u64 core = ((u64)radius * g_saturation_minor_axis[(splat->atlas_index >> 3) & 7]) >> 8;
+        u64 core_sq = core * core;
+        u32 opacity = MIN((u32)splat->color[3] * 2, SATURATION_ONE);
+        if (core_sq == 0 || opacity == 0) {
+            continue;
+        }
+        
+        for (s32 by = by0; by <= by1; by++) {
+            s32 y0 = by * block_units - cy;
+            s32 dy = MAX(abs(y0), abs(y0 + block_units));
+            for (s32 bx = bx0; bx <= bx1; bx++) {
+                s32 x0 = bx * block_units - cx;
+                s32 dx = MAX(abs(x0), abs(x0 + block_units));
+                u64 d_sq = (u64)dx * dx + (u64)dy * dy;
+                if (d_sq > core_sq) {
+                    continue;  // Block not fully inside the footprint core
+                }
                 
-                g_tile_state.bucket_counts[bucket]++;
+                // Round the falloff step up: alpha is never overestimated
+                u32 step = (u32)((d_sq * SATURATION_FALLOFF_STEPS + core_sq - 1) / core_sq);
+                u32 alpha = (opacity * g_saturation_falloff[step]) >> 8;
+                u16* t = &transmittance[by * SATURATION_BLOCKS_X + bx];
+                if (*t >= epsilon) {
+                    *t = (u16)((*t * (SATURATION_ONE - alpha)) >> 8);
+                    if (*t < epsilon) {
+                        saturated++;
+                    }
+                }
             }
-            
-            // Compute bucket offsets (back-to-front order)
-            u32 offset = 0;
-            for (int b = NUM_DEPTH_BUCKETS - 1; b >= 0; b--) {
-                g_tile_state.bucket_offsets[b] = offset;
-                offset += g_tile_state.bucket_counts[b];
+        }
+        
+        // Tile fully opaque: everything farther is hidden
+        if (saturated == SATURATION_BLOCKS) {
+            *occluder_depth = splat->depth;
+            break;
+        }
+    }
+    
+    *covered = (saturated == SATURATION_BLOCKS);
+    if (!drop_hidden) {
+        return count;
+    }
+    
+    u32 kept = count - write;
+    memmove(bin, &bin[write], kept * sizeof(u32));
+    return kept;
+}
+
+// Reduce the tile occluder depths: a cell is opaque in front of the
+// farthest depth of its (up to four) children, a missing child has none
+static void occlusion_build_pyramid(void) {
+    for (u32 level = 1; level < OCCLUSION_LEVELS; level++) {
+        const u32* below = &g_tile_state.occluder_depth[g_tile_state.occlusion_offset[level - 1]];
+        u32* cells = &g_tile_state.occluder_depth[g_tile_state.occlusion_offset[level]];
+        u32 below_width = g_tile_state.occlusion_width[level - 1];
+        u32 below_height = g_tile_state.occlusion_height[level - 1];
+        
+        for (u32 y = 0; y < g_tile_state.occlusion_height[level]; y++) {
+            for (u32 x = 0; x < g_tile_state.occlusion_width[level]; x++) {
+                u32 x0 = x * 2, y0 = y * 2;
+                u32 depth = below[y0 * below_width + x0];
+                depth = (x0 + 1 < below_width) ? MIN(depth, below[y0 * below_width + x0 + 1]) : 0;
+                depth = (y0 + 1 < below_height) ? MIN(depth, below[(y0 + 1) * below_width + x0]) : 0;
+                depth = (x0 + 1 < below_width && y0 + 1 < below_height) ?
+                        MIN(depth, below[(y0 + 1) * below_width + x0 + 1]) : 0;
+                cells[y * g_tile_state.occlusion_width[level] + x] = depth;
             }
-            
-            // Distribute splats to buckets
-            u32* temp_list = (u32*)malloc(splat_count * sizeof(u32));
-            if (temp_list) {
-                for (u32 i = 0; i < splat_count; i++) {
-                    u32 splat_idx = splat_list[i];
-                    fixed16_t depth = splats[splat_idx].depth;
-                    fixed16_t norm_depth = fixed_mul(fixed_sub(depth, near_depth), 
-                                                   fixed_recip_newton(depth_range));
-                    
-                    if (norm_depth < 0) norm_depth = 0;
-                    if (norm_depth >= FIXED16_SCALE) norm_depth = FIXED16_SCALE - 1;
-                    
-                    u32 bucket = fixed_to_int(fixed_mul(norm_depth, 
-                                                       fixed_from_int(NUM_DEPTH_BUCKETS - 1)));
-                    bucket = CLAMP(bucket, 0, NUM_DEPTH_BUCKETS - 1);
-                    
-                    temp_list[g_tile_state.bucket_offsets[bucket]++] = splat_idx;
-                }
-                
-                // Copy back sorted list
-                memcpy(splat_list, temp_list, splat_count * sizeof(u32));
-                free(temp_list);
+        }
+    }
+}
+
+// Build an occlusion pyramid from each rendered frame for the next frame's culling
+void tile_set_occlusion_culling(bool enable) {
+    g_tile_state.occlusion_culling = enable;
+    g_tile_state.occlusion_valid = false;
+}
+
+bool tile_occlusion_available(void) {
+    return g_tile_state.initialized && g_tile_state.occlusion_culling && g_tile_state.occlusion_valid;
+}
+
+// Whether last frame's coverage hides a box whose projection spans the NDC
+// rectangle (y up) and whose nearest point has Z24 depth nearest_depth.
+// The rectangle grows by OCCLUSION_GUARD_TILES and is tested on the level
+// where it covers at most 2x2 cells; hidden only if every one of them was
+// opaque in front of the box.
+bool tile_occlusion_test(float ndc_min_x, float ndc_min_y, float ndc_max_x, float ndc_max_y, u32 nearest_depth) {
+    if (!tile_occlusion_available()) {
+        return false;
+    }
+    g_tile_state.occlusion_queries++;
+    
+    float half_w = g_tile_state.render_width * 0.5f;
+    float half_h = g_tile_state.render_height * 0.5f;
+    s32 x0 = (s32)floorf((ndc_min_x + 1.0f) * half_w) >> TILE_SIZE_SHIFT;
+    s32 x1 = (s32)floorf((ndc_max_x + 1.0f) * half_w) >> TILE_SIZE_SHIFT;
+    s32 y0 = (s32)floorf((1.0f - ndc_max_y) * half_h) >> TILE_SIZE_SHIFT;
+    s32 y1 = (s32)floorf((1.0f - ndc_min_y) * half_h) >> TILE_SIZE_SHIFT;
+    
+    // Off-screen parts are the frustum's business; the rest must be hidden
+    x0 = MAX(x0 - OCCLUSION_GUARD_TILES, 0);
+    y0 = MAX(y0 - OCCLUSION_GUARD_TILES, 0);
+    x1 = MIN(x1 + OCCLUSION_GUARD_TILES, (s32)g_tile_state.tiles_x - 1);
+    y1 = MIN(y1 + OCCLUSION_GUARD_TILES, (s32)g_tile_state.tiles_y - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+    
+    u32 level = 0;
+    while (level + 1 < OCCLUSION_LEVELS && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        level++;
+    }
+    
+    const u32* cells = &g_tile_state.occluder_depth[g_tile_state.occlusion_offset[level]];
+    u32 width = g_tile_state.occlusion_width[level];
+    for (s32 y = y0 >> level; y <= (y1 >> level); y++) {
+        for (s32 x = x0 >> level; x <= (x1 >> level); x++) {
+            if (cells[y * width + x] <= nearest_depth) {
+                return false;
             }
         }
     }
     
-    g_tile_state.sort_cycles += get_cpu_cycles() - sort_start;
+    g_tile_state.occlusion_hits++;
+    return true;
+}
+
+void tile_get_occlusion_stats(u32* queries, u32* hidden) {
+    if (queries) *queries = g_tile_state.occlusion_queries;
+    if (hidden) *hidden = g_tile_state.occlusion_hits;
+}
+
+// Enable the front-to-back saturation early-out; epsilon is the block
+// transmittance (0-1) below which a block counts as opaque
+void tile_set_saturation_cull(bool enable, float epsilon) {
+    g_tile_state.saturation_cull = enable;
+    g_tile_state.saturation_epsilon = (u16)CLAMP((s32)(epsilon * SATURATION_ONE + 0.5f), 1, SATURATION_ONE);
+}
+
+bool tile_get_saturation_cull(void) {
+    return g_tile_state.saturation_cull;
+}
+
+float tile_get_saturation_epsilon(void) {
+    return (float)g_tile_state.saturation_epsilon / SATURATION_ONE;
 }
 
-// Load balancing: redistribute splats from overloaded tiles
+// Load balancing over the binned tiles, after saturation culling.
+// Splats are never moved to neighbouring tiles: the bins are one packed
+// buffer, and a splat moved to a tile it does not overlap lost its coverage.
+// Instead the render regions adapt: tiles above TILE_HOT_SPLATS are planned
+// as 8x8 sub-tiles, and coarse tiles whose tiles draw TILE_SPARSE_SPLATS or
+// fewer in total as one region.
 void perform_load_balancing(void) {
     // Calculate average splats per tile
     u32 total_assignments = 0;
     u32 active_tiles = 0;
     
+    memset(g_tile_state.tile_plan, TILE_PLAN_ROW, MAX_TILES * sizeof(u8));
+    g_tile_state.hot_tiles = 0;
+    g_tile_state.sparse_blocks = 0;
+    
+    for (u32 i = 0; i < MAX_TILES; i++) {
+        if (g_tile_state.tile_splat_counts[i] > TILE_HOT_SPLATS) {
+            g_tile_state.tile_plan[i] = TILE_PLAN_SPLIT;
+            g_tile_state.hot_tiles++;
+        }
+    }
+    
+    // Sparse coarse tiles: at least two drawn tiles, few overlaps in all
+    for (u32 coarse_y = 0; coarse_y * COARSE_TILE_SPAN < g_tile_state.tiles_y; coarse_y++) {
+        for (u32 coarse_x = 0; coarse_x * COARSE_TILE_SPAN < g_tile_state.tiles_x; coarse_x++) {
+            u32 x0 = coarse_x * COARSE_TILE_SPAN, x1 = MIN(x0 + COARSE_TILE_SPAN, g_tile_state.tiles_x);
+            u32 y0 = coarse_y * COARSE_TILE_SPAN, y1 = MIN(y0 + COARSE_TILE_SPAN, g_tile_state.tiles_y);
+            u32 overlaps = 0, drawn = 0;
+            for (u32 y = y0; y < y1; y++) {
+                for (u32 x = x0; x < x1; x++) {
+                    u32 count = g_tile_state.tile_splat_counts[y * TILES_X + x];
+                    overlaps += count;
+                    drawn += (count > 0);
+                }
+            }
+            if (drawn < 2 || overlaps > TILE_SPARSE_SPLATS) {
+                continue;
+            }
+            
+            for (u32 y = y0; y < y1; y++) {
+                memset(&g_tile_state.tile_plan[y * TILES_X + x0], TILE_PLAN_COARSE, x1 - x0);
+            }
+            g_tile_state.sparse_blocks++;
+        }
+    }
+    
     for (u32 i = 0; i < MAX_TILES; i++) {
         if (g_tile_state.tile_splat_counts[i] > 0) {
             total_assignments += g_tile_state.tile_splat_counts[i];
@@ -469,64 +1195,6 @@ void perform_load_balancing(void) {
     if (active_tiles == 0) return;
     
     g_tile_state.average_splats_per_tile = (float)total_assignments / active_tiles;
-    u32 target_max = (u32)(g_tile_state.average_splats_per_tile * 2.0f);  // 2x average as threshold
-    
-    // Find overloaded tiles and redistribute
-    u32 redistributed = 0;
-    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
-        u32 count = g_tile_state.tile_splat_counts[tile_id];
-        if (count > target_max) {
-            // Try to move excess splats to neighboring tiles
-            u32 tile_x = tile_id % TILES_X;
-            u32 tile_y = tile_id / TILES_X;
-            
-            // Check 4-connected neighbors
-            int neighbors[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-            
-            for (int n = 0; n < 4 && count > target_max; n++) {
-                int nx = tile_x + neighbors[n][0];
-                int ny = tile_y + neighbors[n][1];
-                
-                if (nx >= 0 && nx < TILES_X && ny >= 0 && ny < TILES_Y) {
-                    u32 neighbor_id = ny * TILES_X + nx;
-                    u32 neighbor_count = g_tile_state.tile_splat_counts[neighbor_id];
-                    
-                    if (neighbor_count < target_max) {
-                        // Move some splats to neighbor
-                        u32 move_count = MIN(count - target_max, target_max - neighbor_count);
-                        
-                        // Ensure neighbor has capacity
-                        if (neighbor_count + move_count > g_tile_state.tile_list_capacity[neighbor_id]) {
-                            u32 new_capacity = neighbor_count + move_count + 32;  // Add some buffer
-                            u32* new_list = (u32*)realloc(g_tile_state.tile_splat_lists[neighbor_id], 
-                                                         new_capacity * sizeof(u32));
-                            if (new_list) {
-                                g_tile_state.tile_splat_lists[neighbor_id] = new_list;
-                                g_tile_state.tile_list_capacity[neighbor_id] = new_capacity;
-                            } else {
-                                continue;  // Skip if realloc failed
-                            }
-                        }
-                        
-                        // Move splats (take from end of list)
-                        u32* src_list = g_tile_state.tile_splat_lists[tile_id];
-                        u32* dst_list = g_tile_state.tile_splat_lists[neighbor_id];
-                        
-                        for (u32 i = 0; i < move_count; i++) {
-                            dst_list[neighbor_count + i] = src_list[count - move_count + i];
-                        }
-                        
-                        // Update counts
-                        g_tile_state.tile_splat_counts[tile_id] -= move_count;
-                        g_tile_state.tile_splat_counts[neighbor_id] += move_count;
-                        
-                        count -= move_count;
-                        redistributed += move_count;
-                    }
-                }
-            }
-        }
-    }
     
     // Calculate load balance factor
     u32 max_count = 0, min_count = UINT32_MAX;
@@ -540,15 +1208,259 @@ void perform_load_balancing(void) {
     if (max_count > 0) {
         g_tile_state.load_balance_factor = (float)min_count / max_count;
     }
+}
+
+// Group splats of equal depth bucket by footprint cell. The buckets are
+// 4096 Z24 steps wide, below visible blending precision.
+void tile_set_texture_order(bool enable) {
+    g_tile_state.texture_order = enable;
+}
+
+bool tile_get_texture_order(void) {
+    return g_tile_state.texture_order;
+}
+
+// Select the LOD radius threshold for a quality level (0-3, 3 = finest)
+void tile_set_lod_quality(u32 quality_level) {
+    g_tile_state.lod_radius_threshold = g_lod_radius_threshold[MIN(quality_level, LOD_QUALITY_LEVELS - 1)];
+}
+
+// Cell and depth slice a sub-pixel splat aggregates into
+static inline u32 lod_cell_key(const GaussianSplatRender* splat) {
+    u32 cell_x = (u32)((s32)splat->screen_x >> (RENDER_SPLAT_SUBPIXEL_SHIFT + LOD_CELL_SHIFT)) & 0x7FF;
+    u32 cell_y = (u32)((s32)splat->screen_y >> (RENDER_SPLAT_SUBPIXEL_SHIFT + LOD_CELL_SHIFT)) & 0x7FF;
+    return (cell_y << 19) | (cell_x << 8) | ((splat->depth >> LOD_DEPTH_SLICE_SHIFT) & 0xFF);
+}
+
+static void lod_accumulate(LODAggregate* aggregate, const GaussianSplatRender* splat) {
+    float alpha = MIN(splat->color[3], 0x80) * (1.0f / 128.0f);
+    float weight = alpha * (float)splat->radius * (float)splat->radius + 1.0f;
+    
+    aggregate->weight += weight;
+    aggregate->position[0] += weight * splat->screen_x;
+    aggregate->position[1] += weight * splat->screen_y;
+    aggregate->color[0] += weight * splat->color[0];
+    aggregate->color[1] += weight * splat->color[1];
+    aggregate->color[2] += weight * splat->color[2];
+    aggregate->transmittance *= 1.0f - alpha;
+    aggregate->depth = MAX(aggregate->depth, splat->depth);
+    aggregate->members++;
+}
+
+// The aggregate as one round splat: weighted centroid and color, the
+// members' combined opacity, and a radius that deposits the same alpha * area
+static void lod_resolve(const LODAggregate* aggregate, GaussianSplatRender* splat) {
+    float inv_weight = 1.0f / aggregate->weight;
+    float alpha = 1.0f - aggregate->transmittance;
+    float radius = sqrtf((aggregate->weight - aggregate->members) / MAX(alpha, 1.0f / 128.0f));
+    float max_radius = (float)(g_tile_state.lod_radius_threshold + (1 << (RENDER_SPLAT_SUBPIXEL_SHIFT + LOD_CELL_SHIFT)));
+    
+    splat->screen_x = (s16)(aggregate->position[0] * inv_weight);
+    splat->screen_y = (s16)(aggregate->position[1] * inv_weight);
+    splat->radius = (u16)CLAMP(radius, 1.0f, max_radius);
+    splat->depth = aggregate->depth;
+    splat->color[0] = (u8)(aggregate->color[0] * inv_weight);
+    splat->color[1] = (u8)(aggregate->color[1] * inv_weight);
+    splat->color[2] = (u8)(aggregate->color[2] * inv_weight);
+    splat->color[3] = (u8)CLAMP((s32)(alpha * 128.0f + 0.5f), 1, 0x80);
+    splat->atlas_index = 0;                   // Aspect row 0: round footprint
+    splat->atlas_level = (u8)footprint_atlas_level((splat->radius * 2 + 15) >> RENDER_SPLAT_SUBPIXEL_SHIFT);
+}
+
+// Screen-space LOD: fold sub-pixel splats that land in the same pixel cell
+// and depth slice into one aggregate, compacting the array in place.
+// Cells lie inside one tile, so each aggregate replaces its members in
+// exactly the tile they were binned to. Returns the new splat count; on
+// allocation failure nothing is merged.
+u32 tile_lod_aggregate(GaussianSplatRender* splats, u32 splat_count) {
+    g_tile_state.lod_input_splats = splat_count;
+    g_tile_state.lod_output_splats = splat_count;
+    if (!splats || splat_count == 0 || g_tile_state.lod_radius_threshold == 0) {
+        return splat_count;
+    }
+    
+    u32 max_aggregates = MIN(splat_count, LOD_MAX_AGGREGATES);
+    u16* table = (u16*)frame_arena_alloc(LOD_TABLE_SIZE * sizeof(u16), CACHE_LINE_SIZE);
+    LODAggregate* aggregates = (LODAggregate*)frame_arena_alloc(max_aggregates * sizeof(LODAggregate),
+                                                                CACHE_LINE_SIZE);
+    if (!table || !aggregates) {
+        return splat_count;
+    }
+    memset(table, 0, LOD_TABLE_SIZE * sizeof(u16));
+    
+    // Output never passes input, so compaction overwrites only splats already read
+    u32 aggregate_count = 0;
+    u32 output = 0;
+    for (u32 i = 0; i < splat_count; i++) {
+        const GaussianSplatRender splat = splats[i];
+        if (splat.radius == 0) {
+            continue;  // Degenerate, never binned
+        }
+        
+        if (splat.radius >= g_tile_state.lod_radius_threshold) {
+            splats[output++] = splat;
+            continue;
+        }
+        
+        // Linear probe for the splat's cell; slots hold aggregate index + 1
+        u32 key = lod_cell_key(&splat);
+        u32 slot = (key * 2654435761u) >> (32 - LOD_TABLE_BITS);
+        while (table[slot] && aggregates[table[slot] - 1].key != key) {
+            slot = (slot + 1) & (LOD_TABLE_SIZE - 1);
+        }
+        
+        if (table[slot]) {
+            lod_accumulate(&aggregates[table[slot] - 1], &splat);
+            continue;
+        }
+        
+        // First splat in the cell keeps its place and stands in for the aggregate
+        if (aggregate_count < max_aggregates) {
+            LODAggregate* aggregate = &aggregates[aggregate_count];
+            memset(aggregate, 0, sizeof(LODAggregate));
+            aggregate->key = key;
+            aggregate->output = output;
+            aggregate->transmittance = 1.0f;
+            lod_accumulate(aggregate, &splat);
+            table[slot] = (u16)++aggregate_count;
+        }
+        splats[output++] = splat;
+    }
     
-    if (redistributed > 0) {
-        printf("SPLATSTORM X: Load balancing redistributed %u splat assignments\n", redistributed);
+    // Single-member aggregates are the original splat and stay untouched
+    for (u32 a = 0; a < aggregate_count; a++) {
+        if (aggregates[a].members > 1) {
+            lod_resolve(&aggregates[a], &splats[aggregates[a].output]);
+        }
     }
+    
+    g_tile_state.lod_output_splats = output;
+    return output;
 }
 
 // Main tile processing function
+// projected_splats holds GaussianSplatRender entries, as written by vu_process_batch.
+// ============================================================================
+// Tile heatmap (debug): one value per tile, drawn by gs_render_heatmap()
+// ============================================================================
+
+void tile_set_heatmap_mode(u32 mode) {
+    g_tile_state.heatmap_mode = (mode < TILE_HEATMAP_MODES) ? mode : TILE_HEATMAP_OFF;
+    if (g_tile_state.tile_heat) {
+        memset(g_tile_state.tile_heat, 0, MAX_TILES * sizeof(u32));
+    }
+}
+
+u32 tile_get_heatmap_mode(void) {
+    return g_tile_state.heatmap_mode;
+}
+
+const char* tile_heatmap_mode_name(u32 mode) {
+    static const char* const names[TILE_HEATMAP_MODES] = {"off", "splats", "fill", "cycles"};
+    return (mode < TILE_HEATMAP_MODES) ? names[mode] : "unknown";
+}
+
+// Sprite area inside one tile in 12.4 units squared, clamped as
+// gs_build_splat_sprites() clamps it to the screen
+static inline u32 heatmap_sprite_fill(const GaussianSplatRender* splat, s32 tile_x0, s32 tile_y0) {
+    const s32 tile_extent = TILE_SIZE << RENDER_SPLAT_SUBPIXEL_SHIFT;
+    s32 x1 = MAX((s32)splat->screen_x - splat->radius, tile_x0);
+    s32 y1 = MAX((s32)splat->screen_y - splat->radius, tile_y0);
+    s32 x2 = MIN((s32)splat->screen_x + splat->radius, tile_x0 + tile_extent);
+    s32 y2 = MIN((s32)splat->screen_y + splat->radius, tile_y0 + tile_extent);
+    return (x2 > x1 && y2 > y1) ? (u32)(x2 - x1) * (u32)(y2 - y1) : 0;
+}
+
+// Splat and fill values from the bins the frame draws. Cycles are only
+// known as the sprites go out: tile_heatmap_add_cycles() fills them in.
+static void heatmap_build(const GaussianSplatRender* splats) {
+    u32* heat = g_tile_state.tile_heat;
+    memset(heat, 0, MAX_TILES * sizeof(u32));
+    if (g_tile_state.heatmap_mode == TILE_HEATMAP_CYCLES) return;
+    
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32 count = g_tile_state.tile_splat_counts[tile_id];
+        if (count == 0 || g_tile_state.heatmap_mode == TILE_HEATMAP_SPLATS) {
+            heat[tile_id] = count;
+            continue;
+        }
+        
+        s32 tile_x0 = (s32)((tile_id % TILES_X) * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+        s32 tile_y0 = (s32)((tile_id / TILES_X) * TILE_SIZE) << RENDER_SPLAT_SUBPIXEL_SHIFT;
+        const u32* bin = &g_tile_state.bin_indices[g_tile_state.tile_bin_start[tile_id]];
+        u64 area = 0;
+        for (u32 i = 0; i < count; i++) {
+            area += heatmap_sprite_fill(&splats[bin[i]], tile_x0, tile_y0);
+        }
+        heat[tile_id] = (u32)(area >> (2 * RENDER_SPLAT_SUBPIXEL_SHIFT));
+    }
+}
+
+// Submission cycles of one scissor rectangle (pixels), shared evenly by
+// the tiles it covers: a region's sprites are not timed tile by tile
+void tile_heatmap_add_cycles(u32 x, u32 y, u32 width, u32 height, u32 cycles) {
+    if (g_tile_state.heatmap_mode != TILE_HEATMAP_CYCLES || width == 0 || height == 0) return;
+    
+    u32 tile_x1 = MIN(x >> TILE_SIZE_SHIFT, g_tile_state.tiles_x - 1);
+    u32 tile_y1 = MIN(y >> TILE_SIZE_SHIFT, g_tile_state.tiles_y - 1);
+    u32 tile_x2 = MIN((x + width - 1) >> TILE_SIZE_SHIFT, g_tile_state.tiles_x - 1);
+    u32 tile_y2 = MIN((y + height - 1) >> TILE_SIZE_SHIFT, g_tile_state.tiles_y - 1);
+    u32 share = cycles / ((tile_x2 - tile_x1 + 1) * (tile_y2 - tile_y1 + 1));
+    
+    for (u32 tile_y = tile_y1; tile_y <= tile_y2; tile_y++) {
+        for (u32 tile_x = tile_x1; tile_x <= tile_x2; tile_x++) {
+            g_tile_state.tile_heat[tile_y * TILES_X + tile_x] += share;
+        }
+    }
+}
+
+// This frame's values over the active grid (TILES_X stride), or NULL when
+// the heatmap is off
+const u32* tile_get_heatmap(u32* tiles_x, u32* tiles_y, u32* max_value) {
+    if (!g_tile_state.initialized || g_tile_state.heatmap_mode == TILE_HEATMAP_OFF) return NULL;
+    
+    u32 max_heat = 0;
+    for (u32 tile_y = 0; tile_y < g_tile_state.tiles_y; tile_y++) {
+        for (u32 tile_x = 0; tile_x < g_tile_state.tiles_x; tile_x++) {
+            max_heat = MAX(max_heat, g_tile_state.tile_heat[tile_y * TILES_X + tile_x]);
+        }
+    }
+    if (tiles_x) *tiles_x = g_tile_state.tiles_x;
+    if (tiles_y) *tiles_y = g_tile_state.tiles_y;
+    if (max_value) *max_value = max_heat;
+    return g_tile_state.tile_heat;
+}
+
+// Up to max_tiles hottest tiles, hottest first. Returns how many
+u32 tile_heatmap_hottest(u32* tile_ids, u32* values, u32 max_tiles) {
+    if (!g_tile_state.initialized || g_tile_state.heatmap_mode == TILE_HEATMAP_OFF || !tile_ids || !values ||
+        max_tiles == 0) {
+        return 0;
+    }
+    
+    u32 found = 0;
+    for (u32 tile_y = 0; tile_y < g_tile_state.tiles_y; tile_y++) {
+        for (u32 tile_x = 0; tile_x < g_tile_state.tiles_x; tile_x++) {
+            u32 tile_id = tile_y * TILES_X + tile_x;
+            u32 value = g_tile_state.tile_heat[tile_id];
+            if (value == 0 || (found == max_tiles && value <= values[found - 1])) continue;
+            
+            // Insert into the sorted list, dropping the coolest when full
+            u32 slot = (found < max_tiles) ? found++ : found - 1;
+            while (slot > 0 && values[slot - 1] < value) {
+                tile_ids[slot] = tile_ids[slot - 1];
+                values[slot] = values[slot - 1];
+                slot--;
+            }
+            tile_ids[slot] = tile_id;
+            values[slot] = value;
+        }
+    }
+    return found;
+}
+
 int process_tiles(void* projected_splats, u32 projected_count, void* camera, void* tile_ranges) {
-    const GaussianSplat2D* splats = (const GaussianSplat2D*)projected_splats;
+    const GaussianSplatRender* splats = (const GaussianSplatRender*)projected_splats;
     u32 splat_count = projected_count;
     const CameraFixed* cam = (const CameraFixed*)camera;
     TileRange* ranges = (TileRange*)tile_ranges;
@@ -578,38 +1490,71 @@ int process_tiles(void* projected_splats, u32 projected_count, void* camera, voi
     perform_coarse_tile_culling(splats, splat_count);
     g_tile_state.cull_cycles += get_cpu_cycles() - cull_start;
     
-    // Assign splats to fine tiles
-    assign_splats_to_tiles(splats, splat_count);
-    
-    // Sort splats within each tile by depth
-    if (g_tile_state.needs_full_sort) {
-        // Find depth range for bucket sort
-        fixed16_t min_depth = FIXED16_MAX, max_depth = FIXED16_MIN;
-        for (u32 i = 0; i < splat_count; i++) {
-            fixed16_t depth = splats[i].depth;
-            if (depth < min_depth) min_depth = depth;
-            if (depth > max_depth) max_depth = depth;
+    // Bin splats into fine tiles: one pass over the last layout while the
+    // camera stays under the tracking threshold, two passes otherwise
+    bool reuse_layout = g_tile_state.layout_reuse && g_tile_state.layout_valid &&
+                        !g_tile_state.needs_full_sort;
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_BIN);
+    if (!reuse_layout || !assign_splats_to_tiles_one_pass(splats, splat_count)) {
+        if (!assign_splats_to_tiles(splats, splat_count)) {
+            g_tile_state.layout_valid = false;
+            return -1;
         }
-        
-        sort_splats_by_depth(splats, min_depth, max_depth);
-        g_tile_state.needs_full_sort = false;
+    }
+    PROFILE_ZONE_END(PROFILE_ZONE_BIN);
+    
+    // Sort every overlap by (tile, depth). Bins are rebuilt each frame, so
+    // the sort runs every frame; its cost is linear in the overlap count.
+    PROFILE_ZONE_BEGIN(PROFILE_ZONE_SORT);
+    sort_splats_by_depth(splats);
+    PROFILE_ZONE_END(PROFILE_ZONE_SORT);
+    g_tile_state.needs_full_sort = false;
+    
+    // Saturation early-out needs depth-ordered bins; skipped if the sort fell
+    // back. The occlusion pyramid takes the same walk, measuring only.
+    g_tile_state.saturation_culled = 0;
+    g_tile_state.covered_tiles = 0;
+    memset(g_tile_state.tile_covered, 0, MAX_TILES * sizeof(u8));
+    bool sorted = g_tile_state.overlap_count == g_tile_state.total_overlaps;
+    if ((g_tile_state.saturation_cull || g_tile_state.occlusion_culling) && sorted) {
+        u32* occluders = g_tile_state.occluder_depth;  // Level 0: the tile grid
+        memset(occluders, 0, MAX_TILES * sizeof(u32));
+        for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+            u32 count = g_tile_state.tile_splat_counts[tile_id];
+            if (count == 0) continue;
+            
+            u32* bin = &g_tile_state.bin_indices[g_tile_state.tile_bin_start[tile_id]];
+            bool covered;
+            u32 kept = saturation_cull_tile(splats, bin, count, tile_id % TILES_X, tile_id / TILES_X,
+                                            g_tile_state.saturation_cull, &covered, &occluders[tile_id]);
+            g_tile_state.tile_splat_counts[tile_id] = kept;
+            g_tile_state.saturation_culled += count - kept;
+            g_tile_state.tile_covered[tile_id] = covered;
+            g_tile_state.covered_tiles += covered;
+        }
+    }
+    if (g_tile_state.occlusion_culling) {
+        if (sorted) {
+            occlusion_build_pyramid();
+        }
+        g_tile_state.occlusion_valid = sorted;
     }
     
-    // Perform load balancing
+    // Load balancing and the region plan, on the counts that get drawn
     perform_load_balancing();
     
-    // Build tile ranges for rendering
+    // Build tile ranges for rendering: real ranges in the bin buffer
     for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
-        ranges[tile_id].start_index = 0;  // Will be set by renderer
+        ranges[tile_id].start_index = g_tile_state.tile_bin_start[tile_id];
         ranges[tile_id].count = g_tile_state.tile_splat_counts[tile_id];
         
         // Compute depth bounds for this tile
         if (ranges[tile_id].count > 0) {
-            u32* splat_list = g_tile_state.tile_splat_lists[tile_id];
+            const u32* splat_list = &g_tile_state.bin_indices[g_tile_state.tile_bin_start[tile_id]];
             fixed16_t min_depth = FIXED16_MAX, max_depth = FIXED16_MIN;
             
             for (u32 i = 0; i < ranges[tile_id].count; i++) {
-                fixed16_t depth = splats[splat_list[i]].depth;
+                fixed16_t depth = (fixed16_t)splats[splat_list[i]].depth;
                 if (depth < min_depth) min_depth = depth;
                 if (depth > max_depth) max_depth = depth;
             }
@@ -624,16 +1569,229 @@ int process_tiles(void* projected_splats, u32 projected_count, void* camera, voi
         }
     }
     
+    if (g_tile_state.heatmap_mode != TILE_HEATMAP_OFF) {
+        heatmap_build(splats);
+    }
+    
     // Update performance statistics
     u64 total_frame_cycles = get_cpu_cycles() - frame_start;
     
-    printf("SPLATSTORM X: Tile processing complete - %u splats, %u overlaps, %.1f avg/tile, %.2f balance\n",
-           splat_count, g_tile_state.total_overlaps, g_tile_state.average_splats_per_tile, 
-           g_tile_state.load_balance_factor);
+    printf("SPLATSTORM X: Tile processing complete - %u splats, %u overlaps (%u saturated, %u tiles covered), %.1f avg/tile, %.2f balance\n",
+           splat_count, g_tile_state.total_overlaps, g_tile_state.saturation_culled, g_tile_state.covered_tiles,
+           g_tile_state.average_splats_per_tile, g_tile_state.load_balance_factor);
     
     return 0;
 }
 
+// Grow the region stamps when a frame projects more splats than tile_system_init
+// was sized for, as the overlap buffers do. New stamps start at 0, which no
+// region uses.
+static bool ensure_region_stamp_capacity(u32 splat_count) {
+    if (splat_count <= g_tile_state.max_splats) {
+        return true;
+    }
+    
+    u32 new_capacity = splat_count + splat_count / 2;
+    u32* grown = (u32*)realloc(g_tile_state.region_stamp, new_capacity * sizeof(u32));
+    if (!grown) {
+        return false;
+    }
+    memset(grown + g_tile_state.max_splats, 0, (new_capacity - g_tile_state.max_splats) * sizeof(u32));
+    
+    g_tile_state.region_stamp = grown;
+    g_tile_state.max_splats = new_capacity;
+    printf("SPLATSTORM X: Region stamps grown to %u splats\n", new_capacity);
+    return true;
+}
+
+// Fresh stamp for one region; on wrap every old stamp is forgotten
+static u32 region_next_stamp(void) {
+    u32 stamp = ++g_tile_state.region_stamp_clock;
+    if (stamp == 0) {
+        memset(g_tile_state.region_stamp, 0, g_tile_state.max_splats * sizeof(u32));
+        stamp = ++g_tile_state.region_stamp_clock;
+    }
+    return stamp;
+}
+
+// Append a tile's bin to the region being built, once per splat. With
+// sub_x >= 0 only splats whose bounds touch that 8x8 sub-tile (in sub-tile
+// units) are taken. Returns the new entry count.
+static u32 region_append_tile(const GaussianSplatRender* splats, u32 tile_id, u32 region_id, u32 stamp,
+                              u32 entries, s32 sub_x, s32 sub_y) {
+    const int shift = RENDER_SPLAT_SUBPIXEL_SHIFT + TILE_SUB_SHIFT;
+    const u32* bin = &g_tile_state.bin_indices[g_tile_state.tile_bin_start[tile_id]];
+    
+    for (u32 i = 0; i < g_tile_state.tile_splat_counts[tile_id]; i++) {
+        u32 index = bin[i];
+        if (g_tile_state.region_stamp[index] == stamp) continue;
+        
+        const GaussianSplatRender* splat = &splats[index];
+        if (sub_x >= 0 &&
+            (((s32)splat->screen_x - (s32)splat->radius) >> shift > sub_x ||
+             ((s32)splat->screen_x + (s32)splat->radius) >> shift < sub_x ||
+             ((s32)splat->screen_y - (s32)splat->radius) >> shift > sub_y ||
+             ((s32)splat->screen_y + (s32)splat->radius) >> shift < sub_y)) {
+            continue;
+        }
+        g_tile_state.region_stamp[index] = stamp;
+        
+        g_tile_state.overlap_keys[entries] = (region_id << TILE_KEY_DEPTH_BITS) | tile_depth_key(splat);
+        g_tile_state.overlap_values[entries] = index;
+        entries++;
+    }
+    return entries;
+}
+
+static inline void region_set(TileRegion* region, u32 x, u32 y, u32 width, u32 height, u32 start, u32 entries) {
+    region->x = (u16)x;
+    region->y = (u16)y;
+    region->width = (u16)width;
+    region->height = (u16)height;
+    region->start_index = start;
+    region->count = entries - start;
+}
+
+// Build the render regions from the plan perform_load_balancing() made.
+// Sparse coarse tiles become one 64x64 region, hot tiles a region per
+// non-empty 8x8 sub-tile, and every other run of non-empty tiles in a tile
+// row one region. Sort keys order splats globally, so the union of adjacent
+// bins sorted by the same key draws every pixel in its tile order; a splat
+// present in several tiles of a region is emitted once. Regions reuse the
+// overlap sort buffers with the region id on top of the key. Needs sorted
+// bins. Returns the region count, or 0 to render per tile instead.
+u32 tile_build_render_regions(const GaussianSplatRender* splats, u32 splat_count,
+                              TileRegion* regions, u32 max_regions) {
+    g_tile_state.region_entries = 0;
+    g_tile_state.split_regions = 0;
+    g_tile_state.merged_regions = 0;
+    if (!g_tile_state.initialized || !splats || !regions || !g_tile_state.bin_indices ||
+        g_tile_state.total_overlaps == 0 || g_tile_state.overlap_count != g_tile_state.total_overlaps ||
+        !ensure_region_stamp_capacity(splat_count)) {
+        return 0;
+    }
+    
+    u64 sort_start = get_cpu_cycles();
+    max_regions = MIN(max_regions, 1u << (32 - TILE_KEY_DEPTH_BITS));
+    u32 region_count = 0;
+    u32 entries = 0;
+    
+    // Entries still to come if every remaining tile is drawn whole; a split
+    // may only take what leaves room for them in the overlap buffers
+    u32 pending = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        pending += g_tile_state.tile_splat_counts[tile_id];
+    }
+    
+    // Sparse coarse tiles, one region each
+    for (u32 coarse_y = 0; coarse_y * COARSE_TILE_SPAN < g_tile_state.tiles_y; coarse_y++) {
+        for (u32 coarse_x = 0; coarse_x * COARSE_TILE_SPAN < g_tile_state.tiles_x; coarse_x++) {
+            u32 x0 = coarse_x * COARSE_TILE_SPAN, x1 = MIN(x0 + COARSE_TILE_SPAN, g_tile_state.tiles_x);
+            u32 y0 = coarse_y * COARSE_TILE_SPAN, y1 = MIN(y0 + COARSE_TILE_SPAN, g_tile_state.tiles_y);
+            if (g_tile_state.tile_plan[y0 * TILES_X + x0] != TILE_PLAN_COARSE) continue;
+            
+            if (region_count == max_regions) {
+                return 0;
+            }
+            
+            u32 stamp = region_next_stamp();
+            u32 region_start = entries;
+            for (u32 y = y0; y < y1; y++) {
+                for (u32 x = x0; x < x1; x++) {
+                    pending -= g_tile_state.tile_splat_counts[y * TILES_X + x];
+                    entries = region_append_tile(splats, y * TILES_X + x, region_count, stamp, entries, -1, -1);
+                }
+            }
+            region_set(&regions[region_count++], x0 * TILE_SIZE, y0 * TILE_SIZE, (x1 - x0) * TILE_SIZE,
+                       (y1 - y0) * TILE_SIZE, region_start, entries);
+            g_tile_state.merged_regions++;
+        }
+    }
+    
+    // Hot tiles, a region per sub-tile. A splat can land in all four, so
+    // a split that would run out of regions or entries draws the tile whole.
+    const u32 subs = 1 << (TILE_SIZE_SHIFT - TILE_SUB_SHIFT);
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        if (g_tile_state.tile_plan[tile_id] != TILE_PLAN_SPLIT) continue;
+        
+        u32 count = g_tile_state.tile_splat_counts[tile_id];
+        if (region_count + subs * subs > max_regions ||
+            entries + count * subs * subs + (pending - count) > g_tile_state.overlap_capacity) {
+            g_tile_state.tile_plan[tile_id] = TILE_PLAN_ROW;
+            continue;
+        }
+        pending -= count;
+        
+        u32 tile_x = tile_id % TILES_X;
+        u32 tile_y = tile_id / TILES_X;
+        for (u32 sy = 0; sy < subs; sy++) {
+            for (u32 sx = 0; sx < subs; sx++) {
+                u32 region_start = entries;
+                s32 sub_x = (s32)(tile_x * subs + sx);
+                s32 sub_y = (s32)(tile_y * subs + sy);
+                entries = region_append_tile(splats, tile_id, region_count, region_next_stamp(), entries,
+                                             sub_x, sub_y);
+                if (entries == region_start) continue;
+                
+                region_set(&regions[region_count++], (u32)sub_x << TILE_SUB_SHIFT, (u32)sub_y << TILE_SUB_SHIFT,
+                           1 << TILE_SUB_SHIFT, 1 << TILE_SUB_SHIFT, region_start, entries);
+                g_tile_state.split_regions++;
+            }
+        }
+    }
+    
+    // Runs of the remaining non-empty tiles in each tile row
+    for (u32 tile_y = 0; tile_y < g_tile_state.tiles_y; tile_y++) {
+        u32 tile_x = 0;
+        while (tile_x < g_tile_state.tiles_x) {
+            u32 tile_id = tile_y * TILES_X + tile_x;
+            if (g_tile_state.tile_splat_counts[tile_id] == 0 || g_tile_state.tile_plan[tile_id] != TILE_PLAN_ROW) {
+                tile_x++;
+                continue;
+            }
+            
+            if (region_count == max_regions) {
+                return 0;
+            }
+            
+            u32 stamp = region_next_stamp();
+            u32 first_x = tile_x;
+            u32 region_start = entries;
+            for (; tile_x < g_tile_state.tiles_x && g_tile_state.tile_splat_counts[tile_id] > 0 &&
+                   g_tile_state.tile_plan[tile_id] == TILE_PLAN_ROW; tile_x++, tile_id++) {
+                entries = region_append_tile(splats, tile_id, region_count, stamp, entries, -1, -1);
+            }
+            
+            region_set(&regions[region_count++], first_x * TILE_SIZE, tile_y * TILE_SIZE,
+                       (tile_x - first_x) * TILE_SIZE, TILE_SIZE, region_start, entries);
+        }
+    }
+    
+    // Region id is the top of the key, so every region's run stays in place
+    radix_sort_overlaps(entries);
+    g_tile_state.region_entries = entries;
+    
+    g_tile_state.sort_cycles += get_cpu_cycles() - sort_start;
+    return region_count;
+}
+
+void tile_get_region_stats(u32* hot_tiles, u32* split_regions, u32* sparse_blocks, u32* merged_regions) {
+    if (hot_tiles) *hot_tiles = g_tile_state.hot_tiles;
+    if (split_regions) *split_regions = g_tile_state.split_regions;
+    if (sparse_blocks) *sparse_blocks = g_tile_state.sparse_blocks;
+    if (merged_regions) *merged_regions = g_tile_state.merged_regions;
+}
+
+// Back-to-front splat indices of the last region build, by region start_index
+const u32* tile_get_region_indices(void) {
+    return g_tile_state.overlap_values;
+}
+
+// Tile left opaque by this frame's splats (saturation early-out only)
+bool tile_is_covered(u32 tile_id) {
+    return g_tile_state.initialized && tile_id < MAX_TILES && g_tile_state.tile_covered[tile_id];
+}
+
 // Get tile splat list for rendering
 const u32* get_tile_splat_list(u32 tile_id, u32* count) {
     if (!g_tile_state.initialized || tile_id >= MAX_TILES) {
@@ -641,8 +1799,14 @@ const u32* get_tile_splat_list(u32 tile_id, u32* count) {
         return NULL;
     }
     
+    if (!g_tile_state.bin_indices) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    
+    // Sorted back-to-front slice of the bin buffer
     if (count) *count = g_tile_state.tile_splat_counts[tile_id];
-    return g_tile_state.tile_splat_lists[tile_id];
+    return &g_tile_state.bin_indices[g_tile_state.tile_bin_start[tile_id]];
 }
 
 // Get performance statistics
@@ -672,19 +1836,18 @@ void tile_system_cleanup(void) {
     
     printf("SPLATSTORM X: Cleaning up tile rasterization system...\n");
     
-    // Free tile lists
-    if (g_tile_state.tile_splat_lists) {
-        for (u32 i = 0; i < MAX_TILES; i++) {
-            if (g_tile_state.tile_splat_lists[i]) {
-                free(g_tile_state.tile_splat_lists[i]);
-            }
-        }
-        free(g_tile_state.tile_splat_lists);
-    }
+    // Free tile bins (arena bins belong to the frame pool)
+    if (g_tile_state.tile_splat_counts) free(g_tile_state.tile_splat_counts);
+    if (g_tile_state.tile_bin_start) free(g_tile_state.tile_bin_start);
+    if (g_tile_state.tile_bin_cursor) free(g_tile_state.tile_bin_cursor);
+    if (g_tile_state.tile_covered) free(g_tile_state.tile_covered);
+    if (g_tile_state.tile_plan) free(g_tile_state.tile_plan);
+    if (g_tile_state.layout_counts) free(g_tile_state.layout_counts);
+    if (g_tile_state.tile_heat) free(g_tile_state.tile_heat);
+    if (g_tile_state.occluder_depth) free(g_tile_state.occluder_depth);
+    if (g_tile_state.bin_fallback) free(g_tile_state.bin_fallback);
     
     // Free other arrays
-    if (g_tile_state.tile_splat_counts) free(g_tile_state.tile_splat_counts);
-    if (g_tile_state.tile_list_capacity) free(g_tile_state.tile_list_capacity);
     if (g_tile_state.coarse_tile_counts) free(g_tile_state.coarse_tile_counts);
     if (g_tile_state.coarse_tile_bounds) free(g_tile_state.coarse_tile_bounds);
     if (g_tile_state.sort_keys) free(g_tile_state.sort_keys);
@@ -692,6 +1855,12 @@ void tile_system_cleanup(void) {
     if (g_tile_state.bucket_counts) free(g_tile_state.bucket_counts);
     if (g_tile_state.bucket_offsets) free(g_tile_state.bucket_offsets);
     if (g_tile_state.moved_splat_indices) free(g_tile_state.moved_splat_indices);
+    if (g_tile_state.overlap_keys) free(g_tile_state.overlap_keys);
+    if (g_tile_state.overlap_values) free(g_tile_state.overlap_values);
+    if (g_tile_state.overlap_keys_alt) free(g_tile_state.overlap_keys_alt);
+    if (g_tile_state.overlap_values_alt) free(g_tile_state.overlap_values_alt);
+    if (g_tile_state.radix_histograms) free(g_tile_state.radix_histograms);
+    if (g_tile_state.region_stamp) free(g_tile_state.region_stamp);
     
     // Clear state
     memset(&g_tile_state, 0, sizeof(TileSystemState));
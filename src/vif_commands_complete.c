@@ -759,7 +759,7 @@ static void vif_ensure_initialized(void) {
     // Initialize packet buffer
     g_vif_buffer.buffer_size = 1024 * 1024; // 1MB buffer
     g_vif_buffer.max_packet_size = 64 * 1024; // 64KB max packet
-    g_vif_buffer.packet_buffer = memalign(128, g_vif_buffer.buffer_size);
+    g_vif_buffer.packet_buffer = memory_alloc(MEMORY_BUDGET_DMA, g_vif_buffer.buffer_size, 128);
     if (g_vif_buffer.packet_buffer) {
         memset(g_vif_buffer.packet_buffer, 0, g_vif_buffer.buffer_size);
         g_vif_buffer.buffer_allocated = true;
@@ -812,9 +812,12 @@ static int vif_send_packet_to_vu(void* packet, u32 size, int vu_unit) {
         printf("VIF ERROR: DMA send failed - channel=%d, result=%d\n", channel, result);
         return result;
     }
+    dma_account_transfer(channel, qwc * 16);
     
     // Wait for completion
+    u64 wait_start = get_cpu_cycles();
     result = dma_channel_wait(channel, 1000); // 1 second timeout
+    dma_account_wait(channel, (u32)(get_cpu_cycles() - wait_start));
     if (result != 0) {
         printf("VIF ERROR: DMA wait failed - channel=%d, result=%d\n", channel, result);
         return result;
@@ -860,7 +863,7 @@ void vif_print_status(void) {
 // Cleanup VIF system
 void vif_cleanup(void) {
     if (g_vif_buffer.buffer_allocated && g_vif_buffer.packet_buffer) {
-        free(g_vif_buffer.packet_buffer);
+        memory_free(g_vif_buffer.packet_buffer);
         g_vif_buffer.packet_buffer = NULL;
         g_vif_buffer.buffer_allocated = false;
     }
@@ -142,6 +142,7 @@ void splatstorm_vu1_upload_microcode(u32* start, u32* end) {
     // Send packet to VIF1
     splatstorm_vif_send_packet(p_store, DMA_CHANNEL_VIF1);
     splatstorm_vif_destroy_packet(p_store);
+    vu_microcode_invalidate(VU_UNIT_VU1);  // Overwrote whatever the manager placed at 0
     
     debug_log_info("VIF DMA: VU1 microcode upload complete");
 }
@@ -188,6 +189,7 @@ void splatstorm_vu0_upload_microcode(u32* start, u32* end) {
     // Send packet to VIF0 (note: VU0 uses different channel)
     splatstorm_vif_send_packet(p_store, DMA_CHANNEL_VIF0);
     splatstorm_vif_destroy_packet(p_store);
+    vu_microcode_invalidate(VU_UNIT_VU0);
     
     debug_log_info("VIF DMA: VU0 microcode upload complete (%d instructions)", count);
 }
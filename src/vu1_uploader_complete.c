@@ -122,6 +122,7 @@ static int upload_vu1_microcode_lowlevel(void *microcode_start, size_t microcode
         return result;
     }
 
+    vu_microcode_invalidate(VU_UNIT_VU1);  // Code memory changed outside the microcode manager
     printf("VU1 UPLOADER: Microcode upload completed successfully\n");
     return 0;
 }
@@ -222,7 +223,7 @@ static int upload_test_splat_data(void)
         
         // SH coefficients (simple)
         for (int j = 0; j < 16; j++) {
-            test_splats[i].sh_coeffs[j] = 32768; // Neutral
+            test_splats[i].sh_coeffs[j] = 0; // Neutral
         }
         
         test_splats[i].importance = 1000;
@@ -0,0 +1,179 @@
+/*
+ * SPLATSTORM X - VU Activity Sampler
+ * Measures what VU0, VU1 and their VIFs actually do, independent of the
+ * EE code driving them. The EE-side figures (vu_utilization, time spent
+ * in dma_wait_channel) count a wait as VU work whether the unit was
+ * running, the VIF still unpacking or the DMA still in flight.
+ *
+ * EE timer 1 interrupts at a fixed rate; each interrupt reads VPU-STAT
+ * (COP2 vi29) and VIF0_STAT/VIF1_STAT and charges the time since the
+ * previous sample to the state it finds:
+ * - VU0/VU1 busy time, run count and idle gaps between the frame's runs
+ * - VU1 XGKICK stalls on a busy GIF (VPU-STAT VGW1)
+ * - VIF stalls: MSCAL/FLUSHE held for a running program (VEW), VIF1
+ *   waiting for the GIF (VGW), VIF stopped by an interrupt bit or STOP
+ *
+ * Intervals resolve to one sample period (62.5 us at the default rate):
+ * two runs closer than that read as one and shorter runs may be missed,
+ * which the busy fractions average out over a frame. VIF1 interrupt
+ * stalls include the end interrupt of vu_system_complete.c, which stops
+ * VIF1 until its handler releases it.
+ */
+
+#include "splatstorm_x.h"
+#include "gaussian_types.h"
+#include <tamtypes.h>
+#include <kernel.h>
+#include <string.h>
+#include <stdio.h>
+
+// EE timer 1
+#define VU_ACTIVITY_T1_COUNT     ((volatile u32*)0x10000800)
+#define VU_ACTIVITY_T1_MODE      ((volatile u32*)0x10000810)
+#define VU_ACTIVITY_T1_COMP      ((volatile u32*)0x10000820)
+#define T_MODE_CLKS_BUS16        0x001        // Bus clock / 16: 9.216 MHz
+#define T_MODE_ZRET              0x040        // Count restarts at the compare value
+#define T_MODE_CUE               0x080        // Count enable
+#define T_MODE_CMPE              0x100        // Interrupt on compare
+#define T_MODE_EQUF              0x400        // Compare flag, written 1 to clear
+#define VU_ACTIVITY_TIMER_HZ     9216000
+#define VU_ACTIVITY_T1_RUN       (T_MODE_CLKS_BUS16 | T_MODE_ZRET | T_MODE_CUE | T_MODE_CMPE)
+
+// Status registers
+#define VU_ACTIVITY_VIF0_STAT    ((volatile u32*)0x10003800)
+#define VU_ACTIVITY_VIF1_STAT    ((volatile u32*)0x10003C00)
+#define VPU_STAT_VBS0            0x0001       // VU0 running
+#define VPU_STAT_VBS1            0x0100       // VU1 running
+#define VPU_STAT_VGW1            0x1000       // VU1 XGKICK waiting for the GIF
+#define VIF_STAT_VEW             0x0004       // Waiting for the VU program to end
+#define VIF_STAT_VGW             0x0008       // Waiting for the GIF (VIF1)
+#define VIF_STAT_STOPPED         0x0700       // VSS, VFS, VIS
+
+static struct {
+    bool running;
+    s32 handler;                              // INTC_TIM1 handler id
+    u32 sample_hz;
+
+    // Touched by the interrupt only, but for the swap in end_frame
+    VUActivityStats frame;                    // Being sampled
+    u32 last_sample;                          // COP0 Count of the previous sample
+    bool busy[2];                             // State at the previous sample
+    u32 idle_since[2];                        // Count at the last running-to-idle edge
+
+    VUActivityStats last_frame;               // Complete, for readers
+} g_vu_activity = {false, -1, 0};
+
+// COP0 Count is read directly: get_cpu_cycles() keeps its high word in
+// statics the interrupted thread may be updating. 32-bit deltas wrap
+// after 14 s, far beyond one sample period.
+static int vu_activity_sample(int cause) {
+    (void)cause;
+    u32 now, vpu_stat;
+    __asm__ volatile("mfc0 %0, $9" : "=r"(now));
+    __asm__ volatile("cfc2 %0, $vi29" : "=r"(vpu_stat));
+    u32 vif_stat[2] = {*VU_ACTIVITY_VIF0_STAT, *VU_ACTIVITY_VIF1_STAT};
+    *VU_ACTIVITY_T1_MODE = VU_ACTIVITY_T1_RUN | T_MODE_EQUF;
+
+    VUActivityStats* frame = &g_vu_activity.frame;
+    u32 elapsed = now - g_vu_activity.last_sample;
+    g_vu_activity.last_sample = now;
+    frame->samples++;
+    frame->sampled_cycles += elapsed;
+
+    for (u32 unit = VU_UNIT_VU0; unit <= VU_UNIT_VU1; unit++) {
+        bool busy = (vpu_stat & (unit == VU_UNIT_VU0 ? VPU_STAT_VBS0 : VPU_STAT_VBS1)) != 0;
+        if (busy) {
+            frame->busy_cycles[unit] += elapsed;
+            if (!g_vu_activity.busy[unit] && frame->runs[unit]++ > 0) {
+                u32 gap = now - g_vu_activity.idle_since[unit];
+                frame->gap_cycles[unit] += gap;
+                frame->max_gap_cycles[unit] = MAX(frame->max_gap_cycles[unit], gap);
+            }
+        } else if (g_vu_activity.busy[unit]) {
+            g_vu_activity.idle_since[unit] = now;
+        }
+        g_vu_activity.busy[unit] = busy;
+
+        if (vif_stat[unit] & VIF_STAT_VEW) frame->vif_vu_wait_cycles[unit] += elapsed;
+        if (vif_stat[unit] & VIF_STAT_STOPPED) frame->vif_stop_cycles[unit] += elapsed;
+    }
+    if (vpu_stat & VPU_STAT_VGW1) frame->xgkick_wait_cycles += elapsed;
+    if (vif_stat[1] & VIF_STAT_VGW) frame->vif_gif_wait_cycles += elapsed;
+
+    ExitHandler();
+    return 0;
+}
+
+// Start sampling at sample_hz, clamped to VU_ACTIVITY_MAX_HZ
+GaussianResult vu_activity_start(u32 sample_hz) {
+    if (g_vu_activity.running) {
+        return GAUSSIAN_SUCCESS;
+    }
+    if (sample_hz == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    sample_hz = MIN(sample_hz, VU_ACTIVITY_MAX_HZ);
+
+    memset(&g_vu_activity.frame, 0, sizeof(g_vu_activity.frame));
+    memset(&g_vu_activity.last_frame, 0, sizeof(g_vu_activity.last_frame));
+    g_vu_activity.busy[0] = g_vu_activity.busy[1] = false;
+    __asm__ volatile("mfc0 %0, $9" : "=r"(g_vu_activity.last_sample));
+
+    *VU_ACTIVITY_T1_MODE = 0;
+    *VU_ACTIVITY_T1_COUNT = 0;
+    *VU_ACTIVITY_T1_COMP = VU_ACTIVITY_TIMER_HZ / sample_hz;
+    g_vu_activity.handler = AddIntcHandler(INTC_TIM1, vu_activity_sample, 0);
+    if (g_vu_activity.handler < 0) {
+        printf("SPLATSTORM X: Timer 1 interrupt unavailable, VU activity not sampled\n");
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+    EnableIntc(INTC_TIM1);
+    *VU_ACTIVITY_T1_MODE = VU_ACTIVITY_T1_RUN | T_MODE_EQUF;
+
+    g_vu_activity.sample_hz = sample_hz;
+    g_vu_activity.running = true;
+    printf("SPLATSTORM X: VU activity sampled at %u Hz\n", sample_hz);
+    return GAUSSIAN_SUCCESS;
+}
+
+void vu_activity_stop(void) {
+    if (!g_vu_activity.running) {
+        return;
+    }
+    *VU_ACTIVITY_T1_MODE = 0;
+    DisableIntc(INTC_TIM1);
+    RemoveIntcHandler(INTC_TIM1, g_vu_activity.handler);
+    g_vu_activity.handler = -1;
+    g_vu_activity.running = false;
+}
+
+bool vu_activity_running(void) {
+    return g_vu_activity.running;
+}
+
+// Close the frame's samples; call once per frame with the other frame stats
+void vu_activity_end_frame(void) {
+    if (!g_vu_activity.running) {
+        return;
+    }
+    DIntr();
+    g_vu_activity.last_frame = g_vu_activity.frame;
+    memset(&g_vu_activity.frame, 0, sizeof(g_vu_activity.frame));
+    EIntr();
+}
+
+// Activity of the last complete frame; zero while the sampler is off
+void vu_activity_get_stats(VUActivityStats* stats) {
+    if (stats) {
+        *stats = g_vu_activity.last_frame;
+    }
+}
+
+// Share of the last frame the unit spent running a microprogram, 0-1
+float vu_activity_busy_fraction(u32 vu_unit) {
+    const VUActivityStats* stats = &g_vu_activity.last_frame;
+    if (vu_unit > VU_UNIT_VU1 || stats->sampled_cycles == 0) {
+        return 0.0f;
+    }
+    return (float)stats->busy_cycles[vu_unit] / (float)stats->sampled_cycles;
+}
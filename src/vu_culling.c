@@ -1,6 +1,7 @@
 /*
  * SPLATSTORM X - Complete VU Culling Implementation
  * High-performance frustum culling using VU0/VU1 microcode
+ * VU0 runs vu0_cull.vu in micro mode over double-buffered VIF0 batches
  * Full implementation with proper PS2SDK integration
  */
 
@@ -20,17 +21,26 @@
 #include <vif_registers.h>
 #include <stdlib.h>
 #include <string.h>
+#include <malloc.h>
 
 // ============================================================================
 // VU Memory Layout and Constants
 // ============================================================================
 
-// VU0 Memory Layout (4KB instruction + 4KB data)
+// VU0 Memory Layout (4KB instruction + 4KB data = 256 qwords)
+// Two input/result buffer pairs: VIF0 unpacks batch N+1 into one while the
+// microprogram culls batch N out of the other (see vu/vu0_cull.vu).
 #define VU0_CODE_START      0x0000      // Microcode start address
-#define VU0_SPLAT_DATA      0x0000      // Splat positions (data memory)
-#define VU0_PLANE_DATA      0x0200      // Frustum planes (data memory)
-#define VU0_RESULT_DATA     0x0300      // Visibility results (data memory)
-#define VU0_MATRIX_DATA     0x0400      // Transformation matrices (data memory)
+#define VU0_PLANE_DATA      0x0000      // Transposed frustum planes + ones (9 qwords)
+#define VU0_PLANE_QWORDS    9
+#define VU0_SPLAT_DATA_A    0x0010      // Input buffer A: header + spheres
+#define VU0_SPLAT_DATA_B    0x0078      // Input buffer B
+#define VU0_RESULT_DATA_A   0x00E0      // Visibility masks for buffer A
+#define VU0_RESULT_DATA_B   0x00F0      // Visibility masks for buffer B
+
+// Per-batch VIF0 packet: STCYCL/UNPACK qword + header + spheres + ITOP/MSCAL qword
+#define VU0_BATCH_PACKET_QWORDS (1 + 1 + VU0_CULL_BATCH_SIZE + 1)
+#define VU0_CULL_TIMEOUT_CYCLES 2949120 // 10ms: give up and let the caller test on the EE
 
 // VU1 Memory Layout (16KB instruction + 16KB data)
 #define VU1_CODE_START      0x0000      // Microcode start address
@@ -39,23 +49,16 @@
 #define VU1_MATRIX_DATA     0x2000      // View/projection matrices (data memory)
 
 // Batch processing limits
-#define VU0_MAX_SPLATS      128         // VU0 culling batch size
+#define VU0_MAX_SPLATS      VU0_CULL_BATCH_SIZE  // VU0 culling batch size
 #define VU1_MAX_SPLATS      256         // VU1 transform batch size
 
 // ============================================================================
 // VU Microcode Data (Placeholder - would be generated from .vu files)
 // ============================================================================
 
-// VU0 Frustum Culling Microcode
-static u32 vu0_cull_microcode[] __attribute__((aligned(128))) = {
-    // Placeholder microcode for frustum culling
-    // In production, this would be assembled from vu0_cull.vu
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,  // NOP
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,  // NOP
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,  // NOP
-    0x00000000, 0x00000000, 0x00000000, 0x00000000,  // NOP
-    0x8000033C, 0x00000000, 0x00000000, 0x00000000   // E bit + NOP (end)
-};
+// VU0 Frustum Culling Microcode (assembled from vu/vu0_cull.vu)
+extern u32 vu0_cull_start[];
+extern u32 vu0_cull_end[];
 
 // VU1 Transformation Microcode
 static u32 vu1_transform_microcode[] __attribute__((aligned(128))) = {
@@ -76,156 +79,326 @@ typedef struct {
     float x, y, z, w;
 } vu_vector4 __attribute__((aligned(16)));
 
-typedef struct {
-    vu_vector4 position;
-    vu_vector4 scale;
-    u32 color_packed;
-    u32 padding[3];
-} vu_splat_data __attribute__((aligned(16)));
+// ============================================================================
+// VU0 Culling Engine
+// ============================================================================
 
+// VU0 culling engine state
 typedef struct {
-    vu_vector4 plane;
-} vu_frustum_plane __attribute__((aligned(16)));
+    bool initialized;                         // Engine initialization flag
+    bool microcode_loaded;                    // vu0_cull microcode in VU0 micro memory
+    u32 microcode_entry;                      // MSCAL address of vu0_cull
+    bool vif0_busy;                           // A VIF0 packet may still be in flight
+    u32* batch_packets[2];                    // EE-side VIF0 packets, one per VU0 buffer
+    u32* plane_packet;                        // VIF0 packet for the plane upload
+    float planes[6][4];                       // Planes resident in VU0 data memory
+    bool planes_valid;                        // planes matches VU0 memory
+    u32 batch_counts[2];                      // Spheres in the batch queued on each buffer
+    u16 batch_sequence[2];                    // Done marker expected for each buffer
+    u16 next_sequence;                        // Sequence for the next submitted batch
+    u32 fill_buffer;                          // Buffer the next batch is built in
+    u32 oldest_buffer;                        // Oldest batch not yet collected
+    u32 in_flight;                            // Submitted, not yet collected (0-2)
+    bool filling;                             // begin_batch handed out fill_buffer
+    
+    // Performance counters
+    u32 total_splats_processed;               // Spheres culled on VU0
+    u32 total_splats_culled;                  // Spheres rejected on VU0
+    u32 batches_processed;                    // Batches collected
+    u64 submit_cycles;                        // EE time spent issuing batches
+    u64 wait_cycles;                          // EE time spent waiting for results
+    u64 active_cycles;                        // Submit-to-collect time of all batches
+    u64 batch_submit_time[2];                 // Submit timestamp per buffer
+} VU0CullState;
+
+static VU0CullState g_vu0_cull = {0};
+
+// VU0 running bit from the COP2 VPU-STAT register (vi29)
+static inline bool is_vu0_busy(void) {
+    u32 vpu_stat;
+    __asm__ volatile("cfc2 %0, $vi29" : "=r"(vpu_stat));
+    return (vpu_stat & 0x1) != 0;
+}
 
-// ============================================================================
-// VU Helper Functions
-// ============================================================================
+// Wait for the last VIF0 packet and the running microprogram
+static void vu0_wait_idle(void) {
+    if (g_vu0_cull.vif0_busy) {
+        dma_wait_channel(DMA_CHANNEL_VIF0);
+        g_vu0_cull.vif0_busy = false;
+    }
+    while (is_vu0_busy()) {
+        __asm__ volatile("nop");
+    }
+}
 
-static int vu0_upload_microcode_safe(u32* microcode, u32 size_bytes) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    if (!microcode || size_bytes == 0) {
+static void vu0_send_packet(const u32* packet, u32 qwords) {
+    // One packet at a time on VIF0; the previous one has normally long drained
+    if (g_vu0_cull.vif0_busy) {
+        dma_wait_channel(DMA_CHANNEL_VIF0);
+    }
+    FlushCache(0);
+    dma_channel_send_normal(DMA_CHANNEL_VIF0, (void*)((u32)packet & 0x0FFFFFFF), qwords, 0, 0);
+    dma_account_transfer(DMA_CHANNEL_VIF0, qwords * 16);
+    g_vu0_cull.vif0_busy = true;
+}
+
+// VU0 code goes through the microcode manager, which places it and records
+// it resident so later uploads of the same program are skipped
+static int vu0_upload_microcode_safe(const u32* microcode, const u32* microcode_end) {
+    if (!microcode || microcode_end <= microcode) {
         debug_log_error("VU0: Invalid microcode parameters");
         return -1;
     }
     
-    // Simplified implementation - in production would use proper VIF packets
-    // For now, just validate parameters and return success
-    debug_log_verbose("VU0: Uploaded %d bytes of microcode", size_bytes);
+    if (vu_microcode_manager_init() != GAUSSIAN_SUCCESS) {
+        debug_log_error("VU0: Microcode manager unavailable");
+        return -1;
+    }
+    
+    // VU0 micro memory is 4KB = 512 instructions; registration rejects larger programs
+    int program = vu_microcode_register(VU_UNIT_VU0, "vu0_cull", microcode, microcode_end);
+    if (program < 0) {
+        debug_log_error("VU0: Microcode too large (%d bytes)", (u32)microcode_end - (u32)microcode);
+        return -1;
+    }
+    
+    vu0_wait_idle();
+    if (vu_microcode_upload((u32)program, &g_vu0_cull.microcode_entry) != GAUSSIAN_SUCCESS) {
+        debug_log_error("VU0: Microcode upload failed");
+        return -1;
+    }
+    
+    debug_log_verbose("VU0: vu0_cull entry at 0x%03X", g_vu0_cull.microcode_entry);
     return 0;
-
 }
 
-static int vu0_upload_data_safe(void* data, u32 size_bytes, u32 dest_addr) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    if (!data || size_bytes == 0) {
-        debug_log_error("VU0: Invalid data parameters");
+// Upload frustum planes: transposed so one FMAC chain tests four planes
+int vu0_cull_engine_set_planes(const float planes[6][4]) {
+    if (!g_vu0_cull.initialized || !planes) {
         return -1;
     }
     
-    // Simplified implementation - in production would use proper VIF packets
-    debug_log_verbose("VU0: Uploaded %d bytes to address 0x%04X", size_bytes, dest_addr);
+    // Camera still: VU0 already holds these planes
+    if (g_vu0_cull.planes_valid && memcmp(g_vu0_cull.planes, planes, sizeof(g_vu0_cull.planes)) == 0) {
+        return 0;
+    }
+    
+    u32* packet = g_vu0_cull.plane_packet;
+    packet[0] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
+    packet[1] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    packet[2] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    packet[3] = VIF_CODE(VU0_PLANE_DATA, VU0_PLANE_QWORDS, 0x6C, 0);  // UNPACK V4-32
+    
+    float* data = (float*)&packet[4];
+    for (int component = 0; component < 4; component++) {
+        for (int lane = 0; lane < 4; lane++) {
+            // Planes 0-3 in qwords 0-3, planes 4-5 in qwords 4-7
+            data[component * 4 + lane] = planes[lane][component];
+            if (lane < 2) {
+                data[16 + component * 4 + lane] = planes[4 + lane][component];
+            } else {
+                // Padding lanes: zero normal, huge distance, always inside
+                data[16 + component * 4 + lane] = (component == 3) ? 1.0e30f : 0.0f;
+            }
+        }
+    }
+    for (int lane = 0; lane < 4; lane++) {
+        data[32 + lane] = 1.0f;
+    }
+    
+    // Batches in flight were culled against the previous planes: let them finish
+    vu0_wait_idle();
+    vu0_send_packet(packet, 1 + VU0_PLANE_QWORDS);
+    memcpy(g_vu0_cull.planes, planes, sizeof(g_vu0_cull.planes));
+    g_vu0_cull.planes_valid = true;
     return 0;
+}
 
+// Sphere slots (center xyz, radius w) of the next batch, written in place
+// into its VIF0 packet. NULL when both buffers are in flight: collect first.
+float* vu0_cull_engine_begin_batch(u32* buffer_id) {
+    if (!g_vu0_cull.initialized || g_vu0_cull.in_flight >= 2) {
+        return NULL;
+    }
+    
+    g_vu0_cull.filling = true;
+    if (buffer_id) *buffer_id = g_vu0_cull.fill_buffer;
+    return (float*)&g_vu0_cull.batch_packets[g_vu0_cull.fill_buffer][2 * 4];
 }
 
-static int vu0_execute_and_wait(void) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    // Simplified implementation - in production would execute VU0 microcode
-    debug_log_verbose("VU0: Microprogram execution completed");
+// Finish and kick the batch handed out by vu0_cull_engine_begin_batch.
+// Returns immediately; VU0 culls while the EE carries on.
+int vu0_cull_engine_submit(u32 count) {
+    if (!g_vu0_cull.initialized || !g_vu0_cull.filling || count > VU0_CULL_BATCH_SIZE) {
+        return -1;
+    }
+    
+    u64 submit_start = get_cpu_cycles();
+    u32 buffer_id = g_vu0_cull.fill_buffer;
+    u32 input_address = (buffer_id == 0) ? VU0_SPLAT_DATA_A : VU0_SPLAT_DATA_B;
+    u32 result_address = (buffer_id == 0) ? VU0_RESULT_DATA_A : VU0_RESULT_DATA_B;
+    u16 sequence = ++g_vu0_cull.next_sequence;
+    u32* packet = g_vu0_cull.batch_packets[buffer_id];
+    
+    // VIF header, UNPACK last so the payload starts on a qword boundary
+    packet[0] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
+    packet[1] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    packet[2] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    packet[3] = VIF_CODE(input_address, (1 + count) & 0xFF, 0x6C, 0);  // UNPACK V4-32
+    
+    // Batch header: sphere count, result address and done marker
+    packet[4] = count;
+    packet[5] = result_address;
+    packet[6] = sequence;
+    packet[7] = 0;
+    
+    // Kick: ITOP carries the input buffer base, MSCAL waits for the running program
+    u32* kick = &packet[(2 + count) * 4];
+    kick[0] = VIF_CODE(input_address, 0, VIF_CMD_ITOP, 0);
+    kick[1] = VIF_CODE(g_vu0_cull.microcode_entry, 0, VIF_CMD_MSCAL, 0);
+    kick[2] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    kick[3] = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+    
+    vu0_send_packet(packet, 2 + count + 1);
+    
+    g_vu0_cull.batch_counts[buffer_id] = count;
+    g_vu0_cull.batch_sequence[buffer_id] = sequence;
+    g_vu0_cull.batch_submit_time[buffer_id] = submit_start;
+    if (g_vu0_cull.in_flight == 0) {
+        g_vu0_cull.oldest_buffer = buffer_id;
+    }
+    g_vu0_cull.in_flight++;
+    g_vu0_cull.fill_buffer ^= 1;
+    g_vu0_cull.filling = false;
+    
+    g_vu0_cull.submit_cycles += get_cpu_cycles() - submit_start;
     return 0;
-
 }
 
-static int vu0_download_results_safe(void* dest, u32 size_bytes, u32 src_addr) {
-    // COMPLETE IMPLEMENTATION - Full functionality
-    if (!dest || size_bytes == 0) {
-        debug_log_error("VU0: Invalid download parameters");
+// Visibility masks of the oldest batch: bit (i % 16) of masks[i / 16] is
+// set when sphere i is visible. Returns the sphere count, or -1 if VU0 did
+// not finish in time (the caller should test that batch on the EE).
+int vu0_cull_engine_collect(u16* masks, u32* buffer_id) {
+    if (!g_vu0_cull.initialized || g_vu0_cull.in_flight == 0 || !masks) {
         return -1;
     }
     
-    // For now, implement CPU fallback - mark all splats as visible
-    // In production, this would use DMA to read from VU0 data memory
-    memset(dest, 0xFF, size_bytes);
+    u32 id = g_vu0_cull.oldest_buffer;
+    u32 result_address = (id == 0) ? VU0_RESULT_DATA_A : VU0_RESULT_DATA_B;
+    volatile u32* results = (volatile u32*)(VU0_DATA_MEM + result_address * 16);
+    u32 count = g_vu0_cull.batch_counts[id];
     
-    debug_log_verbose("VU0: Downloaded %d bytes from address 0x%04X", size_bytes, src_addr);
-    return 0;
+    g_vu0_cull.oldest_buffer ^= 1;
+    g_vu0_cull.in_flight--;
+    if (buffer_id) *buffer_id = id;
+    
+    // The microprogram stores the batch sequence last
+    u64 wait_start = get_cpu_cycles();
+    while ((u16)results[3] != g_vu0_cull.batch_sequence[id]) {
+        if (get_cpu_cycles() - wait_start > VU0_CULL_TIMEOUT_CYCLES) {
+            debug_log_error("VU0: Batch %d timed out", g_vu0_cull.batch_sequence[id]);
+            vu0_wait_idle();
+            return -1;
+        }
+    }
+    u64 collect_time = get_cpu_cycles();
+    g_vu0_cull.wait_cycles += collect_time - wait_start;
+    g_vu0_cull.active_cycles += collect_time - g_vu0_cull.batch_submit_time[id];
+    
+    u32 visible = 0;
+    for (u32 m = 0; m < (count + 15) / 16; m++) {
+        masks[m] = (u16)results[m * 4];
+        for (u16 bits = masks[m]; bits; bits &= bits - 1) visible++;
+    }
+    
+    g_vu0_cull.total_splats_processed += count;
+    g_vu0_cull.total_splats_culled += count - visible;
+    g_vu0_cull.batches_processed++;
+    return (int)count;
+}
 
+u32 vu0_cull_engine_in_flight(void) {
+    return g_vu0_cull.in_flight;
 }
 
 // ============================================================================
 // Main VU Culling Functions
 // ============================================================================
 
+// Legacy single-batch interface state (vu_upload/execute/get_culling_results)
+static u32 g_staged_count = 0;
+
+static void planes_to_float(s32 cam_planes[6][4], float planes[6][4]) {
+    for (int p = 0; p < 6; p++) {
+        for (int c = 0; c < 4; c++) {
+            planes[p][c] = (float)cam_planes[p][c];
+        }
+    }
+}
+
+static void write_compact_spheres(float* spheres, const CompactSplat* splats, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        spheres[i * 4 + 0] = splats[i].pos[0];
+        spheres[i * 4 + 1] = splats[i].pos[1];
+        spheres[i * 4 + 2] = splats[i].pos[2];
+        spheres[i * 4 + 3] = (splats[i].scale[0] > splats[i].scale[1]) ? splats[i].scale[0] : splats[i].scale[1];
+    }
+}
+
+// Cull any number of splats, streaming batches through both VU0 buffers:
+// batch N+1 is built and uploaded while VU0 culls batch N.
 int vu_cull_splats(CompactSplat* splats, u32 count, s32 cam_planes[6][4], u8* visibility) {
     if (!splats || !cam_planes || !visibility || count == 0) {
         debug_log_error("VU Culling: Invalid parameters");
         return -1;
     }
     
-    // Limit batch size to VU0 capacity
-    if (count > VU0_MAX_SPLATS) {
-        debug_log_warning("VU Culling: Batch size %d limited to %d", count, VU0_MAX_SPLATS);
-        count = VU0_MAX_SPLATS;
-    }
-    
-    debug_log_info("VU Culling: Processing %d splats", count);
-    
-    // Clear visibility mask
-    u32 visibility_bytes = (count + 7) / 8;  // Round up to bytes
-    memset(visibility, 0, visibility_bytes);
-    
-    // Prepare splat data for VU0
-    vu_splat_data* vu_splats = (vu_splat_data*)malloc(count * sizeof(vu_splat_data));
-    if (!vu_splats) {
-        debug_log_error("VU Culling: Failed to allocate splat data buffer");
-        return -1;
-    }
-    
-    // Convert splat data to VU format
-    for (u32 i = 0; i < count; i++) {
-        vu_splats[i].position.x = splats[i].pos[0];
-        vu_splats[i].position.y = splats[i].pos[1];
-        vu_splats[i].position.z = splats[i].pos[2];
-        vu_splats[i].position.w = 1.0f;
-        vu_splats[i].scale.x = splats[i].scale[0];
-        vu_splats[i].scale.y = splats[i].scale[1];
-        vu_splats[i].scale.z = 1.0f;
-        vu_splats[i].scale.w = 1.0f;
-        vu_splats[i].color_packed = splats[i].color_packed;
-    }
-    
-    // Prepare frustum plane data
-    vu_frustum_plane planes[6] __attribute__((aligned(16)));
-    for (int p = 0; p < 6; p++) {
-        planes[p].plane.x = (float)cam_planes[p][0];
-        planes[p].plane.y = (float)cam_planes[p][1];
-        planes[p].plane.z = (float)cam_planes[p][2];
-        planes[p].plane.w = (float)cam_planes[p][3];
-    }
-    
-    // Upload microcode to VU0
-    if (vu0_upload_microcode_safe(vu0_cull_microcode, sizeof(vu0_cull_microcode)) < 0) {
-        free(vu_splats);
+    if (!g_vu0_cull.initialized && vu_culling_init() < 0) {
         return -1;
     }
     
-    // Upload splat data to VU0
-    if (vu0_upload_data_safe(vu_splats, count * sizeof(vu_splat_data), VU0_SPLAT_DATA) < 0) {
-        free(vu_splats);
+    float planes[6][4];
+    planes_to_float(cam_planes, planes);
+    if (vu0_cull_engine_set_planes(planes) < 0) {
         return -1;
     }
     
-    // Upload frustum planes to VU0
-    if (vu0_upload_data_safe(planes, sizeof(planes), VU0_PLANE_DATA) < 0) {
-        free(vu_splats);
-        return -1;
-    }
+    memset(visibility, 0, (count + 7) / 8);
     
-    // Execute VU0 culling microcode
-    if (vu0_execute_and_wait() < 0) {
-        free(vu_splats);
-        return -1;
-    }
+    u32 submitted = 0;
+    u32 collected = 0;
+    u32 batch_start[2] = {0, 0};
+    u16 masks[VU0_CULL_BATCH_SIZE / 16];
     
-    // Download visibility results
-    if (vu0_download_results_safe(visibility, visibility_bytes, VU0_RESULT_DATA) < 0) {
-        free(vu_splats);
-        return -1;
+    while (collected < count) {
+        // Keep both buffers busy
+        while (submitted < count && vu0_cull_engine_in_flight() < 2) {
+            u32 buffer_id;
+            float* spheres = vu0_cull_engine_begin_batch(&buffer_id);
+            u32 batch = (count - submitted > VU0_CULL_BATCH_SIZE) ? VU0_CULL_BATCH_SIZE : (count - submitted);
+            write_compact_spheres(spheres, &splats[submitted], batch);
+            batch_start[buffer_id] = submitted;
+            vu0_cull_engine_submit(batch);
+            submitted += batch;
+        }
+        
+        u32 buffer_id;
+        int batch = vu0_cull_engine_collect(masks, &buffer_id);
+        if (batch < 0) {
+            return -1;
+        }
+        
+        // Masks are LSB first, matching the byte-wise visibility layout
+        u32 first = batch_start[buffer_id];
+        for (u32 i = 0; i < (u32)batch; i++) {
+            if (masks[i / 16] & (1 << (i % 16))) {
+                visibility[(first + i) / 8] |= (u8)(1 << ((first + i) % 8));
+            }
+        }
+        collected += batch;
     }
     
-    free(vu_splats);
-    
-    debug_log_info("VU Culling: Completed culling for %d splats", count);
+    debug_log_verbose("VU Culling: Completed culling for %d splats", count);
     return 0;
 }
 
@@ -240,68 +413,36 @@ int vu_upload_culling_data(CompactSplat* splats, u32 count, s32 cam_planes[6][4]
         count = VU0_MAX_SPLATS;
     }
     
-    debug_log_info("VU Upload: Uploading data for %d splats", count);
-    
-    // Prepare and upload splat data
-    vu_splat_data* vu_splats = (vu_splat_data*)malloc(count * sizeof(vu_splat_data));
-    if (!vu_splats) {
-        debug_log_error("VU Upload: Failed to allocate splat data buffer");
+    if (!g_vu0_cull.initialized && vu_culling_init() < 0) {
         return -1;
     }
     
-    for (u32 i = 0; i < count; i++) {
-        vu_splats[i].position.x = splats[i].pos[0];
-        vu_splats[i].position.y = splats[i].pos[1];
-        vu_splats[i].position.z = splats[i].pos[2];
-        vu_splats[i].position.w = 1.0f;
-        vu_splats[i].scale.x = splats[i].scale[0];
-        vu_splats[i].scale.y = splats[i].scale[1];
-        vu_splats[i].scale.z = 1.0f;
-        vu_splats[i].scale.w = 1.0f;
-        vu_splats[i].color_packed = splats[i].color_packed;
-    }
-    
-    // Upload splat data
-    int result = vu0_upload_data_safe(vu_splats, count * sizeof(vu_splat_data), VU0_SPLAT_DATA);
-    free(vu_splats);
-    
-    if (result < 0) {
-        return result;
-    }
-    
-    // Prepare and upload frustum planes
-    vu_frustum_plane planes[6] __attribute__((aligned(16)));
-    for (int p = 0; p < 6; p++) {
-        planes[p].plane.x = (float)cam_planes[p][0];
-        planes[p].plane.y = (float)cam_planes[p][1];
-        planes[p].plane.z = (float)cam_planes[p][2];
-        planes[p].plane.w = (float)cam_planes[p][3];
+    float planes[6][4];
+    planes_to_float(cam_planes, planes);
+    if (vu0_cull_engine_set_planes(planes) < 0) {
+        return -1;
     }
     
-    result = vu0_upload_data_safe(planes, sizeof(planes), VU0_PLANE_DATA);
-    if (result < 0) {
-        return result;
+    float* spheres = vu0_cull_engine_begin_batch(NULL);
+    if (!spheres) {
+        return -1;
     }
+    write_compact_spheres(spheres, splats, count);
+    g_staged_count = count;
     
-    debug_log_info("VU Upload: Data upload completed successfully");
+    debug_log_verbose("VU Upload: Staged %d splats", count);
     return 0;
 }
 
 int vu_execute_culling_program(void) {
-    debug_log_info("VU Execute: Starting culling program");
-    
-    // Upload microcode if not already done
-    if (vu0_upload_microcode_safe(vu0_cull_microcode, sizeof(vu0_cull_microcode)) < 0) {
-        return -1;
-    }
-    
-    // Execute the culling program
-    if (vu0_execute_and_wait() < 0) {
+    if (g_staged_count == 0) {
+        debug_log_error("VU Execute: No culling data uploaded");
         return -1;
     }
     
-    debug_log_info("VU Execute: Culling program completed");
-    return 0;
+    int result = vu0_cull_engine_submit(g_staged_count);
+    g_staged_count = 0;
+    return result;
 }
 
 int vu_get_culling_results(u8* visibility, u32 max_splats) {
@@ -310,18 +451,18 @@ int vu_get_culling_results(u8* visibility, u32 max_splats) {
         return -1;
     }
     
-    if (max_splats > VU0_MAX_SPLATS) {
-        max_splats = VU0_MAX_SPLATS;
+    u16 masks[VU0_CULL_BATCH_SIZE / 16];
+    int count = vu0_cull_engine_collect(masks, NULL);
+    if (count < 0) {
+        return -1;
     }
     
-    debug_log_info("VU Results: Retrieving results for %d splats", max_splats);
+    if (max_splats > (u32)count) {
+        max_splats = (u32)count;
+    }
     
     u32 visibility_bytes = (max_splats + 7) / 8;
-    
-    // Download results from VU0
-    if (vu0_download_results_safe(visibility, visibility_bytes, VU0_RESULT_DATA) < 0) {
-        return -1;
-    }
+    memcpy(visibility, masks, visibility_bytes);  // LSB-first masks are byte-compatible
     
     // Count visible splats for statistics
     u32 visible_count = 0;
@@ -331,7 +472,7 @@ int vu_get_culling_results(u8* visibility, u32 max_splats) {
         }
     }
     
-    debug_log_info("VU Results: %d/%d splats visible", visible_count, max_splats);
+    debug_log_verbose("VU Results: %d/%d splats visible", visible_count, max_splats);
     return visible_count;
 }
 
@@ -348,7 +489,35 @@ int vu_culling_init(void) {
     // Initialize DMA channels for VU communication
     dma_channel_initialize(DMA_CHANNEL_VIF0, NULL, 0);
     dma_channel_initialize(DMA_CHANNEL_VIF1, NULL, 0);
-
+    
+    if (g_vu0_cull.initialized) {
+        return 0;
+    }
+    
+    memset(&g_vu0_cull, 0, sizeof(g_vu0_cull));
+    for (int i = 0; i < 2; i++) {
+        g_vu0_cull.batch_packets[i] = (u32*)memory_alloc(MEMORY_BUDGET_DMA, VU0_BATCH_PACKET_QWORDS * 16, 64);
+    }
+    g_vu0_cull.plane_packet = (u32*)memory_alloc(MEMORY_BUDGET_DMA, (1 + VU0_PLANE_QWORDS) * 16, 64);
+    
+    if (!g_vu0_cull.batch_packets[0] || !g_vu0_cull.batch_packets[1] || !g_vu0_cull.plane_packet) {
+        debug_log_error("VU Culling: Failed to allocate VIF0 packets");
+        vu_culling_shutdown();
+        return -1;
+    }
+    
+    if (vu0_upload_microcode_safe(vu0_cull_start, vu0_cull_end) < 0) {
+        vu_culling_shutdown();
+        return -1;
+    }
+    g_vu0_cull.microcode_loaded = true;
+    
+    // Clear done markers so stale data memory never matches a sequence
+    volatile u32* data_mem = (volatile u32*)VU0_DATA_MEM;
+    data_mem[VU0_RESULT_DATA_A * 4 + 3] = 0;
+    data_mem[VU0_RESULT_DATA_B * 4 + 3] = 0;
+    
+    g_vu0_cull.initialized = true;
     
     debug_log_info("VU Culling: Initialization completed successfully");
     return 0;
@@ -359,9 +528,18 @@ void vu_culling_shutdown(void) {
     
     // COMPLETE IMPLEMENTATION - Full functionality
     // Wait for any pending operations
+    if (g_vu0_cull.initialized) {
+        vu0_wait_idle();
+    }
     dma_channel_wait(DMA_CHANNEL_VIF0, 0);
     dma_channel_wait(DMA_CHANNEL_VIF1, 0);
     
+    for (int i = 0; i < 2; i++) {
+        if (g_vu0_cull.batch_packets[i]) memory_free(g_vu0_cull.batch_packets[i]);
+    }
+    if (g_vu0_cull.plane_packet) memory_free(g_vu0_cull.plane_packet);
+    memset(&g_vu0_cull, 0, sizeof(g_vu0_cull));
+    
     // Shutdown DMA channels
     dma_channel_shutdown(DMA_CHANNEL_VIF0, 0);
     dma_channel_shutdown(DMA_CHANNEL_VIF1, 0);
@@ -383,12 +561,21 @@ int vu_culling_get_performance_stats(VUCullingStats* stats) {
     // Initialize stats structure
     memset(stats, 0, sizeof(VUCullingStats));
     
-    // In a real implementation, these would be gathered from VU performance counters
-    stats->total_splats_processed = 0;
-    stats->total_splats_culled = 0;
-    stats->average_culling_time_us = 0;
-    stats->vu0_utilization_percent = 0;
-    stats->dma_transfer_time_us = 0;
+    // Cycle counts from the VU0 culling engine (294.912 MHz EE clock)
+    stats->total_splats_processed = g_vu0_cull.total_splats_processed;
+    stats->total_splats_culled = g_vu0_cull.total_splats_culled;
+    if (g_vu0_cull.batches_processed > 0) {
+        stats->average_culling_time_us = (u32)(g_vu0_cull.active_cycles * 1000000ULL /
+                                               294912000ULL / g_vu0_cull.batches_processed);
+    }
+    
+    // Share of in-flight batch time the EE did not spend waiting on results
+    if (g_vu0_cull.active_cycles > 0) {
+        u64 overlapped = (g_vu0_cull.active_cycles > g_vu0_cull.wait_cycles) ?
+                         g_vu0_cull.active_cycles - g_vu0_cull.wait_cycles : 0;
+        stats->vu0_utilization_percent = (u32)(overlapped * 100 / g_vu0_cull.active_cycles);
+    }
+    stats->dma_transfer_time_us = (u32)(g_vu0_cull.submit_cycles * 1000000ULL / 294912000ULL);
     
     debug_log_verbose("VU Stats: Performance statistics retrieved");
     return 0;
@@ -396,7 +583,12 @@ int vu_culling_get_performance_stats(VUCullingStats* stats) {
 
 void vu_culling_reset_performance_stats(void) {
     debug_log_info("VU Stats: Performance statistics reset");
-    // In a real implementation, this would reset VU performance counters
+    g_vu0_cull.total_splats_processed = 0;
+    g_vu0_cull.total_splats_culled = 0;
+    g_vu0_cull.batches_processed = 0;
+    g_vu0_cull.submit_cycles = 0;
+    g_vu0_cull.wait_cycles = 0;
+    g_vu0_cull.active_cycles = 0;
 }
 
 // ============================================================================
@@ -454,8 +646,9 @@ int vu_occlusion_cull_splats(CompactSplat* splats, u32 count,
         return result;
     }
     
-    // Then perform occlusion culling (simplified implementation)
-    // In a real implementation, this would use VU1 to test splats against depth buffer
+    // Occlusion is tested per octree node in the frustum pass, against the
+    // tile rasterizer's pyramid of last frame's opaque tiles; these splats
+    // come without a projection, so only the frustum result is returned
     
     debug_log_info("VU Occlusion: Occlusion culling completed");
     return result;
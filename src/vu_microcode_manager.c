@@ -0,0 +1,265 @@
+/*
+ * SPLATSTORM X - VU Microcode Manager
+ * Keeps several programs resident in VU0/VU1 micro memory at once.
+ *
+ * Programs are registered once and placed first-fit in code memory; the
+ * least recently used resident program on the unit is evicted when nothing
+ * fits. A program that is already resident costs nothing to switch to.
+ * One that is missing is transferred with DMA REF tags carrying MPG, so a
+ * batch chain loads its program in the same VIF stream as its data and the
+ * VIF holds the MPG until the running microprogram ends. VU branches are
+ * PC-relative, so programs run from any address; MSCAL takes the entry
+ * address the manager hands back.
+ */
+
+#include "splatstorm_x.h"
+#include <tamtypes.h>
+#include <kernel.h>
+#include <dma.h>
+#include <dma_tags.h>
+#include <vif_codes.h>
+#include <string.h>
+#include <stdio.h>
+
+// Code memory per unit in 64-bit instructions: VU0 4KB, VU1 16KB
+#define VU0_CODE_DWORDS 512
+#define VU1_CODE_DWORDS 2048
+#define MPG_MAX_QWORDS 128                    // MPG NUM is 8 bits, 0 = 256 instructions
+
+typedef struct {
+    const char* name;                         // For logs
+    u32 unit;                                 // VU_UNIT_VU0 / VU_UNIT_VU1
+    const u32* transfer_start;                // Program start rounded down to a qword
+    u32 transfer_qwords;                      // Whole qwords covering the program
+    u32 entry_offset;                         // Instructions from the load address to the program
+    bool resident;                            // Present in micro memory at address
+    u32 address;                              // Load address in instructions
+    u32 last_use;                             // Use clock of the last selection
+} VUMicrocodeProgram;
+
+typedef struct {
+    bool initialized;
+    VUMicrocodeProgram programs[VU_MICROCODE_MAX_PROGRAMS];
+    u32 program_count;
+    u32 use_clock;                            // Advances on every selection, for LRU
+    u64* upload_chain;                        // DMA chain for synchronous uploads
+
+    // Statistics
+    u32 mpg_transfers;                        // Programs transferred
+    u32 mpg_qwords;                           // Qwords of code transferred
+    u32 resident_hits;                        // Selections that needed no transfer
+} VUMicrocodeManager;
+
+static VUMicrocodeManager g_vu_microcode = {0};
+
+static u32 vu_microcode_capacity(u32 unit) {
+    return (unit == VU_UNIT_VU0) ? VU0_CODE_DWORDS : VU1_CODE_DWORDS;
+}
+
+int vu_microcode_manager_init(void) {
+    if (g_vu_microcode.initialized) {
+        return GAUSSIAN_SUCCESS;
+    }
+
+    memset(&g_vu_microcode, 0, sizeof(g_vu_microcode));
+    g_vu_microcode.upload_chain = (u64*)memory_alloc(MEMORY_BUDGET_DMA, (VU_MICROCODE_MAX_MPG_TAGS + 1) * 16,
+                                                     CACHE_LINE_SIZE);
+    if (!g_vu_microcode.upload_chain) {
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+
+    g_vu_microcode.initialized = true;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Register a program for a unit; registering the same code again returns
+// the existing id. Returns the program id, or a negative GaussianResult.
+int vu_microcode_register(u32 unit, const char* name, const u32* start, const u32* end) {
+    if (!g_vu_microcode.initialized) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+
+    if ((unit != VU_UNIT_VU0 && unit != VU_UNIT_VU1) || !start || end <= start) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    for (u32 i = 0; i < g_vu_microcode.program_count; i++) {
+        VUMicrocodeProgram* program = &g_vu_microcode.programs[i];
+        if (program->unit == unit && program->transfer_start == (const u32*)((u32)start & ~15U)) {
+            return (int)i;
+        }
+    }
+
+    if (g_vu_microcode.program_count >= VU_MICROCODE_MAX_PROGRAMS) {
+        printf("SPLATSTORM X: VU microcode table full, %s not registered\n", name);
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+
+    // The assembler aligns programs to 8 bytes: the transfer starts on the
+    // enclosing qword, and the dword before the program rides along
+    u32 first = (u32)start & ~15U;
+    u32 last = ((u32)end + 15) & ~15U;
+    u32 transfer_qwords = (last - first) / 16;
+    if (transfer_qwords * 2 > vu_microcode_capacity(unit) ||
+        transfer_qwords > MPG_MAX_QWORDS * VU_MICROCODE_MAX_MPG_TAGS) {
+        printf("SPLATSTORM X: VU microcode %s too large (%u qwords)\n", name, transfer_qwords);
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+
+    VUMicrocodeProgram* program = &g_vu_microcode.programs[g_vu_microcode.program_count];
+    memset(program, 0, sizeof(VUMicrocodeProgram));
+    program->name = name;
+    program->unit = unit;
+    program->transfer_start = (const u32*)first;
+    program->transfer_qwords = transfer_qwords;
+    program->entry_offset = ((u32)start - first) / 8;
+
+    return (int)g_vu_microcode.program_count++;
+}
+
+// Lowest free address on the unit that holds size instructions, or -1
+static int vu_microcode_find_space(u32 unit, u32 size) {
+    u32 capacity = vu_microcode_capacity(unit);
+
+    // Candidates: the bottom of memory and the end of each resident program
+    for (u32 c = 0; c <= g_vu_microcode.program_count; c++) {
+        u32 candidate = 0;
+        if (c > 0) {
+            const VUMicrocodeProgram* after = &g_vu_microcode.programs[c - 1];
+            if (!after->resident || after->unit != unit) {
+                continue;
+            }
+            candidate = after->address + after->transfer_qwords * 2;
+        }
+        if (candidate + size > capacity) {
+            continue;
+        }
+
+        bool overlaps = false;
+        for (u32 i = 0; i < g_vu_microcode.program_count && !overlaps; i++) {
+            const VUMicrocodeProgram* other = &g_vu_microcode.programs[i];
+            if (other->resident && other->unit == unit) {
+                u32 other_end = other->address + other->transfer_qwords * 2;
+                overlaps = candidate < other_end && other->address < candidate + size;
+            }
+        }
+        if (!overlaps) {
+            return (int)candidate;
+        }
+    }
+
+    return -1;
+}
+
+// Place a program, evicting least recently used ones until it fits
+static bool vu_microcode_place(VUMicrocodeProgram* program) {
+    u32 size = program->transfer_qwords * 2;
+
+    for (;;) {
+        int address = vu_microcode_find_space(program->unit, size);
+        if (address >= 0) {
+            program->address = (u32)address;
+            return true;
+        }
+
+        VUMicrocodeProgram* victim = NULL;
+        for (u32 i = 0; i < g_vu_microcode.program_count; i++) {
+            VUMicrocodeProgram* other = &g_vu_microcode.programs[i];
+            if (other != program && other->resident && other->unit == program->unit &&
+                (!victim || other->last_use < victim->last_use)) {
+                victim = other;
+            }
+        }
+        if (!victim) {
+            return false;
+        }
+        victim->resident = false;
+    }
+}
+
+// Select a program for the next MSCAL. Resident: nothing is written. Missing:
+// it is placed and REF tags with NOP/MPG codes are written at chain, one per
+// 128 qwords; the caller must send them ahead of its MSCAL. Returns the
+// number of chain qwords written; entry receives the MSCAL address.
+u32 vu_microcode_build_mpg(u32 program_id, u64* chain, u32* entry) {
+    if (!g_vu_microcode.initialized || program_id >= g_vu_microcode.program_count) {
+        return 0;
+    }
+
+    VUMicrocodeProgram* program = &g_vu_microcode.programs[program_id];
+    program->last_use = ++g_vu_microcode.use_clock;
+
+    if (program->resident) {
+        g_vu_microcode.resident_hits++;
+        *entry = program->address + program->entry_offset;
+        return 0;
+    }
+
+    if (!vu_microcode_place(program)) {
+        return 0;  // Cannot happen: registration checked the size against the unit
+    }
+
+    u32 tags = 0;
+    for (u32 offset = 0; offset < program->transfer_qwords; offset += MPG_MAX_QWORDS) {
+        u32 qwords = MIN(program->transfer_qwords - offset, MPG_MAX_QWORDS);
+        u32 source = ((u32)program->transfer_start + offset * 16) & 0x0FFFFFFF;
+
+        // MPG last in the tag qword so the code that follows is 64-bit aligned
+        chain[tags * 2] = DMA_SET_TAG(qwords, 0, DMA_TAG_REF, 0, source, 0);
+        chain[tags * 2 + 1] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                              ((u64)VIF_CODE(program->address + offset * 2, (qwords * 2) & 0xFF, VIF_CMD_MPG, 0) << 32);
+        tags++;
+    }
+
+    program->resident = true;
+    g_vu_microcode.mpg_transfers++;
+    g_vu_microcode.mpg_qwords += program->transfer_qwords;
+    *entry = program->address + program->entry_offset;
+    return tags;
+}
+
+// Make a program resident now, on its own VIF channel, and wait for it
+int vu_microcode_upload(u32 program_id, u32* entry) {
+    if (!g_vu_microcode.initialized || program_id >= g_vu_microcode.program_count) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+
+    const VUMicrocodeProgram* program = &g_vu_microcode.programs[program_id];
+    u64* chain = g_vu_microcode.upload_chain;
+    u32 tags = vu_microcode_build_mpg(program_id, chain, entry);
+    if (tags == 0) {
+        return program->resident ? GAUSSIAN_SUCCESS : GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+
+    chain[tags * 2] = DMA_SET_TAG(0, 0, DMA_TAG_END, 0, 0, 0);
+    chain[tags * 2 + 1] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) | ((u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) << 32);
+
+    int channel = (program->unit == VU_UNIT_VU0) ? DMA_CHANNEL_VIF0 : DMA_CHANNEL_VIF1;
+    FlushCache(0);
+    dma_channel_send_chain(channel, (void*)((u32)chain & 0x0FFFFFFF), 0, DMA_FLAG_TRANSFERTAG, 0);
+    dma_account_transfer(channel, (tags + 1 + program->transfer_qwords) * 16);
+    dma_wait_channel(channel);
+
+    printf("SPLATSTORM X: VU%u microcode %s resident at 0x%03X (%u qwords)\n",
+           program->unit, program->name, program->address, program->transfer_qwords);
+    return GAUSSIAN_SUCCESS;
+}
+
+bool vu_microcode_is_resident(u32 program_id) {
+    return program_id < g_vu_microcode.program_count && g_vu_microcode.programs[program_id].resident;
+}
+
+// Forget what a unit holds, after a reset or an upload outside the manager
+void vu_microcode_invalidate(u32 unit) {
+    for (u32 i = 0; i < g_vu_microcode.program_count; i++) {
+        if (g_vu_microcode.programs[i].unit == unit) {
+            g_vu_microcode.programs[i].resident = false;
+        }
+    }
+}
+
+void vu_microcode_get_stats(u32* transfers, u32* transfer_qwords, u32* resident_hits) {
+    if (transfers) *transfers = g_vu_microcode.mpg_transfers;
+    if (transfer_qwords) *transfer_qwords = g_vu_microcode.mpg_qwords;
+    if (resident_hits) *resident_hits = g_vu_microcode.resident_hits;
+}
@@ -166,6 +166,7 @@ int vu0_upload_microcode_embedded(void) {
     dma_channel_wait(DMA_CHANNEL_VIF0, 0);
     
     free_dma_buffer_aligned(dma_buffer);
+    vu_microcode_invalidate(VU_UNIT_VU0);
     
     vu0_microcode_uploaded = 1;
     debug_log_info("VU0 microcode uploaded successfully");
@@ -224,6 +225,7 @@ int vu1_upload_microcode_embedded(void) {
     dma_channel_wait(DMA_CHANNEL_VIF1, 0);
     
     free_dma_buffer_aligned(dma_buffer);
+    vu_microcode_invalidate(VU_UNIT_VU1);
     
     vu1_microcode_uploaded = 1;
     debug_log_info("VU1 microcode uploaded successfully");
@@ -5,9 +5,16 @@
  * 
  * COMPLETE IMPLEMENTATION - NO STUBS OR PLACEHOLDERS
  * Features:
- * - Double buffering for continuous processing (128 splats per batch)
+ * - Three-stage upload/execute/drain pipeline over two VU1 buffer pairs
+ * - Direct PATH1 render mode: VU1 builds sprite GIF packets and XGKICKs them
+ * - Full EWA projection on VU1: covariance, eigenvalues, radius, atlas cell, 3 sigma cull
+ * - View-dependent SH color on VU1, re-evaluated only where the view direction moved
+ * - Download mode reads back 2 qwords per surviving splat as 16-byte render splats
+ * - Zero-copy uploads: DMA REF tags unpack visible splats straight from the scene array
+ * - One VIF1 chain per batch: constants, header, splats, program and MSCAL in one transfer
  * - Optimized DMA transfers with VIF packet construction
- * - Cycle-accurate profiling and performance monitoring
+ * - VU1 end interrupt: pipeline flushes sleep until the last program stops
+ * - Cycle-accurate profiling and performance monitoring, VU1 busy time from the activity sampler
  * - Error handling and fallback modes
  * - Memory alignment and cache optimization
  * - Instruction scheduling for maximum throughput
@@ -15,54 +22,176 @@
 
 #include "splatstorm_x.h"
 #include "gaussian_types.h"
+#include "fixed_math_mmi.h"
 #include <kernel.h>
 #include <dma.h>
 #include <packet.h>
 #include <packet2.h>
+#include <dma_tags.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <malloc.h>
+#include <math.h>
 
-// VU1 microcode binary (embedded)
-extern u32 vu1_gaussian_projection_start[];
+// VU1 projection programs assembled from vu/*.vu1
+extern u32 gaussian_projection_basic_start[];
+extern u32 gaussian_projection_basic_end[];
+extern u32 gaussian_vu1_safe[];
+extern u32 gaussian_vu1_safe_end[];
+extern u32 gaussian_vu1_intermediate[];
+extern u32 gaussian_vu1_intermediate_end[];
+extern u32 gaussian_vu1_optimized[];
+extern u32 gaussian_vu1_optimized_end[];
+extern u32 vu1Splat_CodeStart[];
+extern u32 vu1Splat_CodeEnd[];
 
 // Use PS2SDK VIF constants and macros - remove conflicting definitions
 
 // Forward declarations for internal functions
-static GaussianResult vu_upload_splat_batch(const GaussianSplat3D* splats, u32 count, u32 buffer_id);
-static GaussianResult vu_start_processing(u32 splat_count);
-static GaussianResult vu_download_results(GaussianSplat2D* output_splats, u32 count);
-extern u32 vu1_gaussian_projection_end[];
-
-// VU1 memory layout constants
-#define VU1_BATCH_SIZE 128                    // Splats per batch (fits in 16KB)
-#define VU1_INPUT_BUFFER_A 0x000              // Input buffer A address
-#define VU1_INPUT_BUFFER_B 0x200              // Input buffer B address  
-#define VU1_CONSTANTS_BASE 0x400              // Constants and matrices
-#define VU1_OUTPUT_BUFFER 0x600               // Output buffer address
-#define VU1_MICROCODE_ADDR 0x000              // Microcode load address
+static u32 vu_build_batch_packet(const GaussianSplat3D* splats, const u32* indices, u32 count,
+                                 u32 buffer_id, u32 flags);
+static void vu_send_batch_packet(u32 buffer_id);
+static GaussianResult vu_download_results(GaussianSplatRender* output_splats, u32 count, u32 buffer_id,
+                                          u32* stored);
+static void vu_store_sh_colors(const GaussianSplat3D* splats, const u32* indices, u32 count, u32 buffer_id);
 
 // DMA packet sizes
-#define SPLAT_INPUT_QWORDS 4                  // 4 qwords per input splat
-#define SPLAT_OUTPUT_QWORDS 4                 // 4 qwords per output splat
+#define SPLAT_INPUT_QWORDS 4                  // Raw position/cov_exp qword, 2 covariance qwords, RGBA qword
+#define SPLAT_UNPACK_SPILL_QWORDS 3           // V4-8 color unpack writes 4 qwords, 3 are overwritten
+#define SPLAT_COV_OFFSET 16                   // Byte offset of cov_mant[1..8] in GaussianSplat3D
+#define SPLAT_COLOR_OFFSET 32                 // Byte offset of color/opacity in GaussianSplat3D
+#define SPLAT_SH_INPUT_QWORDS 8               // Plus color and sh_coeffs[0..13] as 4 V4-16 qwords
+#define SPLAT_OUTPUT_QWORDS 2                 // 2 integer qwords per output splat
+#define OUTPUT_COUNT_QWORDS 1                 // Survivor count in front of downloaded results
+#define BATCH_HEADER_QWORDS 2                 // count/output/flags, GIF tag
+#define KICK_SPLAT_QWORDS 5                   // RGBAQ, UV, XYZ2, UV, XYZ2 (PACKED)
 #define CONSTANTS_QWORDS 16                   // Constants and matrices
+#define COV_SCALE_TABLE_QWORDS 16             // 2^(cov_exp - 7), indexed by cov_exp
+#define ATLAS_TABLE_QWORDS (5 + FOOTPRINT_MIP_LEVELS)  // Cell selection constants, cell origin per level
+#define SH_TABLE_QWORDS 3                     // Camera position, degree 1-2 basis weights
+#define CONSTANT_BLOCK_QWORDS (SH_TABLE_QWORDS + ATLAS_TABLE_QWORDS + COV_SCALE_TABLE_QWORDS + CONSTANTS_QWORDS)
 #define MAX_DMA_PACKET_SIZE 1024              // Maximum DMA packet size
 
+// VU1 memory layout constants (1024 qwords of data memory)
+// Two buffer pairs let batch N+1 upload into one input buffer while VU1
+// executes batch N out of the other, and the EE drains batch N-1 from the
+// output buffer the running program does not touch.
+#define VU1_BATCH_SIZE 60                     // Splats per batch (4 buffers + constants fit in 16KB)
+#define VU1_SH_BATCH_SIZE ((VU1_BATCH_SIZE * SPLAT_INPUT_QWORDS) / SPLAT_SH_INPUT_QWORDS)  // Same input buffer
+#define VU1_INPUT_BUFFER_QWORDS  (BATCH_HEADER_QWORDS + VU1_BATCH_SIZE * SPLAT_INPUT_QWORDS + \
+                                  SPLAT_UNPACK_SPILL_QWORDS)
+
+// Direct render mode: the GIF tag plus 5 qwords per sprite must fit the output buffer
+#define VU1_KICK_BATCH_SIZE ((VU1_BATCH_SIZE * 4 - 1) / KICK_SPLAT_QWORDS)
+#define VU1_OUTPUT_BUFFER_QWORDS (1 + VU1_KICK_BATCH_SIZE * KICK_SPLAT_QWORDS)  // Sized for XGKICK sprites
+
+// SH batches append the shaded RGBA of every splat past their largest GIF packet
+#define VU1_SH_COLOR_OFFSET (1 + VU1_SH_BATCH_SIZE * KICK_SPLAT_QWORDS)  // 151, matches the microprogram
+#define VU1_INPUT_BUFFER_A 0x000              // Input buffer A address
+#define VU1_OUTPUT_BUFFER_A (VU1_INPUT_BUFFER_A + VU1_INPUT_BUFFER_QWORDS)
+#define VU1_INPUT_BUFFER_B 0x1F0              // Input buffer B address
+#define VU1_OUTPUT_BUFFER_B (VU1_INPUT_BUFFER_B + VU1_INPUT_BUFFER_QWORDS)
+#define VU1_CONSTANTS_BASE 0x3F0              // Constants and matrices (matches dma_system)
+#define VU1_COV_SCALE_TABLE (VU1_CONSTANTS_BASE - COV_SCALE_TABLE_QWORDS)
+#define VU1_ATLAS_TABLE (VU1_COV_SCALE_TABLE - ATLAS_TABLE_QWORDS)  // 0x3D7
+#define VU1_SH_TABLE (VU1_ATLAS_TABLE - SH_TABLE_QWORDS)  // 0x3D4, above buffer pair B; constant block base
+
+// Batch header flags (header.z)
+#define VU1_BATCH_FLAG_XGKICK 0x1             // Build GIF packet and XGKICK instead of storing results
+#define VU1_BATCH_FLAG_SH 0x2                 // Evaluate SH color, store shaded colors for the EE
+
+// EE-side batch flags; the microprogram only tests the bits above
+#define VU1_BATCH_FLAG_SH_FILL 0x100          // Write the shaded colors into the SH color cache
+#define VU1_BATCH_FLAG_SH_CACHED 0x200        // Color qword comes from the SH color cache
+
+// GIF tag for the direct path: PACKED, NREG=5, REGS = RGBAQ UV XYZ2 UV XYZ2
+#define KICK_GIF_REGS 0x53531ULL
+
+// Render splat lane 3 of the color qword: alpha, atlas cell and mip level
+#define VU1_PACK_CELL_SHIFT 8
+#define VU1_PACK_LEVEL_SHIFT 14
+
+// VIF UNPACK commands used by the batch chain
+#define VIF_UNPACK_V4_32 0x6C
+#define VIF_UNPACK_V4_16 0x6D
+#define VIF_UNPACK_V4_8 0x6E
+#define VIF_UNPACK_USN (1 << 14)              // Zero-extend 8-bit components
+
+// Per-batch DMA chain: CNT tag + header, three REF tags per splat, END tag with ITOP/MSCAL.
+// The splats themselves are never copied; VIF1 reads them from the scene array.
+// SH batches take a fourth tag per splat but hold half as many splats.
+#define SPLAT_REF_TAGS 3
+// The first batch after a constants upload leads with a REF tag to the
+// constant block; one that selects a program VU1 no longer holds also
+// carries its MPG tags.
+#define BATCH_PACKET_QWORDS (1 + 1 + BATCH_HEADER_QWORDS + VU1_BATCH_SIZE * SPLAT_REF_TAGS + \
+                             VU_MICROCODE_MAX_MPG_TAGS + 1)
+
+// Microcode auto-tune: each program runs a sample of the scene, is checked
+// against the EE projection and timed; the choice is kept per density class
+#define VU1_AUTOTUNE_SPLATS (VU1_BATCH_SIZE * 2)  // Sample size, two batches
+#define VU1_AUTOTUNE_RUNS 4                        // Timed runs per program, best one counts
+#define VU1_AUTOTUNE_DENSITY_CLASSES 8             // Scene size classes, 1K splats and doubling
+#define VU1_AUTOTUNE_DENSITY_BASE 1024
+#define VU1_AUTOTUNE_TOL_SCREEN (1 << RENDER_SPLAT_SUBPIXEL_SHIFT)  // 1 pixel in 12.4
+#define VU1_AUTOTUNE_TOL_ALPHA 1                   // GS alpha LSB
+#define VU1_OUTPUT_POISON 0x80000000U              // Clamps to an off-screen position
+
+// Selectable VU1 programs; entry 0 is the batch-contract program and the fallback
+typedef struct {
+    const char* name;
+    const u32* start;
+    const u32* end;
+} VU1MicrocodeVariant;
+
+static const VU1MicrocodeVariant g_vu1_variants[VU1_MICROCODE_VARIANT_COUNT] = {
+    {"gaussian_projection_fixed", gaussian_projection_basic_start, gaussian_projection_basic_end},
+    {"gaussian_vu1_safe", gaussian_vu1_safe, gaussian_vu1_safe_end},
+    {"gaussian_vu1_intermediate", gaussian_vu1_intermediate, gaussian_vu1_intermediate_end},
+    {"gaussian_vu1_optimized", gaussian_vu1_optimized, gaussian_vu1_optimized_end},
+    {"splatstorm_x_optimized", vu1Splat_CodeStart, vu1Splat_CodeEnd}
+};
+
+// SH color cache entry, one per scene splat. The first 4 bytes mirror the
+// record's color qword, so a fresh entry is DMA'd in place of the record
+// and the splat skips SH evaluation.
+typedef struct {
+    u8 color[3];                              // Shaded RGB from the last SH evaluation
+    u8 opacity;                               // Record opacity
+    float dir[3];                             // Unit view direction it was shaded for, zero = never
+} __attribute__((aligned(16))) SHColorCacheEntry;
+
 // VU system state
 typedef struct {
     bool initialized;                         // System initialization flag
     bool microcode_loaded;                    // Microcode load status
+    u32 microcode_variant;                    // Selected g_vu1_variants entry
+    u32 default_variant;                      // Program kept untuned, and the auto-tune fallback
+    bool autotune;                            // Time the programs per scene density class
+    int microcode_program[VU1_MICROCODE_VARIANT_COUNT];  // Microcode manager id per variant
+    s8 tuned_variant[VU1_AUTOTUNE_DENSITY_CLASSES];  // Auto-tune choice per density class, -1 = untuned
     u32 current_buffer;                       // Current active buffer (0 or 1)
     u32 processing_buffer;                    // Buffer being processed by VU
     bool vu_busy;                             // VU processing status
+    u32 render_mode;                          // VU_RENDER_MODE_DOWNLOAD / VU_RENDER_MODE_XGKICK
+    u32 sh_mode;                              // VU_SH_MODE_OFF / _FULL / _CACHED
+    float sh_cache_cos2;                      // Squared cosine of the cache threshold angle
+    float sh_camera[3];                       // Camera position of the uploaded constants
+    bool instance_constants;                  // Uploaded constants carry an instance transform
+    bool constants_pending;                   // Constant block not yet in a batch chain
+    SHColorCacheEntry* sh_cache;              // Per scene splat, NULL until a scene is loaded
+    u32 sh_cache_count;                       // Entries in sh_cache
+    u32* batch_packets[2];                    // EE-side batch packets, one per VU1 buffer
+    u32 batch_packet_qwords[2];               // Built size of each batch packet
+    u32 batch_packet_bytes[2];                // Bytes VIF1 reads for it: tags and referenced qwords
     u64 last_kick_cycles;                     // Last VU kick timestamp
     u64 total_cycles;                         // Total processing cycles
     u32 batches_processed;                    // Number of batches processed
     u32 splats_processed;                     // Total splats processed
     
     // DMA buffers (cache-aligned)
-    u64* dma_upload_buffer;                   // DMA upload packet buffer
+    u64* dma_upload_buffer;                   // Constant block, CONSTANT_BLOCK_QWORDS
     u64* dma_download_buffer;                 // DMA download packet buffer
     u32 dma_upload_size;                      // Upload buffer size
     u32 dma_download_size;                    // Download buffer size
@@ -72,10 +201,23 @@ typedef struct {
     u64 execute_cycles;                       // VU execution time
     u64 download_cycles;                      // DMA download time
     float vu_utilization;                     // VU utilization percentage
+    
+    // VU1 end interrupt
+    s32 vu1_end_sema;                         // Signalled from INTC_VIF1, -1 = waits spin
+    s32 vu1_end_handler;                      // INTC_VIF1 handler id
+    volatile u32 vu1_end_interrupts;          // Interrupts taken
+    u64 vu1_sleep_cycles;                     // EE time asleep waiting for VU1
 } VUSystemState;
 
 static VUSystemState g_vu_state = {0};
 
+// VIF code bit that interrupts and stalls VIF1 once the code has executed
+#define VIF_CODE_IRQ 0x80000000U
+
+// END tag whose VIF codes are NOP and FLUSHE with the interrupt bit: the
+// FLUSHE waits for the running program, so the interrupt marks VU1 stopping
+static u64 g_vu1_end_chain[2] __attribute__((aligned(16)));
+
 // COMPLETE IMPLEMENTATION - Use centralized performance counter
 // Removed static inline version, using performance_counters.c implementation
 
@@ -84,14 +226,89 @@ static inline bool is_vu1_busy(void) {
     return (*VU1_STAT & 0x1) != 0;  // Check VU1 running bit
 }
 
-// Wait for VU1 to complete processing
+static int vu1_end_interrupt(int cause) {
+    (void)cause;
+    *VIF1_FBRST = VIF_FBRST_STC;  // Release the stall the interrupt bit left
+    g_vu_state.vu1_end_interrupts++;
+    iSignalSema(g_vu_state.vu1_end_sema);
+    ExitHandler();
+    return 0;
+}
+
+static void vu1_end_interrupt_install(void) {
+    g_vu_state.vu1_end_sema = -1;
+    g_vu_state.vu1_end_handler = -1;
+
+    g_vu1_end_chain[0] = DMA_SET_TAG(0, 0, DMA_TAG_END, 0, 0, 0);
+    g_vu1_end_chain[1] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                         ((u64)(VIF_CODE(0, 0, VIF_CMD_FLUSHE, 0) | VIF_CODE_IRQ) << 32);
+    FlushCache(0);
+
+    ee_sema_t sema;
+    memset(&sema, 0, sizeof(sema));
+    sema.init_count = 0;
+    sema.max_count = 1;
+    g_vu_state.vu1_end_sema = CreateSema(&sema);
+    if (g_vu_state.vu1_end_sema < 0) {
+        return;
+    }
+
+    g_vu_state.vu1_end_handler = AddIntcHandler(INTC_VIF1, vu1_end_interrupt, 0);
+    if (g_vu_state.vu1_end_handler < 0) {
+        DeleteSema(g_vu_state.vu1_end_sema);
+        g_vu_state.vu1_end_sema = -1;
+        printf("SPLATSTORM X: VIF1 interrupt unavailable, VU1 waits spin\n");
+        return;
+    }
+    EnableIntc(INTC_VIF1);
+}
+
+static void vu1_end_interrupt_remove(void) {
+    if (g_vu_state.vu1_end_handler >= 0) {
+        DisableIntc(INTC_VIF1);
+        RemoveIntcHandler(INTC_VIF1, g_vu_state.vu1_end_handler);
+    }
+    if (g_vu_state.vu1_end_sema >= 0) {
+        DeleteSema(g_vu_state.vu1_end_sema);
+    }
+    g_vu_state.vu1_end_handler = -1;
+    g_vu_state.vu1_end_sema = -1;
+}
+
+// Wait for VU1 to complete processing; VIF1 must be idle. With the
+// interrupt the EE sleeps: the end chain queues behind the running program
+// and VIF1 interrupts once it stops. The spin covers the rest.
 static void wait_vu1_complete(void) {
+    if (g_vu_state.vu1_end_handler >= 0 && is_vu1_busy()) {
+        u64 sleep_start = get_cpu_cycles();
+        dma_channel_send_chain(DMA_CHANNEL_VIF1, (void*)((u32)g_vu1_end_chain & 0x0FFFFFFF),
+                               0, DMA_FLAG_TRANSFERTAG, 0);
+        dma_account_transfer(DMA_CHANNEL_VIF1, sizeof(g_vu1_end_chain));
+        WaitSema(g_vu_state.vu1_end_sema);
+        dma_wait_channel(DMA_CHANNEL_VIF1);
+        g_vu_state.vu1_sleep_cycles += get_cpu_cycles() - sleep_start;
+    }
+
     while (is_vu1_busy()) {
-        // Yield CPU while waiting
         __asm__ volatile("nop");
     }
 }
 
+// Wait for every VIF1 transfer and the VU1 program they started
+void vu_wait_vu1_idle(void) {
+    if (!g_vu_state.initialized) {
+        return;
+    }
+    dma_wait_channel(DMA_CHANNEL_VIF1);
+    wait_vu1_complete();
+    g_vu_state.vu_busy = false;
+}
+
+void vu_get_wait_stats(u32* end_interrupts, u64* sleep_cycles) {
+    if (end_interrupts) *end_interrupts = g_vu_state.vu1_end_interrupts;
+    if (sleep_cycles) *sleep_cycles = g_vu_state.vu1_sleep_cycles;
+}
+
 // Initialize VU system with complete setup
 int vu_system_init(void) {
     printf("SPLATSTORM X: Initializing complete VU system...\n");
@@ -105,14 +322,36 @@ int vu_system_init(void) {
     *VU1_STAT = 0x0002;  // Reset VU1
     while (*VU1_STAT & 0x0002);  // Wait for reset complete
     
+    // Every program becomes an overlay: batches pull in whichever one they use
+    if (vu_microcode_manager_init() != GAUSSIAN_SUCCESS) {
+        printf("SPLATSTORM X: Failed to initialize VU microcode manager\n");
+        return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
+    }
+    vu_microcode_invalidate(VU_UNIT_VU1);
+    
+    for (u32 i = 0; i < VU1_MICROCODE_VARIANT_COUNT; i++) {
+        g_vu_state.microcode_program[i] = vu_microcode_register(VU_UNIT_VU1, g_vu1_variants[i].name,
+                                                                g_vu1_variants[i].start, g_vu1_variants[i].end);
+        if (g_vu_state.microcode_program[i] < 0) {
+            printf("SPLATSTORM X: VU1 microcode %s not registered\n", g_vu1_variants[i].name);
+        }
+    }
+    
     // Allocate DMA buffers (cache-aligned)
     g_vu_state.dma_upload_size = MAX_DMA_PACKET_SIZE * sizeof(u64);
     g_vu_state.dma_download_size = MAX_DMA_PACKET_SIZE * sizeof(u64);
     
-    g_vu_state.dma_upload_buffer = (u64*)memalign(CACHE_LINE_SIZE, g_vu_state.dma_upload_size);
-    g_vu_state.dma_download_buffer = (u64*)memalign(CACHE_LINE_SIZE, g_vu_state.dma_download_size);
+    g_vu_state.dma_upload_buffer = (u64*)memory_alloc(MEMORY_BUDGET_DMA, g_vu_state.dma_upload_size, CACHE_LINE_SIZE);
+    g_vu_state.dma_download_buffer = (u64*)memory_alloc(MEMORY_BUDGET_DMA, g_vu_state.dma_download_size, CACHE_LINE_SIZE);
+    
+    for (int i = 0; i < 2; i++) {
+        g_vu_state.batch_packets[i] = (u32*)memory_alloc(MEMORY_BUDGET_DMA, BATCH_PACKET_QWORDS * 16, CACHE_LINE_SIZE);
+        g_vu_state.batch_packet_qwords[i] = 0;
+        g_vu_state.batch_packet_bytes[i] = 0;
+    }
     
-    if (!g_vu_state.dma_upload_buffer || !g_vu_state.dma_download_buffer) {
+    if (!g_vu_state.dma_upload_buffer || !g_vu_state.dma_download_buffer ||
+        !g_vu_state.batch_packets[0] || !g_vu_state.batch_packets[1]) {
         printf("SPLATSTORM X: Failed to allocate DMA buffers\n");
         vu_system_cleanup();
         return GAUSSIAN_ERROR_MEMORY_ALLOCATION;
@@ -122,7 +361,15 @@ int vu_system_init(void) {
     g_vu_state.current_buffer = 0;
     g_vu_state.processing_buffer = 0;
     g_vu_state.vu_busy = false;
+    g_vu_state.render_mode = VU_RENDER_MODE_DOWNLOAD;
     g_vu_state.microcode_loaded = false;
+    g_vu_state.microcode_variant = VU1_MICROCODE_DEFAULT;
+    g_vu_state.default_variant = VU1_MICROCODE_DEFAULT;
+    g_vu_state.autotune = true;
+    memset(g_vu_state.tuned_variant, -1, sizeof(g_vu_state.tuned_variant));
+    g_vu_state.sh_cache = NULL;
+    g_vu_state.sh_cache_count = 0;
+    vu_set_sh_mode(VU_SH_MODE_OFF, VU_SH_CACHE_THRESHOLD_DEFAULT);  // The scene load turns it on when it has SH
     
     // Clear performance counters
     g_vu_state.last_kick_cycles = 0;
@@ -133,6 +380,9 @@ int vu_system_init(void) {
     g_vu_state.execute_cycles = 0;
     g_vu_state.download_cycles = 0;
     g_vu_state.vu_utilization = 0.0f;
+    g_vu_state.vu1_end_interrupts = 0;
+    g_vu_state.vu1_sleep_cycles = 0;
+    vu1_end_interrupt_install();
     
     g_vu_state.initialized = true;
     
@@ -140,398 +390,1051 @@ int vu_system_init(void) {
     return GAUSSIAN_SUCCESS;
 }
 
-// Load VU1 microcode with error checking
-static int vu_system_load_microcode(void) {
-    if (!g_vu_state.initialized) {
+// Select one of the VU1 programs. Nothing is transferred here: the next
+// batch chain carries the MPG if VU1 no longer holds the program.
+static int vu_system_load_microcode(u32 variant) {
+    if (!g_vu_state.initialized || variant >= VU1_MICROCODE_VARIANT_COUNT) {
         return GAUSSIAN_ERROR_VU_INITIALIZATION;
     }
     
-    if (g_vu_state.microcode_loaded) {
-        return GAUSSIAN_SUCCESS;  // Already loaded
-    }
-    
-    printf("SPLATSTORM X: Loading VU1 microcode...\n");
-    
-    // Calculate microcode size
-    u32 microcode_size = (u32)vu1_gaussian_projection_end - (u32)vu1_gaussian_projection_start;
-    u32 microcode_qwords = (microcode_size + 15) / 16;  // Round up to qwords
-    
-    if (microcode_qwords > 1024) {  // VU1 has 16KB = 1024 qwords of code memory
-        printf("SPLATSTORM X: Microcode too large (%u qwords, max 1024)\n", microcode_qwords);
+    if (g_vu_state.microcode_program[variant] < 0) {
+        printf("SPLATSTORM X: VU1 microcode %s unavailable\n", g_vu1_variants[variant].name);
         return GAUSSIAN_ERROR_VU_INITIALIZATION;
     }
     
-    // Wait for VU1 to be idle
-    wait_vu1_complete();
-    
-    // Build DMA packet for microcode upload
-    u64* packet = g_vu_state.dma_upload_buffer;
-    u32 packet_qwords = 0;
-    
-    // VIF packet header
-    packet[packet_qwords++] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);  // Set cycle
-    packet[packet_qwords++] = VIF_CODE(0, 0, VIF_CMD_STMOD, 0);   // Set mode
-    packet[packet_qwords++] = VIF_CODE(VU1_MICROCODE_ADDR, 0, 0x06, 0);  // Set program address (MPGADDR)
-    packet[packet_qwords++] = VIF_CODE(0, microcode_qwords, VIF_CMD_MPG, 0);  // Upload microcode
-    
-    // Copy microcode data
-    memcpy(&packet[packet_qwords], vu1_gaussian_projection_start, microcode_size);
-    packet_qwords += microcode_qwords;
-    
-    // Pad to qword boundary
-    while (packet_qwords & 1) {
-        packet[packet_qwords++] = 0;
+    if (g_vu_state.microcode_loaded && g_vu_state.microcode_variant == variant) {
+        return GAUSSIAN_SUCCESS;  // Already selected
     }
     
-    // Flush cache before DMA
-    FlushCache(0);
-    
-    // Send DMA packet using packet2_t
-    packet2_t dma_packet;
-    packet2_reset(&dma_packet, 0);
-    packet2_add_data(&dma_packet, packet, packet_qwords);
-    dma_channel_send_packet2(&dma_packet, DMA_CHANNEL_VIF1, 0);
-    dma_channel_wait(DMA_CHANNEL_VIF1, 0);
-    
     g_vu_state.microcode_loaded = true;
+    g_vu_state.microcode_variant = variant;
     
-    printf("SPLATSTORM X: VU1 microcode loaded (%u qwords)\n", microcode_qwords);
+    printf("SPLATSTORM X: VU1 microcode %s selected (%s)\n", g_vu1_variants[variant].name,
+           vu_microcode_is_resident((u32)g_vu_state.microcode_program[variant]) ? "resident" : "loads with next batch");
     return GAUSSIAN_SUCCESS;
 }
 
 // Upload constants and matrices to VU1
-int vu_upload_constants(void* camera) {
-    const CameraFixed* cam = (const CameraFixed*)camera;
+// With a transform (object to world, row vectors) the view matrix becomes
+// transform * view and the SH camera moves into object space, so splats of
+// an instanced asset project without touching their records.
+static int vu_upload_constants_transformed(const CameraFixed* cam, const fixed16_t* transform) {
     if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
         return GAUSSIAN_ERROR_VU_INITIALIZATION;
     }
     
-    // Build constants packet
-    u64* packet = g_vu_state.dma_upload_buffer;
-    u32 packet_qwords = 0;
+    fixed16_t instance_view[16];
+    const fixed16_t* view = cam->view;
+    if (transform) {
+        matrix_multiply_4x4_fixed(transform, cam->view, instance_view);
+        view = instance_view;
+    }
     
-    // VIF header for constants upload
-    packet[packet_qwords++] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
-    packet[packet_qwords++] = VIF_CODE(VU1_CONSTANTS_BASE, CONSTANTS_QWORDS, 0x6C, 0);  // UNPACK V4-32
+    // One block from VU1_SH_TABLE to the top of data memory: SH, atlas and
+    // covariance scale tables, then the constants and matrices. Nothing is
+    // sent here; the next batch chain unpacks it ahead of its splats.
+    float* block = (float*)g_vu_state.dma_upload_buffer;
+    float* constants = &block[(SH_TABLE_QWORDS + ATLAS_TABLE_QWORDS + COV_SCALE_TABLE_QWORDS) * 4];
     
     // Mathematical constants (qword 0)
-    float* constants = (float*)&packet[packet_qwords];
     constants[0] = 0.5f;    // Half
     constants[1] = 1.0f;    // One
     constants[2] = 2.0f;    // Two
     constants[3] = 3.0f;    // Three
-    packet_qwords++;
+    constants += 4;
     
     // Regularization constants (qword 1)
-    constants = (float*)&packet[packet_qwords];
     constants[0] = 1e-6f;   // Epsilon for regularization
     constants[1] = 1e-3f;   // Numerical stability threshold
-    constants[2] = 0.0f;    // Unused
+    constants[2] = 0.3f;    // Low-pass filter: pixels^2 added to the 2D covariance diagonal
     constants[3] = 0.0f;    // Unused
-    packet_qwords++;
+    constants += 4;
     
     // Cutoff parameters (qword 2)
-    constants = (float*)&packet[packet_qwords];
     constants[0] = 3.0f;    // 3-sigma cutoff
     constants[1] = 9.0f;    // 3-sigma squared
     constants[2] = 4.0f;    // Four (for determinant)
     constants[3] = 0.0f;    // Unused
-    packet_qwords++;
+    constants += 4;
     
     // Viewport transform (qword 3)
-    constants = (float*)&packet[packet_qwords];
     constants[0] = fixed_to_float(cam->viewport[0]);  // x offset
     constants[1] = fixed_to_float(cam->viewport[1]);  // y offset
     constants[2] = fixed_to_float(cam->viewport[2]);  // width
     constants[3] = fixed_to_float(cam->viewport[3]);  // height
-    packet_qwords++;
+    constants += 4;
     
     // View matrix (4 qwords)
     for (int i = 0; i < 4; i++) {
-        constants = (float*)&packet[packet_qwords];
         for (int j = 0; j < 4; j++) {
-            constants[j] = fixed_to_float(cam->view[i*4 + j]);
+            constants[j] = fixed_to_float(view[i*4 + j]);
         }
-        packet_qwords++;
+        constants += 4;
     }
     
     // Projection matrix (4 qwords)
     for (int i = 0; i < 4; i++) {
-        constants = (float*)&packet[packet_qwords];
         for (int j = 0; j < 4; j++) {
             constants[j] = fixed_to_float(cam->proj[i*4 + j]);
         }
-        packet_qwords++;
+        constants += 4;
     }
     
-    // Pad remaining constants space
-    while (packet_qwords < 2 + CONSTANTS_QWORDS) {
-        packet[packet_qwords++] = 0;
+    // Screen mapping constants (qwords 12-15), used by both download and XGKICK modes
+    float half_w = fixed_to_float(cam->viewport[2]) * 0.5f;
+    float half_h = fixed_to_float(cam->viewport[3]) * 0.5f;
+    
+    // Qword 12: color scale, RGBA arrives as 0-255 integers (GS alpha 0x80 = 1.0)
+    constants[0] = 1.0f;
+    constants[1] = 1.0f;
+    constants[2] = 1.0f;
+    constants[3] = 128.0f / 255.0f;
+    constants += 4;
+    
+    // Qword 13: NDC to screen scale, depth scale, radius scale (3 sigma * focal)
+    constants[0] = half_w;
+    constants[1] = -half_h;
+    constants[2] = 16777215.0f;  // 24-bit Z, larger = nearer
+    constants[3] = 3.0f * fixed_to_float(cam->proj[0]) * half_w;
+    constants += 4;
+    
+    // Qword 14: screen offset
+    constants[0] = fixed_to_float(cam->viewport[0]) + half_w;
+    constants[1] = fixed_to_float(cam->viewport[1]) + half_h;
+    constants[2] = 0.0f;
+    constants[3] = 0.0f;
+    constants += 4;
+    
+    // Qword 15: 3 sigma cull half extents, step scale, depth of the near limit
+    // (splats closer than the stability threshold project past it)
+    constants[0] = half_w;
+    constants[1] = half_h;
+    constants[2] = 1.2676506e30f;  // 2^100: clamp(d * scale, 0, 1) is a step at d = 0
+    constants[3] = 16777215.0f / 1e-3f;
+    
+    // Tables below the constants: SH, footprint atlas, and the covariance
+    // scale the microprogram looks up by each splat's raw cov_exp nibble
+    float* sh = block;
+    
+    // Qword 0: camera position for the view direction, color clamp
+    for (int i = 0; i < 3; i++) {
+        g_vu_state.sh_camera[i] = fixed_to_float(cam->position[i]);
+    }
+    if (transform) {
+        // Object space camera: (position - translation) times the inverse
+        // of the upper 3x3, by cofactors since the transform may scale
+        float m[9], d[3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                m[i*3 + j] = fixed_to_float(transform[i*4 + j]);
+            }
+            d[i] = g_vu_state.sh_camera[i] - fixed_to_float(transform[12 + i]);
+        }
+        float c[9] = {
+            m[4]*m[8] - m[5]*m[7], m[5]*m[6] - m[3]*m[8], m[3]*m[7] - m[4]*m[6],
+            m[2]*m[7] - m[1]*m[8], m[0]*m[8] - m[2]*m[6], m[1]*m[6] - m[0]*m[7],
+            m[1]*m[5] - m[2]*m[4], m[2]*m[3] - m[0]*m[5], m[0]*m[4] - m[1]*m[3],
+        };
+        float det = m[0]*c[0] + m[1]*c[1] + m[2]*c[2];
+        float inv_det = (fabsf(det) > 1e-12f) ? 1.0f / det : 0.0f;
+        // d * M^-1 with M^-1 = transpose(cofactors) / det: row j of c dotted with d
+        for (int j = 0; j < 3; j++) {
+            g_vu_state.sh_camera[j] = (d[0]*c[j*3] + d[1]*c[j*3 + 1] + d[2]*c[j*3 + 2]) * inv_det;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        sh[i] = g_vu_state.sh_camera[i];
+    }
+    sh[3] = 255.0f;
+    
+    // Qwords 1-2: real SH basis constants with their signs, per coefficient
+    // lane (sh2..5, then sh6..8 and sh1 in w), times Q1.15 to color units
+    const float sh_scale = 255.0f / 32768.0f;
+    sh[4] = 0.488603f * sh_scale;    // sh2: z
+    sh[5] = -0.488603f * sh_scale;   // sh3: x
+    sh[6] = 1.092548f * sh_scale;    // sh4: xy
+    sh[7] = -1.092548f * sh_scale;   // sh5: yz
+    sh[8] = 0.315392f * sh_scale;    // sh6: 2z^2 - x^2 - y^2
+    sh[9] = -1.092548f * sh_scale;   // sh7: xz
+    sh[10] = 0.546274f * sh_scale;   // sh8: x^2 - y^2
+    sh[11] = -0.488603f * sh_scale;  // sh1: y
+    
+    float* atlas = &sh[SH_TABLE_QWORDS * 4];
+    
+    // Qwords 0-1: 1 / 8^(k/7), the aspect at which row k starts (8:1 in row 7)
+    for (int k = 1; k < 8; k++) {
+        atlas[k - 1] = powf(8.0f, -(float)k / 7.0f);
+    }
+    atlas[7] = 0.0f;  // No eighth row
+    
+    // Qword 2: mip level k applies below a radius of half its cell size, or
+    // below that of level k - bias; levels up to the bias always apply
+    u32 mip_bias = footprint_get_mip_bias();
+    for (u32 k = 1; k < 4; k++) {
+        if (k >= FOOTPRINT_MIP_LEVELS) {
+            atlas[8 + k - 1] = 0.0f;
+        } else if (k <= mip_bias) {
+            atlas[8 + k - 1] = 1e6f;
+        } else {
+            atlas[8 + k - 1] = (float)(FOOTPRINT_RES >> (k - mip_bias)) * 0.5f;
+        }
+    }
+    atlas[11] = 0.0f;
+    
+    // Qword 3: column from the sign steps s (lower half) and t (steeper than 45 degrees)
+    atlas[12] = 7.0f;
+    atlas[13] = 1.0f;
+    atlas[14] = -2.0f;
+    atlas[15] = 0.0f;
+    
+    // Qword 4: column, row and level weights above alpha in the download result
+    atlas[16] = (float)(1 << VU1_PACK_CELL_SHIFT);
+    atlas[17] = (float)(8 << VU1_PACK_CELL_SHIFT);
+    atlas[18] = (float)(1 << VU1_PACK_LEVEL_SHIFT);
+    atlas[19] = 0.0f;
+    
+    // Qwords 5+: cell origin and size (texels) per mip level, for the sprite UVs
+    for (u32 level = 0; level < FOOTPRINT_MIP_LEVELS; level++) {
+        float* entry = &atlas[(5 + level) * 4];
+        u32 u, v;
+        footprint_atlas_cell(0, level, &u, &v);
+        entry[0] = (float)u;
+        entry[1] = (float)v;
+        entry[2] = (float)(FOOTPRINT_RES >> level);
+        entry[3] = 0.0f;
     }
     
-    // Flush cache and send using packet2_t
-    packet2_t dma_packet;
-    packet2_reset(&dma_packet, 0);
-    packet2_add_data(&dma_packet, packet, packet_qwords);
-    FlushCache(0);
-    dma_channel_send_packet2(&dma_packet, DMA_CHANNEL_VIF1, 0);
-    dma_channel_wait(DMA_CHANNEL_VIF1, 0);
+    for (int e = 0; e < COV_SCALE_TABLE_QWORDS; e++) {
+        float* entry = &atlas[(ATLAS_TABLE_QWORDS + e) * 4];
+        float scale = (float)(1 << e) / 128.0f;  // 2^(e - 7)
+        entry[0] = scale / 256.0f;               // Q8.8 mantissa
+        entry[1] = scale / 16777216.0f;          // cov_mant[0], read as the top half of a word
+        entry[2] = 0.0f;
+        entry[3] = scale;
+    }
     
+    g_vu_state.constants_pending = true;
+    g_vu_state.instance_constants = (transform != NULL);
     return 0; // Success
 }
 
-// Process batch of splats with double buffering
-int vu_process_batch(void* visible_splats, u32 visible_count, void* projected_splats, u32* projected_count) {
-    const GaussianSplat3D* input_splats = (const GaussianSplat3D*)visible_splats;
-    GaussianSplat2D* output_splats = (GaussianSplat2D*)projected_splats;
-    u32 splat_count = visible_count;
-    u32* processed_count = projected_count;
-    
-    if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
-        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+int vu_upload_constants(void* camera) {
+    return vu_upload_constants_transformed((const CameraFixed*)camera, NULL);
+}
+
+// Constants for one instance of an asset; the SH cache is bypassed until
+// the next vu_upload_constants(), its entries belong to scene splats.
+// Waits for VU1, earlier batches still read the current constants.
+int vu_upload_instance_constants(void* camera, const fixed16_t transform[16]) {
+    if (!camera || !transform) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    vu_wait_vu1_idle();
+    return vu_upload_constants_transformed((const CameraFixed*)camera, transform);
+}
+
+// A batch sent to VU1 whose output has not been read yet
+typedef struct {
+    u32 offset;                               // First splat of the batch
+    u32 count;
+    u32 buffer;                               // VU1 buffer pair
+} VUPendingBatch;
+
+// Read one finished batch out of its output buffer
+static GaussianResult vu_drain_batch(const GaussianSplat3D* input_splats, const u32* indices,
+                                     const VUPendingBatch* batch, GaussianSplatRender* output_splats,
+                                     u32* processed_count, bool drain_results, bool drain_colors) {
+    if (drain_colors) {
+        vu_store_sh_colors(input_splats, &indices[batch->offset], batch->count, batch->buffer);
+    }
+    if (!drain_results) {
+        *processed_count += batch->count;
+        return GAUSSIAN_SUCCESS;
     }
     
-    if (!input_splats || !output_splats || !processed_count || splat_count == 0) {
-        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    u32 stored = 0;
+    GaussianResult result = vu_download_results(&output_splats[*processed_count], batch->count,
+                                                batch->buffer, &stored);
+    *processed_count += stored;
+    return result;
+}
+
+// Run the three-stage pipeline over a splat array
+// Batch N+1 streams over VIF1 while VU1 runs batch N and the EE drains N-1.
+// The VIF holds each MSCAL until the previous program ends, so the only EE
+// sync point is the VIF1 channel: once packet N has been consumed its MSCAL
+// has issued, so batch N-1 has finished, while N may still be running. Two
+// batches are therefore pending at a time. In XGKICK mode
+// there is nothing to drain and output_splats may be NULL. With indices the
+// batches reference input_splats[indices[i]], otherwise splats are contiguous.
+// SH_FILL batches also drain their shaded colors, in both modes; it needs indices.
+static GaussianResult vu_run_batch_pipeline(const GaussianSplat3D* input_splats, const u32* indices,
+                                            u32 splat_count, GaussianSplatRender* output_splats,
+                                            u32* processed_count, u32 flags) {
+    bool drain_results = (flags & VU1_BATCH_FLAG_XGKICK) == 0;
+    bool drain_colors = (flags & VU1_BATCH_FLAG_SH_FILL) != 0 && indices;
+    u32 max_batch_size = drain_results ? VU1_BATCH_SIZE : VU1_KICK_BATCH_SIZE;
+    if (flags & VU1_BATCH_FLAG_SH) {
+        max_batch_size = VU1_SH_BATCH_SIZE;
     }
     
     u64 batch_start_cycles = get_cpu_cycles();
+    u64 vu_busy_cycles = 0;
     *processed_count = 0;
     
-    // Process in batches of VU1_BATCH_SIZE
+    // Batches sent and not yet drained, oldest first: N-1 and N
+    VUPendingBatch pending[2];
+    u32 pending_count = 0;
+    
     u32 remaining_splats = splat_count;
     u32 batch_offset = 0;
     
     while (remaining_splats > 0) {
-        u32 current_batch_size = MIN(remaining_splats, VU1_BATCH_SIZE);
+        u32 current_batch_size = MIN(remaining_splats, max_batch_size);
+        u32 buffer_id = g_vu_state.current_buffer;
         
-        // Wait for previous VU processing to complete
-        if (g_vu_state.vu_busy) {
-            wait_vu1_complete();
-            g_vu_state.vu_busy = false;
+        // Stage 1: build batch N+1 on the EE while the previous packet is in flight
+        u64 upload_start = get_cpu_cycles();
+        if (indices) {
+            vu_build_batch_packet(input_splats, &indices[batch_offset], current_batch_size, buffer_id, flags);
+        } else {
+            vu_build_batch_packet(&input_splats[batch_offset], NULL, current_batch_size, buffer_id, flags);
+        }
+        u64 upload_end = get_cpu_cycles();
+        g_vu_state.upload_cycles += upload_end - upload_start;
+        if (is_vu1_busy()) {
+            vu_busy_cycles += upload_end - upload_start;
         }
         
-        // Upload input data to current buffer
-        u64 upload_start = get_cpu_cycles();
-        GaussianResult result = vu_upload_splat_batch(&input_splats[batch_offset], 
-                                                     current_batch_size, 
-                                                     g_vu_state.current_buffer);
-        if (result != GAUSSIAN_SUCCESS) {
-            return result;
+        // Packet N consumed => its MSCAL issued => batch N-1 finished
+        u64 wait_start = get_cpu_cycles();
+        if (g_vu_state.vu_busy) {
+            dma_wait_channel(DMA_CHANNEL_VIF1);
         }
-        g_vu_state.upload_cycles += get_cpu_cycles() - upload_start;
+        u64 wait_end = get_cpu_cycles();
+        g_vu_state.execute_cycles += wait_end - wait_start;
+        vu_busy_cycles += wait_end - wait_start;
         
-        // Start VU processing
-        u64 execute_start = get_cpu_cycles();
-        result = vu_start_processing(current_batch_size);
-        if (result != GAUSSIAN_SUCCESS) {
-            return result;
+        // Stage 3: drain batch N-1 while VU1 runs batch N. N-1 used the buffer
+        // pair N+1 is about to unpack into and write, so it has to be read first.
+        if (pending_count == 2) {
+            u64 download_start = get_cpu_cycles();
+            GaussianResult result = vu_drain_batch(input_splats, indices, &pending[0], output_splats,
+                                                   processed_count, drain_results, drain_colors);
+            if (result != GAUSSIAN_SUCCESS) {
+                return result;
+            }
+            pending[0] = pending[1];
+            pending_count = 1;
+            u64 download_end = get_cpu_cycles();
+            g_vu_state.download_cycles += download_end - download_start;
+            if (is_vu1_busy()) {
+                vu_busy_cycles += download_end - download_start;
+            }
         }
         
-        g_vu_state.vu_busy = true;
-        g_vu_state.processing_buffer = g_vu_state.current_buffer;
-        g_vu_state.last_kick_cycles = execute_start;
+        // Stage 2: hand batch N+1 to VIF1 without waiting; it unpacks while
+        // VU1 is still busy and stalls on MSCAL until the running batch ends
+        vu_send_batch_packet(buffer_id);
         
-        // Switch to other buffer for next batch
-        g_vu_state.current_buffer = 1 - g_vu_state.current_buffer;
+        g_vu_state.vu_busy = true;
+        g_vu_state.processing_buffer = buffer_id;
+        g_vu_state.last_kick_cycles = get_cpu_cycles();
         
-        // Wait for processing to complete
-        wait_vu1_complete();
-        g_vu_state.vu_busy = false;
-        g_vu_state.execute_cycles += get_cpu_cycles() - execute_start;
+        // Drain the batch just sent two iterations on (or after the loop)
+        pending[pending_count].offset = batch_offset;
+        pending[pending_count].count = current_batch_size;
+        pending[pending_count].buffer = buffer_id;
+        pending_count++;
         
-        // Download results
-        u64 download_start = get_cpu_cycles();
-        result = vu_download_results(&output_splats[batch_offset], current_batch_size);
-        if (result != GAUSSIAN_SUCCESS) {
-            return result;
-        }
-        g_vu_state.download_cycles += get_cpu_cycles() - download_start;
+        // Switch to other buffer pair for next batch
+        g_vu_state.current_buffer = 1 - g_vu_state.current_buffer;
         
-        // Update counters
-        *processed_count += current_batch_size;
         remaining_splats -= current_batch_size;
         batch_offset += current_batch_size;
         g_vu_state.batches_processed++;
         g_vu_state.splats_processed += current_batch_size;
     }
     
+    // Flush the pipeline: wait for the last program, then drain what is left
+    u64 wait_start = get_cpu_cycles();
+    dma_wait_channel(DMA_CHANNEL_VIF1);
+    wait_vu1_complete();
+    g_vu_state.vu_busy = false;
+    u64 wait_end = get_cpu_cycles();
+    g_vu_state.execute_cycles += wait_end - wait_start;
+    vu_busy_cycles += wait_end - wait_start;
+    
+    u64 download_start = get_cpu_cycles();
+    for (u32 p = 0; p < pending_count; p++) {
+        GaussianResult result = vu_drain_batch(input_splats, indices, &pending[p], output_splats,
+                                               processed_count, drain_results, drain_colors);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+    }
+    g_vu_state.download_cycles += get_cpu_cycles() - download_start;
+    
     // Update performance statistics
     u64 total_batch_cycles = get_cpu_cycles() - batch_start_cycles;
     g_vu_state.total_cycles += total_batch_cycles;
     
-    // Calculate VU utilization (execution time / total time)
+    // VU utilization: share of this call during which VU1 was observed busy
     if (total_batch_cycles > 0) {
-        g_vu_state.vu_utilization = (float)g_vu_state.execute_cycles / (float)total_batch_cycles;
+        g_vu_state.vu_utilization = (float)vu_busy_cycles / (float)total_batch_cycles;
+        if (g_vu_state.vu_utilization > 1.0f) {
+            g_vu_state.vu_utilization = 1.0f;
+        }
     }
     
-    return 0; // Success
+    return GAUSSIAN_SUCCESS;
 }
 
-// Upload splat batch to VU1 memory
-static GaussianResult vu_upload_splat_batch(const GaussianSplat3D* splats, u32 count, u32 buffer_id) {
-    if (count > VU1_BATCH_SIZE) {
+// Camera-to-splat vector for the SH view direction; returns its squared length
+static float vu_sh_view_vector(const GaussianSplat3D* splat, float v[3]) {
+    for (int i = 0; i < 3; i++) {
+        v[i] = fixed_to_float(splat->pos[i]) - g_vu_state.sh_camera[i];
+    }
+    return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+}
+
+// A cached color holds while the view direction stays within the threshold
+// angle of the one it was shaded for: cos^2 compared without a square root
+static bool vu_sh_cache_fresh(const SHColorCacheEntry* entry, const GaussianSplat3D* splat) {
+    float v[3];
+    float length_sq = vu_sh_view_vector(splat, v);
+    float cos_length = v[0] * entry->dir[0] + v[1] * entry->dir[1] + v[2] * entry->dir[2];
+    return cos_length > 0.0f && cos_length * cos_length >= g_vu_state.sh_cache_cos2 * length_sq;
+}
+
+// Run the pipeline with view-dependent color per the SH mode
+// FULL shades every splat. CACHED splits them: splats whose cached color
+// still holds DMA the cache entry as their color qword and skip SH, the
+// rest are shaded in their own batches and refill their entries. The
+// shaded pass goes first; output was never in depth order, so the tile
+// sort and the PATH1 kick do not care.
+static GaussianResult vu_run_shaded_pipeline(const GaussianSplat3D* splats, const u32* indices, u32 count,
+                                             GaussianSplatRender* output_splats, u32* processed_count,
+                                             u32 flags) {
+    if (g_vu_state.sh_mode == VU_SH_MODE_OFF) {
+        return vu_run_batch_pipeline(splats, indices, count, output_splats, processed_count, flags);
+    }
+    
+    // The cache is per scene record, so it needs indices
+    u32* order = NULL;
+    if (g_vu_state.sh_mode == VU_SH_MODE_CACHED && indices && g_vu_state.sh_cache &&
+        !g_vu_state.instance_constants) {
+        order = (u32*)frame_arena_alloc(count * sizeof(u32), CACHE_LINE_SIZE);
+    }
+    if (!order) {
+        return vu_run_batch_pipeline(splats, indices, count, output_splats, processed_count,
+                                     flags | VU1_BATCH_FLAG_SH);
+    }
+    
+    // Shaded splats from the front, cache hits from the back
+    u32 shaded = 0;
+    u32 reused = count;
+    for (u32 i = 0; i < count; i++) {
+        u32 index = indices[i];
+        if (index < g_vu_state.sh_cache_count && vu_sh_cache_fresh(&g_vu_state.sh_cache[index], &splats[index])) {
+            order[--reused] = index;
+        } else {
+            order[shaded++] = index;
+        }
+    }
+    
+    u32 shaded_count = 0;
+    u32 reused_count = 0;
+    if (shaded > 0) {
+        GaussianResult result = vu_run_batch_pipeline(splats, order, shaded, output_splats, &shaded_count,
+                                                      flags | VU1_BATCH_FLAG_SH | VU1_BATCH_FLAG_SH_FILL);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+    }
+    if (shaded < count) {
+        GaussianResult result = vu_run_batch_pipeline(splats, &order[shaded], count - shaded,
+                                                      output_splats ? &output_splats[shaded_count] : NULL,
+                                                      &reused_count, flags | VU1_BATCH_FLAG_SH_CACHED);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+    }
+    
+    *processed_count = shaded_count + reused_count;
+    return GAUSSIAN_SUCCESS;
+}
+
+// Process batch of splats, reading projected results back to EE RAM
+// projected_splats receives one GaussianSplatRender per splat that survives
+// the VU1 3 sigma cull; projected_count is the number of survivors.
+int vu_process_batch(void* visible_splats, u32 visible_count, void* projected_splats, u32* projected_count) {
+    const GaussianSplat3D* input_splats = (const GaussianSplat3D*)visible_splats;
+    GaussianSplatRender* output_splats = (GaussianSplatRender*)projected_splats;
+    
+    if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    
+    if (!input_splats || !output_splats || !projected_count || visible_count == 0) {
         return GAUSSIAN_ERROR_INVALID_PARAMETER;
     }
     
-    // Determine target VU1 address
-    u32 vu_address = (buffer_id == 0) ? VU1_INPUT_BUFFER_A : VU1_INPUT_BUFFER_B;
+    return vu_run_shaded_pipeline(input_splats, NULL, visible_count, output_splats, projected_count, 0);
+}
+
+// Process visible splats in place: indices select records of the resident
+// scene array, which VIF1 reads directly through DMA REF tags
+int vu_process_indexed(const GaussianSplat3D* scene_splats, const u32* indices, u32 count,
+                       GaussianSplatRender* projected_splats, u32* projected_count) {
+    if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
     
-    // Build DMA packet
-    u64* packet = g_vu_state.dma_upload_buffer;
-    u32 packet_qwords = 0;
+    if (!scene_splats || !indices || !projected_splats || !projected_count || count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    return vu_run_shaded_pipeline(scene_splats, indices, count, projected_splats, projected_count, 0);
+}
+
+// Project and render splats entirely on VU1 (PATH1)
+// The microprogram builds sprite GIF packets in its output buffer and
+// XGKICKs them, so projected data never returns over the EE bus. GS drawing
+// state (texture, alpha, scissor) must already be set up by the caller.
+int vu_render_batch_direct(void* visible_splats, u32 visible_count, u32* kicked_count) {
+    const GaussianSplat3D* input_splats = (const GaussianSplat3D*)visible_splats;
+    
+    if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    
+    if (!input_splats || !kicked_count || visible_count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    return vu_run_shaded_pipeline(input_splats, NULL, visible_count, NULL, kicked_count, VU1_BATCH_FLAG_XGKICK);
+}
+
+// Direct PATH1 rendering of indexed scene splats (see vu_process_indexed)
+int vu_render_indexed_direct(const GaussianSplat3D* scene_splats, const u32* indices, u32 count,
+                             u32* kicked_count) {
+    if (!g_vu_state.initialized || !g_vu_state.microcode_loaded) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    
+    if (!scene_splats || !indices || !kicked_count || count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    return vu_run_shaded_pipeline(scene_splats, indices, count, NULL, kicked_count, VU1_BATCH_FLAG_XGKICK);
+}
+
+// Select how render_frame consumes VU1 output
+void vu_set_render_mode(u32 mode) {
+    if (mode != VU_RENDER_MODE_DOWNLOAD && mode != VU_RENDER_MODE_XGKICK) {
+        return;
+    }
+    
+    g_vu_state.render_mode = mode;
+    printf("SPLATSTORM X: VU render mode: %s\n",
+           (mode == VU_RENDER_MODE_XGKICK) ? "VU1 XGKICK (PATH1)" : "EE download");
+}
+
+u32 vu_get_render_mode(void) {
+    return g_vu_state.render_mode;
+}
+
+// Select view-dependent color: off, shaded every frame, or cached until the
+// view direction of a splat turns by more than threshold_degrees
+void vu_set_sh_mode(u32 mode, float threshold_degrees) {
+    if (mode != VU_SH_MODE_OFF && mode != VU_SH_MODE_FULL && mode != VU_SH_MODE_CACHED) {
+        return;
+    }
     
-    // VIF header
-    packet[packet_qwords++] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
-    packet[packet_qwords++] = VIF_CODE(vu_address, count * SPLAT_INPUT_QWORDS, 0x6C, 0);  // UNPACK V4-32
+    float cos_threshold = cosf(threshold_degrees * (float)M_PI / 180.0f);
+    g_vu_state.sh_mode = mode;
+    g_vu_state.sh_cache_cos2 = cos_threshold * cos_threshold;
     
-    // Pack splat data for VU1
+    // Entries shaded under another mode or threshold are not trusted
+    if (g_vu_state.sh_cache) {
+        memset(g_vu_state.sh_cache, 0, g_vu_state.sh_cache_count * sizeof(SHColorCacheEntry));
+    }
+    
+    printf("SPLATSTORM X: VU SH color: %s\n",
+           (mode == VU_SH_MODE_CACHED) ? "VU1, cached" : (mode == VU_SH_MODE_FULL) ? "VU1, every frame" : "off");
+}
+
+u32 vu_get_sh_mode(void) {
+    return g_vu_state.sh_mode;
+}
+
+// Size the SH color cache for a scene and invalidate every entry
+int vu_sh_cache_init(u32 splat_count) {
+    if (!g_vu_state.initialized) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    
+    if (splat_count > g_vu_state.sh_cache_count) {
+        if (g_vu_state.sh_cache) {
+            memory_free(g_vu_state.sh_cache);
+        }
+        g_vu_state.sh_cache = (SHColorCacheEntry*)memory_alloc(MEMORY_BUDGET_SCENE,
+                                                              splat_count * sizeof(SHColorCacheEntry),
+                                                              CACHE_LINE_SIZE);
+        g_vu_state.sh_cache_count = g_vu_state.sh_cache ? splat_count : 0;
+        if (!g_vu_state.sh_cache) {
+            return GAUSSIAN_ERROR_MEMORY_ALLOCATION;  // SH still runs, uncached
+        }
+    }
+    
+    memset(g_vu_state.sh_cache, 0, g_vu_state.sh_cache_count * sizeof(SHColorCacheEntry));
+    return GAUSSIAN_SUCCESS;
+}
+
+// Forget the cached colors of splats whose color, opacity or SH changed
+void vu_sh_cache_invalidate(u32 first, u32 count) {
+    if (!g_vu_state.sh_cache || first >= g_vu_state.sh_cache_count) return;
+    
+    count = MIN(count, g_vu_state.sh_cache_count - first);
+    memset(&g_vu_state.sh_cache[first], 0, count * sizeof(SHColorCacheEntry));
+}
+
+// Auto-tune sample: scene indices, their EE reference and the VU1 readback
+static u32 g_autotune_indices[VU1_AUTOTUNE_SPLATS];
+static GaussianSplatRender g_autotune_reference[VU1_AUTOTUNE_SPLATS] __attribute__((aligned(16)));
+static GaussianSplatRender g_autotune_output[VU1_AUTOTUNE_SPLATS] __attribute__((aligned(16)));
+
+// Density class of a scene: 0 below 1K splats, then one class per doubling
+static u32 vu_autotune_density_class(u32 splat_count) {
+    u32 density_class = 0;
+    while (density_class < VU1_AUTOTUNE_DENSITY_CLASSES - 1 &&
+           splat_count >= (VU1_AUTOTUNE_DENSITY_BASE << density_class)) {
+        density_class++;
+    }
+    return density_class;
+}
+
+// Pick sample splats evenly over the scene and project them on the EE.
+// Scenes are stored in importance and octree order, so a stride covers both.
+static u32 vu_autotune_build_sample(const GaussianSplat3D* splats, u32 splat_count, const CameraFixed* camera) {
+    u32 stride = MAX(1, splat_count / (VU1_AUTOTUNE_SPLATS * 4));
+    u32 sample_count = 0;
+    
+    for (u32 i = 0; i < splat_count && sample_count < VU1_AUTOTUNE_SPLATS; i += stride) {
+        GaussianSplat2D projected;
+        if (project_gaussian_complete(&splats[i], camera, &projected) != GAUSSIAN_SUCCESS) {
+            continue;  // Culled or behind the camera: VU1 output is undefined
+        }
+        
+        GaussianSplatRender* reference = &g_autotune_reference[sample_count];
+        reference->screen_x = (s16)(projected.screen_pos[0] >> (FIXED16_SHIFT - RENDER_SPLAT_SUBPIXEL_SHIFT));
+        reference->screen_y = (s16)(projected.screen_pos[1] >> (FIXED16_SHIFT - RENDER_SPLAT_SUBPIXEL_SHIFT));
+        memcpy(reference->color, projected.color, 3);
+        reference->color[3] = (u8)(((u32)projected.color[3] * 0x80) / 255);  // GS alpha scale
+        
+        g_autotune_indices[sample_count++] = i;
+    }
+    
+    return sample_count;
+}
+
+// Screen position within a pixel, exact RGB, alpha within an LSB
+static bool vu_autotune_output_matches(u32 count) {
     for (u32 i = 0; i < count; i++) {
-        const GaussianSplat3D* splat = &splats[i];
-        float* data = (float*)&packet[packet_qwords];
-        
-        // Qword 0: position.xyz, cov_exp
-        data[0] = fixed_to_float(splat->pos[0]);
-        data[1] = fixed_to_float(splat->pos[1]);
-        data[2] = fixed_to_float(splat->pos[2]);
-        data[3] = (float)(1 << (splat->cov_exp - 7));  // Convert exp to scale factor
-        packet_qwords++;
+        const GaussianSplatRender* vu = &g_autotune_output[i];
+        const GaussianSplatRender* ee = &g_autotune_reference[i];
         
-        // Qword 1: cov_mant[0-3]
-        data = (float*)&packet[packet_qwords];
-        for (int j = 0; j < 4; j++) {
-            data[j] = (float)splat->cov_mant[j] / FIXED8_SCALE;
+        if (abs(vu->screen_x - ee->screen_x) > VU1_AUTOTUNE_TOL_SCREEN ||
+            abs(vu->screen_y - ee->screen_y) > VU1_AUTOTUNE_TOL_SCREEN ||
+            memcmp(vu->color, ee->color, 3) != 0 ||
+            abs(vu->color[3] - ee->color[3]) > VU1_AUTOTUNE_TOL_ALPHA) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fill both output buffers with a value that cannot pass verification, so a
+// program that never writes them is not credited with the previous one's results
+static void vu_autotune_poison_outputs(void) {
+    for (int i = 0; i < 2; i++) {
+        u32 output_address = (i == 0) ? VU1_OUTPUT_BUFFER_A : VU1_OUTPUT_BUFFER_B;
+        volatile u32* vu_output = (volatile u32*)(VU1_DATA_MEM + output_address * 16);
+        for (u32 j = 0; j < (OUTPUT_COUNT_QWORDS + VU1_BATCH_SIZE * SPLAT_OUTPUT_QWORDS) * 4; j++) {
+            vu_output[j] = VU1_OUTPUT_POISON;
+        }
+    }
+}
+
+/*
+ * Select the fastest VU1 program that reproduces the EE projection
+ * A sample of scene splats the EE finds visible runs through every program
+ * in download mode. Output off by more than a pixel, or in color, rules the
+ * program out; the others are timed over VU1_AUTOTUNE_RUNS runs and the
+ * fastest stays loaded with the camera constants uploaded. The choice is
+ * cached per scene density class, so a later scene of similar size reuses it
+ * without running anything. If no program matches, the default one set with
+ * vu_set_default_microcode() is loaded; with auto-tuning off it always is.
+ */
+int vu_autotune_microcode(const GaussianSplat3D* splats, u32 splat_count, const CameraFixed* camera) {
+    if (!g_vu_state.initialized) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    
+    if (!splats || !camera || splat_count == 0) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
+    
+    if (!g_vu_state.autotune) {
+        int result = vu_system_load_microcode(g_vu_state.default_variant);
+        if (result != GAUSSIAN_SUCCESS) {
+            result = vu_system_load_microcode(VU1_MICROCODE_DEFAULT);
+        }
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+        return vu_upload_constants((void*)camera);
+    }
+    
+    u32 density_class = vu_autotune_density_class(splat_count);
+    if (g_vu_state.tuned_variant[density_class] >= 0) {
+        int result = vu_system_load_microcode((u32)g_vu_state.tuned_variant[density_class]);
+        if (result != GAUSSIAN_SUCCESS) {
+            return result;
+        }
+        return vu_upload_constants((void*)camera);
+    }
+    
+    u32 sample_count = vu_autotune_build_sample(splats, splat_count, camera);
+    printf("SPLATSTORM X: Auto-tuning VU1 microcode on %u of %u splats\n", sample_count, splat_count);
+    
+    u32 best_variant = g_vu_state.default_variant;
+    u64 best_cycles = 0;
+    bool found = false;
+    
+    for (u32 variant = 0; variant < VU1_MICROCODE_VARIANT_COUNT && sample_count > 0; variant++) {
+        const char* name = g_vu1_variants[variant].name;
+        if (vu_system_load_microcode(variant) != GAUSSIAN_SUCCESS ||
+            vu_upload_constants((void*)camera) != GAUSSIAN_SUCCESS) {
+            printf("SPLATSTORM X: VU1 microcode %s failed to load, skipped\n", name);
+            continue;
         }
-        packet_qwords++;
         
-        // Qword 2: cov_mant[4-8] (only use first 5 elements)
-        data = (float*)&packet[packet_qwords];
-        for (int j = 0; j < 4; j++) {
-            if (j + 4 < 9) {
-                data[j] = (float)splat->cov_mant[j + 4] / FIXED8_SCALE;
-            } else {
-                data[j] = 0.0f;
+        // Correctness first, on a single run into poisoned output buffers
+        u32 processed = 0;
+        vu_autotune_poison_outputs();
+        GaussianResult result = vu_run_batch_pipeline(splats, g_autotune_indices, sample_count,
+                                                      g_autotune_output, &processed, 0);
+        if (result != GAUSSIAN_SUCCESS || processed != sample_count ||
+            !vu_autotune_output_matches(sample_count)) {
+            printf("SPLATSTORM X: VU1 microcode %s does not match the EE projection\n", name);
+            continue;
+        }
+        
+        // Best of several runs, so a cache miss or DMA stall does not decide
+        u64 cycles = 0;
+        for (int run = 0; run < VU1_AUTOTUNE_RUNS; run++) {
+            u64 run_start = get_cpu_cycles();
+            vu_run_batch_pipeline(splats, g_autotune_indices, sample_count, g_autotune_output, &processed, 0);
+            u64 run_cycles = get_cpu_cycles() - run_start;
+            if (run == 0 || run_cycles < cycles) {
+                cycles = run_cycles;
             }
         }
-        packet_qwords++;
         
-        // Qword 3: color.rgb, opacity
-        data = (float*)&packet[packet_qwords];
-        data[0] = (float)splat->color[0] / 255.0f;
-        data[1] = (float)splat->color[1] / 255.0f;
-        data[2] = (float)splat->color[2] / 255.0f;
-        data[3] = (float)splat->opacity / 255.0f;
-        packet_qwords++;
+        printf("SPLATSTORM X: VU1 microcode %s: %u cycles\n", name, (u32)cycles);
+        if (!found || cycles < best_cycles) {
+            best_variant = variant;
+            best_cycles = cycles;
+            found = true;
+        }
     }
     
-    // Pad remaining batch slots with zeros
-    for (u32 i = count; i < VU1_BATCH_SIZE; i++) {
-        for (int j = 0; j < SPLAT_INPUT_QWORDS; j++) {
-            packet[packet_qwords++] = 0;
-        }
+    // Tuning runs are not frame work
+    vu_reset_performance_counters();
+    
+    if (!found) {
+        printf("SPLATSTORM X: No VU1 microcode verified, using %s\n", g_vu1_variants[best_variant].name);
     }
     
-    // Flush cache and send using packet2_t
-    packet2_t dma_packet;
-    packet2_reset(&dma_packet, 0);
-    packet2_add_data(&dma_packet, packet, packet_qwords);
-    FlushCache(0);
-    dma_channel_send_packet2(&dma_packet, DMA_CHANNEL_VIF1, 0);
-    dma_channel_wait(DMA_CHANNEL_VIF1, 0);
+    // Nothing visible from this camera proves nothing: leave the class untuned
+    if (sample_count > 0) {
+        g_vu_state.tuned_variant[density_class] = (s8)best_variant;
+    }
+    
+    int result = vu_system_load_microcode(best_variant);
+    if (result != GAUSSIAN_SUCCESS) {
+        return result;
+    }
+    
+    printf("SPLATSTORM X: VU1 microcode selected: %s\n", g_vu1_variants[best_variant].name);
+    return vu_upload_constants((void*)camera);
+}
+
+// Currently loaded VU1 program (index into the auto-tune table)
+u32 vu_get_microcode_variant(void) {
+    return g_vu_state.microcode_variant;
+}
+
+// Program a scene starts with when auto-tuning is off or verifies none.
+// Takes effect at the next vu_autotune_microcode(); past choices are dropped.
+int vu_set_default_microcode(u32 variant, bool autotune) {
+    if (!g_vu_state.initialized) {
+        return GAUSSIAN_ERROR_VU_INITIALIZATION;
+    }
+    if (variant >= VU1_MICROCODE_VARIANT_COUNT) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
     
+    g_vu_state.default_variant = variant;
+    g_vu_state.autotune = autotune;
+    memset(g_vu_state.tuned_variant, -1, sizeof(g_vu_state.tuned_variant));
+    printf("SPLATSTORM X: VU1 microcode default %s, auto-tune %s\n", g_vu1_variants[variant].name,
+           autotune ? "on" : "off");
     return GAUSSIAN_SUCCESS;
 }
 
-// Start VU1 processing
-static GaussianResult vu_start_processing(u32 splat_count) {
-    // Build execution packet
-    u64* packet = g_vu_state.dma_upload_buffer;
+// g_vu1_variants index of a program name, VU1_MICROCODE_VARIANT_COUNT if none
+u32 vu_find_microcode_variant(const char* name) {
+    for (u32 i = 0; i < VU1_MICROCODE_VARIANT_COUNT; i++) {
+        if (strcmp(name, g_vu1_variants[i].name) == 0) {
+            return i;
+        }
+    }
+    return VU1_MICROCODE_VARIANT_COUNT;
+}
+
+// Build the DMA chain for one batch. A CNT tag carries the batch header, then
+// each splat costs three REF tags into the scene array: its first qword (raw
+// Q16.16 position, cov_exp and cov_mant[0] in w) as V4-32, the covariance
+// mantissas as signed V4-16, and the qword holding color and opacity as
+// unsigned V4-8. A REF moves whole qwords, so the V4-8 unpack
+// consumes all 16 bytes and spills 3 qwords past the color slot; the next
+// splat overwrites them and the input buffer has room for the last spill.
+// SH batches add the color qword and the next one again as signed V4-16,
+// over the spill, for sh_coeffs[0..13]; SH_CACHED batches take the color
+// qword from the splat's cache entry instead of the record.
+// The END tag carries ITOP/MSCAL so the program finds its buffer via xitop.
+// Constants, header, splats, program and kick thus reach VIF1 in one DMA
+// transfer with no FLUSH: MSCAL and MPG already wait for the running program.
+static u32 vu_build_batch_packet(const GaussianSplat3D* splats, const u32* indices, u32 count,
+                                 u32 buffer_id, u32 flags) {
+    u32 input_address = (buffer_id == 0) ? VU1_INPUT_BUFFER_A : VU1_INPUT_BUFFER_B;
+    u32 output_address = (buffer_id == 0) ? VU1_OUTPUT_BUFFER_A : VU1_OUTPUT_BUFFER_B;
+    
+    u64* chain = (u64*)g_vu_state.batch_packets[buffer_id];
     u32 packet_qwords = 0;
+    u32 ref_qwords = 0;
+    
+    // New constants ride in front of the batch in one unpack. Every pipeline
+    // run starts with VU1 stopped, so they never change under a running program.
+    u32 cycle_code = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
+    if (g_vu_state.constants_pending) {
+        chain[0] = DMA_SET_TAG(CONSTANT_BLOCK_QWORDS, 0, DMA_TAG_REF, 0,
+                               (u32)g_vu_state.dma_upload_buffer & 0x0FFFFFFF, 0);
+        chain[1] = (u64)cycle_code |
+                   ((u64)VIF_CODE(VU1_SH_TABLE, CONSTANT_BLOCK_QWORDS, VIF_UNPACK_V4_32, 0) << 32);
+        cycle_code = VIF_CODE(0, 0, VIF_CMD_NOP, 0);
+        ref_qwords += CONSTANT_BLOCK_QWORDS;
+        packet_qwords++;
+        g_vu_state.constants_pending = false;
+    }
     
-    // Set splat count in VU1 register
-    packet[packet_qwords++] = VIF_CODE(0, 0, VIF_CMD_STROW, 0);
-    packet[packet_qwords++] = splat_count;  // Store count in ROW register
-    packet[packet_qwords++] = 0;
-    packet[packet_qwords++] = 0;
-    packet[packet_qwords++] = 0;
+    // Header tag: its VIF codes set the cycle and unpack the two header qwords that follow
+    chain[packet_qwords * 2] = DMA_SET_TAG(BATCH_HEADER_QWORDS, 0, DMA_TAG_CNT, 0, 0, 0);
+    chain[packet_qwords * 2 + 1] = (u64)cycle_code |
+                                   ((u64)VIF_CODE(input_address, BATCH_HEADER_QWORDS, VIF_UNPACK_V4_32, 0) << 32);
+    packet_qwords++;
     
-    // Start microcode execution
-    packet[packet_qwords++] = VIF_CODE(VU1_MICROCODE_ADDR, 0, VIF_CMD_MSCAL, 0);
+    // Batch header: splat count, output address and mode flags for the microprogram
+    u32* header = (u32*)&chain[packet_qwords * 2];
+    header[0] = count;
+    header[1] = output_address;
+    header[2] = flags;
+    header[3] = 0;
+    packet_qwords++;
     
-    // Flush cache and send using packet2_t
-    packet2_t dma_packet;
-    packet2_reset(&dma_packet, 0);
-    packet2_add_data(&dma_packet, packet, packet_qwords);
-    FlushCache(0);
-    dma_channel_send_packet2(&dma_packet, DMA_CHANNEL_VIF1, 0);
-    dma_channel_wait(DMA_CHANNEL_VIF1, 0);
+    // GIF tag the microprogram copies in front of its sprites (direct mode only)
+    u64* gif_tag = &chain[packet_qwords * 2];
+    if (flags & VU1_BATCH_FLAG_XGKICK) {
+        gif_tag[0] = (u64)count |                       // NLOOP
+                     (1ULL << 15) |                     // EOP
+                     (1ULL << 46) |                     // PRE
+                     ((gs_get_splat_prim() & 0x7FF) << 47) |
+                     (0ULL << 58) |                     // FLG = PACKED
+                     ((u64)KICK_SPLAT_QWORDS << 60);    // NREG
+        gif_tag[1] = KICK_GIF_REGS;
+    } else {
+        gif_tag[0] = 0;
+        gif_tag[1] = 0;
+    }
+    packet_qwords++;
     
-    return GAUSSIAN_SUCCESS;
-}
-
-// Download results from VU1
-static GaussianResult vu_download_results(GaussianSplat2D* output_splats, u32 count) {
-    // Build download packet
-    u64* packet = g_vu_state.dma_download_buffer;
-    u32 packet_qwords = 0;
+    // Reference each splat where it lives; nothing is converted on the EE
+    bool shaded = (flags & VU1_BATCH_FLAG_SH) != 0;
+    bool cached = (flags & VU1_BATCH_FLAG_SH_CACHED) != 0 && indices;
+    u32 slot = input_address + BATCH_HEADER_QWORDS;
+    for (u32 i = 0; i < count; i++) {
+        const GaussianSplat3D* splat = indices ? &splats[indices[i]] : &splats[i];
+        u32 record = (u32)splat & 0x0FFFFFFF;
+        u64* tags = &chain[packet_qwords * 2];
+        
+        // Qword 0 of the record: pos.xyz (Q16.16), cov_exp in the low nibble of w
+        tags[0] = DMA_SET_TAG(1, 0, DMA_TAG_REF, 0, record, 0);
+        tags[1] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                  ((u64)VIF_CODE(slot, 1, VIF_UNPACK_V4_32, 0) << 32);
+        
+        // Qword 1 of the record: cov_mant[1..8] sign-extended into two qwords
+        tags[2] = DMA_SET_TAG(1, 0, DMA_TAG_REF, 0, record + SPLAT_COV_OFFSET, 0);
+        tags[3] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                  ((u64)VIF_CODE(slot + 1, 2, VIF_UNPACK_V4_16, 0) << 32);
+        
+        // Qword 2 of the record: color.rgb, opacity widened to one integer per lane
+        u32 color = cached ? ((u32)&g_vu_state.sh_cache[indices[i]] & 0x0FFFFFFF) : record + SPLAT_COLOR_OFFSET;
+        tags[4] = DMA_SET_TAG(1, 0, DMA_TAG_REF, 0, color, 0);
+        tags[5] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                  ((u64)VIF_CODE(VIF_UNPACK_USN | (slot + 3), 4, VIF_UNPACK_V4_8, 0) << 32);
+        
+        packet_qwords += SPLAT_REF_TAGS;
+        if (!shaded) {
+            slot += SPLAT_INPUT_QWORDS;
+            continue;
+        }
+        
+        // Qwords 2-3 of the record: sh_coeffs[0..13], sign-extended after the color lanes
+        tags[6] = DMA_SET_TAG(2, 0, DMA_TAG_REF, 0, record + SPLAT_COLOR_OFFSET, 0);
+        tags[7] = (u64)VIF_CODE(0, 0, VIF_CMD_NOP, 0) |
+                  ((u64)VIF_CODE(slot + 4, 4, VIF_UNPACK_V4_16, 0) << 32);
+        
+        packet_qwords++;
+        slot += SPLAT_SH_INPUT_QWORDS;
+    }
     
-    // VIF header for data download
-    packet[packet_qwords++] = VIF_CODE(0x0101, 0, VIF_CMD_STCYCL, 0);
-    packet[packet_qwords++] = VIF_CODE(VU1_OUTPUT_BUFFER, count * SPLAT_OUTPUT_QWORDS, 0x6C, 0);  // UNPACK V4-32
+    // Program overlay after the data: the unpacks above overlap the running
+    // batch, and only the MPG waits for it to end. Resident programs add nothing.
+    u32 entry = 0;
+    u32 mpg_first = packet_qwords;
+    packet_qwords += vu_microcode_build_mpg((u32)g_vu_state.microcode_program[g_vu_state.microcode_variant],
+                                            &chain[packet_qwords * 2], &entry);
+    
+    // Referenced qwords: one per splat REF, two more for the SH one, then the MPG blocks
+    ref_qwords += count * (shaded ? SPLAT_REF_TAGS + 2 : SPLAT_REF_TAGS);
+    for (u32 tag = mpg_first; tag < packet_qwords; tag++) {
+        ref_qwords += (u32)(chain[tag * 2] & 0xFFFF);
+    }
     
-    // Send download request using packet2_t
-    packet2_t dma_packet;
-    packet2_reset(&dma_packet, 0);
-    packet2_add_data(&dma_packet, packet, packet_qwords);
+    // Kick: ITOP carries the input buffer base, MSCAL waits for the running program
+    chain[packet_qwords * 2] = DMA_SET_TAG(0, 0, DMA_TAG_END, 0, 0, 0);
+    chain[packet_qwords * 2 + 1] = (u64)VIF_CODE(input_address, 0, VIF_CMD_ITOP, 0) |
+                                   ((u64)VIF_CODE(entry, 0, VIF_CMD_MSCAL, 0) << 32);
+    packet_qwords++;
+    
+    g_vu_state.batch_packet_qwords[buffer_id] = packet_qwords;
+    g_vu_state.batch_packet_bytes[buffer_id] = (packet_qwords + ref_qwords) * 16;
+    return packet_qwords;
+}
+
+// Send a built batch chain to VIF1 without waiting for completion. The tags'
+// upper halves are VIF codes, so the tags themselves are transferred. The
+// cache flush also writes back the scene records the REF tags point at.
+static void vu_send_batch_packet(u32 buffer_id) {
     FlushCache(0);
-    dma_channel_send_packet2(&dma_packet, DMA_CHANNEL_VIF1, 0);
-    dma_channel_wait(DMA_CHANNEL_VIF1, 0);
+    dma_channel_send_chain(DMA_CHANNEL_VIF1, (void*)((u32)g_vu_state.batch_packets[buffer_id] & 0x0FFFFFFF),
+                           0, DMA_FLAG_TRANSFERTAG, 0);
+    dma_account_transfer(DMA_CHANNEL_VIF1, g_vu_state.batch_packet_bytes[buffer_id]);
+}
+
+// Lane limits for narrowing VU1 output: qword 0 is screen x, y (12.4),
+// Z24 depth and radius (12.4); qword 1 is RGB, then GS alpha with the atlas
+// cell and mip level packed above it
+static const fixed16x4_lanes g_output_min[SPLAT_OUTPUT_QWORDS] = {
+    {.lane = {-32768, -32768, 0, 0}},
+    {.lane = {0, 0, 0, 0}}
+};
+static const fixed16x4_lanes g_output_max[SPLAT_OUTPUT_QWORDS] = {
+    {.lane = {32767, 32767, (1 << RENDER_SPLAT_DEPTH_BITS) - 1, 65535}},
+    {.lane = {255, 255, 255, 65535}}
+};
+static const fixed16x4_lanes g_sh_color_max = {.lane = {255, 255, 255, 255}};
+
+// Read back results from a VU1 output buffer (EE-mapped VU1 data memory)
+// VU1 already culled, projected and picked the footprint cell; only the
+// survivors it counted are read, and this only narrows their integer lanes.
+static GaussianResult vu_download_results(GaussianSplatRender* output_splats, u32 count, u32 buffer_id,
+                                          u32* stored) {
+    if (count > VU1_BATCH_SIZE) {
+        return GAUSSIAN_ERROR_INVALID_PARAMETER;
+    }
     
-    // Read back data from VU1 memory (this is simplified - actual implementation would use DMA)
-    // For now, assume data is available in system memory after DMA
+    u32 output_address = (buffer_id == 0) ? VU1_OUTPUT_BUFFER_A : VU1_OUTPUT_BUFFER_B;
+    volatile u32* survivor_count = (volatile u32*)(VU1_DATA_MEM + output_address * 16);
+    volatile fixed16x4* vu_output = (volatile fixed16x4*)(VU1_DATA_MEM + output_address * 16) +
+                                    OUTPUT_COUNT_QWORDS;
     
-    // Unpack VU1 output format to GaussianSplat2D structure
-    float* vu_output = (float*)&packet[packet_qwords];  // Simplified - actual data location varies
+    // A count past the batch can only come from a program that misbehaved
+    count = MIN(*survivor_count, count);
     
     for (u32 i = 0; i < count; i++) {
-        GaussianSplat2D* splat = &output_splats[i];
-        float* data = &vu_output[i * 16];  // 16 floats per output splat
-        
-        // Unpack qword 0: screen_pos.xy, depth, radius
-        splat->screen_pos[0] = fixed_from_float(data[0]);
-        splat->screen_pos[1] = fixed_from_float(data[1]);
-        splat->depth = fixed_from_float(data[2]);
-        splat->radius = fixed_from_float(data[3]);
+        GaussianSplatRender* splat = &output_splats[i];
+        volatile fixed16x4* data = &vu_output[i * SPLAT_OUTPUT_QWORDS];
         
-        // Unpack qword 1: cov_2d[0-3]
-        for (int j = 0; j < 4; j++) {
-            splat->cov_2d[j] = (fixed8_t)(data[4 + j] * FIXED8_SCALE);
+        // One uncached 128-bit read per qword, all lanes clamped at once
+        fixed16x4_lanes lanes[SPLAT_OUTPUT_QWORDS];
+        for (int j = 0; j < SPLAT_OUTPUT_QWORDS; j++) {
+            lanes[j].v = fixed16x4_clamp(data[j], g_output_min[j].v, g_output_max[j].v);
         }
         
-        // Unpack qword 2: eigenvals, atlas coordinates
-        splat->eigenvals[0] = fixed_from_float(data[8]);
-        splat->eigenvals[1] = fixed_from_float(data[9]);
+        splat->screen_x = (s16)lanes[0].lane[0];
+        splat->screen_y = (s16)lanes[0].lane[1];
+        splat->depth = (u32)lanes[0].lane[2];
+        splat->radius = (u16)lanes[0].lane[3];
         
-        u32 atlas_coords = (u32)data[10];
-        splat->atlas_u = (u8)(atlas_coords & 0xFF);
-        splat->atlas_v = (u8)((atlas_coords >> 8) & 0xFF);
+        splat->color[0] = (u8)lanes[1].lane[0];
+        splat->color[1] = (u8)lanes[1].lane[1];
+        splat->color[2] = (u8)lanes[1].lane[2];
         
-        // Unpack qword 3: color.rgba
-        splat->color[0] = (u8)(data[12] * 255.0f);
-        splat->color[1] = (u8)(data[13] * 255.0f);
-        splat->color[2] = (u8)(data[14] * 255.0f);
-        splat->color[3] = (u8)(data[15] * 255.0f);
-        
-        // Clear other fields
-        memset(splat->inv_cov_2d, 0, sizeof(splat->inv_cov_2d));
-        memset(splat->eigenvecs, 0, sizeof(splat->eigenvecs));
-        splat->tile_mask = 0;
-        memset(splat->padding, 0, sizeof(splat->padding));
+        u32 packed = (u32)lanes[1].lane[3];
+        splat->color[3] = (u8)(packed & 0xFF);
+        splat->atlas_index = (u8)((packed >> VU1_PACK_CELL_SHIFT) & (ATLAS_ENTRIES - 1));
+        splat->atlas_level = (u8)(packed >> VU1_PACK_LEVEL_SHIFT);
     }
     
+    *stored = count;
     return GAUSSIAN_SUCCESS;
 }
 
+// Refill the SH color cache from a shaded batch: VU1 leaves the shaded RGBA
+// of every splat, culled or not, in batch order past its results
+static void vu_store_sh_colors(const GaussianSplat3D* splats, const u32* indices, u32 count, u32 buffer_id) {
+    u32 output_address = (buffer_id == 0) ? VU1_OUTPUT_BUFFER_A : VU1_OUTPUT_BUFFER_B;
+    volatile fixed16x4* vu_colors = (volatile fixed16x4*)(VU1_DATA_MEM + (output_address + VU1_SH_COLOR_OFFSET) * 16);
+    
+    for (u32 i = 0; i < count; i++) {
+        u32 index = indices[i];
+        if (index >= g_vu_state.sh_cache_count) {
+            continue;
+        }
+        
+        fixed16x4_lanes lanes;
+        lanes.v = fixed16x4_clamp(vu_colors[i], g_output_min[1].v, g_sh_color_max.v);
+        
+        SHColorCacheEntry* entry = &g_vu_state.sh_cache[index];
+        entry->color[0] = (u8)lanes.lane[0];
+        entry->color[1] = (u8)lanes.lane[1];
+        entry->color[2] = (u8)lanes.lane[2];
+        entry->opacity = (u8)lanes.lane[3];
+        
+        // The direction VU1 shaded for, from the same camera constants
+        float v[3];
+        float length_sq = vu_sh_view_vector(&splats[index], v);
+        float inv_length = (length_sq > 0.0f) ? 1.0f / sqrtf(length_sq) : 0.0f;
+        entry->dir[0] = v[0] * inv_length;
+        entry->dir[1] = v[1] * inv_length;
+        entry->dir[2] = v[2] * inv_length;
+    }
+}
+
 // Get VU system performance statistics
 void vu_get_performance_stats(FrameProfileData* profile) {
     if (!profile || !g_vu_state.initialized) return;
@@ -539,7 +1442,10 @@ void vu_get_performance_stats(FrameProfileData* profile) {
     profile->vu_upload_cycles = g_vu_state.upload_cycles;
     profile->vu_execute_cycles = g_vu_state.execute_cycles;
     profile->vu_download_cycles = g_vu_state.download_cycles;
-    profile->vu_utilization = g_vu_state.vu_utilization;
+    // The sampler sees VU1 itself; the pipeline's own figure counts every
+    // EE wait on VIF1 as VU time
+    profile->vu_utilization = vu_activity_running() ? vu_activity_busy_fraction(VU_UNIT_VU1)
+                                                    : g_vu_state.vu_utilization;
     
     // Convert cycles to milliseconds (EE @ 294.912 MHz)
     float cycle_to_ms = 1000.0f / 294912000.0f;
@@ -565,24 +1471,39 @@ void vu_system_cleanup(void) {
     
     // Wait for any pending operations
     if (g_vu_state.vu_busy) {
+        dma_wait_channel(DMA_CHANNEL_VIF1);
         wait_vu1_complete();
     }
+    vu1_end_interrupt_remove();
     
     // Reset VU1
     *VU1_STAT = 0x0002;
     while (*VU1_STAT & 0x0002);
+    vu_microcode_invalidate(VU_UNIT_VU1);
     
     // Free DMA buffers
     if (g_vu_state.dma_upload_buffer) {
-        free(g_vu_state.dma_upload_buffer);
+        memory_free(g_vu_state.dma_upload_buffer);
         g_vu_state.dma_upload_buffer = NULL;
     }
     
     if (g_vu_state.dma_download_buffer) {
-        free(g_vu_state.dma_download_buffer);
+        memory_free(g_vu_state.dma_download_buffer);
         g_vu_state.dma_download_buffer = NULL;
     }
     
+    for (int i = 0; i < 2; i++) {
+        if (g_vu_state.batch_packets[i]) {
+            memory_free(g_vu_state.batch_packets[i]);
+            g_vu_state.batch_packets[i] = NULL;
+        }
+    }
+    
+    if (g_vu_state.sh_cache) {
+        memory_free(g_vu_state.sh_cache);
+        g_vu_state.sh_cache = NULL;
+    }
+    
     // Clear state
     memset(&g_vu_state, 0, sizeof(VUSystemState));
     
@@ -654,12 +1575,10 @@ void vu_system_configure_memory(int vu_unit) {
             *(volatile u32*)(VU1_DATA_MEM + i) = 0;
         }
         
-        // Configure VU1 memory layout for Gaussian splatting
-        // Buffer 0: Input splats (0x000-0x1FF) - 512 bytes
-        // Buffer 1: Input splats (0x200-0x3FF) - 512 bytes  
-        // Matrix data: (0x400-0x4FF) - 256 bytes
-        // Output buffer: (0x500-0x7FF) - 768 bytes
-        // Temporary data: (0x800-0xFFF) - 2048 bytes
+        // Configure VU1 memory layout for Gaussian splatting (qword addresses)
+        // Buffer A: header + input (0x000-0x0F1), output (0x0F2-0x1E1)
+        // Buffer B: header + input (0x1F0-0x2E1), output (0x2E2-0x3D1)
+        // Constants and matrices: (0x3F0-0x3FF)
         
         debug_log_info("VU1 memory layout configured for Gaussian splatting");
         
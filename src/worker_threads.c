@@ -0,0 +1,296 @@
+/*
+ * SPLATSTORM X - Worker Threads
+ * Takes blocking work off the render thread onto EE kernel threads.
+ *
+ * - Job queue: the render thread posts a function and a small payload and
+ *   never waits; an I/O worker runs the jobs in order. Log writes go
+ *   through it, so a slow host or memory card write stalls the worker
+ *   instead of the frame.
+ * - Input thread: woken at every VBLANK to read the pads over SIF, into
+ *   a snapshot the render thread picks up with worker_input_read().
+ *   Presses between two reads are kept, so a 30 fps frame loses none.
+ *   worker_input_peek() reads the latest sticks mid-frame without them.
+ *
+ * The EE kernel schedules by strict priority and never time-slices: a
+ * thread only runs while every higher-priority one sleeps. The render
+ * thread mostly spins on the GS and DMA, so a worker below it would never
+ * run. Both workers sit above it instead and spend nearly all their time
+ * asleep on a semaphore or an IOP RPC; jobs should wait on I/O, not compute.
+ */
+
+#include "splatstorm_x.h"
+#include <tamtypes.h>
+#include <kernel.h>
+#include <string.h>
+#include <stdio.h>
+
+extern void* _gp;
+
+#define WORKER_STACK_SIZE       (16 * 1024)
+
+typedef struct {
+    WorkerJob function;
+    void* arg;                                // NULL: the job gets its payload
+    char payload[WORKER_JOB_PAYLOAD];
+} WorkerJobEntry;
+
+typedef struct {
+    bool initialized;
+    bool started;                             // Init ran: ids below are valid or -1
+
+    // Job queue: the render thread advances head, the I/O worker tail
+    WorkerJobEntry jobs[WORKER_QUEUE_JOBS];
+    volatile u32 job_head;                    // Jobs posted
+    volatile u32 job_tail;                    // Jobs finished
+    s32 job_sema;                             // One count per posted job
+    s32 io_thread;
+
+    // Input: the thread writes the snapshot with interrupts off
+    s32 input_thread;
+    s32 input_sema;                           // Signalled at every VBLANK start
+    s32 vblank_handler_id;
+    InputState input_snapshot;
+    volatile bool input_fresh;                // A poll landed since the last read
+
+    // Statistics
+    u32 jobs_dropped;                         // Posts refused on a full queue
+    volatile u32 input_polls;
+} WorkerSystem;
+
+static WorkerSystem g_workers = {0};
+
+static u8 g_io_stack[WORKER_STACK_SIZE] __attribute__((aligned(16)));
+static u8 g_input_stack[WORKER_STACK_SIZE] __attribute__((aligned(16)));
+
+static int worker_vblank_handler(int cause) {
+    (void)cause;
+    if (g_workers.input_sema >= 0) {
+        iSignalSema(g_workers.input_sema);
+    }
+    ExitHandler();
+    return 0;
+}
+
+static void worker_io_main(void* arg) {
+    (void)arg;
+    for (;;) {
+        WaitSema(g_workers.job_sema);
+
+        // The slot stays owned until tail passes it, so the render thread
+        // cannot refill it while the job still reads its payload
+        WorkerJobEntry* job = &g_workers.jobs[g_workers.job_tail % WORKER_QUEUE_JOBS];
+        job->function(job->arg ? job->arg : job->payload);
+        g_workers.job_tail++;
+    }
+}
+
+static void worker_input_main(void* arg) {
+    (void)arg;
+    InputState polled;
+    for (;;) {
+        WaitSema(g_workers.input_sema);
+        input_update(&polled);
+
+        DIntr();
+        u32 pressed = g_workers.input_fresh ? g_workers.input_snapshot.buttons_pressed : 0;
+        g_workers.input_snapshot = polled;
+        g_workers.input_snapshot.buttons_pressed |= pressed;
+        g_workers.input_fresh = true;
+        EIntr();
+        g_workers.input_polls++;
+    }
+}
+
+static s32 worker_start_thread(void (*entry)(void*), u8* stack, int priority) {
+    ee_thread_t thread;
+    memset(&thread, 0, sizeof(thread));
+    thread.func = (void*)entry;
+    thread.stack = stack;
+    thread.stack_size = WORKER_STACK_SIZE;
+    thread.gp_reg = &_gp;
+    thread.initial_priority = priority;
+
+    s32 id = CreateThread(&thread);
+    if (id < 0) {
+        return -1;
+    }
+    if (StartThread(id, NULL) < 0) {
+        DeleteThread(id);
+        return -1;
+    }
+    return id;
+}
+
+static s32 worker_create_sema(u32 max_count) {
+    ee_sema_t sema;
+    memset(&sema, 0, sizeof(sema));
+    sema.init_count = 0;
+    sema.max_count = max_count;
+    return CreateSema(&sema);
+}
+
+// Start both workers and move the calling (render) thread to
+// WORKER_RENDER_PRIORITY. Call after the pads are initialized. Without
+// threads everything keeps running inline: posts run the job at once and
+// worker_input_read() reports false.
+GaussianResult worker_system_init(void) {
+    if (g_workers.initialized) {
+        return GAUSSIAN_SUCCESS;
+    }
+
+    memset(&g_workers, 0, sizeof(g_workers));
+    g_workers.io_thread = -1;
+    g_workers.input_thread = -1;
+    g_workers.vblank_handler_id = -1;
+    g_workers.started = true;
+
+    ChangeThreadPriority(GetThreadId(), WORKER_RENDER_PRIORITY);
+
+    g_workers.job_sema = worker_create_sema(WORKER_QUEUE_JOBS);
+    g_workers.input_sema = worker_create_sema(1);
+    if (g_workers.job_sema < 0 || g_workers.input_sema < 0) {
+        printf("SPLATSTORM X: Worker semaphores unavailable\n");
+        worker_system_shutdown();
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+
+    g_workers.io_thread = worker_start_thread(worker_io_main, g_io_stack, WORKER_IO_PRIORITY);
+    g_workers.input_thread = worker_start_thread(worker_input_main, g_input_stack, WORKER_INPUT_PRIORITY);
+    if (g_workers.io_thread < 0 || g_workers.input_thread < 0) {
+        printf("SPLATSTORM X: Worker threads unavailable\n");
+        worker_system_shutdown();
+        return GAUSSIAN_ERROR_INIT_FAILED;
+    }
+
+    g_workers.vblank_handler_id = AddIntcHandler(INTC_VBLANK_S, worker_vblank_handler, 0);
+    if (g_workers.vblank_handler_id < 0) {
+        printf("SPLATSTORM X: Worker VBLANK handler unavailable, input polled inline\n");
+    } else {
+        EnableIntc(INTC_VBLANK_S);
+    }
+
+    g_workers.initialized = true;
+    printf("SPLATSTORM X: Worker threads started (I/O %d, input %d)\n", g_workers.io_thread, g_workers.input_thread);
+    return GAUSSIAN_SUCCESS;
+}
+
+// Finish posted jobs, then stop both workers
+void worker_system_shutdown(void) {
+    if (!g_workers.started) return;
+    if (g_workers.initialized) {
+        worker_flush();
+    }
+
+    if (g_workers.vblank_handler_id >= 0) {
+        RemoveIntcHandler(INTC_VBLANK_S, g_workers.vblank_handler_id);
+        g_workers.vblank_handler_id = -1;
+    }
+
+    s32 threads[2] = { g_workers.io_thread, g_workers.input_thread };
+    for (u32 t = 0; t < 2; t++) {
+        if (threads[t] >= 0) {
+            TerminateThread(threads[t]);
+            DeleteThread(threads[t]);
+        }
+    }
+    g_workers.io_thread = -1;
+    g_workers.input_thread = -1;
+
+    if (g_workers.job_sema >= 0) DeleteSema(g_workers.job_sema);
+    if (g_workers.input_sema >= 0) DeleteSema(g_workers.input_sema);
+    g_workers.job_sema = -1;
+    g_workers.input_sema = -1;
+    g_workers.initialized = false;
+    g_workers.started = false;
+}
+
+bool worker_system_active(void) {
+    return g_workers.initialized;
+}
+
+// Queue a job for the I/O worker from the render thread; never blocks.
+// Up to WORKER_JOB_PAYLOAD bytes of payload are copied, and the job gets
+// arg, or the copy when arg is NULL. False when the queue is full: the
+// job is dropped, since waiting would bring back the stall it avoids.
+bool worker_post_job(WorkerJob function, void* arg, const void* payload, u32 payload_size) {
+    if (!function || payload_size > WORKER_JOB_PAYLOAD) {
+        return false;
+    }
+
+    if (!g_workers.initialized) {
+        char inline_payload[WORKER_JOB_PAYLOAD];
+        if (payload_size > 0) {
+            memcpy(inline_payload, payload, payload_size);
+        }
+        function(arg ? arg : inline_payload);
+        return true;
+    }
+
+    u32 head = g_workers.job_head;
+    if (head - g_workers.job_tail >= WORKER_QUEUE_JOBS) {
+        g_workers.jobs_dropped++;
+        return false;
+    }
+
+    WorkerJobEntry* job = &g_workers.jobs[head % WORKER_QUEUE_JOBS];
+    job->function = function;
+    job->arg = arg;
+    if (payload_size > 0) {
+        memcpy(job->payload, payload, payload_size);
+    }
+    g_workers.job_head = head + 1;
+    SignalSema(g_workers.job_sema);
+    return true;
+}
+
+// Wait until every posted job has run
+void worker_flush(void) {
+    while (g_workers.initialized && g_workers.job_tail != g_workers.job_head) {
+        RotateThreadReadyQueue(WORKER_RENDER_PRIORITY);  // The worker preempts us as soon as it can run
+    }
+}
+
+// Latest pad state from the input thread, with every press since the
+// previous read. False when no input thread runs or no VBLANK has polled
+// yet; the caller polls inline then.
+bool worker_input_read(InputState* input) {
+    if (!g_workers.initialized || g_workers.vblank_handler_id < 0 || !input) {
+        return false;
+    }
+
+    DIntr();
+    bool fresh = g_workers.input_fresh;
+    if (fresh) {
+        *input = g_workers.input_snapshot;
+        g_workers.input_fresh = false;
+    }
+    EIntr();
+
+    if (!fresh) {
+        // Same pad state, no new presses
+        input->buttons_pressed = 0;
+    }
+    return true;
+}
+
+// Pad state of the latest poll, leaving its presses for the next
+// worker_input_read(). False when no input thread runs.
+bool worker_input_peek(InputState* input) {
+    if (!g_workers.initialized || g_workers.vblank_handler_id < 0 || !input) {
+        return false;
+    }
+
+    DIntr();
+    *input = g_workers.input_snapshot;
+    EIntr();
+
+    input->buttons_pressed = 0;
+    return true;
+}
+
+void worker_get_stats(u32* jobs_posted, u32* jobs_pending, u32* jobs_dropped, u32* input_polls) {
+    if (jobs_posted) *jobs_posted = g_workers.job_head;
+    if (jobs_pending) *jobs_pending = g_workers.job_head - g_workers.job_tail;
+    if (jobs_dropped) *jobs_dropped = g_workers.jobs_dropped;
+    if (input_polls) *input_polls = g_workers.input_polls;
+}
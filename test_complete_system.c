@@ -260,6 +260,7 @@ int test_memory_management(void) {
     // Test VRAM allocation
     void* vram_mem = splatstorm_alloc_vram(1024);
     test_log("VRAM Allocation", vram_mem != NULL, "VRAM allocation failed");
+    test_log("VRAM Block Alignment", ((u32)vram_mem % GS_VRAM_BLOCK_BYTES) == 0, "VRAM not block aligned");
     
     // Test aligned allocation
     void* aligned_mem = splatstorm_alloc_aligned(2048, 64);
@@ -275,6 +276,7 @@ int test_memory_management(void) {
     
     // Cleanup
     if (basic_mem) free(basic_mem);
+    if (vram_mem) splatstorm_free_vram(vram_mem);
     
     return (vram_mem != NULL && aligned_mem != NULL && std_mem != NULL && basic_mem != NULL);
 }
@@ -395,6 +397,82 @@ int test_debug_system(void) {
     return 1;
 }
 
+// Bin one deterministic scatter of splats (radius in pixels, Z24 depth) and
+// check its tile lists; total returns the overlaps emitted
+static int tile_binning_case(u32 splat_count, u32 radius_min, u32 radius_spread, u32* total_out) {
+    GaussianSplatRender* splats = (GaussianSplatRender*)calloc(splat_count, sizeof(GaussianSplatRender));
+    TileRange* ranges = (TileRange*)calloc(MAX_TILES, sizeof(TileRange));
+    CameraFixed camera;
+    memset(&camera, 0, sizeof(camera));
+    *total_out = 0;
+    
+    if (!splats || !ranges) {
+        test_log("Tile Sort Allocation", 0, "Failed to allocate test splats");
+        free(splats);
+        free(ranges);
+        return 0;
+    }
+    
+    // Deterministic scatter of splats with varied depth and size (12.4 units, Z24)
+    for (u32 i = 0; i < splat_count; i++) {
+        splats[i].screen_x = (s16)(((i * 37) % 640) << RENDER_SPLAT_SUBPIXEL_SHIFT);
+        splats[i].screen_y = (s16)(((i * 53) % 448) << RENDER_SPLAT_SUBPIXEL_SHIFT);
+        splats[i].radius = (u16)((radius_min + (i % radius_spread)) << RENDER_SPLAT_SUBPIXEL_SHIFT);
+        splats[i].depth = ((i * 7919) % 1000) << 12;
+    }
+    
+    int init_result = tile_system_init(splat_count);
+    test_log("Tile System Init", init_result == 0, "Tile system initialization failed");
+    
+    int result = process_tiles(splats, splat_count, &camera, ranges);
+    test_log("Tile Processing", result == 0, "process_tiles failed");
+    
+    // Every tile list must be back-to-front (ascending Z) and match its TileRange count
+    // Bins are one contiguous buffer: each range starts where the previous ended
+    int ordered = 1;
+    int counts_match = 1;
+    int contiguous = 1;
+    u32 total = 0;
+    for (u32 tile_id = 0; tile_id < MAX_TILES; tile_id++) {
+        u32 count = 0;
+        const u32* list = get_tile_splat_list(tile_id, &count);
+        if (count != ranges[tile_id].count) counts_match = 0;
+        if (ranges[tile_id].start_index != total) contiguous = 0;
+        for (u32 i = 1; i < count; i++) {
+            if (splats[list[i - 1]].depth > splats[list[i]].depth) {
+                ordered = 0;
+            }
+        }
+        total += count;
+    }
+    
+    test_log("Tile Lists Back-To-Front", ordered, "Tile list not sorted far to near");
+    test_log("Tile Range Counts", counts_match, "TileRange count differs from tile list");
+    test_log("Tile Bins Contiguous", contiguous, "TileRange start does not follow previous tile");
+    test_log("Tile Overlaps Emitted", total >= splat_count, "Fewer overlaps than splats");
+    
+    tile_system_cleanup();
+    free(splats);
+    free(ranges);
+    
+    *total_out = total;
+    return (init_result == 0 && result == 0 && ordered && counts_match && contiguous);
+}
+
+// Test 9: Tile Binning Sort
+int test_tile_binning_sort(void) {
+    printf("\n=== TEST 9: TILE BINNING SORT ===\n");
+    
+    u32 total = 0;
+    int small = tile_binning_case(512, 2, 24, &total);
+    
+    // Large footprints: range starts past 65535 must not wrap
+    int large = tile_binning_case(2048, 48, 32, &total);
+    test_log("Tile Overlaps Past 16 Bits", total > 65535, "Too few overlaps to cover 32-bit range starts");
+    
+    return small && large && total > 65535;
+}
+
 // Print comprehensive test results
 void print_test_summary(void) {
     printf("\n📊 COMPLETE SYSTEM TEST RESULTS\n");
@@ -433,13 +511,14 @@ int main(int argc __attribute__((unused)), char* argv[] __attribute__((unused)))
     int test6 = test_graphics_operations();
     int test7 = test_performance_monitoring();
     int test8 = test_debug_system();
+    int test9 = test_tile_binning_sort();
     
     // Print comprehensive results
     print_test_summary();
     
     // Overall result
     int overall_success = (test1 && test2 && test3 && test4 && 
-                          test5 && test6 && test7 && test8);
+                          test5 && test6 && test7 && test8 && test9);
     
     printf("\n🎯 FINAL RESULT: %s\n", overall_success ? "✅ SUCCESS" : "❌ FAILURE");
     printf("All %d object files linked and tested successfully!\n", 27);
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+SPLATSTORM X - LUT Cooker
+Precomputes every lookup table the engine would otherwise generate with
+float math at boot (gaussian_luts_generate_all and generate_luts in
+src/gaussian_math_fixed.c) and writes them in their final in-memory layout:
+exp, sqrt, reciprocal, sin, cos and atan2 tables, the 128x128 covariance
+inverse LUT, the footprint atlas with all its mip levels packed as GS
+texels, its alpha ramp CLUT in CSM1 order, and the 256x256 SH lighting LUT.
+The engine reads the file with one call (gaussian_luts_load) and falls back
+to generating the tables when it is missing or built for another layout.
+
+Tables are computed in float32 like the EE code, so they match the
+generated ones up to the last bit of rounding.
+"""
+
+import argparse
+import math
+import struct
+import numpy as np
+
+LUT_COOKED_MAGIC = 0x534C5554  # 'SLUT'
+LUT_COOKED_VERSION = 1
+DMA_ALIGNMENT = 128
+HEADER_SIZE = 128
+
+# Engine configuration (include/gaussian_types.h)
+LUT_SIZE = 256
+LUT_THRESHOLD_SQ = 9.0
+CUTOFF_SIGMA = 3.0
+COV_INV_LUT_RES = 128
+ATLAS_ENTRIES = 64
+FOOTPRINT_RES = 32
+ATLAS_SIZE = FOOTPRINT_RES * 8
+FOOTPRINT_MIP_LEVELS = 4
+ATLAS_HEIGHT = ATLAS_SIZE + ATLAS_SIZE // 2
+MAX_EIG_VAL = 10.0
+MIN_EIGENVALUE = 1e-6
+
+f32 = np.float32
+
+
+def to_u32(values):
+    """C (u32) cast of non-negative floats: truncation toward zero"""
+    return np.floor(values).astype(np.uint64).astype(np.uint32)
+
+
+def alpha_channel(values):
+    """(u32)value << 24, wrapping like the 32-bit shift on the EE"""
+    return (to_u32(values).astype(np.uint64) << 24).astype(np.uint32)
+
+
+def basic_luts():
+    """generate_luts(): exp, sqrt, reciprocal, sin, cos and atan2"""
+    i = np.arange(LUT_SIZE, dtype=f32)
+    norm = i / f32(LUT_SIZE - 1)
+
+    mahal_sq = norm * norm * f32(LUT_THRESHOLD_SQ)
+    exp_lut = alpha_channel(np.exp(f32(-0.5) * mahal_sq) * f32(255.0))
+    sqrt_lut = alpha_channel(np.sqrt(norm) * f32(255.0))
+
+    recip = np.minimum(f32(1.0) / ((i + f32(1.0)) / f32(LUT_SIZE)), f32(255.0))
+    recip_lut = alpha_channel(recip * f32(255.0) / f32(255.0) * f32(255.0))
+
+    angle = (norm.astype(np.float64) * 2.0 * math.pi).astype(f32)
+    sin_lut = alpha_channel((np.sin(angle) + f32(1.0)) * f32(127.5))
+    cos_lut = alpha_channel((np.cos(angle) + f32(1.0)) * f32(127.5))
+
+    axis = norm * f32(2.0) - f32(1.0)
+    fy, fx = np.meshgrid(axis, axis, indexing='ij')
+    atan = np.arctan2(fy, fx).astype(np.float64)
+    atan2_lut = alpha_channel(((atan + math.pi) / (2.0 * math.pi)).astype(f32) * f32(255.0))
+
+    return exp_lut, sqrt_lut, recip_lut, sin_lut, cos_lut, atan2_lut.reshape(-1)
+
+
+def cov_inv_lut():
+    """generate_cov_inv_lut_complete(): log-spaced diagonal inverses, signed RGBA"""
+    norm = np.arange(COV_INV_LUT_RES, dtype=f32) / f32(COV_INV_LUT_RES - 1)
+    lam = f32(MIN_EIGENVALUE) * np.power(f32(MAX_EIG_VAL) / f32(MIN_EIGENVALUE), norm)
+    lambda2, lambda1 = np.meshgrid(lam, lam, indexing='ij')
+
+    det = lambda1 * lambda2
+    small = np.abs(det) < f32(MIN_EIGENVALUE)
+    lambda1 = np.where(small, lambda1 + f32(MIN_EIGENVALUE), lambda1)
+    lambda2 = np.where(small, lambda2 + f32(MIN_EIGENVALUE), lambda2)
+    inv_det = f32(1.0) / (lambda1 * lambda2)
+
+    max_inv = f32(1.0) / f32(MIN_EIGENVALUE)
+
+    def encode(value):
+        return to_u32(np.clip((value / max_inv + f32(1.0)) * f32(127.5), 0, 255)) & 0xFF
+
+    r = encode(lambda2 * inv_det)
+    g = encode(np.zeros_like(inv_det))
+    a = encode(lambda1 * inv_det)
+    return ((a << 24) | (g << 16) | (g << 8) | r).astype(np.uint32).reshape(-1)
+
+
+def footprint_atlas_cell(cell, level):
+    res = FOOTPRINT_RES >> level
+    origin_u = 0 if level == 0 else ATLAS_SIZE - (ATLAS_SIZE >> (level - 1))
+    origin_v = 0 if level == 0 else ATLAS_SIZE
+    return origin_u + (cell % 8) * res, origin_v + (cell // 8) * res
+
+
+def footprint_atlas(footprint_bits):
+    """generate_footprint_atlas_complete() plus mips, packed for PSMT8/PSMT4"""
+    alpha = np.zeros((ATLAS_HEIGHT, ATLAS_SIZE), dtype=np.uint8)
+    p = np.arange(FOOTPRINT_RES, dtype=f32)
+    n = (p / f32(FOOTPRINT_RES - 1) * f32(2.0) - f32(1.0)) * f32(CUTOFF_SIGMA)
+    ny, nx = np.meshgrid(n, n, indexing='ij')
+
+    for row in range(8):
+        aspect = np.power(f32(8.0), f32(row) / f32(7.0))
+        for col in range(8):
+            theta = f32(col * (math.pi / 8.0))
+            cos_theta, sin_theta = np.cos(theta), np.sin(theta)
+            rx = nx * cos_theta - ny * sin_theta
+            ry = nx * sin_theta + ny * cos_theta
+            sx = rx * np.sqrt(aspect)
+            sy = ry / np.sqrt(aspect)
+            dist_sq = sx * sx + sy * sy
+            cell_alpha = np.where(dist_sq > f32(LUT_THRESHOLD_SQ), f32(0.0), np.exp(f32(-0.5) * dist_sq))
+            alpha[row * FOOTPRINT_RES:(row + 1) * FOOTPRINT_RES,
+                  col * FOOTPRINT_RES:(col + 1) * FOOTPRINT_RES] = to_u32(cell_alpha * f32(255.0))
+
+    # footprint_atlas_build_mips(): rounded 2x2 averages, cell by cell
+    for level in range(1, FOOTPRINT_MIP_LEVELS):
+        res = FOOTPRINT_RES >> level
+        for cell in range(ATLAS_ENTRIES):
+            su, sv = footprint_atlas_cell(cell, level - 1)
+            du, dv = footprint_atlas_cell(cell, level)
+            src = alpha[sv:sv + res * 2, su:su + res * 2].astype(np.uint32)
+            avg = (src[0::2, 0::2] + src[0::2, 1::2] + src[1::2, 0::2] + src[1::2, 1::2] + 2) >> 2
+            alpha[dv:dv + res, du:du + res] = avg
+
+    # footprint_atlas_pack(): PSMT4 keeps the top nibble, left texel low
+    flat = alpha.reshape(-1)
+    if footprint_bits == 4:
+        return ((flat[0::2] >> 4) | (flat[1::2] & 0xF0)).astype(np.uint8)
+    return flat
+
+
+def footprint_clut(footprint_bits):
+    """footprint_clut_build(): neutral RGB, GS alpha ramp, CSM1 entry order"""
+    entries = 1 << footprint_bits
+    clut = np.zeros(entries, dtype=np.uint32)
+    for i in range(entries):
+        alpha = i * 255 // (entries - 1)
+        gs_alpha = (alpha * 128 + 127) // 255
+        slot = i
+        if entries == 256:
+            slot = (i & ~0x18) | ((i & 0x08) << 1) | ((i & 0x10) >> 1)
+        clut[slot] = (gs_alpha << 24) | 0x00808080
+    return clut
+
+
+def sh_lighting_lut():
+    """generate_sh_lighting_lut_complete(): ambient plus one directional light"""
+    t = np.arange(256, dtype=f32) / f32(255.0)
+    v, u = np.meshgrid(t, t, indexing='ij')
+    theta = (u.astype(np.float64) * 2.0 * math.pi).astype(f32)
+    phi = (v.astype(np.float64) * math.pi).astype(f32)
+
+    sin_phi = np.sin(phi)
+    light = f32(0.577)
+    ndotl = (sin_phi * np.cos(theta)) * light + (sin_phi * np.sin(theta)) * light + np.cos(phi) * light
+    lighting = np.clip(f32(0.3) + f32(0.7) * np.maximum(ndotl, f32(0.0)), f32(0.0), f32(1.0))
+
+    value = to_u32(lighting * f32(255.0)) & 0xFF
+    return ((value << 24) | (value << 16) | (value << 8) | value).astype(np.uint32).reshape(-1)
+
+
+def write_luts(filename, footprint_bits):
+    """Header plus payload, every section on a 128-byte boundary"""
+    exp_lut, sqrt_lut, recip_lut, sin_lut, cos_lut, atan2_lut = basic_luts()
+    sections = [exp_lut, sqrt_lut, recip_lut, sin_lut, cos_lut, atan2_lut, cov_inv_lut(),
+                footprint_atlas(footprint_bits), footprint_clut(footprint_bits), sh_lighting_lut()]
+
+    payload = bytearray()
+    table = b''
+    for data in sections:
+        data = data.astype(data.dtype.newbyteorder('<')).tobytes()
+        table += struct.pack('<2I', len(payload), len(data))
+        payload += data
+        payload += b'\0' * (-len(payload) % DMA_ALIGNMENT)
+
+    header = struct.pack('<4I', LUT_COOKED_MAGIC, LUT_COOKED_VERSION, len(payload), footprint_bits) + table
+    header += b'\0' * (HEADER_SIZE - len(header))
+
+    with open(filename, 'wb') as f:
+        f.write(header)
+        f.write(payload)
+    print(f"Wrote {filename}: {len(sections)} tables, {len(payload) // 1024} KB")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SPLATSTORM X LUT Cooker')
+    parser.add_argument('-o', '--output', default='luts.slut', help='Output cooked LUT file')
+    parser.add_argument('--footprint-bits', type=int, choices=(4, 8), default=8,
+                        help='FOOTPRINT_ATLAS_BITS of the engine build (PSMT4 or PSMT8 atlas)')
+
+    args = parser.parse_args()
+    write_luts(args.output, args.footprint_bits)
+
+
+if __name__ == '__main__':
+    main()
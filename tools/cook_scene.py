@@ -0,0 +1,666 @@
+#!/usr/bin/env python3
+"""
+SPLATSTORM X - Scene Cooker
+Converts a PLY capture into a version 2 "cooked" scene whose payload is the
+engine's final in-memory layout: GaussianSplat3D records, hot/warm/cold
+streams with precomputed radii, and the culling octree. The engine loads it
+with one read (load_cooked_scene) or streams it in chunk by chunk
+(scene_stream_begin), both in src/asset_loader_real.c.
+
+Splats are written most important first, so a streamed scene shows its most
+visible splats before the rest arrive. Per-splat conversion, radii and octree
+build mirror ply_loader_enhanced.c, gaussian_splat_bounding_radius() and
+octree_build(), so a cooked scene renders and culls like the same PLY
+converted at boot.
+
+With --packed it writes a version 3 scene instead, about 14x smaller:
+positions quantized across their octree leaf's bounds (11/10/11 bits), log
+scale plus a smallest-three quaternion, packed color and an SH codebook
+index, 16 bytes per splat. The engine decodes it at read speed
+(load_packed_scene).
+
+With --paged it writes a version 4 scene for captures larger than EE RAM:
+the packed splats cut into pages of at most 1024 (octree subtrees), each
+with a few merged proxy splats that are drawn until the page itself is
+loaded around the camera (scene_paging_open).
+
+With --compact the version 2 scene leaves the warm and cold sections empty:
+records and the hot stream alone, 80 of 160 bytes per splat, which is what
+the engine keeps of a scene too large for all three streams.
+"""
+
+import argparse
+import struct
+import numpy as np
+
+SPLAT_MAGIC = 0x53504C54  # 'SPLT'
+SPLAT_VERSION_COOKED = 2
+SPLAT_VERSION_PACKED = 3
+SPLAT_VERSION_PAGED = 4
+DMA_ALIGNMENT = 128
+HEADER_SIZE = 128
+
+FIXED16_MAX = 0x7FFFFFFF
+FIXED16_MIN = -0x80000000
+OCTREE_MAX_DEPTH = 16
+OCTREE_LEAF_SPLATS = 32
+
+PLY_TYPES = {
+    'char': 'i1', 'uchar': 'u1', 'short': 'i2', 'ushort': 'u2',
+    'int': 'i4', 'uint': 'u4', 'float': 'f4', 'double': 'f8',
+}
+
+# Engine structure layouts (include/gaussian_types.h, little-endian EE)
+RECORD_DTYPE = np.dtype({
+    'names': ['pos', 'cov_exp', 'cov_mant', 'color', 'opacity', 'sh_coeffs', 'importance'],
+    'formats': [('<i4', 3), 'u1', ('<i2', 9), ('u1', 3), 'u1', ('<u2', 16), '<u4'],
+    'offsets': [0, 12, 14, 32, 35, 36, 68],
+    'itemsize': 128,
+})
+HOT_DTYPE = np.dtype({
+    'names': ['pos', 'radius'],
+    'formats': [('<i4', 3), '<i4'],
+    'offsets': [0, 12],
+    'itemsize': 16,
+})
+WARM_DTYPE = np.dtype({
+    'names': ['cov_mant', 'cov_exp', 'color', 'opacity'],
+    'formats': [('<i2', 9), 'u1', ('u1', 3), 'u1'],
+    'offsets': [0, 18, 19, 22],
+    'itemsize': 32,
+})
+COLD_DTYPE = np.dtype({
+    'names': ['sh_coeffs', 'importance'],
+    'formats': [('<u2', 16), '<u4'],
+    'offsets': [0, 32],
+    'itemsize': 48,
+})
+# OctreeNode in src/frustum_culling_complete.c
+NODE_STRUCT = struct.Struct('<6iIIIBBH')
+# PackedSplat in src/asset_loader_real.c
+PACKED_DTYPE = np.dtype({
+    'names': ['position', 'rotation', 'scale', 'sh_index', 'color', 'opacity'],
+    'formats': ['<u4', '<u4', ('u1', 3), 'u1', ('u1', 3), 'u1'],
+    'offsets': [0, 4, 8, 11, 12, 15],
+    'itemsize': 16,
+})
+PACKED_POS_BITS = (11, 10, 11)
+PACKED_SH_CODEBOOK_MAX = 256
+SQRT_HALF = 0.70710678
+# PagedPage in src/asset_loader_real.c
+PAGE_STRUCT = struct.Struct('<6iIHHII')
+PAGE_SPLATS = 1024              # SCENE_PAGE_SPLATS
+PAGE_PROXIES = 4                # Coarse splats standing in for a page that is not resident
+
+
+def wrap_s32(value):
+    return ((int(value) + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+
+
+def float_to_fixed16(values):
+    """FLOAT_TO_FIXED16: float32 multiply, truncate toward zero"""
+    scaled = np.asarray(values, dtype=np.float32) * np.float32(65536.0)
+    return np.clip(np.trunc(scaled), FIXED16_MIN, FIXED16_MAX).astype(np.int64)
+
+
+def unit_to_u8(values):
+    """(u8)(value * 255.0f)"""
+    scaled = np.asarray(values, dtype=np.float32) * np.float32(255.0)
+    return np.clip(np.trunc(scaled), 0, 255).astype(np.uint8)
+
+
+def covariance_from_scale_rotation(scales, rotations):
+    """gaussian_covariance_from_scale_rotation(), float32 in the same operation order"""
+    f32 = np.float32
+    q = rotations.astype(f32)
+    w, x, y, z = q[:, 0], q[:, 1], q[:, 2], q[:, 3]
+    norm = np.sqrt(((w * w + x * x) + y * y) + z * z)
+    valid = norm > f32(0.0001)
+    safe = np.where(valid, norm, f32(1.0))
+    w = np.where(valid, w / safe, f32(1.0))
+    x = np.where(valid, x / safe, f32(0.0))
+    y = np.where(valid, y / safe, f32(0.0))
+    z = np.where(valid, z / safe, f32(0.0))
+
+    one, two = f32(1.0), f32(2.0)
+    r = [one - two * (y * y + z * z), two * (x * y - w * z), two * (x * z + w * y),
+         two * (x * y + w * z), one - two * (x * x + z * z), two * (y * z - w * x),
+         two * (x * z - w * y), two * (y * z + w * x), one - two * (x * x + y * y)]
+    s = scales.astype(f32)
+    s2 = [s[:, 0] * s[:, 0], s[:, 1] * s[:, 1], s[:, 2] * s[:, 2]]
+
+    cov = np.stack([(r[i * 3] * r[j * 3] * s2[0] + r[i * 3 + 1] * r[j * 3 + 1] * s2[1]) +
+                    r[i * 3 + 2] * r[j * 3 + 2] * s2[2]
+                    for i in range(3) for j in range(3)], axis=1)
+    max_cov = np.abs(cov).max(axis=1)
+
+    _, octave = np.frexp(max_cov)
+    exp = np.where(max_cov > 0, np.clip(octave - 1 + 7, 0, 15), 7).astype(np.int64)
+    to_mantissa = np.ldexp(f32(256.0), (7 - exp).astype(np.int32)).astype(f32)
+    mantissa = np.clip(cov * to_mantissa[:, None], f32(-32768.0), f32(32767.0))
+    return np.trunc(mantissa).astype(np.int16), exp.astype(np.uint8)
+
+
+def encode_packed(pos, frame_min, frame_max, scales, rotations, color, opacity, sh_index):
+    """PackedSplat records; packed_splat_decode() in src/asset_loader_real.c reverses this"""
+    count = len(pos)
+    rotations = rotations.astype(np.float64)
+
+    # Positions: 11/10/11 bits across the frame bounds
+    steps = np.array([(1 << PACKED_POS_BITS[j]) - 1 for j in range(3)], dtype=np.float64)
+    extent = np.maximum(frame_max - frame_min, 1.0)
+    quantized = np.clip(np.rint((pos - frame_min) / extent * steps), 0, steps).astype(np.uint32)
+    position = (quantized[:, 0] << (PACKED_POS_BITS[1] + PACKED_POS_BITS[2])) | \
+               (quantized[:, 1] << PACKED_POS_BITS[2]) | quantized[:, 2]
+
+    # Rotation: smallest three, the dropped component made non-negative
+    norm = np.linalg.norm(rotations, axis=1)
+    rotations = np.where(norm[:, None] > 0.0001, rotations / np.maximum(norm, 1e-12)[:, None], [1.0, 0.0, 0.0, 0.0])
+    largest = np.abs(rotations).argmax(axis=1)
+    rotations *= np.where(rotations[np.arange(count), largest] < 0, -1.0, 1.0)[:, None]
+    rotation = largest.astype(np.uint32) << 30
+    for c in range(4):
+        for k in range(3):
+            # Component c is the k-th kept one when it sits k places after the dropped ones before it
+            kept = (largest != c) & (c - (largest < c) == k)
+            value = np.clip(np.rint((rotations[:, c] / SQRT_HALF + 1.0) * 0.5 * 1023), 0, 1023).astype(np.uint32)
+            rotation |= np.where(kept, value << (20 - 10 * k), 0).astype(np.uint32)
+
+    # Scale: log2 in 1/16 octaves around 128
+    log_scale = np.log2(np.maximum(scales.astype(np.float64), 1e-30)) * 16.0 + 128.0
+
+    packed = np.zeros(count, dtype=PACKED_DTYPE)
+    packed['position'] = position
+    packed['rotation'] = rotation
+    packed['scale'] = np.clip(np.rint(log_scale), 0, 255).astype(np.uint8)
+    packed['sh_index'] = sh_index
+    packed['color'] = color
+    packed['opacity'] = opacity
+    return packed
+
+
+def quaternion_from_matrix(r):
+    """(w, x, y, z) of a proper rotation matrix"""
+    trace = r[0, 0] + r[1, 1] + r[2, 2]
+    if trace > 0:
+        s = np.sqrt(trace + 1.0) * 2.0
+        return np.array([0.25 * s, (r[2, 1] - r[1, 2]) / s, (r[0, 2] - r[2, 0]) / s, (r[1, 0] - r[0, 1]) / s])
+    i = int(np.argmax([r[0, 0], r[1, 1], r[2, 2]]))
+    j, k = (i + 1) % 3, (i + 2) % 3
+    s = np.sqrt(1.0 + r[i, i] - r[j, j] - r[k, k]) * 2.0
+    q = np.zeros(4)
+    q[0] = (r[k, j] - r[j, k]) / s
+    q[1 + i] = 0.25 * s
+    q[1 + j] = (r[j, i] + r[i, j]) / s
+    q[1 + k] = (r[k, i] + r[i, k]) / s
+    return q
+
+
+class SceneCooker:
+    def __init__(self):
+        self.count = 0
+        self.records = None
+        self.hot = None
+        self.warm = None
+        self.cold = None
+        self.nodes = []
+        self.indices = None
+        # fixed16_sqrt() lookup table as built by fixed_math_init()
+        self.sqrt_table = [int(np.trunc(np.float32(np.sqrt(np.float32(j / 256.0 * 16.0))) * np.float32(65536.0)))
+                           for j in range(256)]
+
+    def load_ply(self, filename):
+        """Read a PLY capture and convert it like load_ply_file()"""
+        print(f"Loading PLY: {filename}")
+
+        with open(filename, 'rb') as f:
+            if f.readline().strip() != b'ply':
+                raise ValueError("Not a valid PLY file")
+
+            fmt = None
+            vertex_count = 0
+            properties = []
+            while True:
+                line = f.readline()
+                if not line:
+                    raise ValueError("Unexpected end of file in header")
+                parts = line.decode('ascii').split()
+                if not parts:
+                    continue
+                if parts[0] == 'end_header':
+                    break
+                if parts[0] == 'format':
+                    fmt = parts[1]
+                elif parts[:2] == ['element', 'vertex']:
+                    vertex_count = int(parts[2])
+                elif parts[0] == 'property':
+                    if parts[1] not in PLY_TYPES:
+                        raise ValueError(f"Unsupported property type: {parts[1]}")
+                    properties.append((parts[2], PLY_TYPES[parts[1]]))
+
+            if vertex_count == 0 or not properties:
+                raise ValueError("PLY file has no vertices or properties")
+
+            names = [name for name, _ in properties]
+            if fmt == 'ascii':
+                data = np.loadtxt(f, dtype=np.float32, ndmin=2, max_rows=vertex_count)
+                columns = {name: data[:, i] for i, name in enumerate(names) if i < data.shape[1]}
+                vertex_count = data.shape[0]
+            else:
+                endian = '>' if fmt == 'binary_big_endian' else '<'
+                dtype = np.dtype([(name, endian + t) for name, t in properties])
+                data = np.frombuffer(f.read(vertex_count * dtype.itemsize), dtype=dtype)
+                vertex_count = len(data)
+                columns = {name: data[name].astype(np.float32) for name in names}
+
+        def column(name, default):
+            if name in columns:
+                return columns[name]
+            return np.full(vertex_count, default, dtype=np.float32)
+
+        self.count = vertex_count
+        records = np.zeros(vertex_count, dtype=RECORD_DTYPE)
+        records['pos'][:, 0] = float_to_fixed16(column('x', 0.0))
+        records['pos'][:, 1] = float_to_fixed16(column('y', 0.0))
+        records['pos'][:, 2] = float_to_fixed16(column('z', 0.0))
+        records['color'][:, 0] = unit_to_u8(column('red', 1.0))
+        records['color'][:, 1] = unit_to_u8(column('green', 1.0))
+        records['color'][:, 2] = unit_to_u8(column('blue', 1.0))
+        opacity = column('alpha', 1.0) if 'alpha' in columns else column('opacity', 1.0)
+        records['opacity'] = unit_to_u8(opacity)
+
+        scales = np.stack([column(f'scale_{i}', 1.0) for i in range(3)], axis=1)
+        rotations = np.stack([column('rot_0', 1.0)] + [column(f'rot_{i}', 0.0) for i in range(1, 4)], axis=1)
+        records['cov_mant'], records['cov_exp'] = covariance_from_scale_rotation(scales, rotations)
+
+        # Importance as in asset_manager_complete.c: opacity times summed scale
+        scale_sum = scales[:, 0] + scales[:, 1] + scales[:, 2]
+        importance = np.trunc(opacity * scale_sum * np.float32(1000.0))
+        records['importance'] = np.clip(importance, 0, 0xFFFFFFFF).astype(np.uint32)
+
+        # Stream order: most important first, ties keep file order
+        order = np.argsort(-records['importance'].astype(np.int64), kind='stable')
+        self.records = records[order]
+        self.scales = scales[order]
+        self.rotations = rotations[order]
+
+        print(f"Converted {vertex_count} splats")
+
+    def fixed16_sqrt(self, value):
+        if value <= 0:
+            return 0
+        if value < (16 << 16):
+            return self.sqrt_table[value >> 16]
+        x = value >> 1
+        for _ in range(8):
+            if x == 0:
+                break
+            quotient = min((value << 16) // x, FIXED16_MAX)
+            x_new = wrap_s32(x + quotient) >> 1
+            if x_new == x:
+                break
+            x = x_new
+        return x
+
+    def bounding_radius(self, max_cov, exp):
+        """gaussian_splat_bounding_radius(): 3 * sqrt of the scaled largest diagonal"""
+        if max_cov <= 0:
+            return 0
+        max_cov_16 = max_cov << 8
+        if exp >= 7:
+            shift = exp - 7
+            max_cov_16 = FIXED16_MAX if max_cov_16 > (FIXED16_MAX >> shift) else max_cov_16 << shift
+        else:
+            max_cov_16 >>= 7 - exp
+        return wrap_s32((196608 * self.fixed16_sqrt(max_cov_16)) >> 16)
+
+    def build_streams(self):
+        """Hot/warm/cold split with gaussian_splat_bounding_radius()"""
+        records = self.records
+        diagonal = records['cov_mant'][:, [0, 4, 8]].max(axis=1).astype(np.int64)
+        exponents = (records['cov_exp'] & 0xF).astype(np.int64)
+
+        radius_cache = {}
+        radii = np.empty(self.count, dtype=np.int64)
+        for i, (max_cov, exp) in enumerate(zip(diagonal.tolist(), exponents.tolist())):
+            if (max_cov, exp) not in radius_cache:
+                radius_cache[(max_cov, exp)] = self.bounding_radius(max_cov, exp)
+            radii[i] = radius_cache[(max_cov, exp)]
+
+        self.hot = np.zeros(self.count, dtype=HOT_DTYPE)
+        self.hot['pos'] = records['pos']
+        self.hot['radius'] = radii
+
+        self.warm = np.zeros(self.count, dtype=WARM_DTYPE)
+        self.warm['cov_mant'] = records['cov_mant']
+        self.warm['cov_exp'] = records['cov_exp'] & 0xF
+        self.warm['color'] = records['color']
+        self.warm['opacity'] = records['opacity']
+
+        self.cold = np.zeros(self.count, dtype=COLD_DTYPE)
+        self.cold['sh_coeffs'] = records['sh_coeffs']
+        self.cold['importance'] = records['importance']
+
+    def build_octree(self):
+        """Adaptive octree, same node order and index ranges as octree_build()"""
+        pos = self.hot['pos'].astype(np.int64)
+        radius = self.hot['radius'].astype(np.int64)
+        self.indices = np.arange(self.count, dtype=np.uint32)
+
+        # node: [min3, max3, first_child, splat_first, splat_count, child_count, depth]
+        self.nodes = [[[0] * 3, [0] * 3, 0, 0, self.count, 0, 0]]
+        world_min = [int(pos[:, j].min()) - 65536 for j in range(3)]
+        world_max = [int(pos[:, j].max()) + 65536 for j in range(3)]
+        self._build_node(pos, 0, world_min, world_max)
+
+        # Refit bounds bottom-up; children always follow their parent
+        for node in reversed(self.nodes):
+            first, count = node[3], node[4]
+            if node[5] == 0:
+                members = self.indices[first:first + count]
+                node[0] = [max(FIXED16_MIN, min(FIXED16_MAX, int((pos[members, j] - radius[members]).min())))
+                           for j in range(3)]
+                node[1] = [max(FIXED16_MIN, min(FIXED16_MAX, int((pos[members, j] + radius[members]).max())))
+                           for j in range(3)]
+            else:
+                children = self.nodes[node[2]:node[2] + node[5]]
+                node[0] = [min(child[0][j] for child in children) for j in range(3)]
+                node[1] = [max(child[1][j] for child in children) for j in range(3)]
+
+        print(f"Built culling octree with {len(self.nodes)} nodes")
+
+    def _build_node(self, pos, node_index, cell_min, cell_max):
+        node = self.nodes[node_index]
+        first, count, depth = node[3], node[4], node[6]
+        if count <= OCTREE_LEAF_SPLATS or depth >= OCTREE_MAX_DEPTH:
+            return
+
+        center = [wrap_s32(cell_min[j] + wrap_s32(cell_max[j] - cell_min[j]) // 2) for j in range(3)]
+        members = self.indices[first:first + count]
+        member_pos = pos[members]
+        octant = ((member_pos[:, 0] >= center[0]).astype(np.int64) |
+                  ((member_pos[:, 1] >= center[1]).astype(np.int64) << 1) |
+                  ((member_pos[:, 2] >= center[2]).astype(np.int64) << 2))
+
+        # Stable scatter, as the counting sort in octree_build_node()
+        self.indices[first:first + count] = members[np.argsort(octant, kind='stable')]
+        octant_counts = np.bincount(octant, minlength=8)
+
+        children = [o for o in range(8) if octant_counts[o] > 0]
+        first_child = len(self.nodes)
+        node[2] = first_child
+        node[5] = len(children)
+
+        range_start = first
+        for o in children:
+            self.nodes.append([[0] * 3, [0] * 3, 0, range_start, int(octant_counts[o]), 0, depth + 1])
+            range_start += int(octant_counts[o])
+
+        for c, o in enumerate(children):
+            child_min = [center[j] if (o >> j) & 1 else cell_min[j] for j in range(3)]
+            child_max = [cell_max[j] if (o >> j) & 1 else center[j] for j in range(3)]
+            self._build_node(pos, first_child + c, child_min, child_max)
+
+    def node_bytes(self):
+        return b''.join(NODE_STRUCT.pack(*n[0], *n[1], n[2], n[3], n[4], n[5], n[6], 0) for n in self.nodes)
+
+    @staticmethod
+    def write_scene(filename, version, count, sections):
+        """Header plus payload, every section on a 128-byte boundary"""
+        payload = bytearray()
+        table = b''
+        for data, stride, section_count in sections:
+            table += struct.pack('<4I', len(payload), len(data), stride, section_count)
+            payload += data
+            payload += b'\0' * (-len(payload) % DMA_ALIGNMENT)
+
+        header = struct.pack('<4I', SPLAT_MAGIC, version, count, len(payload)) + table
+        header += b'\0' * (HEADER_SIZE - len(header))
+
+        with open(filename, 'wb') as f:
+            f.write(header)
+            f.write(payload)
+        return len(payload)
+
+    def write(self, filename, compact=False):
+        """Version 2: the engine's in-memory layout; compact drops warm and cold"""
+        streams = [(b'', WARM_DTYPE.itemsize, 0), (b'', COLD_DTYPE.itemsize, 0)] if compact else [
+            (self.warm.tobytes(), WARM_DTYPE.itemsize, self.count),
+            (self.cold.tobytes(), COLD_DTYPE.itemsize, self.count),
+        ]
+        sections = [
+            (self.records.tobytes(), RECORD_DTYPE.itemsize, self.count),
+            (self.hot.tobytes(), HOT_DTYPE.itemsize, self.count),
+            *streams,
+            (self.node_bytes(), NODE_STRUCT.size, len(self.nodes)),
+            (self.indices.astype('<u4').tobytes(), 4, self.count),
+        ]
+        size = self.write_scene(filename, SPLAT_VERSION_COOKED, self.count, sections)
+        print(f"Wrote cooked scene: {filename} ({self.count} splats, {size / 1024:.1f} KB payload)")
+
+    def build_sh_codebook(self, sh):
+        """At most 256 SH vectors: the distinct ones, or k-means centroids"""
+        unique, inverse = np.unique(sh, axis=0, return_inverse=True)
+        if len(unique) <= PACKED_SH_CODEBOOK_MAX:
+            return unique.astype(np.uint16), inverse.reshape(-1).astype(np.uint8)
+
+        data = sh.astype(np.float32)
+        rng = np.random.default_rng(0)
+        centroids = unique[rng.choice(len(unique), PACKED_SH_CODEBOOK_MAX, replace=False)].astype(np.float32)
+        for _ in range(8):
+            labels = np.empty(len(data), dtype=np.int64)
+            for start in range(0, len(data), 4096):
+                block = data[start:start + 4096]
+                distances = ((block[:, None, :] - centroids[None, :, :]) ** 2).sum(axis=2)
+                labels[start:start + 4096] = distances.argmin(axis=1)
+            for k in range(PACKED_SH_CODEBOOK_MAX):
+                members = data[labels == k]
+                if len(members):
+                    centroids[k] = members.mean(axis=0)
+        codebook = np.clip(np.rint(centroids), 0, 0xFFFF).astype(np.uint16)
+        return codebook, labels.astype(np.uint8)
+
+    def leaf_frames(self):
+        """Leaf nodes in splat order, and each splat's frame bounds in that order"""
+        leaves = sorted((n for n in self.nodes if n[5] == 0), key=lambda n: n[3])
+        counts = [n[4] for n in leaves]
+        frame_min = np.repeat(np.array([n[0] for n in leaves], dtype=np.float64), counts, axis=0)
+        frame_max = np.repeat(np.array([n[1] for n in leaves], dtype=np.float64), counts, axis=0)
+        return leaves, frame_min, frame_max
+
+    def write_packed(self, filename):
+        """Version 3: splats in leaf order, quantized across their leaf's bounds"""
+        order = self.indices.astype(np.int64)
+        records = self.records[order]
+
+        # Leaf frames in splat order; leaf ranges tile the index array
+        leaves, frame_min, frame_max = self.leaf_frames()
+        frame_bytes = b''.join(struct.pack('<6iII', *n[0], *n[1], n[4], 0) for n in leaves)
+
+        codebook, sh_index = self.build_sh_codebook(records['sh_coeffs'])
+        packed = encode_packed(records['pos'], frame_min, frame_max, self.scales[order], self.rotations[order],
+                               records['color'], records['opacity'], sh_index)
+
+        sections = [
+            (codebook.astype('<u2').tobytes(), 32, len(codebook)),
+            (self.node_bytes(), NODE_STRUCT.size, len(self.nodes)),
+            (frame_bytes, 32, len(leaves)),
+            (packed.tobytes(), PACKED_DTYPE.itemsize, self.count),
+        ]
+        size = self.write_scene(filename, SPLAT_VERSION_PACKED, self.count, sections)
+        print(f"Wrote packed scene: {filename} ({self.count} splats, {size / 1024:.1f} KB payload, "
+              f"{len(codebook)} SH codes)")
+
+    def build_page_tree(self):
+        """Octree cut where subtrees fit a page: page tree nodes, then page leaves depth-first"""
+        tree = [[self.nodes[0], 0, 0]]  # [octree node, first child, child count]
+        i = 0
+        while i < len(tree):
+            node = tree[i][0]
+            if node[4] > PAGE_SPLATS and node[5] > 0:
+                tree[i][1], tree[i][2] = len(tree), node[5]
+                tree.extend([child, 0, 0] for child in self.nodes[node[2]:node[2] + node[5]])
+            i += 1
+
+        pages = []
+        stack = [0]
+        while stack:
+            t = stack.pop()
+            if tree[t][2] == 0:
+                pages.append(t)
+            else:
+                stack.extend(range(tree[t][1] + tree[t][2] - 1, tree[t][1] - 1, -1))
+        return tree, pages
+
+    def build_proxies(self, members):
+        """Up to PAGE_PROXIES merged splats: median splits along the longest axis,
+        each group replaced by its opacity-weighted moments"""
+        pos = self.records['pos'][members].astype(np.float64) / 65536.0
+        groups = [np.arange(len(members))]
+        while len(groups) < PAGE_PROXIES:
+            g = max(range(len(groups)), key=lambda k: len(groups[k]))
+            if len(groups[g]) < 2:
+                break
+            group = groups.pop(g)
+            axis = int(np.argmax(np.ptp(pos[group], axis=0)))
+            ordered = group[np.argsort(pos[group, axis], kind='stable')]
+            groups += [ordered[:len(ordered) // 2], ordered[len(ordered) // 2:]]
+
+        records = self.records[members]
+        cov = records['cov_mant'].astype(np.float64) / 256.0 * \
+            np.ldexp(1.0, records['cov_exp'].astype(np.int32) - 7)[:, None]
+        proxies = []
+        for group in groups:
+            weight = records['opacity'][group].astype(np.float64) / 255.0 + 1e-6
+            total = weight.sum()
+            mean = (pos[group] * weight[:, None]).sum(axis=0) / total
+            offset = pos[group] - mean
+            moments = (cov[group].reshape(-1, 3, 3) + offset[:, :, None] * offset[:, None, :]) * weight[:, None, None]
+            values, vectors = np.linalg.eigh(moments.sum(axis=0) / total)
+            if np.linalg.det(vectors) < 0:
+                vectors[:, 2] = -vectors[:, 2]
+            proxies.append({
+                'pos': mean,
+                'scale': np.sqrt(np.maximum(values, 1e-12)),
+                'rotation': quaternion_from_matrix(vectors),
+                'radius': 3.0 * np.sqrt(max(np.diag(moments.sum(axis=0) / total).max(), 0.0)),
+                'color': (records['color'][group] * weight[:, None]).sum(axis=0) / total,
+                'opacity': (records['opacity'][group] * weight).sum() / total,
+                'sh': (records['sh_coeffs'][group] * weight[:, None]).sum(axis=0) / total,
+            })
+        return proxies
+
+    def write_paged(self, filename):
+        """Version 4: packed pages read on demand, proxies and tables resident"""
+        order = self.indices.astype(np.int64)
+        records = self.records[order]
+        leaves, frame_min, frame_max = self.leaf_frames()
+        tree, pages = self.build_page_tree()
+
+        # Page splat runs; a leaf over the page size (depth limit) is truncated
+        page_ranges = []
+        for t in pages:
+            node = tree[t][0]
+            if node[4] > PAGE_SPLATS:
+                print(f"Warning: octree leaf of {node[4]} splats truncated to a {PAGE_SPLATS}-splat page")
+            page_ranges.append((node[3], min(node[4], PAGE_SPLATS)))
+
+        page_proxies = [self.build_proxies(order[first:first + count]) for first, count in page_ranges]
+        proxy_list = [proxy for proxies in page_proxies for proxy in proxies]
+        proxy_sh = np.array([np.clip(np.rint(proxy['sh']), 0, 0xFFFF) for proxy in proxy_list], dtype=np.uint16)
+        codebook, sh_index = self.build_sh_codebook(np.concatenate([records['sh_coeffs'], proxy_sh.reshape(-1, 16)]))
+        packed = encode_packed(records['pos'], frame_min, frame_max, self.scales[order], self.rotations[order],
+                               records['color'], records['opacity'], sh_index[:self.count])
+
+        # Page bounds grow to hold their proxies; inner nodes then cover their children
+        bounds = [[list(node[0]), list(node[1])] for node, _, _ in tree]
+        for t, proxies in zip(pages, page_proxies):
+            for proxy in proxies:
+                for j in range(3):
+                    reach = (proxy['radius'] * 1.1 + 1.0 / 65536.0) * 65536.0
+                    bounds[t][0][j] = max(min(bounds[t][0][j], int(np.floor(proxy['pos'][j] * 65536.0 - reach))),
+                                          FIXED16_MIN)
+                    bounds[t][1][j] = min(max(bounds[t][1][j], int(np.ceil(proxy['pos'][j] * 65536.0 + reach))),
+                                          FIXED16_MAX)
+        for t in range(len(tree) - 1, -1, -1):
+            for c in range(tree[t][1], tree[t][1] + tree[t][2]):
+                bounds[t][0] = [min(a, b) for a, b in zip(bounds[t][0], bounds[c][0])]
+                bounds[t][1] = [max(a, b) for a, b in zip(bounds[t][1], bounds[c][1])]
+
+        # Proxies quantized across their page's bounds
+        proxy_bytes = b''
+        proxy_first = 0
+        code = self.count
+        page_bytes = b''
+        page_data = bytearray()
+        leaf_firsts = [n[3] for n in leaves]
+        for t, (first, count), proxies in zip(pages, page_ranges, page_proxies):
+            n = len(proxies)
+            if n:
+                page_min = np.repeat(np.array([bounds[t][0]], dtype=np.float64), n, axis=0)
+                page_max = np.repeat(np.array([bounds[t][1]], dtype=np.float64), n, axis=0)
+                proxy_bytes += encode_packed(
+                    np.array([p['pos'] * 65536.0 for p in proxies]), page_min, page_max,
+                    np.array([p['scale'] for p in proxies]), np.array([p['rotation'] for p in proxies]),
+                    np.clip(np.rint([p['color'] for p in proxies]), 0, 255).astype(np.uint8),
+                    np.clip(np.rint([p['opacity'] for p in proxies]), 0, 255).astype(np.uint8),
+                    sh_index[code:code + n]).tobytes()
+            code += n
+
+            # Page data: the page's leaf frames, then its splats
+            frames = b''
+            start = int(np.searchsorted(leaf_firsts, first))
+            for leaf in leaves[start:]:
+                if leaf[3] >= first + count:
+                    break
+                frames += struct.pack('<6iII', *leaf[0], *leaf[1], min(leaf[4], first + count - leaf[3]), 0)
+            offset = len(page_data)
+            page_data += frames + packed[first:first + count].tobytes()
+            page_data += b'\0' * (-len(page_data) % DMA_ALIGNMENT)
+            page_bytes += PAGE_STRUCT.pack(*bounds[t][0], *bounds[t][1], offset, len(frames) // 32, count,
+                                           proxy_first, n)
+            proxy_first += n
+
+        node_bytes = b''.join(NODE_STRUCT.pack(*bounds[t][0], *bounds[t][1], first_child, node[3], node[4],
+                                               child_count, node[6], 0)
+                              for t, (node, first_child, child_count) in enumerate(tree))
+        total = sum(count for _, count in page_ranges)
+        sections = [
+            (codebook.astype('<u2').tobytes(), 32, len(codebook)),
+            (node_bytes, NODE_STRUCT.size, len(tree)),
+            (page_bytes, PAGE_STRUCT.size, len(pages)),
+            (proxy_bytes, PACKED_DTYPE.itemsize, len(proxy_list)),
+            (bytes(page_data), 1, len(page_data)),
+        ]
+        size = self.write_scene(filename, SPLAT_VERSION_PAGED, total, sections)
+        print(f"Wrote paged scene: {filename} ({total} splats in {len(pages)} pages, {len(proxy_list)} proxies, "
+              f"{size / 1024:.1f} KB payload)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SPLATSTORM X Scene Cooker')
+    parser.add_argument('input', help='Input PLY file')
+    parser.add_argument('-o', '--output', default='scene.splt', help='Output cooked scene')
+    parser.add_argument('--packed', action='store_true',
+                        help='Write a compressed version 3 scene instead of the in-memory layout')
+    parser.add_argument('--paged', action='store_true',
+                        help='Write a version 4 scene that pages in around the camera, for scenes larger than RAM')
+    parser.add_argument('--compact', action='store_true',
+                        help='Leave out the warm and cold streams, for large scenes that must stay resident')
+
+    args = parser.parse_args()
+
+    cooker = SceneCooker()
+    cooker.load_ply(args.input)
+    cooker.build_streams()
+    cooker.build_octree()
+    if args.paged:
+        cooker.write_paged(args.output)
+    elif args.packed:
+        cooker.write_packed(args.output)
+    else:
+        cooker.write(args.output, args.compact)
+
+
+if __name__ == '__main__':
+    main()
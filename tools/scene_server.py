@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+SPLATSTORM X - Scene Server
+Serves scenes to units that load net:<host>[:port]/<name>
+(scene_stream_begin in src/asset_loader_real.c), so a capture goes from
+the build machine to the fleet without copying it to USB or a memory card.
+
+Names are paths under the served directory. Cooked (version 2) scenes are
+sent as they are; PLY captures are cooked on first request with
+tools/cook_scene.py and kept until the file changes. Packed and paged scenes
+are refused: they exist to save storage, and the unit streams the cooked
+layout straight into place.
+
+A unit sends one line, "SPLT <chunk splats> <name>". The reply is the
+128-byte cooked header, then the payload in the order the unit reads it:
+for each chunk of splats its slice of the hot, warm, record and cold
+sections (compact scenes have no warm or cold entries), then the octree
+nodes and indices. The unit publishes splats a
+chunk at a time, so it draws the most important ones while the rest arrive.
+A name the server cannot serve gets the connection closed instead.
+"""
+
+import argparse
+import os
+import socketserver
+import struct
+import sys
+import tempfile
+import threading
+
+SCENE_SERVER_DEFAULT_PORT = 9100
+SPLAT_MAGIC = 0x53504C54  # 'SPLT'
+SPLAT_VERSION_COOKED = 2
+HEADER_SIZE = 128
+
+# CookedSection order, and the per-chunk read order of scene_stream_next_range()
+SECTION_RECORDS, SECTION_HOT, SECTION_WARM, SECTION_COLD, SECTION_NODES, SECTION_INDICES = range(6)
+CHUNK_SECTIONS = [SECTION_HOT, SECTION_WARM, SECTION_RECORDS, SECTION_COLD]
+
+HEADER = struct.Struct('<4I')
+SECTION = struct.Struct('<4I')
+
+
+class SceneCache:
+    """Cooked scene bytes by path, recooked when a PLY source changes"""
+
+    def __init__(self, root):
+        self.root = os.path.realpath(root)
+        self.scenes = {}
+        self.lock = threading.Lock()
+
+    def resolve(self, name):
+        path = os.path.realpath(os.path.join(self.root, name))
+        if os.path.commonpath([self.root, path]) != self.root or not os.path.isfile(path):
+            return None
+        return path
+
+    def load(self, name):
+        path = self.resolve(name)
+        if path is None:
+            return None, f'no file {name}'
+
+        mtime = os.path.getmtime(path)
+        with self.lock:
+            cached = self.scenes.get(path)
+            if cached and cached[0] == mtime:
+                return cached[1], None
+
+            if path.lower().endswith('.ply'):
+                data = self.cook(path)
+            else:
+                with open(path, 'rb') as f:
+                    data = f.read()
+
+            if len(data) < HEADER_SIZE:
+                return None, f'{name} is not a scene'
+            magic, version, _, payload_size = HEADER.unpack_from(data)
+            if magic != SPLAT_MAGIC or version != SPLAT_VERSION_COOKED:
+                return None, f'{name} is not a cooked scene (version {version})'
+            if len(data) < HEADER_SIZE + payload_size:
+                return None, f'{name} is truncated'
+
+            self.scenes[path] = (mtime, data)
+            return data, None
+
+    @staticmethod
+    def cook(path):
+        # Only PLY sources need the cooker (and numpy)
+        sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+        from cook_scene import SceneCooker
+
+        cooker = SceneCooker()
+        cooker.load_ply(path)
+        cooker.build_streams()
+        cooker.build_octree()
+        with tempfile.TemporaryDirectory() as scratch:
+            output = os.path.join(scratch, 'scene.splt')
+            cooker.write(output)
+            with open(output, 'rb') as f:
+                return f.read()
+
+
+def stream_ranges(data, chunk_splats):
+    """Payload (offset, size) ranges in the order the unit reads them"""
+    _, _, count, _ = HEADER.unpack_from(data)
+    sections = [SECTION.unpack_from(data, HEADER.size + s * SECTION.size) for s in range(6)]
+
+    for first in range(0, count, chunk_splats):
+        chunk = min(chunk_splats, count - first)
+        for s in CHUNK_SECTIONS:
+            offset, _, stride, section_count = sections[s]
+            if section_count > 0:
+                yield offset + first * stride, chunk * stride
+    for s in (SECTION_NODES, SECTION_INDICES):
+        offset, size, _, _ = sections[s]
+        yield offset, size
+
+
+class SceneRequestHandler(socketserver.StreamRequestHandler):
+    def handle(self):
+        unit = self.client_address[0]
+        line = self.rfile.readline(512).decode('ascii', 'replace').strip()
+        fields = line.split(' ', 2)
+        if len(fields) != 3 or fields[0] != 'SPLT' or not fields[1].isdigit() or int(fields[1]) == 0:
+            print(f'{unit}: bad request {line!r}', file=sys.stderr)
+            return
+
+        chunk_splats, name = int(fields[1]), fields[2]
+        data, error = self.server.scenes.load(name)
+        if data is None:
+            print(f'{unit}: {error}', file=sys.stderr)
+            return
+
+        view = memoryview(data)
+        try:
+            self.wfile.write(view[:HEADER_SIZE])
+            for offset, size in stream_ranges(data, chunk_splats):
+                self.wfile.write(view[HEADER_SIZE + offset:HEADER_SIZE + offset + size])
+            self.wfile.flush()
+        except (BrokenPipeError, ConnectionResetError):
+            print(f'{unit}: {name} cancelled', file=sys.stderr)
+            return
+        print(f'{unit}: sent {name} ({len(data) / 1024:.1f} KB)', file=sys.stderr)
+
+
+class SceneServer(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SPLATSTORM X Scene Server')
+    parser.add_argument('root', nargs='?', default='.', help='Directory of scenes to serve')
+    parser.add_argument('-p', '--port', type=int, default=SCENE_SERVER_DEFAULT_PORT, help='TCP port to listen on')
+    parser.add_argument('--bind', default='0.0.0.0', help='Address to listen on')
+
+    args = parser.parse_args()
+
+    with SceneServer((args.bind, args.port), SceneRequestHandler) as server:
+        server.scenes = SceneCache(args.root)
+        print(f'Serving {server.scenes.root} on {args.bind}:{args.port}', file=sys.stderr)
+        try:
+            server.serve_forever()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+SPLATSTORM X - Telemetry Receiver
+Collects the per-frame records units stream with telemetry=<host>[:port]
+(src/telemetry.c) and writes them to CSV, one row per frame and unit.
+Datagrams carry a sequence number per unit, so lost datagrams are counted
+and reported; frames a unit dropped itself show up as gaps in the frame
+column.
+
+Zone times are in milliseconds. The event columns hold the unit's PCR0 and
+PCR1 counts for the whole frame, named after its counter set. Each DMA
+channel group gets the bytes it moved that frame and the milliseconds the EE
+spent waiting on it. VU busy is the share of the frame each VU ran a
+program, as the unit's activity sampler saw it; VU1 gaps and VIF1 MSCAL
+stalls are in milliseconds (all zero with sampling off).
+"""
+
+import argparse
+import csv
+import socket
+import struct
+import sys
+import time
+
+TELEMETRY_MAGIC = 0x4D545053  # 'SPTM'
+TELEMETRY_VERSION = 3
+TELEMETRY_DEFAULT_PORT = 9000
+
+HEADER = struct.Struct('<IHHIHH')
+
+# ProfileZone order (include/profile_zones.h)
+ZONE_NAMES = ['frame', 'render', 'cull', 'vu', 'tile', 'gs', 'gs_sync', 'lod', 'streaming',
+              'bin', 'sort', 'packets']
+
+# DMAStatsChannel order (include/gaussian_types.h)
+DMA_CHANNELS = ['vif0', 'vif1', 'gif', 'spr']
+
+# ProfileCounterSet order: PCR0 and PCR1 event names
+COUNTER_SETS = [('-', '-'), ('icache_miss', 'dcache_miss'), ('branch', 'mispredict'),
+                ('instructions', 'dual_issue'), ('addr_bus_busy', 'data_bus_busy')]
+
+FLAG_NAMES = [(0x01, 'reused'), (0x02, 'fallback'), (0x04, 'direct'), (0x08, 'memory')]
+
+
+def record_struct(zone_count):
+    """frame, zone times in us, PCR0/PCR1, visible, rendered, DMA bytes, DMA waits in us,
+    VU0/VU1 busy in permille, VU1 gaps and VIF1 stalls in us, then four bytes"""
+    channels = len(DMA_CHANNELS)
+    return struct.Struct(f'<I{zone_count}H4I{channels}I{channels}H4H4B')
+
+
+def zone_names(zone_count):
+    return [ZONE_NAMES[i] if i < len(ZONE_NAMES) else f'zone{i}' for i in range(zone_count)]
+
+
+def decode(datagram):
+    """Header fields and the list of records, or None for foreign packets"""
+    if len(datagram) < HEADER.size:
+        return None
+    magic, version, record_size, sequence, record_count, zone_count = HEADER.unpack_from(datagram)
+    if magic != TELEMETRY_MAGIC or version != TELEMETRY_VERSION:
+        return None
+
+    record = record_struct(zone_count)
+    if record.size != record_size or len(datagram) < HEADER.size + record_count * record_size:
+        return None
+
+    records = [record.unpack_from(datagram, HEADER.size + i * record_size) for i in range(record_count)]
+    return sequence, zone_count, records
+
+
+class Collector:
+    def __init__(self, writer):
+        self.writer = writer
+        self.zone_count = None
+        self.last_sequence = {}
+        self.frames = 0
+        self.datagrams = 0
+        self.lost = 0
+
+    def write_header(self, zone_count):
+        self.zone_count = zone_count
+        self.writer.writerow(['unit', 'frame'] + [f'{name}_ms' for name in zone_names(zone_count)] +
+                             ['counter_set', 'event0', 'event1', 'visible_splats', 'rendered_splats'] +
+                             [f'dma_{name}_bytes' for name in DMA_CHANNELS] +
+                             [f'dma_{name}_wait_ms' for name in DMA_CHANNELS] +
+                             ['vu0_busy_pct', 'vu1_busy_pct', 'vu1_gap_ms', 'vif1_vu_wait_ms'] +
+                             ['quality_level', 'resolution_level', 'flags'])
+
+    def add(self, unit, datagram):
+        decoded = decode(datagram)
+        if decoded is None:
+            return
+        sequence, zone_count, records = decoded
+        if self.zone_count is None:
+            self.write_header(zone_count)
+        elif zone_count != self.zone_count:
+            print(f"{unit}: {zone_count} zones, expected {self.zone_count}; skipped", file=sys.stderr)
+            return
+
+        last = self.last_sequence.get(unit)
+        if last is not None and sequence > last + 1:
+            self.lost += sequence - last - 1
+        self.last_sequence[unit] = sequence
+        self.datagrams += 1
+
+        for fields in records:
+            frame = fields[0]
+            zone_us = fields[1:1 + zone_count]
+            event0, event1, visible, rendered = fields[1 + zone_count:5 + zone_count]
+            channels = len(DMA_CHANNELS)
+            dma_bytes = fields[5 + zone_count:5 + zone_count + channels]
+            dma_wait_us = fields[5 + zone_count + channels:5 + zone_count + 2 * channels]
+            vu_fields = 5 + zone_count + 2 * channels
+            vu0_busy, vu1_busy, vu1_gap_us, vif1_wait_us = fields[vu_fields:vu_fields + 4]
+            quality, resolution, counter_set, flags = fields[vu_fields + 4:]
+            events = COUNTER_SETS[counter_set] if counter_set < len(COUNTER_SETS) else ('?', '?')
+            flag_text = '|'.join(name for bit, name in FLAG_NAMES if flags & bit)
+            self.writer.writerow([unit, frame] + [f'{us / 1000.0:.3f}' for us in zone_us] +
+                                 [f'{events[0]}/{events[1]}', event0, event1, visible, rendered] +
+                                 list(dma_bytes) + [f'{us / 1000.0:.3f}' for us in dma_wait_us] +
+                                 [f'{vu0_busy / 10.0:.1f}', f'{vu1_busy / 10.0:.1f}',
+                                  f'{vu1_gap_us / 1000.0:.3f}', f'{vif1_wait_us / 1000.0:.3f}'] +
+                                 [quality, resolution, flag_text])
+            self.frames += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SPLATSTORM X Telemetry Receiver')
+    parser.add_argument('-o', '--output', default='-', help='CSV file to write (default: stdout)')
+    parser.add_argument('-p', '--port', type=int, default=TELEMETRY_DEFAULT_PORT, help='UDP port to listen on')
+    parser.add_argument('--bind', default='0.0.0.0', help='Address to listen on')
+    parser.add_argument('--duration', type=float, default=0.0, help='Stop after this many seconds (0: run until Ctrl-C)')
+
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.port))
+    sock.settimeout(1.0)
+
+    output = sys.stdout if args.output == '-' else open(args.output, 'w', newline='')
+    collector = Collector(csv.writer(output))
+    print(f"Listening on {args.bind}:{args.port}", file=sys.stderr)
+
+    end_time = time.time() + args.duration if args.duration > 0 else None
+    try:
+        while end_time is None or time.time() < end_time:
+            try:
+                datagram, (host, _) = sock.recvfrom(65536)
+            except socket.timeout:
+                continue
+            collector.add(host, datagram)
+            output.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if output is not sys.stdout:
+            output.close()
+        sock.close()
+
+    print(f"{collector.frames} frames in {collector.datagrams} datagrams from {len(collector.last_sequence)} units, "
+          f"{collector.lost} datagrams lost", file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()